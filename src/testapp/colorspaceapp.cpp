@@ -40,6 +40,19 @@ int decode_colorspace(const struct ArgparseOption *opt, void *out, const char *p
 	return 0;
 }
 
+int decode_tone_mapping(const struct ArgparseOption *, void *out, const char *param, int)
+{
+	try {
+		zimg::colorspace::ToneMapping *tone_mapping = static_cast<zimg::colorspace::ToneMapping *>(out);
+		*tone_mapping = g_tone_mapping_table[param];
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << '\n';
+		return -1;
+	}
+
+	return 0;
+}
+
 
 double ns_per_sample(const ImageFrame &frame, double seconds)
 {
@@ -70,7 +83,10 @@ struct Arguments {
 	char fullrange_out;
 	double peak_luminance;
 	char approximate_gamma;
+	char approximate_colorspace;
 	char scene_referred;
+	zimg::colorspace::ToneMapping tone_mapping;
+	double source_peak_luminance;
 	const char *visualise_path;
 	unsigned times;
 	zimg::CPUClass cpu;
@@ -83,7 +99,10 @@ const ArgparseOption program_switches[] = {
 	{ OPTION_FLAG,   nullptr, "fullrange-out",  offsetof(Arguments, fullrange_out),     nullptr, "output is PC range" },
 	{ OPTION_FLOAT,  nullptr, "peak-luminance", offsetof(Arguments, peak_luminance),    nullptr, "nominal peak luminance for SDR (cd/m^2)" },
 	{ OPTION_FLAG,   nullptr, "lut",            offsetof(Arguments, approximate_gamma), nullptr, "use LUT to evaluate transfer functions" },
+	{ OPTION_FLAG,   nullptr, "lut3d",          offsetof(Arguments, approximate_colorspace), nullptr, "use 3D LUT to evaluate conversion" },
 	{ OPTION_FLAG,   "s",     "scene-referred", offsetof(Arguments, scene_referred),    nullptr, "use scene-referred transfer functions" },
+	{ OPTION_USER1,  nullptr, "tone-mapping",   offsetof(Arguments, tone_mapping),      decode_tone_mapping, "select HDR tone mapping operator" },
+	{ OPTION_FLOAT,  nullptr, "source-peak-luminance", offsetof(Arguments, source_peak_luminance), nullptr, "peak luminance of HDR source (cd/m^2)" },
 	{ OPTION_STRING, nullptr, "visualise",      offsetof(Arguments, visualise_path),    nullptr, "path to BMP file for visualisation" },
 	{ OPTION_UINT,   nullptr, "times",          offsetof(Arguments, times),             nullptr, "number of benchmark cycles" },
 	{ OPTION_USER1,  nullptr, "cpu",            offsetof(Arguments, cpu),               arg_decode_cpu, "select CPU type" },
@@ -103,6 +122,7 @@ const char help_str[] =
 "matrix:    unspec, rgb, 601, 709, fcc, 240m, ycgco, 2020_ncl, 2020_cl, chroma_ncl, chroma_cl, ictcp\n"
 "transfer:  unspec, linear, 709, srgb, st_2084, arib_b67\n"
 "primaries: unspec, 470_m, 470_bg, smpte_c, 709, film, 2020, st_428, dcip3_d65, jedec_p22\n"
+"Tone mapping: none, bt2390, hable, reinhard\n"
 "\n"
 PATH_SPECIFIER_HELP_STR;
 
@@ -117,6 +137,7 @@ int colorspace_main(int argc, char **argv)
 	int ret;
 
 	args.peak_luminance = NAN;
+	args.source_peak_luminance = NAN;
 	args.times = 1;
 
 	if ((ret = argparse_parse(&program_def, &args, argc, argv)) < 0)
@@ -136,10 +157,14 @@ int colorspace_main(int argc, char **argv)
 		conv.set_csp_in(args.csp_in)
 		    .set_csp_out(args.csp_out)
 		    .set_approximate_gamma(!!args.approximate_gamma)
+		    .set_approximate_colorspace(!!args.approximate_colorspace)
 		    .set_scene_referred(!!args.scene_referred)
+		    .set_tone_mapping(args.tone_mapping)
 		    .set_cpu(args.cpu);
 		if (!std::isnan(args.peak_luminance))
 			conv.set_peak_luminance(args.peak_luminance);
+		if (!std::isnan(args.source_peak_luminance))
+			conv.set_source_peak_luminance(args.source_peak_luminance);
 
 		auto convert = conv.create();
 		execute(convert.get(), &src_frame, &dst_frame, args.times);
@@ -3,12 +3,13 @@
 #include <fstream>
 #include <exception>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <streambuf>
 #include <string>
 #include <thread>
-#include "common/alloc.h"
 #include "common/except.h"
+#include "common/page_alloc.h"
 #include "common/static_map.h"
 #include "depth/depth.h"
 #include "graph/filtergraph.h"
@@ -211,8 +212,16 @@ void read_graph_params(zimg::graph::GraphBuilder::params *params, const json::Ob
 		params->peak_luminance = val.number();
 	if (const auto &val = obj["approximate_gamma"])
 		params->approximate_gamma = val.boolean();
+	if (const auto &val = obj["approximate_colorspace"])
+		params->approximate_colorspace = val.boolean();
+	if (const auto &val = obj["unresize"])
+		params->unresize = params->unresize || val.boolean();
 	if (const auto &val = obj["scene_referred"])
 		params->scene_referred = val.boolean();
+	if (const auto &val = obj["tone_mapping"])
+		params->tone_mapping = g_tone_mapping_table[val.string().c_str()];
+	if (const auto &val = obj["source_peak_luminance"])
+		params->source_peak_luminance = val.number();
 	if (const auto &val = obj["cpu"])
 		params->cpu = g_cpu_table[val.string().c_str()];
 }
@@ -271,9 +280,14 @@ ImageFrame allocate_frame(const zimg::graph::GraphBuilder::state &state)
 	};
 }
 
+struct page_free {
+	void operator()(void *ptr) const noexcept { zimg::page_free(ptr); }
+};
+
 void thread_target(const zimg::graph::FilterGraph *graph,
                    const zimg::graph::GraphBuilder::state *src_state,
                    const zimg::graph::GraphBuilder::state *dst_state,
+                   const zimg::PageAllocOptions *alloc_options,
                    std::atomic_int *counter,
                    std::exception_ptr *eptr,
                    std::mutex *mutex)
@@ -281,13 +295,13 @@ void thread_target(const zimg::graph::FilterGraph *graph,
 	try {
 		ImageFrame src_frame = allocate_frame(*src_state);
 		ImageFrame dst_frame = allocate_frame(*dst_state);
-		zimg::AlignedVector<char> tmp(graph->get_tmp_size());
+		std::unique_ptr<void, page_free> tmp{ zimg::page_alloc(graph->get_tmp_size(), *alloc_options) };
 
 		while (true) {
 			if ((*counter)-- <= 0)
 				break;
 
-			graph->process(src_frame.as_read_buffer(), dst_frame.as_write_buffer(), tmp.data(), nullptr, nullptr);
+			graph->process(src_frame.as_read_buffer(), dst_frame.as_write_buffer(), tmp.get(), nullptr, nullptr);
 		}
 	} catch (...) {
 		std::lock_guard<std::mutex> lock{ *mutex };
@@ -295,7 +309,7 @@ void thread_target(const zimg::graph::FilterGraph *graph,
 	}
 }
 
-void execute(const json::Object &spec, unsigned times, unsigned threads, unsigned tile_width, zimg::CPUClass cpu)
+void execute(const json::Object &spec, unsigned times, unsigned threads, unsigned tile_width, zimg::CPUClass cpu, const zimg::PageAllocOptions &alloc_options)
 {
 	zimg::graph::GraphBuilder::state src_state;
 	zimg::graph::GraphBuilder::state dst_state;
@@ -327,7 +341,7 @@ void execute(const json::Object &spec, unsigned times, unsigned threads, unsigne
 
 		timer.start();
 		for (unsigned nn = 0; nn < n; ++nn) {
-			thread_pool.emplace_back(thread_target, graph.get(), &src_state, &dst_state, &counter, &eptr, &mutex);
+			thread_pool.emplace_back(thread_target, graph.get(), &src_state, &dst_state, &alloc_options, &counter, &eptr, &mutex);
 		}
 
 		for (auto &th : thread_pool) {
@@ -352,6 +366,9 @@ struct Arguments {
 	unsigned threads;
 	unsigned tile_width;
 	zimg::CPUClass cpu;
+	char transparent_huge_pages;
+	char huge_pages;
+	int numa_node;
 };
 
 const ArgparseOption program_switches[] = {
@@ -359,6 +376,9 @@ const ArgparseOption program_switches[] = {
 	{ OPTION_UINT,  nullptr, "threads",    offsetof(Arguments, threads),    nullptr, "number of threads" },
 	{ OPTION_UINT,  nullptr, "tile-width", offsetof(Arguments, tile_width), nullptr, "graph tile width" },
 	{ OPTION_USER1, nullptr, "cpu",        offsetof(Arguments, cpu),        arg_decode_cpu, "select CPU type" },
+	{ OPTION_FLAG,  nullptr, "thp",        offsetof(Arguments, transparent_huge_pages), nullptr, "advise transparent huge pages for graph temporaries" },
+	{ OPTION_FLAG,  nullptr, "huge-pages", offsetof(Arguments, huge_pages), nullptr, "allocate graph temporaries from explicit huge pages" },
+	{ OPTION_INT,   nullptr, "numa-node",  offsetof(Arguments, numa_node),  nullptr, "preferred NUMA node for graph temporaries" },
 	{ OPTION_NULL }
 };
 
@@ -379,13 +399,15 @@ int graph_main(int argc, char **argv)
 
 	args.times = 100;
 	args.cpu = static_cast<zimg::CPUClass>(-1);
+	args.numa_node = -1;
 
 	if ((ret = argparse_parse(&program_def, &args, argc, argv)) < 0)
 		return ret == ARGPARSE_HELP_MESSAGE ? 0 : ret;
 
 	try {
 		json::Object spec = read_graph_spec(args.specpath);
-		execute(spec, args.times, args.threads, args.tile_width, args.cpu);
+		zimg::PageAllocOptions alloc_options{ !!args.transparent_huge_pages, !!args.huge_pages, args.numa_node };
+		execute(spec, args.times, args.threads, args.tile_width, args.cpu, alloc_options);
 	} catch (const zimg::error::Exception &e) {
 		std::cerr << e.what() << '\n';
 		return 2;
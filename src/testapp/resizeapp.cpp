@@ -30,7 +30,7 @@ int decode_filter(const struct ArgparseOption *, void *out, const char *param, i
 {
 	try {
 		std::unique_ptr<zimg::resize::Filter> *filter = static_cast<std::unique_ptr<zimg::resize::Filter> *>(out);
-		std::regex filter_regex{ R"(^(point|bilinear|bicubic|spline16|spline36|lanczos)(?::([\w.+-]+)(?::([\w.+-]+))?)?$)" };
+		std::regex filter_regex{ R"(^(point|bilinear|bicubic|spline16|spline36|lanczos|area)(?::([\w.+-]+)(?::([\w.+-]+))?)?$)" };
 		std::cmatch match;
 		std::string filter_str;
 		double param_a = NAN;
@@ -101,7 +101,7 @@ const ArgparseOption program_positional[] = {
 
 const char help_str[] =
 "Resampling filter specifier: filter[:param_a[:param_b]]\n"
-"filter: point, bilinear, bicubic, spline16, spline36, lanczos\n"
+"filter: point, bilinear, bicubic, spline16, spline36, lanczos, area\n"
 "\n"
 PIXFMT_SPECIFIER_HELP_STR
 "\n"
@@ -12,6 +12,7 @@ using zimg::PixelType;
 using zimg::colorspace::MatrixCoefficients;
 using zimg::colorspace::TransferCharacteristics;
 using zimg::colorspace::ColorPrimaries;
+using zimg::colorspace::ToneMapping;
 using zimg::depth::DitherType;
 
 namespace {
@@ -111,6 +112,13 @@ const zimg::static_string_map<ColorPrimaries, 12> g_primaries_table{
 	{ "jedec_p22", ColorPrimaries::JEDEC_P22 },
 };
 
+const zimg::static_string_map<ToneMapping, 4> g_tone_mapping_table{
+	{ "none",     ToneMapping::NONE },
+	{ "bt2390",   ToneMapping::BT2390 },
+	{ "hable",    ToneMapping::HABLE },
+	{ "reinhard", ToneMapping::REINHARD },
+};
+
 const zimg::static_string_map<DitherType, 4> g_dither_table{
 	{ "none",            DitherType::NONE },
 	{ "ordered",         DitherType::ORDERED },
@@ -118,7 +126,7 @@ const zimg::static_string_map<DitherType, 4> g_dither_table{
 	{ "error_diffusion", DitherType::ERROR_DIFFUSION },
 };
 
-const zimg::static_string_map<std::unique_ptr<zimg::resize::Filter>(*)(double, double), 8> g_resize_table{
+const zimg::static_string_map<std::unique_ptr<zimg::resize::Filter>(*)(double, double), 9> g_resize_table{
 	{ "point",    make_filter<zimg::resize::PointFilter> },
 	{ "bilinear", make_filter<zimg::resize::BilinearFilter> },
 	{ "bicubic",  make_bicubic_filter },
@@ -126,5 +134,6 @@ const zimg::static_string_map<std::unique_ptr<zimg::resize::Filter>(*)(double, d
 	{ "spline36", make_filter<zimg::resize::Spline36Filter> },
 	{ "spline64", make_filter<zimg::resize::Spline64Filter> },
 	{ "lanczos",  make_lanczos_filter },
+	{ "area",     make_filter<zimg::resize::AreaFilter> },
 	{ "unresize", make_null_filter },
 };
@@ -16,6 +16,7 @@ namespace colorspace {
 enum class MatrixCoefficients;
 enum class TransferCharacteristics;
 enum class ColorPrimaries;
+enum class ToneMapping;
 
 } // namespace colorspace
 
@@ -39,7 +40,8 @@ extern const zimg::static_string_map<zimg::PixelType, 4> g_pixel_table;
 extern const zimg::static_string_map<zimg::colorspace::MatrixCoefficients, 12> g_matrix_table;
 extern const zimg::static_string_map<zimg::colorspace::TransferCharacteristics, 13> g_transfer_table;
 extern const zimg::static_string_map<zimg::colorspace::ColorPrimaries, 12> g_primaries_table;
+extern const zimg::static_string_map<zimg::colorspace::ToneMapping, 4> g_tone_mapping_table;
 extern const zimg::static_string_map<zimg::depth::DitherType, 4> g_dither_table;
-extern const zimg::static_string_map<std::unique_ptr<zimg::resize::Filter>(*)(double, double), 8> g_resize_table;
+extern const zimg::static_string_map<std::unique_ptr<zimg::resize::Filter>(*)(double, double), 9> g_resize_table;
 
 #endif // TABLE_H_
@@ -210,6 +210,13 @@ public:
 		return ret;
 	}
 
+	unsigned get_passthrough_planes() const
+	{
+		unsigned ret;
+		check(zimg_filter_graph_get_passthrough_planes(m_graph, &ret));
+		return ret;
+	}
+
 	void process(const zimg_image_buffer_const &src, const zimg_image_buffer &dst, void *tmp,
 	             zimg_filter_graph_callback unpack_cb = 0, void *unpack_user = 0,
 	             zimg_filter_graph_callback pack_cb = 0, void *pack_user = 0) const
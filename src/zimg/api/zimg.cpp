@@ -7,6 +7,7 @@
 #include "common/cpuinfo.h"
 #include "common/except.h"
 #include "common/make_unique.h"
+#include "common/page_alloc.h"
 #include "common/pixel.h"
 #include "common/static_map.h"
 #include "common/zassert.h"
@@ -26,6 +27,7 @@ constexpr unsigned API_VERSION_2_0 = ZIMG_MAKE_API_VERSION(2, 0);
 constexpr unsigned API_VERSION_2_1 = ZIMG_MAKE_API_VERSION(2, 1);
 constexpr unsigned API_VERSION_2_2 = ZIMG_MAKE_API_VERSION(2, 2);
 constexpr unsigned API_VERSION_2_4 = ZIMG_MAKE_API_VERSION(2, 4);
+constexpr unsigned API_VERSION_2_5 = ZIMG_MAKE_API_VERSION(2, 5);
 
 #define API_VERSION_ASSERT(x) zassert_d((x) >= API_VERSION_2_0, "API version invalid")
 #define POINTER_ALIGNMENT_ASSERT(x) zassert_d(!(x) || reinterpret_cast<uintptr_t>(x) % zimg::ALIGNMENT_RELAXED == 0, "pointer not aligned")
@@ -204,6 +206,20 @@ zimg::graph::GraphBuilder::AlphaType translate_alpha(zimg_alpha_type_e alpha)
 	return search_enum_map(map, alpha, "unrecognized alpha type");
 }
 
+zimg::graph::GraphBuilder::Packing translate_packing(zimg_packing_e packing)
+{
+	using zimg::graph::GraphBuilder;
+
+	static SM_CONSTEXPR_14 const zimg::static_map<zimg_packing_e, GraphBuilder::Packing, 5> map{
+		{ ZIMG_PACKING_PLANAR,          GraphBuilder::Packing::PLANAR },
+		{ ZIMG_PACKING_INTERLEAVED,     GraphBuilder::Packing::INTERLEAVED },
+		{ ZIMG_PACKING_INTERLEAVED_BGR, GraphBuilder::Packing::INTERLEAVED_BGR },
+		{ ZIMG_PACKING_SEMIPLANAR,      GraphBuilder::Packing::SEMIPLANAR },
+		{ ZIMG_PACKING_SEMIPLANAR_MSB,  GraphBuilder::Packing::SEMIPLANAR_MSB },
+	};
+	return search_enum_map(map, packing, "unrecognized packing");
+}
+
 zimg::graph::GraphBuilder::FieldParity translate_field_parity(zimg_field_parity_e field)
 {
 	using zimg::graph::GraphBuilder;
@@ -321,6 +337,19 @@ zimg::depth::DitherType translate_dither(zimg_dither_type_e dither)
 	return search_enum_map(map, dither, "unrecognized dither type");
 }
 
+zimg::colorspace::ToneMapping translate_tone_mapping(zimg_tone_mapping_e tone_mapping)
+{
+	using zimg::colorspace::ToneMapping;
+
+	static SM_CONSTEXPR_14 const zimg::static_map<zimg_tone_mapping_e, ToneMapping, 4> map{
+		{ ZIMG_TONE_MAPPING_NONE,     ToneMapping::NONE },
+		{ ZIMG_TONE_MAPPING_BT2390,   ToneMapping::BT2390 },
+		{ ZIMG_TONE_MAPPING_HABLE,    ToneMapping::HABLE },
+		{ ZIMG_TONE_MAPPING_REINHARD, ToneMapping::REINHARD },
+	};
+	return search_enum_map(map, tone_mapping, "unrecognized tone mapping");
+}
+
 std::unique_ptr<zimg::resize::Filter> translate_resize_filter(zimg_resample_filter_e filter_type, double param_a, double param_b)
 {
 	if (filter_type == ZIMG_RESIZE_UNRESIZE)
@@ -342,6 +371,8 @@ std::unique_ptr<zimg::resize::Filter> translate_resize_filter(zimg_resample_filt
 			return ztd::make_unique<zimg::resize::Spline36Filter>();
 		case ZIMG_RESIZE_SPLINE64:
 			return ztd::make_unique<zimg::resize::Spline64Filter>();
+		case ZIMG_RESIZE_AREA:
+			return ztd::make_unique<zimg::resize::AreaFilter>();
 		case ZIMG_RESIZE_LANCZOS:
 			param_a = std::isnan(param_a) ? zimg::resize::LanczosFilter::DEFAULT_TAPS : std::max(param_a, 1.0);
 			return ztd::make_unique<zimg::resize::LanczosFilter>(static_cast<unsigned>(param_a));
@@ -416,6 +447,8 @@ void import_graph_state_common(const zimg_image_format &src, zimg::graph::GraphB
 	}
 	if (src.version >= API_VERSION_2_4)
 		out->alpha = translate_alpha(src.alpha);
+	if (src.version >= API_VERSION_2_5)
+		out->packing = translate_packing(src.packing);
 }
 
 std::pair<zimg::graph::GraphBuilder::state, zimg::graph::GraphBuilder::state> import_graph_state(const zimg_image_format &src, const zimg_image_format &dst)
@@ -466,6 +499,10 @@ zimg::graph::GraphBuilder::params import_graph_params(const zimg_graph_builder_p
 		params.filter = filters[0].get();
 		params.filter_uv = filters[1].get();
 		params.unresize = src.resample_filter == ZIMG_RESIZE_UNRESIZE;
+
+		// The legacy unresize mode inverts bilinear scaling on all planes.
+		if (params.unresize)
+			params.filter_uv = nullptr;
 		params.dither_type = translate_dither(src.dither_type);
 		params.cpu = translate_cpu(src.cpu_type);
 	}
@@ -473,10 +510,28 @@ zimg::graph::GraphBuilder::params import_graph_params(const zimg_graph_builder_p
 		params.peak_luminance = src.nominal_peak_luminance;
 		params.approximate_gamma = !!src.allow_approximate_gamma;
 	}
+	if (src.version >= API_VERSION_2_5) {
+		params.approximate_colorspace = !!src.allow_approximate_colorspace;
+		params.tone_mapping = translate_tone_mapping(src.tone_mapping);
+		params.source_peak_luminance = src.source_peak_luminance;
+		params.unresize = params.unresize || !!src.unresize;
+	}
 
 	return params;
 }
 
+zimg::PageAllocOptions translate_alloc_flags(unsigned flags, int numa_node)
+{
+	if (flags & ~static_cast<unsigned>(ZIMG_ALLOC_TRANSPARENT_HUGE_PAGES | ZIMG_ALLOC_HUGE_PAGES))
+		zimg::error::throw_<zimg::error::EnumOutOfRange>("unrecognized allocation flags");
+
+	zimg::PageAllocOptions options{};
+	options.transparent_huge_pages = !!(flags & ZIMG_ALLOC_TRANSPARENT_HUGE_PAGES);
+	options.huge_pages = !!(flags & ZIMG_ALLOC_HUGE_PAGES);
+	options.numa_node = numa_node;
+	return options;
+}
+
 } // namespace
 
 
@@ -566,6 +621,22 @@ zimg_error_code_e zimg_filter_graph_get_output_buffering(const zimg_filter_graph
 	EX_END
 }
 
+zimg_error_code_e zimg_filter_graph_get_passthrough_planes(const zimg_filter_graph *ptr, unsigned *out)
+{
+	zassert_d(ptr, "null pointer");
+	zassert_d(out, "null pointer");
+
+	EX_BEGIN
+	zimg::graph::plane_mask planes = assert_dynamic_type<const zimg::graph::FilterGraph>(ptr)->get_passthrough_planes();
+
+	*out = 0;
+	for (int p = 0; p < zimg::graph::PLANE_NUM; ++p) {
+		if (planes[p])
+			*out |= 1U << p;
+	}
+	EX_END
+}
+
 zimg_error_code_e zimg_filter_graph_process(const zimg_filter_graph *ptr, const zimg_image_buffer_const *src, const zimg_image_buffer *dst, void *tmp,
                                              zimg_filter_graph_callback unpack_cb, void *unpack_user,
                                              zimg_filter_graph_callback pack_cb, void *pack_user)
@@ -639,6 +710,34 @@ zimg_error_code_e zimg_filter_graph_process(const zimg_filter_graph *ptr, const
 	EX_END
 }
 
+void *zimg_buffer_alloc(size_t size, unsigned flags, int numa_node)
+{
+	try {
+		return zimg::page_alloc(size, translate_alloc_flags(flags, numa_node));
+	} catch (...) {
+		handle_exception(std::current_exception());
+		return nullptr;
+	}
+}
+
+void *zimg_filter_graph_alloc_tmp(const zimg_filter_graph *ptr, unsigned flags, int numa_node)
+{
+	zassert_d(ptr, "null pointer");
+
+	try {
+		size_t size = assert_dynamic_type<const zimg::graph::FilterGraph>(ptr)->get_tmp_size();
+		return zimg::page_alloc(size, translate_alloc_flags(flags, numa_node));
+	} catch (...) {
+		handle_exception(std::current_exception());
+		return nullptr;
+	}
+}
+
+void zimg_buffer_free(void *ptr)
+{
+	zimg::page_free(ptr);
+}
+
 #undef EX_BEGIN
 #undef EX_END
 
@@ -677,6 +776,9 @@ void zimg_image_format_default(zimg_image_format *ptr, unsigned version)
 	if (version >= API_VERSION_2_4) {
 		ptr->alpha = ZIMG_ALPHA_NONE;
 	}
+	if (version >= API_VERSION_2_5) {
+		ptr->packing = ZIMG_PACKING_PLANAR;
+	}
 }
 
 void zimg_graph_builder_params_default(zimg_graph_builder_params *ptr, unsigned version)
@@ -703,6 +805,12 @@ void zimg_graph_builder_params_default(zimg_graph_builder_params *ptr, unsigned
 		ptr->nominal_peak_luminance = NAN;
 		ptr->allow_approximate_gamma = 0;
 	}
+	if (version >= API_VERSION_2_5) {
+		ptr->allow_approximate_colorspace = 0;
+		ptr->tone_mapping = ZIMG_TONE_MAPPING_NONE;
+		ptr->source_peak_luminance = NAN;
+		ptr->unresize = 0;
+	}
 }
 
 zimg_filter_graph *zimg_filter_graph_build(const zimg_image_format *src_format, const zimg_image_format *dst_format, const zimg_graph_builder_params *params)
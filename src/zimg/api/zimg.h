@@ -29,7 +29,7 @@ extern "C" {
  */
 #define ZIMG_MAKE_API_VERSION(x, y) (((x) << 8) | (y))
 #define ZIMG_API_VERSION_MAJOR 2
-#define ZIMG_API_VERSION_MINOR 4
+#define ZIMG_API_VERSION_MINOR 5
 #define ZIMG_API_VERSION ZIMG_MAKE_API_VERSION(ZIMG_API_VERSION_MAJOR, ZIMG_API_VERSION_MINOR)
 
 /**
@@ -223,6 +223,22 @@ typedef enum zimg_alpha_type_e {
 	ZIMG_ALPHA_PREMULTIPLIED = 2  /**< Premultiplied alpha. */
 } zimg_alpha_type_e;
 
+/**
+ * Memory layout constants.
+ *
+ * Interleaved images store all color components, followed by alpha if
+ * present, in the first plane (e.g. RGB24, RGBA, or BGRA). Semi-planar images
+ * store luma in the first plane and interleaved Cb/Cr in the second plane
+ * (e.g. NV12). Alpha, if present, is stored in the fourth plane.
+ */
+typedef enum zimg_packing_e {
+	ZIMG_PACKING_PLANAR          = 0, /**< Separate planes. */
+	ZIMG_PACKING_INTERLEAVED     = 1, /**< Components interleaved in plane order. */
+	ZIMG_PACKING_INTERLEAVED_BGR = 2, /**< RGB components interleaved in B-G-R(-A) order. */
+	ZIMG_PACKING_SEMIPLANAR      = 3, /**< Interleaved chroma plane. */
+	ZIMG_PACKING_SEMIPLANAR_MSB  = 4  /**< As SEMIPLANAR, with WORD samples in the most significant bits (e.g. P010). */
+} zimg_packing_e;
+
 /**
  * Field parity constants.
  *
@@ -358,6 +374,16 @@ typedef enum zimg_dither_type_e {
 	ZIMG_DITHER_ERROR_DIFFUSION = 3  /**< Floyd-Steinberg error diffusion. */
 } zimg_dither_type_e;
 
+/**
+ * Tone mapping operator constants.
+ */
+typedef enum zimg_tone_mapping_e {
+	ZIMG_TONE_MAPPING_NONE     = 0, /**< Clip HDR highlights. */
+	ZIMG_TONE_MAPPING_BT2390   = 1, /**< ITU-R BT.2390 EETF (Hermite spline in ST.2084 domain). */
+	ZIMG_TONE_MAPPING_HABLE    = 2, /**< Filmic curve by John Hable. */
+	ZIMG_TONE_MAPPING_REINHARD = 3  /**< Extended Reinhard operator. */
+} zimg_tone_mapping_e;
+
 /**
  * Resampling method constants.
  */
@@ -368,6 +394,7 @@ typedef enum zimg_resample_filter_e {
 	ZIMG_RESIZE_SPLINE16 = 3, /**< "Spline16" filter from AviSynth. */
 	ZIMG_RESIZE_SPLINE36 = 4, /**< "Spline36" filter from AviSynth. */
 	ZIMG_RESIZE_SPLINE64 = 6, /**< "Spline64" filter from AviSynth. */
+	ZIMG_RESIZE_AREA     = 7, /**< Area-average (box) filter. Cost is independent of the scaling ratio. Since API 2.5. */
 	ZIMG_RESIZE_LANCZOS  = 5  /**< Lanczos resampling filter with variable number of taps. */
 } zimg_resample_filter_e;
 
@@ -461,6 +488,12 @@ typedef struct zimg_filter_graph zimg_filter_graph;
  * If the image is subsampled, a number of scanlines in units of the chroma
  * subsampling (e.g. 2 lines for 4:2:0) must be read.
  *
+ * The final filter in the graph writes directly to the output buffer. If the
+ * consumer of the image can be addressed as a {@link zimg_image_buffer}, such
+ * as a mapped hardware surface, the output callback can be used solely to
+ * signal completed scanlines, avoiding an additional copy. The output buffer
+ * is never read by the filter graph.
+ *
  * If the callback fails, processing will be aborted and a non-zero value will
  * be returned to the caller of {@link zimg_filter_graph_process}, but the
  * return code of the callback will not be propagated.
@@ -523,9 +556,28 @@ zimg_error_code_e zimg_filter_graph_get_input_buffering(const zimg_filter_graph
 ZIMG_VISIBILITY
 zimg_error_code_e zimg_filter_graph_get_output_buffering(const zimg_filter_graph *ptr, unsigned *out);
 
+/**
+ * Query the output planes which are unmodified copies of the input.
+ *
+ * Bit N of the result is set if plane N of the output is identical to plane N
+ * of the input. If the input and output buffers of such a plane have the same
+ * data pointer and stride, the plane is not processed, allowing images to be
+ * modified in place when only some planes are converted. Since API 2.5.
+ *
+ * @pre out != 0
+ * @param ptr graph handle
+ * @param[out] out set to the bitmask of passthrough planes
+ * @return error code
+ */
+ZIMG_VISIBILITY
+zimg_error_code_e zimg_filter_graph_get_passthrough_planes(const zimg_filter_graph *ptr, unsigned *out);
+
 /**
  * Process an image with the filter graph.
  *
+ * The input and output buffers must not overlap, except for planes reported
+ * by {@link zimg_filter_graph_get_passthrough_planes}.
+ *
  * @param ptr graph handle
  * @param[in] src input image buffer
  * @param[out] dst output image buffer
@@ -542,6 +594,60 @@ zimg_error_code_e zimg_filter_graph_process(const zimg_filter_graph *ptr, const
                                             zimg_filter_graph_callback pack_cb, void *pack_user);
 
 
+/**
+ * Memory allocation flags. Since API 2.5.
+ *
+ * Flags may be combined with bitwise OR.
+ */
+typedef enum zimg_alloc_flags_e {
+	ZIMG_ALLOC_DEFAULT                 = 0, /**< Default allocator. */
+	ZIMG_ALLOC_TRANSPARENT_HUGE_PAGES  = 1, /**< Advise the OS to back the buffer with huge pages, if supported. */
+	ZIMG_ALLOC_HUGE_PAGES              = 2  /**< Allocate from the reserved pool of 2 MB huge pages (Linux) or large pages (Windows). */
+} zimg_alloc_flags_e;
+
+/**
+ * Allocate a buffer suitable for image data or graph temporaries.
+ *
+ * The buffer is aligned to at least 64 bytes and is not initialized. If a
+ * NUMA node is specified, physical memory is preferentially allocated from
+ * that node when first written. NUMA placement is supported on Linux and
+ * Windows and is otherwise ignored. Since API 2.5.
+ *
+ * @param size size in bytes
+ * @param flags bitwise OR of {@link zimg_alloc_flags_e}
+ * @param numa_node preferred NUMA node, or negative for the system default
+ * @return pointer to buffer, or NULL on error
+ */
+ZIMG_VISIBILITY
+void *zimg_buffer_alloc(size_t size, unsigned flags, int numa_node);
+
+/**
+ * Allocate the temporary buffer required to execute the graph.
+ *
+ * The buffer size is given by {@link zimg_filter_graph_get_tmp_size}. Graph
+ * temporaries, including all intermediate line buffers, are laid out
+ * contiguously, so a single huge page typically covers an entire tile.
+ * Since API 2.5.
+ *
+ * @param ptr graph handle
+ * @param flags bitwise OR of {@link zimg_alloc_flags_e}
+ * @param numa_node preferred NUMA node, or negative for the system default
+ * @return pointer to buffer, or NULL on error
+ * @see zimg_buffer_alloc
+ */
+ZIMG_VISIBILITY
+void *zimg_filter_graph_alloc_tmp(const zimg_filter_graph *ptr, unsigned flags, int numa_node);
+
+/**
+ * Free a buffer allocated by {@link zimg_buffer_alloc} or
+ * {@link zimg_filter_graph_alloc_tmp}. Since API 2.5.
+ *
+ * @param ptr pointer to buffer, may be NULL
+ */
+ZIMG_VISIBILITY
+void zimg_buffer_free(void *ptr);
+
+
 /**
  * Image format descriptor.
  */
@@ -575,6 +681,7 @@ typedef struct zimg_image_format {
 	} active_region;
 
 	zimg_alpha_type_e alpha;                                  /**< Alpha channel (default ZIMG_ALPHA_NONE). Since API 2.4. */
+	zimg_packing_e packing;                                   /**< Memory layout (default ZIMG_PACKING_PLANAR). Since API 2.5. */
 } zimg_image_format;
 
 /**
@@ -630,6 +737,53 @@ typedef struct zimg_graph_builder_params {
 
 	/** Allow evaluating transfer functions at reduced precision (default false). */
 	char allow_approximate_gamma;
+
+	/**
+	 * Allow evaluating colorspace conversions through an interpolated 3D LUT
+	 * (default false).
+	 *
+	 * Conversions consisting of multiple steps are sampled on a regular grid
+	 * covering the nominal range of the input. Out-of-range pixels are clipped.
+	 * Conversions from linear light are always evaluated exactly.
+	 *
+	 * Since API 2.5.
+	 */
+	char allow_approximate_colorspace;
+
+	/**
+	 * Tone mapping operator (default ZIMG_TONE_MAPPING_NONE).
+	 *
+	 * Applied when converting from an HDR transfer function (ST.2084 or
+	 * ARIB STD-B67) to a non-linear SDR transfer function. The source peak
+	 * luminance is compressed into the nominal peak luminance. The curve is
+	 * applied to the maximum of the RGB components to preserve hue.
+	 *
+	 * Since API 2.5.
+	 */
+	zimg_tone_mapping_e tone_mapping;
+
+	/**
+	 * Peak luminance (cd/m^2) of the HDR source, used by tone mapping.
+	 *
+	 * Since API 2.5.
+	 *
+	 * The default value is NAN, which is interpreted as 1000 cd/m^2.
+	 */
+	double source_peak_luminance;
+
+	/**
+	 * Invert the resampling filter instead of applying it (default false).
+	 *
+	 * The input is assumed to have been upscaled from the dimensions of the
+	 * output using {@p resample_filter} and {@p resample_filter_uv}. The
+	 * original image is recovered by the method of least squares. The output
+	 * can not be larger than the input, and the active region must cover the
+	 * entire image. Integer images are processed without conversion to
+	 * floating point if the output is also integer.
+	 *
+	 * Since API 2.5.
+	 */
+	char unresize;
 } zimg_graph_builder_params;
 
 /**
@@ -57,6 +57,57 @@ std::unique_ptr<Operation> create_inverse_gamma_operation_arm(const TransferFunc
 	return ret;
 }
 
+std::unique_ptr<Operation> create_arib_b67_operation_arm(const Matrix3x3 &m, const OperationParams &params, CPUClass cpu)
+{
+	ARMCapabilities caps = query_arm_capabilities();
+	std::unique_ptr<Operation> ret;
+
+	if (cpu_is_autodetect(cpu)) {
+		if (!ret && caps.neon && caps.vfpv4)
+			ret = create_arib_b67_operation_neon(m, params);
+	} else {
+		if (!ret && cpu >= CPUClass::ARM_NEON)
+			ret = create_arib_b67_operation_neon(m, params);
+	}
+
+	return ret;
+}
+
+std::unique_ptr<Operation> create_inverse_arib_b67_operation_arm(const Matrix3x3 &m, const OperationParams &params, CPUClass cpu)
+{
+	ARMCapabilities caps = query_arm_capabilities();
+	std::unique_ptr<Operation> ret;
+
+	if (cpu_is_autodetect(cpu)) {
+		if (!ret && caps.neon && caps.vfpv4)
+			ret = create_inverse_arib_b67_operation_neon(m, params);
+	} else {
+		if (!ret && cpu >= CPUClass::ARM_NEON)
+			ret = create_inverse_arib_b67_operation_neon(m, params);
+	}
+
+	return ret;
+}
+
+f16c_func select_f16c_func_arm(bool to_half, CPUClass cpu)
+{
+	f16c_func func = nullptr;
+
+#if !defined(_MSC_VER) || defined(_M_ARM64)
+	ARMCapabilities caps = query_arm_capabilities();
+
+	if (cpu_is_autodetect(cpu)) {
+		if (!func && caps.neon && caps.vfpv4)
+			func = to_half ? float_to_half_neon : half_to_float_neon;
+	} else {
+		if (!func && cpu >= CPUClass::ARM_NEON)
+			func = to_half ? float_to_half_neon : half_to_float_neon;
+	}
+#endif
+
+	return func;
+}
+
 } // namespace colorspace
 } // namespace zimg
 
@@ -6,6 +6,7 @@
 #define ZIMG_COLORSPACE_ARM_OPERATION_IMPL_ARM_H_
 
 #include <memory>
+#include "colorspace/operation.h"
 
 namespace zimg {
 
@@ -16,7 +17,6 @@ namespace colorspace {
 struct Matrix3x3;
 struct OperationParams;
 struct TransferFunction;
-class Operation;
 
 std::unique_ptr<Operation> create_matrix_operation_neon(const Matrix3x3 &m);
 
@@ -30,6 +30,19 @@ std::unique_ptr<Operation> create_inverse_gamma_operation_neon(const TransferFun
 
 std::unique_ptr<Operation> create_inverse_gamma_operation_arm(const TransferFunction &transfer, const OperationParams &params, CPUClass cpu);
 
+std::unique_ptr<Operation> create_arib_b67_operation_neon(const Matrix3x3 &m, const OperationParams &params);
+
+std::unique_ptr<Operation> create_arib_b67_operation_arm(const Matrix3x3 &m, const OperationParams &params, CPUClass cpu);
+
+std::unique_ptr<Operation> create_inverse_arib_b67_operation_neon(const Matrix3x3 &m, const OperationParams &params);
+
+std::unique_ptr<Operation> create_inverse_arib_b67_operation_arm(const Matrix3x3 &m, const OperationParams &params, CPUClass cpu);
+
+void half_to_float_neon(const void *src, void *dst, unsigned left, unsigned right);
+void float_to_half_neon(const void *src, void *dst, unsigned left, unsigned right);
+
+f16c_func select_f16c_func_arm(bool to_half, CPUClass cpu);
+
 } // namespace colorspace
 } // namespace zimg
 
@@ -1,101 +1,103 @@
 #ifdef ZIMG_ARM
 
 #include <algorithm>
+#include <cfloat>
 #include <cstdint>
+#include <utility>
 #include <vector>
 #include <arm_neon.h>
 #include "common/align.h"
 #include "common/ccdep.h"
 #include "common/make_unique.h"
+#include "colorspace/colorspace.h"
 #include "colorspace/gamma.h"
+#include "colorspace/gamma_constants.h"
+#include "colorspace/matrix3.h"
 #include "colorspace/operation.h"
 #include "colorspace/operation_impl.h"
 #include "operation_impl_arm.h"
 
 #include "common/arm/neon_util.h"
 
-#if defined(_M_ARM) || defined(__arm__)
-  #define vcvtnq_s32_f32_(x) vcvtq_s32_f32(vaddq_f32(x, vdupq_n_f32(0.49999997f)))
-#else
-  #define vcvtnq_s32_f32_ vcvtnq_s32_f32
-#endif
-
 namespace zimg {
 namespace colorspace {
 
 namespace {
 
-constexpr unsigned LUT_DEPTH = 16;
+inline FORCE_INLINE float32x4_t lut_interpolate_neon(const float *lut, uint32x4_t xi, float32x4_t t)
+{
+	uint32_t idx[4];
+	float32x4_t v0, v1;
+
+	vst1q_u32(idx, xi);
+	v0 = vld1q_lane_f32(lut + idx[0], vdupq_n_f32(0.0f), 0);
+	v0 = vld1q_lane_f32(lut + idx[1], v0, 1);
+	v0 = vld1q_lane_f32(lut + idx[2], v0, 2);
+	v0 = vld1q_lane_f32(lut + idx[3], v0, 3);
+	v1 = vld1q_lane_f32(lut + idx[0] + 1, vdupq_n_f32(0.0f), 0);
+	v1 = vld1q_lane_f32(lut + idx[1] + 1, v1, 1);
+	v1 = vld1q_lane_f32(lut + idx[2] + 1, v1, 2);
+	v1 = vld1q_lane_f32(lut + idx[3] + 1, v1, 3);
+
+	return vfmaq_f32(v0, vsubq_f32(v1, v0), t);
+}
 
-void to_linear_lut_filter_line(const float *RESTRICT lut, unsigned lut_depth, const float *src, float *dst, unsigned left, unsigned right)
+inline FORCE_INLINE float32x4_t to_linear_lut_neon(const float *lut, float32x4_t x)
 {
-	unsigned vec_left = ceil_n(left, 8);
-	unsigned vec_right = floor_n(right, 8);
+	const float lut_limit = static_cast<float>(1U << TO_LINEAR_LUT_DEPTH);
+	uint32x4_t xi;
+	float32x4_t t;
 
-	const int32_t lut_limit = static_cast<int32_t>(1U) << lut_depth;
+	// Clamp to the table range.
+	x = vfmaq_f32(vdupq_n_f32(0.25f * lut_limit), x, vdupq_n_f32(0.5f * lut_limit));
+	x = vmaxq_f32(x, vdupq_n_f32(0.0f));
+	x = vminq_f32(x, vdupq_n_f32(lut_limit));
 
-	const float32x4_t scale = vdupq_n_f32(0.5f * lut_limit);
-	const float32x4_t offset = vdupq_n_f32(0.25f * lut_limit);
-	const int32x4_t zero = vdupq_n_s32(0);
-	const int32x4_t limit = vdupq_n_s32(lut_limit);
+	xi = vcvtq_u32_f32(x);
+	t = vsubq_f32(x, vcvtq_f32_u32(xi));
 
-	for (unsigned j = left; j < vec_left; ++j) {
-		float32x4_t x = vdupq_n_f32(src[j]);
-		int idx = vgetq_lane_s32(vcvtnq_s32_f32_(vfmaq_f32(offset, x, scale)), 0);
-		dst[j] = lut[std::min(std::max(idx, 0), lut_limit)];
-	}
-	for (unsigned j = vec_left; j < vec_right; j += 4) {
-		float32x4_t x;
-		int32x4_t xi;
-
-		x = vld1q_f32(src + j);
-		x = vfmaq_f32(offset, x, scale);
-		xi = vcvtnq_s32_f32_(x);
-		xi = vmaxq_s32(xi, zero);
-		xi = vminq_s32(xi, limit);
-
-		dst[j + 0] = lut[vgetq_lane_s32(xi, 0)];
-		dst[j + 1] = lut[vgetq_lane_s32(xi, 1)];
-		dst[j + 2] = lut[vgetq_lane_s32(xi, 2)];
-		dst[j + 3] = lut[vgetq_lane_s32(xi, 3)];
-	}
-	for (unsigned j = vec_right; j < right; ++j) {
-		float32x4_t x = vdupq_n_f32(src[j]);
-		int idx = vgetq_lane_s32(vcvtnq_s32_f32_(vfmaq_f32(offset, x, scale)), 0);
-		dst[j] = lut[std::min(std::max(idx, 0), lut_limit)];
-	}
+	return lut_interpolate_neon(lut, xi, t);
 }
 
-#if !defined(_MSC_VER) || defined(_M_ARM64)
-void to_gamma_lut_filter_line(const float *RESTRICT lut, const float *src, float *dst, unsigned left, unsigned right)
+inline FORCE_INLINE float32x4_t to_gamma_lut_neon(const float *lut, float32x4_t x)
+{
+	uint32x4_t xi;
+	float32x4_t t;
+
+	// Clamp to the range of finite numbers.
+	x = vmaxq_f32(x, vdupq_n_f32(-FLT_MAX));
+	x = vminq_f32(x, vdupq_n_f32(FLT_MAX));
+
+	// Index by the upper half of the float and interpolate by the lower half.
+	xi = vreinterpretq_u32_f32(x);
+	t = vcvtq_f32_u32(vandq_u32(xi, vdupq_n_u32(0xFFFF)));
+	t = vmulq_f32(t, vdupq_n_f32(1.0f / 65536.0f));
+	xi = vshrq_n_u32(xi, 16);
+
+	return lut_interpolate_neon(lut, xi, t);
+}
+
+template <bool Inverse>
+void gamma_lut_filter_line(const float *RESTRICT lut, const float *src, float *dst, unsigned left, unsigned right)
 {
 	unsigned vec_left = ceil_n(left, 4);
 	unsigned vec_right = floor_n(right, 4);
 
-	for (unsigned j = left; j < vec_left; ++j) {
-		float32x4_t x = vdupq_n_f32(src[j]);
-		int idx = vget_lane_u16(vreinterpret_u16_f16(vcvt_f16_f32(x)), 0);
-		dst[j] = lut[idx];
+	auto eval = [=](float32x4_t x) { return Inverse ? to_linear_lut_neon(lut, x) : to_gamma_lut_neon(lut, x); };
+
+	if (left != vec_left) {
+		float32x4_t x = eval(vld1q_f32(src + vec_left - 4));
+		neon_store_idxhi_f32(dst + vec_left - 4, x, left % 4);
 	}
 	for (unsigned j = vec_left; j < vec_right; j += 4) {
-		float32x4_t x;
-		uint16x4_t xi;
-
-		x = vld1q_f32(src + j);
-		xi = vreinterpret_u16_f16(vcvt_f16_f32(x));
-
-		dst[j + 0] = lut[vget_lane_u16(xi, 0)];
-		dst[j + 1] = lut[vget_lane_u16(xi, 1)];
-		dst[j + 2] = lut[vget_lane_u16(xi, 2)];
-		dst[j + 3] = lut[vget_lane_u16(xi, 3)];
+		float32x4_t x = eval(vld1q_f32(src + j));
+		vst1q_f32(dst + j, x);
 	}
-	for (unsigned j = vec_right; j < right; ++j) {
-		float32x4_t x = vdupq_n_f32(src[j]);
-		int idx = vget_lane_u16(vreinterpret_u16_f16(vcvt_f16_f32(x)), 0);
-		dst[j] = lut[idx];
+	if (right != vec_right) {
+		float32x4_t x = eval(vld1q_f32(src + vec_right));
+		neon_store_idxlo_f32(dst + vec_right, x, right % 4);
 	}
 }
-#endif // !defined(_MSC_VER) || defined(_M_ARM64)
 
 
 inline FORCE_INLINE void matrix_filter_line_neon_xiter(unsigned j, const float *src0, const float *src1, const float *src2,
@@ -178,51 +180,205 @@ void matrix_filter_line_neon(const float *matrix, const float * const * RESTRICT
 }
 
 
-class ToLinearLutOperationNeon final : public Operation {
-	std::vector<float> m_lut;
-	unsigned m_lut_depth;
-public:
-	ToLinearLutOperationNeon(gamma_func func, unsigned lut_depth, float postscale) :
-		m_lut((1UL << lut_depth) + 1),
-		m_lut_depth{ lut_depth }
-	{
-		// Allocate an extra LUT entry so that indexing can be done by multipying by a power of 2.
-		for (size_t i = 0; i < m_lut.size(); ++i) {
-			float x = static_cast<float>(i) / (1 << lut_depth) * 2.0f - 0.5f;
-			m_lut[i] = func(x) * postscale;
-		}
+#if defined(_M_ARM64) || defined(__aarch64__)
+// log2(x) for positive normal x.
+inline FORCE_INLINE float32x4_t log2_ps_neon(float32x4_t x)
+{
+	uint32x4_t bits = vreinterpretq_u32_f32(x);
+	float32x4_t mant, exp, t, p;
+	uint32x4_t mask;
+
+	// Decompose into mantissa on [sqrt(0.5), sqrt(2)) and exponent.
+	mant = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x007FFFFF)), vdupq_n_u32(0x3F800000)));
+	exp = vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), vdupq_n_s32(127)));
+	mask = vcgeq_f32(mant, vdupq_n_f32(1.41421356f));
+	mant = vbslq_f32(mask, vmulq_f32(mant, vdupq_n_f32(0.5f)), mant);
+	exp = vaddq_f32(exp, vreinterpretq_f32_u32(vandq_u32(mask, vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))));
+
+	t = vsubq_f32(mant, vdupq_n_f32(1.0f));
+	p = vdupq_n_f32(constants::LOG2_HORNER[0]);
+	p = vfmaq_f32(vdupq_n_f32(constants::LOG2_HORNER[1]), p, t);
+	p = vfmaq_f32(vdupq_n_f32(constants::LOG2_HORNER[2]), p, t);
+	p = vfmaq_f32(vdupq_n_f32(constants::LOG2_HORNER[3]), p, t);
+	p = vfmaq_f32(vdupq_n_f32(constants::LOG2_HORNER[4]), p, t);
+	p = vfmaq_f32(vdupq_n_f32(constants::LOG2_HORNER[5]), p, t);
+	p = vfmaq_f32(vdupq_n_f32(constants::LOG2_HORNER[6]), p, t);
+	p = vfmaq_f32(vdupq_n_f32(constants::LOG2_HORNER[7]), p, t);
+
+	return vfmaq_f32(exp, p, t);
+}
+
+inline FORCE_INLINE float32x4_t exp2_ps_neon(float32x4_t x)
+{
+	float32x4_t n, f, p;
+	int32x4_t e;
+
+	// Clamp to the range of normal numbers. Also removes NaN.
+	x = vmaxnmq_f32(x, vdupq_n_f32(-126.0f));
+	x = vminq_f32(x, vdupq_n_f32(126.0f));
+
+	// Split into integer and fractional part on [-0.5, 0.5].
+	n = vrndnq_f32(x);
+	f = vsubq_f32(x, n);
+
+	p = vdupq_n_f32(constants::EXP2_HORNER[0]);
+	p = vfmaq_f32(vdupq_n_f32(constants::EXP2_HORNER[1]), p, f);
+	p = vfmaq_f32(vdupq_n_f32(constants::EXP2_HORNER[2]), p, f);
+	p = vfmaq_f32(vdupq_n_f32(constants::EXP2_HORNER[3]), p, f);
+	p = vfmaq_f32(vdupq_n_f32(constants::EXP2_HORNER[4]), p, f);
+	p = vfmaq_f32(vdupq_n_f32(constants::EXP2_HORNER[5]), p, f);
+	p = vfmaq_f32(vdupq_n_f32(constants::EXP2_HORNER[6]), p, f);
+
+	// Construct 2^n in the exponent field.
+	e = vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(n), vdupq_n_s32(127)), 23);
+	return vmulq_f32(p, vreinterpretq_f32_s32(e));
+}
+
+inline FORCE_INLINE float32x4_t arib_b67_oetf_neon(float32x4_t x)
+{
+	float32x4_t lo, hi;
+	uint32x4_t mask;
+
+	// Also removes NaN.
+	x = vmaxnmq_f32(x, vdupq_n_f32(0.0f));
+	mask = vcleq_f32(x, vdupq_n_f32(1.0f / 12.0f));
+
+	// sqrt(3 * x)
+	lo = vsqrtq_f32(vmulq_f32(x, vdupq_n_f32(3.0f)));
+
+	// a * ln(12 * x - b) + c
+	hi = vfmaq_f32(vdupq_n_f32(-constants::ARIB_B67_B), x, vdupq_n_f32(12.0f));
+	hi = log2_ps_neon(hi);
+	hi = vfmaq_f32(vdupq_n_f32(constants::ARIB_B67_C), hi, vdupq_n_f32(constants::ARIB_B67_A * 0.693147181f));
+
+	return vbslq_f32(mask, lo, hi);
+}
+
+inline FORCE_INLINE float32x4_t arib_b67_inverse_oetf_neon(float32x4_t x)
+{
+	float32x4_t lo, hi;
+	uint32x4_t mask;
+
+	x = vmaxnmq_f32(x, vdupq_n_f32(0.0f));
+	mask = vcleq_f32(x, vdupq_n_f32(0.5f));
+
+	// x^2 / 3
+	lo = vmulq_f32(vmulq_f32(x, x), vdupq_n_f32(1.0f / 3.0f));
+
+	// (exp((x - c) / a) + b) / 12
+	hi = vfmaq_f32(vdupq_n_f32(-1.442695041f * constants::ARIB_B67_C / constants::ARIB_B67_A), x, vdupq_n_f32(1.442695041f / constants::ARIB_B67_A));
+	hi = exp2_ps_neon(hi);
+	hi = vmulq_f32(vaddq_f32(hi, vdupq_n_f32(constants::ARIB_B67_B)), vdupq_n_f32(1.0f / 12.0f));
+
+	return vbslq_f32(mask, lo, hi);
+}
+
+template <bool Inverse>
+inline FORCE_INLINE void arib_b67_filter_line_neon_xiter(unsigned j, const float *src0, const float *src1, const float *src2,
+                                                         const float32x4_t &kr, const float32x4_t &kg, const float32x4_t &kb, const float32x4_t &scale,
+                                                         float32x4_t &out0, float32x4_t &out1, float32x4_t &out2)
+{
+	float32x4_t r = vld1q_f32(src0 + j);
+	float32x4_t g = vld1q_f32(src1 + j);
+	float32x4_t b = vld1q_f32(src2 + j);
+	float32x4_t y;
+
+	if (Inverse) {
+		r = arib_b67_inverse_oetf_neon(r);
+		g = arib_b67_inverse_oetf_neon(g);
+		b = arib_b67_inverse_oetf_neon(b);
+
+		// ys^(gamma - 1)
+		y = vmulq_f32(kr, r);
+		y = vfmaq_f32(y, kg, g);
+		y = vfmaq_f32(y, kb, b);
+		y = vmaxnmq_f32(y, vdupq_n_f32(FLT_MIN));
+		y = exp2_ps_neon(vmulq_f32(log2_ps_neon(y), vdupq_n_f32(0.2f)));
+		y = vmulq_f32(y, scale);
+
+		out0 = vmulq_f32(r, y);
+		out1 = vmulq_f32(g, y);
+		out2 = vmulq_f32(b, y);
+	} else {
+		r = vmulq_f32(r, scale);
+		g = vmulq_f32(g, scale);
+		b = vmulq_f32(b, scale);
+
+		// yd^((1 - gamma) / gamma)
+		y = vmulq_f32(kr, r);
+		y = vfmaq_f32(y, kg, g);
+		y = vfmaq_f32(y, kb, b);
+		y = vmaxnmq_f32(y, vdupq_n_f32(FLT_MIN));
+		y = exp2_ps_neon(vmulq_f32(log2_ps_neon(y), vdupq_n_f32(-0.2f / 1.2f)));
+
+		out0 = arib_b67_oetf_neon(vmulq_f32(r, y));
+		out1 = arib_b67_oetf_neon(vmulq_f32(g, y));
+		out2 = arib_b67_oetf_neon(vmulq_f32(b, y));
 	}
+}
 
-	void process(const float * const *src, float * const *dst, unsigned left, unsigned right) const override
-	{
-		to_linear_lut_filter_line(m_lut.data(), m_lut_depth, src[0], dst[0], left, right);
-		to_linear_lut_filter_line(m_lut.data(), m_lut_depth, src[1], dst[1], left, right);
-		to_linear_lut_filter_line(m_lut.data(), m_lut_depth, src[2], dst[2], left, right);
+template <bool Inverse>
+void arib_b67_filter_line_neon(const float *coeffs, const float * const * RESTRICT src, float * const * RESTRICT dst, unsigned left, unsigned right)
+{
+	const float *src0 = src[0];
+	const float *src1 = src[1];
+	const float *src2 = src[2];
+	float *dst0 = dst[0];
+	float *dst1 = dst[1];
+	float *dst2 = dst[2];
+
+	const float32x4_t kr = vdupq_n_f32(coeffs[0]);
+	const float32x4_t kg = vdupq_n_f32(coeffs[1]);
+	const float32x4_t kb = vdupq_n_f32(coeffs[2]);
+	const float32x4_t scale = vdupq_n_f32(coeffs[3]);
+	float32x4_t out0, out1, out2;
+
+	unsigned vec_left = ceil_n(left, 4);
+	unsigned vec_right = floor_n(right, 4);
+
+#define XITER arib_b67_filter_line_neon_xiter<Inverse>
+#define XARGS src0, src1, src2, kr, kg, kb, scale, out0, out1, out2
+	if (left != vec_left) {
+		XITER(vec_left - 4, XARGS);
+
+		neon_store_idxhi_f32(dst0 + vec_left - 4, out0, left % 4);
+		neon_store_idxhi_f32(dst1 + vec_left - 4, out1, left % 4);
+		neon_store_idxhi_f32(dst2 + vec_left - 4, out2, left % 4);
 	}
-};
 
-#if !defined(_MSC_VER) || defined(_M_ARM64)
-class ToGammaLutOperationNeon final : public Operation {
+	for (unsigned j = vec_left; j < vec_right; j += 4) {
+		XITER(j, XARGS);
+
+		vst1q_f32(dst0 + j, out0);
+		vst1q_f32(dst1 + j, out1);
+		vst1q_f32(dst2 + j, out2);
+	}
+
+	if (right != vec_right) {
+		XITER(vec_right, XARGS);
+
+		neon_store_idxlo_f32(dst0 + vec_right, out0, right % 4);
+		neon_store_idxlo_f32(dst1 + vec_right, out1, right % 4);
+		neon_store_idxlo_f32(dst2 + vec_right, out2, right % 4);
+	}
+#undef XITER
+#undef XARGS
+}
+#endif // defined(_M_ARM64) || defined(__aarch64__)
+
+template <bool Inverse>
+class GammaLutOperationNeon final : public Operation {
 	std::vector<float> m_lut;
 public:
-	ToGammaLutOperationNeon(gamma_func func, float prescale) :
-		m_lut(static_cast<uint32_t>(UINT16_MAX) + 1)
-	{
-		for (size_t i = 0; i <= UINT16_MAX; ++i) {
-			uint16_t half = static_cast<uint16_t>(i);
-			float x = vgetq_lane_f32(vcvt_f32_f16(vreinterpret_f16_u16(vdup_n_u16(half))), 0);
-			m_lut[i] = func(x * prescale);
-		}
-	}
+	explicit GammaLutOperationNeon(std::vector<float> lut) : m_lut(std::move(lut)) {}
 
 	void process(const float * const *src, float * const *dst, unsigned left, unsigned right) const override
 	{
-		to_gamma_lut_filter_line(m_lut.data(), src[0], dst[0], left, right);
-		to_gamma_lut_filter_line(m_lut.data(), src[1], dst[1], left, right);
-		to_gamma_lut_filter_line(m_lut.data(), src[2], dst[2], left, right);
+		gamma_lut_filter_line<Inverse>(m_lut.data(), src[0], dst[0], left, right);
+		gamma_lut_filter_line<Inverse>(m_lut.data(), src[1], dst[1], left, right);
+		gamma_lut_filter_line<Inverse>(m_lut.data(), src[2], dst[2], left, right);
 	}
 };
-#endif // !defined(_MSC_VER) || defined(_M_ARM64)
 
 class MatrixOperationNeon final : public MatrixOperationImpl {
 public:
@@ -236,6 +392,22 @@ public:
 	}
 };
 
+#if defined(_M_ARM64) || defined(__aarch64__)
+template <bool Inverse>
+class AribB67OperationNeon final : public Operation {
+	float m_coeffs[4];
+public:
+	AribB67OperationNeon(const Matrix3x3 &m, float scale) :
+		m_coeffs{ static_cast<float>(m[0][0]), static_cast<float>(m[0][1]), static_cast<float>(m[0][2]), scale }
+	{}
+
+	void process(const float * const *src, float * const *dst, unsigned left, unsigned right) const override
+	{
+		arib_b67_filter_line_neon<Inverse>(m_coeffs, src, dst, left, right);
+	}
+};
+#endif // defined(_M_ARM64) || defined(__aarch64__)
+
 } // namespace
 
 
@@ -246,14 +418,10 @@ std::unique_ptr<Operation> create_matrix_operation_neon(const Matrix3x3 &m)
 
 std::unique_ptr<Operation> create_gamma_operation_neon(const TransferFunction &transfer, const OperationParams &params)
 {
-#if !defined(_MSC_VER) || defined(_M_ARM64)
 	if (!params.approximate_gamma)
 		return nullptr;
 
-	return ztd::make_unique<ToGammaLutOperationNeon>(transfer.to_gamma, transfer.to_gamma_scale);
-#else
-	return nullptr;
-#endif
+	return ztd::make_unique<GammaLutOperationNeon<false>>(make_to_gamma_lut(transfer));
 }
 
 std::unique_ptr<Operation> create_inverse_gamma_operation_neon(const TransferFunction &transfer, const OperationParams &params)
@@ -261,9 +429,82 @@ std::unique_ptr<Operation> create_inverse_gamma_operation_neon(const TransferFun
 	if (!params.approximate_gamma)
 		return nullptr;
 
-	return ztd::make_unique<ToLinearLutOperationNeon>(transfer.to_linear, LUT_DEPTH, transfer.to_linear_scale);
+	return ztd::make_unique<GammaLutOperationNeon<true>>(make_to_linear_lut(transfer));
+}
+
+std::unique_ptr<Operation> create_arib_b67_operation_neon(const Matrix3x3 &m, const OperationParams &params)
+{
+#if defined(_M_ARM64) || defined(__aarch64__)
+	TransferFunction func = select_transfer_function(TransferCharacteristics::ARIB_B67, params.peak_luminance, false);
+	return ztd::make_unique<AribB67OperationNeon<false>>(m, func.to_gamma_scale);
+#else
+	return nullptr;
+#endif
+}
+
+std::unique_ptr<Operation> create_inverse_arib_b67_operation_neon(const Matrix3x3 &m, const OperationParams &params)
+{
+#if defined(_M_ARM64) || defined(__aarch64__)
+	TransferFunction func = select_transfer_function(TransferCharacteristics::ARIB_B67, params.peak_luminance, false);
+	return ztd::make_unique<AribB67OperationNeon<true>>(m, func.to_linear_scale);
+#else
+	return nullptr;
+#endif
 }
 
+#if !defined(_MSC_VER) || defined(_M_ARM64)
+void half_to_float_neon(const void *src, void *dst, unsigned left, unsigned right)
+{
+	const __fp16 *src_p = static_cast<const __fp16 *>(src);
+	float *dst_p = static_cast<float *>(dst);
+
+	unsigned vec_left = ceil_n(left, 4);
+	unsigned vec_right = floor_n(right, 4);
+
+	if (left != vec_left) {
+		float32x4_t x = vcvt_f32_f16(vld1_f16(src_p + vec_left - 4));
+		neon_store_idxhi_f32(dst_p + vec_left - 4, x, left % 4);
+	}
+
+	for (unsigned j = vec_left; j < vec_right; j += 4) {
+		float32x4_t x = vcvt_f32_f16(vld1_f16(src_p + j));
+		vst1q_f32(dst_p + j, x);
+	}
+
+	if (right != vec_right) {
+		float32x4_t x = vcvt_f32_f16(vld1_f16(src_p + vec_right));
+		neon_store_idxlo_f32(dst_p + vec_right, x, right % 4);
+	}
+}
+
+void float_to_half_neon(const void *src, void *dst, unsigned left, unsigned right)
+{
+	const float *src_p = static_cast<const float *>(src);
+	uint16_t *dst_p = static_cast<uint16_t *>(dst);
+
+	unsigned vec_left = ceil_n(left, 4);
+	unsigned vec_right = floor_n(right, 4);
+
+	// Partial vectors are merged with 64-bit stores, so no samples outside the block are touched.
+	if (left != vec_left) {
+		uint16x4_t x = vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src_p + vec_left - 4)));
+		uint16x4_t mask = vreinterpret_u16_u8(vld1_u8(neon_mask_table[(left % 4) * 2]));
+		vst1_u16(dst_p + vec_left - 4, vbsl_u16(mask, vld1_u16(dst_p + vec_left - 4), x));
+	}
+
+	for (unsigned j = vec_left; j < vec_right; j += 4) {
+		uint16x4_t x = vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src_p + j)));
+		vst1_u16(dst_p + j, x);
+	}
+
+	if (right != vec_right) {
+		uint16x4_t x = vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src_p + vec_right)));
+		uint16x4_t mask = vreinterpret_u16_u8(vld1_u8(neon_mask_table[(right % 4) * 2]));
+		vst1_u16(dst_p + vec_right, vbsl_u16(mask, x, vld1_u16(dst_p + vec_right)));
+	}
+}
+#endif // !defined(_MSC_VER) || defined(_M_ARM64)
+
 } // namespace colorspace
 } // namespace zimg
 
@@ -1,5 +1,10 @@
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <memory>
+#include <vector>
+#include "common/align.h"
+#include "common/alloc.h"
 #include "common/cpuinfo.h"
 #include "common/except.h"
 #include "common/make_unique.h"
@@ -8,33 +13,96 @@
 #include "graph/basic_filter.h"
 #include "graph/image_filter.h"
 #include "colorspace.h"
+#include "gamma.h"
 #include "graph.h"
 #include "operation.h"
+#include "operation_impl.h"
 
 namespace zimg {
 namespace colorspace {
 
 namespace {
 
+// HALF samples are converted to FLOAT in blocks small enough to stay in L1.
+constexpr unsigned HALF_BLOCK = 512;
+
+template <class T>
+void integer_lut_line(const std::vector<float> &lut, const void *src, float *dst, unsigned left, unsigned right)
+{
+	const T *src_p = static_cast<const T *>(src);
+	const float *lut_p = lut.data();
+	size_t limit = lut.size() - 1;
+
+	std::transform(src_p + left, src_p + right, dst + left, [=](T x) { return lut_p[std::min(static_cast<size_t>(x), limit)]; });
+}
+
 class ColorspaceConversionImpl final : public graph::ImageFilterBase {
 	std::array<std::unique_ptr<Operation>, 6> m_operations;
+	std::vector<float> m_integer_lut;
+	f16c_func m_to_float;
+	f16c_func m_to_half;
 	unsigned m_width;
 	unsigned m_height;
+	PixelType m_type;
+
+	void apply_operations(const float * const *src, float * const *dst, unsigned left, unsigned right) const
+	{
+		if (!m_operations[0])
+			return;
+		m_operations[0]->process(src, dst, left, right);
+
+		if (!m_operations[1])
+			return;
+		m_operations[1]->process(dst, dst, left, right);
+
+		if (!m_operations[2])
+			return;
+		m_operations[2]->process(dst, dst, left, right);
+
+		if (!m_operations[3])
+			return;
+		m_operations[3]->process(dst, dst, left, right);
+
+		if (!m_operations[4])
+			return;
+		m_operations[4]->process(dst, dst, left, right);
+
+		if (!m_operations[5])
+			return;
+		m_operations[5]->process(dst, dst, left, right);
+	}
 public:
-	ColorspaceConversionImpl(unsigned width, unsigned height, const ColorspaceDefinition &in, const ColorspaceDefinition &out,
-	                         const OperationParams &params, CPUClass cpu) :
+	ColorspaceConversionImpl(unsigned width, unsigned height, PixelType type, std::vector<std::unique_ptr<Operation>> operations,
+	                         f16c_func to_float = nullptr, f16c_func to_half = nullptr) :
+		m_to_float{ to_float },
+		m_to_half{ to_half },
 		m_width{ width },
-		m_height{ height }
+		m_height{ height },
+		m_type{ type }
 	{
-		zassert_d(width <= pixel_max_width(PixelType::FLOAT), "overflow");
+		zassert_d(width <= pixel_max_width(type), "overflow");
+		zassert(!operations.empty(), "empty path");
+		zassert(operations.size() <= 6, "too many operations");
+		zassert(type == PixelType::FLOAT || (m_to_float && m_to_half), "missing f16c function");
 
-		auto path = get_operation_path(in, out);
-		zassert(!path.empty(), "empty path");
-		zassert(path.size() <= 6, "too many operations");
+		std::move(operations.begin(), operations.end(), m_operations.begin());
+	}
 
-		for (size_t i = 0; i < path.size(); ++i) {
-			m_operations[i] = path[i](params, cpu);
-		}
+	ColorspaceConversionImpl(unsigned width, unsigned height, PixelType type, std::vector<std::unique_ptr<Operation>> operations,
+	                         std::vector<float> integer_lut) :
+		m_integer_lut(std::move(integer_lut)),
+		m_to_float{},
+		m_to_half{},
+		m_width{ width },
+		m_height{ height },
+		m_type{ type }
+	{
+		zassert_d(width <= pixel_max_width(PixelType::FLOAT), "overflow");
+		zassert(pixel_is_integer(type), "must be integer");
+		zassert(!m_integer_lut.empty(), "missing integer table");
+		zassert(operations.size() <= 6, "too many operations");
+
+		std::move(operations.begin(), operations.end(), m_operations.begin());
 	}
 
 	filter_flags get_flags() const override
@@ -42,7 +110,7 @@ public:
 		filter_flags flags{};
 
 		flags.same_row = true;
-		flags.in_place = true;
+		flags.in_place = !pixel_is_integer(m_type);
 		flags.color = true;
 
 		return flags;
@@ -50,42 +118,197 @@ public:
 
 	image_attributes get_image_attributes() const override
 	{
-		return{ m_width, m_height, PixelType::FLOAT };
+		return{ m_width, m_height, pixel_is_integer(m_type) ? PixelType::FLOAT : m_type };
 	}
 
-	void process(void *, const graph::ImageBuffer<const void> src[], const graph::ImageBuffer<void> dst[], void *, unsigned i, unsigned left, unsigned right) const override
+	size_t get_tmp_size(unsigned, unsigned) const override
 	{
-		const float *src_ptr[3];
-		float *dst_ptr[3];
+		return m_type == PixelType::HALF ? 3 * HALF_BLOCK * sizeof(float) : 0;
+	}
+
+	void process(void *, const graph::ImageBuffer<const void> src[], const graph::ImageBuffer<void> dst[], void *tmp, unsigned i, unsigned left, unsigned right) const override
+	{
+		if (pixel_is_integer(m_type)) {
+			float *dst_ptr[3];
+
+			for (unsigned p = 0; p < 3; ++p) {
+				dst_ptr[p] = static_cast<float *>(dst[p][i]);
+
+				if (m_type == PixelType::BYTE)
+					integer_lut_line<uint8_t>(m_integer_lut, src[p][i], dst_ptr[p], left, right);
+				else
+					integer_lut_line<uint16_t>(m_integer_lut, src[p][i], dst_ptr[p], left, right);
+			}
+
+			apply_operations(dst_ptr, dst_ptr, left, right);
+		} else if (m_type == PixelType::HALF) {
+			float *buf[3];
+
+			for (unsigned p = 0; p < 3; ++p) {
+				buf[p] = static_cast<float *>(tmp) + p * HALF_BLOCK;
+			}
+
+			for (unsigned j = floor_n(left, AlignmentOf<float>::value); j < right; j += HALF_BLOCK) {
+				unsigned block_left = std::max(j, left) - j;
+				unsigned block_right = std::min(j + HALF_BLOCK, right) - j;
+
+				for (unsigned p = 0; p < 3; ++p) {
+					m_to_float(static_cast<const uint16_t *>(src[p][i]) + j, buf[p], block_left, block_right);
+				}
+
+				apply_operations(buf, buf, block_left, block_right);
+
+				for (unsigned p = 0; p < 3; ++p) {
+					m_to_half(buf[p], static_cast<uint16_t *>(dst[p][i]) + j, block_left, block_right);
+				}
+			}
+		} else {
+			const float *src_ptr[3];
+			float *dst_ptr[3];
+
+			for (unsigned p = 0; p < 3; ++p) {
+				src_ptr[p] = static_cast<const float *>(src[p][i]);
+				dst_ptr[p] = static_cast<float *>(dst[p][i]);
+			}
+
+			apply_operations(src_ptr, dst_ptr, left, right);
+		}
+	}
+};
+
+bool is_hdr_transfer(TransferCharacteristics transfer)
+{
+	return transfer == TransferCharacteristics::ST_2084 || transfer == TransferCharacteristics::ARIB_B67;
+}
+
+// Tone mapping only applies when compressing an HDR signal into a display-
+// referred SDR signal with a lower peak.
+bool use_tone_mapping(const ColorspaceDefinition &in, const ColorspaceDefinition &out, double source_peak, double target_peak)
+{
+	return is_hdr_transfer(in.transfer) && !is_hdr_transfer(out.transfer) &&
+		out.transfer != TransferCharacteristics::LINEAR && out.transfer != TransferCharacteristics::UNSPECIFIED &&
+		source_peak > target_peak;
+}
+
+// Linear light is unbounded and can not be sampled on a finite grid. A single
+// operation is already no more expensive than the LUT.
+bool use_lut3d(const ColorspaceDefinition &in, size_t num_operations)
+{
+	return in.transfer != TransferCharacteristics::LINEAR && num_operations > 1;
+}
 
+// Evaluate the operations on a regular grid spanning the nominal range of the
+// input colorspace. Chroma-difference channels are centered at zero.
+Lut3D bake_lut3d(const std::vector<std::unique_ptr<Operation>> &operations, const ColorspaceDefinition &in, const ColorspaceDefinition &out)
+{
+	Lut3D lut{};
+	lut.size = is_hdr_transfer(in.transfer) || is_hdr_transfer(out.transfer) ? 65 : 33;
+
+	bool yuv = in.matrix != MatrixCoefficients::RGB && in.matrix != MatrixCoefficients::REC_2100_LMS;
+	float low[3] = { 0.0f, yuv ? -0.5f : 0.0f, yuv ? -0.5f : 0.0f };
+
+	unsigned size = lut.size;
+	unsigned count = size * size * size;
+	AlignedVector<float> planes[3];
+
+	for (unsigned p = 0; p < 3; ++p) {
+		lut.scale[p] = static_cast<float>(size - 1);
+		lut.offset[p] = -low[p] * lut.scale[p];
+		planes[p].resize(ceil_n(count, AlignmentOf<float>::value));
+	}
+
+	for (unsigned k = 0; k < size; ++k) {
+		for (unsigned j = 0; j < size; ++j) {
+			for (unsigned i = 0; i < size; ++i) {
+				unsigned idx = (k * size + j) * size + i;
+
+				planes[0][idx] = low[0] + static_cast<float>(i) / (size - 1);
+				planes[1][idx] = low[1] + static_cast<float>(j) / (size - 1);
+				planes[2][idx] = low[2] + static_cast<float>(k) / (size - 1);
+			}
+		}
+	}
+
+	float * const ptr[3] = { planes[0].data(), planes[1].data(), planes[2].data() };
+
+	for (const auto &op : operations) {
+		op->process(ptr, ptr, 0, count);
+	}
+
+	// Grid points outside the output gamut can map to extreme values, which
+	// would otherwise bleed into neighbouring in-gamut cells. Display-referred
+	// outputs are clipped to a half-unit margin around their nominal range,
+	// which still covers every value representable in an integer format.
+	bool clip = out.transfer != TransferCharacteristics::LINEAR;
+	bool yuv_out = out.matrix != MatrixCoefficients::RGB && out.matrix != MatrixCoefficients::REC_2100_LMS;
+	float out_low[3] = { -0.5f, yuv_out ? -1.0f : -0.5f, yuv_out ? -1.0f : -0.5f };
+
+	lut.data.resize(static_cast<size_t>(count) * 4);
+
+	for (unsigned idx = 0; idx < count; ++idx) {
 		for (unsigned p = 0; p < 3; ++p) {
-			src_ptr[p] = static_cast<const float *>(src[p][i]);
-			dst_ptr[p] = static_cast<float *>(dst[p][i]);
+			float x = planes[p][idx];
+			lut.data[idx * 4 + p] = clip ? std::min(std::max(x, out_low[p]), out_low[p] + 2.0f) : x;
 		}
+	}
 
-		m_operations[0]->process(src_ptr, dst_ptr, left, right);
+	return lut;
+}
 
-		if (!m_operations[1])
-			return;
-		m_operations[1]->process(dst_ptr, dst_ptr, left, right);
+std::vector<std::unique_ptr<Operation>> create_operations(const std::vector<OperationFactory> &path, const ColorspaceDefinition &in,
+                                                          const ColorspaceDefinition &out, const OperationParams &params, bool lut3d, CPUClass cpu)
+{
+	std::vector<std::unique_ptr<Operation>> operations;
 
-		if (!m_operations[2])
-			return;
-		m_operations[2]->process(dst_ptr, dst_ptr, left, right);
+	if (lut3d) {
+		// The grid extends outside the gamut, where the approximate SIMD transfer
+		// functions are not equivalent. Sample with the C operations so that the
+		// table is the same on every CPU.
+		for (const auto &func : path) {
+			operations.push_back(func(params, CPUClass::NONE));
+		}
 
-		if (!m_operations[3])
-			return;
-		m_operations[3]->process(dst_ptr, dst_ptr, left, right);
+		Lut3D lut = bake_lut3d(operations, in, out);
+		operations.clear();
+		operations.push_back(create_lut3d_operation(lut, cpu));
+	} else {
+		for (const auto &func : path) {
+			operations.push_back(func(params, cpu));
+		}
+	}
 
-		if (!m_operations[4])
-			return;
-		m_operations[4]->process(dst_ptr, dst_ptr, left, right);
+	return operations;
+}
 
-		if (!m_operations[5])
-			return;
-		m_operations[5]->process(dst_ptr, dst_ptr, left, right);
+// Evaluate the normalization of integer RGB samples, followed by the transfer
+// function if given, for each sample value. The normalization is computed in
+// the same way as the conversion of integer samples to FLOAT.
+std::vector<float> make_integer_lut(const PixelFormat &format, TransferCharacteristics transfer, const OperationParams &params)
+{
+	EnsureSinglePrecision x87;
+
+	double range = format.fullrange ? static_cast<double>((1UL << format.depth) - 1) : 219.0 * (1UL << format.depth) / 256.0;
+	double offset = format.fullrange ? 0.0 : 16.0 * (1UL << format.depth) / 256.0;
+	float scale = static_cast<float>(1.0 / range);
+	float bias = static_cast<float>(-offset * (1.0 / range));
+
+	bool linearize = transfer != TransferCharacteristics::UNSPECIFIED;
+	TransferFunction func{};
+
+	if (linearize)
+		func = select_transfer_function(transfer, params.peak_luminance, params.scene_referred);
+
+	// BYTE tables cover every possible sample. WORD samples exceeding the
+	// depth are clamped to the maximum value.
+	std::vector<float> lut(format.type == PixelType::BYTE ? 256 : 1UL << format.depth);
+
+	for (size_t i = 0; i < lut.size(); ++i) {
+		float x = static_cast<float>(i) * scale + bias;
+		lut[i] = linearize ? func.to_linear_scale * func.to_linear(x) : x;
 	}
-};
+
+	return lut;
+}
 
 } // namespace
 
@@ -97,7 +320,11 @@ ColorspaceConversion::ColorspaceConversion(unsigned width, unsigned height) :
 	csp_out{},
 	peak_luminance{ 100.0 },
 	approximate_gamma{},
+	approximate_colorspace{},
 	scene_referred{},
+	tone_mapping{ ToneMapping::NONE },
+	source_peak_luminance{ 1000.0 },
+	pixel_in{ PixelType::FLOAT },
 	cpu{ CPUClass::NONE }
 {}
 
@@ -108,10 +335,53 @@ std::unique_ptr<graph::ImageFilter> ColorspaceConversion::create() const try
 	      .set_approximate_gamma(approximate_gamma)
 	      .set_scene_referred(scene_referred);
 
+	if (tone_mapping != ToneMapping::NONE && use_tone_mapping(csp_in, csp_out, source_peak_luminance, peak_luminance)) {
+		params.set_tone_mapping(tone_mapping)
+		      .set_source_peak_luminance(source_peak_luminance);
+	}
+
+	if (pixel_is_integer(pixel_in.type)) {
+		if (csp_in.matrix != MatrixCoefficients::RGB || pixel_in.depth > MAX_INTEGER_LUT_DEPTH)
+			error::throw_<error::InternalError>("pixel format not supported");
+
+		TransferCharacteristics transfer = TransferCharacteristics::UNSPECIFIED;
+		std::vector<OperationFactory> path;
+		bool lut3d = false;
+
+		if (csp_in != csp_out) {
+			path = get_operation_path(csp_in, csp_out, params);
+			lut3d = approximate_colorspace && use_lut3d(csp_in, path.size());
+
+			// The table replaces the linearization, unless the whole path is
+			// evaluated through a 3D LUT instead.
+			if (!lut3d)
+				path = get_operation_path(csp_in, csp_out, params, &transfer);
+		}
+
+		std::vector<std::unique_ptr<Operation>> operations = create_operations(path, csp_in, csp_out, params, lut3d, cpu);
+		return ztd::make_unique<ColorspaceConversionImpl>(width, height, pixel_in.type, std::move(operations), make_integer_lut(pixel_in, transfer, params));
+	}
+
+	PixelType pixel_type = pixel_in.type;
+	f16c_func to_float = nullptr;
+	f16c_func to_half = nullptr;
+
+	if (pixel_type == PixelType::HALF) {
+		to_float = select_f16c_func(false, cpu);
+		to_half = select_f16c_func(true, cpu);
+
+		if (!to_float || !to_half)
+			error::throw_<error::InternalError>("pixel type not supported");
+	}
+
 	if (csp_in == csp_out)
-		return ztd::make_unique<graph::CopyFilter>(width, height, PixelType::FLOAT, true);
-	else
-		return ztd::make_unique<ColorspaceConversionImpl>(width, height, csp_in, csp_out, params, cpu);
+		return ztd::make_unique<graph::CopyFilter>(width, height, pixel_type, true);
+
+	std::vector<OperationFactory> path = get_operation_path(csp_in, csp_out, params);
+	std::vector<std::unique_ptr<Operation>> operations =
+		create_operations(path, csp_in, csp_out, params, approximate_colorspace && use_lut3d(csp_in, path.size()), cpu);
+
+	return ztd::make_unique<ColorspaceConversionImpl>(width, height, pixel_type, std::move(operations), to_float, to_half);
 } catch (const std::bad_alloc &) {
 	error::throw_<error::OutOfMemory>();
 }
@@ -4,6 +4,7 @@
 #define ZIMG_COLORSPACE_COLORSPACE_H_
 
 #include <memory>
+#include "common/pixel.h"
 
 namespace zimg {
 
@@ -64,6 +65,13 @@ enum class ColorPrimaries {
 	JEDEC_P22,
 };
 
+enum class ToneMapping {
+	NONE,
+	BT2390,
+	HABLE,
+	REINHARD,
+};
+
 /**
  * Definition of a working colorspace.
  */
@@ -111,6 +119,15 @@ constexpr bool operator!=(const ColorspaceDefinition &a, const ColorspaceDefinit
 }
 
 
+/**
+ * Maximum depth of integer RGB input to {@link ColorspaceConversion}.
+ *
+ * Integer samples are converted to FLOAT by a table indexed by the sample
+ * value, which also applies the transfer function if the conversion begins
+ * by linearizing the input.
+ */
+constexpr unsigned MAX_INTEGER_LUT_DEPTH = 12;
+
 struct ColorspaceConversion {
 	unsigned width;
 	unsigned height;
@@ -120,7 +137,11 @@ struct ColorspaceConversion {
 	BUILDER_MEMBER(ColorspaceDefinition, csp_out)
 	BUILDER_MEMBER(double, peak_luminance)
 	BUILDER_MEMBER(bool, approximate_gamma)
+	BUILDER_MEMBER(bool, approximate_colorspace)
 	BUILDER_MEMBER(bool, scene_referred)
+	BUILDER_MEMBER(ToneMapping, tone_mapping)
+	BUILDER_MEMBER(double, source_peak_luminance)
+	BUILDER_MEMBER(PixelFormat, pixel_in)
 	BUILDER_MEMBER(CPUClass, cpu)
 #undef BUILDER_MEMBER
 
@@ -6,14 +6,15 @@
 #include "common/zassert.h"
 #include "colorspace.h"
 #include "gamma.h"
+#include "gamma_constants.h"
 
 namespace zimg {
 namespace colorspace {
 
 namespace {
 
-constexpr float REC709_ALPHA = 1.09929682680944f;
-constexpr float REC709_BETA = 0.018053968510807f;
+using constants::REC709_ALPHA;
+using constants::REC709_BETA;
 
 constexpr float SMPTE_240M_ALPHA = 1.111572195921731f;
 constexpr float SMPTE_240M_BETA  = 0.022821585529445f;
@@ -22,15 +23,15 @@ constexpr float SMPTE_240M_BETA  = 0.022821585529445f;
 constexpr float SRGB_ALPHA = 1.055010718947587f;
 constexpr float SRGB_BETA = 0.003041282560128f;
 
-constexpr float ST2084_M1 = 0.1593017578125f;
-constexpr float ST2084_M2 = 78.84375f;
-constexpr float ST2084_C1 = 0.8359375f;
-constexpr float ST2084_C2 = 18.8515625f;
-constexpr float ST2084_C3 = 18.6875f;
+using constants::ST2084_M1;
+using constants::ST2084_M2;
+using constants::ST2084_C1;
+using constants::ST2084_C2;
+using constants::ST2084_C3;
 
-constexpr float ARIB_B67_A = 0.17883277f;
-constexpr float ARIB_B67_B = 0.28466892f;
-constexpr float ARIB_B67_C = 0.55991073f;
+using constants::ARIB_B67_A;
+using constants::ARIB_B67_B;
+using constants::ARIB_B67_C;
 
 
 // Chosen for compatibility with higher precision REC709_ALPHA/REC709_BETA.
@@ -0,0 +1,61 @@
+#pragma once
+
+#ifndef ZIMG_COLORSPACE_GAMMA_CONSTANTS_H_
+#define ZIMG_COLORSPACE_GAMMA_CONSTANTS_H_
+
+namespace zimg {
+namespace colorspace {
+namespace constants {
+
+constexpr float REC709_ALPHA = 1.09929682680944f;
+constexpr float REC709_BETA = 0.018053968510807f;
+
+constexpr float ARIB_B67_A = 0.17883277f;
+constexpr float ARIB_B67_B = 0.28466892f;
+constexpr float ARIB_B67_C = 0.55991073f;
+
+constexpr float ST2084_M1 = 0.1593017578125f;
+constexpr float ST2084_M2 = 78.84375f;
+constexpr float ST2084_C1 = 0.8359375f;
+constexpr float ST2084_C2 = 18.8515625f;
+constexpr float ST2084_C3 = 18.6875f;
+
+// Filmic curve by John Hable, as published for Uncharted 2.
+constexpr float HABLE_A = 0.15f;
+constexpr float HABLE_B = 0.50f;
+constexpr float HABLE_C = 0.10f;
+constexpr float HABLE_D = 0.20f;
+constexpr float HABLE_E = 0.02f;
+constexpr float HABLE_F = 0.30f;
+
+// Polynomial approximations shared by the SIMD transfer functions. The
+// coefficients are ordered for evaluation by Horner's method.
+
+// log2(1 + t) / t on [sqrt(0.5) - 1, sqrt(2) - 1). Max error 1.1e-7.
+constexpr float LOG2_HORNER[8] = {
+	-1.457384139e-1f,
+	2.368879989e-1f,
+	-2.500700932e-1f,
+	2.867078190e-1f,
+	-3.600871530e-1f,
+	4.809394302e-1f,
+	-7.213571502e-1f,
+	1.442694773e+0f,
+};
+
+// 2^x on [-0.5, 0.5]. Max relative error 1.1e-7.
+constexpr float EXP2_HORNER[7] = {
+	1.534579425e-4f,
+	1.339993108e-3f,
+	9.618489023e-3f,
+	5.550328777e-2f,
+	2.402264689e-1f,
+	6.931472057e-1f,
+	1.000000001e+0f,
+};
+
+} // namespace constants
+} // namespace colorspace
+} // namespace zimg
+
+#endif // ZIMG_COLORSPACE_GAMMA_CONSTANTS_H_
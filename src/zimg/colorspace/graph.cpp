@@ -1,5 +1,6 @@
 #include <algorithm>
-#include <deque>
+#include <functional>
+#include <queue>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -7,8 +8,11 @@
 #include "common/except.h"
 #include "common/zassert.h"
 #include "colorspace.h"
+#include "gamma.h"
 #include "graph.h"
+#include "matrix3.h"
 #include "operation.h"
+#include "operation_impl.h"
 
 namespace zimg {
 namespace colorspace {
@@ -111,17 +115,58 @@ struct ColorspaceHash {
 	}
 };
 
-typedef std::pair<ColorspaceDefinition, OperationFactory> ColorspaceNode;
+// Relative cost per pixel of each kind of operation, used to weight the path search.
+constexpr double MATRIX_COST = 1.0;
+constexpr double GAMMA_LUT_COST = 2.0;
+constexpr double GAMMA_COST = 4.0;
+constexpr double B67_COST = 6.0;
+constexpr double CONSTANT_LUMINANCE_COST = 2.0 * MATRIX_COST + GAMMA_COST;
 
-std::vector<ColorspaceNode> get_neighboring_colorspaces(const ColorspaceDefinition &csp)
+// Display-referred ARIB STD-B67 depends on all three channels.
+bool is_display_referred_b67(const ColorspaceDefinition &csp, const OperationParams &params)
+{
+	return csp.transfer == TransferCharacteristics::ARIB_B67 && csp.primaries != ColorPrimaries::UNSPECIFIED && !params.approximate_gamma && !params.scene_referred;
+}
+
+double gamma_cost(const ColorspaceDefinition &csp, const OperationParams &params)
+{
+	if (is_display_referred_b67(csp, params))
+		return B67_COST;
+	else
+		return params.approximate_gamma ? GAMMA_LUT_COST : GAMMA_COST;
+}
+
+struct ColorspaceNode {
+	ColorspaceDefinition csp;
+	OperationFactory func;
+	std::function<Matrix3x3()> matrix;
+	TransferCharacteristics transfer; // Set for transfer function edges.
+	bool to_linear;
+	double cost;
+};
+
+std::vector<ColorspaceNode> get_neighboring_colorspaces(const ColorspaceDefinition &csp, const OperationParams &params)
 {
 	zassert_d(is_valid_csp(csp), "invalid colorspace");
 
 	std::vector<ColorspaceNode> edges;
 
-	auto add_edge = [&](const ColorspaceDefinition &out_csp, decltype(&create_ncl_rgb_to_yuv_operation) func)
+	auto add_edge = [&](const ColorspaceDefinition &out_csp, decltype(&create_gamma_to_linear_operation) func, double cost)
 	{
-		edges.emplace_back(out_csp, std::bind(func, csp, out_csp, std::placeholders::_1, std::placeholders::_2));
+		edges.push_back({ out_csp, std::bind(func, csp, out_csp, std::placeholders::_1, std::placeholders::_2), nullptr, TransferCharacteristics::UNSPECIFIED, false, cost });
+	};
+	auto add_gamma_edge = [&](const ColorspaceDefinition &out_csp)
+	{
+		bool to_linear = out_csp.transfer == TransferCharacteristics::LINEAR;
+		const ColorspaceDefinition &gamma_csp = to_linear ? csp : out_csp;
+		auto func = to_linear ? create_gamma_to_linear_operation : create_linear_to_gamma_operation;
+
+		edges.push_back({ out_csp, std::bind(func, csp, out_csp, std::placeholders::_1, std::placeholders::_2), nullptr,
+		                  gamma_csp.transfer, to_linear, gamma_cost(gamma_csp, params) });
+	};
+	auto add_matrix_edge = [&](const ColorspaceDefinition &out_csp, decltype(&gamut_operation_matrix) func)
+	{
+		edges.push_back({ out_csp, nullptr, std::bind(func, csp, out_csp), TransferCharacteristics::UNSPECIFIED, false, MATRIX_COST });
 	};
 
 	if (csp.matrix == MatrixCoefficients::RGB) {
@@ -138,56 +183,56 @@ std::vector<ColorspaceNode> get_neighboring_colorspaces(const ColorspaceDefiniti
 		// RGB can be converted to conventional YUV.
 		for (auto matrix : all_matrix()) {
 			if (std::find(std::begin(special_matrices), std::end(special_matrices), matrix) == std::end(special_matrices))
-				add_edge(csp.to(matrix), create_ncl_rgb_to_yuv_operation);
+				add_matrix_edge(csp.to(matrix), ncl_rgb_to_yuv_operation_matrix);
 		}
 		if (csp.primaries != ColorPrimaries::UNSPECIFIED)
-			add_edge(csp.to(MatrixCoefficients::CHROMATICITY_DERIVED_NCL), create_ncl_rgb_to_yuv_operation);
+			add_matrix_edge(csp.to(MatrixCoefficients::CHROMATICITY_DERIVED_NCL), ncl_rgb_to_yuv_operation_matrix);
 
 		// Linear RGB can be converted to other transfer functions and primaries; also to combined matrix-transfer systems.
 		if (csp.transfer == TransferCharacteristics::LINEAR) {
 			for (auto transfer : all_transfer()) {
 				if (transfer != csp.transfer && transfer != TransferCharacteristics::UNSPECIFIED) {
-					add_edge(csp.to(transfer), create_linear_to_gamma_operation);
+					add_gamma_edge(csp.to(transfer));
 					if (csp.primaries != ColorPrimaries::UNSPECIFIED)
-						add_edge(csp.to(transfer).to(MatrixCoefficients::CHROMATICITY_DERIVED_CL), create_cl_rgb_to_yuv_operation);
+						add_edge(csp.to(transfer).to(MatrixCoefficients::CHROMATICITY_DERIVED_CL), create_cl_rgb_to_yuv_operation, CONSTANT_LUMINANCE_COST);
 				}
 			}
 			if (csp.primaries != ColorPrimaries::UNSPECIFIED) {
 				for (auto primaries : all_primaries()) {
 					if (primaries != csp.primaries && primaries != ColorPrimaries::UNSPECIFIED)
-						add_edge(csp.to(primaries), create_gamut_operation);
+						add_matrix_edge(csp.to(primaries), gamut_operation_matrix);
 				}
 			}
 
-			add_edge(csp.to(MatrixCoefficients::REC_2020_CL).to(TransferCharacteristics::REC_709), create_cl_rgb_to_yuv_operation);
+			add_edge(csp.to(MatrixCoefficients::REC_2020_CL).to(TransferCharacteristics::REC_709), create_cl_rgb_to_yuv_operation, CONSTANT_LUMINANCE_COST);
 
 			if (csp.primaries == ColorPrimaries::REC_2020)
-				add_edge(csp.to(MatrixCoefficients::REC_2100_LMS), create_ncl_rgb_to_yuv_operation);
+				add_matrix_edge(csp.to(MatrixCoefficients::REC_2100_LMS), ncl_rgb_to_yuv_operation_matrix);
 		} else if (csp.transfer != TransferCharacteristics::UNSPECIFIED) {
 			// Gamma RGB can be converted to linear RGB.
-			add_edge(csp.to_linear(), create_gamma_to_linear_operation);
+			add_gamma_edge(csp.to_linear());
 		}
 	} else if (csp.matrix == MatrixCoefficients::REC_2020_CL || csp.matrix == MatrixCoefficients::CHROMATICITY_DERIVED_CL) {
-		add_edge(csp.to_rgb().to_linear(), create_cl_yuv_to_rgb_operation);
+		add_edge(csp.to_rgb().to_linear(), create_cl_yuv_to_rgb_operation, CONSTANT_LUMINANCE_COST);
 	} else if (csp.matrix == MatrixCoefficients::REC_2100_LMS) {
 		// LMS with ST_2084 or ARIB_B67 transfer functions can be converted to ICtCp and also to linear transfer function.
 		if (csp.transfer == TransferCharacteristics::ST_2084 || csp.transfer == TransferCharacteristics::ARIB_B67) {
-			add_edge(csp.to(MatrixCoefficients::REC_2100_ICTCP), create_lms_to_ictcp_operation);
-			add_edge(csp.to(TransferCharacteristics::LINEAR), create_gamma_to_linear_operation);
+			add_matrix_edge(csp.to(MatrixCoefficients::REC_2100_ICTCP), lms_to_ictcp_operation_matrix);
+			add_gamma_edge(csp.to(TransferCharacteristics::LINEAR));
 		}
 		// LMS with linear transfer function can be converted to RGB matrix and to ARIB_B67 and ST_2084 transfer functions.
 		if (csp.transfer == TransferCharacteristics::LINEAR) {
-			add_edge(csp.to_rgb(), create_ncl_yuv_to_rgb_operation);
-			add_edge(csp.to(TransferCharacteristics::ST_2084), create_linear_to_gamma_operation);
-			add_edge(csp.to(TransferCharacteristics::ARIB_B67), create_linear_to_gamma_operation);
+			add_matrix_edge(csp.to_rgb(), ncl_yuv_to_rgb_operation_matrix);
+			add_gamma_edge(csp.to(TransferCharacteristics::ST_2084));
+			add_gamma_edge(csp.to(TransferCharacteristics::ARIB_B67));
 		}
 	} else if (csp.matrix == MatrixCoefficients::REC_2100_ICTCP) {
 		// ICtCp with ST_2084 or ARIB_B67 transfer functions can be converted to LMS.
 		if (csp.transfer == TransferCharacteristics::ST_2084 || csp.transfer == TransferCharacteristics::ARIB_B67)
-			add_edge(csp.to(MatrixCoefficients::REC_2100_LMS), create_ictcp_to_lms_operation);
+			add_matrix_edge(csp.to(MatrixCoefficients::REC_2100_LMS), ictcp_to_lms_operation_matrix);
 	} else if (csp.matrix != MatrixCoefficients::UNSPECIFIED) {
 		// YUV can be converted to RGB.
-		add_edge(csp.to_rgb(), create_ncl_yuv_to_rgb_operation);
+		add_matrix_edge(csp.to_rgb(), ncl_yuv_to_rgb_operation_matrix);
 	}
 
 	return edges;
@@ -196,49 +241,154 @@ std::vector<ColorspaceNode> get_neighboring_colorspaces(const ColorspaceDefiniti
 } // namespace
 
 
-std::vector<OperationFactory> get_operation_path(const ColorspaceDefinition &in, const ColorspaceDefinition &out)
+std::vector<OperationFactory> get_operation_path(const ColorspaceDefinition &in, const ColorspaceDefinition &out, const OperationParams &params,
+                                                 TransferCharacteristics *to_linear)
 {
 	if (!is_valid_csp(in) || !is_valid_csp(out))
 		error::throw_<error::NoColorspaceConversion>("invalid colorspace definition");
 
+	// Queue entries are ordered by cost, then by insertion order, so that paths
+	// of equal cost are resolved in breadth-first order.
+	typedef std::pair<double, size_t> QueueEntry;
+
 	std::vector<OperationFactory> path;
-	std::deque<ColorspaceDefinition> queue;
+	std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+	std::vector<ColorspaceDefinition> queued;
+	std::unordered_map<ColorspaceDefinition, double, ColorspaceHash> costs;
 	std::unordered_set<ColorspaceDefinition, ColorspaceHash> visited;
-	std::unordered_map<ColorspaceDefinition, ColorspaceNode, ColorspaceHash> parents;
+	std::unordered_map<ColorspaceDefinition, std::pair<ColorspaceDefinition, ColorspaceNode>, ColorspaceHash> parents;
 
 	ColorspaceDefinition vertex{};
 
-	visited.insert(in);
-	queue.push_back(in);
+	costs[in] = 0.0;
+	queue.emplace(0.0, queued.size());
+	queued.push_back(in);
 
 	while (!queue.empty()) {
-		vertex = queue.front();
-		queue.pop_front();
+		double cost = queue.top().first;
+		vertex = queued[queue.top().second];
+		queue.pop();
 
 		if (vertex == out)
 			break;
+		if (!visited.insert(vertex).second)
+			continue;
 
-		for (auto &&edge : get_neighboring_colorspaces(vertex)) {
-			if (visited.find(edge.first) != visited.end())
+		for (auto &&edge : get_neighboring_colorspaces(vertex, params)) {
+			double edge_cost = cost + edge.cost;
+			auto it = costs.find(edge.csp);
+
+			if (visited.find(edge.csp) != visited.end() || (it != costs.end() && it->second <= edge_cost))
 				continue;
 
-			visited.insert(edge.first);
-			queue.push_back(edge.first);
-			parents[edge.first] = std::make_pair(vertex, std::move(edge.second));
+			costs[edge.csp] = edge_cost;
+			queue.emplace(edge_cost, queued.size());
+			queued.push_back(edge.csp);
+			parents[edge.csp] = std::make_pair(vertex, std::move(edge));
 		}
 	}
 	if (vertex != out)
 		error::throw_<error::NoColorspaceConversion>("no path between colorspaces");
 
+	std::vector<ColorspaceNode> nodes;
+
 	while (vertex != in) {
 		auto it = parents.find(vertex);
 		zassert_d(it != parents.end(), "missing link in traversal path");
 
-		ColorspaceNode node = std::move(it->second);
-		path.push_back(std::move(node.second));
-		vertex = node.first;
+		nodes.push_back(std::move(it->second.second));
+		vertex = it->second.first;
+	}
+	std::reverse(nodes.begin(), nodes.end());
+
+	// Combine consecutive matrix operations into a single matrix.
+	std::vector<ColorspaceNode> steps;
+
+	for (size_t i = 0; i < nodes.size(); ++i) {
+		if (nodes[i].matrix) {
+			Matrix3x3 m = nodes[i].matrix();
+
+			while (i + 1 < nodes.size() && nodes[i + 1].matrix) {
+				m = nodes[i + 1].matrix() * m;
+				++i;
+			}
+
+			nodes[i].matrix = [=]() { return m; };
+		}
+
+		steps.push_back(std::move(nodes[i]));
+	}
+
+	// HDR tone mapping is applied in linear light, immediately after the
+	// transfer function of the source.
+	auto is_tone_map_step = [&](const ColorspaceNode &node)
+	{
+		return params.tone_mapping != ToneMapping::NONE && node.to_linear &&
+			(node.transfer == TransferCharacteristics::ST_2084 || node.transfer == TransferCharacteristics::ARIB_B67);
+	};
+	auto tone_map_func = [](const OperationParams &op_params, CPUClass cpu) { return create_tone_map_operation(op_params, cpu); };
+
+	size_t first = 0;
+
+	if (to_linear) {
+		*to_linear = TransferCharacteristics::UNSPECIFIED;
+
+		if (!steps.empty() && steps[0].to_linear && steps[0].transfer != TransferCharacteristics::UNSPECIFIED &&
+		    in.matrix == MatrixCoefficients::RGB && !is_display_referred_b67(in, params))
+		{
+			*to_linear = steps[0].transfer;
+			if (is_tone_map_step(steps[0]))
+				path.push_back(tone_map_func);
+			first = 1;
+		}
+	}
+
+	for (size_t i = first; i < steps.size(); ++i) {
+		// Approximate transfer functions are vectorized, so the neighbouring
+		// matrices are evaluated in the same pass to avoid storing and reloading
+		// the intermediate result.
+		size_t gamma_idx = steps[i].matrix ? i + 1 : i;
+
+		if (params.approximate_gamma && gamma_idx < steps.size() && steps[gamma_idx].transfer != TransferCharacteristics::UNSPECIFIED) {
+			bool has_pre = gamma_idx != i;
+			bool tone_map = is_tone_map_step(steps[gamma_idx]);
+			bool has_post = gamma_idx + 1 < steps.size() && steps[gamma_idx + 1].matrix && !tone_map;
+
+			if (has_pre || has_post) {
+				Matrix3x3 pre = has_pre ? steps[i].matrix() : Matrix3x3{};
+				Matrix3x3 post = has_post ? steps[gamma_idx + 1].matrix() : Matrix3x3{};
+				TransferCharacteristics transfer = steps[gamma_idx].transfer;
+				bool to_linear = steps[gamma_idx].to_linear;
+
+				path.push_back([=](const OperationParams &op_params, CPUClass cpu)
+				{
+					TransferFunction func = select_transfer_function(transfer, op_params.peak_luminance, op_params.scene_referred);
+					const Matrix3x3 *pre_ptr = has_pre ? &pre : nullptr;
+					const Matrix3x3 *post_ptr = has_post ? &post : nullptr;
+
+					if (to_linear)
+						return create_fused_inverse_gamma_operation(pre_ptr, func, post_ptr, op_params, cpu);
+					else
+						return create_fused_gamma_operation(pre_ptr, func, post_ptr, op_params, cpu);
+				});
+				if (tone_map)
+					path.push_back(tone_map_func);
+
+				i = has_post ? gamma_idx + 1 : gamma_idx;
+				continue;
+			}
+		}
+
+		if (steps[i].matrix) {
+			Matrix3x3 m = steps[i].matrix();
+			path.push_back([=](const OperationParams &, CPUClass cpu) { return create_matrix_operation(m, cpu); });
+		} else {
+			path.push_back(std::move(steps[i].func));
+		}
+
+		if (is_tone_map_step(steps[i]))
+			path.push_back(tone_map_func);
 	}
-	std::reverse(path.begin(), path.end());
 
 	return path;
 }
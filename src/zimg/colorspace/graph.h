@@ -17,16 +17,31 @@ struct ColorspaceDefinition;
 struct OperationParams;
 class Operation;
 
+enum class TransferCharacteristics;
+
 typedef std::function<std::unique_ptr<Operation>(const OperationParams &, CPUClass)> OperationFactory;
 
 /**
- * Find the shortest path between two colorspaces.
+ * Find the least expensive path between two colorspaces.
+ *
+ * Consecutive matrix operations along the path are combined into one. When
+ * approximate transfer functions are requested, each transfer function is
+ * fused with the matrices immediately before and after it. If tone mapping is
+ * requested, it follows the linearization of the HDR input.
+ *
+ * If the caller can linearize the input by itself, an initial per-channel
+ * conversion from gamma to linear RGB is omitted from the path and its
+ * transfer characteristics are returned instead.
  *
  * @param in input colorspace
  * @param out output colorspace
+ * @param params parameters, used to estimate the cost of operations
+ * @param[out] to_linear if not null, receives the transfer characteristics of
+ *             the omitted linearization, or UNSPECIFIED if none was omitted
  * @return vector of factory functors for operations
  */
-std::vector<OperationFactory> get_operation_path(const ColorspaceDefinition &in, const ColorspaceDefinition &out);
+std::vector<OperationFactory> get_operation_path(const ColorspaceDefinition &in, const ColorspaceDefinition &out, const OperationParams &params,
+                                                 TransferCharacteristics *to_linear = nullptr);
 
 } // namespace colorspace
 } // namespace zimg
@@ -13,10 +13,12 @@ enum class CPUClass;
 namespace colorspace {
 
 struct ColorspaceDefinition;
+struct Matrix3x3;
 
 enum class MatrixCoefficients;
 enum class TransferCharacteristics;
 enum class ColorPrimaries;
+enum class ToneMapping;
 
 /**
  * Parameters struct for operation factory functions.
@@ -26,6 +28,8 @@ struct OperationParams {
 	BUILDER_MEMBER(double, peak_luminance)
 	BUILDER_MEMBER(bool, approximate_gamma)
 	BUILDER_MEMBER(bool, scene_referred)
+	BUILDER_MEMBER(ToneMapping, tone_mapping)
+	BUILDER_MEMBER(double, source_peak_luminance)
 #undef BUILDER_MEMBER
 
 	/**
@@ -34,7 +38,9 @@ struct OperationParams {
 	OperationParams() :
 		peak_luminance{ NAN },
 		approximate_gamma{},
-		scene_referred{}
+		scene_referred{},
+		tone_mapping{},
+		source_peak_luminance{ NAN }
 	{}
 };
 
@@ -60,72 +66,82 @@ public:
 };
 
 /**
- * Create an operation converting from YUV to RGB via a 3x3 matrix.
+ * Conversion between HALF and FLOAT samples in the column range [left, right).
+ */
+typedef void (*f16c_func)(const void *src, void *dst, unsigned left, unsigned right);
+
+/**
+ * Get the 3x3 matrix converting from YUV to RGB.
+ *
+ * Matrix operations are created by {@link create_matrix_operation}, which
+ * allows consecutive matrices in a conversion path to be combined.
  *
  * @param in input colorspace
  * @param out output colorspace
- * @param params parameters
- * @param cpu create operation optimized for given cpu
- * @return concrete operation
+ * @return matrix
+ */
+Matrix3x3 ncl_yuv_to_rgb_operation_matrix(const ColorspaceDefinition &in, const ColorspaceDefinition &out);
+
+/**
+ * Get the 3x3 matrix converting from RGB to YUV.
+ *
+ * @see ncl_yuv_to_rgb_operation_matrix
  */
-std::unique_ptr<Operation> create_ncl_yuv_to_rgb_operation(const ColorspaceDefinition &in, const ColorspaceDefinition &out, const OperationParams &params, CPUClass cpu);
+Matrix3x3 ncl_rgb_to_yuv_operation_matrix(const ColorspaceDefinition &in, const ColorspaceDefinition &out);
 
 /**
- * Create an operation converting from RGB to YUV via a 3x3 matrix.
+ * Get the 3x3 matrix converting from ICtCp to LMS.
  *
- * @see create_ncl_yuv_to_rgb_operation
+ * @see ncl_yuv_to_rgb_operation_matrix
  */
-std::unique_ptr<Operation> create_ncl_rgb_to_yuv_operation(const ColorspaceDefinition &in, const ColorspaceDefinition &out, const OperationParams &params, CPUClass cpu);
+Matrix3x3 ictcp_to_lms_operation_matrix(const ColorspaceDefinition &in, const ColorspaceDefinition &out);
 
 /**
-* Create an operation converting from ICtCp to LMS via a 3x3 matrix.
-*
-* @see create_ncl_yuv_to_rgb_operation
-*/
-std::unique_ptr<Operation> create_ictcp_to_lms_operation(const ColorspaceDefinition &in, const ColorspaceDefinition &out, const OperationParams &params, CPUClass cpu);
+ * Get the 3x3 matrix converting from LMS to ICtCp.
+ *
+ * @see ncl_yuv_to_rgb_operation_matrix
+ */
+Matrix3x3 lms_to_ictcp_operation_matrix(const ColorspaceDefinition &in, const ColorspaceDefinition &out);
 
 /**
-* Create an operation converting from LMS to ICtCp via a 3x3 matrix.
-*
-* @see create_ncl_yuv_to_rgb_operation
-*/
-std::unique_ptr<Operation> create_lms_to_ictcp_operation(const ColorspaceDefinition &in, const ColorspaceDefinition &out, const OperationParams &params, CPUClass cpu);
+ * Get the 3x3 matrix converting between color primaries.
+ *
+ * @see ncl_yuv_to_rgb_operation_matrix
+ */
+Matrix3x3 gamut_operation_matrix(const ColorspaceDefinition &in, const ColorspaceDefinition &out);
 
 /**
  * Create an operation inverting an optical transfer function.
  *
- * @see create_ncl_yuv_to_rgb_operation
+ * @param in input colorspace
+ * @param out output colorspace
+ * @param params parameters
+ * @param cpu create operation optimized for given cpu
+ * @return concrete operation
  */
 std::unique_ptr<Operation> create_gamma_to_linear_operation(const ColorspaceDefinition &in, const ColorspaceDefinition &out, const OperationParams &params, CPUClass cpu);
 
 /**
  * Create an operation applying an optical transfer function.
  *
- * @see create_ncl_yuv_to_rgb_operation
+ * @see create_gamma_to_linear_operation
  */
 std::unique_ptr<Operation> create_linear_to_gamma_operation(const ColorspaceDefinition &in, const ColorspaceDefinition &out, const OperationParams &params, CPUClass cpu);
 
 /**
  * Create an operation converting from YUV to RGB via Rec.2020 Constant Luminance method.
  *
- * @see create_ncl_yuv_to_rgb_operation
+ * @see create_gamma_to_linear_operation
  */
 std::unique_ptr<Operation> create_cl_yuv_to_rgb_operation(const ColorspaceDefinition &in, const ColorspaceDefinition &out, const OperationParams &params, CPUClass cpu);
 
 /**
  * Create an operation converting from RGB to YUV via Rec.2020 Constant Luminance method.
  *
- * @see create_ncl_yuv_to_rgb_operation
+ * @see create_gamma_to_linear_operation
  */
 std::unique_ptr<Operation> create_cl_rgb_to_yuv_operation(const ColorspaceDefinition &in, const ColorspaceDefinition &out, const OperationParams &params, CPUClass cpu);
 
-/**
- * Create an operation converting between color primaries.
- *
- * @see create_ncl_yuv_to_rgb_operation
- */
-std::unique_ptr<Operation> create_gamut_operation(const ColorspaceDefinition &in, const ColorspaceDefinition &out, const OperationParams &params, CPUClass cpu);
-
 } // namespace colorspace
 } // namespace zimg
 
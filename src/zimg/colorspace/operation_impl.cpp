@@ -1,5 +1,9 @@
 #include <algorithm>
 #include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
 #include "common/make_unique.h"
 #include "common/zassert.h"
 #include "colorspace.h"
@@ -8,6 +12,7 @@
 #include "matrix3.h"
 #include "operation.h"
 #include "operation_impl.h"
+#include "tonemap.h"
 
 #if defined(ZIMG_X86)
   #include "x86/operation_impl_x86.h"
@@ -279,6 +284,113 @@ public:
 	}
 };
 
+class ToneMapOperationC final : public Operation {
+	ToneMapCurve m_curve;
+public:
+	explicit ToneMapOperationC(const ToneMapCurve &curve) : m_curve(curve) {}
+
+	void process(const float * const *src, float * const *dst, unsigned left, unsigned right) const override
+	{
+		EnsureSinglePrecision x87;
+
+		for (unsigned i = left; i < right; ++i) {
+			float r = src[0][i];
+			float g = src[1][i];
+			float b = src[2][i];
+
+			float gain = tone_map_gain(m_curve, std::max(std::max(r, g), b));
+
+			dst[0][i] = r * gain;
+			dst[1][i] = g * gain;
+			dst[2][i] = b * gain;
+		}
+	}
+};
+
+class Lut3DOperationC final : public Operation {
+	Lut3D m_lut;
+public:
+	explicit Lut3DOperationC(const Lut3D &lut) : m_lut(lut) {}
+
+	void process(const float * const *src, float * const *dst, unsigned left, unsigned right) const override
+	{
+		const float *lut = m_lut.data.data();
+		const unsigned size = m_lut.size;
+		const unsigned stride[3] = { 4, 4 * size, 4 * size * size };
+		const float limit = static_cast<float>(size - 1);
+
+		for (unsigned i = left; i < right; ++i) {
+			float f[3];
+			unsigned s[3];
+			unsigned idx = 0;
+
+			for (unsigned p = 0; p < 3; ++p) {
+				float u = src[p][i] * m_lut.scale[p] + m_lut.offset[p];
+				u = u >= 0.0f ? u : 0.0f;
+				u = u <= limit ? u : limit;
+
+				unsigned k = std::min(static_cast<unsigned>(u), size - 2);
+				f[p] = u - static_cast<float>(k);
+				s[p] = stride[p];
+				idx += k * stride[p];
+			}
+
+			// Sort the fractions in descending order to select the tetrahedron.
+			if (f[0] < f[1]) {
+				std::swap(f[0], f[1]);
+				std::swap(s[0], s[1]);
+			}
+			if (f[1] < f[2]) {
+				std::swap(f[1], f[2]);
+				std::swap(s[1], s[2]);
+			}
+			if (f[0] < f[1]) {
+				std::swap(f[0], f[1]);
+				std::swap(s[0], s[1]);
+			}
+
+			const float *v0 = lut + idx;
+			const float *v1 = v0 + s[0];
+			const float *v2 = v1 + s[1];
+			const float *v3 = v2 + s[2];
+
+			float w0 = 1.0f - f[0];
+			float w1 = f[0] - f[1];
+			float w2 = f[1] - f[2];
+			float w3 = f[2];
+
+			float x = w0 * v0[0] + w1 * v1[0] + w2 * v2[0] + w3 * v3[0];
+			float y = w0 * v0[1] + w1 * v1[1] + w2 * v2[1] + w3 * v3[1];
+			float z = w0 * v0[2] + w1 * v1[2] + w2 * v2[2] + w3 * v3[2];
+
+			dst[0][i] = x;
+			dst[1][i] = y;
+			dst[2][i] = z;
+		}
+	}
+};
+
+// Runs the steps of a fused operation one after another, for CPUs without a
+// fused implementation.
+class CompositeOperation final : public Operation {
+	std::unique_ptr<Operation> m_operations[3];
+public:
+	CompositeOperation(std::unique_ptr<Operation> first, std::unique_ptr<Operation> second, std::unique_ptr<Operation> third) :
+		m_operations{ std::move(first), std::move(second), std::move(third) }
+	{}
+
+	void process(const float * const *src, float * const *dst, unsigned left, unsigned right) const override
+	{
+		for (const auto &op : m_operations) {
+			if (!op)
+				continue;
+
+			op->process(src, dst, left, right);
+			src = dst;
+		}
+	}
+};
+
 } // namespace
 
 
@@ -291,6 +403,45 @@ MatrixOperationImpl::MatrixOperationImpl(const Matrix3x3 &m)
 	}
 }
 
+std::vector<float> make_to_linear_lut(const TransferFunction &transfer)
+{
+	EnsureSinglePrecision x87;
+
+	// Allocate an extra LUT entry so that the upper end of the range can be interpolated.
+	std::vector<float> lut((1UL << TO_LINEAR_LUT_DEPTH) + 2);
+
+	for (size_t i = 0; i < lut.size(); ++i) {
+		float x = static_cast<float>(i) / (1 << TO_LINEAR_LUT_DEPTH) * 2.0f - 0.5f;
+		lut[i] = transfer.to_linear(x) * transfer.to_linear_scale;
+	}
+
+	return lut;
+}
+
+std::vector<float> make_to_gamma_lut(const TransferFunction &transfer)
+{
+	EnsureSinglePrecision x87;
+
+	// Allocate an extra LUT entry so that any 16-bit index can be interpolated.
+	std::vector<float> lut(static_cast<uint32_t>(UINT16_MAX) + 2);
+
+	for (size_t i = 0; i <= UINT16_MAX; ++i) {
+		uint32_t bits = static_cast<uint32_t>(i) << 16;
+		float x;
+
+		std::memcpy(&x, &bits, sizeof(x));
+		lut[i] = transfer.to_gamma(x * transfer.to_gamma_scale);
+	}
+
+	// Inputs are clamped to the finite range. The segments ending at infinity
+	// are constant, so that the interpolation does not produce NaN.
+	lut[0x7F80] = lut[0x7F7F];
+	lut[0xFF80] = lut[0xFF7F];
+	lut[0x10000] = lut[0xFFFF];
+
+	return lut;
+}
+
 
 std::unique_ptr<Operation> create_matrix_operation(const Matrix3x3 &m, CPUClass cpu)
 {
@@ -337,44 +488,162 @@ std::unique_ptr<Operation> create_inverse_gamma_operation(const TransferFunction
 	return ret;
 }
 
-std::unique_ptr<Operation> create_arib_b67_operation(const Matrix3x3 &m, const OperationParams &params)
+std::unique_ptr<Operation> create_fused_gamma_operation(const Matrix3x3 *pre, const TransferFunction &transfer, const Matrix3x3 *post, const OperationParams &params, CPUClass cpu)
+{
+	std::unique_ptr<Operation> ret;
+
+#if defined(ZIMG_X86)
+	ret = create_fused_gamma_operation_x86(pre, transfer, post, params, cpu);
+#endif
+	if (!ret) {
+		ret = ztd::make_unique<CompositeOperation>(
+			pre ? create_matrix_operation(*pre, cpu) : nullptr,
+			create_gamma_operation(transfer, params, cpu),
+			post ? create_matrix_operation(*post, cpu) : nullptr);
+	}
+
+	return ret;
+}
+
+std::unique_ptr<Operation> create_fused_inverse_gamma_operation(const Matrix3x3 *pre, const TransferFunction &transfer, const Matrix3x3 *post, const OperationParams &params, CPUClass cpu)
+{
+	std::unique_ptr<Operation> ret;
+
+#if defined(ZIMG_X86)
+	ret = create_fused_inverse_gamma_operation_x86(pre, transfer, post, params, cpu);
+#endif
+	if (!ret) {
+		ret = ztd::make_unique<CompositeOperation>(
+			pre ? create_matrix_operation(*pre, cpu) : nullptr,
+			create_inverse_gamma_operation(transfer, params, cpu),
+			post ? create_matrix_operation(*post, cpu) : nullptr);
+	}
+
+	return ret;
+}
+
+std::unique_ptr<Operation> create_arib_b67_operation(const Matrix3x3 &m, const OperationParams &params, CPUClass cpu)
 {
 	zassert_d(!params.scene_referred, "must be display-referred");
 
-	TransferFunction func = select_transfer_function(TransferCharacteristics::ARIB_B67, params.peak_luminance, false);
-	return ztd::make_unique<AribB67OperationC>(m[0][0], m[0][1], m[0][2], func.to_gamma_scale);
+	std::unique_ptr<Operation> ret;
+
+#if defined(ZIMG_X86)
+	ret = create_arib_b67_operation_x86(m, params, cpu);
+#elif defined(ZIMG_ARM)
+	ret = create_arib_b67_operation_arm(m, params, cpu);
+#endif
+	if (!ret) {
+		TransferFunction func = select_transfer_function(TransferCharacteristics::ARIB_B67, params.peak_luminance, false);
+		ret = ztd::make_unique<AribB67OperationC>(m[0][0], m[0][1], m[0][2], func.to_gamma_scale);
+	}
+
+	return ret;
 }
 
-std::unique_ptr<Operation> create_inverse_arib_b67_operation(const Matrix3x3 &m, const OperationParams &params)
+std::unique_ptr<Operation> create_inverse_arib_b67_operation(const Matrix3x3 &m, const OperationParams &params, CPUClass cpu)
 {
 	zassert_d(!params.scene_referred, "must be display-referred");
 
-	TransferFunction func = select_transfer_function(TransferCharacteristics::ARIB_B67, params.peak_luminance, false);
-	return ztd::make_unique<AribB67InverseOperationC>(m[0][0], m[0][1], m[0][2], func.to_linear_scale);
+	std::unique_ptr<Operation> ret;
+
+#if defined(ZIMG_X86)
+	ret = create_inverse_arib_b67_operation_x86(m, params, cpu);
+#elif defined(ZIMG_ARM)
+	ret = create_inverse_arib_b67_operation_arm(m, params, cpu);
+#endif
+	if (!ret) {
+		TransferFunction func = select_transfer_function(TransferCharacteristics::ARIB_B67, params.peak_luminance, false);
+		ret = ztd::make_unique<AribB67InverseOperationC>(m[0][0], m[0][1], m[0][2], func.to_linear_scale);
+	}
+
+	return ret;
+}
+
+std::unique_ptr<Operation> create_tone_map_operation(const OperationParams &params, CPUClass cpu)
+{
+	ToneMapCurve curve = select_tone_map_curve(params.tone_mapping, params.source_peak_luminance, params.peak_luminance);
+	std::unique_ptr<Operation> ret;
+
+#if defined(ZIMG_X86)
+	ret = create_tone_map_operation_x86(curve, cpu);
+#endif
+	if (!ret)
+		ret = ztd::make_unique<ToneMapOperationC>(curve);
+
+	return ret;
+}
+
+std::unique_ptr<Operation> create_lut3d_operation(const Lut3D &lut, CPUClass cpu)
+{
+	std::unique_ptr<Operation> ret;
+
+#if defined(ZIMG_X86)
+	ret = create_lut3d_operation_x86(lut, cpu);
+#endif
+	if (!ret)
+		ret = ztd::make_unique<Lut3DOperationC>(lut);
+
+	return ret;
+}
+
+f16c_func select_f16c_func(bool to_half, CPUClass cpu)
+{
+	f16c_func func = nullptr;
+
+#if defined(ZIMG_X86)
+	func = select_f16c_func_x86(to_half, cpu);
+#elif defined(ZIMG_ARM)
+	func = select_f16c_func_arm(to_half, cpu);
+#endif
+
+	return func;
 }
 
 std::unique_ptr<Operation> create_cl_yuv_to_rgb_operation(const ColorspaceDefinition &in, const ColorspaceDefinition &out, const OperationParams &params, CPUClass cpu)
 {
 	zassert_d(in.primaries == out.primaries, "primaries mismatch");
-	zassert_d((in.matrix == MatrixCoefficients::REC_2020_CL || in.matrix == MatrixCoefficients::CHROMATICITY_DERIVED_CL) && in.transfer == TransferCharacteristics::REC_709, "must be 2020 CL");
+	zassert_d((in.matrix == MatrixCoefficients::REC_2020_CL && in.transfer == TransferCharacteristics::REC_709) || in.matrix == MatrixCoefficients::CHROMATICITY_DERIVED_CL, "must be 2020 CL");
 	zassert_d(out.matrix == MatrixCoefficients::RGB && out.transfer == TransferCharacteristics::LINEAR, "must be linear RGB");
 
 	// CL is always scene-referred.
 	TransferFunction func = select_transfer_function(in.transfer, params.peak_luminance, true);
 	Matrix3x3 m = in.matrix == MatrixCoefficients::CHROMATICITY_DERIVED_CL ? ncl_rgb_to_yuv_matrix_from_primaries(in.primaries) : ncl_rgb_to_yuv_matrix(in.matrix);
-	return ztd::make_unique<CLToRGBOperationC>(func.to_gamma, func.to_linear, m[0][0], m[0][1], m[0][2], func.to_linear_scale);
+
+	std::unique_ptr<Operation> ret;
+
+#if defined(ZIMG_X86)
+	// The SIMD kernels implement only the Rec.709 OETF.
+	if (in.transfer == TransferCharacteristics::REC_709)
+		ret = create_cl_yuv_to_rgb_operation_x86(m, params, cpu);
+#endif
+	if (!ret)
+		ret = ztd::make_unique<CLToRGBOperationC>(func.to_gamma, func.to_linear, m[0][0], m[0][1], m[0][2], func.to_linear_scale);
+
+	return ret;
 }
 
 std::unique_ptr<Operation> create_cl_rgb_to_yuv_operation(const ColorspaceDefinition &in, const ColorspaceDefinition &out, const OperationParams &params, CPUClass cpu)
 {
 	zassert_d(in.primaries == out.primaries, "primaries mismatch");
 	zassert_d(in.matrix == MatrixCoefficients::RGB && in.transfer == TransferCharacteristics::LINEAR, "must be linear RGB");
-	zassert_d((out.matrix == MatrixCoefficients::REC_2020_CL || out.matrix == MatrixCoefficients::CHROMATICITY_DERIVED_CL) && out.transfer == TransferCharacteristics::REC_709, "must be 2020 CL");
+	zassert_d((out.matrix == MatrixCoefficients::REC_2020_CL && out.transfer == TransferCharacteristics::REC_709) || out.matrix == MatrixCoefficients::CHROMATICITY_DERIVED_CL, "must be 2020 CL");
 
 	// CL is always scene-referred.
 	TransferFunction func = select_transfer_function(out.transfer, params.peak_luminance, true);
 	Matrix3x3 m = out.matrix == MatrixCoefficients::CHROMATICITY_DERIVED_CL ? ncl_rgb_to_yuv_matrix_from_primaries(out.primaries) : ncl_rgb_to_yuv_matrix(out.matrix);
-	return ztd::make_unique<CLToYUVOperationC>(func.to_gamma, m[0][0], m[0][1], m[0][2], func.to_gamma_scale);
+
+	std::unique_ptr<Operation> ret;
+
+#if defined(ZIMG_X86)
+	// The SIMD kernels implement only the Rec.709 OETF.
+	if (out.transfer == TransferCharacteristics::REC_709)
+		ret = create_cl_rgb_to_yuv_operation_x86(m, params, cpu);
+#endif
+	if (!ret)
+		ret = ztd::make_unique<CLToYUVOperationC>(func.to_gamma, m[0][0], m[0][1], m[0][2], func.to_gamma_scale);
+
+	return ret;
 }
 
 } // namespace colorspace
@@ -3,6 +3,8 @@
 #ifndef ZIMG_COLORSPACE_OPERATION_IMPL_H_
 #define ZIMG_COLORSPACE_OPERATION_IMPL_H_
 
+#include <vector>
+#include "common/alloc.h"
 #include "common/libm_wrapper.h"
 #include "operation.h"
 
@@ -33,6 +35,51 @@ protected:
 	explicit MatrixOperationImpl(const Matrix3x3 &matrix);
 };
 
+/**
+ * Three-dimensional LUT sampled on a regular grid.
+ *
+ * Each grid point stores three output values, padded to four floats. The
+ * first input channel indexes the fastest-varying axis of the grid.
+ */
+struct Lut3D {
+	AlignedVector<float> data;
+	unsigned size; /**< Number of grid points per axis. */
+	float scale[3]; /**< Scale from input value to grid coordinate. */
+	float offset[3]; /**< Offset from input value to grid coordinate. */
+};
+
+/**
+ * Number of intervals, as a power of 2, in the table approximating conversions
+ * from non-linear encoding to linear light.
+ */
+constexpr unsigned TO_LINEAR_LUT_DEPTH = 12;
+
+/**
+ * Create table approximating a conversion from non-linear encoding to linear light.
+ *
+ * The table samples the range [-0.5, 1.5] at 2^TO_LINEAR_LUT_DEPTH uniform
+ * intervals. Inputs are clamped to the range and linearly interpolated between
+ * the two nearest entries. The interpolation error is at most 2e-7 for SDR
+ * transfer functions and 3e-6 of the peak for ST.2084.
+ *
+ * @param transfer transfer functions
+ * @return table of 2^TO_LINEAR_LUT_DEPTH + 2 entries
+ */
+std::vector<float> make_to_linear_lut(const TransferFunction &transfer);
+
+/**
+ * Create table approximating a conversion from linear light to non-linear encoding.
+ *
+ * The table is indexed by the upper 16 bits of the IEEE-754 representation of
+ * the input, dividing each octave into 128 segments. The lower 16 bits
+ * linearly interpolate within the segment. Inputs are clamped to the range of
+ * finite numbers. The interpolation error is at most 2e-6 on the nominal range.
+ *
+ * @param transfer transfer functions
+ * @return table of 2^16 + 1 entries
+ */
+std::vector<float> make_to_gamma_lut(const TransferFunction &transfer);
+
 /**
  * Create operation consisting of applying a 3x3 matrix to each pixel triplet.
  *
@@ -59,23 +106,81 @@ std::unique_ptr<Operation> create_gamma_operation(const TransferFunction &func,
  */
 std::unique_ptr<Operation> create_inverse_gamma_operation(const TransferFunction &func, const OperationParams &params, CPUClass cpu);
 
+/**
+ * Create operation consisting of a matrix, a conversion from linear light to
+ * non-linear encoding, and another matrix, evaluated in a single pass.
+ *
+ * Either matrix may be omitted by passing a null pointer, but not both.
+ *
+ * @param pre matrix applied before the transfer function, or nullptr
+ * @param transfer transfer functions
+ * @param post matrix applied after the transfer function, or nullptr
+ * @param params parameters
+ * @param cpu create operation optimized for given cpu
+ * @return concrete operation
+ */
+std::unique_ptr<Operation> create_fused_gamma_operation(const Matrix3x3 *pre, const TransferFunction &transfer, const Matrix3x3 *post, const OperationParams &params, CPUClass cpu);
+
+/**
+ * Create operation consisting of a matrix, a conversion from non-linear
+ * encoding to linear light, and another matrix, evaluated in a single pass.
+ *
+ * @see create_fused_gamma_operation
+ */
+std::unique_ptr<Operation> create_fused_inverse_gamma_operation(const Matrix3x3 *pre, const TransferFunction &transfer, const Matrix3x3 *post, const OperationParams &params, CPUClass cpu);
+
 /**
  * Create operation consisting of converting linear light to ARIB STD-B67 using display-referred EOTF.
  *
  * @param m RGB to YUV conversion matrix for color primaries
  * @param params parameters
+ * @param cpu create operation optimized for given cpu
  * @return concrete operation
  */
-std::unique_ptr<Operation> create_arib_b67_operation(const Matrix3x3 &m, const OperationParams &params);
+std::unique_ptr<Operation> create_arib_b67_operation(const Matrix3x3 &m, const OperationParams &params, CPUClass cpu);
 
 /**
  * Create operation consisting of converting ARIB STD-B67 to linear light using display-referred EOTF.
  *
  * @param m RGB to YUV conversion matrix for color primaries
  * @param params parameters
+ * @param cpu create operation optimized for given cpu
  * @return concrete operation
  */
-std::unique_ptr<Operation> create_inverse_arib_b67_operation(const Matrix3x3 &m, const OperationParams &params);
+std::unique_ptr<Operation> create_inverse_arib_b67_operation(const Matrix3x3 &m, const OperationParams &params, CPUClass cpu);
+
+/**
+ * Create operation consisting of compressing HDR linear light into the
+ * nominal range of an SDR signal.
+ *
+ * The source and target peak are taken from the parameters. The input and
+ * output are linear RGB.
+ *
+ * @param params parameters
+ * @param cpu create operation optimized for given cpu
+ * @return concrete operation
+ */
+std::unique_ptr<Operation> create_tone_map_operation(const OperationParams &params, CPUClass cpu);
+
+/**
+ * Create operation consisting of tetrahedral interpolation in a 3D LUT.
+ *
+ * Inputs outside of the grid are clamped to the boundary of the grid.
+ *
+ * @param lut LUT
+ * @param cpu create operation optimized for given cpu
+ * @return concrete operation
+ */
+std::unique_ptr<Operation> create_lut3d_operation(const Lut3D &lut, CPUClass cpu);
+
+/**
+ * Select conversion between HALF samples and the FLOAT samples processed by operations.
+ *
+ * @param to_half true if converting from FLOAT to HALF
+ * @param cpu select function optimized for given cpu
+ * @return conversion function, or nullptr if HALF is not supported on the cpu
+ */
+f16c_func select_f16c_func(bool to_half, CPUClass cpu);
 
 } // namespace colorspace
 } // namespace zimg
@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <cfloat>
+#include "common/except.h"
+#include "colorspace.h"
+#include "gamma.h"
+#include "gamma_constants.h"
+#include "tonemap.h"
+
+namespace zimg {
+namespace colorspace {
+
+namespace {
+
+using constants::HABLE_A;
+using constants::HABLE_B;
+using constants::HABLE_C;
+using constants::HABLE_D;
+using constants::HABLE_E;
+using constants::HABLE_F;
+
+float hable(float x) noexcept
+{
+	return (x * (HABLE_A * x + HABLE_C * HABLE_B) + HABLE_D * HABLE_E) / (x * (HABLE_A * x + HABLE_B) + HABLE_D * HABLE_F) - HABLE_E / HABLE_F;
+}
+
+// Hable curve divided by x. Rearranged to remain finite at zero.
+float hable_gain(float x) noexcept
+{
+	float num = (HABLE_F - HABLE_E) * HABLE_A * x + (HABLE_F * HABLE_C - HABLE_E) * HABLE_B;
+	float den = HABLE_F * (x * (HABLE_A * x + HABLE_B) + HABLE_D * HABLE_F);
+	return num / den;
+}
+
+// Hermite spline from ITU-R BT.2390-8 5.4.1, operating on normalized ST.2084 signal.
+float bt2390_gain(const ToneMapCurve &curve, float x) noexcept
+{
+	if (x < curve.knee_lin)
+		return 1.0f;
+
+	float e1 = st_2084_inverse_eotf(x * curve.pq_scale) / curve.pq_peak;
+	float t = std::max(e1 - curve.knee, 0.0f) / (1.0f - curve.knee);
+	float t2 = t * t;
+	float t3 = t2 * t;
+
+	float e2 = (2.0f * t3 - 3.0f * t2 + 1.0f) * curve.knee + (t3 - 2.0f * t2 + t) * (1.0f - curve.knee) + (-2.0f * t3 + 3.0f * t2) * curve.max_lum;
+	return st_2084_eotf(e2 * curve.pq_peak) / curve.pq_scale / x;
+}
+
+} // namespace
+
+
+ToneMapCurve select_tone_map_curve(ToneMapping method, double source_peak, double target_peak)
+{
+	ToneMapCurve curve{};
+	curve.method = method;
+	curve.peak = static_cast<float>(source_peak / target_peak);
+	curve.pq_scale = static_cast<float>(target_peak / ST2084_PEAK_LUMINANCE);
+
+	switch (method) {
+	case ToneMapping::BT2390:
+		curve.pq_peak = st_2084_inverse_eotf(curve.peak * curve.pq_scale);
+		curve.max_lum = st_2084_inverse_eotf(curve.pq_scale) / curve.pq_peak;
+		curve.knee = std::max(1.5f * curve.max_lum - 0.5f, 0.0f);
+		curve.knee_lin = st_2084_eotf(curve.knee * curve.pq_peak) / curve.pq_scale;
+		break;
+	case ToneMapping::HABLE:
+		curve.norm = 1.0f / hable(curve.peak);
+		break;
+	case ToneMapping::REINHARD:
+		curve.norm = 1.0f / (curve.peak * curve.peak);
+		break;
+	default:
+		error::throw_<error::InternalError>("invalid tone mapping");
+		break;
+	}
+
+	return curve;
+}
+
+float tone_map_gain(const ToneMapCurve &curve, float x) noexcept
+{
+	// Also removes NaN and non-positive values.
+	x = std::max(FLT_MIN, x);
+
+	if (x >= curve.peak)
+		return 1.0f / x;
+
+	switch (curve.method) {
+	case ToneMapping::BT2390:
+		return bt2390_gain(curve, x);
+	case ToneMapping::HABLE:
+		return hable_gain(x) * curve.norm;
+	case ToneMapping::REINHARD:
+		return (1.0f + x * curve.norm) / (1.0f + x);
+	default:
+		return 1.0f;
+	}
+}
+
+} // namespace colorspace
+} // namespace zimg
@@ -0,0 +1,51 @@
+#pragma once
+
+#ifndef ZIMG_COLORSPACE_TONEMAP_H_
+#define ZIMG_COLORSPACE_TONEMAP_H_
+
+namespace zimg {
+namespace colorspace {
+
+enum class ToneMapping;
+
+/**
+ * Parameters of a tone curve compressing linear light from a source peak into
+ * the nominal range [0, 1], where 1 corresponds to the target peak.
+ *
+ * The curve is applied to the maximum of the RGB components, and all
+ * components are scaled by the same gain to preserve chromaticity.
+ */
+struct ToneMapCurve {
+	ToneMapping method;
+	float peak;     // Source peak relative to target peak.
+	float pq_scale; // Target peak relative to ST.2084 peak.
+	float pq_peak;  // ST.2084 signal value of source peak.
+	float max_lum;  // ST.2084 signal value of target peak, normalized by pq_peak.
+	float knee;     // Start of BT.2390 roll-off, normalized by pq_peak.
+	float knee_lin; // Start of BT.2390 roll-off relative to target peak.
+	float norm;     // Normalization of the Hable and Reinhard curves.
+};
+
+/**
+ * Calculate tone curve parameters.
+ *
+ * @param method tone mapping operator
+ * @param source_peak peak luminance of source in cd/m^2
+ * @param target_peak peak luminance of target in cd/m^2
+ * @return curve parameters
+ */
+ToneMapCurve select_tone_map_curve(ToneMapping method, double source_peak, double target_peak);
+
+/**
+ * Calculate the gain applied to a pixel with maximum component x.
+ *
+ * @param curve curve parameters
+ * @param x maximum component in units of target peak
+ * @return gain
+ */
+float tone_map_gain(const ToneMapCurve &curve, float x) noexcept;
+
+} // namespace colorspace
+} // namespace zimg
+
+#endif // ZIMG_COLORSPACE_TONEMAP_H_
@@ -1,131 +1,867 @@
 #ifdef ZIMG_X86
 
 #include <algorithm>
+#include <cfloat>
 #include <cstdint>
+#include <utility>
 #include <vector>
 #include <immintrin.h>
 #include "common/align.h"
 #include "common/ccdep.h"
 #include "common/make_unique.h"
+#include "colorspace/colorspace.h"
 #include "colorspace/gamma.h"
+#include "colorspace/gamma_constants.h"
+#include "colorspace/matrix3.h"
 #include "colorspace/operation.h"
+#include "colorspace/operation_impl.h"
+#include "colorspace/tonemap.h"
 #include "operation_impl_x86.h"
 
+#include "common/x86/sse2_util.h"
+#include "common/x86/avx_util.h"
+
 namespace zimg {
 namespace colorspace {
 
 namespace {
 
-constexpr unsigned LUT_DEPTH = 16;
+inline FORCE_INLINE __m256 to_linear_lut_avx2(const float *lut, __m256 x)
+{
+	const float lut_limit = static_cast<float>(1U << TO_LINEAR_LUT_DEPTH);
+	__m256 v0, v1, t;
+	__m256i xi;
+
+	// Clamp to the table range. Also removes NaN.
+	x = _mm256_fmadd_ps(x, _mm256_set1_ps(0.5f * lut_limit), _mm256_set1_ps(0.25f * lut_limit));
+	x = _mm256_max_ps(x, _mm256_setzero_ps());
+	x = _mm256_min_ps(x, _mm256_set1_ps(lut_limit));
+
+	xi = _mm256_cvttps_epi32(x);
+	t = _mm256_sub_ps(x, _mm256_cvtepi32_ps(xi));
+
+	v0 = _mm256_i32gather_ps(lut, xi, sizeof(float));
+	v1 = _mm256_i32gather_ps(lut + 1, xi, sizeof(float));
+	return _mm256_fmadd_ps(_mm256_sub_ps(v1, v0), t, v0);
+}
+
+inline FORCE_INLINE __m256 to_gamma_lut_avx2(const float *lut, __m256 x)
+{
+	__m256 v0, v1, t;
+	__m256i xi;
+
+	// Clamp to the range of finite numbers. Also removes NaN.
+	x = _mm256_max_ps(x, _mm256_set1_ps(-FLT_MAX));
+	x = _mm256_min_ps(x, _mm256_set1_ps(FLT_MAX));
+
+	// Index by the upper half of the float and interpolate by the lower half.
+	xi = _mm256_castps_si256(x);
+	t = _mm256_cvtepi32_ps(_mm256_and_si256(xi, _mm256_set1_epi32(0xFFFF)));
+	t = _mm256_mul_ps(t, _mm256_set1_ps(1.0f / 65536.0f));
+	xi = _mm256_srli_epi32(xi, 16);
 
-void to_linear_lut_filter_line(const float *RESTRICT lut, unsigned lut_depth, const float *src, float *dst, unsigned left, unsigned right)
+	v0 = _mm256_i32gather_ps(lut, xi, sizeof(float));
+	v1 = _mm256_i32gather_ps(lut + 1, xi, sizeof(float));
+	return _mm256_fmadd_ps(_mm256_sub_ps(v1, v0), t, v0);
+}
+
+template <bool Inverse>
+void gamma_lut_filter_line(const float *RESTRICT lut, const float *src, float *dst, unsigned left, unsigned right)
 {
 	unsigned vec_left = ceil_n(left, 8);
 	unsigned vec_right = floor_n(right, 8);
 
-	const int32_t lut_limit = static_cast<int32_t>(1) << lut_depth;
-
-	const __m256 scale = _mm256_set1_ps(0.5f * lut_limit);
-	const __m256 offset = _mm256_set1_ps(0.25f * lut_limit);
-	const __m256i zero = _mm256_setzero_si256();
-	const __m256i limit = _mm256_set1_epi32(lut_limit);
+	auto eval = [=](__m256 x) { return Inverse ? to_linear_lut_avx2(lut, x) : to_gamma_lut_avx2(lut, x); };
 
-	for (unsigned j = left; j < vec_left; ++j) {
-		__m128 x = _mm_load_ss(src + j);
-		int idx = _mm_cvt_ss2si(_mm_fmadd_ss(x, _mm256_castps256_ps128(scale), _mm256_castps256_ps128(offset)));
-		dst[j] = lut[std::min(std::max(idx, 0), lut_limit)];
+	if (left != vec_left) {
+		__m256 x = eval(_mm256_load_ps(src + vec_left - 8));
+		mm256_store_idxhi_ps(dst + vec_left - 8, x, left % 8);
 	}
 	for (unsigned j = vec_left; j < vec_right; j += 8) {
-		__m256 x;
-		__m256i xi;
-
-		x = _mm256_load_ps(src + j);
-		x = _mm256_fmadd_ps(x, scale, offset);
-		xi = _mm256_cvtps_epi32(x);
-		xi = _mm256_max_epi32(xi, zero);
-		xi = _mm256_min_epi32(xi, limit);
-		x = _mm256_i32gather_ps(lut, xi, sizeof(float));
+		__m256 x = eval(_mm256_load_ps(src + j));
 		_mm256_store_ps(dst + j, x);
 	}
-	for (unsigned j = vec_right; j < right; ++j) {
-		__m128 x = _mm_load_ss(src + j);
-		int idx = _mm_cvt_ss2si(_mm_fmadd_ss(x, _mm256_castps256_ps128(scale), _mm256_castps256_ps128(offset)));
-		dst[j] = lut[std::min(std::max(idx, 0), lut_limit)];
+	if (right != vec_right) {
+		__m256 x = eval(_mm256_load_ps(src + vec_right));
+		mm256_store_idxlo_ps(dst + vec_right, x, right % 8);
+	}
+}
+
+// log2(x) for positive normal x.
+inline FORCE_INLINE __m256 log2_ps_avx2(__m256 x)
+{
+	__m256i bits = _mm256_castps_si256(x);
+	__m256 mant, exp, t, p, mask;
+
+	// Decompose into mantissa on [sqrt(0.5), sqrt(2)) and exponent.
+	mant = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F800000)));
+	exp = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127)));
+	mask = _mm256_cmp_ps(mant, _mm256_set1_ps(1.41421356f), _CMP_GE_OQ);
+	mant = _mm256_blendv_ps(mant, _mm256_mul_ps(mant, _mm256_set1_ps(0.5f)), mask);
+	exp = _mm256_add_ps(exp, _mm256_and_ps(mask, _mm256_set1_ps(1.0f)));
+
+	t = _mm256_sub_ps(mant, _mm256_set1_ps(1.0f));
+	p = _mm256_set1_ps(constants::LOG2_HORNER[0]);
+	p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(constants::LOG2_HORNER[1]));
+	p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(constants::LOG2_HORNER[2]));
+	p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(constants::LOG2_HORNER[3]));
+	p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(constants::LOG2_HORNER[4]));
+	p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(constants::LOG2_HORNER[5]));
+	p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(constants::LOG2_HORNER[6]));
+	p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(constants::LOG2_HORNER[7]));
+
+	return _mm256_fmadd_ps(p, t, exp);
+}
+
+inline FORCE_INLINE __m256 exp2_ps_avx2(__m256 x)
+{
+	__m256 n, f, p;
+	__m256i e;
+
+	// Clamp to the range of normal numbers. Also removes NaN.
+	x = _mm256_max_ps(x, _mm256_set1_ps(-126.0f));
+	x = _mm256_min_ps(x, _mm256_set1_ps(126.0f));
+
+	// Split into integer and fractional part on [-0.5, 0.5].
+	n = _mm256_round_ps(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+	f = _mm256_sub_ps(x, n);
+
+	p = _mm256_set1_ps(constants::EXP2_HORNER[0]);
+	p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(constants::EXP2_HORNER[1]));
+	p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(constants::EXP2_HORNER[2]));
+	p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(constants::EXP2_HORNER[3]));
+	p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(constants::EXP2_HORNER[4]));
+	p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(constants::EXP2_HORNER[5]));
+	p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(constants::EXP2_HORNER[6]));
+
+	// Construct 2^n in the exponent field.
+	e = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23);
+	return _mm256_mul_ps(p, _mm256_castsi256_ps(e));
+}
+
+inline FORCE_INLINE __m256 arib_b67_oetf_avx2(__m256 x)
+{
+	__m256 lo, hi, mask;
+
+	// Also removes NaN.
+	x = _mm256_max_ps(x, _mm256_setzero_ps());
+	mask = _mm256_cmp_ps(x, _mm256_set1_ps(1.0f / 12.0f), _CMP_LE_OQ);
+
+	// sqrt(3 * x)
+	lo = _mm256_sqrt_ps(_mm256_mul_ps(x, _mm256_set1_ps(3.0f)));
+
+	// a * ln(12 * x - b) + c
+	hi = _mm256_fmsub_ps(x, _mm256_set1_ps(12.0f), _mm256_set1_ps(constants::ARIB_B67_B));
+	hi = log2_ps_avx2(hi);
+	hi = _mm256_fmadd_ps(hi, _mm256_set1_ps(constants::ARIB_B67_A * 0.693147181f), _mm256_set1_ps(constants::ARIB_B67_C));
+
+	return _mm256_blendv_ps(hi, lo, mask);
+}
+
+inline FORCE_INLINE __m256 arib_b67_inverse_oetf_avx2(__m256 x)
+{
+	__m256 lo, hi, mask;
+
+	x = _mm256_max_ps(x, _mm256_setzero_ps());
+	mask = _mm256_cmp_ps(x, _mm256_set1_ps(0.5f), _CMP_LE_OQ);
+
+	// x^2 / 3
+	lo = _mm256_mul_ps(_mm256_mul_ps(x, x), _mm256_set1_ps(1.0f / 3.0f));
+
+	// (exp((x - c) / a) + b) / 12
+	hi = _mm256_fmadd_ps(x, _mm256_set1_ps(1.442695041f / constants::ARIB_B67_A), _mm256_set1_ps(-1.442695041f * constants::ARIB_B67_C / constants::ARIB_B67_A));
+	hi = exp2_ps_avx2(hi);
+	hi = _mm256_mul_ps(_mm256_add_ps(hi, _mm256_set1_ps(constants::ARIB_B67_B)), _mm256_set1_ps(1.0f / 12.0f));
+
+	return _mm256_blendv_ps(hi, lo, mask);
+}
+
+template <bool Inverse>
+inline FORCE_INLINE void arib_b67_filter_line_avx2_xiter(unsigned j, const float *src0, const float *src1, const float *src2,
+                                                         const __m256 &kr, const __m256 &kg, const __m256 &kb, const __m256 &scale,
+                                                         __m256 &out0, __m256 &out1, __m256 &out2)
+{
+	__m256 r = _mm256_load_ps(src0 + j);
+	__m256 g = _mm256_load_ps(src1 + j);
+	__m256 b = _mm256_load_ps(src2 + j);
+	__m256 y;
+
+	if (Inverse) {
+		r = arib_b67_inverse_oetf_avx2(r);
+		g = arib_b67_inverse_oetf_avx2(g);
+		b = arib_b67_inverse_oetf_avx2(b);
+
+		// ys^(gamma - 1)
+		y = _mm256_mul_ps(kr, r);
+		y = _mm256_fmadd_ps(kg, g, y);
+		y = _mm256_fmadd_ps(kb, b, y);
+		y = _mm256_max_ps(y, _mm256_set1_ps(FLT_MIN));
+		y = exp2_ps_avx2(_mm256_mul_ps(log2_ps_avx2(y), _mm256_set1_ps(0.2f)));
+		y = _mm256_mul_ps(y, scale);
+
+		out0 = _mm256_mul_ps(r, y);
+		out1 = _mm256_mul_ps(g, y);
+		out2 = _mm256_mul_ps(b, y);
+	} else {
+		r = _mm256_mul_ps(r, scale);
+		g = _mm256_mul_ps(g, scale);
+		b = _mm256_mul_ps(b, scale);
+
+		// yd^((1 - gamma) / gamma)
+		y = _mm256_mul_ps(kr, r);
+		y = _mm256_fmadd_ps(kg, g, y);
+		y = _mm256_fmadd_ps(kb, b, y);
+		y = _mm256_max_ps(y, _mm256_set1_ps(FLT_MIN));
+		y = exp2_ps_avx2(_mm256_mul_ps(log2_ps_avx2(y), _mm256_set1_ps(-0.2f / 1.2f)));
+
+		out0 = arib_b67_oetf_avx2(_mm256_mul_ps(r, y));
+		out1 = arib_b67_oetf_avx2(_mm256_mul_ps(g, y));
+		out2 = arib_b67_oetf_avx2(_mm256_mul_ps(b, y));
+	}
+}
+
+template <bool Inverse>
+void arib_b67_filter_line_avx2(const float *coeffs, const float * const * RESTRICT src, float * const * RESTRICT dst, unsigned left, unsigned right)
+{
+	const float *src0 = src[0];
+	const float *src1 = src[1];
+	const float *src2 = src[2];
+	float *dst0 = dst[0];
+	float *dst1 = dst[1];
+	float *dst2 = dst[2];
+
+	const __m256 kr = _mm256_set1_ps(coeffs[0]);
+	const __m256 kg = _mm256_set1_ps(coeffs[1]);
+	const __m256 kb = _mm256_set1_ps(coeffs[2]);
+	const __m256 scale = _mm256_set1_ps(coeffs[3]);
+	__m256 out0, out1, out2;
+
+	unsigned vec_left = ceil_n(left, 8);
+	unsigned vec_right = floor_n(right, 8);
+
+#define XITER arib_b67_filter_line_avx2_xiter<Inverse>
+#define XARGS src0, src1, src2, kr, kg, kb, scale, out0, out1, out2
+	if (left != vec_left) {
+		XITER(vec_left - 8, XARGS);
+
+		mm256_store_idxhi_ps(dst0 + vec_left - 8, out0, left % 8);
+		mm256_store_idxhi_ps(dst1 + vec_left - 8, out1, left % 8);
+		mm256_store_idxhi_ps(dst2 + vec_left - 8, out2, left % 8);
+	}
+
+	for (unsigned j = vec_left; j < vec_right; j += 8) {
+		XITER(j, XARGS);
+
+		_mm256_store_ps(dst0 + j, out0);
+		_mm256_store_ps(dst1 + j, out1);
+		_mm256_store_ps(dst2 + j, out2);
+	}
+
+	if (right != vec_right) {
+		XITER(vec_right, XARGS);
+
+		mm256_store_idxlo_ps(dst0 + vec_right, out0, right % 8);
+		mm256_store_idxlo_ps(dst1 + vec_right, out1, right % 8);
+		mm256_store_idxlo_ps(dst2 + vec_right, out2, right % 8);
+	}
+#undef XITER
+#undef XARGS
+}
+
+inline FORCE_INLINE __m256 rec_709_oetf_avx2(__m256 x)
+{
+	__m256 lo, hi, mask;
+
+	// Also removes NaN.
+	x = _mm256_max_ps(x, _mm256_setzero_ps());
+	mask = _mm256_cmp_ps(x, _mm256_set1_ps(constants::REC709_BETA), _CMP_LT_OQ);
+
+	lo = _mm256_mul_ps(x, _mm256_set1_ps(4.5f));
+
+	// alpha * x^0.45 - (alpha - 1)
+	hi = exp2_ps_avx2(_mm256_mul_ps(log2_ps_avx2(x), _mm256_set1_ps(0.45f)));
+	hi = _mm256_fmsub_ps(hi, _mm256_set1_ps(constants::REC709_ALPHA), _mm256_set1_ps(constants::REC709_ALPHA - 1.0f));
+
+	return _mm256_blendv_ps(hi, lo, mask);
+}
+
+inline FORCE_INLINE __m256 rec_709_inverse_oetf_avx2(__m256 x)
+{
+	__m256 lo, hi, mask;
+
+	x = _mm256_max_ps(x, _mm256_setzero_ps());
+	mask = _mm256_cmp_ps(x, _mm256_set1_ps(4.5f * constants::REC709_BETA), _CMP_LT_OQ);
+
+	lo = _mm256_mul_ps(x, _mm256_set1_ps(1.0f / 4.5f));
+
+	// ((x + (alpha - 1)) / alpha)^(1 / 0.45)
+	hi = _mm256_div_ps(_mm256_add_ps(x, _mm256_set1_ps(constants::REC709_ALPHA - 1.0f)), _mm256_set1_ps(constants::REC709_ALPHA));
+	hi = exp2_ps_avx2(_mm256_mul_ps(log2_ps_avx2(hi), _mm256_set1_ps(1.0f / 0.45f)));
+
+	return _mm256_blendv_ps(hi, lo, mask);
+}
+
+inline FORCE_INLINE void cl_to_rgb_filter_line_avx2_xiter(unsigned j, const float *src0, const float *src1, const float *src2, const float *coeffs,
+                                                          __m256 &out0, __m256 &out1, __m256 &out2)
+{
+	const __m256 zero = _mm256_setzero_ps();
+
+	__m256 y = _mm256_load_ps(src0 + j);
+	__m256 u = _mm256_load_ps(src1 + j);
+	__m256 v = _mm256_load_ps(src2 + j);
+	__m256 r, g, b, kb, kr;
+
+	// Select the chroma scale by the sign of the difference.
+	kb = _mm256_blendv_ps(_mm256_broadcast_ss(coeffs + 5), _mm256_broadcast_ss(coeffs + 4), _mm256_cmp_ps(u, zero, _CMP_LT_OQ));
+	kr = _mm256_blendv_ps(_mm256_broadcast_ss(coeffs + 7), _mm256_broadcast_ss(coeffs + 6), _mm256_cmp_ps(v, zero, _CMP_LT_OQ));
+
+	b = rec_709_inverse_oetf_avx2(_mm256_fmadd_ps(_mm256_add_ps(u, u), kb, y));
+	r = rec_709_inverse_oetf_avx2(_mm256_fmadd_ps(_mm256_add_ps(v, v), kr, y));
+	y = rec_709_inverse_oetf_avx2(y);
+
+	g = _mm256_fnmadd_ps(_mm256_broadcast_ss(coeffs + 0), r, y);
+	g = _mm256_fnmadd_ps(_mm256_broadcast_ss(coeffs + 2), b, g);
+	g = _mm256_div_ps(g, _mm256_broadcast_ss(coeffs + 1));
+
+	out0 = _mm256_mul_ps(r, _mm256_broadcast_ss(coeffs + 8));
+	out1 = _mm256_mul_ps(g, _mm256_broadcast_ss(coeffs + 8));
+	out2 = _mm256_mul_ps(b, _mm256_broadcast_ss(coeffs + 8));
+}
+
+inline FORCE_INLINE void cl_to_yuv_filter_line_avx2_xiter(unsigned j, const float *src0, const float *src1, const float *src2, const float *coeffs,
+                                                          __m256 &out0, __m256 &out1, __m256 &out2)
+{
+	const __m256 zero = _mm256_setzero_ps();
+
+	__m256 r = _mm256_mul_ps(_mm256_load_ps(src0 + j), _mm256_broadcast_ss(coeffs + 8));
+	__m256 g = _mm256_mul_ps(_mm256_load_ps(src1 + j), _mm256_broadcast_ss(coeffs + 8));
+	__m256 b = _mm256_mul_ps(_mm256_load_ps(src2 + j), _mm256_broadcast_ss(coeffs + 8));
+	__m256 y, kb, kr;
+
+	y = _mm256_mul_ps(_mm256_broadcast_ss(coeffs + 0), r);
+	y = _mm256_fmadd_ps(_mm256_broadcast_ss(coeffs + 1), g, y);
+	y = _mm256_fmadd_ps(_mm256_broadcast_ss(coeffs + 2), b, y);
+	y = rec_709_oetf_avx2(y);
+
+	b = _mm256_sub_ps(rec_709_oetf_avx2(b), y);
+	r = _mm256_sub_ps(rec_709_oetf_avx2(r), y);
+
+	// Select the chroma scale by the sign of the difference.
+	kb = _mm256_blendv_ps(_mm256_broadcast_ss(coeffs + 5), _mm256_broadcast_ss(coeffs + 4), _mm256_cmp_ps(b, zero, _CMP_LT_OQ));
+	kr = _mm256_blendv_ps(_mm256_broadcast_ss(coeffs + 7), _mm256_broadcast_ss(coeffs + 6), _mm256_cmp_ps(r, zero, _CMP_LT_OQ));
+
+	out0 = y;
+	out1 = _mm256_div_ps(b, _mm256_add_ps(kb, kb));
+	out2 = _mm256_div_ps(r, _mm256_add_ps(kr, kr));
+}
+
+template <bool ToRGB>
+void cl_filter_line_avx2(const float *coeffs, const float * const * RESTRICT src, float * const * RESTRICT dst, unsigned left, unsigned right)
+{
+	const float *src0 = src[0];
+	const float *src1 = src[1];
+	const float *src2 = src[2];
+	float *dst0 = dst[0];
+	float *dst1 = dst[1];
+	float *dst2 = dst[2];
+	__m256 out0, out1, out2;
+
+	unsigned vec_left = ceil_n(left, 8);
+	unsigned vec_right = floor_n(right, 8);
+
+#define XITER (ToRGB ? cl_to_rgb_filter_line_avx2_xiter : cl_to_yuv_filter_line_avx2_xiter)
+#define XARGS src0, src1, src2, coeffs, out0, out1, out2
+	if (left != vec_left) {
+		XITER(vec_left - 8, XARGS);
+
+		mm256_store_idxhi_ps(dst0 + vec_left - 8, out0, left % 8);
+		mm256_store_idxhi_ps(dst1 + vec_left - 8, out1, left % 8);
+		mm256_store_idxhi_ps(dst2 + vec_left - 8, out2, left % 8);
+	}
+
+	for (unsigned j = vec_left; j < vec_right; j += 8) {
+		XITER(j, XARGS);
+
+		_mm256_store_ps(dst0 + j, out0);
+		_mm256_store_ps(dst1 + j, out1);
+		_mm256_store_ps(dst2 + j, out2);
+	}
+
+	if (right != vec_right) {
+		XITER(vec_right, XARGS);
+
+		mm256_store_idxlo_ps(dst0 + vec_right, out0, right % 8);
+		mm256_store_idxlo_ps(dst1 + vec_right, out1, right % 8);
+		mm256_store_idxlo_ps(dst2 + vec_right, out2, right % 8);
+	}
+#undef XITER
+#undef XARGS
+}
+
+inline FORCE_INLINE void matrix_avx2(const float *m, __m256 &a, __m256 &b, __m256 &c)
+{
+	__m256 x, y, z;
+	__m256 out0, out1, out2;
+
+	// Same evaluation order as the AVX matrix operation.
+	x = _mm256_mul_ps(_mm256_broadcast_ss(m + 0), a);
+	y = _mm256_mul_ps(_mm256_broadcast_ss(m + 1), b);
+	z = _mm256_mul_ps(_mm256_broadcast_ss(m + 2), c);
+	out0 = _mm256_add_ps(_mm256_add_ps(x, y), z);
+
+	x = _mm256_mul_ps(_mm256_broadcast_ss(m + 3), a);
+	y = _mm256_mul_ps(_mm256_broadcast_ss(m + 4), b);
+	z = _mm256_mul_ps(_mm256_broadcast_ss(m + 5), c);
+	out1 = _mm256_add_ps(_mm256_add_ps(x, y), z);
+
+	x = _mm256_mul_ps(_mm256_broadcast_ss(m + 6), a);
+	y = _mm256_mul_ps(_mm256_broadcast_ss(m + 7), b);
+	z = _mm256_mul_ps(_mm256_broadcast_ss(m + 8), c);
+	out2 = _mm256_add_ps(_mm256_add_ps(x, y), z);
+
+	a = out0;
+	b = out1;
+	c = out2;
+}
+
+template <bool Inverse, bool Pre, bool Post>
+inline FORCE_INLINE void fused_gamma_filter_line_avx2_xiter(unsigned j, const float *src0, const float *src1, const float *src2,
+                                                            const float *lut, const float *pre, const float *post,
+                                                            __m256 &out0, __m256 &out1, __m256 &out2)
+{
+	__m256 a = _mm256_load_ps(src0 + j);
+	__m256 b = _mm256_load_ps(src1 + j);
+	__m256 c = _mm256_load_ps(src2 + j);
+
+	if (Pre)
+		matrix_avx2(pre, a, b, c);
+
+	if (Inverse) {
+		a = to_linear_lut_avx2(lut, a);
+		b = to_linear_lut_avx2(lut, b);
+		c = to_linear_lut_avx2(lut, c);
+	} else {
+		a = to_gamma_lut_avx2(lut, a);
+		b = to_gamma_lut_avx2(lut, b);
+		c = to_gamma_lut_avx2(lut, c);
+	}
+
+	if (Post)
+		matrix_avx2(post, a, b, c);
+
+	out0 = a;
+	out1 = b;
+	out2 = c;
+}
+
+template <bool Inverse, bool Pre, bool Post>
+void fused_gamma_filter_line_avx2(const float *lut, const float *pre, const float *post, const float * const * RESTRICT src, float * const * RESTRICT dst, unsigned left, unsigned right)
+{
+	const float *src0 = src[0];
+	const float *src1 = src[1];
+	const float *src2 = src[2];
+	float *dst0 = dst[0];
+	float *dst1 = dst[1];
+	float *dst2 = dst[2];
+	__m256 out0, out1, out2;
+
+	unsigned vec_left = ceil_n(left, 8);
+	unsigned vec_right = floor_n(right, 8);
+
+#define XITER fused_gamma_filter_line_avx2_xiter<Inverse, Pre, Post>
+#define XARGS src0, src1, src2, lut, pre, post, out0, out1, out2
+	if (left != vec_left) {
+		XITER(vec_left - 8, XARGS);
+
+		mm256_store_idxhi_ps(dst0 + vec_left - 8, out0, left % 8);
+		mm256_store_idxhi_ps(dst1 + vec_left - 8, out1, left % 8);
+		mm256_store_idxhi_ps(dst2 + vec_left - 8, out2, left % 8);
 	}
+
+	for (unsigned j = vec_left; j < vec_right; j += 8) {
+		XITER(j, XARGS);
+
+		_mm256_store_ps(dst0 + j, out0);
+		_mm256_store_ps(dst1 + j, out1);
+		_mm256_store_ps(dst2 + j, out2);
+	}
+
+	if (right != vec_right) {
+		XITER(vec_right, XARGS);
+
+		mm256_store_idxlo_ps(dst0 + vec_right, out0, right % 8);
+		mm256_store_idxlo_ps(dst1 + vec_right, out1, right % 8);
+		mm256_store_idxlo_ps(dst2 + vec_right, out2, right % 8);
+	}
+#undef XITER
+#undef XARGS
+}
+
+inline FORCE_INLINE __m256 st_2084_eotf_avx2(__m256 x)
+{
+	__m256 xpow, num, den;
+
+	// Input must be positive.
+	xpow = exp2_ps_avx2(_mm256_mul_ps(log2_ps_avx2(x), _mm256_set1_ps(1.0f / constants::ST2084_M2)));
+	num = _mm256_max_ps(_mm256_sub_ps(xpow, _mm256_set1_ps(constants::ST2084_C1)), _mm256_set1_ps(FLT_MIN));
+	den = _mm256_max_ps(_mm256_fnmadd_ps(xpow, _mm256_set1_ps(constants::ST2084_C3), _mm256_set1_ps(constants::ST2084_C2)), _mm256_set1_ps(FLT_MIN));
+	return exp2_ps_avx2(_mm256_mul_ps(log2_ps_avx2(_mm256_div_ps(num, den)), _mm256_set1_ps(1.0f / constants::ST2084_M1)));
+}
+
+inline FORCE_INLINE __m256 st_2084_inverse_eotf_avx2(__m256 x)
+{
+	__m256 xpow, num, den;
+
+	// Input must be positive.
+	xpow = exp2_ps_avx2(_mm256_mul_ps(log2_ps_avx2(x), _mm256_set1_ps(constants::ST2084_M1)));
+	num = _mm256_fmadd_ps(xpow, _mm256_set1_ps(constants::ST2084_C2 - constants::ST2084_C3), _mm256_set1_ps(constants::ST2084_C1 - 1.0f));
+	den = _mm256_fmadd_ps(xpow, _mm256_set1_ps(constants::ST2084_C3), _mm256_set1_ps(1.0f));
+	return exp2_ps_avx2(_mm256_mul_ps(log2_ps_avx2(_mm256_add_ps(_mm256_div_ps(num, den), _mm256_set1_ps(1.0f))), _mm256_set1_ps(constants::ST2084_M2)));
+}
+
+inline FORCE_INLINE __m256 bt2390_gain_avx2(const ToneMapCurve &curve, __m256 x)
+{
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 knee = _mm256_broadcast_ss(&curve.knee);
+	__m256 mask, e1, e2, t, t2, t3, p0, p1, p2;
+
+	// Most pixels are below the knee, where the curve is the identity.
+	mask = _mm256_cmp_ps(x, _mm256_broadcast_ss(&curve.knee_lin), _CMP_LT_OQ);
+	if (_mm256_movemask_ps(mask) == 0xFF)
+		return one;
+
+	e1 = _mm256_div_ps(st_2084_inverse_eotf_avx2(_mm256_mul_ps(x, _mm256_broadcast_ss(&curve.pq_scale))), _mm256_broadcast_ss(&curve.pq_peak));
+	t = _mm256_div_ps(_mm256_max_ps(_mm256_sub_ps(e1, knee), _mm256_setzero_ps()), _mm256_sub_ps(one, knee));
+	t2 = _mm256_mul_ps(t, t);
+	t3 = _mm256_mul_ps(t2, t);
+
+	// Hermite basis functions.
+	p0 = _mm256_fmadd_ps(_mm256_set1_ps(2.0f), t3, _mm256_fnmadd_ps(_mm256_set1_ps(3.0f), t2, one));
+	p1 = _mm256_add_ps(_mm256_fnmadd_ps(_mm256_set1_ps(2.0f), t2, t3), t);
+	p2 = _mm256_fmsub_ps(_mm256_set1_ps(3.0f), t2, _mm256_add_ps(t3, t3));
+
+	e2 = _mm256_mul_ps(p0, knee);
+	e2 = _mm256_fmadd_ps(p1, _mm256_sub_ps(one, knee), e2);
+	e2 = _mm256_fmadd_ps(p2, _mm256_broadcast_ss(&curve.max_lum), e2);
+
+	e2 = st_2084_eotf_avx2(_mm256_mul_ps(e2, _mm256_broadcast_ss(&curve.pq_peak)));
+	e2 = _mm256_div_ps(e2, _mm256_mul_ps(_mm256_broadcast_ss(&curve.pq_scale), x));
+
+	return _mm256_blendv_ps(e2, one, mask);
+}
+
+inline FORCE_INLINE __m256 hable_gain_avx2(const ToneMapCurve &curve, __m256 x)
+{
+	using namespace constants;
+	__m256 num, den;
+
+	num = _mm256_fmadd_ps(x, _mm256_set1_ps((HABLE_F - HABLE_E) * HABLE_A), _mm256_set1_ps((HABLE_F * HABLE_C - HABLE_E) * HABLE_B));
+	den = _mm256_fmadd_ps(x, _mm256_set1_ps(HABLE_A), _mm256_set1_ps(HABLE_B));
+	den = _mm256_fmadd_ps(x, den, _mm256_set1_ps(HABLE_D * HABLE_F));
+	den = _mm256_mul_ps(den, _mm256_set1_ps(HABLE_F));
+
+	return _mm256_mul_ps(_mm256_div_ps(num, den), _mm256_broadcast_ss(&curve.norm));
+}
+
+inline FORCE_INLINE __m256 reinhard_gain_avx2(const ToneMapCurve &curve, __m256 x)
+{
+	const __m256 one = _mm256_set1_ps(1.0f);
+	return _mm256_div_ps(_mm256_fmadd_ps(x, _mm256_broadcast_ss(&curve.norm), one), _mm256_add_ps(x, one));
+}
+
+template <ToneMapping Method>
+inline FORCE_INLINE void tone_map_filter_line_avx2_xiter(unsigned j, const float *src0, const float *src1, const float *src2, const ToneMapCurve &curve,
+                                                         __m256 &out0, __m256 &out1, __m256 &out2)
+{
+	__m256 r = _mm256_load_ps(src0 + j);
+	__m256 g = _mm256_load_ps(src1 + j);
+	__m256 b = _mm256_load_ps(src2 + j);
+	__m256 x, gain, mask;
+
+	// Also removes NaN and non-positive values.
+	x = _mm256_max_ps(_mm256_max_ps(r, g), b);
+	x = _mm256_max_ps(x, _mm256_set1_ps(FLT_MIN));
+
+	if (Method == ToneMapping::BT2390)
+		gain = bt2390_gain_avx2(curve, x);
+	else if (Method == ToneMapping::HABLE)
+		gain = hable_gain_avx2(curve, x);
+	else
+		gain = reinhard_gain_avx2(curve, x);
+
+	// Clip above the source peak.
+	mask = _mm256_cmp_ps(x, _mm256_broadcast_ss(&curve.peak), _CMP_GE_OQ);
+	gain = _mm256_blendv_ps(gain, _mm256_div_ps(_mm256_set1_ps(1.0f), x), mask);
+
+	out0 = _mm256_mul_ps(r, gain);
+	out1 = _mm256_mul_ps(g, gain);
+	out2 = _mm256_mul_ps(b, gain);
 }
 
-void to_gamma_lut_filter_line(const float *RESTRICT lut, const float *src, float *dst, unsigned left, unsigned right)
+template <ToneMapping Method>
+void tone_map_filter_line_avx2(const ToneMapCurve &curve, const float * const * RESTRICT src, float * const * RESTRICT dst, unsigned left, unsigned right)
 {
+	const float *src0 = src[0];
+	const float *src1 = src[1];
+	const float *src2 = src[2];
+	float *dst0 = dst[0];
+	float *dst1 = dst[1];
+	float *dst2 = dst[2];
+	__m256 out0, out1, out2;
+
 	unsigned vec_left = ceil_n(left, 8);
 	unsigned vec_right = floor_n(right, 8);
 
-	for (unsigned j = left; j < vec_left; ++j) {
-		__m128 x = _mm_load_ss(src + j);
-		int idx = _mm_extract_epi16(_mm_cvtps_ph(x, 0), 0);
-		dst[j] = lut[idx];
+#define XITER tone_map_filter_line_avx2_xiter<Method>
+#define XARGS src0, src1, src2, curve, out0, out1, out2
+	if (left != vec_left) {
+		XITER(vec_left - 8, XARGS);
+
+		mm256_store_idxhi_ps(dst0 + vec_left - 8, out0, left % 8);
+		mm256_store_idxhi_ps(dst1 + vec_left - 8, out1, left % 8);
+		mm256_store_idxhi_ps(dst2 + vec_left - 8, out2, left % 8);
 	}
+
 	for (unsigned j = vec_left; j < vec_right; j += 8) {
+		XITER(j, XARGS);
+
+		_mm256_store_ps(dst0 + j, out0);
+		_mm256_store_ps(dst1 + j, out1);
+		_mm256_store_ps(dst2 + j, out2);
+	}
+
+	if (right != vec_right) {
+		XITER(vec_right, XARGS);
+
+		mm256_store_idxlo_ps(dst0 + vec_right, out0, right % 8);
+		mm256_store_idxlo_ps(dst1 + vec_right, out1, right % 8);
+		mm256_store_idxlo_ps(dst2 + vec_right, out2, right % 8);
+	}
+#undef XITER
+#undef XARGS
+}
+
+inline FORCE_INLINE void lut3d_compare_exchange_avx2(__m256 &fa, __m256i &sa, __m256 &fb, __m256i &sb)
+{
+	__m256 mask = _mm256_cmp_ps(fa, fb, _CMP_LT_OQ);
+	__m256 fa_ = _mm256_blendv_ps(fa, fb, mask);
+	__m256 fb_ = _mm256_blendv_ps(fb, fa, mask);
+	__m256i sa_ = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(sa), _mm256_castsi256_ps(sb), mask));
+	__m256i sb_ = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(sb), _mm256_castsi256_ps(sa), mask));
+
+	fa = fa_;
+	fb = fb_;
+	sa = sa_;
+	sb = sb_;
+}
+
+inline FORCE_INLINE void lut3d_filter_line_avx2_xiter(unsigned j, const Lut3D &lut, const float *src0, const float *src1, const float *src2,
+                                                      __m256 &out0, __m256 &out1, __m256 &out2)
+{
+	const float *data = lut.data.data();
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 limit = _mm256_set1_ps(static_cast<float>(lut.size - 1));
+	const __m256i idx_limit = _mm256_set1_epi32(lut.size - 2);
+	const float *src[3] = { src0, src1, src2 };
+
+	__m256 f[3];
+	__m256i s[3];
+	__m256i idx = _mm256_setzero_si256();
+
+	for (unsigned p = 0; p < 3; ++p) {
+		unsigned stride = p == 0 ? 4 : p == 1 ? 4 * lut.size : 4 * lut.size * lut.size;
+		__m256 u = _mm256_load_ps(src[p] + j);
+		__m256i k;
+
+		u = _mm256_fmadd_ps(u, _mm256_set1_ps(lut.scale[p]), _mm256_set1_ps(lut.offset[p]));
+		u = _mm256_max_ps(u, zero); // Also removes NaN.
+		u = _mm256_min_ps(u, limit);
+
+		k = _mm256_cvttps_epi32(u);
+		k = _mm256_min_epi32(k, idx_limit);
+
+		f[p] = _mm256_sub_ps(u, _mm256_cvtepi32_ps(k));
+		s[p] = _mm256_set1_epi32(stride);
+		idx = _mm256_add_epi32(idx, _mm256_mullo_epi32(k, s[p]));
+	}
+
+	// Sort the fractions in descending order to select the tetrahedron.
+	lut3d_compare_exchange_avx2(f[0], s[0], f[1], s[1]);
+	lut3d_compare_exchange_avx2(f[1], s[1], f[2], s[2]);
+	lut3d_compare_exchange_avx2(f[0], s[0], f[1], s[1]);
+
+	__m256i idx1 = _mm256_add_epi32(idx, s[0]);
+	__m256i idx2 = _mm256_add_epi32(idx1, s[1]);
+	__m256i idx3 = _mm256_add_epi32(idx2, s[2]);
+
+	__m256 w0 = _mm256_sub_ps(_mm256_set1_ps(1.0f), f[0]);
+	__m256 w1 = _mm256_sub_ps(f[0], f[1]);
+	__m256 w2 = _mm256_sub_ps(f[1], f[2]);
+	__m256 w3 = f[2];
+
+	__m256 *out[3] = { &out0, &out1, &out2 };
+
+	for (unsigned c = 0; c < 3; ++c) {
 		__m256 x;
-		__m256i xi;
 
-		x = _mm256_load_ps(src + j);
-		xi = _mm256_cvtepu16_epi32(_mm256_cvtps_ph(x, 0));
-		x = _mm256_i32gather_ps(lut, xi, sizeof(float));
-		_mm256_store_ps(dst + j, x);
+		x = _mm256_mul_ps(w0, _mm256_i32gather_ps(data + c, idx, sizeof(float)));
+		x = _mm256_fmadd_ps(w1, _mm256_i32gather_ps(data + c, idx1, sizeof(float)), x);
+		x = _mm256_fmadd_ps(w2, _mm256_i32gather_ps(data + c, idx2, sizeof(float)), x);
+		x = _mm256_fmadd_ps(w3, _mm256_i32gather_ps(data + c, idx3, sizeof(float)), x);
+		*out[c] = x;
 	}
-	for (unsigned j = vec_right; j < right; ++j) {
-		__m128 x = _mm_load_ss(src + j);
-		int idx = _mm_extract_epi16(_mm_cvtps_ph(x, 0), 0);
-		dst[j] = lut[idx];
+}
+
+void lut3d_filter_line_avx2(const Lut3D &lut, const float * const *src, float * const *dst, unsigned left, unsigned right)
+{
+	const float *src0 = src[0];
+	const float *src1 = src[1];
+	const float *src2 = src[2];
+	float *dst0 = dst[0];
+	float *dst1 = dst[1];
+	float *dst2 = dst[2];
+
+	unsigned vec_left = ceil_n(left, 8);
+	unsigned vec_right = floor_n(right, 8);
+
+	__m256 out0, out1, out2;
+
+	if (left != vec_left) {
+		lut3d_filter_line_avx2_xiter(vec_left - 8, lut, src0, src1, src2, out0, out1, out2);
+
+		mm256_store_idxhi_ps(dst0 + vec_left - 8, out0, left % 8);
+		mm256_store_idxhi_ps(dst1 + vec_left - 8, out1, left % 8);
+		mm256_store_idxhi_ps(dst2 + vec_left - 8, out2, left % 8);
+	}
+
+	for (unsigned j = vec_left; j < vec_right; j += 8) {
+		lut3d_filter_line_avx2_xiter(j, lut, src0, src1, src2, out0, out1, out2);
+
+		_mm256_store_ps(dst0 + j, out0);
+		_mm256_store_ps(dst1 + j, out1);
+		_mm256_store_ps(dst2 + j, out2);
+	}
+
+	if (right != vec_right) {
+		lut3d_filter_line_avx2_xiter(vec_right, lut, src0, src1, src2, out0, out1, out2);
+
+		mm256_store_idxlo_ps(dst0 + vec_right, out0, right % 8);
+		mm256_store_idxlo_ps(dst1 + vec_right, out1, right % 8);
+		mm256_store_idxlo_ps(dst2 + vec_right, out2, right % 8);
 	}
 }
 
 
-class ToLinearLutOperationAVX2 final : public Operation {
+
+template <bool Inverse>
+class GammaLutOperationAVX2 final : public Operation {
 	std::vector<float> m_lut;
-	unsigned m_lut_depth;
 public:
-	ToLinearLutOperationAVX2(gamma_func func, unsigned lut_depth, float postscale) :
-		m_lut((1UL << lut_depth) + 1),
-		m_lut_depth{ lut_depth }
+	explicit GammaLutOperationAVX2(std::vector<float> lut) : m_lut(std::move(lut)) {}
+
+	void process(const float * const *src, float * const *dst, unsigned left, unsigned right) const override
 	{
-		EnsureSinglePrecision x87;
+		gamma_lut_filter_line<Inverse>(m_lut.data(), src[0], dst[0], left, right);
+		gamma_lut_filter_line<Inverse>(m_lut.data(), src[1], dst[1], left, right);
+		gamma_lut_filter_line<Inverse>(m_lut.data(), src[2], dst[2], left, right);
+	}
+};
 
-		// Allocate an extra LUT entry so that indexing can be done by multipying by a power of 2.
-		for (size_t i = 0; i < m_lut.size(); ++i) {
-			float x = static_cast<float>(i) / (1 << lut_depth) * 2.0f - 0.5f;
-			m_lut[i] = func(x) * postscale;
-		}
+template <bool Inverse>
+class AribB67OperationAVX2 final : public Operation {
+	float m_coeffs[4];
+public:
+	AribB67OperationAVX2(const Matrix3x3 &m, float scale) :
+		m_coeffs{ static_cast<float>(m[0][0]), static_cast<float>(m[0][1]), static_cast<float>(m[0][2]), scale }
+	{}
+
+	void process(const float * const *src, float * const *dst, unsigned left, unsigned right) const override
+	{
+		arib_b67_filter_line_avx2<Inverse>(m_coeffs, src, dst, left, right);
+	}
+};
+
+template <bool ToRGB>
+class CLOperationAVX2 final : public Operation {
+	float m_coeffs[9];
+public:
+	CLOperationAVX2(const Matrix3x3 &m, float scale) :
+		m_coeffs{ static_cast<float>(m[0][0]), static_cast<float>(m[0][1]), static_cast<float>(m[0][2]), 0.0f }
+	{
+		float kr = m_coeffs[0];
+		float kb = m_coeffs[2];
+
+		m_coeffs[4] = rec_709_oetf(1.0f - kb);
+		m_coeffs[5] = 1.0f - rec_709_oetf(kb);
+		m_coeffs[6] = rec_709_oetf(1.0f - kr);
+		m_coeffs[7] = 1.0f - rec_709_oetf(kr);
+		m_coeffs[8] = scale;
 	}
 
 	void process(const float * const *src, float * const *dst, unsigned left, unsigned right) const override
 	{
-		to_linear_lut_filter_line(m_lut.data(), m_lut_depth, src[0], dst[0], left, right);
-		to_linear_lut_filter_line(m_lut.data(), m_lut_depth, src[1], dst[1], left, right);
-		to_linear_lut_filter_line(m_lut.data(), m_lut_depth, src[2], dst[2], left, right);
+		cl_filter_line_avx2<ToRGB>(m_coeffs, src, dst, left, right);
 	}
 };
 
-class ToGammaLutOperationAVX2 final : public Operation {
+template <bool Inverse, bool Pre, bool Post>
+class FusedGammaOperationAVX2 final : public Operation {
 	std::vector<float> m_lut;
+	float m_pre[3][3];
+	float m_post[3][3];
 public:
-	ToGammaLutOperationAVX2(gamma_func func, float prescale) :
-		m_lut(static_cast<uint32_t>(UINT16_MAX) + 1)
+	FusedGammaOperationAVX2(const Matrix3x3 *pre, std::vector<float> lut, const Matrix3x3 *post) :
+		m_lut(std::move(lut)),
+		m_pre{},
+		m_post{}
 	{
-		EnsureSinglePrecision x87;
-
-		for (size_t i = 0; i <= UINT16_MAX; ++i) {
-			uint16_t half = static_cast<uint16_t>(i);
-			float x = _mm_cvtss_f32(_mm_cvtph_ps(_mm_set1_epi16(half)));
-			m_lut[i] = func(x * prescale);
+		for (unsigned i = 0; i < 3; ++i) {
+			for (unsigned j = 0; j < 3; ++j) {
+				m_pre[i][j] = Pre ? static_cast<float>((*pre)[i][j]) : 0.0f;
+				m_post[i][j] = Post ? static_cast<float>((*post)[i][j]) : 0.0f;
+			}
 		}
 	}
 
 	void process(const float * const *src, float * const *dst, unsigned left, unsigned right) const override
 	{
-		to_gamma_lut_filter_line(m_lut.data(), src[0], dst[0], left, right);
-		to_gamma_lut_filter_line(m_lut.data(), src[1], dst[1], left, right);
-		to_gamma_lut_filter_line(m_lut.data(), src[2], dst[2], left, right);
+		fused_gamma_filter_line_avx2<Inverse, Pre, Post>(m_lut.data(), &m_pre[0][0], &m_post[0][0], src, dst, left, right);
+	}
+};
+
+template <bool Inverse>
+std::unique_ptr<Operation> create_fused_gamma_operation_avx2_impl(const Matrix3x3 *pre, std::vector<float> lut, const Matrix3x3 *post)
+{
+	if (pre && post)
+		return ztd::make_unique<FusedGammaOperationAVX2<Inverse, true, true>>(pre, std::move(lut), post);
+	else if (pre)
+		return ztd::make_unique<FusedGammaOperationAVX2<Inverse, true, false>>(pre, std::move(lut), post);
+	else if (post)
+		return ztd::make_unique<FusedGammaOperationAVX2<Inverse, false, true>>(pre, std::move(lut), post);
+	else
+		return nullptr;
+}
+
+template <ToneMapping Method>
+class ToneMapOperationAVX2 final : public Operation {
+	ToneMapCurve m_curve;
+public:
+	explicit ToneMapOperationAVX2(const ToneMapCurve &curve) : m_curve(curve) {}
+
+	void process(const float * const *src, float * const *dst, unsigned left, unsigned right) const override
+	{
+		tone_map_filter_line_avx2<Method>(m_curve, src, dst, left, right);
+	}
+};
+
+class Lut3DOperationAVX2 final : public Operation {
+	Lut3D m_lut;
+public:
+	explicit Lut3DOperationAVX2(const Lut3D &lut) : m_lut(lut) {}
+
+	void process(const float * const *src, float * const *dst, unsigned left, unsigned right) const override
+	{
+		lut3d_filter_line_avx2(m_lut, src, dst, left, right);
 	}
 };
 
@@ -137,7 +873,7 @@ std::unique_ptr<Operation> create_gamma_operation_avx2(const TransferFunction &t
 	if (!params.approximate_gamma)
 		return nullptr;
 
-	return ztd::make_unique<ToGammaLutOperationAVX2>(transfer.to_gamma, transfer.to_gamma_scale);
+	return ztd::make_unique<GammaLutOperationAVX2<false>>(make_to_gamma_lut(transfer));
 }
 
 std::unique_ptr<Operation> create_inverse_gamma_operation_avx2(const TransferFunction &transfer, const OperationParams &params)
@@ -145,7 +881,114 @@ std::unique_ptr<Operation> create_inverse_gamma_operation_avx2(const TransferFun
 	if (!params.approximate_gamma)
 		return nullptr;
 
-	return ztd::make_unique<ToLinearLutOperationAVX2>(transfer.to_linear, LUT_DEPTH, transfer.to_linear_scale);
+	return ztd::make_unique<GammaLutOperationAVX2<true>>(make_to_linear_lut(transfer));
+}
+
+std::unique_ptr<Operation> create_fused_gamma_operation_avx2(const Matrix3x3 *pre, const TransferFunction &transfer, const Matrix3x3 *post, const OperationParams &params)
+{
+	if (!params.approximate_gamma)
+		return nullptr;
+
+	return create_fused_gamma_operation_avx2_impl<false>(pre, make_to_gamma_lut(transfer), post);
+}
+
+std::unique_ptr<Operation> create_fused_inverse_gamma_operation_avx2(const Matrix3x3 *pre, const TransferFunction &transfer, const Matrix3x3 *post, const OperationParams &params)
+{
+	if (!params.approximate_gamma)
+		return nullptr;
+
+	return create_fused_gamma_operation_avx2_impl<true>(pre, make_to_linear_lut(transfer), post);
+}
+
+std::unique_ptr<Operation> create_arib_b67_operation_avx2(const Matrix3x3 &m, const OperationParams &params)
+{
+	TransferFunction func = select_transfer_function(TransferCharacteristics::ARIB_B67, params.peak_luminance, false);
+	return ztd::make_unique<AribB67OperationAVX2<false>>(m, func.to_gamma_scale);
+}
+
+std::unique_ptr<Operation> create_inverse_arib_b67_operation_avx2(const Matrix3x3 &m, const OperationParams &params)
+{
+	TransferFunction func = select_transfer_function(TransferCharacteristics::ARIB_B67, params.peak_luminance, false);
+	return ztd::make_unique<AribB67OperationAVX2<true>>(m, func.to_linear_scale);
+}
+
+std::unique_ptr<Operation> create_cl_yuv_to_rgb_operation_avx2(const Matrix3x3 &m, const OperationParams &params)
+{
+	TransferFunction func = select_transfer_function(TransferCharacteristics::REC_709, params.peak_luminance, true);
+	return ztd::make_unique<CLOperationAVX2<true>>(m, func.to_linear_scale);
+}
+
+std::unique_ptr<Operation> create_cl_rgb_to_yuv_operation_avx2(const Matrix3x3 &m, const OperationParams &params)
+{
+	TransferFunction func = select_transfer_function(TransferCharacteristics::REC_709, params.peak_luminance, true);
+	return ztd::make_unique<CLOperationAVX2<false>>(m, func.to_gamma_scale);
+}
+
+std::unique_ptr<Operation> create_tone_map_operation_avx2(const ToneMapCurve &curve)
+{
+	switch (curve.method) {
+	case ToneMapping::BT2390:
+		return ztd::make_unique<ToneMapOperationAVX2<ToneMapping::BT2390>>(curve);
+	case ToneMapping::HABLE:
+		return ztd::make_unique<ToneMapOperationAVX2<ToneMapping::HABLE>>(curve);
+	case ToneMapping::REINHARD:
+		return ztd::make_unique<ToneMapOperationAVX2<ToneMapping::REINHARD>>(curve);
+	default:
+		return nullptr;
+	}
+}
+
+std::unique_ptr<Operation> create_lut3d_operation_avx2(const Lut3D &lut)
+{
+	return ztd::make_unique<Lut3DOperationAVX2>(lut);
+}
+
+void half_to_float_avx2(const void *src, void *dst, unsigned left, unsigned right)
+{
+	const uint16_t *src_p = static_cast<const uint16_t *>(src);
+	float *dst_p = static_cast<float *>(dst);
+
+	unsigned vec_left = ceil_n(left, 8);
+	unsigned vec_right = floor_n(right, 8);
+
+	if (left != vec_left) {
+		__m256 x = _mm256_cvtph_ps(_mm_load_si128((const __m128i *)(src_p + vec_left - 8)));
+		mm256_store_idxhi_ps(dst_p + vec_left - 8, x, left % 8);
+	}
+
+	for (unsigned j = vec_left; j < vec_right; j += 8) {
+		__m256 x = _mm256_cvtph_ps(_mm_load_si128((const __m128i *)(src_p + j)));
+		_mm256_store_ps(dst_p + j, x);
+	}
+
+	if (right != vec_right) {
+		__m256 x = _mm256_cvtph_ps(_mm_load_si128((const __m128i *)(src_p + vec_right)));
+		mm256_store_idxlo_ps(dst_p + vec_right, x, right % 8);
+	}
+}
+
+void float_to_half_avx2(const void *src, void *dst, unsigned left, unsigned right)
+{
+	const float *src_p = static_cast<const float *>(src);
+	uint16_t *dst_p = static_cast<uint16_t *>(dst);
+
+	unsigned vec_left = ceil_n(left, 8);
+	unsigned vec_right = floor_n(right, 8);
+
+	if (left != vec_left) {
+		__m128i x = _mm256_cvtps_ph(_mm256_load_ps(src_p + vec_left - 8), 0);
+		mm_store_idxhi_epi16((__m128i *)(dst_p + vec_left - 8), x, left % 8);
+	}
+
+	for (unsigned j = vec_left; j < vec_right; j += 8) {
+		__m128i x = _mm256_cvtps_ph(_mm256_load_ps(src_p + j), 0);
+		_mm_store_si128((__m128i *)(dst_p + j), x);
+	}
+
+	if (right != vec_right) {
+		__m128i x = _mm256_cvtps_ph(_mm256_load_ps(src_p + vec_right), 0);
+		mm_store_idxlo_epi16((__m128i *)(dst_p + vec_right), x, right % 8);
+	}
 }
 
 } // namespace colorspace
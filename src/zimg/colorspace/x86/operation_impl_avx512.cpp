@@ -1,12 +1,17 @@
 #ifdef ZIMG_X86_AVX512
 
 #include <cfloat>
+#include <cstdint>
 #include <immintrin.h>
 #include "common/align.h"
 #include "common/ccdep.h"
 #include "common/make_unique.h"
+#include "colorspace/colorspace.h"
 #include "colorspace/gamma.h"
+#include "colorspace/gamma_constants.h"
+#include "colorspace/matrix3.h"
 #include "colorspace/operation_impl.h"
+#include "colorspace/tonemap.h"
 #include "gamma_constants_avx512.h"
 #include "operation_impl_x86.h"
 
@@ -286,6 +291,672 @@ void gamma_filter_line_avx512(const float *src, float *dst, float scale, unsigne
 	}
 }
 
+inline FORCE_INLINE void matrix_avx512(const float *m, __m512 &a, __m512 &b, __m512 &c)
+{
+	__m512 x, y, z;
+
+	// Same evaluation order as the matrix operation.
+	x = _mm512_mul_ps(_mm512_set1_ps(m[0]), a);
+	x = _mm512_fmadd_ps(_mm512_set1_ps(m[1]), b, x);
+	x = _mm512_fmadd_ps(_mm512_set1_ps(m[2]), c, x);
+
+	y = _mm512_mul_ps(_mm512_set1_ps(m[3]), a);
+	y = _mm512_fmadd_ps(_mm512_set1_ps(m[4]), b, y);
+	y = _mm512_fmadd_ps(_mm512_set1_ps(m[5]), c, y);
+
+	z = _mm512_mul_ps(_mm512_set1_ps(m[6]), a);
+	z = _mm512_fmadd_ps(_mm512_set1_ps(m[7]), b, z);
+	z = _mm512_fmadd_ps(_mm512_set1_ps(m[8]), c, z);
+
+	a = x;
+	b = y;
+	c = z;
+}
+
+template <class Op, bool Pre, bool Post>
+inline FORCE_INLINE void fused_gamma_filter_line_avx512_xiter(unsigned j, const float *src0, const float *src1, const float *src2,
+                                                              const float *pre, const float *post, const __m512 &scale,
+                                                              __m512 &out0, __m512 &out1, __m512 &out2)
+{
+	__m512 a = _mm512_load_ps(src0 + j);
+	__m512 b = _mm512_load_ps(src1 + j);
+	__m512 c = _mm512_load_ps(src2 + j);
+
+	if (Pre)
+		matrix_avx512(pre, a, b, c);
+
+	a = Op::func(a, scale);
+	b = Op::func(b, scale);
+	c = Op::func(c, scale);
+
+	if (Post)
+		matrix_avx512(post, a, b, c);
+
+	out0 = a;
+	out1 = b;
+	out2 = c;
+}
+
+template <class Op, bool Pre, bool Post>
+void fused_gamma_filter_line_avx512(const float *pre, const float *post, float scale, const float * const * RESTRICT src, float * const * RESTRICT dst, unsigned left, unsigned right)
+{
+	const float *src0 = src[0];
+	const float *src1 = src[1];
+	const float *src2 = src[2];
+	float *dst0 = dst[0];
+	float *dst1 = dst[1];
+	float *dst2 = dst[2];
+
+	const __m512 scale_ps = _mm512_set1_ps(scale);
+	__m512 out0, out1, out2;
+
+	unsigned vec_left = ceil_n(left, 16);
+	unsigned vec_right = floor_n(right, 16);
+
+#define XITER fused_gamma_filter_line_avx512_xiter<Op, Pre, Post>
+#define XARGS src0, src1, src2, pre, post, scale_ps, out0, out1, out2
+	if (left != vec_left) {
+		XITER(vec_left - 16, XARGS);
+		__mmask16 mask = mmask16_set_hi(vec_left - left);
+
+		_mm512_mask_store_ps(dst0 + vec_left - 16, mask, out0);
+		_mm512_mask_store_ps(dst1 + vec_left - 16, mask, out1);
+		_mm512_mask_store_ps(dst2 + vec_left - 16, mask, out2);
+	}
+
+	for (unsigned j = vec_left; j < vec_right; j += 16) {
+		XITER(j, XARGS);
+
+		_mm512_store_ps(dst0 + j, out0);
+		_mm512_store_ps(dst1 + j, out1);
+		_mm512_store_ps(dst2 + j, out2);
+	}
+
+	if (right != vec_right) {
+		XITER(vec_right, XARGS);
+		__mmask16 mask = mmask16_set_lo(right - vec_right);
+
+		_mm512_mask_store_ps(dst0 + vec_right, mask, out0);
+		_mm512_mask_store_ps(dst1 + vec_right, mask, out1);
+		_mm512_mask_store_ps(dst2 + vec_right, mask, out2);
+	}
+#undef XITER
+#undef XARGS
+}
+
+// log2(x) for positive normal x.
+inline FORCE_INLINE __m512 log2_ps_avx512(__m512 x)
+{
+	__m512 mant, exp, t, p;
+	__mmask16 mask;
+
+	// Decompose into mantissa on [sqrt(0.5), sqrt(2)) and exponent.
+	mant = _mm512_getmant_ps(x, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_zero);
+	exp = _mm512_getexp_ps(x);
+	mask = _mm512_cmp_ps_mask(mant, _mm512_set1_ps(1.41421356f), _CMP_GE_OQ);
+	mant = _mm512_mask_mul_ps(mant, mask, mant, _mm512_set1_ps(0.5f));
+	exp = _mm512_mask_add_ps(exp, mask, exp, _mm512_set1_ps(1.0f));
+
+	t = _mm512_sub_ps(mant, _mm512_set1_ps(1.0f));
+	p = _mm512_set1_ps(constants::LOG2_HORNER[0]);
+	p = _mm512_fmadd_ps(p, t, _mm512_set1_ps(constants::LOG2_HORNER[1]));
+	p = _mm512_fmadd_ps(p, t, _mm512_set1_ps(constants::LOG2_HORNER[2]));
+	p = _mm512_fmadd_ps(p, t, _mm512_set1_ps(constants::LOG2_HORNER[3]));
+	p = _mm512_fmadd_ps(p, t, _mm512_set1_ps(constants::LOG2_HORNER[4]));
+	p = _mm512_fmadd_ps(p, t, _mm512_set1_ps(constants::LOG2_HORNER[5]));
+	p = _mm512_fmadd_ps(p, t, _mm512_set1_ps(constants::LOG2_HORNER[6]));
+	p = _mm512_fmadd_ps(p, t, _mm512_set1_ps(constants::LOG2_HORNER[7]));
+
+	return _mm512_fmadd_ps(p, t, exp);
+}
+
+inline FORCE_INLINE __m512 exp2_ps_avx512(__m512 x)
+{
+	__m512 n, f, p;
+
+	// Split into integer and fractional part on [-0.5, 0.5].
+	n = _mm512_roundscale_ps(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+	f = _mm512_sub_ps(x, n);
+
+	p = _mm512_set1_ps(constants::EXP2_HORNER[0]);
+	p = _mm512_fmadd_ps(p, f, _mm512_set1_ps(constants::EXP2_HORNER[1]));
+	p = _mm512_fmadd_ps(p, f, _mm512_set1_ps(constants::EXP2_HORNER[2]));
+	p = _mm512_fmadd_ps(p, f, _mm512_set1_ps(constants::EXP2_HORNER[3]));
+	p = _mm512_fmadd_ps(p, f, _mm512_set1_ps(constants::EXP2_HORNER[4]));
+	p = _mm512_fmadd_ps(p, f, _mm512_set1_ps(constants::EXP2_HORNER[5]));
+	p = _mm512_fmadd_ps(p, f, _mm512_set1_ps(constants::EXP2_HORNER[6]));
+
+	return _mm512_scalef_ps(p, n);
+}
+
+inline FORCE_INLINE __m512 arib_b67_oetf_avx512(__m512 x)
+{
+	__m512 lo, hi;
+	__mmask16 mask;
+
+	// Also removes NaN.
+	x = _mm512_max_ps(x, _mm512_setzero_ps());
+	mask = _mm512_cmp_ps_mask(x, _mm512_set1_ps(1.0f / 12.0f), _CMP_LE_OQ);
+
+	// sqrt(3 * x)
+	lo = _mm512_sqrt_ps(_mm512_mul_ps(x, _mm512_set1_ps(3.0f)));
+
+	// a * ln(12 * x - b) + c
+	hi = _mm512_fmsub_ps(x, _mm512_set1_ps(12.0f), _mm512_set1_ps(constants::ARIB_B67_B));
+	hi = log2_ps_avx512(hi);
+	hi = _mm512_fmadd_ps(hi, _mm512_set1_ps(constants::ARIB_B67_A * 0.693147181f), _mm512_set1_ps(constants::ARIB_B67_C));
+
+	return _mm512_mask_blend_ps(mask, hi, lo);
+}
+
+inline FORCE_INLINE __m512 arib_b67_inverse_oetf_avx512(__m512 x)
+{
+	__m512 lo, hi;
+	__mmask16 mask;
+
+	x = _mm512_max_ps(x, _mm512_setzero_ps());
+	mask = _mm512_cmp_ps_mask(x, _mm512_set1_ps(0.5f), _CMP_LE_OQ);
+
+	// x^2 / 3
+	lo = _mm512_mul_ps(_mm512_mul_ps(x, x), _mm512_set1_ps(1.0f / 3.0f));
+
+	// (exp((x - c) / a) + b) / 12
+	hi = _mm512_fmadd_ps(x, _mm512_set1_ps(1.442695041f / constants::ARIB_B67_A), _mm512_set1_ps(-1.442695041f * constants::ARIB_B67_C / constants::ARIB_B67_A));
+	hi = exp2_ps_avx512(hi);
+	hi = _mm512_mul_ps(_mm512_add_ps(hi, _mm512_set1_ps(constants::ARIB_B67_B)), _mm512_set1_ps(1.0f / 12.0f));
+
+	return _mm512_mask_blend_ps(mask, hi, lo);
+}
+
+template <bool Inverse>
+inline FORCE_INLINE void arib_b67_filter_line_avx512_xiter(unsigned j, const float *src0, const float *src1, const float *src2,
+                                                           const __m512 &kr, const __m512 &kg, const __m512 &kb, const __m512 &scale,
+                                                           __m512 &out0, __m512 &out1, __m512 &out2)
+{
+	__m512 r = _mm512_load_ps(src0 + j);
+	__m512 g = _mm512_load_ps(src1 + j);
+	__m512 b = _mm512_load_ps(src2 + j);
+	__m512 y;
+
+	if (Inverse) {
+		r = arib_b67_inverse_oetf_avx512(r);
+		g = arib_b67_inverse_oetf_avx512(g);
+		b = arib_b67_inverse_oetf_avx512(b);
+
+		// ys^(gamma - 1)
+		y = _mm512_mul_ps(kr, r);
+		y = _mm512_fmadd_ps(kg, g, y);
+		y = _mm512_fmadd_ps(kb, b, y);
+		y = _mm512_max_ps(y, _mm512_set1_ps(FLT_MIN));
+		y = exp2_ps_avx512(_mm512_mul_ps(log2_ps_avx512(y), _mm512_set1_ps(0.2f)));
+		y = _mm512_mul_ps(y, scale);
+
+		out0 = _mm512_mul_ps(r, y);
+		out1 = _mm512_mul_ps(g, y);
+		out2 = _mm512_mul_ps(b, y);
+	} else {
+		r = _mm512_mul_ps(r, scale);
+		g = _mm512_mul_ps(g, scale);
+		b = _mm512_mul_ps(b, scale);
+
+		// yd^((1 - gamma) / gamma)
+		y = _mm512_mul_ps(kr, r);
+		y = _mm512_fmadd_ps(kg, g, y);
+		y = _mm512_fmadd_ps(kb, b, y);
+		y = _mm512_max_ps(y, _mm512_set1_ps(FLT_MIN));
+		y = exp2_ps_avx512(_mm512_mul_ps(log2_ps_avx512(y), _mm512_set1_ps(-0.2f / 1.2f)));
+
+		out0 = arib_b67_oetf_avx512(_mm512_mul_ps(r, y));
+		out1 = arib_b67_oetf_avx512(_mm512_mul_ps(g, y));
+		out2 = arib_b67_oetf_avx512(_mm512_mul_ps(b, y));
+	}
+}
+
+template <bool Inverse>
+void arib_b67_filter_line_avx512(const float *coeffs, const float * const * RESTRICT src, float * const * RESTRICT dst, unsigned left, unsigned right)
+{
+	const float *src0 = src[0];
+	const float *src1 = src[1];
+	const float *src2 = src[2];
+	float *dst0 = dst[0];
+	float *dst1 = dst[1];
+	float *dst2 = dst[2];
+
+	const __m512 kr = _mm512_set1_ps(coeffs[0]);
+	const __m512 kg = _mm512_set1_ps(coeffs[1]);
+	const __m512 kb = _mm512_set1_ps(coeffs[2]);
+	const __m512 scale = _mm512_set1_ps(coeffs[3]);
+	__m512 out0, out1, out2;
+
+	unsigned vec_left = ceil_n(left, 16);
+	unsigned vec_right = floor_n(right, 16);
+
+#define XITER arib_b67_filter_line_avx512_xiter<Inverse>
+#define XARGS src0, src1, src2, kr, kg, kb, scale, out0, out1, out2
+	if (left != vec_left) {
+		XITER(vec_left - 16, XARGS);
+		__mmask16 mask = mmask16_set_hi(vec_left - left);
+
+		_mm512_mask_store_ps(dst0 + vec_left - 16, mask, out0);
+		_mm512_mask_store_ps(dst1 + vec_left - 16, mask, out1);
+		_mm512_mask_store_ps(dst2 + vec_left - 16, mask, out2);
+	}
+
+	for (unsigned j = vec_left; j < vec_right; j += 16) {
+		XITER(j, XARGS);
+
+		_mm512_store_ps(dst0 + j, out0);
+		_mm512_store_ps(dst1 + j, out1);
+		_mm512_store_ps(dst2 + j, out2);
+	}
+
+	if (right != vec_right) {
+		XITER(vec_right, XARGS);
+		__mmask16 mask = mmask16_set_lo(right - vec_right);
+
+		_mm512_mask_store_ps(dst0 + vec_right, mask, out0);
+		_mm512_mask_store_ps(dst1 + vec_right, mask, out1);
+		_mm512_mask_store_ps(dst2 + vec_right, mask, out2);
+	}
+#undef XITER
+#undef XARGS
+}
+
+inline FORCE_INLINE __m512 rec_709_oetf_avx512(__m512 x)
+{
+	__m512 lo, hi;
+	__mmask16 mask;
+
+	// Also removes NaN.
+	x = _mm512_max_ps(x, _mm512_setzero_ps());
+	mask = _mm512_cmp_ps_mask(x, _mm512_set1_ps(constants::REC709_BETA), _CMP_LT_OQ);
+
+	lo = _mm512_mul_ps(x, _mm512_set1_ps(4.5f));
+
+	// alpha * x^0.45 - (alpha - 1)
+	hi = exp2_ps_avx512(_mm512_mul_ps(log2_ps_avx512(x), _mm512_set1_ps(0.45f)));
+	hi = _mm512_fmsub_ps(hi, _mm512_set1_ps(constants::REC709_ALPHA), _mm512_set1_ps(constants::REC709_ALPHA - 1.0f));
+
+	return _mm512_mask_blend_ps(mask, hi, lo);
+}
+
+inline FORCE_INLINE __m512 rec_709_inverse_oetf_avx512(__m512 x)
+{
+	__m512 lo, hi;
+	__mmask16 mask;
+
+	x = _mm512_max_ps(x, _mm512_setzero_ps());
+	mask = _mm512_cmp_ps_mask(x, _mm512_set1_ps(4.5f * constants::REC709_BETA), _CMP_LT_OQ);
+
+	lo = _mm512_mul_ps(x, _mm512_set1_ps(1.0f / 4.5f));
+
+	// ((x + (alpha - 1)) / alpha)^(1 / 0.45)
+	hi = _mm512_div_ps(_mm512_add_ps(x, _mm512_set1_ps(constants::REC709_ALPHA - 1.0f)), _mm512_set1_ps(constants::REC709_ALPHA));
+	hi = exp2_ps_avx512(_mm512_mul_ps(log2_ps_avx512(hi), _mm512_set1_ps(1.0f / 0.45f)));
+
+	return _mm512_mask_blend_ps(mask, hi, lo);
+}
+
+inline FORCE_INLINE void cl_to_rgb_filter_line_avx512_xiter(unsigned j, const float *src0, const float *src1, const float *src2, const float *coeffs,
+                                                            __m512 &out0, __m512 &out1, __m512 &out2)
+{
+	const __m512 zero = _mm512_setzero_ps();
+
+	__m512 y = _mm512_load_ps(src0 + j);
+	__m512 u = _mm512_load_ps(src1 + j);
+	__m512 v = _mm512_load_ps(src2 + j);
+	__m512 r, g, b, kb, kr;
+
+	// Select the chroma scale by the sign of the difference.
+	kb = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(u, zero, _CMP_LT_OQ), _mm512_set1_ps(coeffs[5]), _mm512_set1_ps(coeffs[4]));
+	kr = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(v, zero, _CMP_LT_OQ), _mm512_set1_ps(coeffs[7]), _mm512_set1_ps(coeffs[6]));
+
+	b = rec_709_inverse_oetf_avx512(_mm512_fmadd_ps(_mm512_add_ps(u, u), kb, y));
+	r = rec_709_inverse_oetf_avx512(_mm512_fmadd_ps(_mm512_add_ps(v, v), kr, y));
+	y = rec_709_inverse_oetf_avx512(y);
+
+	g = _mm512_fnmadd_ps(_mm512_set1_ps(coeffs[0]), r, y);
+	g = _mm512_fnmadd_ps(_mm512_set1_ps(coeffs[2]), b, g);
+	g = _mm512_div_ps(g, _mm512_set1_ps(coeffs[1]));
+
+	out0 = _mm512_mul_ps(r, _mm512_set1_ps(coeffs[8]));
+	out1 = _mm512_mul_ps(g, _mm512_set1_ps(coeffs[8]));
+	out2 = _mm512_mul_ps(b, _mm512_set1_ps(coeffs[8]));
+}
+
+inline FORCE_INLINE void cl_to_yuv_filter_line_avx512_xiter(unsigned j, const float *src0, const float *src1, const float *src2, const float *coeffs,
+                                                            __m512 &out0, __m512 &out1, __m512 &out2)
+{
+	const __m512 zero = _mm512_setzero_ps();
+
+	__m512 r = _mm512_mul_ps(_mm512_load_ps(src0 + j), _mm512_set1_ps(coeffs[8]));
+	__m512 g = _mm512_mul_ps(_mm512_load_ps(src1 + j), _mm512_set1_ps(coeffs[8]));
+	__m512 b = _mm512_mul_ps(_mm512_load_ps(src2 + j), _mm512_set1_ps(coeffs[8]));
+	__m512 y, kb, kr;
+
+	y = _mm512_mul_ps(_mm512_set1_ps(coeffs[0]), r);
+	y = _mm512_fmadd_ps(_mm512_set1_ps(coeffs[1]), g, y);
+	y = _mm512_fmadd_ps(_mm512_set1_ps(coeffs[2]), b, y);
+	y = rec_709_oetf_avx512(y);
+
+	b = _mm512_sub_ps(rec_709_oetf_avx512(b), y);
+	r = _mm512_sub_ps(rec_709_oetf_avx512(r), y);
+
+	// Select the chroma scale by the sign of the difference.
+	kb = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(b, zero, _CMP_LT_OQ), _mm512_set1_ps(coeffs[5]), _mm512_set1_ps(coeffs[4]));
+	kr = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(r, zero, _CMP_LT_OQ), _mm512_set1_ps(coeffs[7]), _mm512_set1_ps(coeffs[6]));
+
+	out0 = y;
+	out1 = _mm512_div_ps(b, _mm512_add_ps(kb, kb));
+	out2 = _mm512_div_ps(r, _mm512_add_ps(kr, kr));
+}
+
+template <bool ToRGB>
+void cl_filter_line_avx512(const float *coeffs, const float * const * RESTRICT src, float * const * RESTRICT dst, unsigned left, unsigned right)
+{
+	const float *src0 = src[0];
+	const float *src1 = src[1];
+	const float *src2 = src[2];
+	float *dst0 = dst[0];
+	float *dst1 = dst[1];
+	float *dst2 = dst[2];
+	__m512 out0, out1, out2;
+
+	unsigned vec_left = ceil_n(left, 16);
+	unsigned vec_right = floor_n(right, 16);
+
+#define XITER (ToRGB ? cl_to_rgb_filter_line_avx512_xiter : cl_to_yuv_filter_line_avx512_xiter)
+#define XARGS src0, src1, src2, coeffs, out0, out1, out2
+	if (left != vec_left) {
+		XITER(vec_left - 16, XARGS);
+		__mmask16 mask = mmask16_set_hi(vec_left - left);
+
+		_mm512_mask_store_ps(dst0 + vec_left - 16, mask, out0);
+		_mm512_mask_store_ps(dst1 + vec_left - 16, mask, out1);
+		_mm512_mask_store_ps(dst2 + vec_left - 16, mask, out2);
+	}
+
+	for (unsigned j = vec_left; j < vec_right; j += 16) {
+		XITER(j, XARGS);
+
+		_mm512_store_ps(dst0 + j, out0);
+		_mm512_store_ps(dst1 + j, out1);
+		_mm512_store_ps(dst2 + j, out2);
+	}
+
+	if (right != vec_right) {
+		XITER(vec_right, XARGS);
+		__mmask16 mask = mmask16_set_lo(right - vec_right);
+
+		_mm512_mask_store_ps(dst0 + vec_right, mask, out0);
+		_mm512_mask_store_ps(dst1 + vec_right, mask, out1);
+		_mm512_mask_store_ps(dst2 + vec_right, mask, out2);
+	}
+#undef XITER
+#undef XARGS
+}
+
+inline FORCE_INLINE __m512 st_2084_eotf_avx512(__m512 x)
+{
+	__m512 xpow, num, den;
+
+	// Input must be positive.
+	xpow = exp2_ps_avx512(_mm512_mul_ps(log2_ps_avx512(x), _mm512_set1_ps(1.0f / constants::ST2084_M2)));
+	num = _mm512_max_ps(_mm512_sub_ps(xpow, _mm512_set1_ps(constants::ST2084_C1)), _mm512_set1_ps(FLT_MIN));
+	den = _mm512_max_ps(_mm512_fnmadd_ps(xpow, _mm512_set1_ps(constants::ST2084_C3), _mm512_set1_ps(constants::ST2084_C2)), _mm512_set1_ps(FLT_MIN));
+	return exp2_ps_avx512(_mm512_mul_ps(log2_ps_avx512(_mm512_div_ps(num, den)), _mm512_set1_ps(1.0f / constants::ST2084_M1)));
+}
+
+inline FORCE_INLINE __m512 st_2084_inverse_eotf_avx512(__m512 x)
+{
+	__m512 xpow, num, den;
+
+	// Input must be positive.
+	xpow = exp2_ps_avx512(_mm512_mul_ps(log2_ps_avx512(x), _mm512_set1_ps(constants::ST2084_M1)));
+	num = _mm512_fmadd_ps(xpow, _mm512_set1_ps(constants::ST2084_C2 - constants::ST2084_C3), _mm512_set1_ps(constants::ST2084_C1 - 1.0f));
+	den = _mm512_fmadd_ps(xpow, _mm512_set1_ps(constants::ST2084_C3), _mm512_set1_ps(1.0f));
+	return exp2_ps_avx512(_mm512_mul_ps(log2_ps_avx512(_mm512_add_ps(_mm512_div_ps(num, den), _mm512_set1_ps(1.0f))), _mm512_set1_ps(constants::ST2084_M2)));
+}
+
+inline FORCE_INLINE __m512 bt2390_gain_avx512(const ToneMapCurve &curve, __m512 x)
+{
+	const __m512 one = _mm512_set1_ps(1.0f);
+	const __m512 knee = _mm512_set1_ps(curve.knee);
+	__m512 e1, e2, t, t2, t3, p0, p1, p2;
+	__mmask16 mask;
+
+	// Most pixels are below the knee, where the curve is the identity.
+	mask = _mm512_cmp_ps_mask(x, _mm512_set1_ps(curve.knee_lin), _CMP_LT_OQ);
+	if (mask == 0xFFFF)
+		return one;
+
+	e1 = _mm512_div_ps(st_2084_inverse_eotf_avx512(_mm512_mul_ps(x, _mm512_set1_ps(curve.pq_scale))), _mm512_set1_ps(curve.pq_peak));
+	t = _mm512_div_ps(_mm512_max_ps(_mm512_sub_ps(e1, knee), _mm512_setzero_ps()), _mm512_sub_ps(one, knee));
+	t2 = _mm512_mul_ps(t, t);
+	t3 = _mm512_mul_ps(t2, t);
+
+	// Hermite basis functions.
+	p0 = _mm512_fmadd_ps(_mm512_set1_ps(2.0f), t3, _mm512_fnmadd_ps(_mm512_set1_ps(3.0f), t2, one));
+	p1 = _mm512_add_ps(_mm512_fnmadd_ps(_mm512_set1_ps(2.0f), t2, t3), t);
+	p2 = _mm512_fmsub_ps(_mm512_set1_ps(3.0f), t2, _mm512_add_ps(t3, t3));
+
+	e2 = _mm512_mul_ps(p0, knee);
+	e2 = _mm512_fmadd_ps(p1, _mm512_sub_ps(one, knee), e2);
+	e2 = _mm512_fmadd_ps(p2, _mm512_set1_ps(curve.max_lum), e2);
+
+	e2 = st_2084_eotf_avx512(_mm512_mul_ps(e2, _mm512_set1_ps(curve.pq_peak)));
+	e2 = _mm512_div_ps(e2, _mm512_mul_ps(_mm512_set1_ps(curve.pq_scale), x));
+
+	return _mm512_mask_blend_ps(mask, e2, one);
+}
+
+inline FORCE_INLINE __m512 hable_gain_avx512(const ToneMapCurve &curve, __m512 x)
+{
+	using namespace constants;
+	__m512 num, den;
+
+	num = _mm512_fmadd_ps(x, _mm512_set1_ps((HABLE_F - HABLE_E) * HABLE_A), _mm512_set1_ps((HABLE_F * HABLE_C - HABLE_E) * HABLE_B));
+	den = _mm512_fmadd_ps(x, _mm512_set1_ps(HABLE_A), _mm512_set1_ps(HABLE_B));
+	den = _mm512_fmadd_ps(x, den, _mm512_set1_ps(HABLE_D * HABLE_F));
+	den = _mm512_mul_ps(den, _mm512_set1_ps(HABLE_F));
+
+	return _mm512_mul_ps(_mm512_div_ps(num, den), _mm512_set1_ps(curve.norm));
+}
+
+inline FORCE_INLINE __m512 reinhard_gain_avx512(const ToneMapCurve &curve, __m512 x)
+{
+	const __m512 one = _mm512_set1_ps(1.0f);
+	return _mm512_div_ps(_mm512_fmadd_ps(x, _mm512_set1_ps(curve.norm), one), _mm512_add_ps(x, one));
+}
+
+template <ToneMapping Method>
+inline FORCE_INLINE void tone_map_filter_line_avx512_xiter(unsigned j, const float *src0, const float *src1, const float *src2, const ToneMapCurve &curve,
+                                                           __m512 &out0, __m512 &out1, __m512 &out2)
+{
+	__m512 r = _mm512_load_ps(src0 + j);
+	__m512 g = _mm512_load_ps(src1 + j);
+	__m512 b = _mm512_load_ps(src2 + j);
+	__m512 x, gain;
+	__mmask16 mask;
+
+	// Also removes NaN and non-positive values.
+	x = _mm512_max_ps(_mm512_max_ps(r, g), b);
+	x = _mm512_max_ps(x, _mm512_set1_ps(FLT_MIN));
+
+	if (Method == ToneMapping::BT2390)
+		gain = bt2390_gain_avx512(curve, x);
+	else if (Method == ToneMapping::HABLE)
+		gain = hable_gain_avx512(curve, x);
+	else
+		gain = reinhard_gain_avx512(curve, x);
+
+	// Clip above the source peak.
+	mask = _mm512_cmp_ps_mask(x, _mm512_set1_ps(curve.peak), _CMP_GE_OQ);
+	gain = _mm512_mask_div_ps(gain, mask, _mm512_set1_ps(1.0f), x);
+
+	out0 = _mm512_mul_ps(r, gain);
+	out1 = _mm512_mul_ps(g, gain);
+	out2 = _mm512_mul_ps(b, gain);
+}
+
+template <ToneMapping Method>
+void tone_map_filter_line_avx512(const ToneMapCurve &curve, const float * const * RESTRICT src, float * const * RESTRICT dst, unsigned left, unsigned right)
+{
+	const float *src0 = src[0];
+	const float *src1 = src[1];
+	const float *src2 = src[2];
+	float *dst0 = dst[0];
+	float *dst1 = dst[1];
+	float *dst2 = dst[2];
+	__m512 out0, out1, out2;
+
+	unsigned vec_left = ceil_n(left, 16);
+	unsigned vec_right = floor_n(right, 16);
+
+#define XITER tone_map_filter_line_avx512_xiter<Method>
+#define XARGS src0, src1, src2, curve, out0, out1, out2
+	if (left != vec_left) {
+		XITER(vec_left - 16, XARGS);
+		__mmask16 mask = mmask16_set_hi(vec_left - left);
+
+		_mm512_mask_store_ps(dst0 + vec_left - 16, mask, out0);
+		_mm512_mask_store_ps(dst1 + vec_left - 16, mask, out1);
+		_mm512_mask_store_ps(dst2 + vec_left - 16, mask, out2);
+	}
+
+	for (unsigned j = vec_left; j < vec_right; j += 16) {
+		XITER(j, XARGS);
+
+		_mm512_store_ps(dst0 + j, out0);
+		_mm512_store_ps(dst1 + j, out1);
+		_mm512_store_ps(dst2 + j, out2);
+	}
+
+	if (right != vec_right) {
+		XITER(vec_right, XARGS);
+		__mmask16 mask = mmask16_set_lo(right - vec_right);
+
+		_mm512_mask_store_ps(dst0 + vec_right, mask, out0);
+		_mm512_mask_store_ps(dst1 + vec_right, mask, out1);
+		_mm512_mask_store_ps(dst2 + vec_right, mask, out2);
+	}
+#undef XITER
+#undef XARGS
+}
+
+inline FORCE_INLINE void lut3d_compare_exchange_avx512(__m512 &fa, __m512i &sa, __m512 &fb, __m512i &sb)
+{
+	__mmask16 mask = _mm512_cmp_ps_mask(fa, fb, _CMP_LT_OQ);
+	__m512 fa_ = _mm512_mask_blend_ps(mask, fa, fb);
+	__m512 fb_ = _mm512_mask_blend_ps(mask, fb, fa);
+	__m512i sa_ = _mm512_mask_blend_epi32(mask, sa, sb);
+	__m512i sb_ = _mm512_mask_blend_epi32(mask, sb, sa);
+
+	fa = fa_;
+	fb = fb_;
+	sa = sa_;
+	sb = sb_;
+}
+
+inline FORCE_INLINE void lut3d_filter_line_avx512_xiter(unsigned j, const Lut3D &lut, const float *src0, const float *src1, const float *src2,
+                                                        __m512 &out0, __m512 &out1, __m512 &out2)
+{
+	const float *data = lut.data.data();
+	const __m512 zero = _mm512_setzero_ps();
+	const __m512 limit = _mm512_set1_ps(static_cast<float>(lut.size - 1));
+	const __m512i idx_limit = _mm512_set1_epi32(lut.size - 2);
+	const float *src[3] = { src0, src1, src2 };
+
+	__m512 f[3];
+	__m512i s[3];
+	__m512i idx = _mm512_setzero_si512();
+
+	for (unsigned p = 0; p < 3; ++p) {
+		unsigned stride = p == 0 ? 4 : p == 1 ? 4 * lut.size : 4 * lut.size * lut.size;
+		__m512 u = _mm512_load_ps(src[p] + j);
+		__m512i k;
+
+		u = _mm512_fmadd_ps(u, _mm512_set1_ps(lut.scale[p]), _mm512_set1_ps(lut.offset[p]));
+		u = _mm512_max_ps(u, zero); // Also removes NaN.
+		u = _mm512_min_ps(u, limit);
+
+		k = _mm512_cvttps_epi32(u);
+		k = _mm512_min_epi32(k, idx_limit);
+
+		f[p] = _mm512_sub_ps(u, _mm512_cvtepi32_ps(k));
+		s[p] = _mm512_set1_epi32(stride);
+		idx = _mm512_add_epi32(idx, _mm512_mullo_epi32(k, s[p]));
+	}
+
+	// Sort the fractions in descending order to select the tetrahedron.
+	lut3d_compare_exchange_avx512(f[0], s[0], f[1], s[1]);
+	lut3d_compare_exchange_avx512(f[1], s[1], f[2], s[2]);
+	lut3d_compare_exchange_avx512(f[0], s[0], f[1], s[1]);
+
+	__m512i idx1 = _mm512_add_epi32(idx, s[0]);
+	__m512i idx2 = _mm512_add_epi32(idx1, s[1]);
+	__m512i idx3 = _mm512_add_epi32(idx2, s[2]);
+
+	__m512 w0 = _mm512_sub_ps(_mm512_set1_ps(1.0f), f[0]);
+	__m512 w1 = _mm512_sub_ps(f[0], f[1]);
+	__m512 w2 = _mm512_sub_ps(f[1], f[2]);
+	__m512 w3 = f[2];
+
+	__m512 *out[3] = { &out0, &out1, &out2 };
+
+	for (unsigned c = 0; c < 3; ++c) {
+		__m512 x;
+
+		x = _mm512_mul_ps(w0, _mm512_i32gather_ps(idx, data + c, sizeof(float)));
+		x = _mm512_fmadd_ps(w1, _mm512_i32gather_ps(idx1, data + c, sizeof(float)), x);
+		x = _mm512_fmadd_ps(w2, _mm512_i32gather_ps(idx2, data + c, sizeof(float)), x);
+		x = _mm512_fmadd_ps(w3, _mm512_i32gather_ps(idx3, data + c, sizeof(float)), x);
+		*out[c] = x;
+	}
+}
+
+void lut3d_filter_line_avx512(const Lut3D &lut, const float * const *src, float * const *dst, unsigned left, unsigned right)
+{
+	const float *src0 = src[0];
+	const float *src1 = src[1];
+	const float *src2 = src[2];
+	float *dst0 = dst[0];
+	float *dst1 = dst[1];
+	float *dst2 = dst[2];
+
+	unsigned vec_left = ceil_n(left, 16);
+	unsigned vec_right = floor_n(right, 16);
+
+	__m512 out0, out1, out2;
+
+	if (left != vec_left) {
+		lut3d_filter_line_avx512_xiter(vec_left - 16, lut, src0, src1, src2, out0, out1, out2);
+		__mmask16 mask = mmask16_set_hi(vec_left - left);
+
+		_mm512_mask_store_ps(dst0 + vec_left - 16, mask, out0);
+		_mm512_mask_store_ps(dst1 + vec_left - 16, mask, out1);
+		_mm512_mask_store_ps(dst2 + vec_left - 16, mask, out2);
+	}
+
+	for (unsigned j = vec_left; j < vec_right; j += 16) {
+		lut3d_filter_line_avx512_xiter(j, lut, src0, src1, src2, out0, out1, out2);
+
+		_mm512_store_ps(dst0 + j, out0);
+		_mm512_store_ps(dst1 + j, out1);
+		_mm512_store_ps(dst2 + j, out2);
+	}
+
+	if (right != vec_right) {
+		lut3d_filter_line_avx512_xiter(vec_right, lut, src0, src1, src2, out0, out1, out2);
+		__mmask16 mask = mmask16_set_lo(right - vec_right);
+
+		_mm512_mask_store_ps(dst0 + vec_right, mask, out0);
+		_mm512_mask_store_ps(dst1 + vec_right, mask, out1);
+		_mm512_mask_store_ps(dst2 + vec_right, mask, out2);
+	}
+}
+
+
 
 class MatrixOperationAVX512 final : public MatrixOperationImpl {
 public:
@@ -314,6 +985,104 @@ public:
 	}
 };
 
+template <class Op, bool Pre, bool Post>
+class FusedGammaOperationAVX512 final : public Operation {
+	float m_pre[3][3];
+	float m_post[3][3];
+	float m_scale;
+public:
+	FusedGammaOperationAVX512(const Matrix3x3 *pre, float scale, const Matrix3x3 *post) :
+		m_pre{},
+		m_post{},
+		m_scale{ scale }
+	{
+		for (unsigned i = 0; i < 3; ++i) {
+			for (unsigned j = 0; j < 3; ++j) {
+				m_pre[i][j] = Pre ? static_cast<float>((*pre)[i][j]) : 0.0f;
+				m_post[i][j] = Post ? static_cast<float>((*post)[i][j]) : 0.0f;
+			}
+		}
+	}
+
+	void process(const float * const *src, float * const *dst, unsigned left, unsigned right) const override
+	{
+		fused_gamma_filter_line_avx512<Op, Pre, Post>(&m_pre[0][0], &m_post[0][0], m_scale, src, dst, left, right);
+	}
+};
+
+template <class Op>
+std::unique_ptr<Operation> create_fused_gamma_operation_avx512_impl(const Matrix3x3 *pre, float scale, const Matrix3x3 *post)
+{
+	if (pre && post)
+		return ztd::make_unique<FusedGammaOperationAVX512<Op, true, true>>(pre, scale, post);
+	else if (pre)
+		return ztd::make_unique<FusedGammaOperationAVX512<Op, true, false>>(pre, scale, post);
+	else if (post)
+		return ztd::make_unique<FusedGammaOperationAVX512<Op, false, true>>(pre, scale, post);
+	else
+		return nullptr;
+}
+
+template <bool Inverse>
+class AribB67OperationAVX512 final : public Operation {
+	float m_coeffs[4];
+public:
+	AribB67OperationAVX512(const Matrix3x3 &m, float scale) :
+		m_coeffs{ static_cast<float>(m[0][0]), static_cast<float>(m[0][1]), static_cast<float>(m[0][2]), scale }
+	{}
+
+	void process(const float * const *src, float * const *dst, unsigned left, unsigned right) const override
+	{
+		arib_b67_filter_line_avx512<Inverse>(m_coeffs, src, dst, left, right);
+	}
+};
+
+template <bool ToRGB>
+class CLOperationAVX512 final : public Operation {
+	float m_coeffs[9];
+public:
+	CLOperationAVX512(const Matrix3x3 &m, float scale) :
+		m_coeffs{ static_cast<float>(m[0][0]), static_cast<float>(m[0][1]), static_cast<float>(m[0][2]), 0.0f }
+	{
+		float kr = m_coeffs[0];
+		float kb = m_coeffs[2];
+
+		m_coeffs[4] = rec_709_oetf(1.0f - kb);
+		m_coeffs[5] = 1.0f - rec_709_oetf(kb);
+		m_coeffs[6] = rec_709_oetf(1.0f - kr);
+		m_coeffs[7] = 1.0f - rec_709_oetf(kr);
+		m_coeffs[8] = scale;
+	}
+
+	void process(const float * const *src, float * const *dst, unsigned left, unsigned right) const override
+	{
+		cl_filter_line_avx512<ToRGB>(m_coeffs, src, dst, left, right);
+	}
+};
+
+template <ToneMapping Method>
+class ToneMapOperationAVX512 final : public Operation {
+	ToneMapCurve m_curve;
+public:
+	explicit ToneMapOperationAVX512(const ToneMapCurve &curve) : m_curve(curve) {}
+
+	void process(const float * const *src, float * const *dst, unsigned left, unsigned right) const override
+	{
+		tone_map_filter_line_avx512<Method>(m_curve, src, dst, left, right);
+	}
+};
+
+class Lut3DOperationAVX512 final : public Operation {
+	Lut3D m_lut;
+public:
+	explicit Lut3DOperationAVX512(const Lut3D &lut) : m_lut(lut) {}
+
+	void process(const float * const *src, float * const *dst, unsigned left, unsigned right) const override
+	{
+		lut3d_filter_line_avx512(m_lut, src, dst, left, right);
+	}
+};
+
 } // namespace
 
 
@@ -352,6 +1121,127 @@ std::unique_ptr<Operation> create_inverse_gamma_operation_avx512(const TransferF
 	return nullptr;
 }
 
+std::unique_ptr<Operation> create_fused_gamma_operation_avx512(const Matrix3x3 *pre, const TransferFunction &transfer, const Matrix3x3 *post, const OperationParams &params)
+{
+	if (!params.approximate_gamma)
+		return nullptr;
+
+	if (transfer.to_gamma == rec_1886_inverse_eotf)
+		return create_fused_gamma_operation_avx512_impl<FuncRec1886InverseEOTF>(pre, transfer.to_gamma_scale, post);
+	else if (transfer.to_gamma == srgb_inverse_eotf)
+		return create_fused_gamma_operation_avx512_impl<FuncSRGBInverseEOTF>(pre, transfer.to_gamma_scale, post);
+	else if (transfer.to_gamma == st_2084_inverse_eotf)
+		return create_fused_gamma_operation_avx512_impl<FuncST2084InverseEOTF>(pre, transfer.to_gamma_scale, post);
+
+	return nullptr;
+}
+
+std::unique_ptr<Operation> create_fused_inverse_gamma_operation_avx512(const Matrix3x3 *pre, const TransferFunction &transfer, const Matrix3x3 *post, const OperationParams &params)
+{
+	if (!params.approximate_gamma)
+		return nullptr;
+
+	if (transfer.to_linear == rec_1886_eotf)
+		return create_fused_gamma_operation_avx512_impl<FuncRec1886EOTF>(pre, transfer.to_linear_scale, post);
+	else if (transfer.to_linear == srgb_eotf)
+		return create_fused_gamma_operation_avx512_impl<FuncSRGBEOTF>(pre, transfer.to_linear_scale, post);
+	else if (transfer.to_linear == st_2084_eotf)
+		return create_fused_gamma_operation_avx512_impl<FuncST2084EOTF>(pre, transfer.to_linear_scale, post);
+
+	return nullptr;
+}
+
+std::unique_ptr<Operation> create_arib_b67_operation_avx512(const Matrix3x3 &m, const OperationParams &params)
+{
+	TransferFunction func = select_transfer_function(TransferCharacteristics::ARIB_B67, params.peak_luminance, false);
+	return ztd::make_unique<AribB67OperationAVX512<false>>(m, func.to_gamma_scale);
+}
+
+std::unique_ptr<Operation> create_inverse_arib_b67_operation_avx512(const Matrix3x3 &m, const OperationParams &params)
+{
+	TransferFunction func = select_transfer_function(TransferCharacteristics::ARIB_B67, params.peak_luminance, false);
+	return ztd::make_unique<AribB67OperationAVX512<true>>(m, func.to_linear_scale);
+}
+
+std::unique_ptr<Operation> create_cl_yuv_to_rgb_operation_avx512(const Matrix3x3 &m, const OperationParams &params)
+{
+	TransferFunction func = select_transfer_function(TransferCharacteristics::REC_709, params.peak_luminance, true);
+	return ztd::make_unique<CLOperationAVX512<true>>(m, func.to_linear_scale);
+}
+
+std::unique_ptr<Operation> create_cl_rgb_to_yuv_operation_avx512(const Matrix3x3 &m, const OperationParams &params)
+{
+	TransferFunction func = select_transfer_function(TransferCharacteristics::REC_709, params.peak_luminance, true);
+	return ztd::make_unique<CLOperationAVX512<false>>(m, func.to_gamma_scale);
+}
+
+std::unique_ptr<Operation> create_tone_map_operation_avx512(const ToneMapCurve &curve)
+{
+	switch (curve.method) {
+	case ToneMapping::BT2390:
+		return ztd::make_unique<ToneMapOperationAVX512<ToneMapping::BT2390>>(curve);
+	case ToneMapping::HABLE:
+		return ztd::make_unique<ToneMapOperationAVX512<ToneMapping::HABLE>>(curve);
+	case ToneMapping::REINHARD:
+		return ztd::make_unique<ToneMapOperationAVX512<ToneMapping::REINHARD>>(curve);
+	default:
+		return nullptr;
+	}
+}
+
+std::unique_ptr<Operation> create_lut3d_operation_avx512(const Lut3D &lut)
+{
+	return ztd::make_unique<Lut3DOperationAVX512>(lut);
+}
+
+void half_to_float_avx512(const void *src, void *dst, unsigned left, unsigned right)
+{
+	const uint16_t *src_p = static_cast<const uint16_t *>(src);
+	float *dst_p = static_cast<float *>(dst);
+
+	unsigned vec_left = ceil_n(left, 16);
+	unsigned vec_right = floor_n(right, 16);
+
+	if (left != vec_left) {
+		__m512 x = _mm512_cvtph_ps(_mm256_load_si256((const __m256i *)(src_p + vec_left - 16)));
+		_mm512_mask_store_ps(dst_p + vec_left - 16, mmask16_set_hi(vec_left - left), x);
+	}
+
+	for (unsigned j = vec_left; j < vec_right; j += 16) {
+		__m512 x = _mm512_cvtph_ps(_mm256_load_si256((const __m256i *)(src_p + j)));
+		_mm512_store_ps(dst_p + j, x);
+	}
+
+	if (right != vec_right) {
+		__m512 x = _mm512_cvtph_ps(_mm256_load_si256((const __m256i *)(src_p + vec_right)));
+		_mm512_mask_store_ps(dst_p + vec_right, mmask16_set_lo(right - vec_right), x);
+	}
+}
+
+void float_to_half_avx512(const void *src, void *dst, unsigned left, unsigned right)
+{
+	const float *src_p = static_cast<const float *>(src);
+	uint16_t *dst_p = static_cast<uint16_t *>(dst);
+
+	unsigned vec_left = ceil_n(left, 16);
+	unsigned vec_right = floor_n(right, 16);
+
+	if (left != vec_left) {
+		__m256i x = _mm512_cvtps_ph(_mm512_load_ps(src_p + vec_left - 16), 0);
+		_mm256_mask_storeu_epi16(dst_p + vec_left - 16, mmask16_set_hi(vec_left - left), x);
+	}
+
+	for (unsigned j = vec_left; j < vec_right; j += 16) {
+		__m256i x = _mm512_cvtps_ph(_mm512_load_ps(src_p + j), 0);
+		_mm256_store_si256((__m256i *)(dst_p + j), x);
+	}
+
+	if (right != vec_right) {
+		__m256i x = _mm512_cvtps_ph(_mm512_load_ps(src_p + vec_right), 0);
+		_mm256_mask_storeu_epi16(dst_p + vec_right, mmask16_set_lo(right - vec_right), x);
+	}
+}
+
 } // namespace colorspace
 } // namespace zimg
 
@@ -1,183 +1,106 @@
 #ifdef ZIMG_X86
 
-#include <algorithm>
-#include <cstddef>
+#include <cfloat>
 #include <cstdint>
-#include <type_traits>
+#include <utility>
 #include <vector>
 #include <emmintrin.h>
 #include "common/align.h"
 #include "common/ccdep.h"
 #include "common/make_unique.h"
-#include "common/x86/sse2_util.h"
 #include "colorspace/gamma.h"
 #include "colorspace/operation.h"
 #include "colorspace/operation_impl.h"
 #include "operation_impl_x86.h"
 
+#include "common/x86/sse_util.h"
+
 namespace zimg {
 namespace colorspace {
 
 namespace {
 
-constexpr unsigned LUT_DEPTH = 16;
+inline FORCE_INLINE __m128 lut_interpolate_sse2(const float *lut, __m128i xi, __m128 t)
+{
+	alignas(16) uint32_t idx[4];
+	__m128 v0, v1;
+
+	_mm_store_si128((__m128i *)idx, xi);
+	v0 = _mm_set_ps(lut[idx[3]], lut[idx[2]], lut[idx[1]], lut[idx[0]]);
+	v1 = _mm_set_ps(lut[idx[3] + 1], lut[idx[2] + 1], lut[idx[1] + 1], lut[idx[0] + 1]);
 
-template <class T, class U>
-T bit_cast(const U &x) noexcept
+	return _mm_add_ps(_mm_mul_ps(_mm_sub_ps(v1, v0), t), v0);
+}
+
+inline FORCE_INLINE __m128 to_linear_lut_sse2(const float *lut, __m128 x)
 {
-	static_assert(sizeof(T) == sizeof(U), "object sizes must match");
-	static_assert(std::is_pod<T>::value && std::is_pod<U>::value, "object types must be POD");
+	const float lut_limit = static_cast<float>(1U << TO_LINEAR_LUT_DEPTH);
+	__m128i xi;
+	__m128 t;
+
+	// Clamp to the table range. Also removes NaN.
+	x = _mm_add_ps(_mm_mul_ps(x, _mm_set_ps1(0.5f * lut_limit)), _mm_set_ps1(0.25f * lut_limit));
+	x = _mm_max_ps(x, _mm_setzero_ps());
+	x = _mm_min_ps(x, _mm_set_ps1(lut_limit));
+
+	xi = _mm_cvttps_epi32(x);
+	t = _mm_sub_ps(x, _mm_cvtepi32_ps(xi));
 
-	T ret;
-	std::copy_n(reinterpret_cast<const char *>(&x), sizeof(x), reinterpret_cast<char *>(&ret));
-	return ret;
+	return lut_interpolate_sse2(lut, xi, t);
 }
 
-void to_linear_lut_filter_line(const float *RESTRICT lut, unsigned lut_depth, const float *src, float *dst, unsigned left, unsigned right)
+inline FORCE_INLINE __m128 to_gamma_lut_sse2(const float *lut, __m128 x)
 {
-	unsigned vec_left = ceil_n(left, 4);
-	unsigned vec_right = floor_n(right, 4);
+	__m128i xi;
+	__m128 t;
 
-	const int32_t lut_limit = static_cast<int32_t>(1) << lut_depth;
+	// Clamp to the range of finite numbers. Also removes NaN.
+	x = _mm_max_ps(x, _mm_set_ps1(-FLT_MAX));
+	x = _mm_min_ps(x, _mm_set_ps1(FLT_MAX));
 
-	const __m128 scale = _mm_set_ps1(0.5f * lut_limit);
-	const __m128 offset = _mm_set_ps1(0.25f * lut_limit);
-	const __m128i limit = _mm_set1_epi16(std::min(lut_limit + INT16_MIN, static_cast<int32_t>(INT16_MAX)));
-	const __m128i bias_epi16 = _mm_set1_epi16(INT16_MIN);
-	const __m128i bias_epi32 = _mm_set1_epi32(INT16_MIN);
+	// Index by the upper half of the float and interpolate by the lower half.
+	xi = _mm_castps_si128(x);
+	t = _mm_cvtepi32_ps(_mm_and_si128(xi, _mm_set1_epi32(0xFFFF)));
+	t = _mm_mul_ps(t, _mm_set_ps1(1.0f / 65536.0f));
+	xi = _mm_srli_epi32(xi, 16);
 
-	for (unsigned j = left; j < vec_left; ++j) {
-		__m128 x = _mm_load_ss(src + j);
-		int idx = _mm_cvt_ss2si(_mm_add_ss(_mm_mul_ss(x, scale), offset));
-		dst[j] = lut[std::min(std::max(idx, 0), lut_limit)];
-	}
-	for (ptrdiff_t j = vec_left; j < static_cast<ptrdiff_t>(vec_right); j += 4) {
-		__m128 x;
-		__m128i xi;
-
-		x = _mm_load_ps(src + j);
-		x = _mm_mul_ps(x, scale);
-		x = _mm_add_ps(x, offset);
-		xi = _mm_cvtps_epi32(x);
-		xi = _mm_add_epi32(xi, bias_epi32);
-		xi = _mm_packs_epi32(xi, xi);
-		xi = _mm_min_epi16(xi, limit);
-		xi = _mm_sub_epi16(xi, bias_epi16);
-
-#if SIZE_MAX >= UINT64_MAX
-		uint64_t tmp = _mm_cvtsi128_si64(xi);
-		dst[j + 0] = lut[tmp & 0xFFFFU];
-		dst[j + 1] = lut[(tmp >> 16) & 0xFFFFU];
-		dst[j + 2] = lut[(tmp >> 32) & 0xFFFFU];
-		dst[j + 3] = lut[tmp >> 48];
-#else
-		uint32_t tmp0 = _mm_cvtsi128_si32(xi);
-		uint32_t tmp1 = _mm_cvtsi128_si32(_mm_shuffle_epi32(xi, _MM_SHUFFLE(3, 2, 0, 1)));
-		dst[j + 0] = lut[tmp0 & 0xFFFFU];
-		dst[j + 1] = lut[tmp0 >> 16];
-		dst[j + 2] = lut[tmp1 & 0xFFFFU];
-		dst[j + 3] = lut[tmp1 >> 16];
-#endif
-	}
-	for (unsigned j = vec_right; j < right; ++j) {
-		__m128 x = _mm_load_ss(src + j);
-		int idx = _mm_cvt_ss2si(_mm_add_ss(_mm_mul_ss(x, scale), offset));
-		dst[j] = lut[std::min(std::max(idx, 0), lut_limit)];
-	}
+	return lut_interpolate_sse2(lut, xi, t);
 }
 
-void to_gamma_lut_filter_line(const float *RESTRICT lut, const float *src, float *dst, unsigned left, unsigned right)
+template <bool Inverse>
+void gamma_lut_filter_line(const float *RESTRICT lut, const float *src, float *dst, unsigned left, unsigned right)
 {
 	unsigned vec_left = ceil_n(left, 4);
 	unsigned vec_right = floor_n(right, 4);
 
-	for (unsigned j = left; j < vec_left; ++j) {
-		__m128i x = _mm_castps_si128(_mm_load_ss(src + j));
-		__m128i msb = _mm_srli_epi32(x, 16);
-		__m128i lsb = _mm_and_si128(_mm_srli_epi32(x, 15), _mm_set1_epi32(1));
-		x = mm_packus_epi32(msb, lsb);
-		x = _mm_adds_epi16(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+	auto eval = [=](__m128 x) { return Inverse ? to_linear_lut_sse2(lut, x) : to_gamma_lut_sse2(lut, x); };
 
-		dst[j] = lut[_mm_cvtsi128_si32(x)];
+	if (left != vec_left) {
+		__m128 x = eval(_mm_load_ps(src + vec_left - 4));
+		mm_store_idxhi_ps(dst + vec_left - 4, x, left % 4);
 	}
 	for (unsigned j = vec_left; j < vec_right; j += 4) {
-		__m128i x = _mm_castps_si128(_mm_load_ps(src + j));
-		__m128i msb = _mm_srli_epi32(x, 16);
-		__m128i lsb = _mm_and_si128(_mm_srli_epi32(x, 15), _mm_set1_epi32(1));
-		x = mm_packus_epi32(msb, lsb);
-		x = _mm_adds_epi16(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
-
-#if SIZE_MAX >= UINT64_MAX
-		uint64_t tmp = _mm_cvtsi128_si64(x);
-		dst[j + 0] = lut[tmp & 0xFFFFU];
-		dst[j + 1] = lut[(tmp >> 16) & 0xFFFFU];
-		dst[j + 2] = lut[(tmp >> 32) & 0xFFFFU];
-		dst[j + 3] = lut[tmp >> 48];
-#else
-		uint32_t tmp0 = _mm_cvtsi128_si32(x);
-		uint32_t tmp1 = _mm_cvtsi128_si32(_mm_shuffle_epi32(x, _MM_SHUFFLE(3, 2, 0, 1)));
-		dst[j + 0] = lut[tmp0 & 0xFFFFU];
-		dst[j + 1] = lut[tmp0 >> 16];
-		dst[j + 2] = lut[tmp1 & 0xFFFFU];
-		dst[j + 3] = lut[tmp1 >> 16];
-#endif
+		__m128 x = eval(_mm_load_ps(src + j));
+		_mm_store_ps(dst + j, x);
 	}
-	for (unsigned j = vec_right; j < right; ++j) {
-		__m128i x = _mm_castps_si128(_mm_load_ss(src + j));
-		__m128i msb = _mm_srli_epi32(x, 16);
-		__m128i lsb = _mm_and_si128(_mm_srli_epi32(x, 15), _mm_set1_epi32(1));
-		x = mm_packus_epi32(msb, lsb);
-		x = _mm_adds_epi16(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
-
-		dst[j] = lut[_mm_cvtsi128_si32(x)];
+	if (right != vec_right) {
+		__m128 x = eval(_mm_load_ps(src + vec_right));
+		mm_store_idxlo_ps(dst + vec_right, x, right % 4);
 	}
 }
 
 
-class ToLinearLutOperationSSE2 final : public Operation {
-	std::vector<float> m_lut;
-	unsigned m_lut_depth;
-public:
-	ToLinearLutOperationSSE2(gamma_func func, unsigned lut_depth, float postscale) :
-		m_lut((1UL << lut_depth) + 1),
-		m_lut_depth{ lut_depth }
-	{
-		EnsureSinglePrecision x87;
-
-		// Allocate an extra LUT entry so that indexing can be done by multipying by a power of 2.
-		for (size_t i = 0; i < m_lut.size(); ++i) {
-			float x = static_cast<float>(i) / (1 << lut_depth) * 2.0f - 0.5f;
-			m_lut[i] = func(x) * postscale;
-		}
-	}
-
-	void process(const float * const *src, float * const *dst, unsigned left, unsigned right) const override
-	{
-		to_linear_lut_filter_line(m_lut.data(), m_lut_depth, src[0], dst[0], left, right);
-		to_linear_lut_filter_line(m_lut.data(), m_lut_depth, src[1], dst[1], left, right);
-		to_linear_lut_filter_line(m_lut.data(), m_lut_depth, src[2], dst[2], left, right);
-	}
-};
-
-class ToGammaLutOperationSSE2 final : public Operation {
+template <bool Inverse>
+class GammaLutOperationSSE2 final : public Operation {
 	std::vector<float> m_lut;
 public:
-	ToGammaLutOperationSSE2(gamma_func func, float prescale) :
-		m_lut(static_cast<uint32_t>(UINT16_MAX) + 1)
-	{
-		EnsureSinglePrecision x87;
-
-		for (size_t i = 0; i <= UINT16_MAX; ++i) {
-			float x = bit_cast<float>(static_cast<uint32_t>(i << 16));
-			m_lut[i] = func(x * prescale);
-		}
-	}
+	explicit GammaLutOperationSSE2(std::vector<float> lut) : m_lut(std::move(lut)) {}
 
 	void process(const float * const *src, float * const *dst, unsigned left, unsigned right) const override
 	{
-		to_gamma_lut_filter_line(m_lut.data(), src[0], dst[0], left, right);
-		to_gamma_lut_filter_line(m_lut.data(), src[1], dst[1], left, right);
-		to_gamma_lut_filter_line(m_lut.data(), src[2], dst[2], left, right);
+		gamma_lut_filter_line<Inverse>(m_lut.data(), src[0], dst[0], left, right);
+		gamma_lut_filter_line<Inverse>(m_lut.data(), src[1], dst[1], left, right);
+		gamma_lut_filter_line<Inverse>(m_lut.data(), src[2], dst[2], left, right);
 	}
 };
 
@@ -189,7 +112,7 @@ std::unique_ptr<Operation> create_gamma_operation_sse2(const TransferFunction &t
 	if (!params.approximate_gamma)
 		return nullptr;
 
-	return ztd::make_unique<ToGammaLutOperationSSE2>(transfer.to_gamma, transfer.to_gamma_scale);
+	return ztd::make_unique<GammaLutOperationSSE2<false>>(make_to_gamma_lut(transfer));
 }
 
 std::unique_ptr<Operation> create_inverse_gamma_operation_sse2(const TransferFunction &transfer, const OperationParams &params)
@@ -197,7 +120,7 @@ std::unique_ptr<Operation> create_inverse_gamma_operation_sse2(const TransferFun
 	if (!params.approximate_gamma)
 		return nullptr;
 
-	return ztd::make_unique<ToLinearLutOperationSSE2>(transfer.to_linear, LUT_DEPTH, transfer.to_linear_scale);
+	return ztd::make_unique<GammaLutOperationSSE2<true>>(make_to_linear_lut(transfer));
 }
 
 } // namespace colorspace
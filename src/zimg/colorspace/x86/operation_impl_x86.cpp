@@ -93,6 +93,222 @@ std::unique_ptr<Operation> create_inverse_gamma_operation_x86(const TransferFunc
 	return ret;
 }
 
+std::unique_ptr<Operation> create_fused_gamma_operation_x86(const Matrix3x3 *pre, const TransferFunction &transfer, const Matrix3x3 *post, const OperationParams &params, CPUClass cpu)
+{
+	X86Capabilities caps = query_x86_capabilities();
+	std::unique_ptr<Operation> ret;
+
+	if (cpu_is_autodetect(cpu)) {
+#ifdef ZIMG_X86_AVX512
+		if (!ret && cpu == CPUClass::AUTO_64B && caps.avx512f && caps.avx512bw && caps.avx512dq)
+			ret = create_fused_gamma_operation_avx512(pre, transfer, post, params);
+#endif
+		if (!ret && caps.avx2 && !cpu_has_slow_gather(caps))
+			ret = create_fused_gamma_operation_avx2(pre, transfer, post, params);
+	} else {
+#ifdef ZIMG_X86_AVX512
+		if (!ret && cpu >= CPUClass::X86_AVX512)
+			ret = create_fused_gamma_operation_avx512(pre, transfer, post, params);
+#endif
+		if (!ret && cpu >= CPUClass::X86_AVX2)
+			ret = create_fused_gamma_operation_avx2(pre, transfer, post, params);
+	}
+
+	return ret;
+}
+
+std::unique_ptr<Operation> create_fused_inverse_gamma_operation_x86(const Matrix3x3 *pre, const TransferFunction &transfer, const Matrix3x3 *post, const OperationParams &params, CPUClass cpu)
+{
+	X86Capabilities caps = query_x86_capabilities();
+	std::unique_ptr<Operation> ret;
+
+	if (cpu_is_autodetect(cpu)) {
+#ifdef ZIMG_X86_AVX512
+		if (!ret && cpu == CPUClass::AUTO_64B && caps.avx512f && caps.avx512bw && caps.avx512dq)
+			ret = create_fused_inverse_gamma_operation_avx512(pre, transfer, post, params);
+#endif
+		if (!ret && caps.avx2 && !cpu_has_slow_gather(caps))
+			ret = create_fused_inverse_gamma_operation_avx2(pre, transfer, post, params);
+	} else {
+#ifdef ZIMG_X86_AVX512
+		if (!ret && cpu >= CPUClass::X86_AVX512)
+			ret = create_fused_inverse_gamma_operation_avx512(pre, transfer, post, params);
+#endif
+		if (!ret && cpu >= CPUClass::X86_AVX2)
+			ret = create_fused_inverse_gamma_operation_avx2(pre, transfer, post, params);
+	}
+
+	return ret;
+}
+
+std::unique_ptr<Operation> create_arib_b67_operation_x86(const Matrix3x3 &m, const OperationParams &params, CPUClass cpu)
+{
+	X86Capabilities caps = query_x86_capabilities();
+	std::unique_ptr<Operation> ret;
+
+	if (cpu_is_autodetect(cpu)) {
+#ifdef ZIMG_X86_AVX512
+		if (!ret && cpu == CPUClass::AUTO_64B && caps.avx512f)
+			ret = create_arib_b67_operation_avx512(m, params);
+#endif
+		if (!ret && caps.avx2 && caps.fma)
+			ret = create_arib_b67_operation_avx2(m, params);
+	} else {
+#ifdef ZIMG_X86_AVX512
+		if (!ret && cpu >= CPUClass::X86_AVX512)
+			ret = create_arib_b67_operation_avx512(m, params);
+#endif
+		if (!ret && cpu >= CPUClass::X86_AVX2)
+			ret = create_arib_b67_operation_avx2(m, params);
+	}
+
+	return ret;
+}
+
+std::unique_ptr<Operation> create_inverse_arib_b67_operation_x86(const Matrix3x3 &m, const OperationParams &params, CPUClass cpu)
+{
+	X86Capabilities caps = query_x86_capabilities();
+	std::unique_ptr<Operation> ret;
+
+	if (cpu_is_autodetect(cpu)) {
+#ifdef ZIMG_X86_AVX512
+		if (!ret && cpu == CPUClass::AUTO_64B && caps.avx512f)
+			ret = create_inverse_arib_b67_operation_avx512(m, params);
+#endif
+		if (!ret && caps.avx2 && caps.fma)
+			ret = create_inverse_arib_b67_operation_avx2(m, params);
+	} else {
+#ifdef ZIMG_X86_AVX512
+		if (!ret && cpu >= CPUClass::X86_AVX512)
+			ret = create_inverse_arib_b67_operation_avx512(m, params);
+#endif
+		if (!ret && cpu >= CPUClass::X86_AVX2)
+			ret = create_inverse_arib_b67_operation_avx2(m, params);
+	}
+
+	return ret;
+}
+
+std::unique_ptr<Operation> create_cl_yuv_to_rgb_operation_x86(const Matrix3x3 &m, const OperationParams &params, CPUClass cpu)
+{
+	X86Capabilities caps = query_x86_capabilities();
+	std::unique_ptr<Operation> ret;
+
+	if (cpu_is_autodetect(cpu)) {
+#ifdef ZIMG_X86_AVX512
+		if (!ret && cpu == CPUClass::AUTO_64B && caps.avx512f)
+			ret = create_cl_yuv_to_rgb_operation_avx512(m, params);
+#endif
+		if (!ret && caps.avx2 && caps.fma)
+			ret = create_cl_yuv_to_rgb_operation_avx2(m, params);
+	} else {
+#ifdef ZIMG_X86_AVX512
+		if (!ret && cpu >= CPUClass::X86_AVX512)
+			ret = create_cl_yuv_to_rgb_operation_avx512(m, params);
+#endif
+		if (!ret && cpu >= CPUClass::X86_AVX2)
+			ret = create_cl_yuv_to_rgb_operation_avx2(m, params);
+	}
+
+	return ret;
+}
+
+std::unique_ptr<Operation> create_cl_rgb_to_yuv_operation_x86(const Matrix3x3 &m, const OperationParams &params, CPUClass cpu)
+{
+	X86Capabilities caps = query_x86_capabilities();
+	std::unique_ptr<Operation> ret;
+
+	if (cpu_is_autodetect(cpu)) {
+#ifdef ZIMG_X86_AVX512
+		if (!ret && cpu == CPUClass::AUTO_64B && caps.avx512f)
+			ret = create_cl_rgb_to_yuv_operation_avx512(m, params);
+#endif
+		if (!ret && caps.avx2 && caps.fma)
+			ret = create_cl_rgb_to_yuv_operation_avx2(m, params);
+	} else {
+#ifdef ZIMG_X86_AVX512
+		if (!ret && cpu >= CPUClass::X86_AVX512)
+			ret = create_cl_rgb_to_yuv_operation_avx512(m, params);
+#endif
+		if (!ret && cpu >= CPUClass::X86_AVX2)
+			ret = create_cl_rgb_to_yuv_operation_avx2(m, params);
+	}
+
+	return ret;
+}
+
+std::unique_ptr<Operation> create_tone_map_operation_x86(const ToneMapCurve &curve, CPUClass cpu)
+{
+	X86Capabilities caps = query_x86_capabilities();
+	std::unique_ptr<Operation> ret;
+
+	if (cpu_is_autodetect(cpu)) {
+#ifdef ZIMG_X86_AVX512
+		if (!ret && cpu == CPUClass::AUTO_64B && caps.avx512f)
+			ret = create_tone_map_operation_avx512(curve);
+#endif
+		if (!ret && caps.avx2 && caps.fma)
+			ret = create_tone_map_operation_avx2(curve);
+	} else {
+#ifdef ZIMG_X86_AVX512
+		if (!ret && cpu >= CPUClass::X86_AVX512)
+			ret = create_tone_map_operation_avx512(curve);
+#endif
+		if (!ret && cpu >= CPUClass::X86_AVX2)
+			ret = create_tone_map_operation_avx2(curve);
+	}
+
+	return ret;
+}
+
+std::unique_ptr<Operation> create_lut3d_operation_x86(const Lut3D &lut, CPUClass cpu)
+{
+	X86Capabilities caps = query_x86_capabilities();
+	std::unique_ptr<Operation> ret;
+
+	if (cpu_is_autodetect(cpu)) {
+#ifdef ZIMG_X86_AVX512
+		if (!ret && cpu == CPUClass::AUTO_64B && caps.avx512f)
+			ret = create_lut3d_operation_avx512(lut);
+#endif
+		if (!ret && caps.avx2 && !cpu_has_slow_gather(caps))
+			ret = create_lut3d_operation_avx2(lut);
+	} else {
+#ifdef ZIMG_X86_AVX512
+		if (!ret && cpu >= CPUClass::X86_AVX512)
+			ret = create_lut3d_operation_avx512(lut);
+#endif
+		if (!ret && cpu >= CPUClass::X86_AVX2)
+			ret = create_lut3d_operation_avx2(lut);
+	}
+
+	return ret;
+}
+
+f16c_func select_f16c_func_x86(bool to_half, CPUClass cpu)
+{
+	X86Capabilities caps = query_x86_capabilities();
+	f16c_func func = nullptr;
+
+	if (cpu_is_autodetect(cpu)) {
+#ifdef ZIMG_X86_AVX512
+		if (!func && cpu == CPUClass::AUTO_64B && cpu_has_avx512_f_dq_bw_vl(caps))
+			func = to_half ? float_to_half_avx512 : half_to_float_avx512;
+#endif
+		if (!func && caps.avx2 && caps.f16c)
+			func = to_half ? float_to_half_avx2 : half_to_float_avx2;
+	} else {
+#ifdef ZIMG_X86_AVX512
+		if (!func && cpu >= CPUClass::X86_AVX512)
+			func = to_half ? float_to_half_avx512 : half_to_float_avx512;
+#endif
+		if (!func && cpu >= CPUClass::X86_AVX2)
+			func = to_half ? float_to_half_avx2 : half_to_float_avx2;
+	}
+
+	return func;
+}
+
 } // namespace colorspace
 } // namespace zimg
 
@@ -6,6 +6,7 @@
 #define ZIMG_COLORSPACE_X86_OPERATION_IMPL_X86_H_
 
 #include <memory>
+#include "colorspace/operation.h"
 
 namespace zimg {
 
@@ -13,11 +14,11 @@ enum class CPUClass;
 
 namespace colorspace {
 
+struct Lut3D;
 struct Matrix3x3;
 struct OperationParams;
+struct ToneMapCurve;
 struct TransferFunction;
-class Operation;
-
 std::unique_ptr<Operation> create_matrix_operation_sse(const Matrix3x3 &m);
 std::unique_ptr<Operation> create_matrix_operation_avx(const Matrix3x3 &m);
 std::unique_ptr<Operation> create_matrix_operation_avx512(const Matrix3x3 &m);
@@ -36,6 +37,54 @@ std::unique_ptr<Operation> create_inverse_gamma_operation_avx512(const TransferF
 
 std::unique_ptr<Operation> create_inverse_gamma_operation_x86(const TransferFunction &transfer, const OperationParams &params, CPUClass cpu);
 
+std::unique_ptr<Operation> create_fused_gamma_operation_avx2(const Matrix3x3 *pre, const TransferFunction &transfer, const Matrix3x3 *post, const OperationParams &params);
+std::unique_ptr<Operation> create_fused_gamma_operation_avx512(const Matrix3x3 *pre, const TransferFunction &transfer, const Matrix3x3 *post, const OperationParams &params);
+
+std::unique_ptr<Operation> create_fused_gamma_operation_x86(const Matrix3x3 *pre, const TransferFunction &transfer, const Matrix3x3 *post, const OperationParams &params, CPUClass cpu);
+
+std::unique_ptr<Operation> create_fused_inverse_gamma_operation_avx2(const Matrix3x3 *pre, const TransferFunction &transfer, const Matrix3x3 *post, const OperationParams &params);
+std::unique_ptr<Operation> create_fused_inverse_gamma_operation_avx512(const Matrix3x3 *pre, const TransferFunction &transfer, const Matrix3x3 *post, const OperationParams &params);
+
+std::unique_ptr<Operation> create_fused_inverse_gamma_operation_x86(const Matrix3x3 *pre, const TransferFunction &transfer, const Matrix3x3 *post, const OperationParams &params, CPUClass cpu);
+
+std::unique_ptr<Operation> create_arib_b67_operation_avx2(const Matrix3x3 &m, const OperationParams &params);
+std::unique_ptr<Operation> create_arib_b67_operation_avx512(const Matrix3x3 &m, const OperationParams &params);
+
+std::unique_ptr<Operation> create_arib_b67_operation_x86(const Matrix3x3 &m, const OperationParams &params, CPUClass cpu);
+
+std::unique_ptr<Operation> create_inverse_arib_b67_operation_avx2(const Matrix3x3 &m, const OperationParams &params);
+std::unique_ptr<Operation> create_inverse_arib_b67_operation_avx512(const Matrix3x3 &m, const OperationParams &params);
+
+std::unique_ptr<Operation> create_inverse_arib_b67_operation_x86(const Matrix3x3 &m, const OperationParams &params, CPUClass cpu);
+
+std::unique_ptr<Operation> create_cl_yuv_to_rgb_operation_avx2(const Matrix3x3 &m, const OperationParams &params);
+std::unique_ptr<Operation> create_cl_yuv_to_rgb_operation_avx512(const Matrix3x3 &m, const OperationParams &params);
+
+std::unique_ptr<Operation> create_cl_yuv_to_rgb_operation_x86(const Matrix3x3 &m, const OperationParams &params, CPUClass cpu);
+
+std::unique_ptr<Operation> create_cl_rgb_to_yuv_operation_avx2(const Matrix3x3 &m, const OperationParams &params);
+std::unique_ptr<Operation> create_cl_rgb_to_yuv_operation_avx512(const Matrix3x3 &m, const OperationParams &params);
+
+std::unique_ptr<Operation> create_cl_rgb_to_yuv_operation_x86(const Matrix3x3 &m, const OperationParams &params, CPUClass cpu);
+
+std::unique_ptr<Operation> create_tone_map_operation_avx2(const ToneMapCurve &curve);
+std::unique_ptr<Operation> create_tone_map_operation_avx512(const ToneMapCurve &curve);
+
+std::unique_ptr<Operation> create_tone_map_operation_x86(const ToneMapCurve &curve, CPUClass cpu);
+
+std::unique_ptr<Operation> create_lut3d_operation_avx2(const Lut3D &lut);
+std::unique_ptr<Operation> create_lut3d_operation_avx512(const Lut3D &lut);
+
+std::unique_ptr<Operation> create_lut3d_operation_x86(const Lut3D &lut, CPUClass cpu);
+
+void half_to_float_avx2(const void *src, void *dst, unsigned left, unsigned right);
+void float_to_half_avx2(const void *src, void *dst, unsigned left, unsigned right);
+
+void half_to_float_avx512(const void *src, void *dst, unsigned left, unsigned right);
+void float_to_half_avx512(const void *src, void *dst, unsigned left, unsigned right);
+
+f16c_func select_f16c_func_x86(bool to_half, CPUClass cpu);
+
 } // namespace colorspace
 } // namespace zimg
 
@@ -10,6 +10,7 @@
   #include <asm/hwcap.h>
 #endif
 
+#include "common/cpuinfo.h"
 #include "cpuinfo_arm.h"
 
 namespace zimg {
@@ -46,6 +47,21 @@ ARMCapabilities query_arm_capabilities() noexcept
 	return caps;
 }
 
+bool cpu_has_fast_f16_arm(CPUClass cpu) noexcept
+{
+#if defined(_MSC_VER) && !defined(_M_ARM64)
+	// Half-precision conversion intrinsics are not available on this target.
+	return false;
+#else
+	if (cpu_is_autodetect(cpu)) {
+		ARMCapabilities caps = query_arm_capabilities();
+		return caps.neon && caps.vfpv4;
+	} else {
+		return cpu >= CPUClass::ARM_NEON;
+	}
+#endif
+}
+
 } // namespace zimg
 
 #endif // ZIMG_ARM
@@ -7,6 +7,8 @@
 
 namespace zimg {
 
+enum class CPUClass;
+
 /**
  * Bitfield of selected ARM feature flags.
  */
@@ -17,6 +19,8 @@ struct ARMCapabilities {
 
 ARMCapabilities query_arm_capabilities() noexcept;
 
+bool cpu_has_fast_f16_arm(CPUClass cpu) noexcept;
+
 } // namespace zimg
 
 #endif // ZIMG_X86_CPUINFO_ARM_H_
@@ -17,6 +17,7 @@
   #define vmull_high_s16(a, v) vmull_s16(vget_high_s16(a), vget_high_s16(v))
   #define vmlal_high_s16(a, b, v) vmlal_s16(a, vget_high_s16(b), vget_high_s16(v))
   #define vfmaq_f32(a, b, c) vmlaq_f32(a, b, c)
+  #define vfmsq_f32(a, b, c) vmlsq_f32(a, b, c)
   #define vdupq_laneq_s16(vec, lane) ((lane) >= 4 ? vdupq_lane_s16(vget_high_s16(vec), (lane) % 4) : vdupq_lane_s16(vget_low_s16(vec), (lane) % 4))
   #define vdupq_laneq_f32(vec, lane) ((lane) >= 2 ? vdupq_lane_f32(vget_high_f32(vec), (lane) % 2) : vdupq_lane_f32(vget_low_f32(vec), (lane) % 2))
 #endif
@@ -1,7 +1,9 @@
 #include "cpuinfo.h"
 
-#ifdef ZIMG_X86
+#if defined(ZIMG_X86)
   #include "x86/cpuinfo_x86.h"
+#elif defined(ZIMG_ARM)
+  #include "arm/cpuinfo_arm.h"
 #endif
 
 namespace zimg {
@@ -18,8 +20,10 @@ unsigned long cpu_cache_size() noexcept
 bool cpu_has_fast_f16(CPUClass cpu) noexcept
 {
 	bool ret = false;
-#ifdef ZIMG_X86
+#if defined(ZIMG_X86)
 	ret = cpu_has_fast_f16_x86(cpu);
+#elif defined(ZIMG_ARM)
+	ret = cpu_has_fast_f16_arm(cpu);
 #endif
 	return ret;
 }
@@ -0,0 +1,206 @@
+#include <climits>
+#include <cstdint>
+#include <new>
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif
+  #include <Windows.h>
+#else
+  #include <sys/mman.h>
+  #ifdef __linux__
+    #include <sys/syscall.h>
+    #include <unistd.h>
+  #endif
+#endif
+
+#include "align.h"
+#include "alloc.h"
+#include "except.h"
+#include "page_alloc.h"
+
+namespace zimg {
+
+namespace {
+
+// The allocation header occupies one cache line, preserving 64-byte alignment of the returned buffer.
+constexpr size_t HEADER_SIZE = 64;
+constexpr size_t HUGE_PAGE_SIZE = static_cast<size_t>(2) << 20;
+
+enum class AllocKind {
+	MALLOC,
+	MMAP,
+	VIRTUAL_ALLOC,
+};
+
+struct AllocHeader {
+	size_t length;
+	AllocKind kind;
+};
+
+static_assert(sizeof(AllocHeader) <= HEADER_SIZE, "header too large");
+
+
+void *attach_header(void *base, size_t length, AllocKind kind) noexcept
+{
+	new (base) AllocHeader{ length, kind };
+	return static_cast<unsigned char *>(base) + HEADER_SIZE;
+}
+
+#if defined(__linux__) && defined(SYS_mbind)
+void bind_numa_node(void *ptr, size_t length, int node) noexcept
+{
+	constexpr int MPOL_PREFERRED_ = 1;
+	constexpr unsigned MAX_NODES = 1024;
+	constexpr unsigned BITS = sizeof(unsigned long) * CHAR_BIT;
+
+	unsigned long mask[MAX_NODES / BITS] = {};
+
+	if (static_cast<unsigned>(node) >= MAX_NODES)
+		return;
+
+	mask[node / BITS] |= 1UL << (node % BITS);
+
+	// The kernel interprets the node count as one greater than the mask length.
+	syscall(SYS_mbind, ptr, static_cast<unsigned long>(length), MPOL_PREFERRED_, mask, static_cast<unsigned long>(MAX_NODES + 1), 0U);
+}
+#endif
+
+#ifdef _WIN32
+void *page_alloc_win32(size_t length, const PageAllocOptions &options)
+{
+	DWORD type = MEM_RESERVE | MEM_COMMIT;
+
+	if (options.huge_pages) {
+		SIZE_T large_page = ::GetLargePageMinimum();
+		if (!large_page)
+			error::throw_<error::OutOfMemory>("large pages not supported");
+
+		length = ceil_n(length, static_cast<unsigned>(large_page));
+		type |= MEM_LARGE_PAGES;
+	}
+
+	void *base = options.numa_node >= 0
+		? ::VirtualAllocExNuma(::GetCurrentProcess(), nullptr, length, type, PAGE_READWRITE, static_cast<DWORD>(options.numa_node))
+		: ::VirtualAlloc(nullptr, length, type, PAGE_READWRITE);
+	if (!base)
+		error::throw_<error::OutOfMemory>("error allocating pages");
+
+	return attach_header(base, length, AllocKind::VIRTUAL_ALLOC);
+}
+#else
+void *page_alloc_mmap(size_t length, const PageAllocOptions &options)
+{
+	int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+	if (options.huge_pages) {
+#ifdef MAP_HUGETLB
+		flags |= MAP_HUGETLB;
+  #ifdef MAP_HUGE_SHIFT
+		flags |= 21 << MAP_HUGE_SHIFT;
+  #endif
+		length = ceil_n(length, HUGE_PAGE_SIZE);
+#else
+		error::throw_<error::OutOfMemory>("huge pages not supported");
+#endif
+	}
+
+	// Transparent huge pages only back 2 MB aligned ranges. The mapping is
+	// enlarged by one huge page, and the excess on either side is unmapped.
+	bool thp = options.transparent_huge_pages && !options.huge_pages;
+	size_t map_length = length;
+
+	if (thp) {
+		length = ceil_n(length, HUGE_PAGE_SIZE);
+		map_length = length + HUGE_PAGE_SIZE;
+	}
+
+	void *base = ::mmap(nullptr, map_length, PROT_READ | PROT_WRITE, flags, -1, 0);
+	if (base == MAP_FAILED)
+		error::throw_<error::OutOfMemory>("error mapping pages");
+
+	if (thp) {
+		unsigned char *first = static_cast<unsigned char *>(base);
+		unsigned char *aligned = first + (HUGE_PAGE_SIZE - reinterpret_cast<uintptr_t>(first) % HUGE_PAGE_SIZE) % HUGE_PAGE_SIZE;
+
+		if (aligned != first)
+			::munmap(first, aligned - first);
+		if (aligned + length != first + map_length)
+			::munmap(aligned + length, first + map_length - (aligned + length));
+
+		base = aligned;
+	}
+
+#ifdef MADV_HUGEPAGE
+	// The advice is a hint, so failure is not an error.
+	if (thp)
+		::madvise(base, length, MADV_HUGEPAGE);
+#endif
+
+#if defined(__linux__) && defined(SYS_mbind)
+	// Pages are not yet committed, so the policy applies to the entire buffer.
+	// Like the advice above, the policy is a preference and failure is ignored.
+	if (options.numa_node >= 0)
+		bind_numa_node(base, length, options.numa_node);
+#endif
+
+	return attach_header(base, length, AllocKind::MMAP);
+}
+#endif
+
+} // namespace
+
+
+void *page_alloc(size_t size, const PageAllocOptions &options)
+{
+	if (size > SIZE_MAX - HEADER_SIZE - HUGE_PAGE_SIZE * 2)
+		error::throw_<error::OutOfMemory>("allocation too large");
+
+	size_t length = size + HEADER_SIZE;
+
+	if (!options.transparent_huge_pages && !options.huge_pages && options.numa_node < 0) {
+		void *base = zimg_x_aligned_malloc(length, HEADER_SIZE);
+		if (!base)
+			error::throw_<error::OutOfMemory>();
+
+		return attach_header(base, length, AllocKind::MALLOC);
+	}
+
+#ifdef _WIN32
+	return page_alloc_win32(length, options);
+#else
+	return page_alloc_mmap(length, options);
+#endif
+}
+
+void page_free(void *ptr) noexcept
+{
+	if (!ptr)
+		return;
+
+	void *base = static_cast<unsigned char *>(ptr) - HEADER_SIZE;
+	AllocHeader header = *static_cast<AllocHeader *>(base);
+
+	switch (header.kind) {
+	case AllocKind::MALLOC:
+		zimg_x_aligned_free(base);
+		break;
+#ifdef _WIN32
+	case AllocKind::VIRTUAL_ALLOC:
+		::VirtualFree(base, 0, MEM_RELEASE);
+		break;
+#else
+	case AllocKind::MMAP:
+		::munmap(base, header.length);
+		break;
+#endif
+	default:
+		break;
+	}
+}
+
+} // namespace zimg
@@ -0,0 +1,41 @@
+#pragma once
+
+#ifndef ZIMG_PAGE_ALLOC_H_
+#define ZIMG_PAGE_ALLOC_H_
+
+#include <cstddef>
+
+namespace zimg {
+
+/**
+ * Options for page-granular allocation.
+ */
+struct PageAllocOptions {
+	bool transparent_huge_pages; /**< Advise the OS to back the buffer with huge pages. */
+	bool huge_pages;             /**< Allocate from the explicit 2 MB huge page pool. */
+	int numa_node;               /**< Preferred NUMA node, or negative for the default policy. */
+};
+
+/**
+ * Allocate a buffer directly from the OS.
+ *
+ * The buffer is aligned to at least 64 bytes. Options not supported by the
+ * platform are ignored, except for explicit huge pages.
+ *
+ * @param size buffer size in bytes
+ * @param options allocation options
+ * @return pointer to buffer
+ * @throw error::OutOfMemory if the allocation fails
+ */
+void *page_alloc(size_t size, const PageAllocOptions &options);
+
+/**
+ * Free a buffer returned by {@link page_alloc}.
+ *
+ * @param ptr pointer to buffer, may be null
+ */
+void page_free(void *ptr) noexcept;
+
+} // namespace zimg
+
+#endif // ZIMG_PAGE_ALLOC_H_
@@ -92,6 +92,22 @@ bool needs_dither_f16c_func_arm(CPUClass cpu)
 #endif
 }
 
+std::unique_ptr<graph::ImageFilter> create_error_diffusion_arm(unsigned width, unsigned height, const PixelFormat &pixel_in, const PixelFormat &pixel_out, CPUClass cpu)
+{
+	ARMCapabilities caps = query_arm_capabilities();
+	std::unique_ptr<graph::ImageFilter> ret;
+
+	if (cpu_is_autodetect(cpu)) {
+		if (!ret && caps.neon && caps.vfpv4)
+			ret = create_error_diffusion_neon(width, height, pixel_in, pixel_out);
+	} else {
+		if (!ret && cpu >= CPUClass::ARM_NEON)
+			ret = create_error_diffusion_neon(width, height, pixel_in, pixel_out);
+	}
+
+	return ret;
+}
+
 } // namespace depth
 } // namespace zimg
 
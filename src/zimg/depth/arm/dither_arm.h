@@ -40,6 +40,11 @@ dither_f16c_func select_dither_f16c_func_arm(CPUClass cpu);
 
 bool needs_dither_f16c_func_arm(CPUClass cpu);
 
+
+std::unique_ptr<graph::ImageFilter> create_error_diffusion_neon(unsigned width, unsigned height, const PixelFormat &pixel_in, const PixelFormat &pixel_out);
+
+std::unique_ptr<graph::ImageFilter> create_error_diffusion_arm(unsigned width, unsigned height, const PixelFormat &pixel_in, const PixelFormat &pixel_out, CPUClass cpu);
+
 } // namespace depth
 } // namespace zimg
 
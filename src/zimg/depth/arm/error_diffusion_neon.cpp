@@ -0,0 +1,547 @@
+#ifdef ZIMG_ARM
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <arm_neon.h>
+#include "common/align.h"
+#include "common/ccdep.h"
+#include "common/checked_int.h"
+#include "common/except.h"
+#include "common/make_unique.h"
+#include "common/pixel.h"
+#include "common/zassert.h"
+#include "depth/quantize.h"
+#include "graph/image_buffer.h"
+#include "graph/image_filter.h"
+#include "dither_arm.h"
+
+#include "common/arm/neon_util.h"
+
+#if defined(_M_ARM) || defined(__arm__)
+  #define vcvtnq_u32_f32_(x) vcvtq_u32_f32(vaddq_f32(x, vdupq_n_f32(0.49999997f)))
+#else
+  #define vcvtnq_u32_f32_ vcvtnq_u32_f32
+#endif
+
+namespace zimg {
+namespace depth {
+
+namespace {
+
+struct error_state {
+	float err_left[4];
+	float err_top_right[4];
+	float err_top[4];
+	float err_top_left[4];
+};
+
+
+template <PixelType SrcType>
+struct error_diffusion_traits;
+
+template <>
+struct error_diffusion_traits<PixelType::BYTE> {
+	typedef uint8_t type;
+
+	static float load1(const uint8_t *ptr) { return *ptr; }
+	static void store1(uint8_t *ptr, uint32_t x) { *ptr = static_cast<uint8_t>(x); }
+
+	static inline FORCE_INLINE void load8(const uint8_t *ptr, float32x4_t &lo, float32x4_t &hi)
+	{
+		uint16x8_t x = vmovl_u8(vld1_u8(ptr));
+		lo = vcvtq_f32_u32(vmovl_u16(vget_low_u16(x)));
+		hi = vcvtq_f32_u32(vmovl_high_u16(x));
+	}
+
+	static inline FORCE_INLINE void store8(uint8_t *ptr, uint32x4_t lo, uint32x4_t hi)
+	{
+		vst1_u8(ptr, vmovn_u16(vcombine_u16(vmovn_u32(lo), vmovn_u32(hi))));
+	}
+};
+
+template <>
+struct error_diffusion_traits<PixelType::WORD> {
+	typedef uint16_t type;
+
+	static float load1(const uint16_t *ptr) { return *ptr; }
+	static void store1(uint16_t *ptr, uint32_t x) { *ptr = static_cast<uint16_t>(x); }
+
+	static inline FORCE_INLINE void load8(const uint16_t *ptr, float32x4_t &lo, float32x4_t &hi)
+	{
+		uint16x8_t x = vld1q_u16(ptr);
+		lo = vcvtq_f32_u32(vmovl_u16(vget_low_u16(x)));
+		hi = vcvtq_f32_u32(vmovl_high_u16(x));
+	}
+
+	static inline FORCE_INLINE void store8(uint16_t *ptr, uint32x4_t lo, uint32x4_t hi)
+	{
+		vst1q_u16(ptr, vcombine_u16(vmovn_u32(lo), vmovn_u32(hi)));
+	}
+};
+
+#if !defined(_MSC_VER) || defined(_M_ARM64)
+template <>
+struct error_diffusion_traits<PixelType::HALF> {
+	typedef __fp16 type;
+
+	static float load1(const __fp16 *ptr)
+	{
+		uint16_t x = *reinterpret_cast<const uint16_t *>(ptr);
+		return vgetq_lane_f32(vcvt_f32_f16(vreinterpret_f16_u16(vdup_n_u16(x))), 0);
+	}
+
+	static inline FORCE_INLINE void load8(const __fp16 *ptr, float32x4_t &lo, float32x4_t &hi)
+	{
+		float16x8_t x = vld1q_f16(ptr);
+		lo = vcvt_f32_f16(vget_low_f16(x));
+		hi = vcvt_high_f32_f16(x);
+	}
+};
+#endif // !defined(_MSC_VER) || defined(_M_ARM64)
+
+template <>
+struct error_diffusion_traits<PixelType::FLOAT> {
+	typedef float type;
+
+	static float load1(const float *ptr) { return *ptr; }
+
+	static inline FORCE_INLINE void load8(const float *ptr, float32x4_t &lo, float32x4_t &hi)
+	{
+		lo = vld1q_f32(ptr);
+		hi = vld1q_f32(ptr + 4);
+	}
+};
+
+
+// Scalar operations are evaluated in vector registers to match the wavefront numerics.
+inline FORCE_INLINE float fma(float a, float b, float c)
+{
+	return vgetq_lane_f32(vfmaq_f32(vdupq_n_f32(c), vdupq_n_f32(a), vdupq_n_f32(b)), 0);
+}
+
+inline FORCE_INLINE uint32_t quantize(float x)
+{
+	return vgetq_lane_u32(vcvtnq_u32_f32_(vdupq_n_f32(x)), 0);
+}
+
+
+template <PixelType SrcType, PixelType DstType>
+void error_diffusion_scalar(const void *src, void *dst, const float * RESTRICT error_top, float * RESTRICT error_cur,
+                            float scale, float offset, unsigned bits, unsigned width)
+{
+	typedef error_diffusion_traits<SrcType> src_traits;
+	typedef error_diffusion_traits<DstType> dst_traits;
+
+	const typename src_traits::type *src_p = static_cast<const typename src_traits::type *>(src);
+	typename dst_traits::type *dst_p = static_cast<typename dst_traits::type *>(dst);
+
+	float err_left = error_cur[0];
+	float err_top_right;
+	float err_top = error_top[0 + 1];
+	float err_top_left = error_top[0];
+
+	for (unsigned j = 0; j < width; ++j) {
+		// Error array is padded by one on each side.
+		unsigned j_err = j + 1;
+		err_top_right = error_top[j_err + 1];
+
+		float x = fma(src_traits::load1(src_p + j), scale, offset);
+		float err, err0, err1;
+
+		err0 = err_left * (7.0f / 16.0f);
+		err0 = fma(err_top_right, 3.0f / 16.0f, err0);
+		err1 = err_top * (5.0f / 16.0f);
+		err1 = fma(err_top_left, 1.0f / 16.0f, err1);
+		err = err0 + err1;
+
+		x += err;
+		x = std::min(std::max(x, 0.0f), static_cast<float>(1L << bits) - 1);
+
+		uint32_t q = quantize(x);
+		err = x - static_cast<float>(q);
+
+		dst_traits::store1(dst_p + j, q);
+		error_cur[j_err] = err;
+
+		err_left = err;
+		err_top_left = err_top;
+		err_top = err_top_right;
+	}
+}
+
+decltype(&error_diffusion_scalar<PixelType::BYTE, PixelType::BYTE>) select_error_diffusion_scalar_func(PixelType pixel_in, PixelType pixel_out)
+{
+	if (pixel_in == PixelType::BYTE && pixel_out == PixelType::BYTE)
+		return error_diffusion_scalar<PixelType::BYTE, PixelType::BYTE>;
+	else if (pixel_in == PixelType::BYTE && pixel_out == PixelType::WORD)
+		return error_diffusion_scalar<PixelType::BYTE, PixelType::WORD>;
+	else if (pixel_in == PixelType::WORD && pixel_out == PixelType::BYTE)
+		return error_diffusion_scalar<PixelType::WORD, PixelType::BYTE>;
+	else if (pixel_in == PixelType::WORD && pixel_out == PixelType::WORD)
+		return error_diffusion_scalar<PixelType::WORD, PixelType::WORD>;
+#if !defined(_MSC_VER) || defined(_M_ARM64)
+	else if (pixel_in == PixelType::HALF && pixel_out == PixelType::BYTE)
+		return error_diffusion_scalar<PixelType::HALF, PixelType::BYTE>;
+	else if (pixel_in == PixelType::HALF && pixel_out == PixelType::WORD)
+		return error_diffusion_scalar<PixelType::HALF, PixelType::WORD>;
+#endif
+	else if (pixel_in == PixelType::FLOAT && pixel_out == PixelType::BYTE)
+		return error_diffusion_scalar<PixelType::FLOAT, PixelType::BYTE>;
+	else if (pixel_in == PixelType::FLOAT && pixel_out == PixelType::WORD)
+		return error_diffusion_scalar<PixelType::FLOAT, PixelType::WORD>;
+	else
+		error::throw_<error::InternalError>("no conversion between pixel types");
+}
+
+
+inline FORCE_INLINE void error_diffusion_wf_neon_xiter(float32x4_t &v, unsigned j, const float *error_top, float *error_cur, const float32x4_t &max_val,
+                                                       const float32x4_t &err_left_w, const float32x4_t &err_top_right_w, const float32x4_t &err_top_w, const float32x4_t &err_top_left_w,
+                                                       float32x4_t &err_left, float32x4_t &err_top_right, float32x4_t &err_top, float32x4_t &err_top_left)
+{
+	unsigned j_err = j + 1;
+
+	float32x4_t x, y, err0, err1, err_rot;
+	uint32x4_t q;
+
+	err0 = vmulq_f32(err_left_w, err_left);
+	err0 = vfmaq_f32(err0, err_top_right_w, err_top_right);
+	err1 = vmulq_f32(err_top_w, err_top);
+	err1 = vfmaq_f32(err1, err_top_left_w, err_top_left);
+	err0 = vaddq_f32(err0, err1);
+
+	x = vaddq_f32(v, err0);
+	x = vmaxq_f32(x, vdupq_n_f32(0.0f));
+	x = vminq_f32(x, max_val);
+	q = vcvtnq_u32_f32_(x);
+	v = vreinterpretq_f32_u32(q);
+
+	y = vcvtq_f32_u32(q);
+	err0 = vsubq_f32(x, y);
+
+	// Left-rotate err0 by 32 bits.
+	err_rot = vextq_f32(err0, err0, 3);
+
+	// Extract the previous high error.
+	error_cur[j_err + 0] = vgetq_lane_f32(err_rot, 0);
+
+	// Insert the next error into the low position.
+	err_rot = vsetq_lane_f32(error_top[j_err + 6 + 2], err_rot, 0);
+
+	err_left = err0;
+	err_top_left = err_top;
+	err_top = err_top_right;
+	err_top_right = err_rot;
+}
+
+template <PixelType SrcType, PixelType DstType, class T, class U>
+void error_diffusion_wf_neon(const graph::ImageBuffer<const T> &src, const graph::ImageBuffer<U> &dst, unsigned i,
+                             const float *error_top, float *error_cur, error_state *state, float scale, float offset, unsigned bits, unsigned width)
+{
+	typedef error_diffusion_traits<SrcType> src_traits;
+	typedef error_diffusion_traits<DstType> dst_traits;
+
+	typedef typename src_traits::type src_type;
+	typedef typename dst_traits::type dst_type;
+
+	static_assert(std::is_same<T, src_type>::value, "wrong type");
+	static_assert(std::is_same<U, dst_type>::value, "wrong type");
+
+	const float32x4_t err_left_w = vdupq_n_f32(7.0f / 16.0f);
+	const float32x4_t err_top_right_w = vdupq_n_f32(3.0f / 16.0f);
+	const float32x4_t err_top_w = vdupq_n_f32(5.0f / 16.0f);
+	const float32x4_t err_top_left_w = vdupq_n_f32(1.0f / 16.0f);
+
+	const float32x4_t scale_ps = vdupq_n_f32(scale);
+	const float32x4_t offset_ps = vdupq_n_f32(offset);
+
+	const float32x4_t max_val = vdupq_n_f32(static_cast<float>((1UL << bits) - 1));
+
+	float32x4_t err_left = vld1q_f32(state->err_left);
+	float32x4_t err_top_right = vld1q_f32(state->err_top_right);
+	float32x4_t err_top = vld1q_f32(state->err_top);
+	float32x4_t err_top_left = vld1q_f32(state->err_top_left);
+
+#define XITER error_diffusion_wf_neon_xiter
+#define XARGS error_top, error_cur, max_val, err_left_w, err_top_right_w, err_top_w, err_top_left_w, err_left, err_top_right, err_top, err_top_left
+	for (unsigned j = 0; j < width; j += 8) {
+		float32x4_t v0_lo, v0_hi, v1_lo, v1_hi, v2_lo, v2_hi, v3_lo, v3_hi;
+
+		src_traits::load8(src[i + 0] + j + 6, v0_lo, v0_hi);
+		src_traits::load8(src[i + 1] + j + 4, v1_lo, v1_hi);
+		src_traits::load8(src[i + 2] + j + 2, v2_lo, v2_hi);
+		src_traits::load8(src[i + 3] + j + 0, v3_lo, v3_hi);
+
+		v0_lo = vfmaq_f32(offset_ps, v0_lo, scale_ps);
+		v0_hi = vfmaq_f32(offset_ps, v0_hi, scale_ps);
+		v1_lo = vfmaq_f32(offset_ps, v1_lo, scale_ps);
+		v1_hi = vfmaq_f32(offset_ps, v1_hi, scale_ps);
+		v2_lo = vfmaq_f32(offset_ps, v2_lo, scale_ps);
+		v2_hi = vfmaq_f32(offset_ps, v2_hi, scale_ps);
+		v3_lo = vfmaq_f32(offset_ps, v3_lo, scale_ps);
+		v3_hi = vfmaq_f32(offset_ps, v3_hi, scale_ps);
+
+		neon_transpose4_f32(v0_lo, v1_lo, v2_lo, v3_lo);
+		neon_transpose4_f32(v0_hi, v1_hi, v2_hi, v3_hi);
+
+		XITER(v0_lo, j + 0, XARGS);
+		XITER(v1_lo, j + 1, XARGS);
+		XITER(v2_lo, j + 2, XARGS);
+		XITER(v3_lo, j + 3, XARGS);
+		XITER(v0_hi, j + 4, XARGS);
+		XITER(v1_hi, j + 5, XARGS);
+		XITER(v2_hi, j + 6, XARGS);
+		XITER(v3_hi, j + 7, XARGS);
+
+		neon_transpose4_f32(v0_lo, v1_lo, v2_lo, v3_lo);
+		neon_transpose4_f32(v0_hi, v1_hi, v2_hi, v3_hi);
+
+		dst_traits::store8(dst[i + 0] + j + 6, vreinterpretq_u32_f32(v0_lo), vreinterpretq_u32_f32(v0_hi));
+		dst_traits::store8(dst[i + 1] + j + 4, vreinterpretq_u32_f32(v1_lo), vreinterpretq_u32_f32(v1_hi));
+		dst_traits::store8(dst[i + 2] + j + 2, vreinterpretq_u32_f32(v2_lo), vreinterpretq_u32_f32(v2_hi));
+		dst_traits::store8(dst[i + 3] + j + 0, vreinterpretq_u32_f32(v3_lo), vreinterpretq_u32_f32(v3_hi));
+	}
+#undef XITER
+#undef XARGS
+
+	vst1q_f32(state->err_left, err_left);
+	vst1q_f32(state->err_top_right, err_top_right);
+	vst1q_f32(state->err_top, err_top);
+	vst1q_f32(state->err_top_left, err_top_left);
+}
+
+template <PixelType SrcType, PixelType DstType>
+void error_diffusion_neon(const graph::ImageBuffer<const void> &src, const graph::ImageBuffer<void> &dst, unsigned i,
+                          const float *error_top, float *error_cur, float scale, float offset, unsigned bits, unsigned width)
+{
+	typedef error_diffusion_traits<SrcType> src_traits;
+	typedef error_diffusion_traits<DstType> dst_traits;
+
+	typedef typename src_traits::type src_type;
+	typedef typename dst_traits::type dst_type;
+
+	const graph::ImageBuffer<const src_type> &src_buf = graph::static_buffer_cast<const src_type>(src);
+	const graph::ImageBuffer<dst_type> &dst_buf = graph::static_buffer_cast<dst_type>(dst);
+
+	error_state state alignas(16) = {};
+	float error_tmp[3][16] = {};
+
+	// Prologue.
+	error_diffusion_scalar<SrcType, DstType>(src_buf[i + 0], dst_buf[i + 0], error_top, error_tmp[0], scale, offset, bits, 6);
+	error_diffusion_scalar<SrcType, DstType>(src_buf[i + 1], dst_buf[i + 1], error_tmp[0], error_tmp[1], scale, offset, bits, 4);
+	error_diffusion_scalar<SrcType, DstType>(src_buf[i + 2], dst_buf[i + 2], error_tmp[1], error_tmp[2], scale, offset, bits, 2);
+
+	// Wavefront.
+	state.err_left[0] = error_tmp[0][5 + 1];
+	state.err_left[1] = error_tmp[1][3 + 1];
+	state.err_left[2] = error_tmp[2][1 + 1];
+	state.err_left[3] = 0.0f;
+
+	state.err_top_right[0] = error_top[7 + 1];
+	state.err_top_right[1] = error_tmp[0][5 + 1];
+	state.err_top_right[2] = error_tmp[1][3 + 1];
+	state.err_top_right[3] = error_tmp[2][1 + 1];
+
+	state.err_top[0] = error_top[6 + 1];
+	state.err_top[1] = error_tmp[0][4 + 1];
+	state.err_top[2] = error_tmp[1][2 + 1];
+	state.err_top[3] = error_tmp[2][0 + 1];
+
+	state.err_top_left[0] = error_top[5 + 1];
+	state.err_top_left[1] = error_tmp[0][3 + 1];
+	state.err_top_left[2] = error_tmp[1][1 + 1];
+	state.err_top_left[3] = 0.0f;
+
+	unsigned vec_count = floor_n(width - 6, 8);
+	error_diffusion_wf_neon<SrcType, DstType>(src_buf, dst_buf, i, error_top, error_cur, &state, scale, offset, bits, vec_count);
+
+	error_tmp[0][5 + 1] = state.err_top_right[1];
+	error_tmp[0][4 + 1] = state.err_top[1];
+	error_tmp[0][3 + 1] = state.err_top_left[1];
+
+	error_tmp[1][3 + 1] = state.err_top_right[2];
+	error_tmp[1][2 + 1] = state.err_top[2];
+	error_tmp[1][1 + 1] = state.err_top_left[2];
+
+	error_tmp[2][1 + 1] = state.err_top_right[3];
+	error_tmp[2][0 + 1] = state.err_top[3];
+	error_tmp[2][0] = state.err_top_left[3];
+
+	// Epilogue.
+	error_diffusion_scalar<SrcType, DstType>(src_buf[i + 0] + vec_count + 6, dst_buf[i + 0] + vec_count + 6, error_top + vec_count + 6, error_tmp[0] + 6,
+	                                         scale, offset, bits, width - vec_count - 6);
+	error_diffusion_scalar<SrcType, DstType>(src_buf[i + 1] + vec_count + 4, dst_buf[i + 1] + vec_count + 4, error_tmp[0] + 4, error_tmp[1] + 4,
+	                                         scale, offset, bits, width - vec_count - 4);
+	error_diffusion_scalar<SrcType, DstType>(src_buf[i + 2] + vec_count + 2, dst_buf[i + 2] + vec_count + 2, error_tmp[1] + 2, error_tmp[2] + 2,
+	                                         scale, offset, bits, width - vec_count - 2);
+	error_diffusion_scalar<SrcType, DstType>(src_buf[i + 3] + vec_count + 0, dst_buf[i + 3] + vec_count + 0, error_tmp[2] + 0, error_cur + vec_count + 0,
+	                                         scale, offset, bits, width - vec_count - 0);
+}
+
+decltype(&error_diffusion_neon<PixelType::BYTE, PixelType::BYTE>) select_error_diffusion_neon_func(PixelType pixel_in, PixelType pixel_out)
+{
+	if (pixel_in == PixelType::BYTE && pixel_out == PixelType::BYTE)
+		return error_diffusion_neon<PixelType::BYTE, PixelType::BYTE>;
+	else if (pixel_in == PixelType::BYTE && pixel_out == PixelType::WORD)
+		return error_diffusion_neon<PixelType::BYTE, PixelType::WORD>;
+	else if (pixel_in == PixelType::WORD && pixel_out == PixelType::BYTE)
+		return error_diffusion_neon<PixelType::WORD, PixelType::BYTE>;
+	else if (pixel_in == PixelType::WORD && pixel_out == PixelType::WORD)
+		return error_diffusion_neon<PixelType::WORD, PixelType::WORD>;
+#if !defined(_MSC_VER) || defined(_M_ARM64)
+	else if (pixel_in == PixelType::HALF && pixel_out == PixelType::BYTE)
+		return error_diffusion_neon<PixelType::HALF, PixelType::BYTE>;
+	else if (pixel_in == PixelType::HALF && pixel_out == PixelType::WORD)
+		return error_diffusion_neon<PixelType::HALF, PixelType::WORD>;
+#endif
+	else if (pixel_in == PixelType::FLOAT && pixel_out == PixelType::BYTE)
+		return error_diffusion_neon<PixelType::FLOAT, PixelType::BYTE>;
+	else if (pixel_in == PixelType::FLOAT && pixel_out == PixelType::WORD)
+		return error_diffusion_neon<PixelType::FLOAT, PixelType::WORD>;
+	else
+		error::throw_<error::InternalError>("no conversion between pixel types");
+}
+
+
+class ErrorDiffusionNeon final : public graph::ImageFilter {
+	decltype(&error_diffusion_scalar<PixelType::BYTE, PixelType::BYTE>) m_scalar_func;
+	decltype(&error_diffusion_neon<PixelType::BYTE, PixelType::BYTE>) m_neon_func;
+
+	PixelType m_pixel_in;
+	PixelType m_pixel_out;
+
+	float m_scale;
+	float m_offset;
+	unsigned m_depth;
+
+	unsigned m_width;
+	unsigned m_height;
+
+	void process_scalar(void *ctx, const void *src, void *dst, bool parity) const
+	{
+		float *ctx_a = reinterpret_cast<float *>(ctx);
+		float *ctx_b = reinterpret_cast<float *>(static_cast<unsigned char *>(ctx) + get_context_size() / 2);
+
+		float *error_top = parity ? ctx_a : ctx_b;
+		float *error_cur = parity ? ctx_b : ctx_a;
+
+		m_scalar_func(src, dst, error_top, error_cur, m_scale, m_offset, m_depth, m_width);
+	}
+
+	void process_vector(void *ctx, const graph::ImageBuffer<const void> &src, const graph::ImageBuffer<void> &dst, unsigned i) const
+	{
+		float *ctx_a = reinterpret_cast<float *>(ctx);
+		float *ctx_b = reinterpret_cast<float *>(static_cast<unsigned char *>(ctx) + get_context_size() / 2);
+
+		float *error_top = (i / 4) % 2 ? ctx_a : ctx_b;
+		float *error_cur = (i / 4) % 2 ? ctx_b : ctx_a;
+
+		m_neon_func(src, dst, i, error_top, error_cur, m_scale, m_offset, m_depth, m_width);
+	}
+public:
+	ErrorDiffusionNeon(unsigned width, unsigned height, const PixelFormat &format_in, const PixelFormat &format_out) :
+		m_scalar_func{ select_error_diffusion_scalar_func(format_in.type, format_out.type) },
+		m_neon_func{ select_error_diffusion_neon_func(format_in.type, format_out.type) },
+		m_pixel_in{ format_in.type },
+		m_pixel_out{ format_out.type },
+		m_scale{},
+		m_offset{},
+		m_depth{ format_out.depth },
+		m_width{ width },
+		m_height{ height }
+	{
+		zassert_d(width <= pixel_max_width(format_in.type), "overflow");
+		zassert_d(width <= pixel_max_width(format_out.type), "overflow");
+
+		if (!pixel_is_integer(format_out.type))
+			error::throw_<error::InternalError>("cannot dither to non-integer format");
+
+		std::tie(m_scale, m_offset) = get_scale_offset(format_in, format_out);
+	}
+
+	filter_flags get_flags() const override
+	{
+		filter_flags flags{};
+
+		flags.has_state = true;
+		flags.same_row = true;
+		flags.in_place = pixel_size(m_pixel_in) == pixel_size(m_pixel_out);
+		flags.entire_row = true;
+
+		return flags;
+	}
+
+	image_attributes get_image_attributes() const override
+	{
+		return{ m_width, m_height, m_pixel_out };
+	}
+
+	pair_unsigned get_required_row_range(unsigned i) const override
+	{
+		unsigned last = std::min(i, UINT_MAX - 4) + 4;
+		return{ i, std::min(last, m_height) };
+	}
+
+	pair_unsigned get_required_col_range(unsigned, unsigned) const override
+	{
+		return{ 0, get_image_attributes().width };
+	}
+
+	unsigned get_simultaneous_lines() const override { return 4; }
+
+	unsigned get_max_buffering() const override { return 4; }
+
+	size_t get_context_size() const override
+	{
+		try {
+			checked_size_t size = (static_cast<checked_size_t>(m_width) + 2) * sizeof(float) * 2;
+			return size.get();
+		} catch (const std::overflow_error &) {
+			error::throw_<error::OutOfMemory>();
+		}
+	}
+
+	size_t get_tmp_size(unsigned, unsigned) const override { return 0; }
+
+	void init_context(void *ctx, unsigned seq) const override
+	{
+		std::fill_n(static_cast<unsigned char *>(ctx), get_context_size(), 0);
+	}
+
+	void process(void *ctx, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *, unsigned i, unsigned, unsigned) const override
+	{
+		if (m_height - i < 4) {
+			bool parity = !!((i / 4) % 2);
+
+			for (unsigned ii = i; ii < m_height; ++ii) {
+				process_scalar(ctx, (*src)[ii], (*dst)[ii], parity);
+				parity = !parity;
+			}
+		} else {
+			process_vector(ctx, *src, *dst, i);
+		}
+	}
+};
+
+} // namespace
+
+
+std::unique_ptr<graph::ImageFilter> create_error_diffusion_neon(unsigned width, unsigned height, const PixelFormat &pixel_in, const PixelFormat &pixel_out)
+{
+#if defined(_MSC_VER) && !defined(_M_ARM64)
+	if (pixel_in.type == PixelType::HALF)
+		return nullptr;
+#endif
+	if (width < 6)
+		return nullptr;
+
+	return ztd::make_unique<ErrorDiffusionNeon>(width, height, pixel_in, pixel_out);
+}
+
+} // namespace depth
+} // namespace zimg
+
+#endif // ZIMG_ARM
@@ -146,11 +146,19 @@ std::unique_ptr<graph::ImageFilter> create_error_diffusion_x86(unsigned width, u
 	std::unique_ptr<graph::ImageFilter> ret;
 
 	if (cpu_is_autodetect(cpu)) {
+#ifdef ZIMG_X86_AVX512
+		if (!ret && cpu == CPUClass::AUTO_64B && caps.avx512f && caps.avx512bw && caps.avx512vl)
+			ret = create_error_diffusion_avx512(width, height, pixel_in, pixel_out);
+#endif
 		if (!ret && caps.avx2 && caps.f16c && caps.fma)
 			ret = create_error_diffusion_avx2(width, height, pixel_in, pixel_out);
 		if (!ret && caps.sse2)
 			ret = create_error_diffusion_sse2(width, height, pixel_in, pixel_out, cpu);
 	} else {
+#ifdef ZIMG_X86_AVX512
+		if (!ret && cpu >= CPUClass::X86_AVX512)
+			ret = create_error_diffusion_avx512(width, height, pixel_in, pixel_out);
+#endif
 		if (!ret && cpu >= CPUClass::X86_AVX2)
 			ret = create_error_diffusion_avx2(width, height, pixel_in, pixel_out);
 		if (!ret && cpu >= CPUClass::X86_SSE2)
@@ -59,6 +59,7 @@ bool needs_dither_f16c_func_x86(CPUClass cpu);
 
 std::unique_ptr<graph::ImageFilter> create_error_diffusion_sse2(unsigned width, unsigned height, const PixelFormat &pixel_in, const PixelFormat &pixel_out, CPUClass cpu);
 std::unique_ptr<graph::ImageFilter> create_error_diffusion_avx2(unsigned width, unsigned height, const PixelFormat &pixel_in, const PixelFormat &pixel_out);
+std::unique_ptr<graph::ImageFilter> create_error_diffusion_avx512(unsigned width, unsigned height, const PixelFormat &pixel_in, const PixelFormat &pixel_out);
 
 std::unique_ptr<graph::ImageFilter> create_error_diffusion_x86(unsigned width, unsigned height, const PixelFormat &pixel_in, const PixelFormat &pixel_out, CPUClass cpu);
 
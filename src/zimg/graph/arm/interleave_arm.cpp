@@ -0,0 +1,91 @@
+#ifdef ZIMG_ARM
+
+#include "common/cpuinfo.h"
+#include "common/pixel.h"
+#include "common/arm/cpuinfo_arm.h"
+#include "interleave_arm.h"
+
+namespace zimg {
+namespace graph {
+
+namespace {
+
+deinterleave_func select_deinterleave_func_neon(PixelType type, unsigned num_components)
+{
+	if (pixel_size(type) == 1 && num_components == 2)
+		return deinterleave_b2_neon;
+	else if (pixel_size(type) == 1 && num_components == 3)
+		return deinterleave_b3_neon;
+	else if (pixel_size(type) == 1 && num_components == 4)
+		return deinterleave_b4_neon;
+	else if (pixel_size(type) == 2 && num_components == 1)
+		return deinterleave_w1_neon;
+	else if (pixel_size(type) == 2 && num_components == 2)
+		return deinterleave_w2_neon;
+	else if (pixel_size(type) == 2 && num_components == 3)
+		return deinterleave_w3_neon;
+	else if (pixel_size(type) == 2 && num_components == 4)
+		return deinterleave_w4_neon;
+	else
+		return nullptr;
+}
+
+interleave_func select_interleave_func_neon(PixelType type, unsigned num_components)
+{
+	if (pixel_size(type) == 1 && num_components == 2)
+		return interleave_b2_neon;
+	else if (pixel_size(type) == 1 && num_components == 3)
+		return interleave_b3_neon;
+	else if (pixel_size(type) == 1 && num_components == 4)
+		return interleave_b4_neon;
+	else if (pixel_size(type) == 2 && num_components == 1)
+		return interleave_w1_neon;
+	else if (pixel_size(type) == 2 && num_components == 2)
+		return interleave_w2_neon;
+	else if (pixel_size(type) == 2 && num_components == 3)
+		return interleave_w3_neon;
+	else if (pixel_size(type) == 2 && num_components == 4)
+		return interleave_w4_neon;
+	else
+		return nullptr;
+}
+
+} // namespace
+
+
+deinterleave_func select_deinterleave_func_arm(PixelType type, unsigned num_components, CPUClass cpu)
+{
+	ARMCapabilities caps = query_arm_capabilities();
+	deinterleave_func func = nullptr;
+
+	if (cpu_is_autodetect(cpu)) {
+		if (!func && caps.neon)
+			func = select_deinterleave_func_neon(type, num_components);
+	} else {
+		if (!func && cpu >= CPUClass::ARM_NEON)
+			func = select_deinterleave_func_neon(type, num_components);
+	}
+
+	return func;
+}
+
+interleave_func select_interleave_func_arm(PixelType type, unsigned num_components, CPUClass cpu)
+{
+	ARMCapabilities caps = query_arm_capabilities();
+	interleave_func func = nullptr;
+
+	if (cpu_is_autodetect(cpu)) {
+		if (!func && caps.neon)
+			func = select_interleave_func_neon(type, num_components);
+	} else {
+		if (!func && cpu >= CPUClass::ARM_NEON)
+			func = select_interleave_func_neon(type, num_components);
+	}
+
+	return func;
+}
+
+} // namespace graph
+} // namespace zimg
+
+#endif // ZIMG_ARM
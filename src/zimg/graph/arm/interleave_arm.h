@@ -0,0 +1,47 @@
+#pragma once
+
+#ifdef ZIMG_ARM
+
+#ifndef ZIMG_GRAPH_ARM_INTERLEAVE_ARM_H_
+#define ZIMG_GRAPH_ARM_INTERLEAVE_ARM_H_
+
+#include "graph/interleave.h"
+
+namespace zimg {
+namespace graph {
+
+#define DECLARE_DEINTERLEAVE(x, cpu) \
+void deinterleave_##x##_##cpu(const void *src, void * const dst[], unsigned shift, unsigned left, unsigned right)
+
+#define DECLARE_INTERLEAVE(x, cpu) \
+void interleave_##x##_##cpu(const void * const src[], void *dst, unsigned shift, unsigned left, unsigned right)
+
+DECLARE_DEINTERLEAVE(b2, neon);
+DECLARE_DEINTERLEAVE(b3, neon);
+DECLARE_DEINTERLEAVE(b4, neon);
+DECLARE_DEINTERLEAVE(w1, neon);
+DECLARE_DEINTERLEAVE(w2, neon);
+DECLARE_DEINTERLEAVE(w3, neon);
+DECLARE_DEINTERLEAVE(w4, neon);
+
+DECLARE_INTERLEAVE(b2, neon);
+DECLARE_INTERLEAVE(b3, neon);
+DECLARE_INTERLEAVE(b4, neon);
+DECLARE_INTERLEAVE(w1, neon);
+DECLARE_INTERLEAVE(w2, neon);
+DECLARE_INTERLEAVE(w3, neon);
+DECLARE_INTERLEAVE(w4, neon);
+
+#undef DECLARE_DEINTERLEAVE
+#undef DECLARE_INTERLEAVE
+
+deinterleave_func select_deinterleave_func_arm(PixelType type, unsigned num_components, CPUClass cpu);
+
+interleave_func select_interleave_func_arm(PixelType type, unsigned num_components, CPUClass cpu);
+
+} // namespace graph
+} // namespace zimg
+
+#endif // ZIMG_GRAPH_ARM_INTERLEAVE_ARM_H_
+
+#endif // ZIMG_ARM
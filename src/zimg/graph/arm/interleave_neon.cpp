@@ -0,0 +1,259 @@
+#ifdef ZIMG_ARM
+
+#include <cstdint>
+#include <arm_neon.h>
+#include "interleave_arm.h"
+
+namespace zimg {
+namespace graph {
+
+namespace {
+
+// Interleaved data has no alignment relative to the planar rows, so pixels
+// are processed from the left edge. Pixels past the last full vector are
+// handled in C.
+template <class T, unsigned N>
+void deinterleave_tail(const T *src, T * const dst[], unsigned shift, unsigned left, unsigned right)
+{
+	for (unsigned j = left; j < right; ++j) {
+		for (unsigned k = 0; k < N; ++k) {
+			dst[k][j] = static_cast<T>(src[j * N + k] >> shift);
+		}
+	}
+}
+
+template <class T, unsigned N>
+void interleave_tail(const T * const src[], T *dst, unsigned shift, unsigned left, unsigned right)
+{
+	for (unsigned j = left; j < right; ++j) {
+		for (unsigned k = 0; k < N; ++k) {
+			dst[j * N + k] = static_cast<T>(src[k][j] << shift);
+		}
+	}
+}
+
+} // namespace
+
+
+void deinterleave_b2_neon(const void *src, void * const dst[], unsigned, unsigned left, unsigned right)
+{
+	const uint8_t *src_p = static_cast<const uint8_t *>(src);
+	uint8_t * const dst_p[2] = { static_cast<uint8_t *>(dst[0]), static_cast<uint8_t *>(dst[1]) };
+	unsigned j;
+
+	for (j = left; j + 16 <= right; j += 16) {
+		uint8x16x2_t x = vld2q_u8(src_p + j * 2);
+		vst1q_u8(dst_p[0] + j, x.val[0]);
+		vst1q_u8(dst_p[1] + j, x.val[1]);
+	}
+	deinterleave_tail<uint8_t, 2>(src_p, dst_p, 0, j, right);
+}
+
+void deinterleave_b3_neon(const void *src, void * const dst[], unsigned, unsigned left, unsigned right)
+{
+	const uint8_t *src_p = static_cast<const uint8_t *>(src);
+	uint8_t * const dst_p[3] = { static_cast<uint8_t *>(dst[0]), static_cast<uint8_t *>(dst[1]), static_cast<uint8_t *>(dst[2]) };
+	unsigned j;
+
+	for (j = left; j + 16 <= right; j += 16) {
+		uint8x16x3_t x = vld3q_u8(src_p + j * 3);
+		vst1q_u8(dst_p[0] + j, x.val[0]);
+		vst1q_u8(dst_p[1] + j, x.val[1]);
+		vst1q_u8(dst_p[2] + j, x.val[2]);
+	}
+	deinterleave_tail<uint8_t, 3>(src_p, dst_p, 0, j, right);
+}
+
+void deinterleave_b4_neon(const void *src, void * const dst[], unsigned, unsigned left, unsigned right)
+{
+	const uint8_t *src_p = static_cast<const uint8_t *>(src);
+	uint8_t * const dst_p[4] = { static_cast<uint8_t *>(dst[0]), static_cast<uint8_t *>(dst[1]), static_cast<uint8_t *>(dst[2]), static_cast<uint8_t *>(dst[3]) };
+	unsigned j;
+
+	for (j = left; j + 16 <= right; j += 16) {
+		uint8x16x4_t x = vld4q_u8(src_p + j * 4);
+		vst1q_u8(dst_p[0] + j, x.val[0]);
+		vst1q_u8(dst_p[1] + j, x.val[1]);
+		vst1q_u8(dst_p[2] + j, x.val[2]);
+		vst1q_u8(dst_p[3] + j, x.val[3]);
+	}
+	deinterleave_tail<uint8_t, 4>(src_p, dst_p, 0, j, right);
+}
+
+void deinterleave_w1_neon(const void *src, void * const dst[], unsigned shift, unsigned left, unsigned right)
+{
+	const uint16_t *src_p = static_cast<const uint16_t *>(src);
+	uint16_t * const dst_p[1] = { static_cast<uint16_t *>(dst[0]) };
+	const int16x8_t count = vdupq_n_s16(-static_cast<int16_t>(shift));
+	unsigned j;
+
+	for (j = left; j + 8 <= right; j += 8) {
+		vst1q_u16(dst_p[0] + j, vshlq_u16(vld1q_u16(src_p + j), count));
+	}
+	deinterleave_tail<uint16_t, 1>(src_p, dst_p, shift, j, right);
+}
+
+void deinterleave_w2_neon(const void *src, void * const dst[], unsigned shift, unsigned left, unsigned right)
+{
+	const uint16_t *src_p = static_cast<const uint16_t *>(src);
+	uint16_t * const dst_p[2] = { static_cast<uint16_t *>(dst[0]), static_cast<uint16_t *>(dst[1]) };
+	const int16x8_t count = vdupq_n_s16(-static_cast<int16_t>(shift));
+	unsigned j;
+
+	for (j = left; j + 8 <= right; j += 8) {
+		uint16x8x2_t x = vld2q_u16(src_p + j * 2);
+		vst1q_u16(dst_p[0] + j, vshlq_u16(x.val[0], count));
+		vst1q_u16(dst_p[1] + j, vshlq_u16(x.val[1], count));
+	}
+	deinterleave_tail<uint16_t, 2>(src_p, dst_p, shift, j, right);
+}
+
+void deinterleave_w3_neon(const void *src, void * const dst[], unsigned shift, unsigned left, unsigned right)
+{
+	const uint16_t *src_p = static_cast<const uint16_t *>(src);
+	uint16_t * const dst_p[3] = { static_cast<uint16_t *>(dst[0]), static_cast<uint16_t *>(dst[1]), static_cast<uint16_t *>(dst[2]) };
+	const int16x8_t count = vdupq_n_s16(-static_cast<int16_t>(shift));
+	unsigned j;
+
+	for (j = left; j + 8 <= right; j += 8) {
+		uint16x8x3_t x = vld3q_u16(src_p + j * 3);
+		vst1q_u16(dst_p[0] + j, vshlq_u16(x.val[0], count));
+		vst1q_u16(dst_p[1] + j, vshlq_u16(x.val[1], count));
+		vst1q_u16(dst_p[2] + j, vshlq_u16(x.val[2], count));
+	}
+	deinterleave_tail<uint16_t, 3>(src_p, dst_p, shift, j, right);
+}
+
+void deinterleave_w4_neon(const void *src, void * const dst[], unsigned shift, unsigned left, unsigned right)
+{
+	const uint16_t *src_p = static_cast<const uint16_t *>(src);
+	uint16_t * const dst_p[4] = { static_cast<uint16_t *>(dst[0]), static_cast<uint16_t *>(dst[1]), static_cast<uint16_t *>(dst[2]), static_cast<uint16_t *>(dst[3]) };
+	const int16x8_t count = vdupq_n_s16(-static_cast<int16_t>(shift));
+	unsigned j;
+
+	for (j = left; j + 8 <= right; j += 8) {
+		uint16x8x4_t x = vld4q_u16(src_p + j * 4);
+		vst1q_u16(dst_p[0] + j, vshlq_u16(x.val[0], count));
+		vst1q_u16(dst_p[1] + j, vshlq_u16(x.val[1], count));
+		vst1q_u16(dst_p[2] + j, vshlq_u16(x.val[2], count));
+		vst1q_u16(dst_p[3] + j, vshlq_u16(x.val[3], count));
+	}
+	deinterleave_tail<uint16_t, 4>(src_p, dst_p, shift, j, right);
+}
+
+void interleave_b2_neon(const void * const src[], void *dst, unsigned, unsigned left, unsigned right)
+{
+	const uint8_t * const src_p[2] = { static_cast<const uint8_t *>(src[0]), static_cast<const uint8_t *>(src[1]) };
+	uint8_t *dst_p = static_cast<uint8_t *>(dst);
+	unsigned j;
+
+	for (j = left; j + 16 <= right; j += 16) {
+		uint8x16x2_t x;
+		x.val[0] = vld1q_u8(src_p[0] + j);
+		x.val[1] = vld1q_u8(src_p[1] + j);
+		vst2q_u8(dst_p + j * 2, x);
+	}
+	interleave_tail<uint8_t, 2>(src_p, dst_p, 0, j, right);
+}
+
+void interleave_b3_neon(const void * const src[], void *dst, unsigned, unsigned left, unsigned right)
+{
+	const uint8_t * const src_p[3] = { static_cast<const uint8_t *>(src[0]), static_cast<const uint8_t *>(src[1]), static_cast<const uint8_t *>(src[2]) };
+	uint8_t *dst_p = static_cast<uint8_t *>(dst);
+	unsigned j;
+
+	for (j = left; j + 16 <= right; j += 16) {
+		uint8x16x3_t x;
+		x.val[0] = vld1q_u8(src_p[0] + j);
+		x.val[1] = vld1q_u8(src_p[1] + j);
+		x.val[2] = vld1q_u8(src_p[2] + j);
+		vst3q_u8(dst_p + j * 3, x);
+	}
+	interleave_tail<uint8_t, 3>(src_p, dst_p, 0, j, right);
+}
+
+void interleave_b4_neon(const void * const src[], void *dst, unsigned, unsigned left, unsigned right)
+{
+	const uint8_t * const src_p[4] = { static_cast<const uint8_t *>(src[0]), static_cast<const uint8_t *>(src[1]), static_cast<const uint8_t *>(src[2]), static_cast<const uint8_t *>(src[3]) };
+	uint8_t *dst_p = static_cast<uint8_t *>(dst);
+	unsigned j;
+
+	for (j = left; j + 16 <= right; j += 16) {
+		uint8x16x4_t x;
+		x.val[0] = vld1q_u8(src_p[0] + j);
+		x.val[1] = vld1q_u8(src_p[1] + j);
+		x.val[2] = vld1q_u8(src_p[2] + j);
+		x.val[3] = vld1q_u8(src_p[3] + j);
+		vst4q_u8(dst_p + j * 4, x);
+	}
+	interleave_tail<uint8_t, 4>(src_p, dst_p, 0, j, right);
+}
+
+void interleave_w1_neon(const void * const src[], void *dst, unsigned shift, unsigned left, unsigned right)
+{
+	const uint16_t * const src_p[1] = { static_cast<const uint16_t *>(src[0]) };
+	uint16_t *dst_p = static_cast<uint16_t *>(dst);
+	const int16x8_t count = vdupq_n_s16(static_cast<int16_t>(shift));
+	unsigned j;
+
+	for (j = left; j + 8 <= right; j += 8) {
+		vst1q_u16(dst_p + j, vshlq_u16(vld1q_u16(src_p[0] + j), count));
+	}
+	interleave_tail<uint16_t, 1>(src_p, dst_p, shift, j, right);
+}
+
+void interleave_w2_neon(const void * const src[], void *dst, unsigned shift, unsigned left, unsigned right)
+{
+	const uint16_t * const src_p[2] = { static_cast<const uint16_t *>(src[0]), static_cast<const uint16_t *>(src[1]) };
+	uint16_t *dst_p = static_cast<uint16_t *>(dst);
+	const int16x8_t count = vdupq_n_s16(static_cast<int16_t>(shift));
+	unsigned j;
+
+	for (j = left; j + 8 <= right; j += 8) {
+		uint16x8x2_t x;
+		x.val[0] = vshlq_u16(vld1q_u16(src_p[0] + j), count);
+		x.val[1] = vshlq_u16(vld1q_u16(src_p[1] + j), count);
+		vst2q_u16(dst_p + j * 2, x);
+	}
+	interleave_tail<uint16_t, 2>(src_p, dst_p, shift, j, right);
+}
+
+void interleave_w3_neon(const void * const src[], void *dst, unsigned shift, unsigned left, unsigned right)
+{
+	const uint16_t * const src_p[3] = { static_cast<const uint16_t *>(src[0]), static_cast<const uint16_t *>(src[1]), static_cast<const uint16_t *>(src[2]) };
+	uint16_t *dst_p = static_cast<uint16_t *>(dst);
+	const int16x8_t count = vdupq_n_s16(static_cast<int16_t>(shift));
+	unsigned j;
+
+	for (j = left; j + 8 <= right; j += 8) {
+		uint16x8x3_t x;
+		x.val[0] = vshlq_u16(vld1q_u16(src_p[0] + j), count);
+		x.val[1] = vshlq_u16(vld1q_u16(src_p[1] + j), count);
+		x.val[2] = vshlq_u16(vld1q_u16(src_p[2] + j), count);
+		vst3q_u16(dst_p + j * 3, x);
+	}
+	interleave_tail<uint16_t, 3>(src_p, dst_p, shift, j, right);
+}
+
+void interleave_w4_neon(const void * const src[], void *dst, unsigned shift, unsigned left, unsigned right)
+{
+	const uint16_t * const src_p[4] = { static_cast<const uint16_t *>(src[0]), static_cast<const uint16_t *>(src[1]), static_cast<const uint16_t *>(src[2]), static_cast<const uint16_t *>(src[3]) };
+	uint16_t *dst_p = static_cast<uint16_t *>(dst);
+	const int16x8_t count = vdupq_n_s16(static_cast<int16_t>(shift));
+	unsigned j;
+
+	for (j = left; j + 8 <= right; j += 8) {
+		uint16x8x4_t x;
+		x.val[0] = vshlq_u16(vld1q_u16(src_p[0] + j), count);
+		x.val[1] = vshlq_u16(vld1q_u16(src_p[1] + j), count);
+		x.val[2] = vshlq_u16(vld1q_u16(src_p[2] + j), count);
+		x.val[3] = vshlq_u16(vld1q_u16(src_p[3] + j), count);
+		vst4q_u16(dst_p + j * 4, x);
+	}
+	interleave_tail<uint16_t, 4>(src_p, dst_p, shift, j, right);
+}
+
+} // namespace graph
+} // namespace zimg
+
+#endif // ZIMG_ARM
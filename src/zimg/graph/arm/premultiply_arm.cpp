@@ -0,0 +1,49 @@
+#ifdef ZIMG_ARM
+
+#include "common/cpuinfo.h"
+#include "common/arm/cpuinfo_arm.h"
+#include "premultiply_arm.h"
+
+namespace zimg {
+namespace graph {
+
+premultiply_func select_premultiply_func_arm(CPUClass cpu)
+{
+	ARMCapabilities caps = query_arm_capabilities();
+	premultiply_func func = nullptr;
+
+	if (cpu_is_autodetect(cpu)) {
+		if (!func && caps.neon)
+			func = premultiply_neon;
+	} else {
+		if (!func && cpu >= CPUClass::ARM_NEON)
+			func = premultiply_neon;
+	}
+
+	return func;
+}
+
+premultiply_func select_unpremultiply_func_arm(CPUClass cpu)
+{
+	premultiply_func func = nullptr;
+
+	// AArch32 NEON has no vector division.
+#if defined(_M_ARM64) || defined(__aarch64__)
+	ARMCapabilities caps = query_arm_capabilities();
+
+	if (cpu_is_autodetect(cpu)) {
+		if (!func && caps.neon)
+			func = unpremultiply_neon;
+	} else {
+		if (!func && cpu >= CPUClass::ARM_NEON)
+			func = unpremultiply_neon;
+	}
+#endif
+
+	return func;
+}
+
+} // namespace graph
+} // namespace zimg
+
+#endif // ZIMG_ARM
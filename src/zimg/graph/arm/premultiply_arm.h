@@ -0,0 +1,32 @@
+#pragma once
+
+#ifdef ZIMG_ARM
+
+#ifndef ZIMG_GRAPH_ARM_PREMULTIPLY_ARM_H_
+#define ZIMG_GRAPH_ARM_PREMULTIPLY_ARM_H_
+
+#include "graph/basic_filter.h"
+
+namespace zimg {
+namespace graph {
+
+#define DECLARE_PREMULTIPLY(x, cpu) \
+void x##_##cpu(const float *alpha, const float *src, float *dst, unsigned left, unsigned right)
+
+DECLARE_PREMULTIPLY(premultiply, neon);
+#if defined(_M_ARM64) || defined(__aarch64__)
+DECLARE_PREMULTIPLY(unpremultiply, neon);
+#endif
+
+#undef DECLARE_PREMULTIPLY
+
+premultiply_func select_premultiply_func_arm(CPUClass cpu);
+
+premultiply_func select_unpremultiply_func_arm(CPUClass cpu);
+
+} // namespace graph
+} // namespace zimg
+
+#endif // ZIMG_GRAPH_ARM_PREMULTIPLY_ARM_H_
+
+#endif // ZIMG_ARM
@@ -0,0 +1,86 @@
+#ifdef ZIMG_ARM
+
+#include <arm_neon.h>
+#include "common/align.h"
+#include "common/ccdep.h"
+#include "premultiply_arm.h"
+
+#include "common/arm/neon_util.h"
+
+namespace zimg {
+namespace graph {
+
+namespace {
+
+inline FORCE_INLINE float32x4_t premultiply_neon_xiter(unsigned j, const float *alpha, const float *src)
+{
+	float32x4_t a = vld1q_f32(alpha + j);
+	float32x4_t x = vld1q_f32(src + j);
+
+	a = vmaxq_f32(a, vdupq_n_f32(0.0f));
+	a = vminq_f32(a, vdupq_n_f32(1.0f));
+	return vmulq_f32(x, a);
+}
+
+#if defined(_M_ARM64) || defined(__aarch64__)
+inline FORCE_INLINE float32x4_t unpremultiply_neon_xiter(unsigned j, const float *alpha, const float *src)
+{
+	float32x4_t a = vld1q_f32(alpha + j);
+	float32x4_t x = vld1q_f32(src + j);
+	uint32x4_t mask;
+
+	a = vmaxq_f32(a, vdupq_n_f32(0.0f));
+	a = vminq_f32(a, vdupq_n_f32(1.0f));
+	mask = vceqq_f32(a, vdupq_n_f32(0.0f));
+
+	return vbslq_f32(mask, vdupq_n_f32(0.0f), vdivq_f32(x, a));
+}
+#endif // defined(_M_ARM64) || defined(__aarch64__)
+
+} // namespace
+
+
+void premultiply_neon(const float *alpha, const float *src, float *dst, unsigned left, unsigned right)
+{
+	unsigned vec_left = ceil_n(left, 4);
+	unsigned vec_right = floor_n(right, 4);
+
+	if (left != vec_left) {
+		float32x4_t x = premultiply_neon_xiter(vec_left - 4, alpha, src);
+		neon_store_idxhi_f32(dst + vec_left - 4, x, left % 4);
+	}
+	for (unsigned j = vec_left; j < vec_right; j += 4) {
+		float32x4_t x = premultiply_neon_xiter(j, alpha, src);
+		vst1q_f32(dst + j, x);
+	}
+	if (right != vec_right) {
+		float32x4_t x = premultiply_neon_xiter(vec_right, alpha, src);
+		neon_store_idxlo_f32(dst + vec_right, x, right % 4);
+	}
+}
+
+#if defined(_M_ARM64) || defined(__aarch64__)
+void unpremultiply_neon(const float *alpha, const float *src, float *dst, unsigned left, unsigned right)
+{
+	unsigned vec_left = ceil_n(left, 4);
+	unsigned vec_right = floor_n(right, 4);
+
+	if (left != vec_left) {
+		float32x4_t x = unpremultiply_neon_xiter(vec_left - 4, alpha, src);
+		neon_store_idxhi_f32(dst + vec_left - 4, x, left % 4);
+	}
+	for (unsigned j = vec_left; j < vec_right; j += 4) {
+		float32x4_t x = unpremultiply_neon_xiter(j, alpha, src);
+		vst1q_f32(dst + j, x);
+	}
+	if (right != vec_right) {
+		float32x4_t x = unpremultiply_neon_xiter(vec_right, alpha, src);
+		neon_store_idxlo_f32(dst + vec_right, x, right % 4);
+	}
+}
+#endif // defined(_M_ARM64) || defined(__aarch64__)
+
+} // namespace graph
+} // namespace zimg
+
+#endif // ZIMG_ARM
@@ -1,10 +1,88 @@
 #include <algorithm>
+#include <cfloat>
+#include <cstdint>
 #include "common/pixel.h"
+#include "common/zassert.h"
 #include "basic_filter.h"
 
+#if defined(ZIMG_X86)
+  #include "x86/premultiply_x86.h"
+#elif defined(ZIMG_ARM)
+  #include "arm/premultiply_arm.h"
+#endif
+
 namespace zimg {
 namespace graph {
 
+namespace {
+
+void premultiply_c(const float *alpha, const float *src, float *dst, unsigned left, unsigned right)
+{
+	for (unsigned j = left; j < right; ++j) {
+		float a = alpha[j];
+		a = std::min(std::max(a, 0.0f), 1.0f);
+		dst[j] = src[j] * a;
+	}
+}
+
+void unpremultiply_c(const float *alpha, const float *src, float *dst, unsigned left, unsigned right)
+{
+	for (unsigned j = left; j < right; ++j) {
+		float a = alpha[j];
+		a = std::min(std::max(a, 0.0f), 1.0f);
+		dst[j] = a == 0.0f ? 0.0f : src[j] / a;
+	}
+}
+
+template <class T>
+void premultiply_int(const T *alpha, const T *src, T *dst, unsigned depth, unsigned left, unsigned right)
+{
+	const uint32_t maxval = (1UL << depth) - 1;
+	const uint32_t half = 1UL << (depth - 1);
+
+	for (unsigned j = left; j < right; ++j) {
+		uint32_t a = std::min(static_cast<uint32_t>(alpha[j]), maxval);
+		uint32_t x = std::min(static_cast<uint32_t>(src[j]), maxval);
+
+		// Division by 2^n-1 with rounding, exact for 0 <= x, a <= 2^n-1.
+		uint32_t t = x * a + half;
+		dst[j] = static_cast<T>((t + (t >> depth)) >> depth);
+	}
+}
+
+premultiply_func select_premultiply_func(CPUClass cpu)
+{
+	premultiply_func func = nullptr;
+
+#if defined(ZIMG_X86)
+	func = select_premultiply_func_x86(cpu);
+#elif defined(ZIMG_ARM)
+	func = select_premultiply_func_arm(cpu);
+#endif
+	if (!func)
+		func = premultiply_c;
+
+	return func;
+}
+
+premultiply_func select_unpremultiply_func(CPUClass cpu)
+{
+	premultiply_func func = nullptr;
+
+#if defined(ZIMG_X86)
+	func = select_unpremultiply_func_x86(cpu);
+#elif defined(ZIMG_ARM)
+	func = select_unpremultiply_func_arm(cpu);
+#endif
+	if (!func)
+		func = unpremultiply_c;
+
+	return func;
+}
+
+} // namespace
+
+
 CopyFilter::CopyFilter(unsigned width, unsigned height, PixelType type, bool color) :
 	m_attr{ width, height, type },
 	m_color{ color }
@@ -29,7 +107,8 @@ void CopyFilter::process(void *, const ImageBuffer<const void> *src, const Image
 		size_t left_byte = static_cast<size_t>(left) * pixel_size(m_attr.type);
 		size_t right_byte = static_cast<size_t>(right) * pixel_size(m_attr.type);
 
-		std::copy_n(src_p + left_byte, right_byte - left_byte, dst_p + left_byte);
+		if (src_p != dst_p)
+			std::copy_n(src_p + left_byte, right_byte - left_byte, dst_p + left_byte);
 	}
 }
 
@@ -108,11 +187,19 @@ void ValueInitializeFilter::process(void *, const ImageBuffer<const void> *, con
 }
 
 
-PremultiplyFilter::PremultiplyFilter(unsigned width, unsigned height, bool color) :
+PremultiplyFilter::PremultiplyFilter(unsigned width, unsigned height, const PixelFormat &format, bool color, CPUClass cpu) :
+	m_func{},
 	m_width{ width },
 	m_height{ height },
+	m_format(format),
 	m_color{ color }
-{}
+{
+	zassert_d(m_format.type != PixelType::HALF, "half precision not supported");
+	zassert_d(pixel_is_float(m_format.type) || m_format.fullrange, "limited range not supported");
+
+	if (m_format.type == PixelType::FLOAT)
+		m_func = select_premultiply_func(cpu);
+}
 
 auto PremultiplyFilter::get_flags() const -> filter_flags
 {
@@ -125,27 +212,32 @@ auto PremultiplyFilter::get_flags() const -> filter_flags
 
 auto PremultiplyFilter::get_image_attributes() const -> image_attributes
 {
-	return{ m_width, m_height, PixelType::FLOAT };
+	return{ m_width, m_height, m_format.type };
 }
 
 void PremultiplyFilter::process(void *, const ImageBuffer<const void> src[], const ImageBuffer<void> dst[], void *, unsigned i, unsigned left, unsigned right) const
 {
-	const float *alpha = static_buffer_cast<const float>(src)[3][i];
-
 	for (unsigned p = 0; p < (m_color ? 3U : 1U); ++p) {
-		const float *src_p = static_buffer_cast<const float>(src)[p][i];
-		float *dst_p = static_buffer_cast<float>(dst)[p][i];
-
-		for (unsigned j = left; j < right; ++j) {
-			float a = alpha[j];
-			a = std::min(std::max(a, 0.0f), 1.0f);
-			dst_p[j] = src_p[j] * a;
+		switch (m_format.type) {
+		case PixelType::BYTE:
+			premultiply_int(static_buffer_cast<const uint8_t>(src)[3][i], static_buffer_cast<const uint8_t>(src)[p][i],
+			                static_buffer_cast<uint8_t>(dst)[p][i], m_format.depth, left, right);
+			break;
+		case PixelType::WORD:
+			premultiply_int(static_buffer_cast<const uint16_t>(src)[3][i], static_buffer_cast<const uint16_t>(src)[p][i],
+			                static_buffer_cast<uint16_t>(dst)[p][i], m_format.depth, left, right);
+			break;
+		default:
+			m_func(static_buffer_cast<const float>(src)[3][i], static_buffer_cast<const float>(src)[p][i],
+			       static_buffer_cast<float>(dst)[p][i], left, right);
+			break;
 		}
 	}
 }
 
 
-UnpremultiplyFilter::UnpremultiplyFilter(unsigned width, unsigned height, bool color) :
+UnpremultiplyFilter::UnpremultiplyFilter(unsigned width, unsigned height, bool color, CPUClass cpu) :
+	m_func{ select_unpremultiply_func(cpu) },
 	m_width{ width },
 	m_height{ height },
 	m_color{ color }
@@ -169,16 +261,8 @@ void UnpremultiplyFilter::process(void *, const ImageBuffer<const void> src[], c
 {
 	const float *alpha = static_buffer_cast<const float>(src)[3][i];
 
-	for (unsigned p = 0; p < (m_color ? 3U : 1U); ++p) {
-		const float *src_p = static_buffer_cast<const float>(src)[p][i];
-		float *dst_p = static_buffer_cast<float>(dst)[p][i];
-
-		for (unsigned j = left; j < right; ++j) {
-			float a = alpha[j];
-			a = std::min(std::max(a, 0.0f), 1.0f);
-			dst_p[j] = a == 0.0f ? 0.0f : src_p[j] / a;
-		}
-	}
+	for (unsigned p = 0; p < (m_color ? 3U : 1U); ++p)
+		m_func(alpha, static_buffer_cast<const float>(src)[p][i], static_buffer_cast<float>(dst)[p][i], left, right);
 }
 
 } // namespace graph
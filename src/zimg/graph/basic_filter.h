@@ -4,14 +4,17 @@
 #define ZIMG_GRAPH_BASIC_FILTER_H_
 
 #include <cstdint>
+#include "common/pixel.h"
 #include "image_filter.h"
 
 namespace zimg {
 
-enum class PixelType;
+enum class CPUClass;
 
 namespace graph {
 
+typedef void (*premultiply_func)(const float *alpha, const float *src, float *dst, unsigned left, unsigned right);
+
 // Copies an image buffer.
 class CopyFilter : public ImageFilterBase {
 	image_attributes m_attr;
@@ -69,12 +72,17 @@ public:
 };
 
 // Premultiplies an image.
+//
+// Integer images must be full range. They are premultiplied without
+// conversion to floating point, rounding to the nearest sample value.
 class PremultiplyFilter : public ImageFilterBase {
+	premultiply_func m_func;
 	unsigned m_width;
 	unsigned m_height;
+	PixelFormat m_format;
 	bool m_color;
 public:
-	PremultiplyFilter(unsigned width, unsigned height, bool color);
+	PremultiplyFilter(unsigned width, unsigned height, const PixelFormat &format, bool color, CPUClass cpu);
 
 	filter_flags get_flags() const override;
 
@@ -85,11 +93,12 @@ public:
 
 // Unpremultiplies an image.
 class UnpremultiplyFilter : public ImageFilterBase {
+	premultiply_func m_func;
 	unsigned m_width;
 	unsigned m_height;
 	bool m_color;
 public:
-	UnpremultiplyFilter(unsigned width, unsigned height, bool color);
+	UnpremultiplyFilter(unsigned width, unsigned height, bool color, CPUClass cpu);
 
 	filter_flags get_flags() const override;
 
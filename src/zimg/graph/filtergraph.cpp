@@ -47,11 +47,13 @@ class FilterGraph::impl {
 	GraphNode *m_source;
 	GraphNode *m_sink;
 	node_map m_output_nodes;
+	plane_mask m_passthrough;
 	unsigned m_interleaved_tile_width;
 	unsigned m_planar_tile_width[PLANE_NUM];
 	size_t m_tmp_size;
 	bool m_entire_row;
 	bool m_planar;
+	bool m_planar_uv;
 	bool m_requires_64b_alignment;
 
 	node_id next_id() const { return static_cast<node_id>(m_nodes.size()); }
@@ -81,6 +83,24 @@ class FilterGraph::impl {
 		}
 	}
 
+	// Planes executed together in planar mode. U and V are grouped if a node
+	// processes both, so that the node is not executed once for each plane.
+	plane_mask planar_group(int plane) const
+	{
+		plane_mask group{};
+		group[plane] = true;
+
+		if (m_planar_uv && plane == PLANE_U && m_output_nodes[PLANE_V])
+			group[PLANE_V] = true;
+
+		return group;
+	}
+
+	bool is_grouped_plane(int plane) const
+	{
+		return m_planar_uv && plane == PLANE_V && m_output_nodes[PLANE_U];
+	}
+
 	size_t calculate_cache_footprint(SimulationState::result &sim, int plane) const
 	{
 		const GraphNode *out = plane < 0 ? m_sink : m_output_nodes[plane];
@@ -110,13 +130,20 @@ class FilterGraph::impl {
 				}
 			}
 		} else {
-			if (m_source->get_plane_mask()[plane]) {
-				auto input_attr = m_source->get_image_attributes(plane);
-				footprint += ceil_n(static_cast<checked_size_t>(input_attr.width) * pixel_size(input_attr.type), ALIGNMENT) * input_lines;
-			}
-			if (m_sink->get_plane_mask()[plane]) {
-				auto output_attr = m_sink->get_image_attributes(plane);
-				footprint += ceil_n(static_cast<checked_size_t>(output_attr.width) * pixel_size(output_attr.type), ALIGNMENT) * output_lines;
+			plane_mask group = planar_group(plane);
+
+			for (int p = 0; p < PLANE_NUM; ++p) {
+				if (!group[p])
+					continue;
+
+				if (m_source->get_plane_mask()[p]) {
+					auto input_attr = m_source->get_image_attributes(p);
+					footprint += ceil_n(static_cast<checked_size_t>(input_attr.width) * pixel_size(input_attr.type), ALIGNMENT) * input_lines;
+				}
+				if (m_sink->get_plane_mask()[p]) {
+					auto output_attr = m_sink->get_image_attributes(p);
+					footprint += ceil_n(static_cast<checked_size_t>(output_attr.width) * pixel_size(output_attr.type), ALIGNMENT) * output_lines;
+				}
 			}
 		}
 
@@ -154,16 +181,23 @@ class FilterGraph::impl {
 			return;
 
 		for (int p = 0; p < PLANE_NUM; ++p) {
-			if (!m_output_nodes[p])
+			if (!m_output_nodes[p] || is_grouped_plane(p))
 				continue;
 
 			SimulationState sim{ m_nodes };
+			plane_mask group = planar_group(p);
 			unsigned height = m_output_nodes[p]->get_image_attributes(p).height;
 
 			for (unsigned i = 0; i < height; ++i) {
-				m_output_nodes[p]->simulate(&sim, i, i + 1, p);
+				for (int q = p; q < PLANE_NUM; ++q) {
+					if (group[q])
+						m_output_nodes[q]->simulate(&sim, i, i + 1, q);
+				}
+			}
+			for (int q = p; q < PLANE_NUM; ++q) {
+				if (group[q])
+					m_output_nodes[q]->simulate_alloc(&sim);
 			}
-			m_output_nodes[p]->simulate_alloc(&sim);
 
 			m_planar_sim[p] = sim.get_result(m_nodes);
 			m_tmp_size = std::max(m_tmp_size, ExecutionState::calculate_tmp_size(m_planar_sim[p], m_nodes));
@@ -201,11 +235,21 @@ class FilterGraph::impl {
 	void process_planar(const ImageBuffer<const void> src[], const ImageBuffer<void> dst[], void *tmp) const
 	{
 		for (int p = 0; p < PLANE_NUM; ++p) {
-			if (!m_output_nodes[p])
+			if (!m_output_nodes[p] || is_grouped_plane(p))
+				continue;
+
+			// An unmodified plane written back to its own storage requires no work.
+			plane_mask group = planar_group(p);
+			for (int q = p; q < PLANE_NUM; ++q) {
+				if (group[q] && m_passthrough[q] && src[q].data() == dst[q].data() && src[q].stride() == dst[q].stride())
+					group[q] = false;
+			}
+			if (std::none_of(group.begin(), group.end(), [](bool x) { return x; }))
 				continue;
 
 			ExecutionState state{ m_planar_sim[p], m_nodes, m_source->cache_id(), m_sink->cache_id(), src, dst, nullptr, nullptr, tmp };
 			auto attr = m_output_nodes[p]->get_image_attributes(p);
+			bool single = std::count(group.begin(), group.end(), true) == 1;
 
 			for (unsigned j = 0; j < attr.width;) {
 				unsigned j_end = j + std::min(m_planar_tile_width[p], attr.width - j);
@@ -213,8 +257,24 @@ class FilterGraph::impl {
 					j_end = attr.width;
 
 				state.reset_initialized(m_nodes.size());
-				m_output_nodes[p]->init_context(&state, 0, j, j_end, p);
-				m_output_nodes[p]->generate(&state, attr.height, p);
+
+				for (int q = p; q < PLANE_NUM; ++q) {
+					if (group[q])
+						m_output_nodes[q]->init_context(&state, 0, j, j_end, q);
+				}
+
+				if (single) {
+					int q = static_cast<int>(std::find(group.begin(), group.end(), true) - group.begin());
+					m_output_nodes[q]->generate(&state, attr.height, q);
+				} else {
+					// Grouped planes advance together, so that shared nodes run once per row.
+					for (unsigned i = 0; i < attr.height; ++i) {
+						for (int q = p; q < PLANE_NUM; ++q) {
+							if (group[q])
+								m_output_nodes[q]->generate(&state, i + 1, q);
+						}
+					}
+				}
 
 				j = j_end;
 			}
@@ -227,11 +287,13 @@ public:
 		m_source{},
 		m_sink{},
 		m_output_nodes{},
+		m_passthrough{},
 		m_interleaved_tile_width{},
 		m_planar_tile_width{},
 		m_tmp_size{},
 		m_entire_row{},
 		m_planar{ true },
+		m_planar_uv{},
 		m_requires_64b_alignment{}
 	{}
 
@@ -256,8 +318,13 @@ public:
 		size_t input_plane_count = std::count(input_planes.begin(), input_planes.end(), true);
 		size_t output_plane_count = std::count(output_planes.begin(), output_planes.end(), true);
 
-		if (output_plane_count > 1 || input_plane_count > 1 || (input_plane_count > 0 && input_planes != output_planes))
+		// A node processing U and V only is executed in planar mode with both planes in one pass.
+		bool uv = output_planes == plane_mask{ false, true, true, false };
+
+		if ((output_plane_count > 1 && !uv) || (input_plane_count > 0 && input_planes != output_planes))
 			m_planar = false;
+		if (uv)
+			m_planar_uv = true;
 		if (filter->get_flags().entire_row)
 			m_entire_row = true;
 
@@ -269,6 +336,7 @@ public:
 	{
 		zassert_d(!m_sink, "sink already defined");
 		node_map parents = id_to_node(deps);
+		node_map scratch{};
 
 		for (int p = 0; p < PLANE_NUM; ++p) {
 			GraphNode *node = parents[p];
@@ -278,22 +346,30 @@ public:
 			bool need_copy = false;
 
 			// If the node is the source, then a copy is needed, because the source buffer is external.
-			// If the node is not a terminal, then a copy is also needed.
+			// If the node is not a terminal, then a copy is also needed, as the output buffer is never read.
 			if (node->is_sourcesink() || node->ref_count() > 0) {
 				need_copy = true;
 			} else {
-				// If the node produces planes that do not contribute to the output, then a copy is needed.
+				// If the node produces planes that are absent from the output, those planes are written to scratch
+				// buffers, so that the node still writes directly to the output. If the planes are instead produced by
+				// another node, or the scratch plane is claimed by another node, a copy is needed.
 				plane_mask mask = node->get_plane_mask();
 
 				for (int q = 0; q < PLANE_NUM; ++q) {
-					if (mask[q] && parents[q] != node) {
+					if (mask[q] && ((deps[q] >= 0 && parents[q] != node) || (scratch[q] && scratch[q] != node))) {
 						need_copy = true;
 						break;
 					}
 				}
+				for (int q = 0; q < PLANE_NUM && !need_copy; ++q) {
+					if (mask[q] && deps[q] < 0)
+						scratch[q] = node;
+				}
 			}
 
 			if (need_copy) {
+				m_passthrough[p] = node == m_source;
+
 				id_map deps = null_ids;
 				deps[p] = node->id();
 
@@ -308,7 +384,7 @@ public:
 		add_ref(parents);
 
 		m_output_nodes = parents;
-		m_nodes.emplace_back(make_sink_node(next_id(), m_output_nodes));
+		m_nodes.emplace_back(make_sink_node(next_id(), m_output_nodes, scratch));
 		m_sink = m_nodes.back().get();
 		m_sink->add_ref();
 
@@ -357,6 +433,14 @@ public:
 		}
 	}
 
+	plane_mask get_passthrough_planes() const
+	{
+		zassert_d(m_sink, "complete graph required");
+		return m_passthrough;
+	}
+
+	bool is_planar() const { return m_planar; }
+
 	bool requires_64b_alignment() const { return m_requires_64b_alignment; }
 
 	void set_requires_64b_alignment() { m_requires_64b_alignment = true; }
@@ -443,6 +527,16 @@ void FilterGraph::set_tile_width(unsigned tile_width)
 	m_impl->set_tile_width(tile_width);
 }
 
+plane_mask FilterGraph::get_passthrough_planes() const
+{
+	return m_impl->get_passthrough_planes();
+}
+
+bool FilterGraph::is_planar() const
+{
+	return m_impl->is_planar();
+}
+
 bool FilterGraph::requires_64b_alignment() const
 {
 	return m_impl->requires_64b_alignment();
@@ -175,6 +175,27 @@ public:
 	 */
 	void set_tile_width(unsigned tile_width);
 
+	/**
+	 * Get the output planes which are unmodified copies of the input.
+	 *
+	 * If the input and output buffers of such a plane refer to the same
+	 * memory, the plane is not processed.
+	 *
+	 * @return mask of passthrough planes
+	 */
+	plane_mask get_passthrough_planes() const;
+
+	/**
+	 * Check if the graph can be executed one plane at a time.
+	 *
+	 * Attaching a node that reads or writes several planes disables planar
+	 * execution for the remainder of the graph, unless the node processes
+	 * only the U and V planes. Such nodes execute both planes in one pass.
+	 *
+	 * @return true if planar execution is possible, else false
+	 */
+	bool is_planar() const;
+
 	/**
 	 * Check if the graph requires 64-byte data alignment.
 	 *
@@ -190,6 +211,8 @@ public:
 	/**
 	 * Process an image frame with filter graph.
 	 *
+	 * Input and output buffers may alias only for passthrough planes.
+	 *
 	 * @param src pointer to input buffers
 	 * @param dst pointer to output buffers
 	 * @param tmp temporary buffer
@@ -1,6 +1,9 @@
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <memory>
 #include <utility>
+#include <vector>
 #include "common/cpuinfo.h"
 #include "common/except.h"
 #include "common/make_unique.h"
@@ -13,6 +16,7 @@
 #include "filtergraph.h"
 #include "graphbuilder.h"
 #include "image_filter.h"
+#include "interleave.h"
 
 
 #ifndef ZIMG_UNSAFE_IMAGE_SIZE
@@ -61,6 +65,43 @@ id_map operator&(id_map lhs, plane_mask rhs)
 class DefaultFilterObserver : public FilterObserver {};
 
 
+bool is_interleaved(GraphBuilder::Packing packing)
+{
+	return packing == GraphBuilder::Packing::INTERLEAVED || packing == GraphBuilder::Packing::INTERLEAVED_BGR;
+}
+
+bool is_semiplanar(GraphBuilder::Packing packing)
+{
+	return packing == GraphBuilder::Packing::SEMIPLANAR || packing == GraphBuilder::Packing::SEMIPLANAR_MSB;
+}
+
+// Returns the number of interleaved components and their plane indices.
+unsigned packed_components(GraphBuilder::Packing packing, bool has_chroma, bool has_alpha, component_map *components)
+{
+	unsigned n = 0;
+
+	if (is_semiplanar(packing)) {
+		(*components)[n++] = PLANE_U;
+		(*components)[n++] = PLANE_V;
+	} else if (packing == GraphBuilder::Packing::INTERLEAVED_BGR) {
+		(*components)[n++] = PLANE_V;
+		(*components)[n++] = PLANE_U;
+		(*components)[n++] = PLANE_Y;
+	} else {
+		(*components)[n++] = PLANE_Y;
+		if (has_chroma) {
+			(*components)[n++] = PLANE_U;
+			(*components)[n++] = PLANE_V;
+		}
+	}
+
+	if (is_interleaved(packing) && has_alpha)
+		(*components)[n++] = PLANE_A;
+
+	return n;
+}
+
+
 // Offset of chroma sample from corresponding centered chroma sample in units of chroma pixels.
 double chroma_offset_w(GraphBuilder::ChromaLocationW loc, double subsampling)
 {
@@ -228,6 +269,19 @@ void validate_state(const GraphBuilder::state &state)
 	if (!state.fullrange && state.depth < 8)
 		error::throw_<error::BitDepthOverflow>("bit depth must be at least 8 for limited range");
 
+	if (is_interleaved(state.packing)) {
+		if (state.subsample_w || state.subsample_h)
+			error::throw_<error::UnsupportedSubsampling>("interleaved image cannot be subsampled");
+		if (state.color == GraphBuilder::ColorFamily::GREY && state.alpha == GraphBuilder::AlphaType::NONE)
+			error::throw_<error::ColorFamilyMismatch>("interleaved image must have more than one component");
+	}
+	if (state.packing == GraphBuilder::Packing::INTERLEAVED_BGR && state.color != GraphBuilder::ColorFamily::RGB)
+		error::throw_<error::ColorFamilyMismatch>("BGR component order requires RGB color family");
+	if (is_semiplanar(state.packing) && state.color != GraphBuilder::ColorFamily::YUV)
+		error::throw_<error::ColorFamilyMismatch>("semi-planar image must be YUV");
+	if (state.packing == GraphBuilder::Packing::SEMIPLANAR_MSB && state.type != PixelType::WORD)
+		error::throw_<error::UnsupportedOperation>("MSB-aligned samples require WORD pixel type");
+
 	if (!std::isfinite(state.active_left) || !std::isfinite(state.active_top) || !std::isfinite(state.active_width) || !std::isfinite(state.active_height))
 		error::throw_<error::InvalidImageSize>("active window must be finite");
 	if (state.active_width <= 0 || state.active_height <= 0)
@@ -378,9 +432,28 @@ private:
 		ALPHA,
 	};
 
+	// Packed source plane which has not yet been split into planes.
+	struct pending_split {
+		ImageFilter::image_attributes attr;
+		node_id src_id;
+		int src_plane;
+		component_map components;
+		unsigned num_components;
+		unsigned shift;
+	};
+
 	std::unique_ptr<FilterGraph> m_graph;
 	id_map m_ids;
 	internal_state m_state;
+	Packing m_source_packing;
+	Packing m_packing;
+	CPUClass m_cpu;
+
+	// The source split and the depth conversions next to packed images are
+	// attached only once a consumer requires them, so that each conversion can
+	// be fused with the packing of its component.
+	std::vector<pending_split> m_pending_splits;
+	std::array<std::shared_ptr<ImageFilter>, PLANE_NUM> m_pending_depth;
 
 	internal_state make_float_444_state(const internal_state &state, bool include_alpha)
 	{
@@ -404,12 +477,139 @@ private:
 		}
 	}
 
-	void attach_filter(std::shared_ptr<ImageFilter> filter, id_map deps, plane_mask outputs)
+	void attach_filter_now(std::shared_ptr<ImageFilter> filter, const id_map &deps, const plane_mask &outputs)
 	{
 		node_id id = m_graph->attach_filter(std::move(filter), deps, outputs);
 		apply_mask(outputs, [&](int p) { m_ids[p] = id; });
 	}
 
+	void attach_filter(std::shared_ptr<ImageFilter> filter, id_map deps, plane_mask outputs)
+	{
+		plane_mask dep_mask{};
+		for (int p = 0; p < PLANE_NUM; ++p) {
+			dep_mask[p] = deps[p] != invalid_id;
+		}
+
+		// Deferred operations on the affected planes are attached first.
+		plane_mask flushed = flush_pending(dep_mask | outputs);
+		for (int p = 0; p < PLANE_NUM; ++p) {
+			if (flushed[p] && dep_mask[p])
+				deps[p] = m_ids[p];
+		}
+
+		attach_filter_now(std::move(filter), deps, outputs);
+	}
+
+	void attach_split(const pending_split &split)
+	{
+		component_filters convert{};
+		plane_mask outputs{};
+		plane_mask dropped{};
+		const ImageFilter *first = nullptr;
+		bool fuse = true;
+
+		for (unsigned k = 0; k < split.num_components; ++k) {
+			int p = split.components[k];
+
+			// Components dropped from the graph are not converted.
+			if (m_ids[p] == invalid_id) {
+				dropped[p] = true;
+				continue;
+			}
+
+			convert[k] = m_pending_depth[p];
+			outputs[p] = true;
+
+			if (!convert[k] || (first && first->get_image_attributes().type != convert[k]->get_image_attributes().type))
+				fuse = false;
+			else if (!first)
+				first = convert[k].get();
+		}
+
+		if (outputs == plane_mask{})
+			return;
+
+		id_map deps = null_ids;
+		deps[split.src_plane] = split.src_id;
+
+		std::shared_ptr<ImageFilter> filter;
+
+		if (fuse) {
+			filter = std::make_shared<DeinterleaveConvertFilter>(
+				split.attr.width, split.attr.height, split.attr.type, split.src_plane, split.components, split.num_components, split.shift, convert, m_cpu);
+			apply_mask(outputs, [&](int p) { m_pending_depth[p].reset(); });
+		} else {
+			filter = std::make_shared<DeinterleaveFilter>(
+				split.attr.width, split.attr.height, split.attr.type, split.src_plane, split.components, split.num_components, split.shift, m_cpu);
+			outputs |= dropped;
+		}
+
+		attach_filter_now(std::move(filter), deps, outputs);
+		apply_mask(dropped, [&](int p) { m_ids[p] = invalid_id; });
+	}
+
+	plane_mask flush_pending(const plane_mask &mask)
+	{
+		plane_mask flushed{};
+
+		for (int p = 0; p < PLANE_NUM; ++p) {
+			if (!mask[p])
+				continue;
+
+			auto it = std::find_if(m_pending_splits.begin(), m_pending_splits.end(), [=](const pending_split &split)
+			{
+				auto last = split.components.begin() + split.num_components;
+				return std::find(split.components.begin(), last, p) != last;
+			});
+			if (it != m_pending_splits.end()) {
+				pending_split split = *it;
+				m_pending_splits.erase(it);
+				attach_split(split);
+
+				for (unsigned k = 0; k < split.num_components; ++k) {
+					flushed[split.components[k]] = true;
+				}
+			}
+
+			if (m_pending_depth[p]) {
+				plane_mask plane{};
+				plane[p] = true;
+
+				std::shared_ptr<ImageFilter> filter = std::move(m_pending_depth[p]);
+				m_pending_depth[p].reset();
+				attach_filter_now(std::move(filter), m_ids & plane, plane);
+				flushed[p] = true;
+			}
+		}
+
+		return flushed;
+	}
+
+	bool is_split_pending(int p) const
+	{
+		return std::any_of(m_pending_splits.begin(), m_pending_splits.end(), [=](const pending_split &split)
+		{
+			auto last = split.components.begin() + split.num_components;
+			return std::find(split.components.begin(), last, p) != last;
+		});
+	}
+
+	void attach_depth(std::shared_ptr<ImageFilter> filter, int p)
+	{
+		plane_mask mask{};
+		mask[p] = true;
+
+		// Only conversions next to a packed image can be fused.
+		if (!is_split_pending(p) && m_packing == Packing::PLANAR) {
+			attach_greyscale_filter(std::move(filter), mask, true);
+			return;
+		}
+
+		if (m_pending_depth[p])
+			flush_pending(mask);
+		m_pending_depth[p] = std::move(filter);
+	}
+
 	void attach_greyscale_filter(std::shared_ptr<ImageFilter> filter, plane_mask mask, bool has_dep)
 	{
 		apply_mask(mask, [&](int p)
@@ -422,15 +622,30 @@ private:
 		});
 	}
 
-	void check_is_444_float(bool check_alpha)
+	void attach_resize_filter(std::shared_ptr<ImageFilter> filter, std::shared_ptr<ImageFilter> filter_uv, plane_mask mask)
+	{
+		// A U+V filter is a color filter for both chroma planes. Otherwise, it
+		// is a greyscale fallback applied to each of them.
+		if (filter_uv && filter_uv->get_flags().color)
+			attach_filter(std::move(filter_uv), m_ids & chroma_planes, chroma_planes);
+		else if (filter_uv)
+			attach_greyscale_filter(std::move(filter_uv), chroma_planes, true);
+
+		if (filter)
+			attach_greyscale_filter(std::move(filter), mask, true);
+	}
+
+	void check_is_444_float(bool check_alpha, bool allow_half = false, bool allow_integer = false)
 	{
-		iassert(m_state.planes[PLANE_Y].format.type == PixelType::FLOAT);
+		PixelType type = m_state.planes[PLANE_Y].format.type;
+
+		iassert(type == PixelType::FLOAT || (allow_half && type == PixelType::HALF) || (allow_integer && pixel_is_integer(type)));
 		if (m_state.has_chroma()) {
-			iassert(m_state.planes[PLANE_U].format.type == PixelType::FLOAT);
-			iassert(m_state.planes[PLANE_V].format.type == PixelType::FLOAT);
+			iassert(m_state.planes[PLANE_U].format.type == type);
+			iassert(m_state.planes[PLANE_V].format.type == type);
 		}
 		if (check_alpha && m_state.has_alpha())
-			iassert(m_state.planes[PLANE_A].format.type == PixelType::FLOAT);
+			iassert(m_state.planes[PLANE_A].format.type == type);
 
 		if (m_state.has_chroma()) {
 			iassert(m_state.planes[0].width == m_state.planes[1].width && m_state.planes[0].height == m_state.planes[1].height);
@@ -509,6 +724,18 @@ private:
 		return false;
 	}
 
+	bool can_convert_colorspace_integer(const internal_state &target)
+	{
+		const PixelFormat &format = m_state.planes[PLANE_Y].format;
+
+		if (m_state.color != ColorFamily::RGB || !pixel_is_integer(format.type) || format.depth > colorspace::MAX_INTEGER_LUT_DEPTH)
+			return false;
+		if (m_state.planes[PLANE_U] != m_state.planes[PLANE_Y] || m_state.planes[PLANE_V] != m_state.planes[PLANE_Y])
+			return false;
+
+		return !needs_resize_plane(target, PLANE_Y);
+	}
+
 	bool needs_premul(const internal_state &target)
 	{
 		if (m_state.alpha != AlphaType::STRAIGHT)
@@ -516,7 +743,26 @@ private:
 		return target.alpha != AlphaType::STRAIGHT || needs_colorspace(target) || needs_interpolation(target);
 	}
 
-	void drop_plane(int p) { m_ids[p] = invalid_id; }
+	bool can_premultiply_integer(const internal_state &target)
+	{
+		const PixelFormat &format = m_state.planes[PLANE_Y].format;
+
+		// Integer chroma is offset from zero and can not be scaled directly.
+		if (m_state.color == ColorFamily::YUV || !pixel_is_integer(format.type) || !format.fullrange)
+			return false;
+		if (m_state.has_chroma() && (m_state.planes[PLANE_U] != m_state.planes[PLANE_Y] || m_state.planes[PLANE_V] != m_state.planes[PLANE_Y]))
+			return false;
+		if (m_state.planes[PLANE_A] != m_state.planes[PLANE_Y] || target.planes[PLANE_Y].format != format)
+			return false;
+
+		return !needs_colorspace(target) && !needs_interpolation(target);
+	}
+
+	void drop_plane(int p)
+	{
+		m_ids[p] = invalid_id;
+		m_pending_depth[p].reset();
+	}
 
 	void yuv_to_grey(FilterObserver &observer)
 	{
@@ -574,15 +820,15 @@ private:
 		m_state.planes[PLANE_V].format = format;
 	}
 
-	void premultiply(FilterObserver &observer)
+	void premultiply(const params &params, FilterObserver &observer)
 	{
 		iassert(m_state.alpha == AlphaType::STRAIGHT);
-		check_is_444_float(true);
+		check_is_444_float(true, false, true);
 
 		observer.premultiply();
 
 		auto filter = std::make_shared<PremultiplyFilter>(
-			m_state.planes[PLANE_Y].width, m_state.planes[PLANE_Y].height, m_state.has_chroma());
+			m_state.planes[PLANE_Y].width, m_state.planes[PLANE_Y].height, m_state.planes[PLANE_Y].format, m_state.has_chroma(), params.cpu);
 
 		plane_mask dep_mask = luma_planes | alpha_planes;
 		plane_mask output_mask = luma_planes;
@@ -596,7 +842,7 @@ private:
 		m_state.alpha = AlphaType::PREMULTIPLIED;
 	}
 
-	void unpremultiply(FilterObserver &observer)
+	void unpremultiply(const params &params, FilterObserver &observer)
 	{
 		iassert(m_state.alpha == AlphaType::PREMULTIPLIED);
 		check_is_444_float(true);
@@ -604,7 +850,7 @@ private:
 		observer.unpremultiply();
 
 		auto filter = std::make_shared<UnpremultiplyFilter>(
-			m_state.planes[PLANE_Y].width, m_state.planes[PLANE_Y].height, m_state.has_chroma());
+			m_state.planes[PLANE_Y].width, m_state.planes[PLANE_Y].height, m_state.has_chroma(), params.cpu);
 
 		plane_mask dep_mask = luma_planes | alpha_planes;
 		plane_mask output_mask = luma_planes;
@@ -660,12 +906,33 @@ private:
 		});
 	}
 
+	PixelFormat choose_unresize_format(const internal_state &target, int p)
+	{
+		PixelFormat src_format = m_state.planes[p].format;
+		PixelFormat dst_format = target.planes[p].format;
+
+		// Solve in the integer domain only if the output is also integer, as rounding would otherwise discard precision.
+		if (dst_format.type == PixelType::BYTE || dst_format.type == PixelType::WORD) {
+			if (src_format.type == PixelType::WORD)
+				return src_format;
+			if (src_format.type == PixelType::BYTE && !src_format.fullrange)
+				return { PixelType::WORD, 16, false, src_format.chroma, src_format.ycgco };
+		}
+
+		return PixelType::FLOAT;
+	}
+
 	PixelFormat choose_resize_format(const internal_state &target, const params &params, int p)
 	{
 		if (params.unresize)
-			return PixelType::FLOAT;
+			return choose_unresize_format(target, p);
 
 		bool supported[4] = { false, true, cpu_has_fast_f16(params.cpu), true };
+
+		// Point resampling copies samples, so any pixel type can be resized without conversion.
+		if (dynamic_cast<const resize::PointFilter *>(p == PLANE_U || p == PLANE_V ? params.filter_uv : params.filter))
+			std::fill_n(supported, 4, true);
+
 		auto is_supported_type = [=](PixelType type) { return supported[static_cast<int>(type)]; };
 
 		double src_pels = static_cast<double>(m_state.planes[p].width) * m_state.planes[p].height;
@@ -719,13 +986,18 @@ private:
 
 		std::unique_ptr<ImageFilter> first;
 		std::unique_ptr<ImageFilter> second;
+		std::unique_ptr<ImageFilter> first_uv;
+		std::unique_ptr<ImageFilter> second_uv;
+		plane_mask uv_mask{};
 
 		if (params.unresize) {
 			unresize::UnresizeConversion conv{ src_plane.width, src_plane.height, src_plane.format.type };
 			conv.set_orig_width(dst_plane.width)
 				.set_orig_height(dst_plane.height)
+				.set_depth(src_plane.format.depth)
 				.set_shift_w(shift_w)
 				.set_shift_h(shift_h)
+				.set_filter(p == PLANE_U || p == PLANE_V ? params.filter_uv : params.filter)
 				.set_cpu(params.cpu);
 
 			observer.unresize(conv, p);
@@ -747,15 +1019,29 @@ private:
 
 			observer.resize(conv, p);
 
-			auto filter_list = conv.create();
-			first = std::move(filter_list.first);
-			second = std::move(filter_list.second);
+			// U and V are resized by the same filters, so both planes share a node.
+			if (mask[PLANE_U] && mask[PLANE_V]) {
+				auto filter_list = conv.set_uv(true).create();
+				first_uv = std::move(filter_list.first);
+				second_uv = std::move(filter_list.second);
+				uv_mask = chroma_planes;
+				conv.set_uv(false);
+			}
+
+			if (mask != uv_mask) {
+				auto filter_list = conv.create();
+				first = std::move(filter_list.first);
+				second = std::move(filter_list.second);
+			}
 		}
 
-		if (first)
-			attach_greyscale_filter(std::move(first), mask, true);
-		if (second)
-			attach_greyscale_filter(std::move(second), mask, true);
+		plane_mask greyscale_mask = mask;
+		apply_mask(uv_mask, [&](int q) { greyscale_mask[q] = false; });
+
+		if (first || first_uv)
+			attach_resize_filter(std::move(first), std::move(first_uv), greyscale_mask);
+		if (second || second_uv)
+			attach_resize_filter(std::move(second), std::move(second_uv), greyscale_mask);
 
 		apply_mask(mask, [&](int q)
 		{
@@ -768,7 +1054,7 @@ private:
 	void convert_colorspace(const colorspace::ColorspaceDefinition &csp, const params &params, FilterObserver &observer)
 	{
 		iassert(m_state.color != ColorFamily::GREY);
-		check_is_444_float(false);
+		check_is_444_float(false, true, m_state.color == ColorFamily::RGB);
 
 		if (m_state.colorspace == csp)
 			return;
@@ -777,16 +1063,28 @@ private:
 		conv.set_csp_in(m_state.colorspace)
 			.set_csp_out(csp)
 			.set_approximate_gamma(params.approximate_gamma)
+			.set_approximate_colorspace(params.approximate_colorspace)
 			.set_scene_referred(params.scene_referred)
+			.set_tone_mapping(params.tone_mapping)
+			.set_pixel_in(m_state.planes[PLANE_Y].format)
 			.set_cpu(params.cpu);
 		if (!std::isnan(params.peak_luminance))
 			conv.set_peak_luminance(params.peak_luminance);
+		if (!std::isnan(params.source_peak_luminance))
+			conv.set_source_peak_luminance(params.source_peak_luminance);
 
 		observer.colorspace(conv);
 
 		auto filter = conv.create();
 		attach_filter(std::move(filter), m_ids & (luma_planes | chroma_planes), luma_planes | chroma_planes);
 
+		// Integer input is converted to FLOAT.
+		if (pixel_is_integer(m_state.planes[PLANE_Y].format.type)) {
+			m_state.planes[PLANE_Y].format = PixelType::FLOAT;
+			m_state.planes[PLANE_U].format = PixelType::FLOAT;
+			m_state.planes[PLANE_V].format = PixelType::FLOAT;
+		}
+
 		if (csp.matrix == colorspace::MatrixCoefficients::RGB) {
 			m_state.color = ColorFamily::RGB;
 			m_state.planes[PLANE_U].format.chroma = false;
@@ -812,8 +1110,8 @@ private:
 
 		observer.depth(conv, p);
 
-		auto filter = conv.create();
-		attach_greyscale_filter(std::move(filter), mask, true);
+		std::shared_ptr<ImageFilter> filter = conv.create();
+		apply_mask(mask, [&](int q) { attach_depth(filter, q); });
 
 		apply_mask(mask, [&](int q) { m_state.planes[q].format = format; });
 	}
@@ -887,6 +1185,18 @@ private:
 			tmp.planes[PLANE_Y].active_width = w.planes[PLANE_Y].active_width;
 			tmp.planes[PLANE_Y].active_height = h.planes[PLANE_Y].active_height;
 
+			// Keep HALF end-to-end if the colorspace conversion can process it directly.
+			if (m_state.planes[PLANE_Y].format.type == PixelType::HALF && target.planes[PLANE_Y].format.type == PixelType::HALF &&
+			    !params.unresize && cpu_has_fast_f16(params.cpu))
+			{
+				tmp.planes[PLANE_Y].format = PixelType::HALF;
+			}
+
+			// Integer RGB is converted to FLOAT by the colorspace conversion, which
+			// also linearizes it in the same table lookup.
+			if (can_convert_colorspace_integer(tmp))
+				tmp.planes[PLANE_Y].format = m_state.planes[PLANE_Y].format;
+
 			if (tmp.has_chroma())
 				tmp.chroma_from_luma_444();
 
@@ -929,14 +1239,18 @@ private:
 	void connect_internal(internal_state &target, const params &params, FilterObserver &observer)
 	{
 		if (needs_premul(target)) {
+			flush_pending(alpha_planes);
+
 			internal_state::plane orig_alpha_plane = m_state.planes[PLANE_A];
 			node_id orig_alpha_node = m_ids[PLANE_A];
 
-			internal_state tmp = make_float_444_state(m_state, true);
-			connect_color_channels(tmp, params, observer);
-			connect_plane(tmp, params, observer, ConnectMode::ALPHA, false);
+			if (!can_premultiply_integer(target)) {
+				internal_state tmp = make_float_444_state(m_state, true);
+				connect_color_channels(tmp, params, observer);
+				connect_plane(tmp, params, observer, ConnectMode::ALPHA, false);
+			}
 
-			premultiply(observer);
+			premultiply(params, observer);
 
 			if (target.has_alpha() && target.planes[PLANE_A] == orig_alpha_plane) {
 				m_ids[PLANE_A] = orig_alpha_node;
@@ -951,6 +1265,8 @@ private:
 		}
 
 		if (m_state.alpha == AlphaType::PREMULTIPLIED && target.alpha == AlphaType::STRAIGHT) {
+			flush_pending(alpha_planes);
+
 			internal_state::plane orig_alpha_plane = m_state.planes[PLANE_A];
 			node_id orig_alpha_node = m_ids[PLANE_A];
 
@@ -958,7 +1274,7 @@ private:
 			connect_color_channels(tmp, params, observer);
 			connect_plane(tmp, params, observer, ConnectMode::ALPHA, false);
 
-			unpremultiply(observer);
+			unpremultiply(params, observer);
 
 			if (target.has_alpha() && target.planes[PLANE_A] == orig_alpha_plane) {
 				m_ids[PLANE_A] = orig_alpha_node;
@@ -978,8 +1294,100 @@ private:
 		if (m_state != target)
 			error::throw_<error::InternalError>("failed to connect graph");
 	}
+
+	void defer_deinterleave(int src_plane, const component_map &components, unsigned num_components, unsigned shift)
+	{
+		const internal_state::plane &plane = m_state.planes[src_plane];
+		node_id src_id = m_ids[src_plane];
+
+		m_pending_splits.push_back({ { plane.width, plane.height, plane.format.type }, src_id, src_plane, components, num_components, shift });
+
+		// Until the split is attached, its components refer to the packed plane.
+		for (unsigned k = 0; k < num_components; ++k) {
+			m_ids[components[k]] = src_id;
+		}
+	}
+
+	void attach_interleave(int dst_plane, const component_map &components, unsigned num_components, unsigned shift, const plane_mask &outputs)
+	{
+		const internal_state::plane &plane = m_state.planes[dst_plane];
+		component_filters convert{};
+		plane_mask inputs{};
+		bool fuse = true;
+
+		for (unsigned k = 0; k < num_components; ++k) {
+			int p = components[k];
+
+			convert[k] = m_pending_depth[p];
+			inputs[p] = true;
+
+			if (is_split_pending(p) || !convert[k] || convert[k]->get_image_attributes().type != plane.format.type)
+				fuse = false;
+		}
+
+		std::shared_ptr<ImageFilter> filter;
+
+		if (fuse) {
+			filter = std::make_shared<InterleaveConvertFilter>(
+				plane.width, plane.height, plane.format.type, dst_plane, components, num_components, shift, convert, m_cpu);
+			apply_mask(inputs, [&](int p) { m_pending_depth[p].reset(); });
+		} else {
+			filter = std::make_shared<InterleaveFilter>(
+				plane.width, plane.height, plane.format.type, dst_plane, components, num_components, shift, m_cpu);
+		}
+
+		attach_filter(std::move(filter), m_ids & inputs, outputs);
+	}
+
+	// Splits the packed source planes. Deferred until the CPU type is known.
+	void deinterleave_source()
+	{
+		if (m_source_packing == Packing::PLANAR)
+			return;
+
+		component_map components{};
+		unsigned num_components = packed_components(m_source_packing, m_state.has_chroma(), m_state.has_alpha(), &components);
+		unsigned shift = m_source_packing == Packing::SEMIPLANAR_MSB ? pixel_depth(PixelType::WORD) - m_state.planes[PLANE_Y].format.depth : 0;
+
+		defer_deinterleave(is_semiplanar(m_source_packing) ? PLANE_U : PLANE_Y, components, num_components, shift);
+
+		// The remaining planes of an MSB-aligned image are shifted in place.
+		if (shift) {
+			defer_deinterleave(PLANE_Y, { PLANE_Y }, 1, shift);
+			if (m_state.has_alpha())
+				defer_deinterleave(PLANE_A, { PLANE_A }, 1, shift);
+		}
+
+		m_source_packing = Packing::PLANAR;
+	}
+
+	void interleave_output()
+	{
+		if (m_packing == Packing::PLANAR)
+			return;
+
+		component_map components{};
+		unsigned num_components = packed_components(m_packing, m_state.has_chroma(), m_state.has_alpha(), &components);
+		unsigned shift = m_packing == Packing::SEMIPLANAR_MSB ? pixel_depth(PixelType::WORD) - m_state.planes[PLANE_Y].format.depth : 0;
+
+		if (is_interleaved(m_packing)) {
+			attach_interleave(PLANE_Y, components, num_components, shift, luma_planes);
+			m_ids = m_ids & luma_planes;
+			return;
+		}
+
+		// Semi-planar chroma is written to the U plane. The V plane is kept in
+		// the output map so that the sink retains the chroma subsampling.
+		attach_interleave(PLANE_U, components, num_components, shift, chroma_planes);
+
+		if (shift) {
+			attach_interleave(PLANE_Y, { PLANE_Y }, 1, shift, luma_planes);
+			if (m_state.has_alpha())
+				attach_interleave(PLANE_A, { PLANE_A }, 1, shift, alpha_planes);
+		}
+	}
 public:
-	impl() : m_ids(null_ids), m_state{} {}
+	impl() : m_ids(null_ids), m_state{}, m_source_packing{}, m_packing{}, m_cpu{ CPUClass::AUTO } {}
 
 	void set_source(const state &source)
 	{
@@ -988,15 +1396,19 @@ public:
 
 		m_graph = ztd::make_unique<FilterGraph>();
 		m_ids = null_ids;
+		m_pending_splits.clear();
+		m_pending_depth = {};
 		m_state = internal_state{ source };
+		m_source_packing = source.packing;
+		m_packing = source.packing;
 
 		ImageFilter::image_attributes attr{ source.width, source.height, source.type };
 
 		plane_mask mask{};
 		mask[PLANE_Y] = true;
-		mask[PLANE_U] = m_state.has_chroma();
-		mask[PLANE_V] = m_state.has_chroma();
-		mask[PLANE_A] = m_state.has_alpha();
+		mask[PLANE_U] = m_state.has_chroma() && !is_interleaved(source.packing);
+		mask[PLANE_V] = m_state.has_chroma() && !is_interleaved(source.packing);
+		mask[PLANE_A] = m_state.has_alpha() && !is_interleaved(source.packing);
 
 		node_id id = m_graph->add_source(attr, source.subsample_w, source.subsample_h, mask);
 		apply_mask(mask, [&](int p) { m_ids[p] = id; });
@@ -1007,7 +1419,11 @@ public:
 		if (!m_graph)
 			error::throw_<error::InternalError>("graph not initialized");
 
+		m_cpu = params.cpu;
+		deinterleave_source();
+
 		internal_state internal_target{ target };
+		m_packing = target.packing;
 		connect_internal(internal_target, params, observer);
 	}
 
@@ -1016,6 +1432,10 @@ public:
 		if (!m_graph)
 			error::throw_<error::InternalError>("graph not initialized");
 
+		deinterleave_source();
+		interleave_output();
+		flush_pending({ true, true, true, true });
+
 		m_graph->set_output(m_ids);
 		return std::move(m_graph);
 	}
@@ -1029,7 +1449,10 @@ GraphBuilder::params::params() noexcept :
 	dither_type{},
 	peak_luminance{ NAN },
 	approximate_gamma{},
+	approximate_colorspace{},
 	scene_referred{},
+	tone_mapping{ colorspace::ToneMapping::NONE },
+	source_peak_luminance{ NAN },
 	cpu{ CPUClass::AUTO }
 {
 	static const resize::BicubicFilter bicubic;
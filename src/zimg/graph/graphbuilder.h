@@ -94,6 +94,18 @@ public:
 		BOTTOM,
 	};
 
+	// Memory layout of the image planes. Interleaved images store all color
+	// components and alpha in the first plane. Semi-planar images store the
+	// interleaved chroma components in the second plane. The MSB variant
+	// stores samples in the most significant bits of each word.
+	enum class Packing {
+		PLANAR,
+		INTERLEAVED,
+		INTERLEAVED_BGR,
+		SEMIPLANAR,
+		SEMIPLANAR_MSB,
+	};
+
 	// Canonical state.
 	struct state {
 		unsigned width;
@@ -118,6 +130,7 @@ public:
 		double active_height;
 
 		AlphaType alpha;
+		Packing packing;
 	};
 
 	// Filter instantiation parameters.
@@ -128,7 +141,10 @@ public:
 		depth::DitherType dither_type;
 		double peak_luminance;
 		bool approximate_gamma;
+		bool approximate_colorspace;
 		bool scene_referred;
+		colorspace::ToneMapping tone_mapping;
+		double source_peak_luminance;
 		CPUClass cpu;
 
 		params() noexcept;
@@ -181,7 +197,8 @@ public:
 	/**
 	 * Finalize and return a complete filter graph.
 	 *
-	 * Returns a graph with the output node set to the current format.
+	 * Returns a graph with the output node set to the current format. The
+	 * output planes are stored with the packing of the last connected target.
 	 *
 	 * @return graph
 	 */
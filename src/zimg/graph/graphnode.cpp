@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <climits>
 #include <type_traits>
+#include <utility>
 #include "common/alloc.h"
 #include "common/make_unique.h"
 #include "common/pixel.h"
@@ -13,11 +14,32 @@ namespace graph {
 
 namespace {
 
+#ifndef NDEBUG
+// Debug builds end every cache in the arena with a guard page.
+constexpr size_t GUARD_PAGE_SIZE = 4096;
+#else
+constexpr size_t GUARD_PAGE_SIZE = 0;
+#endif
+
 constexpr plane_mask nodes_to_mask(const node_map &nodes)
 {
 	return{ !!nodes[0], !!nodes[1], !!nodes[2], !!nodes[3] };
 }
 
+plane_mask cache_planes(const GraphNode &node)
+{
+	return node.is_sourcesink() ? node.get_scratch_planes() : node.get_plane_mask();
+}
+
+checked_size_t cache_plane_size(const GraphNode &node, int plane, unsigned cache_lines)
+{
+	auto attr = node.get_image_attributes(plane);
+	unsigned shift_h = plane == PLANE_U || plane == PLANE_V ? node.get_subsample_h() : 0;
+
+	checked_size_t stride = ceil_n(checked_size_t{ attr.width } * pixel_size(attr.type), ALIGNMENT);
+	return stride * (cache_lines >> shift_h);
+}
+
 void validate_plane_mask(const plane_mask &planes)
 {
 	if (!planes[PLANE_Y])
@@ -47,6 +69,7 @@ public:
 	unsigned get_subsample_w() const override { return m_subsample_w; }
 	unsigned get_subsample_h() const override { return m_subsample_h; }
 	plane_mask get_plane_mask() const override { return m_planes; }
+	plane_mask get_scratch_planes() const override { return{}; }
 
 	image_attributes get_image_attributes(int plane) const override
 	{
@@ -131,13 +154,15 @@ public:
 
 class SinkNode final : public GraphNode {
 	node_map m_parents;
+	node_map m_scratch;
 	unsigned m_subsample_w;
 	unsigned m_subsample_h;
 	image_attributes m_attr;
 public:
-	explicit SinkNode(node_id id, const node_map &parents) :
+	explicit SinkNode(node_id id, const node_map &parents, const node_map &scratch) :
 		GraphNode(id),
 		m_parents(parents),
+		m_scratch(scratch),
 		m_subsample_w{},
 		m_subsample_h{},
 		m_attr{}
@@ -175,11 +200,12 @@ public:
 	unsigned get_subsample_w() const override { return m_subsample_w; }
 	unsigned get_subsample_h() const override { return m_subsample_h; }
 	plane_mask get_plane_mask() const override { return nodes_to_mask(m_parents); }
+	plane_mask get_scratch_planes() const override { return nodes_to_mask(m_scratch); }
 
 	image_attributes get_image_attributes(int plane) const override
 	{
-		zassert_d(m_parents[plane], "plane not present");
-		return m_parents[plane]->get_image_attributes(plane);
+		zassert_d(m_parents[plane] || m_scratch[plane], "plane not present");
+		return m_parents[plane] ? m_parents[plane]->get_image_attributes(plane) : m_scratch[plane]->get_image_attributes(plane);
 	}
 
 	void try_inplace() override
@@ -218,6 +244,8 @@ public:
 			if (m_parents[PLANE_A]) {
 				m_parents[PLANE_A]->simulate(state, cursor, cursor + (1U << m_subsample_h), PLANE_A);
 			}
+
+			state->record_access(cache_id(), state->next_event());
 		}
 		state->update(id(), cache_id(), first, cursor, PLANE_Y);
 	}
@@ -317,6 +345,7 @@ public:
 	unsigned get_subsample_w() const override { return 0; }
 	unsigned get_subsample_h() const override { return 0; }
 	plane_mask get_plane_mask() const override { return m_output_planes; }
+	plane_mask get_scratch_planes() const override { return{}; }
 
 	image_attributes get_image_attributes(int plane) const override
 	{
@@ -341,6 +370,15 @@ public:
 				if (m_parents[p])
 					m_parents[p]->simulate(state, range.first, range.second, p);
 			}
+
+			// Corresponds to a call to ImageFilter::process, which reads the parent buffers and writes the node buffer.
+			unsigned event = state->next_event();
+			state->record_access(cache_id(), event);
+
+			for (const GraphNode *node : m_parents) {
+				if (node)
+					state->record_access(node->cache_id(), event);
+			}
 		}
 		state->update(id(), cache_id(), first, cursor, plane);
 	}
@@ -517,7 +555,7 @@ public:
 } // namespace
 
 
-SimulationState::SimulationState(const std::vector<std::unique_ptr<GraphNode>> &nodes) : m_state(nodes.size()), m_tmp{}
+SimulationState::SimulationState(const std::vector<std::unique_ptr<GraphNode>> &nodes) : m_state(nodes.size()), m_tmp{}, m_event{}
 {
 	for (const auto &node : nodes) {
 		m_state[node->cache_id()].subsample_h = std::max(m_state[node->cache_id()].subsample_h, node->get_subsample_h());
@@ -527,7 +565,7 @@ SimulationState::SimulationState(const std::vector<std::unique_ptr<GraphNode>> &
 SimulationState::result SimulationState::get_result(const std::vector<std::unique_ptr<GraphNode>> &nodes) const
 {
 	zassert_d(nodes.size() == m_state.size(), "incorrect number of nodes");
-	result res{ std::vector<result::s>(m_state.size()), m_tmp };
+	result res{ std::vector<result::s>(m_state.size()), m_tmp, 0 };
 
 	for (const auto &node : nodes) {
 		unsigned history = m_state[node->id()].cache_history;
@@ -546,6 +584,76 @@ SimulationState::result SimulationState::get_result(const std::vector<std::uniqu
 		res.node_result[node->id()].context_size = m_state[node->id()].context_size;
 	}
 
+	// Assign each node buffer an offset in a common arena. Buffers that are never accessed during the same interval of
+	// the simulation, such as the input and output of a filter processing an entire plane, may share memory.
+	struct block {
+		node_id id;
+		size_t size;
+		unsigned first;
+		unsigned last;
+	};
+
+	std::vector<block> blocks;
+	std::vector<size_t> candidates;
+	checked_size_t cache_size = 0;
+
+	for (const auto &node : nodes) {
+		const state &s = m_state[node->id()];
+		plane_mask planes = cache_planes(*node);
+		checked_size_t size = 0;
+
+		for (int p = 0; p < PLANE_NUM; ++p) {
+			if (planes[p])
+				size += cache_plane_size(*node, p, res.node_result[node->id()].cache_lines);
+		}
+
+		if (size.get())
+			blocks.push_back({ node->id(), (size + GUARD_PAGE_SIZE).get(), s.live ? s.live_first : 0, s.live ? s.live_last : UINT_MAX });
+	}
+
+	std::stable_sort(blocks.begin(), blocks.end(), [](const block &a, const block &b) { return a.size > b.size; });
+
+	auto overlaps = [](size_t a_first, size_t a_last, size_t b_first, size_t b_last) { return a_first < b_last && b_first < a_last; };
+
+	// Blocks that are live at the same time may not overlap. Guard pages are checked throughout the frame, so a guard
+	// page may not overlap any other block either, except for an identically placed guard page.
+	auto conflicts = [&](const block &a, size_t a_offset, const block &b, size_t b_offset)
+	{
+		size_t a_end = a_offset + a.size;
+		size_t b_end = b_offset + b.size;
+
+		if (a.first <= b.last && b.first <= a.last)
+			return overlaps(a_offset, a_end, b_offset, b_end);
+
+		return overlaps(a_offset, a_end - GUARD_PAGE_SIZE, b_end - GUARD_PAGE_SIZE, b_end) ||
+		       overlaps(a_end - GUARD_PAGE_SIZE, a_end, b_offset, b_end - GUARD_PAGE_SIZE);
+	};
+
+	for (auto it = blocks.begin(); it != blocks.end(); ++it) {
+		candidates.assign(1, 0);
+
+		for (auto prev = blocks.begin(); prev != it; ++prev) {
+			size_t prev_end = res.node_result[prev->id].cache_offset + prev->size;
+
+			candidates.push_back(prev_end);
+			if (prev_end >= it->size)
+				candidates.push_back(prev_end - it->size);
+		}
+		std::sort(candidates.begin(), candidates.end());
+
+		size_t offset = 0;
+		for (size_t candidate : candidates) {
+			offset = candidate;
+
+			if (std::none_of(blocks.begin(), it, [&](const block &prev) { return conflicts(*it, candidate, prev, res.node_result[prev.id].cache_offset); }))
+				break;
+		}
+
+		res.node_result[it->id].cache_offset = offset;
+		cache_size = std::max(cache_size.get(), (checked_size_t{ offset } + it->size).get());
+	}
+	res.cache_size = cache_size.get();
+
 	return res;
 }
 
@@ -582,12 +690,22 @@ void SimulationState::alloc_tmp(size_t sz)
 	m_tmp = std::max(m_tmp, sz);
 }
 
+void SimulationState::record_access(node_id cache_id, unsigned event)
+{
+	zassert_d(cache_id >= 0, "invalid id");
+	state &s = m_state[cache_id];
+
+	s.live_first = s.live ? std::min(s.live_first, event) : event;
+	s.live_last = s.live ? std::max(s.live_last, event) : event;
+	s.live = true;
+}
+
 
 #ifndef NDEBUG
 class ExecutionState::guard_page {
 	static constexpr uint32_t pattern = 0xDEADBEEF;
 
-	uint32_t page[4096 / sizeof(uint32_t)];
+	uint32_t page[GUARD_PAGE_SIZE / sizeof(uint32_t)];
 public:
 	template <class Alloc>
 	static void allocate(Alloc &alloc) { alloc.template allocate_n<guard_page>(1); }
@@ -628,27 +746,7 @@ size_t ExecutionState::calculate_tmp_size(const SimulationState::result &sim, co
 	alloc.allocate_n<guard_page *>(nodes.size() * 2 + 2 + 1); // m_guard_pages
 #endif
 
-	for (const auto &node : nodes) {
-		guard_page::allocate(alloc);
-
-		if (node->is_sourcesink())
-			continue;
-
-		plane_mask planes = node->get_plane_mask();
-		unsigned cache_lines = sim.node_result[node->id()].cache_lines;
-
-		for (int p = 0; p < PLANE_NUM; ++p) {
-			if (!planes[p])
-				continue;
-
-			auto attr = node->get_image_attributes(p);
-			unsigned shift_h = p == PLANE_U || p == PLANE_V ? node->get_subsample_h() : 0;
-
-			checked_size_t stride = ceil_n(checked_size_t{ attr.width } * pixel_size(attr.type), ALIGNMENT);
-			unsigned plane_lines = cache_lines >> shift_h;
-			alloc.allocate(stride * plane_lines);
-		}
-	}
+	alloc.allocate(sim.cache_size);
 
 	for (const auto &node : nodes) {
 		guard_page::allocate(alloc);
@@ -685,16 +783,14 @@ ExecutionState::ExecutionState(const SimulationState::result &sim, const std::ve
 #endif
 
 	guard_page **guard_pages = m_guard_pages;
+	unsigned char *cache = alloc.allocate<unsigned char>(sim.cache_size);
 
 	for (const auto &node : nodes) {
-		guard_page::allocate(guard_pages, alloc);
-
-		if (node->is_sourcesink())
-			continue;
-
-		plane_mask planes = node->get_plane_mask();
+		plane_mask planes = cache_planes(*node);
 		ColorImageBuffer<void> &buffer = m_buffers[node->id()];
 		const auto &node_sim = sim.node_result[node->id()];
+		LinearAllocator node_alloc{ cache + node_sim.cache_offset };
+		size_t block_size = 0;
 
 		for (int p = 0; p < PLANE_NUM; ++p) {
 			if (!planes[p])
@@ -706,8 +802,12 @@ ExecutionState::ExecutionState(const SimulationState::result &sim, const std::ve
 			size_t stride = ceil_n(static_cast<size_t>(attr.width) * pixel_size(attr.type), ALIGNMENT);
 			unsigned plane_lines = node_sim.cache_lines >> shift_h;
 			unsigned mask = node_sim.mask == BUFFER_MAX ? BUFFER_MAX : node_sim.mask >> shift_h;
-			buffer[p] = { alloc.allocate(stride * plane_lines), static_cast<ptrdiff_t>(stride), mask };
+			buffer[p] = { node_alloc.allocate(stride * plane_lines), static_cast<ptrdiff_t>(stride), mask };
+			block_size += stride * plane_lines;
 		}
+
+		if (block_size)
+			guard_page::allocate(guard_pages, node_alloc);
 	}
 
 	for (const auto &node : nodes) {
@@ -718,7 +818,11 @@ ExecutionState::ExecutionState(const SimulationState::result &sim, const std::ve
 	for (int p = 0; p < PLANE_NUM; ++p) {
 		m_buffers[src_id][p] = { const_cast<void *>(src[p].data()), src[p].stride(), src[p].mask() };
 	}
-	m_buffers[dst_id] = { dst[0], dst[1], dst[2], dst[3] };
+	plane_mask scratch = nodes[dst_id]->get_scratch_planes();
+	for (int p = 0; p < PLANE_NUM; ++p) {
+		if (!scratch[p])
+			m_buffers[dst_id][p] = dst[p];
+	}
 
 	guard_page::allocate(guard_pages, alloc);
 	m_tmp = alloc.allocate(sim.shared_tmp);
@@ -765,9 +869,9 @@ std::unique_ptr<GraphNode> make_source_node(node_id id, const ImageFilter::image
 	return ztd::make_unique<SourceNode>(id, attr, subsample_w, subsample_h, planes);
 }
 
-std::unique_ptr<GraphNode> make_sink_node(node_id id, const node_map &parents)
+std::unique_ptr<GraphNode> make_sink_node(node_id id, const node_map &parents, const node_map &scratch)
 {
-	return ztd::make_unique<SinkNode>(id, parents);
+	return ztd::make_unique<SinkNode>(id, parents, scratch);
 }
 
 std::unique_ptr<GraphNode> make_filter_node(node_id id, std::shared_ptr<ImageFilter> filter, const node_map &parents, const plane_mask &output_planes)
@@ -22,10 +22,12 @@ public:
 			unsigned cache_lines;
 			unsigned mask;
 			size_t context_size;
+			size_t cache_offset;
 		};
 
 		std::vector<s> node_result;
 		size_t shared_tmp;
+		size_t cache_size;
 	};
 private:
 	struct state {
@@ -34,11 +36,15 @@ private:
 		unsigned cache_history;
 		unsigned cursor;
 		unsigned subsample_h;
+		unsigned live_first;
+		unsigned live_last;
 		bool cursor_initialized;
+		bool live;
 	};
 
 	std::vector<state> m_state;
 	size_t m_tmp;
+	unsigned m_event;
 public:
 	explicit SimulationState(const std::vector<std::unique_ptr<GraphNode>> &nodes);
 
@@ -51,6 +57,10 @@ public:
 	void alloc_context(node_id id, size_t sz);
 
 	void alloc_tmp(size_t sz);
+
+	unsigned next_event() { return m_event++; }
+
+	void record_access(node_id cache_id, unsigned event);
 };
 
 
@@ -130,6 +140,8 @@ public:
 
 	virtual plane_mask get_plane_mask() const = 0;
 
+	virtual plane_mask get_scratch_planes() const = 0;
+
 	virtual image_attributes get_image_attributes(int plane) const = 0;
 
 	virtual void simulate(SimulationState *state, unsigned first, unsigned last, int plane) const = 0;
@@ -151,7 +163,7 @@ typedef std::array<GraphNode *, PLANE_NUM> node_map;
 
 std::unique_ptr<GraphNode> make_source_node(node_id id, const ImageFilter::image_attributes &attr, unsigned subsample_w, unsigned subsample_h, const plane_mask &planes);
 
-std::unique_ptr<GraphNode> make_sink_node(node_id id, const node_map &parents);
+std::unique_ptr<GraphNode> make_sink_node(node_id id, const node_map &parents, const node_map &scratch);
 
 std::unique_ptr<GraphNode> make_filter_node(node_id id, std::shared_ptr<ImageFilter> filter, const node_map &parents, const plane_mask &output_planes);
 
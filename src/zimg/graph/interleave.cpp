@@ -0,0 +1,370 @@
+#include <algorithm>
+#include <cstdint>
+#include "common/align.h"
+#include "common/checked_int.h"
+#include "common/except.h"
+#include "common/pixel.h"
+#include "common/zassert.h"
+#include "image_buffer.h"
+#include "interleave.h"
+
+#if defined(ZIMG_X86)
+  #include "x86/interleave_x86.h"
+#elif defined(ZIMG_ARM)
+  #include "arm/interleave_arm.h"
+#endif
+
+namespace zimg {
+namespace graph {
+
+namespace {
+
+template <class T, unsigned N>
+void deinterleave_c(const void *src, void * const dst[], unsigned shift, unsigned left, unsigned right)
+{
+	const T *src_p = static_cast<const T *>(src);
+
+	for (unsigned j = left; j < right; ++j) {
+		for (unsigned k = 0; k < N; ++k) {
+			static_cast<T *>(dst[k])[j] = static_cast<T>(src_p[j * N + k] >> shift);
+		}
+	}
+}
+
+template <class T, unsigned N>
+void interleave_c(const void * const src[], void *dst, unsigned shift, unsigned left, unsigned right)
+{
+	T *dst_p = static_cast<T *>(dst);
+
+	for (unsigned j = left; j < right; ++j) {
+		for (unsigned k = 0; k < N; ++k) {
+			dst_p[j * N + k] = static_cast<T>(static_cast<const T *>(src[k])[j] << shift);
+		}
+	}
+}
+
+template <class T>
+deinterleave_func select_deinterleave_func_c(unsigned num_components)
+{
+	switch (num_components) {
+	case 1: return deinterleave_c<T, 1>;
+	case 2: return deinterleave_c<T, 2>;
+	case 3: return deinterleave_c<T, 3>;
+	case 4: return deinterleave_c<T, 4>;
+	default: error::throw_<error::InternalError>("unsupported number of components");
+	}
+}
+
+template <class T>
+interleave_func select_interleave_func_c(unsigned num_components)
+{
+	switch (num_components) {
+	case 1: return interleave_c<T, 1>;
+	case 2: return interleave_c<T, 2>;
+	case 3: return interleave_c<T, 3>;
+	case 4: return interleave_c<T, 4>;
+	default: error::throw_<error::InternalError>("unsupported number of components");
+	}
+}
+
+deinterleave_func select_deinterleave_func(PixelType type, unsigned num_components, CPUClass cpu)
+{
+	deinterleave_func func = nullptr;
+
+#if defined(ZIMG_X86)
+	func = select_deinterleave_func_x86(type, num_components, cpu);
+#elif defined(ZIMG_ARM)
+	func = select_deinterleave_func_arm(type, num_components, cpu);
+#endif
+	if (func)
+		return func;
+
+	// Samples are moved bit-for-bit, so HALF and FLOAT are handled as integers.
+	switch (pixel_size(type)) {
+	case 1: return select_deinterleave_func_c<uint8_t>(num_components);
+	case 2: return select_deinterleave_func_c<uint16_t>(num_components);
+	case 4: return select_deinterleave_func_c<uint32_t>(num_components);
+	default: error::throw_<error::InternalError>("unsupported pixel type");
+	}
+}
+
+interleave_func select_interleave_func(PixelType type, unsigned num_components, CPUClass cpu)
+{
+	interleave_func func = nullptr;
+
+#if defined(ZIMG_X86)
+	func = select_interleave_func_x86(type, num_components, cpu);
+#elif defined(ZIMG_ARM)
+	func = select_interleave_func_arm(type, num_components, cpu);
+#endif
+	if (func)
+		return func;
+
+	switch (pixel_size(type)) {
+	case 1: return select_interleave_func_c<uint8_t>(num_components);
+	case 2: return select_interleave_func_c<uint16_t>(num_components);
+	case 4: return select_interleave_func_c<uint32_t>(num_components);
+	default: error::throw_<error::InternalError>("unsupported pixel type");
+	}
+}
+
+ImageFilter::filter_flags convert_flags(const component_filters &convert, unsigned num_components)
+{
+	ImageFilter::filter_flags flags{};
+	flags.color = true;
+	flags.same_row = true;
+
+	for (unsigned k = 0; k < num_components; ++k) {
+		if (!convert[k])
+			continue;
+
+		ImageFilter::filter_flags convert_flags = convert[k]->get_flags();
+		flags.has_state = flags.has_state || convert_flags.has_state;
+		flags.entire_row = flags.entire_row || convert_flags.entire_row;
+	}
+	return flags;
+}
+
+const ImageFilter &first_convert(const component_filters &convert, unsigned num_components)
+{
+	for (unsigned k = 0; k < num_components; ++k) {
+		if (convert[k])
+			return *convert[k];
+	}
+	error::throw_<error::InternalError>("no conversion");
+}
+
+void check_convert(const component_filters &convert, unsigned num_components, unsigned width, unsigned height)
+{
+	for (unsigned k = 0; k < num_components; ++k) {
+		if (!convert[k])
+			continue;
+
+		zassert_d(!convert[k]->get_flags().color && convert[k]->get_flags().same_row, "conversion must be a greyscale point filter");
+		zassert_d(convert[k]->get_image_attributes().width == width && convert[k]->get_image_attributes().height == height, "conversion dimensions mismatch");
+		zassert_d(convert[k]->get_image_attributes().type == first_convert(convert, num_components).get_image_attributes().type, "conversion type mismatch");
+	}
+}
+
+size_t convert_context_size(const component_filters &convert, unsigned num_components)
+{
+	size_t size = 0;
+
+	for (unsigned k = 0; k < num_components; ++k) {
+		if (convert[k])
+			size = std::max(size, ceil_n(convert[k]->get_context_size(), ALIGNMENT));
+	}
+	return size;
+}
+
+size_t convert_tmp_size(const component_filters &convert, unsigned num_components, size_t row_size, unsigned left, unsigned right)
+{
+	size_t size = 0;
+
+	for (unsigned k = 0; k < num_components; ++k) {
+		if (convert[k])
+			size = std::max(size, convert[k]->get_tmp_size(left, right));
+	}
+	return (static_cast<checked_size_t>(row_size) * num_components + size).get();
+}
+
+size_t staging_row_size(unsigned width, PixelType type)
+{
+	return ceil_n(static_cast<checked_size_t>(width) * pixel_size(type), ALIGNMENT).get();
+}
+
+} // namespace
+
+
+DeinterleaveFilter::DeinterleaveFilter(unsigned width, unsigned height, PixelType type, int src_plane, const component_map &components, unsigned num_components, unsigned shift, CPUClass cpu) :
+	m_func{},
+	m_attr{ width, height, type },
+	m_components(components),
+	m_num_components{ num_components },
+	m_src_plane{ src_plane },
+	m_shift{ shift }
+{
+	zassert_d(num_components >= 1 && num_components <= PLANE_NUM, "invalid number of components");
+	zassert_d(!shift || type == PixelType::WORD, "shift requires WORD samples");
+	m_func = select_deinterleave_func(type, num_components, cpu);
+}
+
+auto DeinterleaveFilter::get_flags() const -> filter_flags
+{
+	filter_flags flags{};
+	flags.color = true;
+	flags.same_row = true;
+	return flags;
+}
+
+auto DeinterleaveFilter::get_image_attributes() const -> image_attributes { return m_attr; }
+
+void DeinterleaveFilter::process(void *, const ImageBuffer<const void> src[], const ImageBuffer<void> dst[], void *, unsigned i, unsigned left, unsigned right) const
+{
+	void *dst_p[PLANE_NUM]{};
+
+	for (unsigned k = 0; k < m_num_components; ++k) {
+		dst_p[k] = dst[m_components[k]][i];
+	}
+	m_func(src[m_src_plane][i], dst_p, m_shift, left, right);
+}
+
+
+InterleaveFilter::InterleaveFilter(unsigned width, unsigned height, PixelType type, int dst_plane, const component_map &components, unsigned num_components, unsigned shift, CPUClass cpu) :
+	m_func{},
+	m_attr{ width, height, type },
+	m_components(components),
+	m_num_components{ num_components },
+	m_dst_plane{ dst_plane },
+	m_shift{ shift }
+{
+	zassert_d(num_components >= 1 && num_components <= PLANE_NUM, "invalid number of components");
+	zassert_d(!shift || type == PixelType::WORD, "shift requires WORD samples");
+	m_func = select_interleave_func(type, num_components, cpu);
+}
+
+auto InterleaveFilter::get_flags() const -> filter_flags
+{
+	filter_flags flags{};
+	flags.color = true;
+	flags.same_row = true;
+	return flags;
+}
+
+auto InterleaveFilter::get_image_attributes() const -> image_attributes { return m_attr; }
+
+void InterleaveFilter::process(void *, const ImageBuffer<const void> src[], const ImageBuffer<void> dst[], void *, unsigned i, unsigned left, unsigned right) const
+{
+	const void *src_p[PLANE_NUM]{};
+
+	for (unsigned k = 0; k < m_num_components; ++k) {
+		src_p[k] = src[m_components[k]][i];
+	}
+	m_func(src_p, dst[m_dst_plane][i], m_shift, left, right);
+}
+
+
+
+DeinterleaveConvertFilter::DeinterleaveConvertFilter(unsigned width, unsigned height, PixelType type, int src_plane, const component_map &components, unsigned num_components, unsigned shift,
+                                                     const component_filters &convert, CPUClass cpu) :
+	m_deinterleave{ width, height, type, src_plane, components, num_components, shift, cpu },
+	m_convert(convert),
+	m_components(components),
+	m_num_components{ num_components },
+	m_row_size{ staging_row_size(width, type) },
+	m_context_size{}
+{
+	check_convert(convert, num_components, width, height);
+	m_context_size = convert_context_size(convert, num_components);
+}
+
+auto DeinterleaveConvertFilter::get_flags() const -> filter_flags { return convert_flags(m_convert, m_num_components); }
+
+auto DeinterleaveConvertFilter::get_image_attributes() const -> image_attributes
+{
+	return first_convert(m_convert, m_num_components).get_image_attributes();
+}
+
+size_t DeinterleaveConvertFilter::get_context_size() const
+{
+	return (static_cast<checked_size_t>(m_context_size) * m_num_components).get();
+}
+
+size_t DeinterleaveConvertFilter::get_tmp_size(unsigned left, unsigned right) const
+{
+	return convert_tmp_size(m_convert, m_num_components, m_row_size, left, right);
+}
+
+void DeinterleaveConvertFilter::init_context(void *ctx, unsigned) const
+{
+	unsigned char *ctx_p = static_cast<unsigned char *>(ctx);
+
+	// Each component is seeded as if it were converted by its own node.
+	for (unsigned k = 0; k < m_num_components; ++k) {
+		if (m_convert[k])
+			m_convert[k]->init_context(ctx_p + k * m_context_size, m_components[k]);
+	}
+}
+
+void DeinterleaveConvertFilter::process(void *ctx, const ImageBuffer<const void> src[], const ImageBuffer<void> dst[], void *tmp, unsigned i, unsigned left, unsigned right) const
+{
+	unsigned char *ctx_p = static_cast<unsigned char *>(ctx);
+	unsigned char *tmp_p = static_cast<unsigned char *>(tmp);
+	void *convert_tmp = tmp_p + m_row_size * m_num_components;
+
+	// Every row of a staging buffer refers to the same memory.
+	ImageBuffer<void> staging[PLANE_NUM];
+	for (unsigned k = 0; k < m_num_components; ++k) {
+		staging[m_components[k]] = { tmp_p + k * m_row_size, 0, 0 };
+	}
+
+	m_deinterleave.process(nullptr, src, staging, nullptr, i, left, right);
+
+	for (unsigned k = 0; k < m_num_components; ++k) {
+		int p = m_components[k];
+		ImageBuffer<const void> convert_src = staging[p];
+
+		if (m_convert[k])
+			m_convert[k]->process(ctx_p + k * m_context_size, &convert_src, dst + p, convert_tmp, i, left, right);
+	}
+}
+
+
+InterleaveConvertFilter::InterleaveConvertFilter(unsigned width, unsigned height, PixelType type, int dst_plane, const component_map &components, unsigned num_components, unsigned shift,
+                                                 const component_filters &convert, CPUClass cpu) :
+	m_interleave{ width, height, type, dst_plane, components, num_components, shift, cpu },
+	m_convert(convert),
+	m_components(components),
+	m_num_components{ num_components },
+	m_row_size{ staging_row_size(width, type) },
+	m_context_size{}
+{
+	check_convert(convert, num_components, width, height);
+	zassert_d(std::all_of(convert.begin(), convert.begin() + num_components, [](const std::shared_ptr<ImageFilter> &f) { return !!f; }), "missing conversion");
+	zassert_d(convert[0]->get_image_attributes().type == type, "conversion type mismatch");
+	m_context_size = convert_context_size(convert, num_components);
+}
+
+auto InterleaveConvertFilter::get_flags() const -> filter_flags { return convert_flags(m_convert, m_num_components); }
+
+auto InterleaveConvertFilter::get_image_attributes() const -> image_attributes { return m_interleave.get_image_attributes(); }
+
+size_t InterleaveConvertFilter::get_context_size() const
+{
+	return (static_cast<checked_size_t>(m_context_size) * m_num_components).get();
+}
+
+size_t InterleaveConvertFilter::get_tmp_size(unsigned left, unsigned right) const
+{
+	return convert_tmp_size(m_convert, m_num_components, m_row_size, left, right);
+}
+
+void InterleaveConvertFilter::init_context(void *ctx, unsigned) const
+{
+	unsigned char *ctx_p = static_cast<unsigned char *>(ctx);
+
+	for (unsigned k = 0; k < m_num_components; ++k) {
+		m_convert[k]->init_context(ctx_p + k * m_context_size, m_components[k]);
+	}
+}
+
+void InterleaveConvertFilter::process(void *ctx, const ImageBuffer<const void> src[], const ImageBuffer<void> dst[], void *tmp, unsigned i, unsigned left, unsigned right) const
+{
+	unsigned char *ctx_p = static_cast<unsigned char *>(ctx);
+	unsigned char *tmp_p = static_cast<unsigned char *>(tmp);
+	void *convert_tmp = tmp_p + m_row_size * m_num_components;
+
+	ImageBuffer<const void> staging[PLANE_NUM];
+	for (unsigned k = 0; k < m_num_components; ++k) {
+		int p = m_components[k];
+		ImageBuffer<void> convert_dst{ tmp_p + k * m_row_size, 0, 0 };
+
+		m_convert[k]->process(ctx_p + k * m_context_size, src + p, &convert_dst, convert_tmp, i, left, right);
+		staging[p] = convert_dst;
+	}
+
+	m_interleave.process(nullptr, staging, dst, nullptr, i, left, right);
+}
+
+} // namespace graph
+} // namespace zimg
@@ -0,0 +1,125 @@
+#pragma once
+
+#ifndef ZIMG_GRAPH_INTERLEAVE_H_
+#define ZIMG_GRAPH_INTERLEAVE_H_
+
+#include <array>
+#include <memory>
+#include "filtergraph.h"
+#include "image_filter.h"
+
+namespace zimg {
+
+enum class CPUClass;
+enum class PixelType;
+
+namespace graph {
+
+typedef void (*deinterleave_func)(const void *src, void * const dst[], unsigned shift, unsigned left, unsigned right);
+typedef void (*interleave_func)(const void * const src[], void *dst, unsigned shift, unsigned left, unsigned right);
+
+// Maps the i-th interleaved component to a plane index.
+typedef std::array<int, PLANE_NUM> component_map;
+
+// Greyscale filter applied to the i-th interleaved component.
+typedef std::array<std::shared_ptr<ImageFilter>, PLANE_NUM> component_filters;
+
+// Splits a plane of interleaved samples into separate planes.
+//
+// Integer samples may be stored in the most significant bits of each word,
+// in which case they are shifted down to the nominal bit depth. A single
+// component is shifted without deinterleaving.
+class DeinterleaveFilter : public ImageFilterBase {
+	deinterleave_func m_func;
+	image_attributes m_attr;
+	component_map m_components;
+	unsigned m_num_components;
+	int m_src_plane;
+	unsigned m_shift;
+public:
+	DeinterleaveFilter(unsigned width, unsigned height, PixelType type, int src_plane, const component_map &components, unsigned num_components, unsigned shift, CPUClass cpu);
+
+	filter_flags get_flags() const override;
+
+	image_attributes get_image_attributes() const override;
+
+	void process(void *, const ImageBuffer<const void> src[], const ImageBuffer<void> dst[], void *, unsigned i, unsigned left, unsigned right) const override;
+};
+
+// Merges separate planes into a plane of interleaved samples.
+class InterleaveFilter : public ImageFilterBase {
+	interleave_func m_func;
+	image_attributes m_attr;
+	component_map m_components;
+	unsigned m_num_components;
+	int m_dst_plane;
+	unsigned m_shift;
+public:
+	InterleaveFilter(unsigned width, unsigned height, PixelType type, int dst_plane, const component_map &components, unsigned num_components, unsigned shift, CPUClass cpu);
+
+	filter_flags get_flags() const override;
+
+	image_attributes get_image_attributes() const override;
+
+	void process(void *, const ImageBuffer<const void> src[], const ImageBuffer<void> dst[], void *, unsigned i, unsigned left, unsigned right) const override;
+};
+
+// Splits a plane of interleaved samples and converts each component with a
+// greyscale filter, such as a depth conversion, in the same pass.
+//
+// The split components are staged in temporary rows instead of the line
+// caches of separate graph nodes.
+class DeinterleaveConvertFilter : public ImageFilterBase {
+	DeinterleaveFilter m_deinterleave;
+	component_filters m_convert;
+	component_map m_components;
+	unsigned m_num_components;
+	size_t m_row_size;
+	size_t m_context_size;
+public:
+	DeinterleaveConvertFilter(unsigned width, unsigned height, PixelType type, int src_plane, const component_map &components, unsigned num_components, unsigned shift,
+	                          const component_filters &convert, CPUClass cpu);
+
+	filter_flags get_flags() const override;
+
+	image_attributes get_image_attributes() const override;
+
+	size_t get_context_size() const override;
+
+	size_t get_tmp_size(unsigned left, unsigned right) const override;
+
+	void init_context(void *ctx, unsigned seq) const override;
+
+	void process(void *ctx, const ImageBuffer<const void> src[], const ImageBuffer<void> dst[], void *tmp, unsigned i, unsigned left, unsigned right) const override;
+};
+
+// Converts separate planes with greyscale filters and merges the results into
+// a plane of interleaved samples in the same pass.
+class InterleaveConvertFilter : public ImageFilterBase {
+	InterleaveFilter m_interleave;
+	component_filters m_convert;
+	component_map m_components;
+	unsigned m_num_components;
+	size_t m_row_size;
+	size_t m_context_size;
+public:
+	InterleaveConvertFilter(unsigned width, unsigned height, PixelType type, int dst_plane, const component_map &components, unsigned num_components, unsigned shift,
+	                        const component_filters &convert, CPUClass cpu);
+
+	filter_flags get_flags() const override;
+
+	image_attributes get_image_attributes() const override;
+
+	size_t get_context_size() const override;
+
+	size_t get_tmp_size(unsigned left, unsigned right) const override;
+
+	void init_context(void *ctx, unsigned seq) const override;
+
+	void process(void *ctx, const ImageBuffer<const void> src[], const ImageBuffer<void> dst[], void *tmp, unsigned i, unsigned left, unsigned right) const override;
+};
+
+} // namespace graph
+} // namespace zimg
+
+#endif // ZIMG_GRAPH_INTERLEAVE_H_
@@ -0,0 +1,274 @@
+#ifdef ZIMG_X86
+
+#include <cstdint>
+#include <emmintrin.h>
+#include "common/ccdep.h"
+#include "interleave_x86.h"
+
+namespace zimg {
+namespace graph {
+
+namespace {
+
+// Interleaved data has no alignment relative to the planar rows, so all
+// accesses are unaligned. Pixels past the last full vector are handled in C.
+template <class T, unsigned N>
+void deinterleave_tail(const T *src, T * const dst[], unsigned shift, unsigned left, unsigned right)
+{
+	for (unsigned j = left; j < right; ++j) {
+		for (unsigned k = 0; k < N; ++k) {
+			dst[k][j] = static_cast<T>(src[j * N + k] >> shift);
+		}
+	}
+}
+
+template <class T, unsigned N>
+void interleave_tail(const T * const src[], T *dst, unsigned shift, unsigned left, unsigned right)
+{
+	for (unsigned j = left; j < right; ++j) {
+		for (unsigned k = 0; k < N; ++k) {
+			dst[j * N + k] = static_cast<T>(src[k][j] << shift);
+		}
+	}
+}
+
+// Packs the low 16 bits of each dword without saturation.
+inline FORCE_INLINE __m128i pack_lo_epi32(__m128i a, __m128i b)
+{
+	a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+	b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+	return _mm_packs_epi32(a, b);
+}
+
+// Packs the high 16 bits of each dword.
+inline FORCE_INLINE __m128i pack_hi_epi32(__m128i a, __m128i b)
+{
+	a = _mm_srai_epi32(a, 16);
+	b = _mm_srai_epi32(b, 16);
+	return _mm_packs_epi32(a, b);
+}
+
+} // namespace
+
+
+void deinterleave_b2_sse2(const void *src, void * const dst[], unsigned, unsigned left, unsigned right)
+{
+	const uint8_t *src_p = static_cast<const uint8_t *>(src);
+	uint8_t * const dst_p[2] = { static_cast<uint8_t *>(dst[0]), static_cast<uint8_t *>(dst[1]) };
+	const __m128i lomask = _mm_set1_epi16(0x00FF);
+	unsigned j;
+
+	for (j = left; j + 16 <= right; j += 16) {
+		__m128i x0 = _mm_loadu_si128((const __m128i *)(src_p + j * 2 + 0));
+		__m128i x1 = _mm_loadu_si128((const __m128i *)(src_p + j * 2 + 16));
+
+		__m128i c0 = _mm_packus_epi16(_mm_and_si128(x0, lomask), _mm_and_si128(x1, lomask));
+		__m128i c1 = _mm_packus_epi16(_mm_srli_epi16(x0, 8), _mm_srli_epi16(x1, 8));
+
+		_mm_storeu_si128((__m128i *)(dst_p[0] + j), c0);
+		_mm_storeu_si128((__m128i *)(dst_p[1] + j), c1);
+	}
+	deinterleave_tail<uint8_t, 2>(src_p, dst_p, 0, j, right);
+}
+
+void deinterleave_b4_sse2(const void *src, void * const dst[], unsigned, unsigned left, unsigned right)
+{
+	const uint8_t *src_p = static_cast<const uint8_t *>(src);
+	uint8_t * const dst_p[4] = { static_cast<uint8_t *>(dst[0]), static_cast<uint8_t *>(dst[1]), static_cast<uint8_t *>(dst[2]), static_cast<uint8_t *>(dst[3]) };
+	const __m128i lomask = _mm_set1_epi32(0x000000FF);
+	unsigned j;
+
+	for (j = left; j + 16 <= right; j += 16) {
+		__m128i x0 = _mm_loadu_si128((const __m128i *)(src_p + j * 4 + 0));
+		__m128i x1 = _mm_loadu_si128((const __m128i *)(src_p + j * 4 + 16));
+		__m128i x2 = _mm_loadu_si128((const __m128i *)(src_p + j * 4 + 32));
+		__m128i x3 = _mm_loadu_si128((const __m128i *)(src_p + j * 4 + 48));
+
+		for (unsigned k = 0; k < 4; ++k) {
+			__m128i y0 = _mm_and_si128(x0, lomask);
+			__m128i y1 = _mm_and_si128(x1, lomask);
+			__m128i y2 = _mm_and_si128(x2, lomask);
+			__m128i y3 = _mm_and_si128(x3, lomask);
+
+			y0 = _mm_packs_epi32(y0, y1);
+			y2 = _mm_packs_epi32(y2, y3);
+			_mm_storeu_si128((__m128i *)(dst_p[k] + j), _mm_packus_epi16(y0, y2));
+
+			x0 = _mm_srli_epi32(x0, 8);
+			x1 = _mm_srli_epi32(x1, 8);
+			x2 = _mm_srli_epi32(x2, 8);
+			x3 = _mm_srli_epi32(x3, 8);
+		}
+	}
+	deinterleave_tail<uint8_t, 4>(src_p, dst_p, 0, j, right);
+}
+
+void deinterleave_w1_sse2(const void *src, void * const dst[], unsigned shift, unsigned left, unsigned right)
+{
+	const uint16_t *src_p = static_cast<const uint16_t *>(src);
+	uint16_t * const dst_p[1] = { static_cast<uint16_t *>(dst[0]) };
+	const __m128i count = _mm_cvtsi32_si128(shift);
+	unsigned j;
+
+	for (j = left; j + 8 <= right; j += 8) {
+		__m128i x = _mm_loadu_si128((const __m128i *)(src_p + j));
+		_mm_storeu_si128((__m128i *)(dst_p[0] + j), _mm_srl_epi16(x, count));
+	}
+	deinterleave_tail<uint16_t, 1>(src_p, dst_p, shift, j, right);
+}
+
+void deinterleave_w2_sse2(const void *src, void * const dst[], unsigned shift, unsigned left, unsigned right)
+{
+	const uint16_t *src_p = static_cast<const uint16_t *>(src);
+	uint16_t * const dst_p[2] = { static_cast<uint16_t *>(dst[0]), static_cast<uint16_t *>(dst[1]) };
+	const __m128i count = _mm_cvtsi32_si128(shift);
+	unsigned j;
+
+	for (j = left; j + 8 <= right; j += 8) {
+		__m128i x0 = _mm_loadu_si128((const __m128i *)(src_p + j * 2 + 0));
+		__m128i x1 = _mm_loadu_si128((const __m128i *)(src_p + j * 2 + 8));
+
+		__m128i c0 = _mm_srl_epi16(pack_lo_epi32(x0, x1), count);
+		__m128i c1 = _mm_srl_epi16(pack_hi_epi32(x0, x1), count);
+
+		_mm_storeu_si128((__m128i *)(dst_p[0] + j), c0);
+		_mm_storeu_si128((__m128i *)(dst_p[1] + j), c1);
+	}
+	deinterleave_tail<uint16_t, 2>(src_p, dst_p, shift, j, right);
+}
+
+void deinterleave_w4_sse2(const void *src, void * const dst[], unsigned shift, unsigned left, unsigned right)
+{
+	const uint16_t *src_p = static_cast<const uint16_t *>(src);
+	uint16_t * const dst_p[4] = { static_cast<uint16_t *>(dst[0]), static_cast<uint16_t *>(dst[1]), static_cast<uint16_t *>(dst[2]), static_cast<uint16_t *>(dst[3]) };
+	const __m128i count = _mm_cvtsi32_si128(shift);
+	unsigned j;
+
+	for (j = left; j + 8 <= right; j += 8) {
+		__m128i x0 = _mm_loadu_si128((const __m128i *)(src_p + j * 4 + 0));
+		__m128i x1 = _mm_loadu_si128((const __m128i *)(src_p + j * 4 + 8));
+		__m128i x2 = _mm_loadu_si128((const __m128i *)(src_p + j * 4 + 16));
+		__m128i x3 = _mm_loadu_si128((const __m128i *)(src_p + j * 4 + 24));
+
+		// Gather components 0-1 and 2-3 of each pixel into separate qwords.
+		x0 = _mm_shuffle_epi32(x0, _MM_SHUFFLE(3, 1, 2, 0));
+		x1 = _mm_shuffle_epi32(x1, _MM_SHUFFLE(3, 1, 2, 0));
+		x2 = _mm_shuffle_epi32(x2, _MM_SHUFFLE(3, 1, 2, 0));
+		x3 = _mm_shuffle_epi32(x3, _MM_SHUFFLE(3, 1, 2, 0));
+
+		__m128i c01_lo = _mm_unpacklo_epi64(x0, x1);
+		__m128i c23_lo = _mm_unpackhi_epi64(x0, x1);
+		__m128i c01_hi = _mm_unpacklo_epi64(x2, x3);
+		__m128i c23_hi = _mm_unpackhi_epi64(x2, x3);
+
+		_mm_storeu_si128((__m128i *)(dst_p[0] + j), _mm_srl_epi16(pack_lo_epi32(c01_lo, c01_hi), count));
+		_mm_storeu_si128((__m128i *)(dst_p[1] + j), _mm_srl_epi16(pack_hi_epi32(c01_lo, c01_hi), count));
+		_mm_storeu_si128((__m128i *)(dst_p[2] + j), _mm_srl_epi16(pack_lo_epi32(c23_lo, c23_hi), count));
+		_mm_storeu_si128((__m128i *)(dst_p[3] + j), _mm_srl_epi16(pack_hi_epi32(c23_lo, c23_hi), count));
+	}
+	deinterleave_tail<uint16_t, 4>(src_p, dst_p, shift, j, right);
+}
+
+
+void interleave_b2_sse2(const void * const src[], void *dst, unsigned, unsigned left, unsigned right)
+{
+	const uint8_t * const src_p[2] = { static_cast<const uint8_t *>(src[0]), static_cast<const uint8_t *>(src[1]) };
+	uint8_t *dst_p = static_cast<uint8_t *>(dst);
+	unsigned j;
+
+	for (j = left; j + 16 <= right; j += 16) {
+		__m128i c0 = _mm_loadu_si128((const __m128i *)(src_p[0] + j));
+		__m128i c1 = _mm_loadu_si128((const __m128i *)(src_p[1] + j));
+
+		_mm_storeu_si128((__m128i *)(dst_p + j * 2 + 0), _mm_unpacklo_epi8(c0, c1));
+		_mm_storeu_si128((__m128i *)(dst_p + j * 2 + 16), _mm_unpackhi_epi8(c0, c1));
+	}
+	interleave_tail<uint8_t, 2>(src_p, dst_p, 0, j, right);
+}
+
+void interleave_b4_sse2(const void * const src[], void *dst, unsigned, unsigned left, unsigned right)
+{
+	const uint8_t * const src_p[4] = { static_cast<const uint8_t *>(src[0]), static_cast<const uint8_t *>(src[1]), static_cast<const uint8_t *>(src[2]), static_cast<const uint8_t *>(src[3]) };
+	uint8_t *dst_p = static_cast<uint8_t *>(dst);
+	unsigned j;
+
+	for (j = left; j + 16 <= right; j += 16) {
+		__m128i c0 = _mm_loadu_si128((const __m128i *)(src_p[0] + j));
+		__m128i c1 = _mm_loadu_si128((const __m128i *)(src_p[1] + j));
+		__m128i c2 = _mm_loadu_si128((const __m128i *)(src_p[2] + j));
+		__m128i c3 = _mm_loadu_si128((const __m128i *)(src_p[3] + j));
+
+		__m128i c01_lo = _mm_unpacklo_epi8(c0, c1);
+		__m128i c01_hi = _mm_unpackhi_epi8(c0, c1);
+		__m128i c23_lo = _mm_unpacklo_epi8(c2, c3);
+		__m128i c23_hi = _mm_unpackhi_epi8(c2, c3);
+
+		_mm_storeu_si128((__m128i *)(dst_p + j * 4 + 0), _mm_unpacklo_epi16(c01_lo, c23_lo));
+		_mm_storeu_si128((__m128i *)(dst_p + j * 4 + 16), _mm_unpackhi_epi16(c01_lo, c23_lo));
+		_mm_storeu_si128((__m128i *)(dst_p + j * 4 + 32), _mm_unpacklo_epi16(c01_hi, c23_hi));
+		_mm_storeu_si128((__m128i *)(dst_p + j * 4 + 48), _mm_unpackhi_epi16(c01_hi, c23_hi));
+	}
+	interleave_tail<uint8_t, 4>(src_p, dst_p, 0, j, right);
+}
+
+void interleave_w1_sse2(const void * const src[], void *dst, unsigned shift, unsigned left, unsigned right)
+{
+	const uint16_t * const src_p[1] = { static_cast<const uint16_t *>(src[0]) };
+	uint16_t *dst_p = static_cast<uint16_t *>(dst);
+	const __m128i count = _mm_cvtsi32_si128(shift);
+	unsigned j;
+
+	for (j = left; j + 8 <= right; j += 8) {
+		__m128i x = _mm_loadu_si128((const __m128i *)(src_p[0] + j));
+		_mm_storeu_si128((__m128i *)(dst_p + j), _mm_sll_epi16(x, count));
+	}
+	interleave_tail<uint16_t, 1>(src_p, dst_p, shift, j, right);
+}
+
+void interleave_w2_sse2(const void * const src[], void *dst, unsigned shift, unsigned left, unsigned right)
+{
+	const uint16_t * const src_p[2] = { static_cast<const uint16_t *>(src[0]), static_cast<const uint16_t *>(src[1]) };
+	uint16_t *dst_p = static_cast<uint16_t *>(dst);
+	const __m128i count = _mm_cvtsi32_si128(shift);
+	unsigned j;
+
+	for (j = left; j + 8 <= right; j += 8) {
+		__m128i c0 = _mm_sll_epi16(_mm_loadu_si128((const __m128i *)(src_p[0] + j)), count);
+		__m128i c1 = _mm_sll_epi16(_mm_loadu_si128((const __m128i *)(src_p[1] + j)), count);
+
+		_mm_storeu_si128((__m128i *)(dst_p + j * 2 + 0), _mm_unpacklo_epi16(c0, c1));
+		_mm_storeu_si128((__m128i *)(dst_p + j * 2 + 8), _mm_unpackhi_epi16(c0, c1));
+	}
+	interleave_tail<uint16_t, 2>(src_p, dst_p, shift, j, right);
+}
+
+void interleave_w4_sse2(const void * const src[], void *dst, unsigned shift, unsigned left, unsigned right)
+{
+	const uint16_t * const src_p[4] = { static_cast<const uint16_t *>(src[0]), static_cast<const uint16_t *>(src[1]), static_cast<const uint16_t *>(src[2]), static_cast<const uint16_t *>(src[3]) };
+	uint16_t *dst_p = static_cast<uint16_t *>(dst);
+	const __m128i count = _mm_cvtsi32_si128(shift);
+	unsigned j;
+
+	for (j = left; j + 8 <= right; j += 8) {
+		__m128i c0 = _mm_sll_epi16(_mm_loadu_si128((const __m128i *)(src_p[0] + j)), count);
+		__m128i c1 = _mm_sll_epi16(_mm_loadu_si128((const __m128i *)(src_p[1] + j)), count);
+		__m128i c2 = _mm_sll_epi16(_mm_loadu_si128((const __m128i *)(src_p[2] + j)), count);
+		__m128i c3 = _mm_sll_epi16(_mm_loadu_si128((const __m128i *)(src_p[3] + j)), count);
+
+		__m128i c01_lo = _mm_unpacklo_epi16(c0, c1);
+		__m128i c01_hi = _mm_unpackhi_epi16(c0, c1);
+		__m128i c23_lo = _mm_unpacklo_epi16(c2, c3);
+		__m128i c23_hi = _mm_unpackhi_epi16(c2, c3);
+
+		_mm_storeu_si128((__m128i *)(dst_p + j * 4 + 0), _mm_unpacklo_epi32(c01_lo, c23_lo));
+		_mm_storeu_si128((__m128i *)(dst_p + j * 4 + 8), _mm_unpackhi_epi32(c01_lo, c23_lo));
+		_mm_storeu_si128((__m128i *)(dst_p + j * 4 + 16), _mm_unpacklo_epi32(c01_hi, c23_hi));
+		_mm_storeu_si128((__m128i *)(dst_p + j * 4 + 24), _mm_unpackhi_epi32(c01_hi, c23_hi));
+	}
+	interleave_tail<uint16_t, 4>(src_p, dst_p, shift, j, right);
+}
+
+} // namespace graph
+} // namespace zimg
+
+#endif // ZIMG_X86
@@ -0,0 +1,83 @@
+#ifdef ZIMG_X86
+
+#include "common/cpuinfo.h"
+#include "common/pixel.h"
+#include "common/x86/cpuinfo_x86.h"
+#include "interleave_x86.h"
+
+namespace zimg {
+namespace graph {
+
+namespace {
+
+deinterleave_func select_deinterleave_func_sse2(PixelType type, unsigned num_components)
+{
+	if (pixel_size(type) == 1 && num_components == 2)
+		return deinterleave_b2_sse2;
+	else if (pixel_size(type) == 1 && num_components == 4)
+		return deinterleave_b4_sse2;
+	else if (pixel_size(type) == 2 && num_components == 1)
+		return deinterleave_w1_sse2;
+	else if (pixel_size(type) == 2 && num_components == 2)
+		return deinterleave_w2_sse2;
+	else if (pixel_size(type) == 2 && num_components == 4)
+		return deinterleave_w4_sse2;
+	else
+		return nullptr;
+}
+
+interleave_func select_interleave_func_sse2(PixelType type, unsigned num_components)
+{
+	if (pixel_size(type) == 1 && num_components == 2)
+		return interleave_b2_sse2;
+	else if (pixel_size(type) == 1 && num_components == 4)
+		return interleave_b4_sse2;
+	else if (pixel_size(type) == 2 && num_components == 1)
+		return interleave_w1_sse2;
+	else if (pixel_size(type) == 2 && num_components == 2)
+		return interleave_w2_sse2;
+	else if (pixel_size(type) == 2 && num_components == 4)
+		return interleave_w4_sse2;
+	else
+		return nullptr;
+}
+
+} // namespace
+
+
+deinterleave_func select_deinterleave_func_x86(PixelType type, unsigned num_components, CPUClass cpu)
+{
+	X86Capabilities caps = query_x86_capabilities();
+	deinterleave_func func = nullptr;
+
+	if (cpu_is_autodetect(cpu)) {
+		if (!func && caps.sse2)
+			func = select_deinterleave_func_sse2(type, num_components);
+	} else {
+		if (!func && cpu >= CPUClass::X86_SSE2)
+			func = select_deinterleave_func_sse2(type, num_components);
+	}
+
+	return func;
+}
+
+interleave_func select_interleave_func_x86(PixelType type, unsigned num_components, CPUClass cpu)
+{
+	X86Capabilities caps = query_x86_capabilities();
+	interleave_func func = nullptr;
+
+	if (cpu_is_autodetect(cpu)) {
+		if (!func && caps.sse2)
+			func = select_interleave_func_sse2(type, num_components);
+	} else {
+		if (!func && cpu >= CPUClass::X86_SSE2)
+			func = select_interleave_func_sse2(type, num_components);
+	}
+
+	return func;
+}
+
+} // namespace graph
+} // namespace zimg
+
+#endif // ZIMG_X86
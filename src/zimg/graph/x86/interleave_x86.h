@@ -0,0 +1,43 @@
+#pragma once
+
+#ifdef ZIMG_X86
+
+#ifndef ZIMG_GRAPH_X86_INTERLEAVE_X86_H_
+#define ZIMG_GRAPH_X86_INTERLEAVE_X86_H_
+
+#include "graph/interleave.h"
+
+namespace zimg {
+namespace graph {
+
+#define DECLARE_DEINTERLEAVE(x, cpu) \
+void deinterleave_##x##_##cpu(const void *src, void * const dst[], unsigned shift, unsigned left, unsigned right)
+
+#define DECLARE_INTERLEAVE(x, cpu) \
+void interleave_##x##_##cpu(const void * const src[], void *dst, unsigned shift, unsigned left, unsigned right)
+
+DECLARE_DEINTERLEAVE(b2, sse2);
+DECLARE_DEINTERLEAVE(b4, sse2);
+DECLARE_DEINTERLEAVE(w1, sse2);
+DECLARE_DEINTERLEAVE(w2, sse2);
+DECLARE_DEINTERLEAVE(w4, sse2);
+
+DECLARE_INTERLEAVE(b2, sse2);
+DECLARE_INTERLEAVE(b4, sse2);
+DECLARE_INTERLEAVE(w1, sse2);
+DECLARE_INTERLEAVE(w2, sse2);
+DECLARE_INTERLEAVE(w4, sse2);
+
+#undef DECLARE_DEINTERLEAVE
+#undef DECLARE_INTERLEAVE
+
+deinterleave_func select_deinterleave_func_x86(PixelType type, unsigned num_components, CPUClass cpu);
+
+interleave_func select_interleave_func_x86(PixelType type, unsigned num_components, CPUClass cpu);
+
+} // namespace graph
+} // namespace zimg
+
+#endif // ZIMG_GRAPH_X86_INTERLEAVE_X86_H_
+
+#endif // ZIMG_X86
@@ -0,0 +1,82 @@
+#ifdef ZIMG_X86
+
+#include <immintrin.h>
+#include "common/align.h"
+#include "common/ccdep.h"
+#include "premultiply_x86.h"
+
+#include "common/x86/avx_util.h"
+
+namespace zimg {
+namespace graph {
+
+namespace {
+
+inline FORCE_INLINE __m256 premultiply_avx2_xiter(unsigned j, const float *alpha, const float *src)
+{
+	__m256 a = _mm256_load_ps(alpha + j);
+	__m256 x = _mm256_load_ps(src + j);
+
+	a = _mm256_max_ps(a, _mm256_setzero_ps());
+	a = _mm256_min_ps(a, _mm256_set1_ps(1.0f));
+	return _mm256_mul_ps(x, a);
+}
+
+inline FORCE_INLINE __m256 unpremultiply_avx2_xiter(unsigned j, const float *alpha, const float *src)
+{
+	__m256 a = _mm256_load_ps(alpha + j);
+	__m256 x = _mm256_load_ps(src + j);
+	__m256 mask;
+
+	a = _mm256_max_ps(a, _mm256_setzero_ps());
+	a = _mm256_min_ps(a, _mm256_set1_ps(1.0f));
+	mask = _mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_NEQ_UQ);
+
+	return _mm256_and_ps(_mm256_div_ps(x, a), mask);
+}
+
+} // namespace
+
+
+void premultiply_avx2(const float *alpha, const float *src, float *dst, unsigned left, unsigned right)
+{
+	unsigned vec_left = ceil_n(left, 8);
+	unsigned vec_right = floor_n(right, 8);
+
+	if (left != vec_left) {
+		__m256 x = premultiply_avx2_xiter(vec_left - 8, alpha, src);
+		mm256_store_idxhi_ps(dst + vec_left - 8, x, left % 8);
+	}
+	for (unsigned j = vec_left; j < vec_right; j += 8) {
+		__m256 x = premultiply_avx2_xiter(j, alpha, src);
+		_mm256_store_ps(dst + j, x);
+	}
+	if (right != vec_right) {
+		__m256 x = premultiply_avx2_xiter(vec_right, alpha, src);
+		mm256_store_idxlo_ps(dst + vec_right, x, right % 8);
+	}
+}
+
+void unpremultiply_avx2(const float *alpha, const float *src, float *dst, unsigned left, unsigned right)
+{
+	unsigned vec_left = ceil_n(left, 8);
+	unsigned vec_right = floor_n(right, 8);
+
+	if (left != vec_left) {
+		__m256 x = unpremultiply_avx2_xiter(vec_left - 8, alpha, src);
+		mm256_store_idxhi_ps(dst + vec_left - 8, x, left % 8);
+	}
+	for (unsigned j = vec_left; j < vec_right; j += 8) {
+		__m256 x = unpremultiply_avx2_xiter(j, alpha, src);
+		_mm256_store_ps(dst + j, x);
+	}
+	if (right != vec_right) {
+		__m256 x = unpremultiply_avx2_xiter(vec_right, alpha, src);
+		mm256_store_idxlo_ps(dst + vec_right, x, right % 8);
+	}
+}
+
+} // namespace graph
+} // namespace zimg
+
+#endif // ZIMG_X86
@@ -0,0 +1,82 @@
+#ifdef ZIMG_X86_AVX512
+
+#include <immintrin.h>
+#include "common/align.h"
+#include "common/ccdep.h"
+#include "premultiply_x86.h"
+
+#include "common/x86/avx512_util.h"
+
+namespace zimg {
+namespace graph {
+
+namespace {
+
+inline FORCE_INLINE __m512 premultiply_avx512_xiter(unsigned j, const float *alpha, const float *src)
+{
+	__m512 a = _mm512_load_ps(alpha + j);
+	__m512 x = _mm512_load_ps(src + j);
+
+	a = _mm512_max_ps(a, _mm512_setzero_ps());
+	a = _mm512_min_ps(a, _mm512_set1_ps(1.0f));
+	return _mm512_mul_ps(x, a);
+}
+
+inline FORCE_INLINE __m512 unpremultiply_avx512_xiter(unsigned j, const float *alpha, const float *src)
+{
+	__m512 a = _mm512_load_ps(alpha + j);
+	__m512 x = _mm512_load_ps(src + j);
+	__mmask16 mask;
+
+	a = _mm512_max_ps(a, _mm512_setzero_ps());
+	a = _mm512_min_ps(a, _mm512_set1_ps(1.0f));
+	mask = _mm512_cmp_ps_mask(a, _mm512_setzero_ps(), _CMP_NEQ_UQ);
+
+	return _mm512_maskz_div_ps(mask, x, a);
+}
+
+} // namespace
+
+
+void premultiply_avx512(const float *alpha, const float *src, float *dst, unsigned left, unsigned right)
+{
+	unsigned vec_left = ceil_n(left, 16);
+	unsigned vec_right = floor_n(right, 16);
+
+	if (left != vec_left) {
+		__m512 x = premultiply_avx512_xiter(vec_left - 16, alpha, src);
+		_mm512_mask_store_ps(dst + vec_left - 16, mmask16_set_hi(vec_left - left), x);
+	}
+	for (unsigned j = vec_left; j < vec_right; j += 16) {
+		__m512 x = premultiply_avx512_xiter(j, alpha, src);
+		_mm512_store_ps(dst + j, x);
+	}
+	if (right != vec_right) {
+		__m512 x = premultiply_avx512_xiter(vec_right, alpha, src);
+		_mm512_mask_store_ps(dst + vec_right, mmask16_set_lo(right - vec_right), x);
+	}
+}
+
+void unpremultiply_avx512(const float *alpha, const float *src, float *dst, unsigned left, unsigned right)
+{
+	unsigned vec_left = ceil_n(left, 16);
+	unsigned vec_right = floor_n(right, 16);
+
+	if (left != vec_left) {
+		__m512 x = unpremultiply_avx512_xiter(vec_left - 16, alpha, src);
+		_mm512_mask_store_ps(dst + vec_left - 16, mmask16_set_hi(vec_left - left), x);
+	}
+	for (unsigned j = vec_left; j < vec_right; j += 16) {
+		__m512 x = unpremultiply_avx512_xiter(j, alpha, src);
+		_mm512_store_ps(dst + j, x);
+	}
+	if (right != vec_right) {
+		__m512 x = unpremultiply_avx512_xiter(vec_right, alpha, src);
+		_mm512_mask_store_ps(dst + vec_right, mmask16_set_lo(right - vec_right), x);
+	}
+}
+
+} // namespace graph
+} // namespace zimg
+
+#endif // ZIMG_X86_AVX512
@@ -0,0 +1,82 @@
+#ifdef ZIMG_X86
+
+#include <emmintrin.h>
+#include "common/align.h"
+#include "common/ccdep.h"
+#include "premultiply_x86.h"
+
+#include "common/x86/sse_util.h"
+
+namespace zimg {
+namespace graph {
+
+namespace {
+
+inline FORCE_INLINE __m128 premultiply_sse2_xiter(unsigned j, const float *alpha, const float *src)
+{
+	__m128 a = _mm_load_ps(alpha + j);
+	__m128 x = _mm_load_ps(src + j);
+
+	a = _mm_max_ps(a, _mm_setzero_ps());
+	a = _mm_min_ps(a, _mm_set_ps1(1.0f));
+	return _mm_mul_ps(x, a);
+}
+
+inline FORCE_INLINE __m128 unpremultiply_sse2_xiter(unsigned j, const float *alpha, const float *src)
+{
+	__m128 a = _mm_load_ps(alpha + j);
+	__m128 x = _mm_load_ps(src + j);
+	__m128 mask;
+
+	a = _mm_max_ps(a, _mm_setzero_ps());
+	a = _mm_min_ps(a, _mm_set_ps1(1.0f));
+	mask = _mm_cmpneq_ps(a, _mm_setzero_ps());
+
+	return _mm_and_ps(_mm_div_ps(x, a), mask);
+}
+
+} // namespace
+
+
+void premultiply_sse2(const float *alpha, const float *src, float *dst, unsigned left, unsigned right)
+{
+	unsigned vec_left = ceil_n(left, 4);
+	unsigned vec_right = floor_n(right, 4);
+
+	if (left != vec_left) {
+		__m128 x = premultiply_sse2_xiter(vec_left - 4, alpha, src);
+		mm_store_idxhi_ps(dst + vec_left - 4, x, left % 4);
+	}
+	for (unsigned j = vec_left; j < vec_right; j += 4) {
+		__m128 x = premultiply_sse2_xiter(j, alpha, src);
+		_mm_store_ps(dst + j, x);
+	}
+	if (right != vec_right) {
+		__m128 x = premultiply_sse2_xiter(vec_right, alpha, src);
+		mm_store_idxlo_ps(dst + vec_right, x, right % 4);
+	}
+}
+
+void unpremultiply_sse2(const float *alpha, const float *src, float *dst, unsigned left, unsigned right)
+{
+	unsigned vec_left = ceil_n(left, 4);
+	unsigned vec_right = floor_n(right, 4);
+
+	if (left != vec_left) {
+		__m128 x = unpremultiply_sse2_xiter(vec_left - 4, alpha, src);
+		mm_store_idxhi_ps(dst + vec_left - 4, x, left % 4);
+	}
+	for (unsigned j = vec_left; j < vec_right; j += 4) {
+		__m128 x = unpremultiply_sse2_xiter(j, alpha, src);
+		_mm_store_ps(dst + j, x);
+	}
+	if (right != vec_right) {
+		__m128 x = unpremultiply_sse2_xiter(vec_right, alpha, src);
+		mm_store_idxlo_ps(dst + vec_right, x, right % 4);
+	}
+}
+
+} // namespace graph
+} // namespace zimg
+
+#endif // ZIMG_X86
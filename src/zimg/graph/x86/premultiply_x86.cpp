@@ -0,0 +1,69 @@
+#ifdef ZIMG_X86
+
+#include "common/cpuinfo.h"
+#include "common/x86/cpuinfo_x86.h"
+#include "premultiply_x86.h"
+
+namespace zimg {
+namespace graph {
+
+premultiply_func select_premultiply_func_x86(CPUClass cpu)
+{
+	X86Capabilities caps = query_x86_capabilities();
+	premultiply_func func = nullptr;
+
+	if (cpu_is_autodetect(cpu)) {
+#ifdef ZIMG_X86_AVX512
+		if (!func && cpu == CPUClass::AUTO_64B && cpu_has_avx512_f_dq_bw_vl(caps))
+			func = premultiply_avx512;
+#endif
+		if (!func && caps.avx2)
+			func = premultiply_avx2;
+		if (!func && caps.sse2)
+			func = premultiply_sse2;
+	} else {
+#ifdef ZIMG_X86_AVX512
+		if (!func && cpu >= CPUClass::X86_AVX512)
+			func = premultiply_avx512;
+#endif
+		if (!func && cpu >= CPUClass::X86_AVX2)
+			func = premultiply_avx2;
+		if (!func && cpu >= CPUClass::X86_SSE2)
+			func = premultiply_sse2;
+	}
+
+	return func;
+}
+
+premultiply_func select_unpremultiply_func_x86(CPUClass cpu)
+{
+	X86Capabilities caps = query_x86_capabilities();
+	premultiply_func func = nullptr;
+
+	if (cpu_is_autodetect(cpu)) {
+#ifdef ZIMG_X86_AVX512
+		if (!func && cpu == CPUClass::AUTO_64B && cpu_has_avx512_f_dq_bw_vl(caps))
+			func = unpremultiply_avx512;
+#endif
+		if (!func && caps.avx2)
+			func = unpremultiply_avx2;
+		if (!func && caps.sse2)
+			func = unpremultiply_sse2;
+	} else {
+#ifdef ZIMG_X86_AVX512
+		if (!func && cpu >= CPUClass::X86_AVX512)
+			func = unpremultiply_avx512;
+#endif
+		if (!func && cpu >= CPUClass::X86_AVX2)
+			func = unpremultiply_avx2;
+		if (!func && cpu >= CPUClass::X86_SSE2)
+			func = unpremultiply_sse2;
+	}
+
+	return func;
+}
+
+} // namespace graph
+} // namespace zimg
+
+#endif // ZIMG_X86
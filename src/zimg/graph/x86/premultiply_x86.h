@@ -0,0 +1,35 @@
+#pragma once
+
+#ifdef ZIMG_X86
+
+#ifndef ZIMG_GRAPH_X86_PREMULTIPLY_X86_H_
+#define ZIMG_GRAPH_X86_PREMULTIPLY_X86_H_
+
+#include "graph/basic_filter.h"
+
+namespace zimg {
+namespace graph {
+
+#define DECLARE_PREMULTIPLY(x, cpu) \
+void x##_##cpu(const float *alpha, const float *src, float *dst, unsigned left, unsigned right)
+
+DECLARE_PREMULTIPLY(premultiply, sse2);
+DECLARE_PREMULTIPLY(premultiply, avx2);
+DECLARE_PREMULTIPLY(premultiply, avx512);
+
+DECLARE_PREMULTIPLY(unpremultiply, sse2);
+DECLARE_PREMULTIPLY(unpremultiply, avx2);
+DECLARE_PREMULTIPLY(unpremultiply, avx512);
+
+#undef DECLARE_PREMULTIPLY
+
+premultiply_func select_premultiply_func_x86(CPUClass cpu);
+
+premultiply_func select_unpremultiply_func_x86(CPUClass cpu);
+
+} // namespace graph
+} // namespace zimg
+
+#endif // ZIMG_GRAPH_X86_PREMULTIPLY_X86_H_
+
+#endif // ZIMG_X86
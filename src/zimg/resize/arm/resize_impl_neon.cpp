@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <stdexcept>
+#include <type_traits>
 #include <arm_neon.h>
 #include "common/align.h"
 #include "common/ccdep.h"
@@ -49,15 +50,96 @@ void transpose_line_8x8_u16(uint16_t * RESTRICT dst, const uint16_t * const * RE
 	}
 }
 
-void transpose_line_4x4_f32(float * RESTRICT dst, const float *src_p0, const float *src_p1, const float *src_p2, const float *src_p3, unsigned left, unsigned right)
+#if !defined(_MSC_VER) || defined(_M_ARM64)
+struct f16_traits {
+	typedef __fp16 pixel_type;
+
+	static constexpr PixelType type_constant = PixelType::HALF;
+
+	static inline FORCE_INLINE float32x4_t load4(const pixel_type *ptr)
+	{
+		return vcvt_f32_f16(vld1_f16(ptr));
+	}
+
+	static inline FORCE_INLINE void store4(pixel_type *ptr, float32x4_t x)
+	{
+		vst1_f16(ptr, vcvt_f16_f32(x));
+	}
+
+	static inline FORCE_INLINE void scatter4(pixel_type *dst0, pixel_type *dst1, pixel_type *dst2, pixel_type *dst3, float32x4_t x)
+	{
+		uint16x4_t y = vreinterpret_u16_f16(vcvt_f16_f32(x));
+
+		vst1_lane_u16(reinterpret_cast<uint16_t *>(dst0), y, 0);
+		vst1_lane_u16(reinterpret_cast<uint16_t *>(dst1), y, 1);
+		vst1_lane_u16(reinterpret_cast<uint16_t *>(dst2), y, 2);
+		vst1_lane_u16(reinterpret_cast<uint16_t *>(dst3), y, 3);
+	}
+
+	// Masked stores touch only the four samples of the vector, unlike the 16-byte helpers in neon_util.h.
+	static inline FORCE_INLINE void store_idxlo(pixel_type *dst, float32x4_t x, unsigned idx)
+	{
+		uint16_t *dst_p = reinterpret_cast<uint16_t *>(dst);
+		uint16x4_t mask = vreinterpret_u16_u8(vld1_u8(neon_mask_table[idx * 2]));
+		uint16x4_t y = vreinterpret_u16_f16(vcvt_f16_f32(x));
+
+		vst1_u16(dst_p, vbsl_u16(mask, y, vld1_u16(dst_p)));
+	}
+
+	static inline FORCE_INLINE void store_idxhi(pixel_type *dst, float32x4_t x, unsigned idx)
+	{
+		uint16_t *dst_p = reinterpret_cast<uint16_t *>(dst);
+		uint16x4_t mask = vreinterpret_u16_u8(vld1_u8(neon_mask_table[idx * 2]));
+		uint16x4_t y = vreinterpret_u16_f16(vcvt_f16_f32(x));
+
+		vst1_u16(dst_p, vbsl_u16(mask, vld1_u16(dst_p), y));
+	}
+};
+#endif // !defined(_MSC_VER) || defined(_M_ARM64)
+
+struct f32_traits {
+	typedef float pixel_type;
+
+	static constexpr PixelType type_constant = PixelType::FLOAT;
+
+	static inline FORCE_INLINE float32x4_t load4(const pixel_type *ptr)
+	{
+		return vld1q_f32(ptr);
+	}
+
+	static inline FORCE_INLINE void store4(pixel_type *ptr, float32x4_t x)
+	{
+		vst1q_f32(ptr, x);
+	}
+
+	static inline FORCE_INLINE void scatter4(pixel_type *dst0, pixel_type *dst1, pixel_type *dst2, pixel_type *dst3, float32x4_t x)
+	{
+		neon_scatter_f32(dst0, dst1, dst2, dst3, x);
+	}
+
+	static inline FORCE_INLINE void store_idxlo(pixel_type *dst, float32x4_t x, unsigned idx)
+	{
+		neon_store_idxlo_f32(dst, x, idx);
+	}
+
+	static inline FORCE_INLINE void store_idxhi(pixel_type *dst, float32x4_t x, unsigned idx)
+	{
+		neon_store_idxhi_f32(dst, x, idx);
+	}
+};
+
+
+// HALF samples are widened while transposing, so the horizontal kernel always reads FLOAT.
+template <class Traits, class T>
+void transpose_line_4x4(float * RESTRICT dst, const T *src_p0, const T *src_p1, const T *src_p2, const T *src_p3, unsigned left, unsigned right)
 {
 	for (unsigned j = left; j < right; j += 4) {
 		float32x4_t x0, x1, x2, x3;
 
-		x0 = vld1q_f32(src_p0 + j);
-		x1 = vld1q_f32(src_p1 + j);
-		x2 = vld1q_f32(src_p2 + j);
-		x3 = vld1q_f32(src_p3 + j);
+		x0 = Traits::load4(src_p0 + j);
+		x1 = Traits::load4(src_p1 + j);
+		x2 = Traits::load4(src_p2 + j);
+		x3 = Traits::load4(src_p3 + j);
 
 		neon_transpose4_f32(x0, x1, x2, x3);
 
@@ -299,9 +381,9 @@ const decltype(&resize_line8_h_u16_neon<false, 0>) resize_line8_h_u16_neon_jt_la
 
 
 template <unsigned FWidth, unsigned Tail>
-inline FORCE_INLINE float32x4_t resize_line4_h_f32_neon_xiter(unsigned j,
-                                                              const unsigned * RESTRICT filter_left, const float * RESTRICT filter_data, unsigned filter_stride, unsigned filter_width,
-                                                              const float * RESTRICT src, unsigned src_base)
+inline FORCE_INLINE float32x4_t resize_line4_h_fp_neon_xiter(unsigned j,
+                                                             const unsigned * RESTRICT filter_left, const float * RESTRICT filter_data, unsigned filter_stride, unsigned filter_width,
+                                                             const float * RESTRICT src, unsigned src_base)
 {
 	const float *filter_coeffs = filter_data + j * filter_stride;
 	const float *src_p = src + (filter_left[j] - src_base) * 4;
@@ -363,23 +445,25 @@ inline FORCE_INLINE float32x4_t resize_line4_h_f32_neon_xiter(unsigned j,
 	return accum0;
 }
 
-template <unsigned FWidth, unsigned Tail>
-void resize_line4_h_f32_neon(const unsigned * RESTRICT filter_left, const float * RESTRICT filter_data, unsigned filter_stride, unsigned filter_width,
-                            const float * RESTRICT src, float * const * RESTRICT dst, unsigned src_base, unsigned left, unsigned right)
+template <class Traits, unsigned FWidth, unsigned Tail>
+void resize_line4_h_fp_neon(const unsigned * RESTRICT filter_left, const float * RESTRICT filter_data, unsigned filter_stride, unsigned filter_width,
+                            const float * RESTRICT src, typename Traits::pixel_type * const * RESTRICT dst, unsigned src_base, unsigned left, unsigned right)
 {
+	typedef typename Traits::pixel_type pixel_type;
+
 	unsigned vec_left = ceil_n(left, 4);
 	unsigned vec_right = floor_n(right, 4);
 
-	float *dst_p0 = dst[0];
-	float *dst_p1 = dst[1];
-	float *dst_p2 = dst[2];
-	float *dst_p3 = dst[3];
+	pixel_type *dst_p0 = dst[0];
+	pixel_type *dst_p1 = dst[1];
+	pixel_type *dst_p2 = dst[2];
+	pixel_type *dst_p3 = dst[3];
 
-#define XITER resize_line4_h_f32_neon_xiter<FWidth, Tail>
+#define XITER resize_line4_h_fp_neon_xiter<FWidth, Tail>
 #define XARGS filter_left, filter_data, filter_stride, filter_width, src, src_base
 	for (unsigned j = left; j < vec_left; ++j) {
 		float32x4_t x = XITER(j, XARGS);
-		neon_scatter_f32(dst_p0 + j, dst_p1 + j, dst_p2 + j, dst_p3 + j, x);
+		Traits::scatter4(dst_p0 + j, dst_p1 + j, dst_p2 + j, dst_p3 + j, x);
 	}
 
 	for (unsigned j = vec_left; j < vec_right; j += 4) {
@@ -392,36 +476,46 @@ void resize_line4_h_f32_neon(const unsigned * RESTRICT filter_left, const float
 
 		neon_transpose4_f32(x0, x1, x2, x3);
 
-		vst1q_f32(dst_p0 + j, x0);
-		vst1q_f32(dst_p1 + j, x1);
-		vst1q_f32(dst_p2 + j, x2);
-		vst1q_f32(dst_p3 + j, x3);
+		Traits::store4(dst_p0 + j, x0);
+		Traits::store4(dst_p1 + j, x1);
+		Traits::store4(dst_p2 + j, x2);
+		Traits::store4(dst_p3 + j, x3);
 	}
 
 	for (unsigned j = vec_right; j < right; ++j) {
 		float32x4_t x = XITER(j, XARGS);
-		neon_scatter_f32(dst_p0 + j, dst_p1 + j, dst_p2 + j, dst_p3 + j, x);
+		Traits::scatter4(dst_p0 + j, dst_p1 + j, dst_p2 + j, dst_p3 + j, x);
 	}
 #undef XITER
 #undef XARGS
 }
 
-const decltype(&resize_line4_h_f32_neon<0, 0>) resize_line4_h_f32_neon_jt_small[] = {
-	resize_line4_h_f32_neon<1, 1>,
-	resize_line4_h_f32_neon<2, 2>,
-	resize_line4_h_f32_neon<3, 3>,
-	resize_line4_h_f32_neon<4, 4>,
-	resize_line4_h_f32_neon<5, 1>,
-	resize_line4_h_f32_neon<6, 2>,
-	resize_line4_h_f32_neon<7, 3>,
-	resize_line4_h_f32_neon<8, 4>
+template <class Traits>
+struct resize_line4_h_fp_neon_jt {
+	typedef decltype(&resize_line4_h_fp_neon<Traits, 0, 0>) func_type;
+
+	static const func_type small[8];
+	static const func_type large[4];
+};
+
+template <class Traits>
+const typename resize_line4_h_fp_neon_jt<Traits>::func_type resize_line4_h_fp_neon_jt<Traits>::small[8] = {
+	resize_line4_h_fp_neon<Traits, 1, 1>,
+	resize_line4_h_fp_neon<Traits, 2, 2>,
+	resize_line4_h_fp_neon<Traits, 3, 3>,
+	resize_line4_h_fp_neon<Traits, 4, 4>,
+	resize_line4_h_fp_neon<Traits, 5, 1>,
+	resize_line4_h_fp_neon<Traits, 6, 2>,
+	resize_line4_h_fp_neon<Traits, 7, 3>,
+	resize_line4_h_fp_neon<Traits, 8, 4>
 };
 
-const decltype(&resize_line4_h_f32_neon<0, 0>) resize_line4_h_f32_neon_jt_large[] = {
-	resize_line4_h_f32_neon<0, 0>,
-	resize_line4_h_f32_neon<0, 1>,
-	resize_line4_h_f32_neon<0, 2>,
-	resize_line4_h_f32_neon<0, 3>
+template <class Traits>
+const typename resize_line4_h_fp_neon_jt<Traits>::func_type resize_line4_h_fp_neon_jt<Traits>::large[4] = {
+	resize_line4_h_fp_neon<Traits, 0, 0>,
+	resize_line4_h_fp_neon<Traits, 0, 1>,
+	resize_line4_h_fp_neon<Traits, 0, 2>,
+	resize_line4_h_fp_neon<Traits, 0, 3>
 };
 
 
@@ -582,47 +676,50 @@ const decltype(&resize_line_v_u16_neon<0, false, false>) resize_line_v_u16_neon_
 };
 
 
-template <unsigned N, bool UpdateAccum>
-inline FORCE_INLINE float32x4_t resize_line_v_f32_neon_xiter(unsigned j,
-                                                             const float *src_p0, const float *src_p1, const float *src_p2, const float *src_p3,
-                                                             const float *src_p4, const float *src_p5, const float *src_p6, const float *src_p7, float * RESTRICT accum_p,
-                                                             const float32x4_t &c0, const float32x4_t &c1, const float32x4_t &c2, const float32x4_t &c3,
-                                                             const float32x4_t &c4, const float32x4_t &c5, const float32x4_t &c6, const float32x4_t &c7)
+template <class Traits, unsigned N, bool UpdateAccum, class T = typename Traits::pixel_type>
+inline FORCE_INLINE float32x4_t resize_line_v_fp_neon_xiter(unsigned j,
+                                                            const T *src_p0, const T *src_p1, const T *src_p2, const T *src_p3,
+                                                            const T *src_p4, const T *src_p5, const T *src_p6, const T *src_p7, T * RESTRICT accum_p,
+                                                            const float32x4_t &c0, const float32x4_t &c1, const float32x4_t &c2, const float32x4_t &c3,
+                                                            const float32x4_t &c4, const float32x4_t &c5, const float32x4_t &c6, const float32x4_t &c7)
 {
+	typedef typename Traits::pixel_type pixel_type;
+	static_assert(std::is_same<pixel_type, T>::value, "must not specify T");
+
 	float32x4_t accum0 = vdupq_n_f32(0.0f);
 	float32x4_t accum1 = vdupq_n_f32(0.0f);
 	float32x4_t x;
 
 	if (N >= 0) {
-		x = vld1q_f32(src_p0 + j);
-		accum0 = UpdateAccum ? vfmaq_f32(vld1q_f32(accum_p + j), c0, x) : vmulq_f32(c0, x);
+		x = Traits::load4(src_p0 + j);
+		accum0 = UpdateAccum ? vfmaq_f32(Traits::load4(accum_p + j), c0, x) : vmulq_f32(c0, x);
 	}
 	if (N >= 1) {
-		x = vld1q_f32(src_p1 + j);
+		x = Traits::load4(src_p1 + j);
 		accum1 = vmulq_f32(c1, x);
 	}
 	if (N >= 2) {
-		x = vld1q_f32(src_p2 + j);
+		x = Traits::load4(src_p2 + j);
 		accum0 = vfmaq_f32(accum0, c2, x);
 	}
 	if (N >= 3) {
-		x = vld1q_f32(src_p3 + j);
+		x = Traits::load4(src_p3 + j);
 		accum1 = vfmaq_f32(accum1, c3, x);
 	}
 	if (N >= 4) {
-		x = vld1q_f32(src_p4 + j);
+		x = Traits::load4(src_p4 + j);
 		accum0 = vfmaq_f32(accum0, c4, x);
 	}
 	if (N >= 5) {
-		x = vld1q_f32(src_p5 + j);
+		x = Traits::load4(src_p5 + j);
 		accum1 = vfmaq_f32(accum1, c5, x);
 	}
 	if (N >= 6) {
-		x = vld1q_f32(src_p6 + j);
+		x = Traits::load4(src_p6 + j);
 		accum0 = vfmaq_f32(accum0, c6, x);
 	}
 	if (N >= 7) {
-		x = vld1q_f32(src_p7 + j);
+		x = Traits::load4(src_p7 + j);
 		accum1 = vfmaq_f32(accum1, c7, x);
 	}
 
@@ -630,17 +727,19 @@ inline FORCE_INLINE float32x4_t resize_line_v_f32_neon_xiter(unsigned j,
 	return accum0;
 }
 
-template <unsigned N, bool UpdateAccum>
-void resize_line_v_f32_neon(const float * RESTRICT filter_data, const float * const * RESTRICT src, float * RESTRICT dst, unsigned left, unsigned right)
+template <class Traits, unsigned N, bool UpdateAccum>
+void resize_line_v_fp_neon(const float * RESTRICT filter_data, const typename Traits::pixel_type * const * RESTRICT src, typename Traits::pixel_type * RESTRICT dst, unsigned left, unsigned right)
 {
-	const float *src_p0 = src[0];
-	const float *src_p1 = src[1];
-	const float *src_p2 = src[2];
-	const float *src_p3 = src[3];
-	const float *src_p4 = src[4];
-	const float *src_p5 = src[5];
-	const float *src_p6 = src[6];
-	const float *src_p7 = src[7];
+	typedef typename Traits::pixel_type pixel_type;
+
+	const pixel_type *src_p0 = src[0];
+	const pixel_type *src_p1 = src[1];
+	const pixel_type *src_p2 = src[2];
+	const pixel_type *src_p3 = src[3];
+	const pixel_type *src_p4 = src[4];
+	const pixel_type *src_p5 = src[5];
+	const pixel_type *src_p6 = src[6];
+	const pixel_type *src_p7 = src[7];
 
 	unsigned vec_left = ceil_n(left, 4);
 	unsigned vec_right = floor_n(right, 4);
@@ -656,53 +755,56 @@ void resize_line_v_f32_neon(const float * RESTRICT filter_data, const float * co
 
 	float32x4_t accum;
 
-#define XITER resize_line_v_f32_neon_xiter<N, UpdateAccum>
+#define XITER resize_line_v_fp_neon_xiter<Traits, N, UpdateAccum>
 #define XARGS src_p0, src_p1, src_p2, src_p3, src_p4, src_p5, src_p6, src_p7, dst, c0, c1, c2, c3, c4, c5, c6, c7
 	if (left != vec_left) {
 		accum = XITER(vec_left - 4, XARGS);
-		neon_store_idxhi_f32(dst + vec_left - 4, accum, left % 4);
+		Traits::store_idxhi(dst + vec_left - 4, accum, left % 4);
 	}
 
 	for (unsigned j = vec_left; j < vec_right; j += 4) {
 		accum = XITER(j, XARGS);
-		vst1q_f32(dst + j, accum);
+		Traits::store4(dst + j, accum);
 	}
 
 	if (right != vec_right) {
 		accum = XITER(vec_right, XARGS);
-		neon_store_idxlo_f32(dst + vec_right, accum, right % 4);
+		Traits::store_idxlo(dst + vec_right, accum, right % 4);
 	}
 #undef XITER
 #undef XARGS
 }
 
-struct resize_line_v_f32_neon_jt {
-	typedef decltype(&resize_line_v_f32_neon<0, false>) func_type;
+template <class Traits>
+struct resize_line_v_fp_neon_jt {
+	typedef decltype(&resize_line_v_fp_neon<Traits, 0, false>) func_type;
 
 	static const func_type table_a[8];
 	static const func_type table_b[8];
 };
 
-const resize_line_v_f32_neon_jt::func_type resize_line_v_f32_neon_jt::table_a[8] = {
-	resize_line_v_f32_neon<0, false>,
-	resize_line_v_f32_neon<1, false>,
-	resize_line_v_f32_neon<2, false>,
-	resize_line_v_f32_neon<3, false>,
-	resize_line_v_f32_neon<4, false>,
-	resize_line_v_f32_neon<5, false>,
-	resize_line_v_f32_neon<6, false>,
-	resize_line_v_f32_neon<7, false>,
+template <class Traits>
+const typename resize_line_v_fp_neon_jt<Traits>::func_type resize_line_v_fp_neon_jt<Traits>::table_a[8] = {
+	resize_line_v_fp_neon<Traits, 0, false>,
+	resize_line_v_fp_neon<Traits, 1, false>,
+	resize_line_v_fp_neon<Traits, 2, false>,
+	resize_line_v_fp_neon<Traits, 3, false>,
+	resize_line_v_fp_neon<Traits, 4, false>,
+	resize_line_v_fp_neon<Traits, 5, false>,
+	resize_line_v_fp_neon<Traits, 6, false>,
+	resize_line_v_fp_neon<Traits, 7, false>,
 };
 
-const resize_line_v_f32_neon_jt::func_type resize_line_v_f32_neon_jt::table_b[8] = {
-	resize_line_v_f32_neon<0, true>,
-	resize_line_v_f32_neon<1, true>,
-	resize_line_v_f32_neon<2, true>,
-	resize_line_v_f32_neon<3, true>,
-	resize_line_v_f32_neon<4, true>,
-	resize_line_v_f32_neon<5, true>,
-	resize_line_v_f32_neon<6, true>,
-	resize_line_v_f32_neon<7, true>,
+template <class Traits>
+const typename resize_line_v_fp_neon_jt<Traits>::func_type resize_line_v_fp_neon_jt<Traits>::table_b[8] = {
+	resize_line_v_fp_neon<Traits, 0, true>,
+	resize_line_v_fp_neon<Traits, 1, true>,
+	resize_line_v_fp_neon<Traits, 2, true>,
+	resize_line_v_fp_neon<Traits, 3, true>,
+	resize_line_v_fp_neon<Traits, 4, true>,
+	resize_line_v_fp_neon<Traits, 5, true>,
+	resize_line_v_fp_neon<Traits, 6, true>,
+	resize_line_v_fp_neon<Traits, 7, true>,
 };
 
 
@@ -762,17 +864,21 @@ public:
 };
 
 
-class ResizeImplH_F32_Neon final : public ResizeImplH {
-	decltype(&resize_line4_h_f32_neon<0, 0>) m_func;
+template <class Traits>
+class ResizeImplH_FP_Neon final : public ResizeImplH {
+	typedef typename Traits::pixel_type pixel_type;
+	typedef typename resize_line4_h_fp_neon_jt<Traits>::func_type func_type;
+
+	func_type m_func;
 public:
-	ResizeImplH_F32_Neon(const FilterContext &filter, unsigned height) :
-		ResizeImplH(filter, image_attributes{ filter.filter_rows, height, PixelType::FLOAT }),
+	ResizeImplH_FP_Neon(const FilterContext &filter, unsigned height) :
+		ResizeImplH(filter, image_attributes{ filter.filter_rows, height, Traits::type_constant }),
 		m_func{}
 	{
 		if (filter.filter_width <= 8)
-			m_func = resize_line4_h_f32_neon_jt_small[filter.filter_width - 1];
+			m_func = resize_line4_h_fp_neon_jt<Traits>::small[filter.filter_width - 1];
 		else
-			m_func = resize_line4_h_f32_neon_jt_large[filter.filter_width % 4];
+			m_func = resize_line4_h_fp_neon_jt<Traits>::large[filter.filter_width % 4];
 	}
 
 	unsigned get_simultaneous_lines() const override { return 4; }
@@ -791,12 +897,12 @@ public:
 
 	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *tmp, unsigned i, unsigned left, unsigned right) const override
 	{
-		const auto &src_buf = graph::static_buffer_cast<const float>(*src);
-		const auto &dst_buf = graph::static_buffer_cast<float>(*dst);
+		const auto &src_buf = graph::static_buffer_cast<const pixel_type>(*src);
+		const auto &dst_buf = graph::static_buffer_cast<pixel_type>(*dst);
 		auto range = get_required_col_range(left, right);
 
-		const float *src_ptr[4] = { 0 };
-		float *dst_ptr[4] = { 0 };
+		const pixel_type *src_ptr[4] = { 0 };
+		pixel_type *dst_ptr[4] = { 0 };
 		float *transpose_buf = static_cast<float *>(tmp);
 		unsigned height = get_image_attributes().height;
 
@@ -805,7 +911,7 @@ public:
 		src_ptr[2] = src_buf[std::min(i + 2, height - 1)];
 		src_ptr[3] = src_buf[std::min(i + 3, height - 1)];
 
-		transpose_line_4x4_f32(transpose_buf, src_ptr[0], src_ptr[1], src_ptr[2], src_ptr[3], floor_n(range.first, 4), ceil_n(range.second, 4));
+		transpose_line_4x4<Traits>(transpose_buf, src_ptr[0], src_ptr[1], src_ptr[2], src_ptr[3], floor_n(range.first, 4), ceil_n(range.second, 4));
 
 		dst_ptr[0] = dst_buf[std::min(i + 0, height - 1)];
 		dst_ptr[1] = dst_buf[std::min(i + 1, height - 1)];
@@ -884,23 +990,25 @@ public:
 };
 
 
-class ResizeImplV_F32_Neon final : public ResizeImplV {
+template <class Traits>
+class ResizeImplV_FP_Neon final : public ResizeImplV {
+	typedef typename Traits::pixel_type pixel_type;
 public:
-	ResizeImplV_F32_Neon(const FilterContext &filter, unsigned width) :
-		ResizeImplV(filter, image_attributes{ width, filter.filter_rows, PixelType::FLOAT })
+	ResizeImplV_FP_Neon(const FilterContext &filter, unsigned width) :
+		ResizeImplV(filter, image_attributes{ width, filter.filter_rows, Traits::type_constant })
 	{}
 
 	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *, unsigned i, unsigned left, unsigned right) const override
 	{
-		const auto &src_buf = graph::static_buffer_cast<const float>(*src);
-		const auto &dst_buf = graph::static_buffer_cast<float>(*dst);
+		const auto &src_buf = graph::static_buffer_cast<const pixel_type>(*src);
+		const auto &dst_buf = graph::static_buffer_cast<pixel_type>(*dst);
 
 		const float *filter_data = m_filter.data.data() + i * m_filter.stride;
 		unsigned filter_width = m_filter.filter_width;
 		unsigned src_height = m_filter.input_width;
 
-		const float *src_lines[8] = { 0 };
-		float *dst_line = dst_buf[i];
+		const pixel_type *src_lines[8] = { 0 };
+		pixel_type *dst_line = dst_buf[i];
 
 		{
 			unsigned taps_remain = std::min(filter_width - 0, 8U);
@@ -915,7 +1023,7 @@ public:
 			src_lines[6] = src_buf[std::min(top + 6, src_height - 1)];
 			src_lines[7] = src_buf[std::min(top + 7, src_height - 1)];
 
-			resize_line_v_f32_neon_jt::table_a[taps_remain - 1](filter_data + 0, src_lines, dst_line, left, right);
+			resize_line_v_fp_neon_jt<Traits>::table_a[taps_remain - 1](filter_data + 0, src_lines, dst_line, left, right);
 		}
 
 		for (unsigned k = 8; k < filter_width; k += 8) {
@@ -931,7 +1039,7 @@ public:
 			src_lines[6] = src_buf[std::min(top + 6, src_height - 1)];
 			src_lines[7] = src_buf[std::min(top + 7, src_height - 1)];
 
-			resize_line_v_f32_neon_jt::table_b[taps_remain - 1](filter_data + k, src_lines, dst_line, left, right);
+			resize_line_v_fp_neon_jt<Traits>::table_b[taps_remain - 1](filter_data + k, src_lines, dst_line, left, right);
 		}
 	}
 };
@@ -944,7 +1052,11 @@ std::unique_ptr<graph::ImageFilter> create_resize_impl_h_neon(const FilterContex
 	std::unique_ptr<graph::ImageFilter> ret;
 
 	if (type == PixelType::FLOAT)
-		ret = ztd::make_unique<ResizeImplH_F32_Neon>(context, height);
+		ret = ztd::make_unique<ResizeImplH_FP_Neon<f32_traits>>(context, height);
+#if !defined(_MSC_VER) || defined(_M_ARM64)
+	else if (type == PixelType::HALF)
+		ret = ztd::make_unique<ResizeImplH_FP_Neon<f16_traits>>(context, height);
+#endif
 	else if (type == PixelType::WORD)
 		ret = ztd::make_unique<ResizeImplH_U16_Neon>(context, height, depth);
 
@@ -956,7 +1068,11 @@ std::unique_ptr<graph::ImageFilter> create_resize_impl_v_neon(const FilterContex
 	std::unique_ptr<graph::ImageFilter> ret;
 
 	if (type == PixelType::FLOAT)
-		ret = ztd::make_unique<ResizeImplV_F32_Neon>(context, width);
+		ret = ztd::make_unique<ResizeImplV_FP_Neon<f32_traits>>(context, width);
+#if !defined(_MSC_VER) || defined(_M_ARM64)
+	else if (type == PixelType::HALF)
+		ret = ztd::make_unique<ResizeImplV_FP_Neon<f16_traits>>(context, width);
+#endif
 	else if (type == PixelType::WORD)
 		ret = ztd::make_unique<ResizeImplV_U16_Neon>(context, width, depth);
 
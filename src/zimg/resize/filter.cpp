@@ -6,9 +6,9 @@
 #include <cstdlib>
 #include <stdexcept>
 #include <vector>
+#include "common/checked_int.h"
 #include "common/except.h"
 #include "common/libm_wrapper.h"
-#include "common/matrix.h"
 #include "common/zassert.h"
 #include "filter.h"
 
@@ -41,12 +41,37 @@ double round_halfup(double x) noexcept
 }
 
 
-FilterContext matrix_to_filter(const RowMatrix<double> &m)
+/**
+ * Filter coefficients prior to rounding. Each row stores a contiguous span of
+ * coefficients, starting at the left offset of the row.
+ */
+struct FilterMatrix {
+	unsigned rows;
+	unsigned cols;
+	unsigned capacity;
+	std::vector<double> coeffs;
+	std::vector<unsigned> left;
+	std::vector<unsigned> width;
+
+	FilterMatrix(unsigned rows, unsigned cols, unsigned capacity) :
+		rows{ rows },
+		cols{ cols },
+		capacity{ capacity },
+		coeffs((static_cast<checked_size_t>(rows) * capacity).get()),
+		left(rows),
+		width(rows)
+	{}
+
+	double *row(unsigned i) { return coeffs.data() + static_cast<size_t>(i) * capacity; }
+	const double *row(unsigned i) const { return coeffs.data() + static_cast<size_t>(i) * capacity; }
+};
+
+FilterContext matrix_to_filter(const FilterMatrix &m)
 {
-	size_t width = 0;
+	unsigned width = 0;
 
-	for (size_t i = 0; i < m.rows(); ++i) {
-		width = std::max(width, m.row_right(i) - m.row_left(i));
+	for (unsigned i = 0; i < m.rows; ++i) {
+		width = std::max(width, m.width[i]);
 	}
 	zassert_d(width, "empty matrix");
 
@@ -58,9 +83,9 @@ FilterContext matrix_to_filter(const RowMatrix<double> &m)
 	FilterContext e{};
 
 	try {
-		e.filter_width = static_cast<unsigned>(width);
-		e.filter_rows = static_cast<unsigned>(m.rows());
-		e.input_width = static_cast<unsigned>(m.cols());
+		e.filter_width = width;
+		e.filter_rows = m.rows;
+		e.input_width = m.cols;
 		e.stride = static_cast<unsigned>(ceil_n(width, AlignmentOf<float>::value));
 		e.stride_i16 = static_cast<unsigned>(ceil_n(width, AlignmentOf<uint16_t>::value));
 
@@ -74,8 +99,12 @@ FilterContext matrix_to_filter(const RowMatrix<double> &m)
 		error::throw_<error::OutOfMemory>();
 	}
 
-	for (size_t i = 0; i < m.rows(); ++i) {
-		unsigned left = static_cast<unsigned>(std::min(m.row_left(i), m.cols() - width));
+	for (unsigned i = 0; i < m.rows; ++i) {
+		const double *row = m.row(i);
+		unsigned row_left = m.left[i];
+		unsigned row_right = m.left[i] + m.width[i];
+		unsigned left = std::min(row_left, m.cols - width);
+
 		double f32_err = 0.0f;
 		double i16_err = 0;
 
@@ -88,8 +117,9 @@ FilterContext matrix_to_filter(const RowMatrix<double> &m)
 		 * This minimizes accumulation of error and ensures that the filter
 		 * continues to sum as close to 1.0 as possible after rounding.
 		 */
-		for (size_t j = 0; j < width; ++j) {
-			double coeff = m[i][left + j];
+		for (unsigned j = 0; j < width; ++j) {
+			unsigned idx = left + j;
+			double coeff = (idx >= row_left && idx < row_right) ? row[idx - row_left] : 0.0;
 
 			double coeff_expected_f32 = coeff - f32_err;
 			double coeff_expected_i16 = coeff * (1 << 14) - i16_err;
@@ -108,8 +138,8 @@ FilterContext matrix_to_filter(const RowMatrix<double> &m)
 			f32_sum += coeff_f32;
 			i16_sum += coeff_i16;
 
-			e.data[i * e.stride + j] = coeff_f32;
-			e.data_i16[i * e.stride_i16 + j] = coeff_i16;
+			e.data[static_cast<size_t>(i) * e.stride + j] = coeff_f32;
+			e.data_i16[static_cast<size_t>(i) * e.stride_i16 + j] = coeff_i16;
 		}
 
 		/* The final sum may still be off by a few ULP. This can not be fixed for
@@ -119,7 +149,7 @@ FilterContext matrix_to_filter(const RowMatrix<double> &m)
 		zassert_d(1.0 - f32_sum <= FLT_EPSILON, "error too great");
 		zassert_d(std::abs((1 << 14) - i16_sum) <= 1, "error too great");
 
-		e.data_i16[i * e.stride_i16 + i16_greatest_idx] += (1 << 14) - i16_sum;
+		e.data_i16[static_cast<size_t>(i) * e.stride_i16 + i16_greatest_idx] += (1 << 14) - i16_sum;
 
 		e.left[i] = left;
 	}
@@ -127,6 +157,32 @@ FilterContext matrix_to_filter(const RowMatrix<double> &m)
 	return e;
 }
 
+FilterMatrix area_to_matrix(const AreaFilterContext &area)
+{
+	FilterMatrix m{ static_cast<unsigned>(area.rows.size()), area.input_width, area.max_count };
+
+	for (unsigned i = 0; i < m.rows; ++i) {
+		const AreaFilterContext::Row &area_row = area.rows[i];
+		double *row = m.row(i);
+
+		m.left[i] = area_row.left;
+		m.width[i] = area_row.count;
+
+		if (area_row.count == 1) {
+			row[0] = area_row.coeff_first;
+			continue;
+		}
+
+		row[0] = area_row.coeff_first;
+		for (unsigned k = 1; k < area_row.count - 1; ++k) {
+			row[k] = area_row.coeff_mid;
+		}
+		row[area_row.count - 1] = area_row.coeff_last;
+	}
+
+	return m;
+}
+
 } // namespace
 
 
@@ -245,8 +301,29 @@ double LanczosFilter::operator()(double x) const
 }
 
 
+unsigned AreaFilter::support() const { return 1; }
+
+double AreaFilter::operator()(double x) const
+{
+	x = std::abs(x);
+	return x < 0.5 ? 1.0 : x == 0.5 ? 0.5 : 0.0;
+}
+
+
 FilterContext compute_filter(const Filter &f, unsigned src_dim, unsigned dst_dim, double shift, double width)
 {
+	// The area filter is defined by the overlap of pixel footprints, which can
+	// not be expressed by sampling the filter kernel.
+	if (dynamic_cast<const AreaFilter *>(&f)) {
+		try {
+			return matrix_to_filter(area_to_matrix(compute_area_filter(src_dim, dst_dim, shift, width)));
+		} catch (const std::length_error &) {
+			error::throw_<error::OutOfMemory>();
+		} catch (const std::overflow_error &) {
+			error::throw_<error::OutOfMemory>();
+		}
+	}
+
 	double scale = static_cast<double>(dst_dim) / width;
 	double step = std::min(scale, 1.0);
 	double support = static_cast<double>(f.support()) / step;
@@ -256,20 +333,25 @@ FilterContext compute_filter(const Filter &f, unsigned src_dim, unsigned dst_dim
 		error::throw_<error::ResamplingNotAvailable>("filter width too great");
 
 	try {
-		RowMatrix<double> m{ dst_dim, src_dim };
+		FilterMatrix m{ dst_dim, src_dim, std::min(filter_size, src_dim) };
+		std::vector<double> taps(filter_size);
+		std::vector<unsigned> taps_idx(filter_size);
 
 		for (unsigned i = 0; i < dst_dim; ++i) {
 			// Position of output sample on input grid.
 			double pos = (i + 0.5) / scale + shift;
 			double begin_pos = round_halfup(pos - filter_size / 2.0) + 0.5;
 
+			// Evaluate the filter once per tap.
 			double total = 0.0;
 			for (unsigned j = 0; j < filter_size; ++j) {
 				double xpos = begin_pos + j;
-				total += f((xpos - pos) * step);
+				taps[j] = f((xpos - pos) * step);
+				total += taps[j];
 			}
 
-			size_t left = SIZE_MAX;
+			unsigned left = UINT_MAX;
+			unsigned right = 0;
 
 			for (unsigned j = 0; j < filter_size; ++j) {
 				double xpos = begin_pos + j;
@@ -286,22 +368,86 @@ FilterContext compute_filter(const Filter &f, unsigned src_dim, unsigned dst_dim
 				// Clamp the position if it is still out of bounds.
 				real_pos = std::min(std::max(real_pos, 0.0), std::nextafter(src_dim, -INFINITY));
 
-				size_t idx = static_cast<size_t>(std::floor(real_pos));
-				m[i][idx] += f((xpos - pos) * step) / total;
+				unsigned idx = static_cast<unsigned>(std::floor(real_pos));
+				taps[j] /= total;
+				taps_idx[j] = idx;
+
+				// Taps with a zero coefficient do not extend the row to the right.
 				left = std::min(left, idx);
+				if (taps[j] != 0.0)
+					right = std::max(right, idx + 1);
 			}
 
-			// Force allocating an entry to keep the left offset table sorted.
-			if (m[i][left] == 0.0) {
-				m[i][left] = DBL_EPSILON;
-				m[i][left] = 0.0;
+			right = std::max(right, left + 1);
+			zassert_d(right - left <= m.capacity, "row too wide");
+
+			double *row = m.row(i);
+			for (unsigned j = 0; j < filter_size; ++j) {
+				row[taps_idx[j] - left] += taps[j];
 			}
+
+			m.left[i] = left;
+			m.width[i] = right - left;
 		}
 
 		return matrix_to_filter(m);
 	} catch (const std::length_error &) {
 		error::throw_<error::OutOfMemory>();
+	} catch (const std::overflow_error &) {
+		error::throw_<error::OutOfMemory>();
+	}
+}
+
+AreaFilterContext compute_area_filter(unsigned src_dim, unsigned dst_dim, double shift, double width)
+{
+	double scale = static_cast<double>(dst_dim) / width;
+	double src_dim_d = static_cast<double>(src_dim);
+
+	if (1.0 / scale > static_cast<double>(UINT_MAX / 2))
+		error::throw_<error::ResamplingNotAvailable>("filter width too great");
+
+	AreaFilterContext ctx{};
+
+	try {
+		ctx.rows.resize(dst_dim);
+	} catch (const std::length_error &) {
+		error::throw_<error::OutOfMemory>();
 	}
+
+	ctx.input_width = src_dim;
+	ctx.max_count = 0;
+
+	for (unsigned i = 0; i < dst_dim; ++i) {
+		AreaFilterContext::Row &row = ctx.rows[i];
+
+		// Footprint of output sample on input grid, clipped to the image.
+		double begin_pos = std::min(std::max(i / scale + shift, 0.0), src_dim_d);
+		double end_pos = std::min(std::max((i + 1) / scale + shift, 0.0), src_dim_d);
+
+		unsigned left = static_cast<unsigned>(std::floor(begin_pos));
+		unsigned right = static_cast<unsigned>(std::ceil(end_pos));
+
+		// Degenerate footprint. Take the nearest sample.
+		if (end_pos - begin_pos < DBL_EPSILON * src_dim_d || right <= left + 1) {
+			row.left = std::min(left, src_dim - 1);
+			row.count = 1;
+			row.coeff_first = 1.0f;
+			row.coeff_mid = 0.0f;
+			row.coeff_last = 0.0f;
+		} else {
+			double total = end_pos - begin_pos;
+
+			row.left = left;
+			row.count = right - left;
+			row.coeff_first = static_cast<float>((left + 1 - begin_pos) / total);
+			row.coeff_mid = static_cast<float>(1.0 / total);
+			row.coeff_last = static_cast<float>((end_pos - (right - 1)) / total);
+		}
+
+		ctx.max_count = std::max(ctx.max_count, row.count);
+	}
+
+	return ctx;
 }
 
 } // namespace resize
@@ -4,6 +4,7 @@
 #define ZIMG_RESIZE_FILTER_H_
 
 #include <cstddef>
+#include <vector>
 #include "common/alloc.h"
 
 namespace zimg {
@@ -127,6 +128,19 @@ public:
 	double operator()(double x) const override;
 };
 
+/**
+ * Area (a.k.a. box) filter.
+ *
+ * Each output sample is the average of the input samples covered by its
+ * footprint, weighted by the fraction of each input sample covered.
+ */
+class AreaFilter : public Filter {
+public:
+	unsigned support() const override;
+
+	double operator()(double x) const override;
+};
+
 /**
  * Computed filter taps for a given scale and shift.
  */
@@ -177,6 +191,57 @@ struct FilterContext {
  */
 FilterContext compute_filter(const Filter &f, unsigned src_dim, unsigned dst_dim, double shift, double width);
 
+/**
+ * Computed footprints for an area filter.
+ *
+ * Each output sample is the sum of an input span, in which only the first and
+ * last samples are partially covered. The interior samples share a common
+ * coefficient, allowing the span to be processed as a running sum.
+ */
+struct AreaFilterContext {
+	struct Row {
+		/**
+		 * Index of first input sample.
+		 */
+		unsigned left;
+
+		/**
+		 * Number of input samples.
+		 */
+		unsigned count;
+
+		/**
+		 * Coefficients of the first, interior, and last input samples.
+		 * If the count is one, only the first coefficient is used.
+		 */
+		float coeff_first;
+		float coeff_mid;
+		float coeff_last;
+	};
+
+	/**
+	 * Width of the filter input.
+	 */
+	unsigned input_width;
+
+	/**
+	 * Maximum number of input samples in a footprint.
+	 */
+	unsigned max_count;
+
+	/**
+	 * Footprint of each output sample.
+	 */
+	std::vector<Row> rows;
+};
+
+/**
+ * Compute the footprints of an area filter for a scale and shift.
+ *
+ * @see compute_filter
+ */
+AreaFilterContext compute_area_filter(unsigned src_dim, unsigned dst_dim, double shift, double width);
+
 } // namespace resize
 } // namespace zimg
 
@@ -21,6 +21,20 @@ bool resize_h_first(double xscale, double yscale) noexcept
 	return h_first_cost < v_first_cost;
 }
 
+bool resize_v_transpose(const Filter &filter, double yscale, unsigned width, PixelType type) noexcept
+{
+	// The transposed vertical pass buffers the entire plane and transposes each
+	// sample twice. The direct pass is faster while the input rows of one tile
+	// fit in cache, which the graph ensures by narrowing the tile. The
+	// transposed pass is therefore limited to filters with so many taps that
+	// even the narrowest tile, matching TILE_WIDTH_MIN in the graph, spills.
+	constexpr unsigned min_tile_width = 128;
+
+	double taps = 2.0 * filter.support() * std::max(1.0 / yscale, 1.0);
+	double window = taps * std::min(width, min_tile_width) * pixel_size(type);
+	return window > cpu_cache_size();
+}
+
 } // namespace
 
 
@@ -36,7 +50,8 @@ ResizeConversion::ResizeConversion(unsigned src_width, unsigned src_height, Pixe
 	shift_h{},
 	subwidth{ static_cast<double>(src_width) },
 	subheight{ static_cast<double>(src_height) },
-	cpu{ CPUClass::NONE }
+	cpu{ CPUClass::NONE },
+	uv{}
 {}
 
 auto ResizeConversion::create() const -> filter_pair try
@@ -53,9 +68,12 @@ auto ResizeConversion::create() const -> filter_pair try
 	auto builder = ResizeImplBuilder{ src_width, src_height, type }
 		.set_depth(depth)
 		.set_filter(filter)
-		.set_cpu(cpu);
+		.set_cpu(cpu)
+		.set_uv(uv);
 	filter_pair ret{};
 
+	builder.set_transpose(!skip_v && resize_v_transpose(*filter, static_cast<double>(dst_height) / subheight, std::max(src_width, dst_width), type));
+
 	if (skip_h) {
 		ret.first = builder.set_horizontal(false)
 		                   .set_dst_dim(dst_height)
@@ -39,6 +39,7 @@ struct ResizeConversion {
 	BUILDER_MEMBER(double, subwidth)
 	BUILDER_MEMBER(double, subheight)
 	BUILDER_MEMBER(CPUClass, cpu)
+	BUILDER_MEMBER(bool, uv)
 #undef BUILDER_MEMBER
 
 	ResizeConversion(unsigned src_width, unsigned src_height, PixelType type);
@@ -1,6 +1,9 @@
 #include <algorithm>
 #include <climits>
 #include <cstdint>
+#include <cstring>
+#include "common/align.h"
+#include "common/checked_int.h"
 #include "common/cpuinfo.h"
 #include "common/except.h"
 #include "common/make_unique.h"
@@ -106,13 +109,249 @@ void resize_line_v_f32_c(const FilterContext &filter, const graph::ImageBuffer<c
 	}
 }
 
+void resize_line_h_u16_uv_c(const FilterContext &filter, const uint16_t *src_u, const uint16_t *src_v, uint16_t *dst_u, uint16_t *dst_v,
+                            unsigned left, unsigned right, unsigned pixel_max)
+{
+	for (unsigned j = left; j < right; ++j) {
+		unsigned left = filter.left[j];
+		int32_t accum_u = 0;
+		int32_t accum_v = 0;
+
+		for (unsigned k = 0; k < filter.filter_width; ++k) {
+			int32_t coeff = filter.data_i16[j * filter.stride_i16 + k];
+
+			accum_u += coeff * unpack_pixel_u16(src_u[left + k]);
+			accum_v += coeff * unpack_pixel_u16(src_v[left + k]);
+		}
+
+		dst_u[j] = pack_pixel_u16(accum_u, pixel_max);
+		dst_v[j] = pack_pixel_u16(accum_v, pixel_max);
+	}
+}
+
+void resize_line_h_f32_uv_c(const FilterContext &filter, const float *src_u, const float *src_v, float *dst_u, float *dst_v, unsigned left, unsigned right)
+{
+	for (unsigned j = left; j < right; ++j) {
+		unsigned top = filter.left[j];
+		float accum_u = 0;
+		float accum_v = 0;
+
+		for (unsigned k = 0; k < filter.filter_width; ++k) {
+			float coeff = filter.data[j * filter.stride + k];
+
+			accum_u += coeff * src_u[top + k];
+			accum_v += coeff * src_v[top + k];
+		}
+
+		dst_u[j] = accum_u;
+		dst_v[j] = accum_v;
+	}
+}
+
+void resize_line_v_u16_uv_c(const FilterContext &filter, const graph::ImageBuffer<const uint16_t> &src_u, const graph::ImageBuffer<const uint16_t> &src_v,
+                            const graph::ImageBuffer<uint16_t> &dst_u, const graph::ImageBuffer<uint16_t> &dst_v, unsigned i, unsigned left, unsigned right, unsigned pixel_max)
+{
+	const int16_t *filter_coeffs = &filter.data_i16[i * filter.stride_i16];
+	unsigned top = filter.left[i];
+
+	for (unsigned j = left; j < right; ++j) {
+		int32_t accum_u = 0;
+		int32_t accum_v = 0;
+
+		for (unsigned k = 0; k < filter.filter_width; ++k) {
+			int32_t coeff = filter_coeffs[k];
+
+			accum_u += coeff * unpack_pixel_u16(src_u[top + k][j]);
+			accum_v += coeff * unpack_pixel_u16(src_v[top + k][j]);
+		}
+
+		dst_u[i][j] = pack_pixel_u16(accum_u, pixel_max);
+		dst_v[i][j] = pack_pixel_u16(accum_v, pixel_max);
+	}
+}
+
+void resize_line_v_f32_uv_c(const FilterContext &filter, const graph::ImageBuffer<const float> &src_u, const graph::ImageBuffer<const float> &src_v,
+                            const graph::ImageBuffer<float> &dst_u, const graph::ImageBuffer<float> &dst_v, unsigned i, unsigned left, unsigned right)
+{
+	const float *filter_coeffs = &filter.data[i * filter.stride];
+	unsigned top = filter.left[i];
+
+	for (unsigned j = left; j < right; ++j) {
+		float accum_u = 0;
+		float accum_v = 0;
+
+		for (unsigned k = 0; k < filter.filter_width; ++k) {
+			float coeff = filter_coeffs[k];
+
+			accum_u += coeff * src_u[top + k][j];
+			accum_v += coeff * src_v[top + k][j];
+		}
+
+		dst_u[i][j] = accum_u;
+		dst_v[i][j] = accum_v;
+	}
+}
+
+uint16_t pack_pixel_area_u16(float x, int32_t pixel_max) noexcept
+{
+	int32_t y = static_cast<int32_t>(x + 0.5f);
+	y = std::max(std::min(y, pixel_max), static_cast<int32_t>(0));
+
+	return static_cast<uint16_t>(y);
+}
+
+void resize_line_h_area_u16_c(const AreaFilterContext &filter, const uint16_t *src, uint16_t *dst, unsigned left, unsigned right, unsigned pixel_max)
+{
+	for (unsigned j = left; j < right; ++j) {
+		const AreaFilterContext::Row &row = filter.rows[j];
+		const uint16_t *src_p = src + row.left;
+
+		if (row.count == 1) {
+			dst[j] = src_p[0];
+			continue;
+		}
+
+		uint32_t sum = 0;
+
+		for (unsigned k = 1; k < row.count - 1; ++k) {
+			sum += src_p[k];
+		}
+
+		float accum = row.coeff_first * src_p[0] + row.coeff_mid * static_cast<float>(sum) + row.coeff_last * src_p[row.count - 1];
+		dst[j] = pack_pixel_area_u16(accum, pixel_max);
+	}
+}
+
+void resize_line_h_area_f32_c(const AreaFilterContext &filter, const float *src, float *dst, unsigned left, unsigned right)
+{
+	for (unsigned j = left; j < right; ++j) {
+		const AreaFilterContext::Row &row = filter.rows[j];
+		const float *src_p = src + row.left;
+
+		if (row.count == 1) {
+			dst[j] = src_p[0];
+			continue;
+		}
+
+		float sum = 0;
+
+		for (unsigned k = 1; k < row.count - 1; ++k) {
+			sum += src_p[k];
+		}
+
+		dst[j] = row.coeff_first * src_p[0] + row.coeff_mid * sum + row.coeff_last * src_p[row.count - 1];
+	}
+}
+
+void resize_line_v_area_u16_c(const AreaFilterContext &filter, const graph::ImageBuffer<const uint16_t> &src, const graph::ImageBuffer<uint16_t> &dst, uint32_t *accum, unsigned i, unsigned left, unsigned right, unsigned pixel_max)
+{
+	const AreaFilterContext::Row &row = filter.rows[i];
+	const uint16_t *src_first = src[row.left];
+	const uint16_t *src_last = src[row.left + row.count - 1];
+	uint16_t *dst_p = dst[i];
+
+	if (row.count == 1) {
+		std::copy(src_first + left, src_first + right, dst_p + left);
+		return;
+	}
+
+	float coeff_first = row.coeff_first;
+	float coeff_mid = row.coeff_mid;
+	float coeff_last = row.coeff_last;
+
+	if (row.count == 2) {
+		for (unsigned j = left; j < right; ++j) {
+			dst_p[j] = pack_pixel_area_u16(coeff_first * src_first[j] + coeff_last * src_last[j], pixel_max);
+		}
+		return;
+	}
+
+	const uint16_t *src_p = src[row.left + 1];
+	for (unsigned j = left; j < right; ++j) {
+		accum[j] = src_p[j];
+	}
+
+	for (unsigned k = 2; k < row.count - 1; ++k) {
+		src_p = src[row.left + k];
+
+		for (unsigned j = left; j < right; ++j) {
+			accum[j] += src_p[j];
+		}
+	}
+
+	for (unsigned j = left; j < right; ++j) {
+		float x = coeff_first * src_first[j] + coeff_mid * static_cast<float>(accum[j]) + coeff_last * src_last[j];
+		dst_p[j] = pack_pixel_area_u16(x, pixel_max);
+	}
+}
+
+void resize_line_v_area_f32_c(const AreaFilterContext &filter, const graph::ImageBuffer<const float> &src, const graph::ImageBuffer<float> &dst, float *accum, unsigned i, unsigned left, unsigned right)
+{
+	const AreaFilterContext::Row &row = filter.rows[i];
+	const float *src_first = src[row.left];
+	const float *src_last = src[row.left + row.count - 1];
+	float *dst_p = dst[i];
+
+	if (row.count == 1) {
+		std::copy(src_first + left, src_first + right, dst_p + left);
+		return;
+	}
+
+	float coeff_first = row.coeff_first;
+	float coeff_mid = row.coeff_mid;
+	float coeff_last = row.coeff_last;
+
+	if (row.count == 2) {
+		for (unsigned j = left; j < right; ++j) {
+			dst_p[j] = coeff_first * src_first[j] + coeff_last * src_last[j];
+		}
+		return;
+	}
+
+	// With a single interior row, the row itself is the running sum.
+	const float *mid = src[row.left + 1];
+
+	if (row.count > 3) {
+		const float *src_p = src[row.left + 2];
+
+		for (unsigned j = left; j < right; ++j) {
+			accum[j] = mid[j] + src_p[j];
+		}
+
+		for (unsigned k = 3; k < row.count - 1; ++k) {
+			src_p = src[row.left + k];
+
+			for (unsigned j = left; j < right; ++j) {
+				accum[j] += src_p[j];
+			}
+		}
+
+		mid = accum;
+	}
+
+	for (unsigned j = left; j < right; ++j) {
+		dst_p[j] = coeff_first * src_first[j] + coeff_mid * mid[j] + coeff_last * src_last[j];
+	}
+}
+
+template <class T>
+void resize_line_h_point_c(const FilterContext &filter, const void *src, void *dst, unsigned left, unsigned right)
+{
+	const T *src_p = static_cast<const T *>(src);
+	T *dst_p = static_cast<T *>(dst);
+
+	for (unsigned j = left; j < right; ++j) {
+		dst_p[j] = src_p[filter.left[j]];
+	}
+}
+
 
 class ResizeImplH_C : public ResizeImplH {
 	PixelType m_type;
 	int32_t m_pixel_max;
 public:
-	ResizeImplH_C(const FilterContext &filter, unsigned height, PixelType type, unsigned depth) :
-		ResizeImplH(filter, image_attributes{ filter.filter_rows, height, type }),
+	ResizeImplH_C(const FilterContext &filter, unsigned height, PixelType type, unsigned depth, bool uv = false) :
+		ResizeImplH(filter, image_attributes{ filter.filter_rows, height, type }, uv),
 		m_type{ type },
 		m_pixel_max{ static_cast<int32_t>(1UL << depth) - 1 }
 	{
@@ -122,7 +361,13 @@ public:
 
 	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *, unsigned i, unsigned left, unsigned right) const override
 	{
-		if (m_type == PixelType::WORD)
+		if (m_uv && m_type == PixelType::WORD)
+			resize_line_h_u16_uv_c(m_filter, static_cast<const uint16_t *>(src[1][i]), static_cast<const uint16_t *>(src[2][i]),
+			                       static_cast<uint16_t *>(dst[1][i]), static_cast<uint16_t *>(dst[2][i]), left, right, m_pixel_max);
+		else if (m_uv)
+			resize_line_h_f32_uv_c(m_filter, static_cast<const float *>(src[1][i]), static_cast<const float *>(src[2][i]),
+			                       static_cast<float *>(dst[1][i]), static_cast<float *>(dst[2][i]), left, right);
+		else if (m_type == PixelType::WORD)
 			resize_line_h_u16_c(m_filter, static_cast<const uint16_t *>((*src)[i]), static_cast<uint16_t *>((*dst)[i]), left, right, m_pixel_max);
 		else
 			resize_line_h_f32_c(m_filter, static_cast<const float *>((*src)[i]), static_cast<float *>((*dst)[i]), left, right);
@@ -133,8 +378,8 @@ class ResizeImplV_C : public ResizeImplV {
 	PixelType m_type;
 	int32_t m_pixel_max;
 public:
-	ResizeImplV_C(const FilterContext &filter, unsigned width, PixelType type, unsigned depth) :
-		ResizeImplV(filter, image_attributes{ width, filter.filter_rows, type}),
+	ResizeImplV_C(const FilterContext &filter, unsigned width, PixelType type, unsigned depth, bool uv = false) :
+		ResizeImplV(filter, image_attributes{ width, filter.filter_rows, type}, uv),
 		m_type{ type },
 		m_pixel_max{ static_cast<int32_t>(1UL << depth) - 1 }
 	{
@@ -144,20 +389,349 @@ public:
 
 	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *, unsigned i, unsigned left, unsigned right) const override
 	{
-		if (m_type == PixelType::WORD)
+		if (m_uv && m_type == PixelType::WORD)
+			resize_line_v_u16_uv_c(m_filter, graph::static_buffer_cast<const uint16_t>(src[1]), graph::static_buffer_cast<const uint16_t>(src[2]),
+			                       graph::static_buffer_cast<uint16_t>(dst[1]), graph::static_buffer_cast<uint16_t>(dst[2]), i, left, right, m_pixel_max);
+		else if (m_uv)
+			resize_line_v_f32_uv_c(m_filter, graph::static_buffer_cast<const float>(src[1]), graph::static_buffer_cast<const float>(src[2]),
+			                       graph::static_buffer_cast<float>(dst[1]), graph::static_buffer_cast<float>(dst[2]), i, left, right);
+		else if (m_type == PixelType::WORD)
 			resize_line_v_u16_c(m_filter, graph::static_buffer_cast<const uint16_t>(*src), graph::static_buffer_cast<uint16_t>(*dst), i, left, right, m_pixel_max);
 		else
 			resize_line_v_f32_c(m_filter, graph::static_buffer_cast<const float>(*src), graph::static_buffer_cast<float>(*dst), i, left, right);
 	}
 };
 
+
+// Copies columns [left, left + count) of rows [0, height) into consecutive
+// rows of a tile. Rows beyond the image width replicate the last column.
+template <class T>
+void transpose_to_tile(const graph::ImageBuffer<const T> &src, T *tile, size_t tile_stride, unsigned left, unsigned count, unsigned tile_height, unsigned height)
+{
+	for (unsigned i = 0; i < height; i += 8) {
+		const T *src_p[8];
+		unsigned n = std::min(height - i, 8U);
+
+		for (unsigned k = 0; k < 8; ++k) {
+			src_p[k] = src[i + std::min(k, n - 1)] + left;
+		}
+
+		for (unsigned j = 0; j < tile_height; ++j) {
+			unsigned jj = std::min(j, count - 1);
+			T *tile_p = tile + j * tile_stride + i;
+
+			for (unsigned k = 0; k < n; ++k) {
+				tile_p[k] = src_p[k][jj];
+			}
+		}
+	}
+}
+
+// Inverse of transpose_to_tile. Only the first count rows of the tile are stored.
+template <class T>
+void transpose_from_tile(const T *tile, size_t tile_stride, const graph::ImageBuffer<T> &dst, unsigned left, unsigned count, unsigned height)
+{
+	for (unsigned i = 0; i < height; i += 8) {
+		T *dst_p[8];
+		unsigned n = std::min(height - i, 8U);
+
+		for (unsigned k = 0; k < n; ++k) {
+			dst_p[k] = dst[i + k] + left;
+		}
+
+		for (unsigned j = 0; j < count; ++j) {
+			const T *tile_p = tile + j * tile_stride + i;
+
+			for (unsigned k = 0; k < n; ++k) {
+				dst_p[k][j] = tile_p[k];
+			}
+		}
+	}
+}
+
+std::unique_ptr<graph::ImageFilter> create_resize_impl_h(const FilterContext &filter_ctx, unsigned height, PixelType type, unsigned depth, CPUClass cpu)
+{
+	std::unique_ptr<graph::ImageFilter> ret;
+
+#if defined(ZIMG_X86)
+	ret = create_resize_impl_h_x86(filter_ctx, height, type, depth, cpu);
+#elif defined(ZIMG_ARM)
+	ret = create_resize_impl_h_arm(filter_ctx, height, type, depth, cpu);
+#endif
+	if (!ret)
+		ret = ztd::make_unique<ResizeImplH_C>(filter_ctx, height, type, depth);
+
+	return ret;
+}
+
+std::unique_ptr<graph::ImageFilter> create_resize_impl_v(const FilterContext &filter_ctx, unsigned width, PixelType type, unsigned depth, CPUClass cpu)
+{
+	std::unique_ptr<graph::ImageFilter> ret;
+
+#if defined(ZIMG_X86)
+	ret = create_resize_impl_v_x86(filter_ctx, width, type, depth, cpu);
+#elif defined(ZIMG_ARM)
+	ret = create_resize_impl_v_arm(filter_ctx, width, type, depth, cpu);
+#endif
+	if (!ret)
+		ret = ztd::make_unique<ResizeImplV_C>(filter_ctx, width, type, depth);
+
+	return ret;
+}
+
+// Scalar code for both planes is slower than a vector kernel applied to each
+// plane, so the C implementation is only used when vector code is disabled.
+std::unique_ptr<graph::ImageFilter> create_resize_impl_h_uv(const FilterContext &filter_ctx, unsigned height, PixelType type, unsigned depth, CPUClass cpu)
+{
+	std::unique_ptr<graph::ImageFilter> ret;
+
+#if defined(ZIMG_X86)
+	ret = create_resize_impl_h_uv_x86(filter_ctx, height, type, depth, cpu);
+#endif
+	if (!ret && cpu == CPUClass::NONE && (type == PixelType::WORD || type == PixelType::FLOAT))
+		ret = ztd::make_unique<ResizeImplH_C>(filter_ctx, height, type, depth, true);
+
+	return ret;
+}
+
+std::unique_ptr<graph::ImageFilter> create_resize_impl_v_uv(const FilterContext &filter_ctx, unsigned width, PixelType type, unsigned depth, CPUClass cpu)
+{
+	std::unique_ptr<graph::ImageFilter> ret;
+
+#if defined(ZIMG_X86)
+	ret = create_resize_impl_v_uv_x86(filter_ctx, width, type, depth, cpu);
+#endif
+	if (!ret && cpu == CPUClass::NONE && (type == PixelType::WORD || type == PixelType::FLOAT))
+		ret = ztd::make_unique<ResizeImplV_C>(filter_ctx, width, type, depth, true);
+
+	return ret;
+}
+
+// Tile height matches the strips processed by transpose_tile_func.
+constexpr unsigned TRANSPOSE_TILE_HEIGHT = 16;
+
+// Vertical resize evaluated as a horizontal resize of the transposed image.
+// Strips of columns are transposed into a tile, filtered by the horizontal
+// kernel, and transposed back. Each input row is read once, independent of
+// the filter width, at the cost of buffering the entire plane.
+class ResizeImplV_Transpose : public ResizeImplV {
+	std::unique_ptr<graph::ImageFilter> m_impl;
+	transpose_tile_func m_to_tile;
+	transpose_tile_func m_from_tile;
+	PixelType m_type;
+	size_t m_src_stride;
+	size_t m_dst_stride;
+
+	template <class T>
+	void process_tile(const graph::ImageBuffer<const T> &src, const graph::ImageBuffer<T> &dst, void *tmp) const
+	{
+		unsigned src_height = m_filter.input_width;
+		unsigned dst_height = m_attr.height;
+		unsigned lines = m_impl->get_simultaneous_lines();
+
+		T *src_tile = static_cast<T *>(tmp);
+		T *dst_tile = src_tile + m_src_stride * TRANSPOSE_TILE_HEIGHT;
+		void *impl_tmp = dst_tile + m_dst_stride * TRANSPOSE_TILE_HEIGHT;
+
+		graph::ImageBuffer<void> src_buf{ src_tile, static_cast<ptrdiff_t>(m_src_stride * sizeof(T)), graph::BUFFER_MAX };
+		graph::ImageBuffer<void> dst_buf{ dst_tile, static_cast<ptrdiff_t>(m_dst_stride * sizeof(T)), graph::BUFFER_MAX };
+		graph::ImageBuffer<const void> impl_src_buf = src_buf;
+
+		for (unsigned j = 0; j < m_attr.width; j += TRANSPOSE_TILE_HEIGHT) {
+			unsigned count = std::min(m_attr.width - j, TRANSPOSE_TILE_HEIGHT);
+			bool full = count == TRANSPOSE_TILE_HEIGHT;
+
+			if (full && m_to_tile)
+				m_to_tile(src, src_buf, j, src_height);
+			else
+				transpose_to_tile(src, src_tile, m_src_stride, j, count, TRANSPOSE_TILE_HEIGHT, src_height);
+
+			for (unsigned jj = 0; jj < count; jj += lines) {
+				m_impl->process(nullptr, &impl_src_buf, &dst_buf, impl_tmp, jj, 0, dst_height);
+			}
+
+			if (full && m_from_tile)
+				m_from_tile(dst_buf, dst, j, dst_height);
+			else
+				transpose_from_tile(dst_tile, m_dst_stride, dst, j, count, dst_height);
+		}
+	}
+public:
+	ResizeImplV_Transpose(const FilterContext &filter, unsigned width, PixelType type, unsigned depth, CPUClass cpu) :
+		ResizeImplV(filter, image_attributes{ width, filter.filter_rows, type }),
+		m_to_tile{},
+		m_from_tile{},
+		m_type{ type },
+		m_src_stride{ ceil_n(filter.input_width, ALIGNMENT / pixel_size(type)) },
+		m_dst_stride{ ceil_n(filter.filter_rows, ALIGNMENT / pixel_size(type)) }
+	{
+		if (m_type != PixelType::WORD && m_type != PixelType::FLOAT)
+			error::throw_<error::InternalError>("pixel type not supported");
+
+		m_impl = create_resize_impl_h(filter, TRANSPOSE_TILE_HEIGHT, type, depth, cpu);
+		zassert_d(TRANSPOSE_TILE_HEIGHT % m_impl->get_simultaneous_lines() == 0, "wrong tile height");
+
+#if defined(ZIMG_X86)
+		m_to_tile = select_transpose_to_tile_func_x86(type, cpu);
+		m_from_tile = select_transpose_from_tile_func_x86(type, cpu);
+#endif
+	}
+
+	filter_flags get_flags() const override
+	{
+		filter_flags flags{};
+
+		flags.has_state = true;
+		flags.entire_row = true;
+		flags.entire_plane = true;
+
+		return flags;
+	}
+
+	pair_unsigned get_required_row_range(unsigned) const override { return{ 0, m_filter.input_width }; }
+
+	pair_unsigned get_required_col_range(unsigned, unsigned) const override { return{ 0, m_attr.width }; }
+
+	unsigned get_simultaneous_lines() const override { return graph::BUFFER_MAX; }
+
+	unsigned get_max_buffering() const override { return graph::BUFFER_MAX; }
+
+	size_t get_tmp_size(unsigned, unsigned) const override
+	{
+		try {
+			checked_size_t size = static_cast<checked_size_t>(m_src_stride) + m_dst_stride;
+			size *= TRANSPOSE_TILE_HEIGHT;
+			size *= pixel_size(m_type);
+			size += m_impl->get_tmp_size(0, m_attr.height);
+			return size.get();
+		} catch (const std::overflow_error &) {
+			error::throw_<error::OutOfMemory>();
+		}
+	}
+
+	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *tmp, unsigned, unsigned, unsigned) const override
+	{
+		if (m_type == PixelType::WORD)
+			process_tile(graph::static_buffer_cast<const uint16_t>(*src), graph::static_buffer_cast<uint16_t>(*dst), tmp);
+		else
+			process_tile(graph::static_buffer_cast<const float>(*src), graph::static_buffer_cast<float>(*dst), tmp);
+	}
+};
+
+// Filters with a single tap select one input sample for each output sample.
+// The coefficient is always one, so the sample is copied without conversion.
+class ResizeImplH_Point : public ResizeImplH {
+	decltype(&resize_line_h_point_c<uint8_t>) m_func;
+public:
+	ResizeImplH_Point(const FilterContext &filter, unsigned height, PixelType type) :
+		ResizeImplH(filter, image_attributes{ filter.filter_rows, height, type }),
+		m_func{}
+	{
+		zassert_d(filter.filter_width == 1, "wrong filter width");
+
+		switch (pixel_size(type)) {
+		case sizeof(uint8_t):
+			m_func = resize_line_h_point_c<uint8_t>;
+			break;
+		case sizeof(uint16_t):
+			m_func = resize_line_h_point_c<uint16_t>;
+			break;
+		case sizeof(uint32_t):
+			m_func = resize_line_h_point_c<uint32_t>;
+			break;
+		default:
+			error::throw_<error::InternalError>("pixel type not supported");
+		}
+	}
+
+	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *, unsigned i, unsigned left, unsigned right) const override
+	{
+		m_func(m_filter, (*src)[i], (*dst)[i], left, right);
+	}
+};
+
+class ResizeImplV_Point : public ResizeImplV {
+	unsigned m_pixel_size;
+public:
+	ResizeImplV_Point(const FilterContext &filter, unsigned width, PixelType type) :
+		ResizeImplV(filter, image_attributes{ width, filter.filter_rows, type }),
+		m_pixel_size{ pixel_size(type) }
+	{
+		zassert_d(filter.filter_width == 1, "wrong filter width");
+	}
+
+	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *, unsigned i, unsigned left, unsigned right) const override
+	{
+		const char *src_p = static_cast<const char *>((*src)[m_filter.left[i]]);
+		char *dst_p = static_cast<char *>((*dst)[i]);
+
+		std::memcpy(dst_p + static_cast<size_t>(left) * m_pixel_size, src_p + static_cast<size_t>(left) * m_pixel_size, static_cast<size_t>(right - left) * m_pixel_size);
+	}
+};
+
+class ResizeImplH_Area : public ResizeImplH {
+	AreaFilterContext m_area;
+	PixelType m_type;
+	int32_t m_pixel_max;
+public:
+	ResizeImplH_Area(const FilterContext &filter, const AreaFilterContext &area, unsigned height, PixelType type, unsigned depth) :
+		ResizeImplH(filter, image_attributes{ filter.filter_rows, height, type }),
+		m_area(area),
+		m_type{ type },
+		m_pixel_max{ static_cast<int32_t>(1UL << depth) - 1 }
+	{
+		if (m_type != PixelType::WORD && m_type != PixelType::FLOAT)
+			error::throw_<error::InternalError>("pixel type not supported");
+	}
+
+	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *, unsigned i, unsigned left, unsigned right) const override
+	{
+		if (m_type == PixelType::WORD)
+			resize_line_h_area_u16_c(m_area, static_cast<const uint16_t *>((*src)[i]), static_cast<uint16_t *>((*dst)[i]), left, right, m_pixel_max);
+		else
+			resize_line_h_area_f32_c(m_area, static_cast<const float *>((*src)[i]), static_cast<float *>((*dst)[i]), left, right);
+	}
+};
+
+class ResizeImplV_Area : public ResizeImplV {
+	AreaFilterContext m_area;
+	PixelType m_type;
+	int32_t m_pixel_max;
+public:
+	ResizeImplV_Area(const FilterContext &filter, const AreaFilterContext &area, unsigned width, PixelType type, unsigned depth) :
+		ResizeImplV(filter, image_attributes{ width, filter.filter_rows, type }),
+		m_area(area),
+		m_type{ type },
+		m_pixel_max{ static_cast<int32_t>(1UL << depth) - 1 }
+	{
+		if (m_type != PixelType::WORD && m_type != PixelType::FLOAT)
+			error::throw_<error::InternalError>("pixel type not supported");
+	}
+
+	size_t get_tmp_size(unsigned, unsigned) const override
+	{
+		// Interior rows are accumulated into a line of 32-bit sums.
+		static_assert(sizeof(uint32_t) == sizeof(float), "wrong type");
+		return m_area.max_count > 2 ? (static_cast<checked_size_t>(m_attr.width) * sizeof(float)).get() : 0;
+	}
+
+	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *tmp, unsigned i, unsigned left, unsigned right) const override
+	{
+		if (m_type == PixelType::WORD)
+			resize_line_v_area_u16_c(m_area, graph::static_buffer_cast<const uint16_t>(*src), graph::static_buffer_cast<uint16_t>(*dst), static_cast<uint32_t *>(tmp), i, left, right, m_pixel_max);
+		else
+			resize_line_v_area_f32_c(m_area, graph::static_buffer_cast<const float>(*src), graph::static_buffer_cast<float>(*dst), static_cast<float *>(tmp), i, left, right);
+	}
+};
+
 } // namespace
 
 
-ResizeImplH::ResizeImplH(const FilterContext &filter, const image_attributes &attr) :
+ResizeImplH::ResizeImplH(const FilterContext &filter, const image_attributes &attr, bool uv) :
 	m_filter(filter),
 	m_attr(attr),
-	m_is_sorted{ std::is_sorted(m_filter.left.begin(), m_filter.left.end()) }
+	m_is_sorted{ std::is_sorted(m_filter.left.begin(), m_filter.left.end()) },
+	m_uv{ uv }
 {
 	zassert_d(m_filter.input_width <= pixel_max_width(attr.type), "overflow");
 	zassert_d(attr.width <= pixel_max_width(attr.type), "overflow");
@@ -169,6 +743,7 @@ graph::ImageFilter::filter_flags ResizeImplH::get_flags() const
 
 	flags.same_row = true;
 	flags.entire_row = !m_is_sorted;
+	flags.color = m_uv;
 
 	return flags;
 }
@@ -201,10 +776,11 @@ unsigned ResizeImplH::get_max_buffering() const
 }
 
 
-ResizeImplV::ResizeImplV(const FilterContext &filter, const image_attributes &attr) :
+ResizeImplV::ResizeImplV(const FilterContext &filter, const image_attributes &attr, bool uv) :
 	m_filter(filter),
 	m_attr(attr),
-	m_is_sorted{ std::is_sorted(m_filter.left.begin(), m_filter.left.end()) }
+	m_is_sorted{ std::is_sorted(m_filter.left.begin(), m_filter.left.end()) },
+	m_uv{ uv }
 {
 	zassert_d(m_filter.input_width <= pixel_max_width(attr.type), "overflow");
 	zassert_d(attr.width <= pixel_max_width(attr.type), "overflow");
@@ -215,6 +791,7 @@ graph::ImageFilter::filter_flags ResizeImplV::get_flags() const
 	graph::ImageFilter::filter_flags flags{};
 
 	flags.entire_row = !m_is_sorted;
+	flags.color = m_uv;
 
 	return flags;
 }
@@ -263,31 +840,51 @@ ResizeImplBuilder::ResizeImplBuilder(unsigned src_width, unsigned src_height, Pi
 	filter{},
 	shift{},
 	subwidth{},
-	cpu{ CPUClass::NONE }
+	cpu{ CPUClass::NONE },
+	transpose{},
+	uv{}
 {}
 
 std::unique_ptr<graph::ImageFilter> ResizeImplBuilder::create() const
 {
-	std::unique_ptr<graph::ImageFilter> ret;
-
 	unsigned src_dim = horizontal ? src_width : src_height;
 	FilterContext filter_ctx = compute_filter(*filter, src_dim, dst_dim, shift, subwidth);
 
-#if defined(ZIMG_X86)
-	ret = horizontal ?
-		create_resize_impl_h_x86(filter_ctx, src_height, type, depth, cpu) :
-		create_resize_impl_v_x86(filter_ctx, src_width, type, depth, cpu);
-#elif defined(ZIMG_ARM)
-	ret = horizontal ?
-		create_resize_impl_h_arm(filter_ctx, src_height, type, depth, cpu) :
-		create_resize_impl_v_arm(filter_ctx, src_width, type, depth, cpu);
-#endif
-	if (!ret && horizontal)
-		ret = ztd::make_unique<ResizeImplH_C>(filter_ctx, src_height, type, depth);
-	if (!ret && !horizontal)
-		ret = ztd::make_unique<ResizeImplV_C>(filter_ctx, src_width, type, depth);
+	// Single-tap filters (e.g. point) are evaluated as a gather, for any pixel type.
+	if (filter_ctx.filter_width == 1) {
+		if (horizontal)
+			return ztd::make_unique<ResizeImplH_Point>(filter_ctx, src_height, type);
+		else
+			return ztd::make_unique<ResizeImplV_Point>(filter_ctx, src_width, type);
+	}
 
-	return ret;
+	// The area filter is evaluated as a running sum, independent of the
+	// scaling ratio. The integer sum is limited to 32 bits.
+	if (dynamic_cast<const AreaFilter *>(filter) && (type == PixelType::WORD || type == PixelType::FLOAT)) {
+		AreaFilterContext area_ctx = compute_area_filter(src_dim, dst_dim, shift, subwidth);
+
+		if (type == PixelType::FLOAT || area_ctx.max_count <= (1UL << 16)) {
+			if (horizontal)
+				return ztd::make_unique<ResizeImplH_Area>(filter_ctx, area_ctx, src_height, type, depth);
+			else
+				return ztd::make_unique<ResizeImplV_Area>(filter_ctx, area_ctx, src_width, type, depth);
+		}
+	}
+
+	if (!horizontal && transpose && (type == PixelType::WORD || type == PixelType::FLOAT))
+		return ztd::make_unique<ResizeImplV_Transpose>(filter_ctx, src_width, type, depth, cpu);
+
+	if (uv) {
+		std::unique_ptr<graph::ImageFilter> ret = horizontal ?
+			create_resize_impl_h_uv(filter_ctx, src_height, type, depth, cpu) :
+			create_resize_impl_v_uv(filter_ctx, src_width, type, depth, cpu);
+		if (ret)
+			return ret;
+	}
+
+	return horizontal ?
+		create_resize_impl_h(filter_ctx, src_height, type, depth, cpu) :
+		create_resize_impl_v(filter_ctx, src_width, type, depth, cpu);
 }
 
 } // namespace resize
@@ -14,13 +14,16 @@ enum class PixelType;
 
 namespace resize {
 
+// A filter constructed with uv set is a color filter which resizes planes 1
+// and 2 (U and V) with the same coefficients. Plane 0 is not accessed.
 class ResizeImplH : public graph::ImageFilterBase {
 protected:
 	FilterContext m_filter;
 	image_attributes m_attr;
 	bool m_is_sorted;
+	bool m_uv;
 
-	ResizeImplH(const FilterContext &filter, const image_attributes &attr);
+	ResizeImplH(const FilterContext &filter, const image_attributes &attr, bool uv = false);
 public:
 	filter_flags get_flags() const override;
 
@@ -38,8 +41,9 @@ protected:
 	FilterContext m_filter;
 	image_attributes m_attr;
 	bool m_is_sorted;
+	bool m_uv;
 
-	ResizeImplV(const FilterContext &filter, const image_attributes &attr);
+	ResizeImplV(const FilterContext &filter, const image_attributes &attr, bool uv = false);
 public:
 	filter_flags get_flags() const override;
 
@@ -50,6 +54,14 @@ public:
 	unsigned get_max_buffering() const override;
 };
 
+// Transposes a strip of 16 columns between an image and a tile. The
+// to_tile variant copies columns [left, left + 16) of rows [0, height) into
+// tile rows [0, 16), and the from_tile variant performs the inverse.
+typedef void (*transpose_tile_func)(const graph::ImageBuffer<const void> &src, const graph::ImageBuffer<void> &dst, unsigned left, unsigned height);
+
+// If uv is set, the builder returns a filter for the U and V planes where
+// one is implemented for the pixel type and CPU. Otherwise, the returned
+// greyscale filter is applied to each plane.
 struct ResizeImplBuilder {
 	unsigned src_width;
 	unsigned src_height;
@@ -63,6 +75,8 @@ struct ResizeImplBuilder {
 	BUILDER_MEMBER(double, shift)
 	BUILDER_MEMBER(double, subwidth)
 	BUILDER_MEMBER(CPUClass, cpu)
+	BUILDER_MEMBER(bool, transpose)
+	BUILDER_MEMBER(bool, uv)
 #undef BUILDER_MEMBER
 
 	ResizeImplBuilder(unsigned src_width, unsigned src_height, PixelType type);
@@ -176,8 +176,13 @@ void transpose_line_8x8(T * RESTRICT dst, const T * const * RESTRICT src, unsign
 	}
 }
 
+// If Offset is set, INT16_MIN is added to each pixel, as required by the signed
+// multiply in the U+V kernels.
+template <bool Offset = false>
 void transpose_line_16x16_epi16(uint16_t * RESTRICT dst, const uint16_t * const * RESTRICT src, unsigned left, unsigned right)
 {
+	const __m256i i16_min = _mm256_set1_epi16(INT16_MIN);
+
 	for (unsigned j = left; j < right; j += 16) {
 		__m256i x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15;
 
@@ -200,6 +205,25 @@ void transpose_line_16x16_epi16(uint16_t * RESTRICT dst, const uint16_t * const
 
 		mm256_transpose16_epi16(x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15);
 
+		if (Offset) {
+			x0 = _mm256_add_epi16(x0, i16_min);
+			x1 = _mm256_add_epi16(x1, i16_min);
+			x2 = _mm256_add_epi16(x2, i16_min);
+			x3 = _mm256_add_epi16(x3, i16_min);
+			x4 = _mm256_add_epi16(x4, i16_min);
+			x5 = _mm256_add_epi16(x5, i16_min);
+			x6 = _mm256_add_epi16(x6, i16_min);
+			x7 = _mm256_add_epi16(x7, i16_min);
+			x8 = _mm256_add_epi16(x8, i16_min);
+			x9 = _mm256_add_epi16(x9, i16_min);
+			x10 = _mm256_add_epi16(x10, i16_min);
+			x11 = _mm256_add_epi16(x11, i16_min);
+			x12 = _mm256_add_epi16(x12, i16_min);
+			x13 = _mm256_add_epi16(x13, i16_min);
+			x14 = _mm256_add_epi16(x14, i16_min);
+			x15 = _mm256_add_epi16(x15, i16_min);
+		}
+
 		_mm256_store_si256((__m256i *)(dst + 0), x0);
 		_mm256_store_si256((__m256i *)(dst + 16), x1);
 		_mm256_store_si256((__m256i *)(dst + 32), x2);
@@ -1166,6 +1190,531 @@ const typename resize_line_v_fp_avx2_jt<Traits>::func_type resize_line_v_fp_avx2
 };
 
 
+// Kernels for the U and V planes. Each coefficient is loaded once and applied
+// to both planes, with the same results as the kernels above.
+inline FORCE_INLINE void resize_line8_h_u16_uv_avx2_madd(const __m256i &c, const uint16_t *src_p, __m256i &accum_lo, __m256i &accum_hi)
+{
+	__m256i x0, x1, xl, xh;
+
+	// The source is already offset by INT16_MIN during transposition.
+	x0 = _mm256_load_si256((const __m256i *)(src_p + 0));
+	x1 = _mm256_load_si256((const __m256i *)(src_p + 16));
+
+	xl = _mm256_unpacklo_epi16(x0, x1);
+	xh = _mm256_unpackhi_epi16(x0, x1);
+	xl = _mm256_madd_epi16(c, xl);
+	xh = _mm256_madd_epi16(c, xh);
+
+	accum_lo = _mm256_add_epi32(accum_lo, xl);
+	accum_hi = _mm256_add_epi32(accum_hi, xh);
+}
+
+inline FORCE_INLINE __m256i resize_line8_h_u16_uv_avx2_pack(__m256i accum_lo, __m256i accum_hi, uint16_t limit)
+{
+	const __m256i i16_min = _mm256_set1_epi16(INT16_MIN);
+	const __m256i lim = _mm256_set1_epi16(limit + INT16_MIN);
+
+	accum_lo = export_i30_u16(accum_lo, accum_hi);
+	accum_lo = _mm256_min_epi16(accum_lo, lim);
+	accum_lo = _mm256_sub_epi16(accum_lo, i16_min);
+	return accum_lo;
+}
+
+template <bool DoLoop, unsigned Tail>
+inline FORCE_INLINE void resize_line8_h_u16_uv_avx2_xiter(unsigned j,
+                                                          const unsigned * RESTRICT filter_left, const int16_t * RESTRICT filter_data, unsigned filter_stride, unsigned filter_width,
+                                                          const uint16_t * RESTRICT src_u, const uint16_t * RESTRICT src_v, unsigned src_base, uint16_t limit,
+                                                          __m256i &out_u, __m256i &out_v)
+{
+	const int16_t *filter_coeffs = filter_data + j * filter_stride;
+	const uint16_t *src_pu = src_u + (filter_left[j] - src_base) * 16;
+	const uint16_t *src_pv = src_v + (filter_left[j] - src_base) * 16;
+
+	__m256i accum_ulo = _mm256_setzero_si256();
+	__m256i accum_uhi = _mm256_setzero_si256();
+	__m256i accum_vlo = _mm256_setzero_si256();
+	__m256i accum_vhi = _mm256_setzero_si256();
+	__m256i c;
+
+	unsigned k_end = DoLoop ? floor_n(filter_width + 1, 8) : 0;
+
+	// Coefficient pairs are broadcast from memory instead of shuffled.
+	for (unsigned k = 0; k < k_end; k += 8) {
+		c = _mm256_castps_si256(_mm256_broadcast_ss((const float *)(filter_coeffs + k + 0)));
+		resize_line8_h_u16_uv_avx2_madd(c, src_pu + 0, accum_ulo, accum_uhi);
+		resize_line8_h_u16_uv_avx2_madd(c, src_pv + 0, accum_vlo, accum_vhi);
+
+		c = _mm256_castps_si256(_mm256_broadcast_ss((const float *)(filter_coeffs + k + 2)));
+		resize_line8_h_u16_uv_avx2_madd(c, src_pu + 32, accum_ulo, accum_uhi);
+		resize_line8_h_u16_uv_avx2_madd(c, src_pv + 32, accum_vlo, accum_vhi);
+
+		c = _mm256_castps_si256(_mm256_broadcast_ss((const float *)(filter_coeffs + k + 4)));
+		resize_line8_h_u16_uv_avx2_madd(c, src_pu + 64, accum_ulo, accum_uhi);
+		resize_line8_h_u16_uv_avx2_madd(c, src_pv + 64, accum_vlo, accum_vhi);
+
+		c = _mm256_castps_si256(_mm256_broadcast_ss((const float *)(filter_coeffs + k + 6)));
+		resize_line8_h_u16_uv_avx2_madd(c, src_pu + 96, accum_ulo, accum_uhi);
+		resize_line8_h_u16_uv_avx2_madd(c, src_pv + 96, accum_vlo, accum_vhi);
+
+		src_pu += 128;
+		src_pv += 128;
+	}
+
+	if (Tail >= 2) {
+		c = _mm256_castps_si256(_mm256_broadcast_ss((const float *)(filter_coeffs + k_end + 0)));
+		resize_line8_h_u16_uv_avx2_madd(c, src_pu + 0, accum_ulo, accum_uhi);
+		resize_line8_h_u16_uv_avx2_madd(c, src_pv + 0, accum_vlo, accum_vhi);
+	}
+	if (Tail >= 4) {
+		c = _mm256_castps_si256(_mm256_broadcast_ss((const float *)(filter_coeffs + k_end + 2)));
+		resize_line8_h_u16_uv_avx2_madd(c, src_pu + 32, accum_ulo, accum_uhi);
+		resize_line8_h_u16_uv_avx2_madd(c, src_pv + 32, accum_vlo, accum_vhi);
+	}
+	if (Tail >= 6) {
+		c = _mm256_castps_si256(_mm256_broadcast_ss((const float *)(filter_coeffs + k_end + 4)));
+		resize_line8_h_u16_uv_avx2_madd(c, src_pu + 64, accum_ulo, accum_uhi);
+		resize_line8_h_u16_uv_avx2_madd(c, src_pv + 64, accum_vlo, accum_vhi);
+	}
+	if (Tail >= 8) {
+		c = _mm256_castps_si256(_mm256_broadcast_ss((const float *)(filter_coeffs + k_end + 6)));
+		resize_line8_h_u16_uv_avx2_madd(c, src_pu + 96, accum_ulo, accum_uhi);
+		resize_line8_h_u16_uv_avx2_madd(c, src_pv + 96, accum_vlo, accum_vhi);
+	}
+
+	out_u = resize_line8_h_u16_uv_avx2_pack(accum_ulo, accum_uhi, limit);
+	out_v = resize_line8_h_u16_uv_avx2_pack(accum_vlo, accum_vhi, limit);
+}
+
+inline FORCE_INLINE void scatter16_epi16(uint16_t * const *dst, unsigned j, __m256i x)
+{
+	mm_scatter_epi16(dst[0] + j, dst[1] + j, dst[2] + j, dst[3] + j, dst[4] + j, dst[5] + j, dst[6] + j, dst[7] + j, _mm256_castsi256_si128(x));
+	mm_scatter_epi16(dst[8] + j, dst[9] + j, dst[10] + j, dst[11] + j, dst[12] + j, dst[13] + j, dst[14] + j, dst[15] + j, _mm256_extractf128_si256(x, 1));
+}
+
+inline FORCE_INLINE void transpose_store16_epi16(uint16_t * const *dst, unsigned j, const uint16_t (*cache)[16])
+{
+	__m256i x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15;
+
+	x0 = _mm256_load_si256((const __m256i *)cache[0]);
+	x1 = _mm256_load_si256((const __m256i *)cache[1]);
+	x2 = _mm256_load_si256((const __m256i *)cache[2]);
+	x3 = _mm256_load_si256((const __m256i *)cache[3]);
+	x4 = _mm256_load_si256((const __m256i *)cache[4]);
+	x5 = _mm256_load_si256((const __m256i *)cache[5]);
+	x6 = _mm256_load_si256((const __m256i *)cache[6]);
+	x7 = _mm256_load_si256((const __m256i *)cache[7]);
+	x8 = _mm256_load_si256((const __m256i *)cache[8]);
+	x9 = _mm256_load_si256((const __m256i *)cache[9]);
+	x10 = _mm256_load_si256((const __m256i *)cache[10]);
+	x11 = _mm256_load_si256((const __m256i *)cache[11]);
+	x12 = _mm256_load_si256((const __m256i *)cache[12]);
+	x13 = _mm256_load_si256((const __m256i *)cache[13]);
+	x14 = _mm256_load_si256((const __m256i *)cache[14]);
+	x15 = _mm256_load_si256((const __m256i *)cache[15]);
+
+	mm256_transpose16_epi16(x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15);
+
+	_mm256_store_si256((__m256i *)(dst[0] + j), x0);
+	_mm256_store_si256((__m256i *)(dst[1] + j), x1);
+	_mm256_store_si256((__m256i *)(dst[2] + j), x2);
+	_mm256_store_si256((__m256i *)(dst[3] + j), x3);
+	_mm256_store_si256((__m256i *)(dst[4] + j), x4);
+	_mm256_store_si256((__m256i *)(dst[5] + j), x5);
+	_mm256_store_si256((__m256i *)(dst[6] + j), x6);
+	_mm256_store_si256((__m256i *)(dst[7] + j), x7);
+	_mm256_store_si256((__m256i *)(dst[8] + j), x8);
+	_mm256_store_si256((__m256i *)(dst[9] + j), x9);
+	_mm256_store_si256((__m256i *)(dst[10] + j), x10);
+	_mm256_store_si256((__m256i *)(dst[11] + j), x11);
+	_mm256_store_si256((__m256i *)(dst[12] + j), x12);
+	_mm256_store_si256((__m256i *)(dst[13] + j), x13);
+	_mm256_store_si256((__m256i *)(dst[14] + j), x14);
+	_mm256_store_si256((__m256i *)(dst[15] + j), x15);
+}
+
+template <bool DoLoop, unsigned Tail>
+void resize_line8_h_u16_uv_avx2(const unsigned * RESTRICT filter_left, const int16_t * RESTRICT filter_data, unsigned filter_stride, unsigned filter_width,
+                                const uint16_t * RESTRICT src_u, const uint16_t * RESTRICT src_v, uint16_t * const * dst_u, uint16_t * const * dst_v,
+                                unsigned src_base, unsigned left, unsigned right, uint16_t limit)
+{
+	unsigned vec_left = ceil_n(left, 16);
+	unsigned vec_right = floor_n(right, 16);
+	__m256i x_u, x_v;
+
+#define XITER resize_line8_h_u16_uv_avx2_xiter<DoLoop, Tail>
+#define XARGS filter_left, filter_data, filter_stride, filter_width, src_u, src_v, src_base, limit
+	for (unsigned j = left; j < vec_left; ++j) {
+		XITER(j, XARGS, x_u, x_v);
+		scatter16_epi16(dst_u, j, x_u);
+		scatter16_epi16(dst_v, j, x_v);
+	}
+
+	for (unsigned j = vec_left; j < vec_right; j += 16) {
+		uint16_t cache_u alignas(32)[16][16];
+		uint16_t cache_v alignas(32)[16][16];
+
+		for (unsigned jj = j; jj < j + 16; ++jj) {
+			XITER(jj, XARGS, x_u, x_v);
+			_mm256_store_si256((__m256i *)cache_u[jj - j], x_u);
+			_mm256_store_si256((__m256i *)cache_v[jj - j], x_v);
+		}
+
+		transpose_store16_epi16(dst_u, j, cache_u);
+		transpose_store16_epi16(dst_v, j, cache_v);
+	}
+
+	for (unsigned j = vec_right; j < right; ++j) {
+		XITER(j, XARGS, x_u, x_v);
+		scatter16_epi16(dst_u, j, x_u);
+		scatter16_epi16(dst_v, j, x_v);
+	}
+#undef XITER
+#undef XARGS
+}
+
+const decltype(&resize_line8_h_u16_uv_avx2<false, 0>) resize_line8_h_u16_uv_avx2_jt_small[] = {
+	resize_line8_h_u16_uv_avx2<false, 2>,
+	resize_line8_h_u16_uv_avx2<false, 2>,
+	resize_line8_h_u16_uv_avx2<false, 4>,
+	resize_line8_h_u16_uv_avx2<false, 4>,
+	resize_line8_h_u16_uv_avx2<false, 6>,
+	resize_line8_h_u16_uv_avx2<false, 6>,
+	resize_line8_h_u16_uv_avx2<false, 8>,
+	resize_line8_h_u16_uv_avx2<false, 8>,
+};
+
+const decltype(&resize_line8_h_u16_uv_avx2<false, 0>) resize_line8_h_u16_uv_avx2_jt_large[] = {
+	resize_line8_h_u16_uv_avx2<true, 0>,
+	resize_line8_h_u16_uv_avx2<true, 2>,
+	resize_line8_h_u16_uv_avx2<true, 2>,
+	resize_line8_h_u16_uv_avx2<true, 4>,
+	resize_line8_h_u16_uv_avx2<true, 4>,
+	resize_line8_h_u16_uv_avx2<true, 6>,
+	resize_line8_h_u16_uv_avx2<true, 6>,
+	resize_line8_h_u16_uv_avx2<true, 0>,
+};
+
+template <class Traits, unsigned FWidth, unsigned Tail>
+inline FORCE_INLINE void resize_line8_h_fp_uv_avx2_xiter(unsigned j,
+                                                         const unsigned * RESTRICT filter_left, const float * RESTRICT filter_data, unsigned filter_stride, unsigned filter_width,
+                                                         const typename Traits::pixel_type * RESTRICT src_u, const typename Traits::pixel_type * RESTRICT src_v, unsigned src_base,
+                                                         __m256 &out_u, __m256 &out_v)
+{
+	typedef typename Traits::pixel_type pixel_type;
+
+	const float *filter_coeffs = filter_data + j * filter_stride;
+	const pixel_type *src_pu = src_u + (filter_left[j] - src_base) * 8;
+	const pixel_type *src_pv = src_v + (filter_left[j] - src_base) * 8;
+
+	__m256 accum0_u = _mm256_setzero_ps();
+	__m256 accum1_u = _mm256_setzero_ps();
+	__m256 accum0_v = _mm256_setzero_ps();
+	__m256 accum1_v = _mm256_setzero_ps();
+	__m256 c, coeffs;
+
+	unsigned k_end = FWidth ? FWidth - Tail : floor_n(filter_width, 4);
+
+	for (unsigned k = 0; k < k_end; k += 4) {
+		coeffs = _mm256_broadcast_ps((const __m128 *)(filter_coeffs + k));
+
+		c = _mm256_shuffle_ps(coeffs, coeffs, _MM_SHUFFLE(0, 0, 0, 0));
+		accum0_u = _mm256_fmadd_ps(c, Traits::load8(src_pu + 0), accum0_u);
+		accum0_v = _mm256_fmadd_ps(c, Traits::load8(src_pv + 0), accum0_v);
+
+		c = _mm256_shuffle_ps(coeffs, coeffs, _MM_SHUFFLE(1, 1, 1, 1));
+		accum1_u = _mm256_fmadd_ps(c, Traits::load8(src_pu + 8), accum1_u);
+		accum1_v = _mm256_fmadd_ps(c, Traits::load8(src_pv + 8), accum1_v);
+
+		c = _mm256_shuffle_ps(coeffs, coeffs, _MM_SHUFFLE(2, 2, 2, 2));
+		accum0_u = _mm256_fmadd_ps(c, Traits::load8(src_pu + 16), accum0_u);
+		accum0_v = _mm256_fmadd_ps(c, Traits::load8(src_pv + 16), accum0_v);
+
+		c = _mm256_shuffle_ps(coeffs, coeffs, _MM_SHUFFLE(3, 3, 3, 3));
+		accum1_u = _mm256_fmadd_ps(c, Traits::load8(src_pu + 24), accum1_u);
+		accum1_v = _mm256_fmadd_ps(c, Traits::load8(src_pv + 24), accum1_v);
+
+		src_pu += 32;
+		src_pv += 32;
+	}
+
+	if (Tail >= 1) {
+		coeffs = _mm256_broadcast_ps((const __m128 *)(filter_coeffs + k_end));
+
+		c = _mm256_shuffle_ps(coeffs, coeffs, _MM_SHUFFLE(0, 0, 0, 0));
+		accum0_u = _mm256_fmadd_ps(c, Traits::load8(src_pu + 0), accum0_u);
+		accum0_v = _mm256_fmadd_ps(c, Traits::load8(src_pv + 0), accum0_v);
+	}
+	if (Tail >= 2) {
+		c = _mm256_shuffle_ps(coeffs, coeffs, _MM_SHUFFLE(1, 1, 1, 1));
+		accum1_u = _mm256_fmadd_ps(c, Traits::load8(src_pu + 8), accum1_u);
+		accum1_v = _mm256_fmadd_ps(c, Traits::load8(src_pv + 8), accum1_v);
+	}
+	if (Tail >= 3) {
+		c = _mm256_shuffle_ps(coeffs, coeffs, _MM_SHUFFLE(2, 2, 2, 2));
+		accum0_u = _mm256_fmadd_ps(c, Traits::load8(src_pu + 16), accum0_u);
+		accum0_v = _mm256_fmadd_ps(c, Traits::load8(src_pv + 16), accum0_v);
+	}
+	if (Tail >= 4) {
+		c = _mm256_shuffle_ps(coeffs, coeffs, _MM_SHUFFLE(3, 3, 3, 3));
+		accum1_u = _mm256_fmadd_ps(c, Traits::load8(src_pu + 24), accum1_u);
+		accum1_v = _mm256_fmadd_ps(c, Traits::load8(src_pv + 24), accum1_v);
+	}
+
+	if (!FWidth || FWidth >= 2) {
+		accum0_u = _mm256_add_ps(accum0_u, accum1_u);
+		accum0_v = _mm256_add_ps(accum0_v, accum1_v);
+	}
+
+	out_u = accum0_u;
+	out_v = accum0_v;
+}
+
+template <class Traits>
+inline FORCE_INLINE void scatter8(typename Traits::pixel_type * const *dst, unsigned j, __m256 x)
+{
+	Traits::scatter8(dst[0] + j, dst[1] + j, dst[2] + j, dst[3] + j, dst[4] + j, dst[5] + j, dst[6] + j, dst[7] + j, x);
+}
+
+template <class Traits>
+inline FORCE_INLINE void transpose_store8(typename Traits::pixel_type * const *dst, unsigned j, __m256 x0, __m256 x1, __m256 x2, __m256 x3, __m256 x4, __m256 x5, __m256 x6, __m256 x7)
+{
+	mm256_transpose8_ps(x0, x1, x2, x3, x4, x5, x6, x7);
+
+	Traits::store8(dst[0] + j, x0);
+	Traits::store8(dst[1] + j, x1);
+	Traits::store8(dst[2] + j, x2);
+	Traits::store8(dst[3] + j, x3);
+	Traits::store8(dst[4] + j, x4);
+	Traits::store8(dst[5] + j, x5);
+	Traits::store8(dst[6] + j, x6);
+	Traits::store8(dst[7] + j, x7);
+}
+
+template <class Traits, unsigned FWidth, unsigned Tail>
+void resize_line8_h_fp_uv_avx2(const unsigned * RESTRICT filter_left, const float * RESTRICT filter_data, unsigned filter_stride, unsigned filter_width,
+                               const typename Traits::pixel_type * RESTRICT src_u, const typename Traits::pixel_type * RESTRICT src_v,
+                               typename Traits::pixel_type * const * RESTRICT dst_u, typename Traits::pixel_type * const * RESTRICT dst_v,
+                               unsigned src_base, unsigned left, unsigned right)
+{
+	unsigned vec_left = ceil_n(left, 8);
+	unsigned vec_right = floor_n(right, 8);
+	__m256 x_u, x_v;
+
+#define XITER resize_line8_h_fp_uv_avx2_xiter<Traits, FWidth, Tail>
+#define XARGS filter_left, filter_data, filter_stride, filter_width, src_u, src_v, src_base
+	for (unsigned j = left; j < vec_left; ++j) {
+		XITER(j, XARGS, x_u, x_v);
+		scatter8<Traits>(dst_u, j, x_u);
+		scatter8<Traits>(dst_v, j, x_v);
+	}
+
+	for (unsigned j = vec_left; j < vec_right; j += 8) {
+		__m256 u0, u1, u2, u3, u4, u5, u6, u7;
+		__m256 v0, v1, v2, v3, v4, v5, v6, v7;
+
+		XITER(j + 0, XARGS, u0, v0);
+		XITER(j + 1, XARGS, u1, v1);
+		XITER(j + 2, XARGS, u2, v2);
+		XITER(j + 3, XARGS, u3, v3);
+		XITER(j + 4, XARGS, u4, v4);
+		XITER(j + 5, XARGS, u5, v5);
+		XITER(j + 6, XARGS, u6, v6);
+		XITER(j + 7, XARGS, u7, v7);
+
+		transpose_store8<Traits>(dst_u, j, u0, u1, u2, u3, u4, u5, u6, u7);
+		transpose_store8<Traits>(dst_v, j, v0, v1, v2, v3, v4, v5, v6, v7);
+	}
+
+	for (unsigned j = vec_right; j < right; ++j) {
+		XITER(j, XARGS, x_u, x_v);
+		scatter8<Traits>(dst_u, j, x_u);
+		scatter8<Traits>(dst_v, j, x_v);
+	}
+#undef XITER
+#undef XARGS
+}
+
+template <class Traits>
+struct resize_line8_h_fp_uv_avx2_jt {
+	typedef decltype(&resize_line8_h_fp_uv_avx2<Traits, 0, 0>) func_type;
+
+	static const func_type small[8];
+	static const func_type large[4];
+};
+
+template <class Traits>
+const typename resize_line8_h_fp_uv_avx2_jt<Traits>::func_type resize_line8_h_fp_uv_avx2_jt<Traits>::small[8] = {
+	resize_line8_h_fp_uv_avx2<Traits, 1, 1>,
+	resize_line8_h_fp_uv_avx2<Traits, 2, 2>,
+	resize_line8_h_fp_uv_avx2<Traits, 3, 3>,
+	resize_line8_h_fp_uv_avx2<Traits, 4, 4>,
+	resize_line8_h_fp_uv_avx2<Traits, 5, 1>,
+	resize_line8_h_fp_uv_avx2<Traits, 6, 2>,
+	resize_line8_h_fp_uv_avx2<Traits, 7, 3>,
+	resize_line8_h_fp_uv_avx2<Traits, 8, 4>
+};
+
+template <class Traits>
+const typename resize_line8_h_fp_uv_avx2_jt<Traits>::func_type resize_line8_h_fp_uv_avx2_jt<Traits>::large[4] = {
+	resize_line8_h_fp_uv_avx2<Traits, 0, 0>,
+	resize_line8_h_fp_uv_avx2<Traits, 0, 1>,
+	resize_line8_h_fp_uv_avx2<Traits, 0, 2>,
+	resize_line8_h_fp_uv_avx2<Traits, 0, 3>
+};
+
+template <unsigned N, bool ReadAccum, bool WriteToAccum>
+void resize_line_v_u16_uv_avx2(const int16_t * RESTRICT filter_data, const uint16_t * const * RESTRICT src_u, const uint16_t * const * RESTRICT src_v,
+                               uint16_t * RESTRICT dst_u, uint16_t * RESTRICT dst_v, uint32_t * RESTRICT accum_u, uint32_t * RESTRICT accum_v,
+                               unsigned left, unsigned right, uint16_t limit)
+{
+	unsigned vec_left = ceil_n(left, 16);
+	unsigned vec_right = floor_n(right, 16);
+	unsigned accum_base = floor_n(left, 16);
+
+	const __m256i c01 = _mm256_unpacklo_epi16(_mm256_set1_epi16(filter_data[0]), _mm256_set1_epi16(filter_data[1]));
+	const __m256i c23 = _mm256_unpacklo_epi16(_mm256_set1_epi16(filter_data[2]), _mm256_set1_epi16(filter_data[3]));
+	const __m256i c45 = _mm256_unpacklo_epi16(_mm256_set1_epi16(filter_data[4]), _mm256_set1_epi16(filter_data[5]));
+	const __m256i c67 = _mm256_unpacklo_epi16(_mm256_set1_epi16(filter_data[6]), _mm256_set1_epi16(filter_data[7]));
+
+	__m256i out_u, out_v;
+
+#define XITER resize_line_v_u16_avx2_xiter<N, ReadAccum, WriteToAccum>
+#define XARGS_U accum_base, src_u[0], src_u[1], src_u[2], src_u[3], src_u[4], src_u[5], src_u[6], src_u[7], accum_u, c01, c23, c45, c67, limit
+#define XARGS_V accum_base, src_v[0], src_v[1], src_v[2], src_v[3], src_v[4], src_v[5], src_v[6], src_v[7], accum_v, c01, c23, c45, c67, limit
+	if (left != vec_left) {
+		out_u = XITER(vec_left - 16, XARGS_U);
+		out_v = XITER(vec_left - 16, XARGS_V);
+
+		if (!WriteToAccum) {
+			mm256_store_idxhi_epi16((__m256i *)(dst_u + vec_left - 16), out_u, left % 16);
+			mm256_store_idxhi_epi16((__m256i *)(dst_v + vec_left - 16), out_v, left % 16);
+		}
+	}
+
+	for (unsigned j = vec_left; j < vec_right; j += 16) {
+		out_u = XITER(j, XARGS_U);
+		out_v = XITER(j, XARGS_V);
+
+		if (!WriteToAccum) {
+			_mm256_store_si256((__m256i *)(dst_u + j), out_u);
+			_mm256_store_si256((__m256i *)(dst_v + j), out_v);
+		}
+	}
+
+	if (right != vec_right) {
+		out_u = XITER(vec_right, XARGS_U);
+		out_v = XITER(vec_right, XARGS_V);
+
+		if (!WriteToAccum) {
+			mm256_store_idxlo_epi16((__m256i *)(dst_u + vec_right), out_u, right % 16);
+			mm256_store_idxlo_epi16((__m256i *)(dst_v + vec_right), out_v, right % 16);
+		}
+	}
+#undef XITER
+#undef XARGS_U
+#undef XARGS_V
+}
+
+const decltype(&resize_line_v_u16_uv_avx2<0, false, false>) resize_line_v_u16_uv_avx2_jt_a[] = {
+	resize_line_v_u16_uv_avx2<0, false, false>,
+	resize_line_v_u16_uv_avx2<0, false, false>,
+	resize_line_v_u16_uv_avx2<2, false, false>,
+	resize_line_v_u16_uv_avx2<2, false, false>,
+	resize_line_v_u16_uv_avx2<4, false, false>,
+	resize_line_v_u16_uv_avx2<4, false, false>,
+	resize_line_v_u16_uv_avx2<6, false, false>,
+	resize_line_v_u16_uv_avx2<6, false, false>,
+};
+
+const decltype(&resize_line_v_u16_uv_avx2<0, false, false>) resize_line_v_u16_uv_avx2_jt_b[] = {
+	resize_line_v_u16_uv_avx2<0, true, false>,
+	resize_line_v_u16_uv_avx2<0, true, false>,
+	resize_line_v_u16_uv_avx2<2, true, false>,
+	resize_line_v_u16_uv_avx2<2, true, false>,
+	resize_line_v_u16_uv_avx2<4, true, false>,
+	resize_line_v_u16_uv_avx2<4, true, false>,
+	resize_line_v_u16_uv_avx2<6, true, false>,
+	resize_line_v_u16_uv_avx2<6, true, false>,
+};
+
+template <class Traits, unsigned N, bool UpdateAccum>
+void resize_line_v_fp_uv_avx2(const float * RESTRICT filter_data, const typename Traits::pixel_type * const * RESTRICT src_u, const typename Traits::pixel_type * const * RESTRICT src_v,
+                              typename Traits::pixel_type * RESTRICT dst_u, typename Traits::pixel_type * RESTRICT dst_v, unsigned left, unsigned right)
+{
+	unsigned vec_left = ceil_n(left, 8);
+	unsigned vec_right = floor_n(right, 8);
+
+	const __m256 c0 = _mm256_broadcast_ss(filter_data + 0);
+	const __m256 c1 = _mm256_broadcast_ss(filter_data + 1);
+	const __m256 c2 = _mm256_broadcast_ss(filter_data + 2);
+	const __m256 c3 = _mm256_broadcast_ss(filter_data + 3);
+	const __m256 c4 = _mm256_broadcast_ss(filter_data + 4);
+	const __m256 c5 = _mm256_broadcast_ss(filter_data + 5);
+	const __m256 c6 = _mm256_broadcast_ss(filter_data + 6);
+	const __m256 c7 = _mm256_broadcast_ss(filter_data + 7);
+
+	__m256 accum_u, accum_v;
+
+#define XITER resize_line_v_fp_avx2_xiter<Traits, N, UpdateAccum>
+#define XARGS_U src_u[0], src_u[1], src_u[2], src_u[3], src_u[4], src_u[5], src_u[6], src_u[7], dst_u, c0, c1, c2, c3, c4, c5, c6, c7
+#define XARGS_V src_v[0], src_v[1], src_v[2], src_v[3], src_v[4], src_v[5], src_v[6], src_v[7], dst_v, c0, c1, c2, c3, c4, c5, c6, c7
+	if (left != vec_left) {
+		accum_u = XITER(vec_left - 8, XARGS_U);
+		accum_v = XITER(vec_left - 8, XARGS_V);
+		Traits::store_idxhi(dst_u + vec_left - 8, accum_u, left % 8);
+		Traits::store_idxhi(dst_v + vec_left - 8, accum_v, left % 8);
+	}
+
+	for (unsigned j = vec_left; j < vec_right; j += 8) {
+		accum_u = XITER(j, XARGS_U);
+		accum_v = XITER(j, XARGS_V);
+		Traits::store8(dst_u + j, accum_u);
+		Traits::store8(dst_v + j, accum_v);
+	}
+
+	if (right != vec_right) {
+		accum_u = XITER(vec_right, XARGS_U);
+		accum_v = XITER(vec_right, XARGS_V);
+		Traits::store_idxlo(dst_u + vec_right, accum_u, right % 8);
+		Traits::store_idxlo(dst_v + vec_right, accum_v, right % 8);
+	}
+#undef XITER
+#undef XARGS_U
+#undef XARGS_V
+}
+
+template <class Traits>
+struct resize_line_v_fp_uv_avx2_jt {
+	typedef decltype(&resize_line_v_fp_uv_avx2<Traits, 0, false>) func_type;
+
+	static const func_type table_a[8];
+	static const func_type table_b[8];
+};
+
+template <class Traits>
+const typename resize_line_v_fp_uv_avx2_jt<Traits>::func_type resize_line_v_fp_uv_avx2_jt<Traits>::table_a[8] = {
+	resize_line_v_fp_uv_avx2<Traits, 0, false>,
+	resize_line_v_fp_uv_avx2<Traits, 1, false>,
+	resize_line_v_fp_uv_avx2<Traits, 2, false>,
+	resize_line_v_fp_uv_avx2<Traits, 3, false>,
+	resize_line_v_fp_uv_avx2<Traits, 4, false>,
+	resize_line_v_fp_uv_avx2<Traits, 5, false>,
+	resize_line_v_fp_uv_avx2<Traits, 6, false>,
+	resize_line_v_fp_uv_avx2<Traits, 7, false>,
+};
+
+template <class Traits>
+const typename resize_line_v_fp_uv_avx2_jt<Traits>::func_type resize_line_v_fp_uv_avx2_jt<Traits>::table_b[8] = {
+	resize_line_v_fp_uv_avx2<Traits, 0, true>,
+	resize_line_v_fp_uv_avx2<Traits, 1, true>,
+	resize_line_v_fp_uv_avx2<Traits, 2, true>,
+	resize_line_v_fp_uv_avx2<Traits, 3, true>,
+	resize_line_v_fp_uv_avx2<Traits, 4, true>,
+	resize_line_v_fp_uv_avx2<Traits, 5, true>,
+	resize_line_v_fp_uv_avx2<Traits, 6, true>,
+	resize_line_v_fp_uv_avx2<Traits, 7, true>,
+};
+
 class ResizeImplH_U16_AVX2 final : public ResizeImplH {
 	decltype(&resize_line8_h_u16_avx2<false, 0>) m_func;
 	uint16_t m_pixel_max;
@@ -1288,6 +1837,146 @@ public:
 	}
 };
 
+class ResizeImplH_U16_UV_AVX2 final : public ResizeImplH {
+	decltype(&resize_line8_h_u16_uv_avx2<false, 0>) m_func;
+	uint16_t m_pixel_max;
+
+	size_t get_plane_tmp_size(unsigned left, unsigned right) const
+	{
+		auto range = get_required_col_range(left, right);
+		checked_size_t size = (static_cast<checked_size_t>(range.second) - floor_n(range.first, 16) + 16) * sizeof(uint16_t) * 16;
+		return ceil_n(size, ALIGNMENT).get();
+	}
+public:
+	ResizeImplH_U16_UV_AVX2(const FilterContext &filter, unsigned height, unsigned depth) :
+		ResizeImplH(filter, image_attributes{ filter.filter_rows, height, PixelType::WORD }, true),
+		m_func{},
+		m_pixel_max{ static_cast<uint16_t>((1UL << depth) - 1) }
+	{
+		if (filter.filter_width > 8)
+			m_func = resize_line8_h_u16_uv_avx2_jt_large[filter.filter_width % 8];
+		else
+			m_func = resize_line8_h_u16_uv_avx2_jt_small[filter.filter_width - 1];
+	}
+
+	unsigned get_simultaneous_lines() const override { return 16; }
+
+	size_t get_tmp_size(unsigned left, unsigned right) const override
+	{
+		try {
+			checked_size_t size = get_plane_tmp_size(left, right);
+			return (size * 2).get();
+		} catch (const std::overflow_error &) {
+			error::throw_<error::OutOfMemory>();
+		}
+	}
+
+	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *tmp, unsigned i, unsigned left, unsigned right) const override
+	{
+		const auto &src_u = graph::static_buffer_cast<const uint16_t>(src[1]);
+		const auto &src_v = graph::static_buffer_cast<const uint16_t>(src[2]);
+		const auto &dst_u = graph::static_buffer_cast<uint16_t>(dst[1]);
+		const auto &dst_v = graph::static_buffer_cast<uint16_t>(dst[2]);
+		auto range = get_required_col_range(left, right);
+
+		const uint16_t *src_ptr[16] = { 0 };
+		uint16_t *dst_ptr_u[16] = { 0 };
+		uint16_t *dst_ptr_v[16] = { 0 };
+		uint16_t *transpose_buf_u = static_cast<uint16_t *>(tmp);
+		uint16_t *transpose_buf_v = static_cast<uint16_t *>(static_cast<void *>(static_cast<unsigned char *>(tmp) + get_plane_tmp_size(left, right)));
+		unsigned height = get_image_attributes().height;
+
+		for (unsigned n = 0; n < 16; ++n) {
+			src_ptr[n] = src_u[std::min(i + n, height - 1)];
+		}
+		transpose_line_16x16_epi16<true>(transpose_buf_u, src_ptr, floor_n(range.first, 16), ceil_n(range.second, 16));
+
+		for (unsigned n = 0; n < 16; ++n) {
+			src_ptr[n] = src_v[std::min(i + n, height - 1)];
+		}
+		transpose_line_16x16_epi16<true>(transpose_buf_v, src_ptr, floor_n(range.first, 16), ceil_n(range.second, 16));
+
+		for (unsigned n = 0; n < 16; ++n) {
+			dst_ptr_u[n] = dst_u[std::min(i + n, height - 1)];
+			dst_ptr_v[n] = dst_v[std::min(i + n, height - 1)];
+		}
+
+		m_func(m_filter.left.data(), m_filter.data_i16.data(), m_filter.stride_i16, m_filter.filter_width,
+		       transpose_buf_u, transpose_buf_v, dst_ptr_u, dst_ptr_v, floor_n(range.first, 16), left, right, m_pixel_max);
+	}
+};
+
+template <class Traits>
+class ResizeImplH_FP_UV_AVX2 final : public ResizeImplH {
+	typedef typename Traits::pixel_type pixel_type;
+	typedef typename resize_line8_h_fp_uv_avx2_jt<Traits>::func_type func_type;
+
+	func_type m_func;
+
+	size_t get_plane_tmp_size(unsigned left, unsigned right) const
+	{
+		auto range = get_required_col_range(left, right);
+		checked_size_t size = (static_cast<checked_size_t>(range.second) - floor_n(range.first, 8) + 8) * sizeof(pixel_type) * 8;
+		return ceil_n(size, ALIGNMENT).get();
+	}
+public:
+	ResizeImplH_FP_UV_AVX2(const FilterContext &filter, unsigned height) :
+		ResizeImplH(filter, image_attributes{ filter.filter_rows, height, Traits::type_constant }, true),
+		m_func{}
+	{
+		if (filter.filter_width <= 8)
+			m_func = resize_line8_h_fp_uv_avx2_jt<Traits>::small[filter.filter_width - 1];
+		else
+			m_func = resize_line8_h_fp_uv_avx2_jt<Traits>::large[filter.filter_width % 4];
+	}
+
+	unsigned get_simultaneous_lines() const override { return 8; }
+
+	size_t get_tmp_size(unsigned left, unsigned right) const override
+	{
+		try {
+			checked_size_t size = get_plane_tmp_size(left, right);
+			return (size * 2).get();
+		} catch (const std::overflow_error &) {
+			error::throw_<error::OutOfMemory>();
+		}
+	}
+
+	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *tmp, unsigned i, unsigned left, unsigned right) const override
+	{
+		const auto &src_u = graph::static_buffer_cast<const pixel_type>(src[1]);
+		const auto &src_v = graph::static_buffer_cast<const pixel_type>(src[2]);
+		const auto &dst_u = graph::static_buffer_cast<pixel_type>(dst[1]);
+		const auto &dst_v = graph::static_buffer_cast<pixel_type>(dst[2]);
+		auto range = get_required_col_range(left, right);
+
+		const pixel_type *src_ptr[8] = { 0 };
+		pixel_type *dst_ptr_u[8] = { 0 };
+		pixel_type *dst_ptr_v[8] = { 0 };
+		pixel_type *transpose_buf_u = static_cast<pixel_type *>(tmp);
+		pixel_type *transpose_buf_v = static_cast<pixel_type *>(static_cast<void *>(static_cast<unsigned char *>(tmp) + get_plane_tmp_size(left, right)));
+		unsigned height = get_image_attributes().height;
+
+		for (unsigned n = 0; n < 8; ++n) {
+			src_ptr[n] = src_u[std::min(i + n, height - 1)];
+		}
+		transpose_line_8x8<Traits>(transpose_buf_u, src_ptr, floor_n(range.first, 8), ceil_n(range.second, 8));
+
+		for (unsigned n = 0; n < 8; ++n) {
+			src_ptr[n] = src_v[std::min(i + n, height - 1)];
+		}
+		transpose_line_8x8<Traits>(transpose_buf_v, src_ptr, floor_n(range.first, 8), ceil_n(range.second, 8));
+
+		for (unsigned n = 0; n < 8; ++n) {
+			dst_ptr_u[n] = dst_u[std::min(i + n, height - 1)];
+			dst_ptr_v[n] = dst_v[std::min(i + n, height - 1)];
+		}
+
+		m_func(m_filter.left.data(), m_filter.data.data(), m_filter.stride, m_filter.filter_width,
+		       transpose_buf_u, transpose_buf_v, dst_ptr_u, dst_ptr_v, floor_n(range.first, 8), left, right);
+	}
+};
+
 class ResizeImplH_Permute_U16_AVX2 final : public graph::ImageFilterBase {
 	typedef typename resize_line_h_perm_u16_avx2_jt::func_type func_type;
 
@@ -1631,6 +2320,123 @@ public:
 	}
 };
 
+class ResizeImplV_U16_UV_AVX2 final : public ResizeImplV {
+	uint16_t m_pixel_max;
+
+	size_t get_plane_tmp_size(unsigned left, unsigned right) const
+	{
+		checked_size_t size = 0;
+
+		if (m_filter.filter_width > 8)
+			size += ceil_n((ceil_n(checked_size_t{ right }, 16) - floor_n(left, 16)) * sizeof(uint32_t), ALIGNMENT);
+
+		return size.get();
+	}
+public:
+	ResizeImplV_U16_UV_AVX2(const FilterContext &filter, unsigned width, unsigned depth) :
+		ResizeImplV(filter, image_attributes{ width, filter.filter_rows, PixelType::WORD }, true),
+		m_pixel_max{ static_cast<uint16_t>((1UL << depth) - 1) }
+	{}
+
+	size_t get_tmp_size(unsigned left, unsigned right) const override
+	{
+		try {
+			checked_size_t size = get_plane_tmp_size(left, right);
+			return (size * 2).get();
+		} catch (const std::overflow_error &) {
+			error::throw_<error::OutOfMemory>();
+		}
+	}
+
+	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *tmp, unsigned i, unsigned left, unsigned right) const override
+	{
+		const auto &src_u = graph::static_buffer_cast<const uint16_t>(src[1]);
+		const auto &src_v = graph::static_buffer_cast<const uint16_t>(src[2]);
+		const auto &dst_u = graph::static_buffer_cast<uint16_t>(dst[1]);
+		const auto &dst_v = graph::static_buffer_cast<uint16_t>(dst[2]);
+
+		const int16_t *filter_data = m_filter.data_i16.data() + i * m_filter.stride_i16;
+		unsigned filter_width = m_filter.filter_width;
+		unsigned src_height = m_filter.input_width;
+
+		const uint16_t *src_lines_u[8] = { 0 };
+		const uint16_t *src_lines_v[8] = { 0 };
+		uint16_t *dst_line_u = dst_u[i];
+		uint16_t *dst_line_v = dst_v[i];
+		uint32_t *accum_buf_u = static_cast<uint32_t *>(tmp);
+		uint32_t *accum_buf_v = static_cast<uint32_t *>(static_cast<void *>(static_cast<unsigned char *>(tmp) + get_plane_tmp_size(left, right)));
+
+		unsigned top = m_filter.left[i];
+
+		auto load_lines = [&](unsigned k)
+		{
+			for (unsigned n = 0; n < 8; ++n) {
+				src_lines_u[n] = src_u[std::min(top + k + n, src_height - 1)];
+				src_lines_v[n] = src_v[std::min(top + k + n, src_height - 1)];
+			}
+		};
+
+		if (filter_width <= 8) {
+			load_lines(0);
+			resize_line_v_u16_uv_avx2_jt_a[filter_width - 1](filter_data, src_lines_u, src_lines_v, dst_line_u, dst_line_v, accum_buf_u, accum_buf_v, left, right, m_pixel_max);
+		} else {
+			unsigned k_end = ceil_n(filter_width, 8) - 8;
+
+			load_lines(0);
+			resize_line_v_u16_uv_avx2<6, false, true>(filter_data + 0, src_lines_u, src_lines_v, dst_line_u, dst_line_v, accum_buf_u, accum_buf_v, left, right, m_pixel_max);
+
+			for (unsigned k = 8; k < k_end; k += 8) {
+				load_lines(k);
+				resize_line_v_u16_uv_avx2<6, true, true>(filter_data + k, src_lines_u, src_lines_v, dst_line_u, dst_line_v, accum_buf_u, accum_buf_v, left, right, m_pixel_max);
+			}
+
+			load_lines(k_end);
+			resize_line_v_u16_uv_avx2_jt_b[filter_width - k_end - 1](filter_data + k_end, src_lines_u, src_lines_v, dst_line_u, dst_line_v, accum_buf_u, accum_buf_v, left, right, m_pixel_max);
+		}
+	}
+};
+
+template <class Traits>
+class ResizeImplV_FP_UV_AVX2 final : public ResizeImplV {
+	typedef typename Traits::pixel_type pixel_type;
+public:
+	ResizeImplV_FP_UV_AVX2(const FilterContext &filter, unsigned width) :
+		ResizeImplV(filter, image_attributes{ width, filter.filter_rows, Traits::type_constant }, true)
+	{}
+
+	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *, unsigned i, unsigned left, unsigned right) const override
+	{
+		const auto &src_u = graph::static_buffer_cast<const pixel_type>(src[1]);
+		const auto &src_v = graph::static_buffer_cast<const pixel_type>(src[2]);
+		const auto &dst_u = graph::static_buffer_cast<pixel_type>(dst[1]);
+		const auto &dst_v = graph::static_buffer_cast<pixel_type>(dst[2]);
+
+		const float *filter_data = m_filter.data.data() + i * m_filter.stride;
+		unsigned filter_width = m_filter.filter_width;
+		unsigned src_height = m_filter.input_width;
+
+		const pixel_type *src_lines_u[8] = { 0 };
+		const pixel_type *src_lines_v[8] = { 0 };
+		pixel_type *dst_line_u = dst_u[i];
+		pixel_type *dst_line_v = dst_v[i];
+
+		for (unsigned k = 0; k < filter_width; k += 8) {
+			unsigned taps_remain = std::min(filter_width - k, 8U);
+			unsigned top = m_filter.left[i] + k;
+
+			for (unsigned n = 0; n < 8; ++n) {
+				src_lines_u[n] = src_u[std::min(top + n, src_height - 1)];
+				src_lines_v[n] = src_v[std::min(top + n, src_height - 1)];
+			}
+
+			if (k == 0)
+				resize_line_v_fp_uv_avx2_jt<Traits>::table_a[taps_remain - 1](filter_data + k, src_lines_u, src_lines_v, dst_line_u, dst_line_v, left, right);
+			else
+				resize_line_v_fp_uv_avx2_jt<Traits>::table_b[taps_remain - 1](filter_data + k, src_lines_u, src_lines_v, dst_line_u, dst_line_v, left, right);
+		}
+	}
+};
+
 } // namespace
 
 
@@ -1675,6 +2481,262 @@ std::unique_ptr<graph::ImageFilter> create_resize_impl_v_avx2(const FilterContex
 	return ret;
 }
 
+std::unique_ptr<graph::ImageFilter> create_resize_impl_h_uv_avx2(const FilterContext &context, unsigned height, PixelType type, unsigned depth)
+{
+	std::unique_ptr<graph::ImageFilter> ret;
+
+	// The permute kernels need no transpose, which outweighs sharing the
+	// coefficients between planes. The greyscale filter is returned instead.
+#ifndef ZIMG_RESIZE_NO_PERMUTE
+	if (cpu_has_slow_permute(query_x86_capabilities()))
+		ret = nullptr;
+	else if (type == PixelType::WORD)
+		ret = ResizeImplH_Permute_U16_AVX2::create(context, height, depth);
+	else if (type == PixelType::HALF)
+		ret = ResizeImplH_Permute_FP_AVX2<f16_traits>::create(context, height);
+	else if (type == PixelType::FLOAT)
+		ret = ResizeImplH_Permute_FP_AVX2<f32_traits>::create(context, height);
+
+	if (ret)
+		return ret;
+#endif
+
+	if (type == PixelType::WORD)
+		ret = ztd::make_unique<ResizeImplH_U16_UV_AVX2>(context, height, depth);
+	else if (type == PixelType::HALF)
+		ret = ztd::make_unique<ResizeImplH_FP_UV_AVX2<f16_traits>>(context, height);
+	else if (type == PixelType::FLOAT)
+		ret = ztd::make_unique<ResizeImplH_FP_UV_AVX2<f32_traits>>(context, height);
+
+	return ret;
+}
+
+std::unique_ptr<graph::ImageFilter> create_resize_impl_v_uv_avx2(const FilterContext &context, unsigned width, PixelType type, unsigned depth)
+{
+	std::unique_ptr<graph::ImageFilter> ret;
+
+	if (type == PixelType::WORD)
+		ret = ztd::make_unique<ResizeImplV_U16_UV_AVX2>(context, width, depth);
+	else if (type == PixelType::HALF)
+		ret = ztd::make_unique<ResizeImplV_FP_UV_AVX2<f16_traits>>(context, width);
+	else if (type == PixelType::FLOAT)
+		ret = ztd::make_unique<ResizeImplV_FP_UV_AVX2<f32_traits>>(context, width);
+
+	return ret;
+}
+
+void transpose_to_tile_u16_avx2(const graph::ImageBuffer<const void> &src, const graph::ImageBuffer<void> &dst, unsigned left, unsigned height)
+{
+	const auto &src_buf = graph::static_buffer_cast<const uint16_t>(src);
+	const auto &dst_buf = graph::static_buffer_cast<uint16_t>(dst);
+	unsigned vec_height = floor_n(height, 16);
+
+	for (unsigned i = 0; i < vec_height; i += 16) {
+		__m256i x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15;
+
+		x0 = _mm256_loadu_si256((const __m256i *)(src_buf[i + 0] + left));
+		x1 = _mm256_loadu_si256((const __m256i *)(src_buf[i + 1] + left));
+		x2 = _mm256_loadu_si256((const __m256i *)(src_buf[i + 2] + left));
+		x3 = _mm256_loadu_si256((const __m256i *)(src_buf[i + 3] + left));
+		x4 = _mm256_loadu_si256((const __m256i *)(src_buf[i + 4] + left));
+		x5 = _mm256_loadu_si256((const __m256i *)(src_buf[i + 5] + left));
+		x6 = _mm256_loadu_si256((const __m256i *)(src_buf[i + 6] + left));
+		x7 = _mm256_loadu_si256((const __m256i *)(src_buf[i + 7] + left));
+		x8 = _mm256_loadu_si256((const __m256i *)(src_buf[i + 8] + left));
+		x9 = _mm256_loadu_si256((const __m256i *)(src_buf[i + 9] + left));
+		x10 = _mm256_loadu_si256((const __m256i *)(src_buf[i + 10] + left));
+		x11 = _mm256_loadu_si256((const __m256i *)(src_buf[i + 11] + left));
+		x12 = _mm256_loadu_si256((const __m256i *)(src_buf[i + 12] + left));
+		x13 = _mm256_loadu_si256((const __m256i *)(src_buf[i + 13] + left));
+		x14 = _mm256_loadu_si256((const __m256i *)(src_buf[i + 14] + left));
+		x15 = _mm256_loadu_si256((const __m256i *)(src_buf[i + 15] + left));
+
+		mm256_transpose16_epi16(x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15);
+
+		_mm256_store_si256((__m256i *)(dst_buf[0] + i), x0);
+		_mm256_store_si256((__m256i *)(dst_buf[1] + i), x1);
+		_mm256_store_si256((__m256i *)(dst_buf[2] + i), x2);
+		_mm256_store_si256((__m256i *)(dst_buf[3] + i), x3);
+		_mm256_store_si256((__m256i *)(dst_buf[4] + i), x4);
+		_mm256_store_si256((__m256i *)(dst_buf[5] + i), x5);
+		_mm256_store_si256((__m256i *)(dst_buf[6] + i), x6);
+		_mm256_store_si256((__m256i *)(dst_buf[7] + i), x7);
+		_mm256_store_si256((__m256i *)(dst_buf[8] + i), x8);
+		_mm256_store_si256((__m256i *)(dst_buf[9] + i), x9);
+		_mm256_store_si256((__m256i *)(dst_buf[10] + i), x10);
+		_mm256_store_si256((__m256i *)(dst_buf[11] + i), x11);
+		_mm256_store_si256((__m256i *)(dst_buf[12] + i), x12);
+		_mm256_store_si256((__m256i *)(dst_buf[13] + i), x13);
+		_mm256_store_si256((__m256i *)(dst_buf[14] + i), x14);
+		_mm256_store_si256((__m256i *)(dst_buf[15] + i), x15);
+	}
+	for (unsigned i = vec_height; i < height; ++i) {
+		for (unsigned k = 0; k < 16; ++k) {
+			dst_buf[k][i] = src_buf[i][left + k];
+		}
+	}
+}
+
+void transpose_from_tile_u16_avx2(const graph::ImageBuffer<const void> &src, const graph::ImageBuffer<void> &dst, unsigned left, unsigned height)
+{
+	const auto &src_buf = graph::static_buffer_cast<const uint16_t>(src);
+	const auto &dst_buf = graph::static_buffer_cast<uint16_t>(dst);
+	unsigned vec_height = floor_n(height, 16);
+
+	for (unsigned i = 0; i < vec_height; i += 16) {
+		__m256i x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15;
+
+		x0 = _mm256_load_si256((const __m256i *)(src_buf[0] + i));
+		x1 = _mm256_load_si256((const __m256i *)(src_buf[1] + i));
+		x2 = _mm256_load_si256((const __m256i *)(src_buf[2] + i));
+		x3 = _mm256_load_si256((const __m256i *)(src_buf[3] + i));
+		x4 = _mm256_load_si256((const __m256i *)(src_buf[4] + i));
+		x5 = _mm256_load_si256((const __m256i *)(src_buf[5] + i));
+		x6 = _mm256_load_si256((const __m256i *)(src_buf[6] + i));
+		x7 = _mm256_load_si256((const __m256i *)(src_buf[7] + i));
+		x8 = _mm256_load_si256((const __m256i *)(src_buf[8] + i));
+		x9 = _mm256_load_si256((const __m256i *)(src_buf[9] + i));
+		x10 = _mm256_load_si256((const __m256i *)(src_buf[10] + i));
+		x11 = _mm256_load_si256((const __m256i *)(src_buf[11] + i));
+		x12 = _mm256_load_si256((const __m256i *)(src_buf[12] + i));
+		x13 = _mm256_load_si256((const __m256i *)(src_buf[13] + i));
+		x14 = _mm256_load_si256((const __m256i *)(src_buf[14] + i));
+		x15 = _mm256_load_si256((const __m256i *)(src_buf[15] + i));
+
+		mm256_transpose16_epi16(x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15);
+
+		_mm256_storeu_si256((__m256i *)(dst_buf[i + 0] + left), x0);
+		_mm256_storeu_si256((__m256i *)(dst_buf[i + 1] + left), x1);
+		_mm256_storeu_si256((__m256i *)(dst_buf[i + 2] + left), x2);
+		_mm256_storeu_si256((__m256i *)(dst_buf[i + 3] + left), x3);
+		_mm256_storeu_si256((__m256i *)(dst_buf[i + 4] + left), x4);
+		_mm256_storeu_si256((__m256i *)(dst_buf[i + 5] + left), x5);
+		_mm256_storeu_si256((__m256i *)(dst_buf[i + 6] + left), x6);
+		_mm256_storeu_si256((__m256i *)(dst_buf[i + 7] + left), x7);
+		_mm256_storeu_si256((__m256i *)(dst_buf[i + 8] + left), x8);
+		_mm256_storeu_si256((__m256i *)(dst_buf[i + 9] + left), x9);
+		_mm256_storeu_si256((__m256i *)(dst_buf[i + 10] + left), x10);
+		_mm256_storeu_si256((__m256i *)(dst_buf[i + 11] + left), x11);
+		_mm256_storeu_si256((__m256i *)(dst_buf[i + 12] + left), x12);
+		_mm256_storeu_si256((__m256i *)(dst_buf[i + 13] + left), x13);
+		_mm256_storeu_si256((__m256i *)(dst_buf[i + 14] + left), x14);
+		_mm256_storeu_si256((__m256i *)(dst_buf[i + 15] + left), x15);
+	}
+	for (unsigned i = vec_height; i < height; ++i) {
+		for (unsigned k = 0; k < 16; ++k) {
+			dst_buf[i][left + k] = src_buf[k][i];
+		}
+	}
+}
+
+void transpose_to_tile_f32_avx2(const graph::ImageBuffer<const void> &src, const graph::ImageBuffer<void> &dst, unsigned left, unsigned height)
+{
+	const auto &src_buf = graph::static_buffer_cast<const float>(src);
+	const auto &dst_buf = graph::static_buffer_cast<float>(dst);
+	unsigned vec_height = floor_n(height, 8);
+
+	for (unsigned i = 0; i < vec_height; i += 8) {
+		__m256 x0, x1, x2, x3, x4, x5, x6, x7;
+		__m256 y0, y1, y2, y3, y4, y5, y6, y7;
+
+		x0 = _mm256_loadu_ps(src_buf[i + 0] + left);
+		x1 = _mm256_loadu_ps(src_buf[i + 1] + left);
+		x2 = _mm256_loadu_ps(src_buf[i + 2] + left);
+		x3 = _mm256_loadu_ps(src_buf[i + 3] + left);
+		x4 = _mm256_loadu_ps(src_buf[i + 4] + left);
+		x5 = _mm256_loadu_ps(src_buf[i + 5] + left);
+		x6 = _mm256_loadu_ps(src_buf[i + 6] + left);
+		x7 = _mm256_loadu_ps(src_buf[i + 7] + left);
+		y0 = _mm256_loadu_ps(src_buf[i + 0] + left + 8);
+		y1 = _mm256_loadu_ps(src_buf[i + 1] + left + 8);
+		y2 = _mm256_loadu_ps(src_buf[i + 2] + left + 8);
+		y3 = _mm256_loadu_ps(src_buf[i + 3] + left + 8);
+		y4 = _mm256_loadu_ps(src_buf[i + 4] + left + 8);
+		y5 = _mm256_loadu_ps(src_buf[i + 5] + left + 8);
+		y6 = _mm256_loadu_ps(src_buf[i + 6] + left + 8);
+		y7 = _mm256_loadu_ps(src_buf[i + 7] + left + 8);
+
+		mm256_transpose8_ps(x0, x1, x2, x3, x4, x5, x6, x7);
+		mm256_transpose8_ps(y0, y1, y2, y3, y4, y5, y6, y7);
+
+		_mm256_store_ps(dst_buf[0] + i, x0);
+		_mm256_store_ps(dst_buf[1] + i, x1);
+		_mm256_store_ps(dst_buf[2] + i, x2);
+		_mm256_store_ps(dst_buf[3] + i, x3);
+		_mm256_store_ps(dst_buf[4] + i, x4);
+		_mm256_store_ps(dst_buf[5] + i, x5);
+		_mm256_store_ps(dst_buf[6] + i, x6);
+		_mm256_store_ps(dst_buf[7] + i, x7);
+		_mm256_store_ps(dst_buf[8] + i, y0);
+		_mm256_store_ps(dst_buf[9] + i, y1);
+		_mm256_store_ps(dst_buf[10] + i, y2);
+		_mm256_store_ps(dst_buf[11] + i, y3);
+		_mm256_store_ps(dst_buf[12] + i, y4);
+		_mm256_store_ps(dst_buf[13] + i, y5);
+		_mm256_store_ps(dst_buf[14] + i, y6);
+		_mm256_store_ps(dst_buf[15] + i, y7);
+	}
+	for (unsigned i = vec_height; i < height; ++i) {
+		for (unsigned k = 0; k < 16; ++k) {
+			dst_buf[k][i] = src_buf[i][left + k];
+		}
+	}
+}
+
+void transpose_from_tile_f32_avx2(const graph::ImageBuffer<const void> &src, const graph::ImageBuffer<void> &dst, unsigned left, unsigned height)
+{
+	const auto &src_buf = graph::static_buffer_cast<const float>(src);
+	const auto &dst_buf = graph::static_buffer_cast<float>(dst);
+	unsigned vec_height = floor_n(height, 8);
+
+	for (unsigned i = 0; i < vec_height; i += 8) {
+		__m256 x0, x1, x2, x3, x4, x5, x6, x7;
+		__m256 y0, y1, y2, y3, y4, y5, y6, y7;
+
+		x0 = _mm256_load_ps(src_buf[0] + i);
+		x1 = _mm256_load_ps(src_buf[1] + i);
+		x2 = _mm256_load_ps(src_buf[2] + i);
+		x3 = _mm256_load_ps(src_buf[3] + i);
+		x4 = _mm256_load_ps(src_buf[4] + i);
+		x5 = _mm256_load_ps(src_buf[5] + i);
+		x6 = _mm256_load_ps(src_buf[6] + i);
+		x7 = _mm256_load_ps(src_buf[7] + i);
+		y0 = _mm256_load_ps(src_buf[8] + i);
+		y1 = _mm256_load_ps(src_buf[9] + i);
+		y2 = _mm256_load_ps(src_buf[10] + i);
+		y3 = _mm256_load_ps(src_buf[11] + i);
+		y4 = _mm256_load_ps(src_buf[12] + i);
+		y5 = _mm256_load_ps(src_buf[13] + i);
+		y6 = _mm256_load_ps(src_buf[14] + i);
+		y7 = _mm256_load_ps(src_buf[15] + i);
+
+		mm256_transpose8_ps(x0, x1, x2, x3, x4, x5, x6, x7);
+		mm256_transpose8_ps(y0, y1, y2, y3, y4, y5, y6, y7);
+
+		_mm256_storeu_ps(dst_buf[i + 0] + left, x0);
+		_mm256_storeu_ps(dst_buf[i + 1] + left, x1);
+		_mm256_storeu_ps(dst_buf[i + 2] + left, x2);
+		_mm256_storeu_ps(dst_buf[i + 3] + left, x3);
+		_mm256_storeu_ps(dst_buf[i + 4] + left, x4);
+		_mm256_storeu_ps(dst_buf[i + 5] + left, x5);
+		_mm256_storeu_ps(dst_buf[i + 6] + left, x6);
+		_mm256_storeu_ps(dst_buf[i + 7] + left, x7);
+		_mm256_storeu_ps(dst_buf[i + 0] + left + 8, y0);
+		_mm256_storeu_ps(dst_buf[i + 1] + left + 8, y1);
+		_mm256_storeu_ps(dst_buf[i + 2] + left + 8, y2);
+		_mm256_storeu_ps(dst_buf[i + 3] + left + 8, y3);
+		_mm256_storeu_ps(dst_buf[i + 4] + left + 8, y4);
+		_mm256_storeu_ps(dst_buf[i + 5] + left + 8, y5);
+		_mm256_storeu_ps(dst_buf[i + 6] + left + 8, y6);
+		_mm256_storeu_ps(dst_buf[i + 7] + left + 8, y7);
+	}
+	for (unsigned i = vec_height; i < height; ++i) {
+		for (unsigned k = 0; k < 16; ++k) {
+			dst_buf[i][left + k] = src_buf[k][i];
+		}
+	}
+}
+
 } // namespace resize
 } // namespace zimg
 
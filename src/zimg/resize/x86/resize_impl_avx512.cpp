@@ -917,6 +917,110 @@ std::unique_ptr<graph::ImageFilter> create_resize_impl_v_avx512(const FilterCont
 	return ret;
 }
 
+void transpose_to_tile_f32_avx512(const graph::ImageBuffer<const void> &src, const graph::ImageBuffer<void> &dst, unsigned left, unsigned height)
+{
+	const auto &src_buf = graph::static_buffer_cast<const float>(src);
+	const auto &dst_buf = graph::static_buffer_cast<float>(dst);
+	unsigned vec_height = floor_n(height, 16);
+
+	for (unsigned i = 0; i < vec_height; i += 16) {
+		__m512 x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15;
+
+		x0 = _mm512_loadu_ps(src_buf[i + 0] + left);
+		x1 = _mm512_loadu_ps(src_buf[i + 1] + left);
+		x2 = _mm512_loadu_ps(src_buf[i + 2] + left);
+		x3 = _mm512_loadu_ps(src_buf[i + 3] + left);
+		x4 = _mm512_loadu_ps(src_buf[i + 4] + left);
+		x5 = _mm512_loadu_ps(src_buf[i + 5] + left);
+		x6 = _mm512_loadu_ps(src_buf[i + 6] + left);
+		x7 = _mm512_loadu_ps(src_buf[i + 7] + left);
+		x8 = _mm512_loadu_ps(src_buf[i + 8] + left);
+		x9 = _mm512_loadu_ps(src_buf[i + 9] + left);
+		x10 = _mm512_loadu_ps(src_buf[i + 10] + left);
+		x11 = _mm512_loadu_ps(src_buf[i + 11] + left);
+		x12 = _mm512_loadu_ps(src_buf[i + 12] + left);
+		x13 = _mm512_loadu_ps(src_buf[i + 13] + left);
+		x14 = _mm512_loadu_ps(src_buf[i + 14] + left);
+		x15 = _mm512_loadu_ps(src_buf[i + 15] + left);
+
+		mm512_transpose16_ps(x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15);
+
+		_mm512_store_ps(dst_buf[0] + i, x0);
+		_mm512_store_ps(dst_buf[1] + i, x1);
+		_mm512_store_ps(dst_buf[2] + i, x2);
+		_mm512_store_ps(dst_buf[3] + i, x3);
+		_mm512_store_ps(dst_buf[4] + i, x4);
+		_mm512_store_ps(dst_buf[5] + i, x5);
+		_mm512_store_ps(dst_buf[6] + i, x6);
+		_mm512_store_ps(dst_buf[7] + i, x7);
+		_mm512_store_ps(dst_buf[8] + i, x8);
+		_mm512_store_ps(dst_buf[9] + i, x9);
+		_mm512_store_ps(dst_buf[10] + i, x10);
+		_mm512_store_ps(dst_buf[11] + i, x11);
+		_mm512_store_ps(dst_buf[12] + i, x12);
+		_mm512_store_ps(dst_buf[13] + i, x13);
+		_mm512_store_ps(dst_buf[14] + i, x14);
+		_mm512_store_ps(dst_buf[15] + i, x15);
+	}
+	for (unsigned i = vec_height; i < height; ++i) {
+		for (unsigned k = 0; k < 16; ++k) {
+			dst_buf[k][i] = src_buf[i][left + k];
+		}
+	}
+}
+
+void transpose_from_tile_f32_avx512(const graph::ImageBuffer<const void> &src, const graph::ImageBuffer<void> &dst, unsigned left, unsigned height)
+{
+	const auto &src_buf = graph::static_buffer_cast<const float>(src);
+	const auto &dst_buf = graph::static_buffer_cast<float>(dst);
+	unsigned vec_height = floor_n(height, 16);
+
+	for (unsigned i = 0; i < vec_height; i += 16) {
+		__m512 x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15;
+
+		x0 = _mm512_load_ps(src_buf[0] + i);
+		x1 = _mm512_load_ps(src_buf[1] + i);
+		x2 = _mm512_load_ps(src_buf[2] + i);
+		x3 = _mm512_load_ps(src_buf[3] + i);
+		x4 = _mm512_load_ps(src_buf[4] + i);
+		x5 = _mm512_load_ps(src_buf[5] + i);
+		x6 = _mm512_load_ps(src_buf[6] + i);
+		x7 = _mm512_load_ps(src_buf[7] + i);
+		x8 = _mm512_load_ps(src_buf[8] + i);
+		x9 = _mm512_load_ps(src_buf[9] + i);
+		x10 = _mm512_load_ps(src_buf[10] + i);
+		x11 = _mm512_load_ps(src_buf[11] + i);
+		x12 = _mm512_load_ps(src_buf[12] + i);
+		x13 = _mm512_load_ps(src_buf[13] + i);
+		x14 = _mm512_load_ps(src_buf[14] + i);
+		x15 = _mm512_load_ps(src_buf[15] + i);
+
+		mm512_transpose16_ps(x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15);
+
+		_mm512_storeu_ps(dst_buf[i + 0] + left, x0);
+		_mm512_storeu_ps(dst_buf[i + 1] + left, x1);
+		_mm512_storeu_ps(dst_buf[i + 2] + left, x2);
+		_mm512_storeu_ps(dst_buf[i + 3] + left, x3);
+		_mm512_storeu_ps(dst_buf[i + 4] + left, x4);
+		_mm512_storeu_ps(dst_buf[i + 5] + left, x5);
+		_mm512_storeu_ps(dst_buf[i + 6] + left, x6);
+		_mm512_storeu_ps(dst_buf[i + 7] + left, x7);
+		_mm512_storeu_ps(dst_buf[i + 8] + left, x8);
+		_mm512_storeu_ps(dst_buf[i + 9] + left, x9);
+		_mm512_storeu_ps(dst_buf[i + 10] + left, x10);
+		_mm512_storeu_ps(dst_buf[i + 11] + left, x11);
+		_mm512_storeu_ps(dst_buf[i + 12] + left, x12);
+		_mm512_storeu_ps(dst_buf[i + 13] + left, x13);
+		_mm512_storeu_ps(dst_buf[i + 14] + left, x14);
+		_mm512_storeu_ps(dst_buf[i + 15] + left, x15);
+	}
+	for (unsigned i = vec_height; i < height; ++i) {
+		for (unsigned k = 0; k < 16; ++k) {
+			dst_buf[i][left + k] = src_buf[k][i];
+		}
+	}
+}
+
 } // namespace resize
 } // namespace zimg
 
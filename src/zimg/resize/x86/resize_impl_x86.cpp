@@ -1,6 +1,7 @@
 #ifdef ZIMG_X86
 
 #include "common/cpuinfo.h"
+#include "common/pixel.h"
 #include "common/x86/cpuinfo_x86.h"
 #include "graph/image_filter.h"
 #include "resize_impl_x86.h"
@@ -92,6 +93,106 @@ std::unique_ptr<graph::ImageFilter> create_resize_impl_v_x86(const FilterContext
 	return ret;
 }
 
+// Kernels for both chroma planes are only implemented for AVX2. Where an
+// AVX-512 greyscale kernel would be selected, the planes are resized separately.
+std::unique_ptr<graph::ImageFilter> create_resize_impl_h_uv_x86(const FilterContext &context, unsigned height, PixelType type, unsigned depth, CPUClass cpu)
+{
+	X86Capabilities caps = query_x86_capabilities();
+	std::unique_ptr<graph::ImageFilter> ret;
+
+	if (cpu_is_autodetect(cpu)) {
+#ifdef ZIMG_X86_AVX512
+		if (cpu == CPUClass::AUTO_64B && cpu_has_avx512_f_dq_bw_vl(caps))
+			return nullptr;
+#endif
+		if (!ret && caps.avx2)
+			ret = create_resize_impl_h_uv_avx2(context, height, type, depth);
+	} else {
+#ifdef ZIMG_X86_AVX512
+		if (cpu >= CPUClass::X86_AVX512)
+			return nullptr;
+#endif
+		if (!ret && cpu >= CPUClass::X86_AVX2)
+			ret = create_resize_impl_h_uv_avx2(context, height, type, depth);
+	}
+
+	return ret;
+}
+
+std::unique_ptr<graph::ImageFilter> create_resize_impl_v_uv_x86(const FilterContext &context, unsigned width, PixelType type, unsigned depth, CPUClass cpu)
+{
+	X86Capabilities caps = query_x86_capabilities();
+	std::unique_ptr<graph::ImageFilter> ret;
+
+	if (cpu_is_autodetect(cpu)) {
+#ifdef ZIMG_X86_AVX512
+		if (cpu == CPUClass::AUTO_64B && cpu_has_avx512_f_dq_bw_vl(caps))
+			return nullptr;
+#endif
+		if (!ret && caps.avx2)
+			ret = create_resize_impl_v_uv_avx2(context, width, type, depth);
+	} else {
+#ifdef ZIMG_X86_AVX512
+		if (cpu >= CPUClass::X86_AVX512)
+			return nullptr;
+#endif
+		if (!ret && cpu >= CPUClass::X86_AVX2)
+			ret = create_resize_impl_v_uv_avx2(context, width, type, depth);
+	}
+
+	return ret;
+}
+
+// A 16x16 block of WORD samples fits in 256-bit registers, so the AVX2
+// transpose is also used on AVX-512 processors.
+transpose_tile_func select_transpose_to_tile_func_x86(PixelType type, CPUClass cpu)
+{
+	X86Capabilities caps = query_x86_capabilities();
+	transpose_tile_func func = nullptr;
+
+	if (cpu_is_autodetect(cpu)) {
+#ifdef ZIMG_X86_AVX512
+		if (!func && cpu == CPUClass::AUTO_64B && cpu_has_avx512_f_dq_bw_vl(caps) && type == PixelType::FLOAT)
+			func = transpose_to_tile_f32_avx512;
+#endif
+		if (!func && caps.avx2)
+			func = type == PixelType::WORD ? transpose_to_tile_u16_avx2 : type == PixelType::FLOAT ? transpose_to_tile_f32_avx2 : nullptr;
+	} else {
+#ifdef ZIMG_X86_AVX512
+		if (!func && cpu >= CPUClass::X86_AVX512 && type == PixelType::FLOAT)
+			func = transpose_to_tile_f32_avx512;
+#endif
+		if (!func && cpu >= CPUClass::X86_AVX2)
+			func = type == PixelType::WORD ? transpose_to_tile_u16_avx2 : type == PixelType::FLOAT ? transpose_to_tile_f32_avx2 : nullptr;
+	}
+
+	return func;
+}
+
+transpose_tile_func select_transpose_from_tile_func_x86(PixelType type, CPUClass cpu)
+{
+	X86Capabilities caps = query_x86_capabilities();
+	transpose_tile_func func = nullptr;
+
+	if (cpu_is_autodetect(cpu)) {
+#ifdef ZIMG_X86_AVX512
+		if (!func && cpu == CPUClass::AUTO_64B && cpu_has_avx512_f_dq_bw_vl(caps) && type == PixelType::FLOAT)
+			func = transpose_from_tile_f32_avx512;
+#endif
+		if (!func && caps.avx2)
+			func = type == PixelType::WORD ? transpose_from_tile_u16_avx2 : type == PixelType::FLOAT ? transpose_from_tile_f32_avx2 : nullptr;
+	} else {
+#ifdef ZIMG_X86_AVX512
+		if (!func && cpu >= CPUClass::X86_AVX512 && type == PixelType::FLOAT)
+			func = transpose_from_tile_f32_avx512;
+#endif
+		if (!func && cpu >= CPUClass::X86_AVX2)
+			func = type == PixelType::WORD ? transpose_from_tile_u16_avx2 : type == PixelType::FLOAT ? transpose_from_tile_f32_avx2 : nullptr;
+	}
+
+	return func;
+}
+
 } // namespace resize
 } // namespace zimg
 
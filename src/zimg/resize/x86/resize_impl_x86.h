@@ -6,6 +6,7 @@
 #define ZIMG_RESIZE_X86_RESIZE_IMPL_X86_H_
 
 #include <memory>
+#include "resize/resize_impl.h"
 
 namespace zimg {
 
@@ -42,13 +43,36 @@ DECLARE_IMPL_V(avx2);
 DECLARE_IMPL_V(avx512);
 DECLARE_IMPL_V(avx512_vnni);
 
+std::unique_ptr<graph::ImageFilter> create_resize_impl_h_uv_avx2(const FilterContext &context, unsigned height, PixelType type, unsigned depth);
+std::unique_ptr<graph::ImageFilter> create_resize_impl_v_uv_avx2(const FilterContext &context, unsigned width, PixelType type, unsigned depth);
+
+#define DECLARE_TRANSPOSE_TILE(x, cpu) \
+void x##_##cpu(const graph::ImageBuffer<const void> &src, const graph::ImageBuffer<void> &dst, unsigned left, unsigned height)
+
+DECLARE_TRANSPOSE_TILE(transpose_to_tile_u16, avx2);
+DECLARE_TRANSPOSE_TILE(transpose_to_tile_f32, avx2);
+DECLARE_TRANSPOSE_TILE(transpose_to_tile_f32, avx512);
+
+DECLARE_TRANSPOSE_TILE(transpose_from_tile_u16, avx2);
+DECLARE_TRANSPOSE_TILE(transpose_from_tile_f32, avx2);
+DECLARE_TRANSPOSE_TILE(transpose_from_tile_f32, avx512);
+
 #undef DECLARE_IMPL_H
 #undef DECLARE_IMPL_V
+#undef DECLARE_TRANSPOSE_TILE
 
 std::unique_ptr<graph::ImageFilter> create_resize_impl_h_x86(const FilterContext &context, unsigned height, PixelType type, unsigned depth, CPUClass cpu);
 
 std::unique_ptr<graph::ImageFilter> create_resize_impl_v_x86(const FilterContext &context, unsigned width, PixelType type, unsigned depth, CPUClass cpu);
 
+std::unique_ptr<graph::ImageFilter> create_resize_impl_h_uv_x86(const FilterContext &context, unsigned height, PixelType type, unsigned depth, CPUClass cpu);
+
+std::unique_ptr<graph::ImageFilter> create_resize_impl_v_uv_x86(const FilterContext &context, unsigned width, PixelType type, unsigned depth, CPUClass cpu);
+
+transpose_tile_func select_transpose_to_tile_func_x86(PixelType type, CPUClass cpu);
+
+transpose_tile_func select_transpose_from_tile_func_x86(PixelType type, CPUClass cpu);
+
 } // namespace resize
 } // namespace zimg
 
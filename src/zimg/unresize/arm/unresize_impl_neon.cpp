@@ -0,0 +1,364 @@
+#ifdef ZIMG_ARM
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <arm_neon.h>
+#include "common/align.h"
+#include "common/ccdep.h"
+#include "common/checked_int.h"
+#include "common/except.h"
+#include "common/make_unique.h"
+#include "common/pixel.h"
+#include "graph/image_buffer.h"
+#include "unresize/unresize_impl.h"
+#include "unresize_impl_arm.h"
+
+#include "common/arm/neon_util.h"
+
+#if defined(_M_ARM) || defined(__arm__)
+  #define vcvtnq_u32_f32_(x) vcvtq_u32_f32(vaddq_f32(x, vdupq_n_f32(0.49999997f)))
+#else
+  #define vcvtnq_u32_f32_ vcvtnq_u32_f32
+#endif
+
+namespace zimg {
+namespace unresize {
+
+namespace {
+
+inline FORCE_INLINE float32x4_t load_f32(const float *src)
+{
+	return vld1q_f32(src);
+}
+
+inline FORCE_INLINE float32x4_t load_f32(const uint16_t *src)
+{
+	return vcvtq_f32_u32(vmovl_u16(vld1_u16(src)));
+}
+
+inline FORCE_INLINE uint16x4_t cvt_f32_u16(float32x4_t x, uint16x4_t pixel_max)
+{
+	return vmin_u16(vqmovn_u32(vcvtnq_u32_f32_(x)), pixel_max);
+}
+
+inline FORCE_INLINE void store_idxlo_u16(uint16_t *dst, uint16x4_t x, unsigned idx)
+{
+	uint16_t tmp[4];
+	vst1_u16(tmp, x);
+	std::copy_n(tmp, idx, dst);
+}
+
+// Transposes 4 rows into columns of 4 floats.
+template <class T>
+void transpose_line_4x4_f32(float * RESTRICT dst, const T * const * RESTRICT src, unsigned width)
+{
+	for (unsigned j = 0; j < width; j += 4) {
+		float32x4_t x0 = load_f32(src[0] + j);
+		float32x4_t x1 = load_f32(src[1] + j);
+		float32x4_t x2 = load_f32(src[2] + j);
+		float32x4_t x3 = load_f32(src[3] + j);
+
+		neon_transpose4_f32(x0, x1, x2, x3);
+
+		vst1q_f32(dst + 0, x0);
+		vst1q_f32(dst + 4, x1);
+		vst1q_f32(dst + 8, x2);
+		vst1q_f32(dst + 12, x3);
+
+		dst += 16;
+	}
+}
+
+// Transposes columns of 4 floats back into 4 rows.
+void untranspose_line_4x4_f32(float * const * RESTRICT dst, const float * RESTRICT src, unsigned width)
+{
+	unsigned vec_right = floor_n(width, 4);
+
+	for (unsigned j = 0; j < ceil_n(width, 4); j += 4) {
+		float32x4_t x0 = vld1q_f32(src + 0);
+		float32x4_t x1 = vld1q_f32(src + 4);
+		float32x4_t x2 = vld1q_f32(src + 8);
+		float32x4_t x3 = vld1q_f32(src + 12);
+
+		neon_transpose4_f32(x0, x1, x2, x3);
+
+		if (j < vec_right) {
+			vst1q_f32(dst[0] + j, x0);
+			vst1q_f32(dst[1] + j, x1);
+			vst1q_f32(dst[2] + j, x2);
+			vst1q_f32(dst[3] + j, x3);
+		} else {
+			neon_store_idxlo_f32(dst[0] + j, x0, width % 4);
+			neon_store_idxlo_f32(dst[1] + j, x1, width % 4);
+			neon_store_idxlo_f32(dst[2] + j, x2, width % 4);
+			neon_store_idxlo_f32(dst[3] + j, x3, width % 4);
+		}
+
+		src += 16;
+	}
+}
+
+// Transposes columns of 4 floats back into 4 rows of WORD samples.
+void untranspose_line_4x4_f32_u16(uint16_t * const * RESTRICT dst, const float * RESTRICT src, unsigned width, uint16_t pixel_max)
+{
+	const uint16x4_t max = vdup_n_u16(pixel_max);
+	unsigned vec_right = floor_n(width, 4);
+
+	for (unsigned j = 0; j < ceil_n(width, 4); j += 4) {
+		float32x4_t x[4];
+
+		for (unsigned n = 0; n < 4; ++n) {
+			x[n] = vld1q_f32(src + n * 4);
+		}
+
+		neon_transpose4_f32(x[0], x[1], x[2], x[3]);
+
+		for (unsigned n = 0; n < 4; ++n) {
+			uint16x4_t y = cvt_f32_u16(x[n], max);
+
+			if (j < vec_right)
+				vst1_u16(dst[n] + j, y);
+			else
+				store_idxlo_u16(dst[n] + j, y, width % 4);
+		}
+
+		src += 16;
+	}
+}
+
+void store_line_u16_neon(const float *src, uint16_t *dst, unsigned width, uint16_t pixel_max)
+{
+	const uint16x4_t max = vdup_n_u16(pixel_max);
+	unsigned vec_right = floor_n(width, 4);
+
+	for (unsigned j = 0; j < vec_right; j += 4) {
+		vst1_u16(dst + j, cvt_f32_u16(vld1q_f32(src + j), max));
+	}
+	if (width != vec_right)
+		store_idxlo_u16(dst + vec_right, cvt_f32_u16(vld1q_f32(src + vec_right), max), width % 4);
+}
+
+// Solves the system for 4 transposed rows, one row per vector lane.
+void unresize_line4_h_f32_neon(const BilinearContext &ctx, const float * RESTRICT src, float * RESTRICT dst)
+{
+	const float *c = ctx.lu_c.data();
+	const float *l = ctx.lu_l.data();
+	const float *u = ctx.lu_u.data();
+	unsigned bw = ctx.lu_bandwidth;
+
+	for (unsigned j = 0; j < ctx.output_width; ++j) {
+		const float *coeffs = &ctx.matrix_coefficients[j * ctx.matrix_row_stride];
+		const float *src_p = src + static_cast<size_t>(ctx.matrix_row_offsets[j]) * 4;
+		float32x4_t accum = vdupq_n_f32(0.0f);
+
+		for (unsigned k = 0; k < ctx.matrix_row_size; ++k) {
+			accum = vfmaq_f32(accum, vdupq_n_f32(coeffs[k]), vld1q_f32(src_p + k * 4));
+		}
+		for (unsigned k = 1; k <= std::min(j, bw); ++k) {
+			accum = vfmsq_f32(accum, vdupq_n_f32(c[j * bw + k - 1]), vld1q_f32(dst + (j - k) * 4));
+		}
+
+		vst1q_f32(dst + j * 4, vmulq_n_f32(accum, l[j]));
+	}
+
+	for (unsigned j = ctx.output_width; j != 0; --j) {
+		float32x4_t w = vld1q_f32(dst + (j - 1) * 4);
+
+		for (unsigned k = 1; k <= std::min(ctx.output_width - j, bw); ++k) {
+			w = vfmsq_f32(w, vdupq_n_f32(u[(j - 1) * bw + k - 1]), vld1q_f32(dst + (j - 1 + k) * 4));
+		}
+
+		vst1q_f32(dst + (j - 1) * 4, w);
+	}
+}
+
+template <class T>
+void unresize_line_forward_v_neon(const BilinearContext &ctx, const graph::ImageBuffer<const T> &src, const graph::ImageBuffer<float> &dst, unsigned i, unsigned width)
+{
+	const float *coeffs = &ctx.matrix_coefficients[i * ctx.matrix_row_stride];
+	unsigned top = ctx.matrix_row_offsets[i];
+
+	const float *c = ctx.lu_c.data() + static_cast<size_t>(i) * ctx.lu_bandwidth;
+	const float l = ctx.lu_l[i];
+	unsigned bw = std::min(i, ctx.lu_bandwidth);
+	unsigned vec_right = floor_n(width, 4);
+
+	for (unsigned j = 0; j < ceil_n(width, 4); j += 4) {
+		float32x4_t accum = vdupq_n_f32(0.0f);
+
+		for (unsigned k = 0; k < ctx.matrix_row_size; ++k) {
+			accum = vfmaq_f32(accum, vdupq_n_f32(coeffs[k]), load_f32(src[top + k] + j));
+		}
+		for (unsigned k = 1; k <= bw; ++k) {
+			accum = vfmsq_f32(accum, vdupq_n_f32(c[k - 1]), vld1q_f32(dst[i - k] + j));
+		}
+
+		float32x4_t z = vmulq_n_f32(accum, l);
+
+		if (j < vec_right)
+			vst1q_f32(dst[i] + j, z);
+		else
+			neon_store_idxlo_f32(dst[i] + j, z, width % 4);
+	}
+}
+
+void unresize_line_back_v_f32_neon(const BilinearContext &ctx, const graph::ImageBuffer<float> &dst, unsigned i, unsigned width)
+{
+	const float *u = ctx.lu_u.data() + static_cast<size_t>(i - 1) * ctx.lu_bandwidth;
+	unsigned bw = std::min(ctx.output_width - i, ctx.lu_bandwidth);
+	unsigned vec_right = floor_n(width, 4);
+
+	for (unsigned j = 0; j < ceil_n(width, 4); j += 4) {
+		float32x4_t w = vld1q_f32(dst[i - 1] + j);
+
+		for (unsigned k = 1; k <= bw; ++k) {
+			w = vfmsq_f32(w, vdupq_n_f32(u[k - 1]), vld1q_f32(dst[i - 1 + k] + j));
+		}
+
+		if (j < vec_right)
+			vst1q_f32(dst[i - 1] + j, w);
+		else
+			neon_store_idxlo_f32(dst[i - 1] + j, w, width % 4);
+	}
+}
+
+
+class UnresizeImplH_Neon final : public UnresizeImplH {
+	uint16_t m_pixel_max;
+
+	template <class T>
+	const float *transpose_and_solve(const graph::ImageBuffer<const T> &src, void *tmp, unsigned i) const
+	{
+		const T *src_ptr[4] = { 0 };
+		float *transpose_in = static_cast<float *>(tmp);
+		float *transpose_out = transpose_in + ceil_n(m_context.input_width, 4) * 4;
+		unsigned height = get_image_attributes().height;
+
+		for (unsigned n = 0; n < 4; ++n) {
+			src_ptr[n] = src[std::min(i + n, height - 1)];
+		}
+
+		transpose_line_4x4_f32(transpose_in, src_ptr, m_context.input_width);
+		unresize_line4_h_f32_neon(m_context, transpose_in, transpose_out);
+		return transpose_out;
+	}
+public:
+	UnresizeImplH_Neon(const BilinearContext &context, unsigned height, PixelType type, unsigned depth) :
+		UnresizeImplH(context, image_attributes{ context.output_width, height, type }),
+		m_pixel_max{ static_cast<uint16_t>(type == PixelType::WORD ? (1UL << depth) - 1 : 0) }
+	{}
+
+	unsigned get_simultaneous_lines() const override { return 4; }
+
+	size_t get_tmp_size(unsigned, unsigned) const override
+	{
+		try {
+			checked_size_t size = static_cast<checked_size_t>(ceil_n(m_context.input_width, 4)) * 4;
+			size += static_cast<checked_size_t>(ceil_n(m_context.output_width, 4)) * 4;
+			size *= sizeof(float);
+			return size.get();
+		} catch (const std::overflow_error &) {
+			error::throw_<error::OutOfMemory>();
+		}
+	}
+
+	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *tmp, unsigned i, unsigned, unsigned) const override
+	{
+		unsigned height = get_image_attributes().height;
+
+		if (get_image_attributes().type == PixelType::WORD) {
+			const auto &dst_buf = graph::static_buffer_cast<uint16_t>(*dst);
+			const float *result = transpose_and_solve(graph::static_buffer_cast<const uint16_t>(*src), tmp, i);
+			uint16_t *dst_ptr[4] = { 0 };
+
+			for (unsigned n = 0; n < 4; ++n) {
+				dst_ptr[n] = dst_buf[std::min(i + n, height - 1)];
+			}
+
+			untranspose_line_4x4_f32_u16(dst_ptr, result, m_context.output_width, m_pixel_max);
+		} else {
+			const auto &dst_buf = graph::static_buffer_cast<float>(*dst);
+			const float *result = transpose_and_solve(graph::static_buffer_cast<const float>(*src), tmp, i);
+			float *dst_ptr[4] = { 0 };
+
+			for (unsigned n = 0; n < 4; ++n) {
+				dst_ptr[n] = dst_buf[std::min(i + n, height - 1)];
+			}
+
+			untranspose_line_4x4_f32(dst_ptr, result, m_context.output_width);
+		}
+	}
+};
+
+class UnresizeImplV_Neon final : public UnresizeImplV {
+	uint16_t m_pixel_max;
+public:
+	UnresizeImplV_Neon(const BilinearContext &context, unsigned width, PixelType type, unsigned depth) :
+		UnresizeImplV(context, image_attributes{ width, context.output_width, type }),
+		m_pixel_max{ static_cast<uint16_t>(type == PixelType::WORD ? (1UL << depth) - 1 : 0) }
+	{}
+
+	size_t get_tmp_size(unsigned, unsigned) const override
+	{
+		return get_image_attributes().type == PixelType::WORD ? get_tmp_plane_size() : 0;
+	}
+
+	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *tmp, unsigned, unsigned, unsigned) const override
+	{
+		unsigned width = get_image_attributes().width;
+		unsigned height = get_image_attributes().height;
+
+		if (get_image_attributes().type == PixelType::WORD) {
+			const auto &src_buf = graph::static_buffer_cast<const uint16_t>(*src);
+			const auto &dst_buf = graph::static_buffer_cast<uint16_t>(*dst);
+			graph::ImageBuffer<float> tmp_buf = get_tmp_plane(tmp);
+
+			for (unsigned i = 0; i < height; ++i) {
+				unresize_line_forward_v_neon(m_context, src_buf, tmp_buf, i, width);
+			}
+			for (unsigned i = height; i != 0; --i) {
+				unresize_line_back_v_f32_neon(m_context, tmp_buf, i, width);
+				store_line_u16_neon(tmp_buf[i - 1], dst_buf[i - 1], width, m_pixel_max);
+			}
+		} else {
+			const auto &src_buf = graph::static_buffer_cast<const float>(*src);
+			const auto &dst_buf = graph::static_buffer_cast<float>(*dst);
+
+			for (unsigned i = 0; i < height; ++i) {
+				unresize_line_forward_v_neon(m_context, src_buf, dst_buf, i, width);
+			}
+			for (unsigned i = height; i != 0; --i) {
+				unresize_line_back_v_f32_neon(m_context, dst_buf, i, width);
+			}
+		}
+	}
+};
+
+} // namespace
+
+
+std::unique_ptr<graph::ImageFilter> create_unresize_impl_h_neon(const BilinearContext &context, unsigned height, PixelType type, unsigned depth)
+{
+	std::unique_ptr<graph::ImageFilter> ret;
+
+	if (type == PixelType::WORD || type == PixelType::FLOAT)
+		ret = ztd::make_unique<UnresizeImplH_Neon>(context, height, type, depth);
+
+	return ret;
+}
+
+std::unique_ptr<graph::ImageFilter> create_unresize_impl_v_neon(const BilinearContext &context, unsigned width, PixelType type, unsigned depth)
+{
+	std::unique_ptr<graph::ImageFilter> ret;
+
+	if (type == PixelType::WORD || type == PixelType::FLOAT)
+		ret = ztd::make_unique<UnresizeImplV_Neon>(context, width, type, depth);
+
+	return ret;
+}
+
+} // namespace unresize
+} // namespace zimg
+
+#endif // ZIMG_ARM
@@ -6,6 +6,7 @@
 #include "common/except.h"
 #include "common/matrix.h"
 #include "common/zassert.h"
+#include "resize/filter.h"
 #include "bilinear.h"
 
 namespace zimg {
@@ -20,36 +21,65 @@ T epsilon()
 }
 
 template <class T>
-struct TridiagonalLU {
+struct BandedLU {
 	std::vector<T> l;
 	std::vector<T> u;
 	std::vector<T> c;
+	size_t bandwidth;
 
-	explicit TridiagonalLU(size_t n) : l(n), u(n), c(n)
+	BandedLU(size_t n, size_t bandwidth) : l(n), u(n * bandwidth), c(n * bandwidth), bandwidth{ bandwidth }
 	{}
+
+	T &lower(size_t i, size_t j) { return i == j ? l[i] : c[i * bandwidth + (i - j) - 1]; }
+	T &upper(size_t i, size_t j) { return u[i * bandwidth + (j - i) - 1]; }
 };
 
+size_t matrix_bandwidth(const RowMatrix<double> &m)
+{
+	size_t bandwidth = 0;
+
+	for (size_t i = 0; i < m.rows(); ++i) {
+		if (m.row_right(i) <= m.row_left(i))
+			continue;
+
+		bandwidth = std::max(bandwidth, i - std::min(m.row_left(i), i));
+		bandwidth = std::max(bandwidth, std::max(m.row_right(i) - 1, i) - i);
+	}
+
+	return bandwidth;
+}
+
+// Crout factorization of a banded matrix, with U having a unit diagonal.
+// No pivoting is required, as (A' A) is symmetric positive definite.
 template <class T>
-TridiagonalLU<T> tridiagonal_decompose(const RowMatrix<T> &m)
+BandedLU<T> banded_decompose(const RowMatrix<T> &m, size_t bandwidth)
 {
 	size_t n = m.rows();
-	TridiagonalLU<T> lu{ n };
-	T zero = static_cast<T>(0);
+	BandedLU<T> lu{ n, bandwidth };
 	T eps = epsilon<T>();
 
-	lu.c[0] = zero;
-	lu.l[0] = m[0][0];
-	lu.u[0] = m[0][1] / (m[0][0] + eps);
+	for (size_t i = 0; i < n; ++i) {
+		size_t first = i - std::min(i, bandwidth);
+		size_t last = std::min(i + bandwidth, n - 1);
 
-	for (size_t i = 1; i < n - 1; ++i) {
-		lu.c[i] = m[i][i - 1];
-		lu.l[i] = m[i][i] - lu.c[i] * lu.u[i - 1];
-		lu.u[i] = m[i][i + 1] / (lu.l[i] + eps);
-	}
+		for (size_t j = first; j <= i; ++j) {
+			T accum = m[i][j];
 
-	lu.c[n - 1] = m[n - 1][n - 2];
-	lu.l[n - 1] = m[n - 1][n - 1] - lu.c[n - 1] * lu.u[n - 2];
-	lu.u[n - 1] = zero;
+			for (size_t k = first; k < j; ++k) {
+				accum -= lu.lower(i, k) * lu.upper(k, j);
+			}
+			lu.lower(i, j) = accum;
+		}
+
+		for (size_t j = i + 1; j <= last; ++j) {
+			T accum = m[i][j];
+
+			for (size_t k = std::max(first, j - std::min(j, bandwidth)); k < i; ++k) {
+				accum -= lu.lower(i, k) * lu.upper(k, j);
+			}
+			lu.upper(i, j) = accum / (lu.l[i] + eps);
+		}
+	}
 
 	return lu;
 }
@@ -102,10 +132,41 @@ RowMatrix<double> bilinear_weights(unsigned in, unsigned out, double shift)
 	return m;
 }
 
+/**
+ * Compute the coefficients for an arbitrary scaling matrix.
+ *
+ * @param filter resampling filter
+ * @param in input (unscaled) dimension
+ * @param out output (scaled) dimension
+ * @param shift shift applied to output in units of input pixels
+ * @return the scaling matrix
+ */
+RowMatrix<double> filter_weights(const resize::Filter &filter, unsigned in, unsigned out, double shift)
+{
+	resize::FilterContext filter_ctx = resize::compute_filter(filter, in, out, shift, in);
+	RowMatrix<double> m{ out, in };
+
+	for (unsigned i = 0; i < filter_ctx.filter_rows; ++i) {
+		for (unsigned k = 0; k < filter_ctx.filter_width; ++k) {
+			float coeff = filter_ctx.data[static_cast<size_t>(i) * filter_ctx.stride + k];
+
+			if (coeff)
+				m[i][filter_ctx.left[i] + k] = coeff;
+		}
+	}
+
+	return m;
+}
+
 } // namespace
 
 
 BilinearContext create_bilinear_context(unsigned in, unsigned out, double shift)
+{
+	return create_unresize_context(in, out, shift, nullptr);
+}
+
+BilinearContext create_unresize_context(unsigned in, unsigned out, double shift, const resize::Filter *filter)
 {
 	BilinearContext ctx;
 
@@ -114,10 +175,11 @@ BilinearContext create_bilinear_context(unsigned in, unsigned out, double shift)
 
 	try {
 		// Map output shift to input shift.
-		RowMatrix<double> m = bilinear_weights(in, out, -shift * in / out);
+		RowMatrix<double> m = filter ? filter_weights(*filter, in, out, shift * in / out) : bilinear_weights(in, out, -shift * in / out);
 		RowMatrix<double> transpose_m = ~m;
 		RowMatrix<double> pinv_m = transpose_m * m;
-		TridiagonalLU<double> lu = tridiagonal_decompose(pinv_m);
+		size_t bandwidth = matrix_bandwidth(pinv_m);
+		BandedLU<double> lu = banded_decompose(pinv_m, bandwidth);
 
 		size_t rows = transpose_m.rows();
 		size_t cols = transpose_m.cols();
@@ -151,14 +213,15 @@ BilinearContext create_bilinear_context(unsigned in, unsigned out, double shift)
 			ctx.matrix_row_offsets[i] = static_cast<unsigned>(left);
 		}
 
-		ctx.lu_c.resize(rows);
+		ctx.lu_bandwidth = static_cast<unsigned>(bandwidth);
+		ctx.lu_c.resize(lu.c.size());
 		ctx.lu_l.resize(rows);
-		ctx.lu_u.resize(rows);
+		ctx.lu_u.resize(lu.u.size());
 		for (size_t i = 0; i < rows; ++i) {
-			ctx.lu_c[i] = static_cast<float>(lu.c[i]);
 			ctx.lu_l[i] = static_cast<float>((1.0 / (lu.l[i] + epsilon<float>()))); // Pre-invert this value, as it is used in division.
-			ctx.lu_u[i] = static_cast<float>(lu.u[i]);
 		}
+		std::transform(lu.c.begin(), lu.c.end(), ctx.lu_c.begin(), [](double x) { return static_cast<float>(x); });
+		std::transform(lu.u.begin(), lu.u.end(), ctx.lu_u.begin(), [](double x) { return static_cast<float>(x); });
 	} catch (const std::length_error &) {
 		error::throw_<error::OutOfMemory>();
 	}
@@ -6,6 +6,14 @@
 #include "common/alloc.h"
 
 namespace zimg {
+
+namespace resize {
+
+class Filter;
+
+} // namespace resize
+
+
 namespace unresize {
 
 /**
@@ -46,15 +54,27 @@ struct BilinearContext {
 	unsigned matrix_row_stride;
 
 	/**
-	 * LU decomposition of (A' A) stored as three arrays of dimension (N).
+	 * Number of non-zero diagonals above and below the main diagonal of
+	 * (A' A), denoted (B). The bilinear filter yields a tridiagonal system
+	 * with (B) equal to 1. Wider filters yield wider bands.
+	 */
+	unsigned lu_bandwidth;
+
+	/**
+	 * LU decomposition of (A' A). The diagonal of L is stored as an array of
+	 * dimension (N). The off-diagonal bands are stored as arrays of dimension
+	 * (N * B), grouped by row.
 	 *
 	 * The relationship to L and U is given by the following.
 	 *
-	 * lu_c(i) = L(i, i - 1)
+	 * lu_c(i, k) = L(i, i - k)
 	 * lu_l(i) = 1 / L(i, i)
-	 * lu_u(i) = U(i, i + 1)
+	 * lu_u(i, k) = U(i, i + k)
+	 *
+	 * lu_c(i, k) = lu_c[(i - 1) * B + (k - 1)]
+	 * lu_u(i, k) = lu_u[(i - 1) * B + (k - 1)]
 	 *
-	 * lu_c(1) and lu_u(N) are set to 0 to simplify the execution loop.
+	 * Elements outside of the matrix are set to 0.
 	 * lu_l is stored inverted as it is used in forward substitution as a divisor.
 	 */
 	AlignedVector<float> lu_c;
@@ -72,6 +92,18 @@ struct BilinearContext {
  */
 BilinearContext create_bilinear_context(unsigned in, unsigned out, double shift);
 
+/**
+ * Initialize a BilinearContext to invert an arbitrary resampling filter.
+ *
+ * @param in dimension of original vector
+ * @param out dimension of upscaled vector
+ * @param shift center shift relative to upscaled vector
+ * @param filter filter used to upscale the original vector, or nullptr for
+ *               the legacy bilinear algorithm
+ * @return an initialized context
+ */
+BilinearContext create_unresize_context(unsigned in, unsigned out, double shift, const resize::Filter *filter);
+
 } // namespace unresize
 } // namespace zimg
 
@@ -29,8 +29,10 @@ UnresizeConversion::UnresizeConversion(unsigned up_width, unsigned up_height, Pi
 	type{ type },
 	orig_width{ up_width },
 	orig_height{ up_height },
+	depth{ pixel_depth(type) },
 	shift_w{},
 	shift_h{},
+	filter{},
 	cpu{ CPUClass::NONE }
 {}
 
@@ -45,7 +47,7 @@ auto UnresizeConversion::create() const -> filter_pair try
 	if (skip_h && skip_v)
 		return{ ztd::make_unique<graph::CopyFilter>(up_width, up_height, type), nullptr };
 
-	auto builder = UnresizeImplBuilder{ up_width, up_height, type }.set_cpu(cpu);
+	auto builder = UnresizeImplBuilder{ up_width, up_height, type }.set_depth(depth).set_filter(filter).set_cpu(cpu);
 	filter_pair ret{};
 
 	if (skip_h) {
@@ -4,7 +4,7 @@
 #define ZIMG_UNRESIZE_UNRESIZE_H_
 
 /**
- * Unresize: reverses the effect of the bilinear scaling method.
+ * Unresize: reverses the effect of a resampling filter, by default bilinear.
  *
  * Linear interpolation in one dimension from an input dimension N to an
  * output dimension M can be represented as the matrix product:
@@ -73,9 +73,21 @@
  *   x(i) = z(i) - u(i) * x'(i + 1)
  *
  *
+ * Other resampling filters are handled in the same manner. A filter of
+ * support S yields a banded matrix P with a half-bandwidth B of at most
+ * (2 * S - 1), e.g. heptadiagonal for bicubic filters. The
+ * factorization generalizes by summing over the band.
+ *
+ * L(i, j) = P(i, j) - SUM(k = i - B : j - 1) L(i, k) * U(k, j)
+ * U(i, j) = (P(i, j) - SUM(k = j - B : i - 1) L(i, k) * U(k, j)) / L(i, i)
+ *
+ * z(i) = (y'(i) - SUM(k = 1 : B) L(i, i - k) * z(i - k)) / l(i)
+ * x(i) = z(i) - SUM(k = 1 : B) U(i, i + k) * x(i + k)
+ *
+ *
  * The implementation of Unresize caches the values of P, l, u, and c for given
  * dimensions N and M. Execution is done by first computing y' and then
- * performing the tridiagonal algorithm to obtain x.
+ * performing the banded substitution to obtain x.
  *
  * Generalization to two dimensions is done by processing each dimension.
  */
@@ -95,6 +107,13 @@ class ImageFilter;
 } // namespace graph
 
 
+namespace resize {
+
+class Filter;
+
+} // namespace resize
+
+
 namespace unresize {
 
 struct UnresizeConversion {
@@ -107,8 +126,10 @@ struct UnresizeConversion {
 #include "common/builder.h"
 	BUILDER_MEMBER(unsigned, orig_width)
 	BUILDER_MEMBER(unsigned, orig_height)
+	BUILDER_MEMBER(unsigned, depth)
 	BUILDER_MEMBER(double, shift_w)
 	BUILDER_MEMBER(double, shift_h)
+	BUILDER_MEMBER(const resize::Filter *, filter)
 	BUILDER_MEMBER(CPUClass, cpu)
 #undef BUILDER_MEMBER
 
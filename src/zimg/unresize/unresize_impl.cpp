@@ -1,5 +1,10 @@
 #include <algorithm>
 #include <climits>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include "common/align.h"
+#include "common/checked_int.h"
 #include "common/cpuinfo.h"
 #include "common/except.h"
 #include "common/make_unique.h"
@@ -7,6 +12,12 @@
 #include "common/zassert.h"
 #include "unresize_impl.h"
 
+#if defined(ZIMG_X86)
+  #include "x86/unresize_impl_x86.h"
+#elif defined(ZIMG_ARM)
+  #include "arm/unresize_impl_arm.h"
+#endif
+
 namespace zimg {
 namespace unresize {
 
@@ -17,9 +28,7 @@ void unresize_line_h_f32_c(const BilinearContext &ctx, const float *src, float *
 	const float *c = ctx.lu_c.data();
 	const float *l = ctx.lu_l.data();
 	const float *u = ctx.lu_u.data();
-
-	float z = 0.0f;
-	float w = 0.0f;
+	unsigned bw = ctx.lu_bandwidth;
 
 	for (unsigned j = 0; j < ctx.output_width; ++j) {
 		float accum = 0.0f;
@@ -32,96 +41,173 @@ void unresize_line_h_f32_c(const BilinearContext &ctx, const float *src, float *
 			accum += coeff * x;
 		}
 
-		z = (accum - c[j] * z) * l[j];
-		dst[j] = z;
+		for (unsigned k = 1; k <= std::min(j, bw); ++k) {
+			accum -= c[j * bw + k - 1] * dst[j - k];
+		}
+
+		dst[j] = accum * l[j];
 	}
 
 	for (unsigned j = ctx.output_width; j != 0; --j) {
-		w = dst[j - 1] - u[j - 1] * w;
+		float w = dst[j - 1];
+
+		for (unsigned k = 1; k <= std::min(ctx.output_width - j, bw); ++k) {
+			w -= u[(j - 1) * bw + k - 1] * dst[j - 1 + k];
+		}
+
 		dst[j - 1] = w;
 	}
 }
 
-void unresize_line_forward_v_f32_c(const BilinearContext &ctx, const graph::ImageBuffer<const float> &src, const graph::ImageBuffer<float> &dst, unsigned i, unsigned width)
+template <class T>
+void unresize_line_forward_v_c(const BilinearContext &ctx, const graph::ImageBuffer<const T> &src, const graph::ImageBuffer<float> &dst, unsigned i, unsigned width)
 {
-	const float *c = ctx.lu_c.data();
-	const float *l = ctx.lu_l.data();
+	const float *c = ctx.lu_c.data() + static_cast<size_t>(i) * ctx.lu_bandwidth;
+	const float l = ctx.lu_l[i];
+	unsigned bw = std::min(i, ctx.lu_bandwidth);
 
 	const float *coeffs = &ctx.matrix_coefficients[i * ctx.matrix_row_stride];
 	unsigned top = ctx.matrix_row_offsets[i];
 
 	for (unsigned j = 0; j < width; ++j) {
-		float z = i ? dst[i - 1][j] : 0.0f;
 		float accum = 0.0f;
 
 		for (unsigned k = 0; k < ctx.matrix_row_size; ++k) {
 			float coeff = coeffs[k];
-			float x = src[top + k][j];
+			float x = static_cast<float>(src[top + k][j]);
 
 			accum += coeff * x;
 		}
 
-		z = (accum - c[i] * z) * l[i];
-		dst[i][j] = z;
+		for (unsigned k = 1; k <= bw; ++k) {
+			accum -= c[k - 1] * dst[i - k][j];
+		}
+
+		dst[i][j] = accum * l;
 	}
 }
 
-void unresize_line_back_v_f32_c(const BilinearContext &ctx, const graph::ImageBuffer<float> &dst, unsigned i, unsigned width)
+void unresize_line_back_v_c(const BilinearContext &ctx, const graph::ImageBuffer<float> &dst, unsigned i, unsigned width)
 {
-	const float *u = ctx.lu_u.data();
+	const float *u = ctx.lu_u.data() + static_cast<size_t>(i - 1) * ctx.lu_bandwidth;
+	unsigned bw = std::min(ctx.output_width - i, ctx.lu_bandwidth);
 
 	for (unsigned j = 0; j < width; ++j) {
-		float w = i < ctx.output_width ? dst[i][j] : 0.0f;
+		float w = dst[i - 1][j];
+
+		for (unsigned k = 1; k <= bw; ++k) {
+			w -= u[k - 1] * dst[i - 1 + k][j];
+		}
 
-		w = dst[i - 1][j] - u[i - 1] * w;
 		dst[i - 1][j] = w;
 	}
 }
 
+void load_line_u16_c(const uint16_t *src, float *dst, unsigned width)
+{
+	std::transform(src, src + width, dst, [](uint16_t x) { return static_cast<float>(x); });
+}
+
+void store_line_u16_c(const float *src, uint16_t *dst, unsigned width, uint16_t pixel_max)
+{
+	std::transform(src, src + width, dst, [=](float x)
+	{
+		x = std::min(std::max(x, 0.0f), static_cast<float>(pixel_max));
+		return static_cast<uint16_t>(std::lrint(x));
+	});
+}
+
 
 class UnresizeImplH_C final : public UnresizeImplH {
+	uint16_t m_pixel_max;
 public:
-	UnresizeImplH_C(const BilinearContext &context, unsigned height, PixelType type) :
-		UnresizeImplH(context, image_attributes{ context.output_width, height, type })
+	UnresizeImplH_C(const BilinearContext &context, unsigned height, PixelType type, unsigned depth) :
+		UnresizeImplH(context, image_attributes{ context.output_width, height, type }),
+		m_pixel_max{ static_cast<uint16_t>(type == PixelType::WORD ? (1UL << depth) - 1 : 0) }
 	{
 		zassert_d(context.input_width <= pixel_max_width(type), "overflow");
 		zassert_d(context.output_width <= pixel_max_width(type), "overflow");
 
-		if (type != PixelType::FLOAT)
+		if (type != PixelType::WORD && type != PixelType::FLOAT)
 			error::throw_<error::InternalError>("pixel type not supported");
 	}
 
-	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *, unsigned i, unsigned, unsigned) const override
+	size_t get_tmp_size(unsigned, unsigned) const override
+	{
+		if (get_image_attributes().type != PixelType::WORD)
+			return 0;
+
+		try {
+			checked_size_t size = ceil_n(checked_size_t{ m_context.input_width }, AlignmentOf<float>::value);
+			size += ceil_n(checked_size_t{ m_context.output_width }, AlignmentOf<float>::value);
+			size *= sizeof(float);
+			return size.get();
+		} catch (const std::overflow_error &) {
+			error::throw_<error::OutOfMemory>();
+		}
+	}
+
+	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *tmp, unsigned i, unsigned, unsigned) const override
 	{
-		unresize_line_h_f32_c(m_context, static_cast<const float *>((*src)[i]), static_cast<float *>((*dst)[i]));
+		if (get_image_attributes().type == PixelType::WORD) {
+			float *line_in = static_cast<float *>(tmp);
+			float *line_out = line_in + ceil_n(m_context.input_width, AlignmentOf<float>::value);
+
+			load_line_u16_c(static_cast<const uint16_t *>((*src)[i]), line_in, m_context.input_width);
+			unresize_line_h_f32_c(m_context, line_in, line_out);
+			store_line_u16_c(line_out, static_cast<uint16_t *>((*dst)[i]), m_context.output_width, m_pixel_max);
+		} else {
+			unresize_line_h_f32_c(m_context, static_cast<const float *>((*src)[i]), static_cast<float *>((*dst)[i]));
+		}
 	}
 };
 
 class UnresizeImplV_C final : public UnresizeImplV {
+	uint16_t m_pixel_max;
 public:
-	UnresizeImplV_C(const BilinearContext &context, unsigned width, PixelType type) :
-		UnresizeImplV(context, image_attributes{ width, context.output_width, type })
+	UnresizeImplV_C(const BilinearContext &context, unsigned width, PixelType type, unsigned depth) :
+		UnresizeImplV(context, image_attributes{ width, context.output_width, type }),
+		m_pixel_max{ static_cast<uint16_t>(type == PixelType::WORD ? (1UL << depth) - 1 : 0) }
 	{
 		zassert_d(context.input_width <= pixel_max_width(type), "overflow");
 		zassert_d(context.output_width <= pixel_max_width(type), "overflow");
 
-		if (type != PixelType::FLOAT)
+		if (type != PixelType::WORD && type != PixelType::FLOAT)
 			error::throw_<error::InternalError>("pixel type not supported");
 	}
 
-	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *, unsigned, unsigned, unsigned) const override
+	size_t get_tmp_size(unsigned, unsigned) const override
 	{
-		const auto &src_buf = graph::static_buffer_cast<const float>(*src);
-		const auto &dst_buf = graph::static_buffer_cast<float>(*dst);
+		return get_image_attributes().type == PixelType::WORD ? get_tmp_plane_size() : 0;
+	}
 
+	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *tmp, unsigned, unsigned, unsigned) const override
+	{
 		unsigned width = get_image_attributes().width;
 		unsigned height = get_image_attributes().height;
 
-		for (unsigned i = 0; i < height; ++i) {
-			unresize_line_forward_v_f32_c(m_context, src_buf, dst_buf, i, width);
-		}
-		for (unsigned i = height; i != 0; --i) {
-			unresize_line_back_v_f32_c(m_context, dst_buf, i, width);
+		if (get_image_attributes().type == PixelType::WORD) {
+			const auto &src_buf = graph::static_buffer_cast<const uint16_t>(*src);
+			const auto &dst_buf = graph::static_buffer_cast<uint16_t>(*dst);
+			graph::ImageBuffer<float> tmp_buf = get_tmp_plane(tmp);
+
+			for (unsigned i = 0; i < height; ++i) {
+				unresize_line_forward_v_c(m_context, src_buf, tmp_buf, i, width);
+			}
+			for (unsigned i = height; i != 0; --i) {
+				unresize_line_back_v_c(m_context, tmp_buf, i, width);
+				store_line_u16_c(tmp_buf[i - 1], dst_buf[i - 1], width, m_pixel_max);
+			}
+		} else {
+			const auto &src_buf = graph::static_buffer_cast<const float>(*src);
+			const auto &dst_buf = graph::static_buffer_cast<float>(*dst);
+
+			for (unsigned i = 0; i < height; ++i) {
+				unresize_line_forward_v_c(m_context, src_buf, dst_buf, i, width);
+			}
+			for (unsigned i = height; i != 0; --i) {
+				unresize_line_back_v_c(m_context, dst_buf, i, width);
+			}
 		}
 	}
 };
@@ -155,7 +241,7 @@ auto UnresizeImplH::get_required_row_range(unsigned i) const -> pair_unsigned
 
 auto UnresizeImplH::get_required_col_range(unsigned left, unsigned right) const -> pair_unsigned
 {
-	return{ 0, get_image_attributes().width };
+	return{ 0, m_context.input_width };
 }
 
 unsigned UnresizeImplH::get_max_buffering() const
@@ -194,6 +280,24 @@ auto UnresizeImplV::get_required_col_range(unsigned, unsigned) const -> pair_uns
 
 unsigned UnresizeImplV::get_simultaneous_lines() const { return graph::BUFFER_MAX; }
 
+size_t UnresizeImplV::get_tmp_plane_size() const
+{
+	try {
+		checked_size_t size = ceil_n(checked_size_t{ get_image_attributes().width }, AlignmentOf<float>::value);
+		size *= m_context.output_width;
+		size *= sizeof(float);
+		return size.get();
+	} catch (const std::overflow_error &) {
+		error::throw_<error::OutOfMemory>();
+	}
+}
+
+graph::ImageBuffer<float> UnresizeImplV::get_tmp_plane(void *tmp) const
+{
+	ptrdiff_t stride = ceil_n(get_image_attributes().width, AlignmentOf<float>::value) * sizeof(float);
+	return{ static_cast<float *>(tmp), stride, graph::BUFFER_MAX };
+}
+
 unsigned UnresizeImplV::get_max_buffering() const { return graph::BUFFER_MAX; }
 
 
@@ -203,7 +307,9 @@ UnresizeImplBuilder::UnresizeImplBuilder(unsigned up_width, unsigned up_height,
 	type{ type },
 	horizontal{},
 	orig_dim{},
+	depth{ pixel_depth(type) },
 	shift{},
+	filter{},
 	cpu{ CPUClass::NONE }
 {}
 
@@ -212,12 +318,23 @@ std::unique_ptr<graph::ImageFilter> UnresizeImplBuilder::create() const
 	std::unique_ptr<graph::ImageFilter> ret;
 
 	unsigned up_dim = horizontal ? up_width : up_height;
-	BilinearContext context = create_bilinear_context(orig_dim, up_dim, shift);
-
+	BilinearContext context = create_unresize_context(orig_dim, up_dim, shift, filter);
+
+#if defined(ZIMG_X86)
+	if (horizontal)
+		ret = create_unresize_impl_h_x86(context, up_height, type, depth, cpu);
+	else
+		ret = create_unresize_impl_v_x86(context, up_width, type, depth, cpu);
+#elif defined(ZIMG_ARM)
+	if (horizontal)
+		ret = create_unresize_impl_h_arm(context, up_height, type, depth, cpu);
+	else
+		ret = create_unresize_impl_v_arm(context, up_width, type, depth, cpu);
+#endif
 	if (!ret && horizontal)
-		ret = ztd::make_unique<UnresizeImplH_C>(context, up_height, type);
+		ret = ztd::make_unique<UnresizeImplH_C>(context, up_height, type, depth);
 	if (!ret && !horizontal)
-		ret = ztd::make_unique<UnresizeImplV_C>(context, up_width, type);
+		ret = ztd::make_unique<UnresizeImplV_C>(context, up_width, type, depth);
 
 	return ret;
 }
@@ -38,6 +38,11 @@ protected:
 	image_attributes m_attr;
 
 	UnresizeImplV(const BilinearContext &context, const image_attributes &attr);
+
+	// Single precision plane holding the intermediate results for WORD images.
+	size_t get_tmp_plane_size() const;
+
+	graph::ImageBuffer<float> get_tmp_plane(void *tmp) const;
 public:
 	filter_flags get_flags() const override;
 
@@ -60,7 +65,9 @@ struct UnresizeImplBuilder {
 #include "common/builder.h"
 	BUILDER_MEMBER(bool, horizontal)
 	BUILDER_MEMBER(unsigned, orig_dim)
+	BUILDER_MEMBER(unsigned, depth)
 	BUILDER_MEMBER(double, shift)
+	BUILDER_MEMBER(const resize::Filter *, filter)
 	BUILDER_MEMBER(CPUClass, cpu)
 #undef BUILDER_MEMBER
 
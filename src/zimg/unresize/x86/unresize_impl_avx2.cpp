@@ -0,0 +1,381 @@
+#ifdef ZIMG_X86
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <immintrin.h>
+#include "common/align.h"
+#include "common/ccdep.h"
+#include "common/checked_int.h"
+#include "common/except.h"
+#include "common/make_unique.h"
+#include "common/pixel.h"
+#include "graph/image_buffer.h"
+#include "unresize/unresize_impl.h"
+#include "unresize_impl_x86.h"
+
+#include "common/x86/sse2_util.h"
+#include "common/x86/avx_util.h"
+
+namespace zimg {
+namespace unresize {
+
+namespace {
+
+inline FORCE_INLINE __m256 load_ps(const float *src)
+{
+	return _mm256_load_ps(src);
+}
+
+inline FORCE_INLINE __m256 load_ps(const uint16_t *src)
+{
+	return _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_load_si128((const __m128i *)src)));
+}
+
+inline FORCE_INLINE __m128i cvt_ps_epu16(__m256 x, __m128i pixel_max)
+{
+	__m256i y = _mm256_cvtps_epi32(x);
+	__m128i z = _mm_packus_epi32(_mm256_castsi256_si128(y), _mm256_extracti128_si256(y, 1));
+	return _mm_min_epu16(z, pixel_max);
+}
+
+// Transposes 8 rows into columns of 8 floats.
+template <class T>
+void transpose_line_8x8_ps(float * RESTRICT dst, const T * const * RESTRICT src, unsigned width)
+{
+	for (unsigned j = 0; j < width; j += 8) {
+		__m256 x0 = load_ps(src[0] + j);
+		__m256 x1 = load_ps(src[1] + j);
+		__m256 x2 = load_ps(src[2] + j);
+		__m256 x3 = load_ps(src[3] + j);
+		__m256 x4 = load_ps(src[4] + j);
+		__m256 x5 = load_ps(src[5] + j);
+		__m256 x6 = load_ps(src[6] + j);
+		__m256 x7 = load_ps(src[7] + j);
+
+		mm256_transpose8_ps(x0, x1, x2, x3, x4, x5, x6, x7);
+
+		_mm256_store_ps(dst + 0, x0);
+		_mm256_store_ps(dst + 8, x1);
+		_mm256_store_ps(dst + 16, x2);
+		_mm256_store_ps(dst + 24, x3);
+		_mm256_store_ps(dst + 32, x4);
+		_mm256_store_ps(dst + 40, x5);
+		_mm256_store_ps(dst + 48, x6);
+		_mm256_store_ps(dst + 56, x7);
+
+		dst += 64;
+	}
+}
+
+// Transposes columns of 8 floats back into 8 rows.
+void untranspose_line_8x8_ps(float * const * RESTRICT dst, const float * RESTRICT src, unsigned width)
+{
+	unsigned vec_right = floor_n(width, 8);
+
+	for (unsigned j = 0; j < ceil_n(width, 8); j += 8) {
+		__m256 x0 = _mm256_load_ps(src + 0);
+		__m256 x1 = _mm256_load_ps(src + 8);
+		__m256 x2 = _mm256_load_ps(src + 16);
+		__m256 x3 = _mm256_load_ps(src + 24);
+		__m256 x4 = _mm256_load_ps(src + 32);
+		__m256 x5 = _mm256_load_ps(src + 40);
+		__m256 x6 = _mm256_load_ps(src + 48);
+		__m256 x7 = _mm256_load_ps(src + 56);
+
+		mm256_transpose8_ps(x0, x1, x2, x3, x4, x5, x6, x7);
+
+		if (j < vec_right) {
+			_mm256_store_ps(dst[0] + j, x0);
+			_mm256_store_ps(dst[1] + j, x1);
+			_mm256_store_ps(dst[2] + j, x2);
+			_mm256_store_ps(dst[3] + j, x3);
+			_mm256_store_ps(dst[4] + j, x4);
+			_mm256_store_ps(dst[5] + j, x5);
+			_mm256_store_ps(dst[6] + j, x6);
+			_mm256_store_ps(dst[7] + j, x7);
+		} else {
+			mm256_store_idxlo_ps(dst[0] + j, x0, width % 8);
+			mm256_store_idxlo_ps(dst[1] + j, x1, width % 8);
+			mm256_store_idxlo_ps(dst[2] + j, x2, width % 8);
+			mm256_store_idxlo_ps(dst[3] + j, x3, width % 8);
+			mm256_store_idxlo_ps(dst[4] + j, x4, width % 8);
+			mm256_store_idxlo_ps(dst[5] + j, x5, width % 8);
+			mm256_store_idxlo_ps(dst[6] + j, x6, width % 8);
+			mm256_store_idxlo_ps(dst[7] + j, x7, width % 8);
+		}
+
+		src += 64;
+	}
+}
+
+// Transposes columns of 8 floats back into 8 rows of WORD samples.
+void untranspose_line_8x8_ps_epu16(uint16_t * const * RESTRICT dst, const float * RESTRICT src, unsigned width, uint16_t pixel_max)
+{
+	const __m128i max = _mm_set1_epi16(static_cast<int16_t>(pixel_max));
+	unsigned vec_right = floor_n(width, 8);
+
+	for (unsigned j = 0; j < ceil_n(width, 8); j += 8) {
+		__m256 x[8];
+
+		for (unsigned n = 0; n < 8; ++n) {
+			x[n] = _mm256_load_ps(src + n * 8);
+		}
+
+		mm256_transpose8_ps(x[0], x[1], x[2], x[3], x[4], x[5], x[6], x[7]);
+
+		for (unsigned n = 0; n < 8; ++n) {
+			__m128i y = cvt_ps_epu16(x[n], max);
+
+			if (j < vec_right)
+				_mm_store_si128((__m128i *)(dst[n] + j), y);
+			else
+				mm_store_idxlo_epi16((__m128i *)(dst[n] + j), y, width % 8);
+		}
+
+		src += 64;
+	}
+}
+
+void store_line_epu16_avx2(const float *src, uint16_t *dst, unsigned width, uint16_t pixel_max)
+{
+	const __m128i max = _mm_set1_epi16(static_cast<int16_t>(pixel_max));
+	unsigned vec_right = floor_n(width, 8);
+
+	for (unsigned j = 0; j < vec_right; j += 8) {
+		_mm_store_si128((__m128i *)(dst + j), cvt_ps_epu16(_mm256_load_ps(src + j), max));
+	}
+	if (width != vec_right)
+		mm_store_idxlo_epi16((__m128i *)(dst + vec_right), cvt_ps_epu16(_mm256_load_ps(src + vec_right), max), width % 8);
+}
+
+// Solves the system for 8 transposed rows, one row per vector lane.
+void unresize_line8_h_f32_avx2(const BilinearContext &ctx, const float * RESTRICT src, float * RESTRICT dst)
+{
+	const float *c = ctx.lu_c.data();
+	const float *l = ctx.lu_l.data();
+	const float *u = ctx.lu_u.data();
+	unsigned bw = ctx.lu_bandwidth;
+
+	for (unsigned j = 0; j < ctx.output_width; ++j) {
+		const float *coeffs = &ctx.matrix_coefficients[j * ctx.matrix_row_stride];
+		const float *src_p = src + static_cast<size_t>(ctx.matrix_row_offsets[j]) * 8;
+		__m256 accum = _mm256_setzero_ps();
+
+		for (unsigned k = 0; k < ctx.matrix_row_size; ++k) {
+			accum = _mm256_fmadd_ps(_mm256_broadcast_ss(coeffs + k), _mm256_load_ps(src_p + k * 8), accum);
+		}
+		for (unsigned k = 1; k <= std::min(j, bw); ++k) {
+			accum = _mm256_fnmadd_ps(_mm256_broadcast_ss(c + j * bw + k - 1), _mm256_load_ps(dst + (j - k) * 8), accum);
+		}
+
+		_mm256_store_ps(dst + j * 8, _mm256_mul_ps(accum, _mm256_broadcast_ss(l + j)));
+	}
+
+	for (unsigned j = ctx.output_width; j != 0; --j) {
+		__m256 w = _mm256_load_ps(dst + (j - 1) * 8);
+
+		for (unsigned k = 1; k <= std::min(ctx.output_width - j, bw); ++k) {
+			w = _mm256_fnmadd_ps(_mm256_broadcast_ss(u + (j - 1) * bw + k - 1), _mm256_load_ps(dst + (j - 1 + k) * 8), w);
+		}
+
+		_mm256_store_ps(dst + (j - 1) * 8, w);
+	}
+}
+
+template <class T>
+inline FORCE_INLINE __m256 unresize_line_forward_v_avx2_xiter(const BilinearContext &ctx, const graph::ImageBuffer<const T> &src, const graph::ImageBuffer<float> &dst,
+                                                              unsigned i, unsigned j, const float *c, unsigned bw, const __m256 &l)
+{
+	const float *coeffs = &ctx.matrix_coefficients[i * ctx.matrix_row_stride];
+	unsigned top = ctx.matrix_row_offsets[i];
+
+	__m256 accum = _mm256_setzero_ps();
+
+	for (unsigned k = 0; k < ctx.matrix_row_size; ++k) {
+		accum = _mm256_fmadd_ps(_mm256_broadcast_ss(coeffs + k), load_ps(src[top + k] + j), accum);
+	}
+	for (unsigned k = 1; k <= bw; ++k) {
+		accum = _mm256_fnmadd_ps(_mm256_broadcast_ss(c + k - 1), _mm256_load_ps(dst[i - k] + j), accum);
+	}
+
+	return _mm256_mul_ps(accum, l);
+}
+
+template <class T>
+void unresize_line_forward_v_avx2(const BilinearContext &ctx, const graph::ImageBuffer<const T> &src, const graph::ImageBuffer<float> &dst, unsigned i, unsigned width)
+{
+	const float *c = ctx.lu_c.data() + static_cast<size_t>(i) * ctx.lu_bandwidth;
+	const __m256 l = _mm256_broadcast_ss(&ctx.lu_l[i]);
+	unsigned bw = std::min(i, ctx.lu_bandwidth);
+	unsigned vec_right = floor_n(width, 8);
+
+	for (unsigned j = 0; j < vec_right; j += 8) {
+		__m256 z = unresize_line_forward_v_avx2_xiter(ctx, src, dst, i, j, c, bw, l);
+		_mm256_store_ps(dst[i] + j, z);
+	}
+	if (width != vec_right) {
+		__m256 z = unresize_line_forward_v_avx2_xiter(ctx, src, dst, i, vec_right, c, bw, l);
+		mm256_store_idxlo_ps(dst[i] + vec_right, z, width % 8);
+	}
+}
+
+void unresize_line_back_v_f32_avx2(const BilinearContext &ctx, const graph::ImageBuffer<float> &dst, unsigned i, unsigned width)
+{
+	const float *u = ctx.lu_u.data() + static_cast<size_t>(i - 1) * ctx.lu_bandwidth;
+	unsigned bw = std::min(ctx.output_width - i, ctx.lu_bandwidth);
+	unsigned vec_right = floor_n(width, 8);
+
+	for (unsigned j = 0; j < ceil_n(width, 8); j += 8) {
+		__m256 w = _mm256_load_ps(dst[i - 1] + j);
+
+		for (unsigned k = 1; k <= bw; ++k) {
+			w = _mm256_fnmadd_ps(_mm256_broadcast_ss(u + k - 1), _mm256_load_ps(dst[i - 1 + k] + j), w);
+		}
+
+		if (j < vec_right)
+			_mm256_store_ps(dst[i - 1] + j, w);
+		else
+			mm256_store_idxlo_ps(dst[i - 1] + j, w, width % 8);
+	}
+}
+
+
+class UnresizeImplH_AVX2 final : public UnresizeImplH {
+	uint16_t m_pixel_max;
+
+	template <class T>
+	const float *transpose_and_solve(const graph::ImageBuffer<const T> &src, void *tmp, unsigned i) const
+	{
+		const T *src_ptr[8] = { 0 };
+		float *transpose_in = static_cast<float *>(tmp);
+		float *transpose_out = transpose_in + ceil_n(m_context.input_width, 8) * 8;
+		unsigned height = get_image_attributes().height;
+
+		for (unsigned n = 0; n < 8; ++n) {
+			src_ptr[n] = src[std::min(i + n, height - 1)];
+		}
+
+		transpose_line_8x8_ps(transpose_in, src_ptr, m_context.input_width);
+		unresize_line8_h_f32_avx2(m_context, transpose_in, transpose_out);
+		return transpose_out;
+	}
+public:
+	UnresizeImplH_AVX2(const BilinearContext &context, unsigned height, PixelType type, unsigned depth) :
+		UnresizeImplH(context, image_attributes{ context.output_width, height, type }),
+		m_pixel_max{ static_cast<uint16_t>(type == PixelType::WORD ? (1UL << depth) - 1 : 0) }
+	{}
+
+	unsigned get_simultaneous_lines() const override { return 8; }
+
+	size_t get_tmp_size(unsigned, unsigned) const override
+	{
+		try {
+			checked_size_t size = static_cast<checked_size_t>(ceil_n(m_context.input_width, 8)) * 8;
+			size += static_cast<checked_size_t>(ceil_n(m_context.output_width, 8)) * 8;
+			size *= sizeof(float);
+			return size.get();
+		} catch (const std::overflow_error &) {
+			error::throw_<error::OutOfMemory>();
+		}
+	}
+
+	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *tmp, unsigned i, unsigned, unsigned) const override
+	{
+		unsigned height = get_image_attributes().height;
+
+		if (get_image_attributes().type == PixelType::WORD) {
+			const auto &dst_buf = graph::static_buffer_cast<uint16_t>(*dst);
+			const float *result = transpose_and_solve(graph::static_buffer_cast<const uint16_t>(*src), tmp, i);
+			uint16_t *dst_ptr[8] = { 0 };
+
+			for (unsigned n = 0; n < 8; ++n) {
+				dst_ptr[n] = dst_buf[std::min(i + n, height - 1)];
+			}
+
+			untranspose_line_8x8_ps_epu16(dst_ptr, result, m_context.output_width, m_pixel_max);
+		} else {
+			const auto &dst_buf = graph::static_buffer_cast<float>(*dst);
+			const float *result = transpose_and_solve(graph::static_buffer_cast<const float>(*src), tmp, i);
+			float *dst_ptr[8] = { 0 };
+
+			for (unsigned n = 0; n < 8; ++n) {
+				dst_ptr[n] = dst_buf[std::min(i + n, height - 1)];
+			}
+
+			untranspose_line_8x8_ps(dst_ptr, result, m_context.output_width);
+		}
+	}
+};
+
+class UnresizeImplV_AVX2 final : public UnresizeImplV {
+	uint16_t m_pixel_max;
+public:
+	UnresizeImplV_AVX2(const BilinearContext &context, unsigned width, PixelType type, unsigned depth) :
+		UnresizeImplV(context, image_attributes{ width, context.output_width, type }),
+		m_pixel_max{ static_cast<uint16_t>(type == PixelType::WORD ? (1UL << depth) - 1 : 0) }
+	{}
+
+	size_t get_tmp_size(unsigned, unsigned) const override
+	{
+		return get_image_attributes().type == PixelType::WORD ? get_tmp_plane_size() : 0;
+	}
+
+	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *tmp, unsigned, unsigned, unsigned) const override
+	{
+		unsigned width = get_image_attributes().width;
+		unsigned height = get_image_attributes().height;
+
+		if (get_image_attributes().type == PixelType::WORD) {
+			const auto &src_buf = graph::static_buffer_cast<const uint16_t>(*src);
+			const auto &dst_buf = graph::static_buffer_cast<uint16_t>(*dst);
+			graph::ImageBuffer<float> tmp_buf = get_tmp_plane(tmp);
+
+			for (unsigned i = 0; i < height; ++i) {
+				unresize_line_forward_v_avx2(m_context, src_buf, tmp_buf, i, width);
+			}
+			for (unsigned i = height; i != 0; --i) {
+				unresize_line_back_v_f32_avx2(m_context, tmp_buf, i, width);
+				store_line_epu16_avx2(tmp_buf[i - 1], dst_buf[i - 1], width, m_pixel_max);
+			}
+		} else {
+			const auto &src_buf = graph::static_buffer_cast<const float>(*src);
+			const auto &dst_buf = graph::static_buffer_cast<float>(*dst);
+
+			for (unsigned i = 0; i < height; ++i) {
+				unresize_line_forward_v_avx2(m_context, src_buf, dst_buf, i, width);
+			}
+			for (unsigned i = height; i != 0; --i) {
+				unresize_line_back_v_f32_avx2(m_context, dst_buf, i, width);
+			}
+		}
+	}
+};
+
+} // namespace
+
+
+std::unique_ptr<graph::ImageFilter> create_unresize_impl_h_avx2(const BilinearContext &context, unsigned height, PixelType type, unsigned depth)
+{
+	std::unique_ptr<graph::ImageFilter> ret;
+
+	if (type == PixelType::WORD || type == PixelType::FLOAT)
+		ret = ztd::make_unique<UnresizeImplH_AVX2>(context, height, type, depth);
+
+	return ret;
+}
+
+std::unique_ptr<graph::ImageFilter> create_unresize_impl_v_avx2(const BilinearContext &context, unsigned width, PixelType type, unsigned depth)
+{
+	std::unique_ptr<graph::ImageFilter> ret;
+
+	if (type == PixelType::WORD || type == PixelType::FLOAT)
+		ret = ztd::make_unique<UnresizeImplV_AVX2>(context, width, type, depth);
+
+	return ret;
+}
+
+} // namespace unresize
+} // namespace zimg
+
+#endif // ZIMG_X86
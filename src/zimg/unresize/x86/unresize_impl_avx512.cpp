@@ -0,0 +1,282 @@
+#ifdef ZIMG_X86_AVX512
+
+#include <algorithm>
+#include <stdexcept>
+#include <immintrin.h>
+#include "common/align.h"
+#include "common/ccdep.h"
+#include "common/checked_int.h"
+#include "common/except.h"
+#include "common/make_unique.h"
+#include "common/pixel.h"
+#include "graph/image_buffer.h"
+#include "unresize/unresize_impl.h"
+#include "unresize_impl_x86.h"
+
+#include "common/x86/avx512_util.h"
+
+namespace zimg {
+namespace unresize {
+
+namespace {
+
+// Transposes 16 rows into columns of 16 floats.
+void transpose_line_16x16_ps(float * RESTRICT dst, const float * const * RESTRICT src, unsigned width)
+{
+	for (unsigned j = 0; j < width; j += 16) {
+		__m512 x0 = _mm512_load_ps(src[0] + j);
+		__m512 x1 = _mm512_load_ps(src[1] + j);
+		__m512 x2 = _mm512_load_ps(src[2] + j);
+		__m512 x3 = _mm512_load_ps(src[3] + j);
+		__m512 x4 = _mm512_load_ps(src[4] + j);
+		__m512 x5 = _mm512_load_ps(src[5] + j);
+		__m512 x6 = _mm512_load_ps(src[6] + j);
+		__m512 x7 = _mm512_load_ps(src[7] + j);
+		__m512 x8 = _mm512_load_ps(src[8] + j);
+		__m512 x9 = _mm512_load_ps(src[9] + j);
+		__m512 x10 = _mm512_load_ps(src[10] + j);
+		__m512 x11 = _mm512_load_ps(src[11] + j);
+		__m512 x12 = _mm512_load_ps(src[12] + j);
+		__m512 x13 = _mm512_load_ps(src[13] + j);
+		__m512 x14 = _mm512_load_ps(src[14] + j);
+		__m512 x15 = _mm512_load_ps(src[15] + j);
+
+		mm512_transpose16_ps(x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15);
+
+		_mm512_store_ps(dst + 0, x0);
+		_mm512_store_ps(dst + 16, x1);
+		_mm512_store_ps(dst + 32, x2);
+		_mm512_store_ps(dst + 48, x3);
+		_mm512_store_ps(dst + 64, x4);
+		_mm512_store_ps(dst + 80, x5);
+		_mm512_store_ps(dst + 96, x6);
+		_mm512_store_ps(dst + 112, x7);
+		_mm512_store_ps(dst + 128, x8);
+		_mm512_store_ps(dst + 144, x9);
+		_mm512_store_ps(dst + 160, x10);
+		_mm512_store_ps(dst + 176, x11);
+		_mm512_store_ps(dst + 192, x12);
+		_mm512_store_ps(dst + 208, x13);
+		_mm512_store_ps(dst + 224, x14);
+		_mm512_store_ps(dst + 240, x15);
+
+		dst += 256;
+	}
+}
+
+// Transposes columns of 16 floats back into 16 rows.
+void untranspose_line_16x16_ps(float * const * RESTRICT dst, const float * RESTRICT src, unsigned width)
+{
+	unsigned vec_right = floor_n(width, 16);
+
+	for (unsigned j = 0; j < ceil_n(width, 16); j += 16) {
+		__m512 x0 = _mm512_load_ps(src + 0);
+		__m512 x1 = _mm512_load_ps(src + 16);
+		__m512 x2 = _mm512_load_ps(src + 32);
+		__m512 x3 = _mm512_load_ps(src + 48);
+		__m512 x4 = _mm512_load_ps(src + 64);
+		__m512 x5 = _mm512_load_ps(src + 80);
+		__m512 x6 = _mm512_load_ps(src + 96);
+		__m512 x7 = _mm512_load_ps(src + 112);
+		__m512 x8 = _mm512_load_ps(src + 128);
+		__m512 x9 = _mm512_load_ps(src + 144);
+		__m512 x10 = _mm512_load_ps(src + 160);
+		__m512 x11 = _mm512_load_ps(src + 176);
+		__m512 x12 = _mm512_load_ps(src + 192);
+		__m512 x13 = _mm512_load_ps(src + 208);
+		__m512 x14 = _mm512_load_ps(src + 224);
+		__m512 x15 = _mm512_load_ps(src + 240);
+
+		mm512_transpose16_ps(x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15);
+
+		__mmask16 mask = j < vec_right ? 0xFFFFU : mmask16_set_lo(width % 16);
+
+		_mm512_mask_store_ps(dst[0] + j, mask, x0);
+		_mm512_mask_store_ps(dst[1] + j, mask, x1);
+		_mm512_mask_store_ps(dst[2] + j, mask, x2);
+		_mm512_mask_store_ps(dst[3] + j, mask, x3);
+		_mm512_mask_store_ps(dst[4] + j, mask, x4);
+		_mm512_mask_store_ps(dst[5] + j, mask, x5);
+		_mm512_mask_store_ps(dst[6] + j, mask, x6);
+		_mm512_mask_store_ps(dst[7] + j, mask, x7);
+		_mm512_mask_store_ps(dst[8] + j, mask, x8);
+		_mm512_mask_store_ps(dst[9] + j, mask, x9);
+		_mm512_mask_store_ps(dst[10] + j, mask, x10);
+		_mm512_mask_store_ps(dst[11] + j, mask, x11);
+		_mm512_mask_store_ps(dst[12] + j, mask, x12);
+		_mm512_mask_store_ps(dst[13] + j, mask, x13);
+		_mm512_mask_store_ps(dst[14] + j, mask, x14);
+		_mm512_mask_store_ps(dst[15] + j, mask, x15);
+
+		src += 256;
+	}
+}
+
+// Solves the system for 16 transposed rows, one row per vector lane.
+void unresize_line16_h_f32_avx512(const BilinearContext &ctx, const float * RESTRICT src, float * RESTRICT dst)
+{
+	const float *c = ctx.lu_c.data();
+	const float *l = ctx.lu_l.data();
+	const float *u = ctx.lu_u.data();
+	unsigned bw = ctx.lu_bandwidth;
+
+	for (unsigned j = 0; j < ctx.output_width; ++j) {
+		const float *coeffs = &ctx.matrix_coefficients[j * ctx.matrix_row_stride];
+		const float *src_p = src + static_cast<size_t>(ctx.matrix_row_offsets[j]) * 16;
+		__m512 accum = _mm512_setzero_ps();
+
+		for (unsigned k = 0; k < ctx.matrix_row_size; ++k) {
+			accum = _mm512_fmadd_ps(_mm512_set1_ps(coeffs[k]), _mm512_load_ps(src_p + k * 16), accum);
+		}
+		for (unsigned k = 1; k <= std::min(j, bw); ++k) {
+			accum = _mm512_fnmadd_ps(_mm512_set1_ps(c[j * bw + k - 1]), _mm512_load_ps(dst + (j - k) * 16), accum);
+		}
+
+		_mm512_store_ps(dst + j * 16, _mm512_mul_ps(accum, _mm512_set1_ps(l[j])));
+	}
+
+	for (unsigned j = ctx.output_width; j != 0; --j) {
+		__m512 w = _mm512_load_ps(dst + (j - 1) * 16);
+
+		for (unsigned k = 1; k <= std::min(ctx.output_width - j, bw); ++k) {
+			w = _mm512_fnmadd_ps(_mm512_set1_ps(u[(j - 1) * bw + k - 1]), _mm512_load_ps(dst + (j - 1 + k) * 16), w);
+		}
+
+		_mm512_store_ps(dst + (j - 1) * 16, w);
+	}
+}
+
+void unresize_line_forward_v_f32_avx512(const BilinearContext &ctx, const graph::ImageBuffer<const float> &src, const graph::ImageBuffer<float> &dst, unsigned i, unsigned width)
+{
+	const float *coeffs = &ctx.matrix_coefficients[i * ctx.matrix_row_stride];
+	unsigned top = ctx.matrix_row_offsets[i];
+
+	const float *c = ctx.lu_c.data() + static_cast<size_t>(i) * ctx.lu_bandwidth;
+	const __m512 l = _mm512_set1_ps(ctx.lu_l[i]);
+	unsigned bw = std::min(i, ctx.lu_bandwidth);
+	unsigned vec_right = floor_n(width, 16);
+
+	for (unsigned j = 0; j < ceil_n(width, 16); j += 16) {
+		__m512 accum = _mm512_setzero_ps();
+
+		for (unsigned k = 0; k < ctx.matrix_row_size; ++k) {
+			accum = _mm512_fmadd_ps(_mm512_set1_ps(coeffs[k]), _mm512_load_ps(src[top + k] + j), accum);
+		}
+		for (unsigned k = 1; k <= bw; ++k) {
+			accum = _mm512_fnmadd_ps(_mm512_set1_ps(c[k - 1]), _mm512_load_ps(dst[i - k] + j), accum);
+		}
+
+		_mm512_mask_store_ps(dst[i] + j, j < vec_right ? 0xFFFFU : mmask16_set_lo(width % 16), _mm512_mul_ps(accum, l));
+	}
+}
+
+void unresize_line_back_v_f32_avx512(const BilinearContext &ctx, const graph::ImageBuffer<float> &dst, unsigned i, unsigned width)
+{
+	const float *u = ctx.lu_u.data() + static_cast<size_t>(i - 1) * ctx.lu_bandwidth;
+	unsigned bw = std::min(ctx.output_width - i, ctx.lu_bandwidth);
+	unsigned vec_right = floor_n(width, 16);
+
+	for (unsigned j = 0; j < ceil_n(width, 16); j += 16) {
+		__m512 w = _mm512_load_ps(dst[i - 1] + j);
+
+		for (unsigned k = 1; k <= bw; ++k) {
+			w = _mm512_fnmadd_ps(_mm512_set1_ps(u[k - 1]), _mm512_load_ps(dst[i - 1 + k] + j), w);
+		}
+
+		_mm512_mask_store_ps(dst[i - 1] + j, j < vec_right ? 0xFFFFU : mmask16_set_lo(width % 16), w);
+	}
+}
+
+
+class UnresizeImplH_F32_AVX512 final : public UnresizeImplH {
+public:
+	UnresizeImplH_F32_AVX512(const BilinearContext &context, unsigned height) :
+		UnresizeImplH(context, image_attributes{ context.output_width, height, PixelType::FLOAT })
+	{}
+
+	unsigned get_simultaneous_lines() const override { return 16; }
+
+	size_t get_tmp_size(unsigned, unsigned) const override
+	{
+		try {
+			checked_size_t size = static_cast<checked_size_t>(ceil_n(m_context.input_width, 16)) * 16;
+			size += static_cast<checked_size_t>(ceil_n(m_context.output_width, 16)) * 16;
+			size *= sizeof(float);
+			return size.get();
+		} catch (const std::overflow_error &) {
+			error::throw_<error::OutOfMemory>();
+		}
+	}
+
+	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *tmp, unsigned i, unsigned, unsigned) const override
+	{
+		const auto &src_buf = graph::static_buffer_cast<const float>(*src);
+		const auto &dst_buf = graph::static_buffer_cast<float>(*dst);
+
+		const float *src_ptr[16] = { 0 };
+		float *dst_ptr[16] = { 0 };
+		float *transpose_in = static_cast<float *>(tmp);
+		float *transpose_out = transpose_in + ceil_n(m_context.input_width, 16) * 16;
+		unsigned height = get_image_attributes().height;
+
+		for (unsigned n = 0; n < 16; ++n) {
+			src_ptr[n] = src_buf[std::min(i + n, height - 1)];
+			dst_ptr[n] = dst_buf[std::min(i + n, height - 1)];
+		}
+
+		transpose_line_16x16_ps(transpose_in, src_ptr, m_context.input_width);
+		unresize_line16_h_f32_avx512(m_context, transpose_in, transpose_out);
+		untranspose_line_16x16_ps(dst_ptr, transpose_out, m_context.output_width);
+	}
+};
+
+class UnresizeImplV_F32_AVX512 final : public UnresizeImplV {
+public:
+	UnresizeImplV_F32_AVX512(const BilinearContext &context, unsigned width) :
+		UnresizeImplV(context, image_attributes{ width, context.output_width, PixelType::FLOAT })
+	{}
+
+	void process(void *, const graph::ImageBuffer<const void> *src, const graph::ImageBuffer<void> *dst, void *, unsigned, unsigned, unsigned) const override
+	{
+		const auto &src_buf = graph::static_buffer_cast<const float>(*src);
+		const auto &dst_buf = graph::static_buffer_cast<float>(*dst);
+
+		unsigned width = get_image_attributes().width;
+		unsigned height = get_image_attributes().height;
+
+		for (unsigned i = 0; i < height; ++i) {
+			unresize_line_forward_v_f32_avx512(m_context, src_buf, dst_buf, i, width);
+		}
+		for (unsigned i = height; i != 0; --i) {
+			unresize_line_back_v_f32_avx512(m_context, dst_buf, i, width);
+		}
+	}
+};
+
+} // namespace
+
+
+std::unique_ptr<graph::ImageFilter> create_unresize_impl_h_avx512(const BilinearContext &context, unsigned height, PixelType type, unsigned)
+{
+	std::unique_ptr<graph::ImageFilter> ret;
+
+	if (type == PixelType::FLOAT)
+		ret = ztd::make_unique<UnresizeImplH_F32_AVX512>(context, height);
+
+	return ret;
+}
+
+std::unique_ptr<graph::ImageFilter> create_unresize_impl_v_avx512(const BilinearContext &context, unsigned width, PixelType type, unsigned)
+{
+	std::unique_ptr<graph::ImageFilter> ret;
+
+	if (type == PixelType::FLOAT)
+		ret = ztd::make_unique<UnresizeImplV_F32_AVX512>(context, width);
+
+	return ret;
+}
+
+} // namespace unresize
+} // namespace zimg
+
+#endif // ZIMG_X86_AVX512
@@ -1,5 +1,6 @@
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include "api/zimg.h"
 
@@ -70,3 +71,91 @@ TEST(APITest, test_api_2_3_compat)
 		EXPECT_EQ(0xCC, *(reinterpret_cast<unsigned char *>(&format) + i));
 	}
 }
+
+TEST(APITest, test_api_2_4_compat)
+{
+	const unsigned API_2_4 = ZIMG_MAKE_API_VERSION(2, 4);
+	const size_t extra_off = offsetof(zimg_image_format, packing);
+	const size_t extra_len = sizeof(zimg_image_format) - extra_off;
+
+	zimg_image_format format;
+	std::memset(reinterpret_cast<unsigned char *>(&format) + extra_off, 0xCC, extra_len);
+
+	zimg_image_format_default(&format, API_2_4);
+	EXPECT_EQ(API_2_4, format.version);
+	for (size_t i = extra_off; i < extra_len; ++i) {
+		EXPECT_EQ(0xCC, *(reinterpret_cast<unsigned char *>(&format) + i));
+	}
+}
+
+TEST(APITest, test_passthrough_planes)
+{
+	zimg_image_format src_format;
+	zimg_image_format_default(&src_format, ZIMG_API_VERSION);
+	src_format.width = 640;
+	src_format.height = 480;
+	src_format.pixel_type = ZIMG_PIXEL_BYTE;
+	src_format.subsample_w = 1;
+	src_format.subsample_h = 1;
+	src_format.color_family = ZIMG_COLOR_YUV;
+	src_format.pixel_range = ZIMG_RANGE_LIMITED;
+
+	zimg_image_format dst_format = src_format;
+	dst_format.subsample_w = 0;
+	dst_format.subsample_h = 0;
+
+	zimg_filter_graph *graph = zimg_filter_graph_build(&src_format, &dst_format, nullptr);
+	ASSERT_TRUE(graph);
+
+	unsigned planes = ~0U;
+	EXPECT_EQ(ZIMG_ERROR_SUCCESS, zimg_filter_graph_get_passthrough_planes(graph, &planes));
+	EXPECT_EQ(1U, planes);
+	zimg_filter_graph_free(graph);
+
+	graph = zimg_filter_graph_build(&src_format, &src_format, nullptr);
+	ASSERT_TRUE(graph);
+
+	EXPECT_EQ(ZIMG_ERROR_SUCCESS, zimg_filter_graph_get_passthrough_planes(graph, &planes));
+	EXPECT_EQ(7U, planes);
+	zimg_filter_graph_free(graph);
+}
+
+TEST(APITest, test_buffer_alloc)
+{
+	const unsigned flags[] = { ZIMG_ALLOC_DEFAULT, ZIMG_ALLOC_TRANSPARENT_HUGE_PAGES };
+
+	for (unsigned f : flags) {
+		for (int numa_node = -1; numa_node <= 0; ++numa_node) {
+			SCOPED_TRACE(f);
+			SCOPED_TRACE(numa_node);
+
+			// NUMA placement is a preference, so only the allocation itself is
+			// checked. Whether node 0 is honoured depends on the environment.
+			void *ptr = zimg_buffer_alloc(3 << 20, f, numa_node);
+			ASSERT_TRUE(ptr);
+			EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(ptr) % 64);
+			std::memset(ptr, 0xCC, 3 << 20);
+			zimg_buffer_free(ptr);
+		}
+	}
+
+	EXPECT_FALSE(zimg_buffer_alloc(64, 4, -1));
+	EXPECT_EQ(ZIMG_ERROR_ENUM_OUT_OF_RANGE, zimg_get_last_error(nullptr, 0));
+	zimg_clear_last_error();
+
+	zimg_buffer_free(nullptr);
+
+	zimg_image_format format;
+	zimg_image_format_default(&format, ZIMG_API_VERSION);
+	format.width = 640;
+	format.height = 480;
+	format.pixel_type = ZIMG_PIXEL_BYTE;
+
+	zimg_filter_graph *graph = zimg_filter_graph_build(&format, &format, nullptr);
+	ASSERT_TRUE(graph);
+
+	void *tmp = zimg_filter_graph_alloc_tmp(graph, ZIMG_ALLOC_TRANSPARENT_HUGE_PAGES, -1);
+	EXPECT_TRUE(tmp);
+	zimg_buffer_free(tmp);
+	zimg_filter_graph_free(graph);
+}
@@ -80,40 +80,28 @@ TEST(ColorspaceConversionNeonTest, test_transfer_lut)
 
 	const char *expected_sha1[][3] = {
 		{
-#if defined(_M_ARM64) || defined(__aarch64__)
-			"23d012fcb280f601e2e3c349229d0108e3cd632a",
-			"7ae186215d5fa45065f7aeac74ab2dc74b556696",
-			"bad84d4e0de8572c81df6d9f91fef05b1576f9e5"
-#else
-			"52451877e62e9fc31eb10b1e37c5f95fdd8851db",
-			"06bc0aff436bbbf4ba633b2255dd096e628a129c",
-			"a20570af1c05291029ea7d6b4215c451f4a9187a"
-#endif
+			"3ac21465994325deee1a40e0fa3c004fbc41c81f",
+			"b77f13bc9add6986fa89fe7b81f773e21e0b21c9",
+			"6181708f6635997995e992cc1d5e9c06e94416bc"
 		},
 		{
-			"011ee645ad30bb6ad6d93d8980d89a3e3e073c19",
-			"5ae0e075b3856d9f491954b477568b17daf7f147",
-			"84b20f8fa27c23a668540566b9df26c4b42c9afa"
+			"5307a8802e5880063b99dbcfa9cb21b96e999657",
+			"d4761e0ad93329e71ae2162607e7e8dc63970138",
+			"fe723d4049eeb8851288dbd2f42e6f37e8aae719"
 		},
 		{
-#if defined(_M_ARM64) || defined(__aarch64__)
-			"8206be2ae5e8a0fc003daeec4178189eecf82a13",
-			"24843f17600dd7bf9870f5c778549bd96c333427",
-			"26a6b00801b41da17d849e02217bf69add6324a6"
-#else
-			"905d4d54eeae6458e8e0975c9cea66b25edcc234",
-			"d380f54820f1e269ea54a1d552b0cb704f83dd7b",
-			"552579149674b5e37f0d443ad19a59593fdca057"
-#endif
+			"cb69dc5acfe552f8b2fae874f1c349543b3949dd",
+			"dcae3f877e785179ec0d13d64aaa575c53f2453c",
+			"60017f48ac2fb7661e6c402cff07c4efad5a9f57"
 		},
 		{
-			"16f2274ffac90927de0438114f0ea22e650981a0",
-			"b1c8b15b6159ab43e7bfc4e715fe3b621628d26e",
-			"632ae07d6919533c87d2ed28560a60cf070498e2"
+			"f97ec96e6aba2b18f4e0d7e1a0232e29466a1a86",
+			"080063d669baa27154566a64195493d14a3444d0",
+			"a82ad1b67471c7fa029fbf0f6382bafa200e3614"
 		},
 	};
-	const double expected_tolinear_snr = 80.0;
-	const double expected_togamma_snr = 80.0;
+	const double expected_tolinear_snr = 90.0;
+	const double expected_togamma_snr = 110.0;
 
 	SCOPED_TRACE("tolinear 709");
 	test_case({ MatrixCoefficients::RGB, TransferCharacteristics::REC_709, ColorPrimaries::UNSPECIFIED },
@@ -133,4 +121,84 @@ TEST(ColorspaceConversionNeonTest, test_transfer_lut)
 	          expected_sha1[3], expected_togamma_snr);
 }
 
+#if defined(_M_ARM64) || defined(__aarch64__)
+TEST(ColorspaceConversionNeonTest, test_arib_b67)
+{
+	using namespace zimg::colorspace;
+
+	const unsigned w = 640;
+	const unsigned h = 480;
+
+	if (!zimg::query_arm_capabilities().neon) {
+		SUCCEED() << "neon not available, skipping";
+		return;
+	}
+
+	// The display-referred OOTF is only used without approximate gamma.
+	auto run_test = [=](const ColorspaceDefinition &csp_in, const ColorspaceDefinition &csp_out, double expected_snr)
+	{
+		auto builder = ColorspaceConversion{ w, h }
+			.set_csp_in(csp_in)
+			.set_csp_out(csp_out);
+
+		auto filter_c = builder.set_cpu(zimg::CPUClass::NONE).create();
+		auto filter_neon = builder.set_cpu(zimg::CPUClass::ARM_NEON).create();
+
+		zimg::PixelFormat format = zimg::PixelType::FLOAT;
+		FilterValidator validator{ filter_neon.get(), w, h, format };
+		validator.set_ref_filter(filter_c.get(), expected_snr)
+		         .set_yuv(false)
+		         .validate();
+	};
+
+	const double expected_tolinear_snr = 120.0;
+	const double expected_togamma_snr = 120.0;
+
+	SCOPED_TRACE("tolinear");
+	run_test({ MatrixCoefficients::RGB, TransferCharacteristics::ARIB_B67, ColorPrimaries::REC_2020 },
+	         { MatrixCoefficients::RGB, TransferCharacteristics::LINEAR, ColorPrimaries::REC_2020 },
+	         expected_tolinear_snr);
+	SCOPED_TRACE("togamma");
+	run_test({ MatrixCoefficients::RGB, TransferCharacteristics::LINEAR, ColorPrimaries::REC_2020 },
+	         { MatrixCoefficients::RGB, TransferCharacteristics::ARIB_B67, ColorPrimaries::REC_2020 },
+	         expected_togamma_snr);
+}
+#endif // defined(_M_ARM64) || defined(__aarch64__)
+
+#if !defined(_MSC_VER) || defined(_M_ARM64)
+TEST(ColorspaceConversionNeonTest, test_half)
+{
+	using namespace zimg::colorspace;
+
+	const unsigned w = 640;
+	const unsigned h = 480;
+
+	if (!zimg::query_arm_capabilities().neon) {
+		SUCCEED() << "neon not available, skipping";
+		return;
+	}
+
+	ColorspaceDefinition csp_in{ MatrixCoefficients::REC_709, TransferCharacteristics::REC_709, ColorPrimaries::REC_709 };
+	ColorspaceDefinition csp_out{ MatrixCoefficients::RGB, TransferCharacteristics::REC_709, ColorPrimaries::REC_709 };
+
+	auto builder = ColorspaceConversion{ w, h }
+		.set_csp_in(csp_in)
+		.set_csp_out(csp_out)
+		.set_approximate_gamma(true);
+
+	// No half-precision implementation is available in C, so HALF is compared to the FLOAT implementation.
+	auto filter_c = builder.set_cpu(zimg::CPUClass::NONE).create();
+	auto filter_neon = builder.set_pixel_in(zimg::PixelType::HALF).set_cpu(zimg::CPUClass::ARM_NEON).create();
+
+	// Half precision has an 11-bit significand, so results may differ from the reference by an ulp.
+	const double expected_snr = 60.0;
+
+	zimg::PixelFormat format = zimg::PixelType::HALF;
+	FilterValidator validator{ filter_neon.get(), w, h, format };
+	validator.set_ref_filter(filter_c.get(), expected_snr)
+	         .set_yuv(true)
+	         .validate();
+}
+#endif // !defined(_MSC_VER) || defined(_M_ARM64)
+
 #endif // ZIMG_ARM
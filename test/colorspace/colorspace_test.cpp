@@ -1,3 +1,4 @@
+#include "common/cpuinfo.h"
 #include "common/pixel.h"
 #include "colorspace/colorspace.h"
 #include "graph/image_filter.h"
@@ -58,9 +59,9 @@ TEST(ColorspaceConversionTest, test_matrix_only)
 			"cf8fbed8b60ae7328d43d06523ab25eab1095316"
 		},
 		{
-			"b189703d18508db5e1fa374e7403415728dfaf51",
-			"b81c2d5cf5251aad96797ec0025fe56b2c676853",
-			"03d20fd3a89fa681a461491a2558734636bd7e9b"
+			"eb59e3f589c50e3c2b6f54215207d1471f9b87e2",
+			"997dbbded68c9297d858d01380cb3ca7b86f690b",
+			"29d20c5ef6ead470a2f6fc081ef4ea929e3130f9"
 		},
 		{
 			"3732b8f5fb4b5282ab1912a689f3d25cf5651bcb",
@@ -369,3 +370,195 @@ TEST(ColorspaceConversionTest, test_rec2100_ictcp)
 	          { MatrixCoefficients::RGB, TransferCharacteristics::LINEAR, ColorPrimaries::REC_2020 },
 	          expected_sha1[3]);
 }
+
+TEST(ColorspaceConversionTest, test_matrix_folding)
+{
+	using namespace zimg::colorspace;
+
+	const char *expected_sha1[][3] = {
+		{
+			"5d08f308997525adf5fbd996bfeba397ac26bef4",
+			"51890a78cb7cdea299e14e3bbb596751140af91d",
+			"18f85d92a7a951127afb4d02ea385891b9eb7150"
+		},
+		{
+			"a5e3c53495e2297491683623ee814d16568c6b71",
+			"7536f72d616e146a903d1b19d4540897a88b5246",
+			"d72d2148ab54d45f49bb1153c7126a7ea85f75d7"
+		},
+	};
+
+	SCOPED_TRACE("linear rgb 709->linear lms");
+	test_case({ MatrixCoefficients::RGB, TransferCharacteristics::LINEAR, ColorPrimaries::REC_709 },
+	          { MatrixCoefficients::REC_2100_LMS, TransferCharacteristics::LINEAR, ColorPrimaries::REC_2020 },
+	          expected_sha1[0]);
+	SCOPED_TRACE("linear 709->linear 2020");
+	test_case({ MatrixCoefficients::REC_709, TransferCharacteristics::LINEAR, ColorPrimaries::REC_709 },
+	          { MatrixCoefficients::REC_2020_NCL, TransferCharacteristics::LINEAR, ColorPrimaries::REC_2020 },
+	          expected_sha1[1]);
+}
+
+TEST(ColorspaceConversionTest, test_lut3d)
+{
+	using namespace zimg::colorspace;
+
+	const unsigned w = 640;
+	const unsigned h = 480;
+
+	auto run_test = [=](const ColorspaceDefinition &csp_in, const ColorspaceDefinition &csp_out, const char * const expected_sha1[3], double expected_snr)
+	{
+		auto builder = ColorspaceConversion{ w, h }
+			.set_csp_in(csp_in)
+			.set_csp_out(csp_out)
+			.set_cpu(zimg::CPUClass::NONE);
+
+		auto filter_exact = builder.create();
+		auto filter_lut = builder.set_approximate_colorspace(true).create();
+
+		zimg::PixelFormat format = zimg::PixelType::FLOAT;
+		FilterValidator validator{ filter_lut.get(), w, h, format };
+		validator.set_sha1(expected_sha1)
+		         .set_ref_filter(filter_exact.get(), expected_snr)
+		         .set_yuv(csp_in.matrix != MatrixCoefficients::RGB)
+		         .validate();
+	};
+
+	const char *expected_sha1[][3] = {
+		{
+			"b5e54a278e24fce58fd91f6de1f93530e2e875d9",
+			"9dc40d9807cee55fe35fe035bf006ba477da21c4",
+			"db2e5fbc9c23f0e089783cb2bb64194b847a9a93"
+		},
+		{
+			"662efa488814611a6b7385b4eba0426afe95d6df",
+			"9e8615bdab5877ffe602afea945fefb99b7141e4",
+			"7526e79d7f16804418f4e7a01987c9f77eacb719"
+		},
+		{
+			"e036bc2fb967e96e6db3c93f09262a4def887697",
+			"711adee01a57d7950186f2c0e0c34f44da14e277",
+			"40258604361c7154f21b60bac2d4d2feca545046"
+		},
+	};
+
+	SCOPED_TRACE("709->2020");
+	run_test({ MatrixCoefficients::REC_709, TransferCharacteristics::REC_709, ColorPrimaries::REC_709 },
+	         { MatrixCoefficients::REC_2020_NCL, TransferCharacteristics::REC_709, ColorPrimaries::REC_2020 },
+	         expected_sha1[0], 70.0);
+	SCOPED_TRACE("rgb srgb->709 smpte_c");
+	run_test({ MatrixCoefficients::RGB, TransferCharacteristics::SRGB, ColorPrimaries::REC_709 },
+	         { MatrixCoefficients::REC_601, TransferCharacteristics::REC_709, ColorPrimaries::SMPTE_C },
+	         expected_sha1[1], 48.0);
+	SCOPED_TRACE("2020 st2084->ictcp");
+	run_test({ MatrixCoefficients::REC_2020_NCL, TransferCharacteristics::ST_2084, ColorPrimaries::REC_2020 },
+	         { MatrixCoefficients::REC_2100_ICTCP, TransferCharacteristics::ST_2084, ColorPrimaries::REC_2020 },
+	         expected_sha1[2], 60.0);
+}
+
+TEST(ColorspaceConversionTest, test_tone_mapping)
+{
+	using namespace zimg::colorspace;
+
+	const unsigned w = 640;
+	const unsigned h = 480;
+
+	const ColorspaceDefinition csp_in{ MatrixCoefficients::REC_2020_NCL, TransferCharacteristics::ST_2084, ColorPrimaries::REC_2020 };
+	const ColorspaceDefinition csp_out{ MatrixCoefficients::REC_709, TransferCharacteristics::REC_709, ColorPrimaries::REC_709 };
+
+	auto run_test = [=](ToneMapping tone_mapping, const char * const expected_sha1[3])
+	{
+		auto convert = ColorspaceConversion{ w, h }
+			.set_csp_in(csp_in)
+			.set_csp_out(csp_out)
+			.set_tone_mapping(tone_mapping)
+			.set_source_peak_luminance(1000.0)
+			.create();
+
+		zimg::PixelFormat format = zimg::PixelType::FLOAT;
+		FilterValidator validator{ convert.get(), w, h, format };
+		validator.set_sha1(expected_sha1)
+		         .set_yuv(true)
+		         .validate();
+	};
+
+	const char *expected_sha1[][3] = {
+		{
+			"224c1d48ee789df61ad19532986c21dd4d1ca62b",
+			"db8241b0bc18a91bbac05e26853847320871651d",
+			"94578cb4d372080925401db72600a2fe2677dbad"
+		},
+		{
+			"f982068f83ff521a86b258ccd0f653f4463b036a",
+			"1f4d0f0fb2ee4cfa5cbc10236f6e1166f4f33e8b",
+			"3005243863b8f771a60b7c3258668f19d9a87732"
+		},
+		{
+			"19db459a88169034993452dc0ffba038fc549861",
+			"6d46fab0205a0cc40bce11eec807225ff50a7da8",
+			"e9ce0b60af72f56848d3fe7a097db9eead0777a4"
+		},
+	};
+
+	SCOPED_TRACE("bt2390");
+	run_test(ToneMapping::BT2390, expected_sha1[0]);
+	SCOPED_TRACE("hable");
+	run_test(ToneMapping::HABLE, expected_sha1[1]);
+	SCOPED_TRACE("reinhard");
+	run_test(ToneMapping::REINHARD, expected_sha1[2]);
+}
+
+TEST(ColorspaceConversionTest, test_integer_input)
+{
+	using namespace zimg::colorspace;
+
+	const unsigned w = 640;
+	const unsigned h = 480;
+
+	auto run_test = [=](const ColorspaceDefinition &csp_in, const ColorspaceDefinition &csp_out, const zimg::PixelFormat &format, const char * const expected_sha1[3])
+	{
+		auto convert = ColorspaceConversion{ w, h }
+			.set_csp_in(csp_in)
+			.set_csp_out(csp_out)
+			.set_pixel_in(format)
+			.create();
+
+		FilterValidator validator{ convert.get(), w, h, format };
+		validator.set_sha1(expected_sha1)
+		         .validate();
+	};
+
+	const ColorspaceDefinition csp_gamma{ MatrixCoefficients::RGB, TransferCharacteristics::REC_709, ColorPrimaries::REC_709 };
+	const ColorspaceDefinition csp_st2084{ MatrixCoefficients::RGB, TransferCharacteristics::ST_2084, ColorPrimaries::REC_2020 };
+
+	const char *expected_sha1[][3] = {
+		{
+			"aa9b040279872c887a1e9a5c417685e669a4b473",
+			"9862a9659a7e5092cf38552330cf7bba5f1a445c",
+			"19fd0aa66aa2dc14b6a03a87d72eddf349f014e3"
+		},
+		{
+			"f6ddfdefe77ab0af18d20e4f56c9661651ce1386",
+			"02481013d7211eebf15ebdc8d3fcb1b48db894d3",
+			"4d46efd090fc1b5b1d3eecd3edaeb43f99927ac2"
+		},
+		{
+			"3f2650a2aceefd6123dc48ded08941373bf71173",
+			"806c6bfb06d1c792b706e04c47d4385c3230aeb8",
+			"3d6c9990dc7dc15dd41d91dc4b490569dfeab58f"
+		},
+		{
+			"2054ddc482bde42bacd16be918e02ed6c6a85eec",
+			"0a0aff57d9a060d38d4034c00bf31334374e7e06",
+			"1d05a38f813febabba4de63eb1f2f05a9ecd2054"
+		},
+	};
+
+	SCOPED_TRACE("byte gamma->linear");
+	run_test(csp_gamma, csp_gamma.to_linear(), { zimg::PixelType::BYTE, 8, true }, expected_sha1[0]);
+	SCOPED_TRACE("word gamma->linear");
+	run_test(csp_gamma, csp_gamma.to_linear(), { zimg::PixelType::WORD, 10, false }, expected_sha1[1]);
+	SCOPED_TRACE("word st2084->709");
+	run_test(csp_st2084, csp_gamma, { zimg::PixelType::WORD, 12, false }, expected_sha1[2]);
+	SCOPED_TRACE("byte rgb->709");
+	run_test(csp_gamma, csp_gamma.to(MatrixCoefficients::REC_709), { zimg::PixelType::BYTE, 8, false }, expected_sha1[3]);
+}
@@ -0,0 +1,76 @@
+#include <cmath>
+
+#include "colorspace/colorspace.h"
+#include "colorspace/gamma.h"
+#include "colorspace/tonemap.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+void test_curve(zimg::colorspace::ToneMapping method, double source_peak, double target_peak)
+{
+	zimg::colorspace::EnsureSinglePrecision x87;
+
+	const unsigned long STEPS = 1UL << 16;
+
+	zimg::colorspace::ToneMapCurve curve = zimg::colorspace::select_tone_map_curve(method, source_peak, target_peak);
+	float peak = static_cast<float>(source_peak / target_peak);
+	float cur = 0.0f;
+
+	// Allow for rounding in the ST.2084 transfer functions.
+	const float tolerance = 1e-4f;
+
+	EXPECT_NEAR(1.0f, peak * zimg::colorspace::tone_map_gain(curve, peak), 1e-5f);
+	EXPECT_NEAR(1.0f, 2.0f * peak * zimg::colorspace::tone_map_gain(curve, 2.0f * peak), 1e-5f);
+	EXPECT_FALSE(std::isnan(zimg::colorspace::tone_map_gain(curve, 0.0f)));
+	EXPECT_FALSE(std::isnan(zimg::colorspace::tone_map_gain(curve, NAN)));
+
+	for (unsigned long i = 1; i <= STEPS; ++i) {
+		float x = i * (peak / STEPS);
+		float y = x * zimg::colorspace::tone_map_gain(curve, x);
+		ASSERT_FALSE(std::isnan(y)) << " x=" << x << " i=" << i;
+		ASSERT_GE(y, cur - tolerance) << " x=" << x << " i=" << i;
+		ASSERT_LE(y, 1.0f + tolerance) << " x=" << x << " i=" << i;
+		cur = y;
+	}
+}
+
+} // namespace
+
+
+TEST(ToneMapTest, test_bt2390)
+{
+	SCOPED_TRACE("1000/100");
+	test_curve(zimg::colorspace::ToneMapping::BT2390, 1000.0, 100.0);
+	SCOPED_TRACE("4000/203");
+	test_curve(zimg::colorspace::ToneMapping::BT2390, 4000.0, 203.0);
+	SCOPED_TRACE("10000/100");
+	test_curve(zimg::colorspace::ToneMapping::BT2390, 10000.0, 100.0);
+
+	// The curve is the identity below the knee.
+	zimg::colorspace::ToneMapCurve curve = zimg::colorspace::select_tone_map_curve(zimg::colorspace::ToneMapping::BT2390, 1000.0, 100.0);
+	EXPECT_GT(curve.knee_lin, 0.0f);
+	EXPECT_LT(curve.knee_lin, 1.0f);
+	EXPECT_EQ(1.0f, zimg::colorspace::tone_map_gain(curve, curve.knee_lin * 0.5f));
+	EXPECT_EQ(1.0f, zimg::colorspace::tone_map_gain(curve, 0.0f));
+}
+
+TEST(ToneMapTest, test_hable)
+{
+	SCOPED_TRACE("1000/100");
+	test_curve(zimg::colorspace::ToneMapping::HABLE, 1000.0, 100.0);
+	SCOPED_TRACE("4000/203");
+	test_curve(zimg::colorspace::ToneMapping::HABLE, 4000.0, 203.0);
+	SCOPED_TRACE("10000/100");
+	test_curve(zimg::colorspace::ToneMapping::HABLE, 10000.0, 100.0);
+}
+
+TEST(ToneMapTest, test_reinhard)
+{
+	SCOPED_TRACE("1000/100");
+	test_curve(zimg::colorspace::ToneMapping::REINHARD, 1000.0, 100.0);
+	SCOPED_TRACE("4000/203");
+	test_curve(zimg::colorspace::ToneMapping::REINHARD, 4000.0, 203.0);
+	SCOPED_TRACE("10000/100");
+	test_curve(zimg::colorspace::ToneMapping::REINHARD, 10000.0, 100.0);
+}
@@ -1,11 +1,16 @@
 #ifdef ZIMG_X86
 
+#include <algorithm>
 #include <cmath>
+#include "common/alloc.h"
 #include "common/cpuinfo.h"
 #include "common/pixel.h"
 #include "common/x86/cpuinfo_x86.h"
 #include "graph/image_filter.h"
 #include "colorspace/colorspace.h"
+#include "colorspace/gamma.h"
+#include "colorspace/operation.h"
+#include "colorspace/operation_impl.h"
 
 #include "gtest/gtest.h"
 #include "graph/filter_validator.h"
@@ -13,7 +18,7 @@
 namespace {
 
 void test_case(const zimg::colorspace::ColorspaceDefinition &csp_in, const zimg::colorspace::ColorspaceDefinition &csp_out,
-			   const char * const expected_sha1[3], double expected_snr)
+			   const char * const expected_sha1[3], double expected_snr, bool lut3d = false)
 {
 	const unsigned w = 640;
 	const unsigned h = 480;
@@ -27,7 +32,8 @@ void test_case(const zimg::colorspace::ColorspaceDefinition &csp_in, const zimg:
 	auto builder = zimg::colorspace::ColorspaceConversion{ w, h }
 		.set_csp_in(csp_in)
 		.set_csp_out(csp_out)
-		.set_approximate_gamma(true);
+		.set_approximate_gamma(true)
+		.set_approximate_colorspace(lut3d);
 
 	auto filter_c = builder.set_cpu(zimg::CPUClass::NONE).create();
 	auto filter_avx2 = builder.set_cpu(zimg::CPUClass::X86_AVX2).create();
@@ -39,6 +45,55 @@ void test_case(const zimg::colorspace::ColorspaceDefinition &csp_in, const zimg:
 	         .validate();
 }
 
+void test_lut_accuracy(zimg::colorspace::TransferCharacteristics transfer, zimg::CPUClass cpu, float tolinear_errthr, float togamma_errthr)
+{
+	using namespace zimg::colorspace;
+
+	const unsigned N = 1U << 16;
+
+	TransferFunction func = select_transfer_function(transfer, 100.0, false);
+	OperationParams params;
+	params.set_peak_luminance(100.0)
+	      .set_approximate_gamma(true)
+	      .set_scene_referred(false);
+
+	auto tolinear = create_inverse_gamma_operation(func, params, cpu);
+	auto togamma = create_gamma_operation(func, params, cpu);
+
+	zimg::AlignedVector<float> src(N);
+	zimg::AlignedVector<float> dst(N);
+	const float *src_p[3] = { src.data(), src.data(), src.data() };
+	float *dst_p[3] = { dst.data(), dst.data(), dst.data() };
+
+	// The thresholds include rounding in the single-precision reference, which
+	// dominates the interpolation error near the ST.2084 peak.
+	EnsureSinglePrecision x87;
+	float err = 0.0f;
+
+	for (unsigned i = 0; i < N; ++i) {
+		src[i] = static_cast<float>(i) / (N - 1);
+	}
+	tolinear->process(src_p, dst_p, 0, N);
+
+	for (unsigned i = 0; i < N; ++i) {
+		err = std::max(err, std::fabs(dst[i] / func.to_linear_scale - func.to_linear(src[i])));
+	}
+	EXPECT_LT(err, tolinear_errthr);
+
+	// Sample the nominal range uniformly and the lower end logarithmically.
+	for (unsigned i = 0; i < N; ++i) {
+		float x = i % 2 ? static_cast<float>(i) / (N - 1) : std::exp2(-24.0f * i / N);
+		src[i] = x / func.to_gamma_scale;
+	}
+	togamma->process(src_p, dst_p, 0, N);
+
+	err = 0.0f;
+	for (unsigned i = 0; i < N; ++i) {
+		err = std::max(err, std::fabs(dst[i] - func.to_gamma(src[i] * func.to_gamma_scale)));
+	}
+	EXPECT_LT(err, togamma_errthr);
+}
+
 } // namespace
 
 
@@ -48,28 +103,28 @@ TEST(ColorspaceConversionAVX2Test, test_transfer_lut)
 
 	const char *expected_sha1[][3] = {
 		{
-			"23d012fcb280f601e2e3c349229d0108e3cd632a",
-			"7ae186215d5fa45065f7aeac74ab2dc74b556696",
-			"bad84d4e0de8572c81df6d9f91fef05b1576f9e5"
+			"3ac21465994325deee1a40e0fa3c004fbc41c81f",
+			"b77f13bc9add6986fa89fe7b81f773e21e0b21c9",
+			"6181708f6635997995e992cc1d5e9c06e94416bc"
 		},
 		{
-			"011ee645ad30bb6ad6d93d8980d89a3e3e073c19",
-			"5ae0e075b3856d9f491954b477568b17daf7f147",
-			"84b20f8fa27c23a668540566b9df26c4b42c9afa"
+			"5307a8802e5880063b99dbcfa9cb21b96e999657",
+			"d4761e0ad93329e71ae2162607e7e8dc63970138",
+			"fe723d4049eeb8851288dbd2f42e6f37e8aae719"
 		},
 		{
-			"8206be2ae5e8a0fc003daeec4178189eecf82a13",
-			"24843f17600dd7bf9870f5c778549bd96c333427",
-			"26a6b00801b41da17d849e02217bf69add6324a6"
+			"cb69dc5acfe552f8b2fae874f1c349543b3949dd",
+			"dcae3f877e785179ec0d13d64aaa575c53f2453c",
+			"60017f48ac2fb7661e6c402cff07c4efad5a9f57"
 		},
 		{
-			"16f2274ffac90927de0438114f0ea22e650981a0",
-			"b1c8b15b6159ab43e7bfc4e715fe3b621628d26e",
-			"632ae07d6919533c87d2ed28560a60cf070498e2"
+			"f97ec96e6aba2b18f4e0d7e1a0232e29466a1a86",
+			"080063d669baa27154566a64195493d14a3444d0",
+			"a82ad1b67471c7fa029fbf0f6382bafa200e3614"
 		},
 	};
-	const double expected_tolinear_snr = 80.0;
-	const double expected_togamma_snr = 80.0;
+	const double expected_tolinear_snr = 90.0;
+	const double expected_togamma_snr = 110.0;
 
 	SCOPED_TRACE("tolinear 709");
 	test_case({ MatrixCoefficients::RGB, TransferCharacteristics::REC_709, ColorPrimaries::UNSPECIFIED },
@@ -89,4 +144,351 @@ TEST(ColorspaceConversionAVX2Test, test_transfer_lut)
 	          expected_sha1[3], expected_togamma_snr);
 }
 
+TEST(ColorspaceConversionAVX2Test, test_transfer_lut_accuracy)
+{
+	using namespace zimg::colorspace;
+
+	if (!zimg::query_x86_capabilities().avx2) {
+		SUCCEED() << "avx2 not available, skipping";
+		return;
+	}
+
+	SCOPED_TRACE("709");
+	test_lut_accuracy(TransferCharacteristics::REC_709, zimg::CPUClass::X86_AVX2, 1e-6f, 2e-6f);
+	SCOPED_TRACE("srgb");
+	test_lut_accuracy(TransferCharacteristics::SRGB, zimg::CPUClass::X86_AVX2, 1e-6f, 2e-6f);
+	SCOPED_TRACE("st2084");
+	test_lut_accuracy(TransferCharacteristics::ST_2084, zimg::CPUClass::X86_AVX2, 2e-4f, 1e-5f);
+}
+
+TEST(ColorspaceConversionAVX2Test, test_fused_gamma)
+{
+	using namespace zimg::colorspace;
+
+	const unsigned w = 640;
+	const unsigned h = 480;
+
+	if (!zimg::query_x86_capabilities().avx2) {
+		SUCCEED() << "avx2 not available, skipping";
+		return;
+	}
+
+	// Fusing the transfer function with the adjacent matrices must not change
+	// the result. The expected hashes are those of the separate operations.
+	auto run_test = [=](const ColorspaceDefinition &csp_in, const ColorspaceDefinition &csp_out, const char * const expected_sha1[3])
+	{
+		auto filter = ColorspaceConversion{ w, h }
+			.set_csp_in(csp_in)
+			.set_csp_out(csp_out)
+			.set_approximate_gamma(true)
+			.set_cpu(zimg::CPUClass::X86_AVX2)
+			.create();
+
+		zimg::PixelFormat format = zimg::PixelType::FLOAT;
+		FilterValidator validator{ filter.get(), w, h, format };
+		validator.set_sha1(expected_sha1)
+		         .set_yuv(csp_in.matrix != MatrixCoefficients::RGB)
+		         .validate();
+	};
+
+	const char *expected_sha1[][3] = {
+		{
+			"1e82a0ff47cfa663fe774417889a0a8fb8e153e9",
+			"1ffc80e11c95e719c5bcf78f77da391dc06ee2a3",
+			"3fcd04ba7d9769963f9cc974239fd8d232d5c87c"
+		},
+		{
+			"0bd826b205bede27be268ecdbaea94d27e7fe15c",
+			"2a9538560cb7110cc99070f42feb2303fdf05576",
+			"27179ed3601717279b4f184a422f63f48db5ecad"
+		},
+		{
+			"de006c1b1bb25b14479295653343724b53b3f00b",
+			"e70784ba7720f2983e0ed4ce65a1b467d3d09b48",
+			"0304b121030d2bfb81066a1701fa5d9218ba1645"
+		},
+	};
+
+	SCOPED_TRACE("709 to 2020");
+	run_test({ MatrixCoefficients::REC_709, TransferCharacteristics::REC_709, ColorPrimaries::REC_709 },
+	         { MatrixCoefficients::REC_2020_NCL, TransferCharacteristics::REC_709, ColorPrimaries::REC_2020 },
+	         expected_sha1[0]);
+	SCOPED_TRACE("2020 st2084 to 709");
+	run_test({ MatrixCoefficients::REC_2020_NCL, TransferCharacteristics::ST_2084, ColorPrimaries::REC_2020 },
+	         { MatrixCoefficients::REC_709, TransferCharacteristics::REC_709, ColorPrimaries::REC_709 },
+	         expected_sha1[1]);
+	SCOPED_TRACE("srgb to 601");
+	run_test({ MatrixCoefficients::RGB, TransferCharacteristics::SRGB, ColorPrimaries::REC_709 },
+	         { MatrixCoefficients::REC_601, TransferCharacteristics::REC_709, ColorPrimaries::SMPTE_C },
+	         expected_sha1[2]);
+}
+
+TEST(ColorspaceConversionAVX2Test, test_arib_b67)
+{
+	using namespace zimg::colorspace;
+
+	const unsigned w = 640;
+	const unsigned h = 480;
+
+	if (!zimg::query_x86_capabilities().avx2) {
+		SUCCEED() << "avx2 not available, skipping";
+		return;
+	}
+
+	// The display-referred OOTF is only used without approximate gamma.
+	auto run_test = [=](const ColorspaceDefinition &csp_in, const ColorspaceDefinition &csp_out, const char * const expected_sha1[3], double expected_snr)
+	{
+		auto builder = ColorspaceConversion{ w, h }
+			.set_csp_in(csp_in)
+			.set_csp_out(csp_out);
+
+		auto filter_c = builder.set_cpu(zimg::CPUClass::NONE).create();
+		auto filter_avx2 = builder.set_cpu(zimg::CPUClass::X86_AVX2).create();
+
+		zimg::PixelFormat format = zimg::PixelType::FLOAT;
+		FilterValidator validator{ filter_avx2.get(), w, h, format };
+		validator.set_sha1(expected_sha1)
+		         .set_ref_filter(filter_c.get(), expected_snr)
+		         .set_yuv(false)
+		         .validate();
+	};
+
+	const char *expected_sha1[][3] = {
+		{
+			"5c1db5c9ec583626195e1b75ca49944200a9f0ff",
+			"7499876ad3a7bf9a88d8ce30bce92c670db5dc1d",
+			"da013785edcf2c0d60f8d7d7b7aea754136311e1"
+		},
+		{
+			"207a903feb89c703681796be2e76a8d61adfe211",
+			"d787ea8c31e067baa4815c4b66950a864f335c1e",
+			"ce9f7125f99fb5d5484a3667b61093727c09b426"
+		},
+	};
+	const double expected_tolinear_snr = 120.0;
+	const double expected_togamma_snr = 120.0;
+
+	SCOPED_TRACE("tolinear");
+	run_test({ MatrixCoefficients::RGB, TransferCharacteristics::ARIB_B67, ColorPrimaries::REC_2020 },
+	         { MatrixCoefficients::RGB, TransferCharacteristics::LINEAR, ColorPrimaries::REC_2020 },
+	         expected_sha1[0], expected_tolinear_snr);
+	SCOPED_TRACE("togamma");
+	run_test({ MatrixCoefficients::RGB, TransferCharacteristics::LINEAR, ColorPrimaries::REC_2020 },
+	         { MatrixCoefficients::RGB, TransferCharacteristics::ARIB_B67, ColorPrimaries::REC_2020 },
+	         expected_sha1[1], expected_togamma_snr);
+}
+
+TEST(ColorspaceConversionAVX2Test, test_constant_luminance)
+{
+	using namespace zimg::colorspace;
+
+	const unsigned w = 640;
+	const unsigned h = 480;
+
+	if (!zimg::query_x86_capabilities().avx2) {
+		SUCCEED() << "avx2 not available, skipping";
+		return;
+	}
+
+	auto run_test = [=](const ColorspaceDefinition &csp_in, const ColorspaceDefinition &csp_out, const char * const expected_sha1[3], double expected_snr)
+	{
+		auto builder = ColorspaceConversion{ w, h }
+			.set_csp_in(csp_in)
+			.set_csp_out(csp_out);
+
+		auto filter_c = builder.set_cpu(zimg::CPUClass::NONE).create();
+		auto filter_avx2 = builder.set_cpu(zimg::CPUClass::X86_AVX2).create();
+
+		zimg::PixelFormat format = zimg::PixelType::FLOAT;
+		FilterValidator validator{ filter_avx2.get(), w, h, format };
+		validator.set_sha1(expected_sha1)
+		         .set_ref_filter(filter_c.get(), expected_snr)
+		         .set_yuv(csp_in.matrix != MatrixCoefficients::RGB)
+		         .validate();
+	};
+
+	const char *expected_sha1[][3] = {
+		{
+			"e463351f184a7b0aba6d54d7c8fbfd560d48db4d",
+			"82a04b7a1aac9beba057c7faa33c4c1f30616c3e",
+			"574e6b91e3939964cfa6d86e31ad6a3324e7f875"
+		},
+		{
+			"f537a382b67ed9b398a9a5cc245ee3da276f17da",
+			"6b0db776b9d177ab118c43d39eb206b1a596170a",
+			"c2603b554046b21561e53bde54fdb8f68ffa575e"
+		},
+		{
+			"3d24031b1611d20bd6617fc2ce0c9370bcdf66eb",
+			"48d11776f1ba49e3f46348c5079bc1237afd78dc",
+			"a7d252febf022e0163792963a67374da8fc2c879"
+		},
+		{
+			"226b868cc3cf424b9119728c0b4d10a52ed0cf63",
+			"909a8112de8e243695ac61c2b5285078b5ab8a52",
+			"880a8817525bd1958ce9fb65585b5a81575d2837"
+		},
+	};
+	const double expected_snr = 120.0;
+
+	SCOPED_TRACE("tolinear");
+	run_test({ MatrixCoefficients::REC_2020_CL, TransferCharacteristics::REC_709, ColorPrimaries::REC_2020 },
+	         { MatrixCoefficients::RGB, TransferCharacteristics::LINEAR, ColorPrimaries::REC_2020 },
+	         expected_sha1[0], expected_snr);
+	SCOPED_TRACE("togamma");
+	run_test({ MatrixCoefficients::RGB, TransferCharacteristics::LINEAR, ColorPrimaries::REC_2020 },
+	         { MatrixCoefficients::REC_2020_CL, TransferCharacteristics::REC_709, ColorPrimaries::REC_2020 },
+	         expected_sha1[1], expected_snr);
+	SCOPED_TRACE("tolinear srgb");
+	run_test({ MatrixCoefficients::CHROMATICITY_DERIVED_CL, TransferCharacteristics::SRGB, ColorPrimaries::REC_2020 },
+	         { MatrixCoefficients::RGB, TransferCharacteristics::LINEAR, ColorPrimaries::REC_2020 },
+	         expected_sha1[2], expected_snr);
+	SCOPED_TRACE("togamma srgb");
+	run_test({ MatrixCoefficients::RGB, TransferCharacteristics::LINEAR, ColorPrimaries::REC_2020 },
+	         { MatrixCoefficients::CHROMATICITY_DERIVED_CL, TransferCharacteristics::SRGB, ColorPrimaries::REC_2020 },
+	         expected_sha1[3], expected_snr);
+}
+
+TEST(ColorspaceConversionAVX2Test, test_lut3d)
+{
+	using namespace zimg::colorspace;
+
+	const char *expected_sha1[][3] = {
+		{
+			"0106aaad21dcef24fd7bba79aec75ce8087c7735",
+			"a7d1c846374def7581e4b5a79d79b807e556a280",
+			"7d75974970e59433e4ce4951e77ab96fa976e59d"
+		},
+		{
+			"8d956e949692938c7399f57457db34af7b75b634",
+			"eee422c8a93f58eea7bdaf3885ec939d40959f18",
+			"762a58cfe2c885ad463a0ae3ff894ae203067401"
+		},
+	};
+	const double expected_snr = 120.0;
+
+	SCOPED_TRACE("709->2020");
+	test_case({ MatrixCoefficients::REC_709, TransferCharacteristics::REC_709, ColorPrimaries::REC_709 },
+	          { MatrixCoefficients::REC_2020_NCL, TransferCharacteristics::REC_709, ColorPrimaries::REC_2020 },
+	          expected_sha1[0], expected_snr, true);
+	SCOPED_TRACE("2020 st2084->ictcp");
+	test_case({ MatrixCoefficients::REC_2020_NCL, TransferCharacteristics::ST_2084, ColorPrimaries::REC_2020 },
+	          { MatrixCoefficients::REC_2100_ICTCP, TransferCharacteristics::ST_2084, ColorPrimaries::REC_2020 },
+	          expected_sha1[1], expected_snr, true);
+}
+
+TEST(ColorspaceConversionAVX2Test, test_tone_mapping)
+{
+	using namespace zimg::colorspace;
+
+	const unsigned w = 640;
+	const unsigned h = 480;
+
+	if (!zimg::query_x86_capabilities().avx2) {
+		SUCCEED() << "avx2 not available, skipping";
+		return;
+	}
+
+	const ColorspaceDefinition csp_in{ MatrixCoefficients::REC_2020_NCL, TransferCharacteristics::ST_2084, ColorPrimaries::REC_2020 };
+	const ColorspaceDefinition csp_out{ MatrixCoefficients::REC_709, TransferCharacteristics::REC_709, ColorPrimaries::REC_709 };
+
+	auto run_test = [=](ToneMapping tone_mapping, const char * const expected_sha1[3], double expected_snr)
+	{
+		auto builder = ColorspaceConversion{ w, h }
+			.set_csp_in(csp_in)
+			.set_csp_out(csp_out)
+			.set_tone_mapping(tone_mapping)
+			.set_source_peak_luminance(1000.0);
+
+		auto filter_c = builder.set_cpu(zimg::CPUClass::NONE).create();
+		auto filter_avx2 = builder.set_cpu(zimg::CPUClass::X86_AVX2).create();
+
+		zimg::PixelFormat format = zimg::PixelType::FLOAT;
+		FilterValidator validator{ filter_avx2.get(), w, h, format };
+		validator.set_sha1(expected_sha1)
+		         .set_ref_filter(filter_c.get(), expected_snr)
+		         .set_yuv(true)
+		         .validate();
+	};
+
+	const char *expected_sha1[][3] = {
+		{
+			"583533a24e989f53bec1645a69367c70f713f3eb",
+			"47bc994d0f16e6e3eabb0b35cbc952ef7fce4d13",
+			"bf6ee070c5fdcb666d33663038af6208fe550eac"
+		},
+		{
+			"dd3c9f38ab9d1b43edd3bca015b8c41e26fb3d26",
+			"f9fda46965c0bf5983ff1c7424cb31e7c55880ee",
+			"4de966250395e7eb3fe40195c666e5c6160c3ee3"
+		},
+		{
+			"3b0842e272dde65e81584d5a92df27c5d1c6939b",
+			"8f1f742bce5c2c8728f4f543fdb9dfbf04404e63",
+			"6faf37121b028ce7abef1fffdea2c3eaefe5f9e8"
+		},
+	};
+	const double expected_snr = 80.0;
+
+	SCOPED_TRACE("bt2390");
+	run_test(ToneMapping::BT2390, expected_sha1[0], expected_snr);
+	SCOPED_TRACE("hable");
+	run_test(ToneMapping::HABLE, expected_sha1[1], expected_snr);
+	SCOPED_TRACE("reinhard");
+	run_test(ToneMapping::REINHARD, expected_sha1[2], expected_snr);
+}
+
+TEST(ColorspaceConversionAVX2Test, test_half)
+{
+	using namespace zimg::colorspace;
+
+	const unsigned w = 640;
+	const unsigned h = 480;
+
+	if (!zimg::query_x86_capabilities().avx2) {
+		SUCCEED() << "avx2 not available, skipping";
+		return;
+	}
+
+	// No half-precision implementation is available in C. Make sure to visually check results if they differ from hash.
+	auto run_test = [=](const ColorspaceDefinition &csp_in, const ColorspaceDefinition &csp_out, const char * const expected_sha1[3])
+	{
+		auto filter = ColorspaceConversion{ w, h }
+			.set_csp_in(csp_in)
+			.set_csp_out(csp_out)
+			.set_approximate_gamma(true)
+			.set_pixel_in(zimg::PixelType::HALF)
+			.set_cpu(zimg::CPUClass::X86_AVX2)
+			.create();
+
+		zimg::PixelFormat format = zimg::PixelType::HALF;
+		FilterValidator validator{ filter.get(), w, h, format };
+		validator.set_sha1(expected_sha1)
+		         .set_yuv(csp_in.matrix != MatrixCoefficients::RGB)
+		         .validate();
+	};
+
+	const char *expected_sha1[][3] = {
+		{
+			"8e28e5d32c243966706bc7e7019b836d587c9110",
+			"7337d722d12a9ca1913db64809333f0a8620b814",
+			"5fea6d3d0ce01e09daea2b46f2311b0d262225b9"
+		},
+		{
+			"ee76e080c4a084ed7a2261006c358762412f3b3f",
+			"aae0e7080ffd65d54d2333d90b6d6d2027575f5d",
+			"7086be517f14cd85220501a264e4f936fc06582c"
+		},
+	};
+
+	SCOPED_TRACE("709 yuv->rgb");
+	run_test({ MatrixCoefficients::REC_709, TransferCharacteristics::REC_709, ColorPrimaries::REC_709 },
+	         { MatrixCoefficients::RGB, TransferCharacteristics::REC_709, ColorPrimaries::REC_709 },
+	         expected_sha1[0]);
+	SCOPED_TRACE("2020 st2084->709");
+	run_test({ MatrixCoefficients::REC_2020_NCL, TransferCharacteristics::ST_2084, ColorPrimaries::REC_2020 },
+	         { MatrixCoefficients::REC_709, TransferCharacteristics::REC_709, ColorPrimaries::REC_709 },
+	         expected_sha1[1]);
+}
+
 #endif // ZIMG_X86
@@ -13,7 +13,7 @@
 namespace {
 
 void test_case(const zimg::colorspace::ColorspaceDefinition &csp_in, const zimg::colorspace::ColorspaceDefinition &csp_out,
-               const char * const expected_sha1[3], double expected_snr)
+               const char * const expected_sha1[3], double expected_snr, bool lut3d = false)
 {
 	const unsigned w = 640;
 	const unsigned h = 480;
@@ -27,7 +27,8 @@ void test_case(const zimg::colorspace::ColorspaceDefinition &csp_in, const zimg:
 	auto builder = zimg::colorspace::ColorspaceConversion{ w, h }
 		.set_csp_in(csp_in)
 		.set_csp_out(csp_out)
-		.set_approximate_gamma(true);
+		.set_approximate_gamma(true)
+		.set_approximate_colorspace(lut3d);
 
 	auto filter_c = builder.set_cpu(zimg::CPUClass::NONE).create();
 	auto filter_avx512 = builder.set_cpu(zimg::CPUClass::X86_AVX512).create();
@@ -145,4 +146,334 @@ TEST(ColorspaceConversionAVX512Test, test_transfer_st_2084)
 	          expected_sha1[1], expected_togamma_snr);
 }
 
+TEST(ColorspaceConversionAVX512Test, test_fused_gamma)
+{
+	using namespace zimg::colorspace;
+
+	const unsigned w = 640;
+	const unsigned h = 480;
+
+	if (!zimg::query_x86_capabilities().avx512f) {
+		SUCCEED() << "avx512 not available, skipping";
+		return;
+	}
+
+	// Fusing the transfer function with the adjacent matrices must not change
+	// the result. The expected hashes are those of the separate operations.
+	auto run_test = [=](const ColorspaceDefinition &csp_in, const ColorspaceDefinition &csp_out, const char * const expected_sha1[3])
+	{
+		auto filter = ColorspaceConversion{ w, h }
+			.set_csp_in(csp_in)
+			.set_csp_out(csp_out)
+			.set_approximate_gamma(true)
+			.set_cpu(zimg::CPUClass::X86_AVX512)
+			.create();
+
+		zimg::PixelFormat format = zimg::PixelType::FLOAT;
+		FilterValidator validator{ filter.get(), w, h, format };
+		validator.set_sha1(expected_sha1)
+		         .set_yuv(csp_in.matrix != MatrixCoefficients::RGB)
+		         .validate();
+	};
+
+	const char *expected_sha1[][3] = {
+		{
+			"31ef17f306f3bf6a9426db9f2e99730bb1b292d2",
+			"7c3cdce54ec9e217c9a4f77bcb90880be14a21ba",
+			"803ece094bb6be3506a7cc2b8e03a1a4de11cc94"
+		},
+		{
+			"7850a8e6cb5055a047cf7d0557f969c676094436",
+			"188db855910b91a23d23ebaed5c7fcaef931b79d",
+			"e95de0049b380a308a80f569bb63d6b3f265dfa2"
+		},
+		{
+			"17396c82dd2cbf52db1c5a9a012404da982998b6",
+			"5c41a8e17ed1ab275dc45762c2737b78d302b769",
+			"2e029e6d1d0d63d04497fc79681ad1ce162dc977"
+		},
+	};
+
+	SCOPED_TRACE("709 to 2020");
+	run_test({ MatrixCoefficients::REC_709, TransferCharacteristics::REC_709, ColorPrimaries::REC_709 },
+	         { MatrixCoefficients::REC_2020_NCL, TransferCharacteristics::REC_709, ColorPrimaries::REC_2020 },
+	         expected_sha1[0]);
+	SCOPED_TRACE("2020 st2084 to 709");
+	run_test({ MatrixCoefficients::REC_2020_NCL, TransferCharacteristics::ST_2084, ColorPrimaries::REC_2020 },
+	         { MatrixCoefficients::REC_709, TransferCharacteristics::REC_709, ColorPrimaries::REC_709 },
+	         expected_sha1[1]);
+	SCOPED_TRACE("srgb to 601");
+	run_test({ MatrixCoefficients::RGB, TransferCharacteristics::SRGB, ColorPrimaries::REC_709 },
+	         { MatrixCoefficients::REC_601, TransferCharacteristics::REC_709, ColorPrimaries::SMPTE_C },
+	         expected_sha1[2]);
+}
+
+TEST(ColorspaceConversionAVX512Test, test_arib_b67)
+{
+	using namespace zimg::colorspace;
+
+	const unsigned w = 640;
+	const unsigned h = 480;
+
+	if (!zimg::query_x86_capabilities().avx512f) {
+		SUCCEED() << "avx512 not available, skipping";
+		return;
+	}
+
+	// The display-referred OOTF is only used without approximate gamma.
+	auto run_test = [=](const ColorspaceDefinition &csp_in, const ColorspaceDefinition &csp_out, const char * const expected_sha1[3], double expected_snr)
+	{
+		auto builder = ColorspaceConversion{ w, h }
+			.set_csp_in(csp_in)
+			.set_csp_out(csp_out);
+
+		auto filter_c = builder.set_cpu(zimg::CPUClass::NONE).create();
+		auto filter_avx512 = builder.set_cpu(zimg::CPUClass::X86_AVX512).create();
+
+		zimg::PixelFormat format = zimg::PixelType::FLOAT;
+		FilterValidator validator{ filter_avx512.get(), w, h, format };
+		validator.set_sha1(expected_sha1)
+		         .set_ref_filter(filter_c.get(), expected_snr)
+		         .set_yuv(false)
+		         .validate();
+	};
+
+	const char *expected_sha1[][3] = {
+		{
+			"5c1db5c9ec583626195e1b75ca49944200a9f0ff",
+			"7499876ad3a7bf9a88d8ce30bce92c670db5dc1d",
+			"da013785edcf2c0d60f8d7d7b7aea754136311e1"
+		},
+		{
+			"207a903feb89c703681796be2e76a8d61adfe211",
+			"d787ea8c31e067baa4815c4b66950a864f335c1e",
+			"ce9f7125f99fb5d5484a3667b61093727c09b426"
+		},
+	};
+	const double expected_tolinear_snr = 120.0;
+	const double expected_togamma_snr = 120.0;
+
+	SCOPED_TRACE("tolinear");
+	run_test({ MatrixCoefficients::RGB, TransferCharacteristics::ARIB_B67, ColorPrimaries::REC_2020 },
+	         { MatrixCoefficients::RGB, TransferCharacteristics::LINEAR, ColorPrimaries::REC_2020 },
+	         expected_sha1[0], expected_tolinear_snr);
+	SCOPED_TRACE("togamma");
+	run_test({ MatrixCoefficients::RGB, TransferCharacteristics::LINEAR, ColorPrimaries::REC_2020 },
+	         { MatrixCoefficients::RGB, TransferCharacteristics::ARIB_B67, ColorPrimaries::REC_2020 },
+	         expected_sha1[1], expected_togamma_snr);
+}
+
+TEST(ColorspaceConversionAVX512Test, test_constant_luminance)
+{
+	using namespace zimg::colorspace;
+
+	const unsigned w = 640;
+	const unsigned h = 480;
+
+	if (!zimg::query_x86_capabilities().avx512f) {
+		SUCCEED() << "avx512f not available, skipping";
+		return;
+	}
+
+	auto run_test = [=](const ColorspaceDefinition &csp_in, const ColorspaceDefinition &csp_out, const char * const expected_sha1[3], double expected_snr)
+	{
+		auto builder = ColorspaceConversion{ w, h }
+			.set_csp_in(csp_in)
+			.set_csp_out(csp_out);
+
+		auto filter_c = builder.set_cpu(zimg::CPUClass::NONE).create();
+		auto filter_avx512 = builder.set_cpu(zimg::CPUClass::X86_AVX512).create();
+
+		zimg::PixelFormat format = zimg::PixelType::FLOAT;
+		FilterValidator validator{ filter_avx512.get(), w, h, format };
+		validator.set_sha1(expected_sha1)
+		         .set_ref_filter(filter_c.get(), expected_snr)
+		         .set_yuv(csp_in.matrix != MatrixCoefficients::RGB)
+		         .validate();
+	};
+
+	const char *expected_sha1[][3] = {
+		{
+			"e463351f184a7b0aba6d54d7c8fbfd560d48db4d",
+			"82a04b7a1aac9beba057c7faa33c4c1f30616c3e",
+			"574e6b91e3939964cfa6d86e31ad6a3324e7f875"
+		},
+		{
+			"f537a382b67ed9b398a9a5cc245ee3da276f17da",
+			"6b0db776b9d177ab118c43d39eb206b1a596170a",
+			"c2603b554046b21561e53bde54fdb8f68ffa575e"
+		},
+		{
+			"3d24031b1611d20bd6617fc2ce0c9370bcdf66eb",
+			"48d11776f1ba49e3f46348c5079bc1237afd78dc",
+			"a7d252febf022e0163792963a67374da8fc2c879"
+		},
+		{
+			"226b868cc3cf424b9119728c0b4d10a52ed0cf63",
+			"909a8112de8e243695ac61c2b5285078b5ab8a52",
+			"880a8817525bd1958ce9fb65585b5a81575d2837"
+		},
+	};
+	const double expected_snr = 120.0;
+
+	SCOPED_TRACE("tolinear");
+	run_test({ MatrixCoefficients::REC_2020_CL, TransferCharacteristics::REC_709, ColorPrimaries::REC_2020 },
+	         { MatrixCoefficients::RGB, TransferCharacteristics::LINEAR, ColorPrimaries::REC_2020 },
+	         expected_sha1[0], expected_snr);
+	SCOPED_TRACE("togamma");
+	run_test({ MatrixCoefficients::RGB, TransferCharacteristics::LINEAR, ColorPrimaries::REC_2020 },
+	         { MatrixCoefficients::REC_2020_CL, TransferCharacteristics::REC_709, ColorPrimaries::REC_2020 },
+	         expected_sha1[1], expected_snr);
+	SCOPED_TRACE("tolinear srgb");
+	run_test({ MatrixCoefficients::CHROMATICITY_DERIVED_CL, TransferCharacteristics::SRGB, ColorPrimaries::REC_2020 },
+	         { MatrixCoefficients::RGB, TransferCharacteristics::LINEAR, ColorPrimaries::REC_2020 },
+	         expected_sha1[2], expected_snr);
+	SCOPED_TRACE("togamma srgb");
+	run_test({ MatrixCoefficients::RGB, TransferCharacteristics::LINEAR, ColorPrimaries::REC_2020 },
+	         { MatrixCoefficients::CHROMATICITY_DERIVED_CL, TransferCharacteristics::SRGB, ColorPrimaries::REC_2020 },
+	         expected_sha1[3], expected_snr);
+}
+
+TEST(ColorspaceConversionAVX512Test, test_lut3d)
+{
+	using namespace zimg::colorspace;
+
+	const char *expected_sha1[][3] = {
+		{
+			"0106aaad21dcef24fd7bba79aec75ce8087c7735",
+			"a7d1c846374def7581e4b5a79d79b807e556a280",
+			"7d75974970e59433e4ce4951e77ab96fa976e59d"
+		},
+		{
+			"8d956e949692938c7399f57457db34af7b75b634",
+			"eee422c8a93f58eea7bdaf3885ec939d40959f18",
+			"762a58cfe2c885ad463a0ae3ff894ae203067401"
+		},
+	};
+	const double expected_snr = 120.0;
+
+	SCOPED_TRACE("709->2020");
+	test_case({ MatrixCoefficients::REC_709, TransferCharacteristics::REC_709, ColorPrimaries::REC_709 },
+	          { MatrixCoefficients::REC_2020_NCL, TransferCharacteristics::REC_709, ColorPrimaries::REC_2020 },
+	          expected_sha1[0], expected_snr, true);
+	SCOPED_TRACE("2020 st2084->ictcp");
+	test_case({ MatrixCoefficients::REC_2020_NCL, TransferCharacteristics::ST_2084, ColorPrimaries::REC_2020 },
+	          { MatrixCoefficients::REC_2100_ICTCP, TransferCharacteristics::ST_2084, ColorPrimaries::REC_2020 },
+	          expected_sha1[1], expected_snr, true);
+}
+
+TEST(ColorspaceConversionAVX512Test, test_tone_mapping)
+{
+	using namespace zimg::colorspace;
+
+	const unsigned w = 640;
+	const unsigned h = 480;
+
+	if (!zimg::query_x86_capabilities().avx512f) {
+		SUCCEED() << "avx512 not available, skipping";
+		return;
+	}
+
+	const ColorspaceDefinition csp_in{ MatrixCoefficients::REC_2020_NCL, TransferCharacteristics::ST_2084, ColorPrimaries::REC_2020 };
+	const ColorspaceDefinition csp_out{ MatrixCoefficients::REC_709, TransferCharacteristics::REC_709, ColorPrimaries::REC_709 };
+
+	auto run_test = [=](ToneMapping tone_mapping, const char * const expected_sha1[3], double expected_snr)
+	{
+		auto builder = ColorspaceConversion{ w, h }
+			.set_csp_in(csp_in)
+			.set_csp_out(csp_out)
+			.set_tone_mapping(tone_mapping)
+			.set_source_peak_luminance(1000.0);
+
+		auto filter_c = builder.set_cpu(zimg::CPUClass::NONE).create();
+		auto filter_avx512 = builder.set_cpu(zimg::CPUClass::X86_AVX512).create();
+
+		zimg::PixelFormat format = zimg::PixelType::FLOAT;
+		FilterValidator validator{ filter_avx512.get(), w, h, format };
+		validator.set_sha1(expected_sha1)
+		         .set_ref_filter(filter_c.get(), expected_snr)
+		         .set_yuv(true)
+		         .validate();
+	};
+
+	const char *expected_sha1[][3] = {
+		{
+			"e28044a5ac9973f8be0024bed689fb13ec32b735",
+			"84e39e23611c7742ced2e280e34b79cc0cd23347",
+			"ca4e7840139961dd799808a5bb0a27eca6bbb2fc"
+		},
+		{
+			"4eedb9f2700631ae967d4e7525aa4f5b3298818a",
+			"ca712ff612e0346289fc0c83159db4d823fa79e4",
+			"71e8e7606133264ba43eaf5c396b8100cfbc5cf5"
+		},
+		{
+			"6285f155991aadc887ca7ac512665244c7316971",
+			"ea02d5e7844558a0959373d2a0d0fa54cbbd9fc5",
+			"e5cdbcb66d098ff58926e54d23e082baa9170e80"
+		},
+	};
+	const double expected_snr = 80.0;
+
+	SCOPED_TRACE("bt2390");
+	run_test(ToneMapping::BT2390, expected_sha1[0], expected_snr);
+	SCOPED_TRACE("hable");
+	run_test(ToneMapping::HABLE, expected_sha1[1], expected_snr);
+	SCOPED_TRACE("reinhard");
+	run_test(ToneMapping::REINHARD, expected_sha1[2], expected_snr);
+}
+
+TEST(ColorspaceConversionAVX512Test, test_half)
+{
+	using namespace zimg::colorspace;
+
+	const unsigned w = 640;
+	const unsigned h = 480;
+
+	if (!zimg::cpu_has_avx512_f_dq_bw_vl(zimg::query_x86_capabilities())) {
+		SUCCEED() << "avx512 not available, skipping";
+		return;
+	}
+
+	// No half-precision implementation is available in C. Make sure to visually check results if they differ from hash.
+	auto run_test = [=](const ColorspaceDefinition &csp_in, const ColorspaceDefinition &csp_out, const char * const expected_sha1[3])
+	{
+		auto filter = ColorspaceConversion{ w, h }
+			.set_csp_in(csp_in)
+			.set_csp_out(csp_out)
+			.set_approximate_gamma(true)
+			.set_pixel_in(zimg::PixelType::HALF)
+			.set_cpu(zimg::CPUClass::X86_AVX512)
+			.create();
+
+		zimg::PixelFormat format = zimg::PixelType::HALF;
+		FilterValidator validator{ filter.get(), w, h, format };
+		validator.set_sha1(expected_sha1)
+		         .set_yuv(csp_in.matrix != MatrixCoefficients::RGB)
+		         .validate();
+	};
+
+	const char *expected_sha1[][3] = {
+		{
+			"c6645519d515a7370c722c4b97395b2d19b5b4b3",
+			"f340e28ff219cc96d1af38fac7bdd55ee1093b4c",
+			"5e705daf308f6fdd539e42f4b9b327fab225ec89"
+		},
+		{
+			"e12cf8e25b402eba01888f0696db29332990ed21",
+			"81864b2e95d40586cab335e380e2fb966d8041a1",
+			"f554c44cec33869d0ca63939b2faf5f7107acaf1"
+		},
+	};
+
+	SCOPED_TRACE("709 yuv->rgb");
+	run_test({ MatrixCoefficients::REC_709, TransferCharacteristics::REC_709, ColorPrimaries::REC_709 },
+	         { MatrixCoefficients::RGB, TransferCharacteristics::REC_709, ColorPrimaries::REC_709 },
+	         expected_sha1[0]);
+	SCOPED_TRACE("2020 st2084->709");
+	run_test({ MatrixCoefficients::REC_2020_NCL, TransferCharacteristics::ST_2084, ColorPrimaries::REC_2020 },
+	         { MatrixCoefficients::REC_709, TransferCharacteristics::REC_709, ColorPrimaries::REC_709 },
+	         expected_sha1[1]);
+}
+
 #endif // ZIMG_X86_AVX512
@@ -0,0 +1,134 @@
+#ifdef ZIMG_ARM
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include "common/alloc.h"
+#include "common/cpuinfo.h"
+#include "common/pixel.h"
+#include "common/arm/cpuinfo_arm.h"
+#include "graph/image_buffer.h"
+#include "graph/interleave.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+void test_case(zimg::PixelType type, unsigned num_components, unsigned shift)
+{
+	const unsigned w = 640;
+	const std::pair<unsigned, unsigned> ranges[] = { { 0, w }, { 3, w - 5 }, { w / 4 + 1, w / 2 - 1 } };
+	const zimg::graph::component_map components{ { 3, 1, 0, 2 } };
+	const size_t size = zimg::pixel_size(type);
+
+	if (!zimg::query_arm_capabilities().neon) {
+		SUCCEED() << "neon not available, skipping";
+		return;
+	}
+
+	zimg::graph::DeinterleaveFilter deinterleave_c{ w, 1, type, 0, components, num_components, shift, zimg::CPUClass::NONE };
+	zimg::graph::DeinterleaveFilter deinterleave_neon{ w, 1, type, 0, components, num_components, shift, zimg::CPUClass::ARM_NEON };
+	zimg::graph::InterleaveFilter interleave_c{ w, 1, type, 0, components, num_components, shift, zimg::CPUClass::NONE };
+	zimg::graph::InterleaveFilter interleave_neon{ w, 1, type, 0, components, num_components, shift, zimg::CPUClass::ARM_NEON };
+
+	zimg::AlignedVector<uint8_t> packed(w * num_components * size);
+	zimg::AlignedVector<uint8_t> planes[4];
+	zimg::AlignedVector<uint8_t> packed_c(packed.size());
+	zimg::AlignedVector<uint8_t> packed_neon(packed.size());
+	zimg::AlignedVector<uint8_t> planes_c[4];
+	zimg::AlignedVector<uint8_t> planes_neon[4];
+	std::mt19937 mt;
+
+	for (uint8_t &x : packed) {
+		x = static_cast<uint8_t>(mt());
+	}
+	for (unsigned p = 0; p < 4; ++p) {
+		planes[p].resize(w * size);
+		planes_c[p].resize(w * size);
+		planes_neon[p].resize(w * size);
+
+		for (uint8_t &x : planes[p]) {
+			x = static_cast<uint8_t>(mt());
+		}
+	}
+
+	zimg::graph::ColorImageBuffer<const void> packed_buf;
+	zimg::graph::ColorImageBuffer<const void> planes_buf;
+	zimg::graph::ColorImageBuffer<void> packed_c_buf;
+	zimg::graph::ColorImageBuffer<void> packed_neon_buf;
+	zimg::graph::ColorImageBuffer<void> planes_c_buf;
+	zimg::graph::ColorImageBuffer<void> planes_neon_buf;
+
+	packed_buf[0] = { packed.data(), 0, zimg::graph::BUFFER_MAX };
+	packed_c_buf[0] = { packed_c.data(), 0, zimg::graph::BUFFER_MAX };
+	packed_neon_buf[0] = { packed_neon.data(), 0, zimg::graph::BUFFER_MAX };
+	for (unsigned p = 0; p < 4; ++p) {
+		planes_buf[p] = { planes[p].data(), 0, zimg::graph::BUFFER_MAX };
+		planes_c_buf[p] = { planes_c[p].data(), 0, zimg::graph::BUFFER_MAX };
+		planes_neon_buf[p] = { planes_neon[p].data(), 0, zimg::graph::BUFFER_MAX };
+	}
+
+	for (const auto &range : ranges) {
+		SCOPED_TRACE(range.first);
+		SCOPED_TRACE(range.second);
+
+		std::fill(packed_c.begin(), packed_c.end(), 0xCD);
+		std::fill(packed_neon.begin(), packed_neon.end(), 0xCD);
+		for (unsigned p = 0; p < 4; ++p) {
+			std::fill(planes_c[p].begin(), planes_c[p].end(), 0xCD);
+			std::fill(planes_neon[p].begin(), planes_neon[p].end(), 0xCD);
+		}
+
+		deinterleave_c.process(nullptr, packed_buf, planes_c_buf, nullptr, 0, range.first, range.second);
+		deinterleave_neon.process(nullptr, packed_buf, planes_neon_buf, nullptr, 0, range.first, range.second);
+		interleave_c.process(nullptr, planes_buf, packed_c_buf, nullptr, 0, range.first, range.second);
+		interleave_neon.process(nullptr, planes_buf, packed_neon_buf, nullptr, 0, range.first, range.second);
+
+		for (unsigned p = 0; p < 4; ++p) {
+			ASSERT_EQ(planes_c[p], planes_neon[p]) << "plane " << p;
+		}
+		ASSERT_EQ(packed_c, packed_neon);
+	}
+}
+
+} // namespace
+
+
+TEST(InterleaveFilterNEONTest, test_interleave_b2)
+{
+	test_case(zimg::PixelType::BYTE, 2, 0);
+}
+
+TEST(InterleaveFilterNEONTest, test_interleave_b3)
+{
+	test_case(zimg::PixelType::BYTE, 3, 0);
+}
+
+TEST(InterleaveFilterNEONTest, test_interleave_b4)
+{
+	test_case(zimg::PixelType::BYTE, 4, 0);
+}
+
+TEST(InterleaveFilterNEONTest, test_interleave_w1)
+{
+	test_case(zimg::PixelType::WORD, 1, 6);
+}
+
+TEST(InterleaveFilterNEONTest, test_interleave_w2)
+{
+	test_case(zimg::PixelType::WORD, 2, 0);
+	test_case(zimg::PixelType::WORD, 2, 6);
+}
+
+TEST(InterleaveFilterNEONTest, test_interleave_w3)
+{
+	test_case(zimg::PixelType::WORD, 3, 0);
+}
+
+TEST(InterleaveFilterNEONTest, test_interleave_w4)
+{
+	test_case(zimg::PixelType::WORD, 4, 0);
+}
+
+#endif // ZIMG_ARM
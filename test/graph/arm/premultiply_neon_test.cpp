@@ -0,0 +1,34 @@
+#ifdef ZIMG_ARM
+
+#include "common/cpuinfo.h"
+#include "common/arm/cpuinfo_arm.h"
+#include "graph/premultiply_validator.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+void test_case(bool unpremultiply)
+{
+	if (!zimg::query_arm_capabilities().neon) {
+		SUCCEED() << "neon not available, skipping";
+		return;
+	}
+
+	validate_premultiply(zimg::CPUClass::ARM_NEON, unpremultiply);
+}
+
+} // namespace
+
+
+TEST(PremultiplyFilterNeonTest, test_premultiply)
+{
+	test_case(false);
+}
+
+TEST(PremultiplyFilterNeonTest, test_unpremultiply)
+{
+	test_case(true);
+}
+
+#endif // ZIMG_ARM
@@ -29,6 +29,7 @@ class FilterValidator {
 public:
 	FilterValidator(const zimg::graph::ImageFilter *test_filter, unsigned src_width, unsigned src_height, const zimg::PixelFormat &src_format);
 
+	// A HALF filter may be compared to a FLOAT reference filter.
 	FilterValidator &set_ref_filter(const zimg::graph::ImageFilter *ref_filter, double snr_thresh);
 	FilterValidator &set_sha1(const char * const sha1_str[3]);
 	FilterValidator &set_yuv(bool yuv);
@@ -57,6 +57,21 @@ public:
 	}
 };
 
+template <class T>
+class OutputRecordingFilter : public SplatFilter<T> {
+	mutable const void *m_output;
+public:
+	using SplatFilter<T>::SplatFilter;
+
+	const void *get_output() const { return m_output; }
+
+	void process(void *ctx, const zimg::graph::ImageBuffer<const void> *src, const zimg::graph::ImageBuffer<void> *dst, void *tmp, unsigned i, unsigned left, unsigned right) const override
+	{
+		m_output = dst[0].data();
+		SplatFilter<T>::process(ctx, src, dst, tmp, i, left, right);
+	}
+};
+
 } // namespace
 
 
@@ -260,6 +275,120 @@ TEST(FilterGraphTest, test_skip_plane)
 	}
 }
 
+TEST(FilterGraphTest, test_passthrough)
+{
+	const unsigned w = 640;
+	const unsigned h = 480;
+	const zimg::PixelType type = zimg::PixelType::FLOAT;
+
+	const uint8_t test_byte1 = 0xCD;
+	const uint8_t test_byte2 = 0xDD;
+
+	for (unsigned x = 0; x < 2; ++x) {
+		SCOPED_TRACE(!!x);
+
+		auto filter = std::make_shared<SplatFilter<float>>(w, h, type);
+		filter->set_input_val(test_byte1);
+		filter->set_output_val(test_byte2);
+
+		zimg::graph::FilterGraph graph;
+		node_id id = graph.add_source({ w, h, type }, 0, 0, enabled_planes(true));
+		node_id id_u = graph.attach_filter(filter, { invalid_id, id, invalid_id, invalid_id }, { false, true, false, false });
+		node_id id_v = graph.attach_filter(filter, { invalid_id, invalid_id, id, invalid_id }, { false, false, true, false });
+		graph.set_output({ id, id_u, id_v, invalid_id });
+
+		plane_mask passthrough = graph.get_passthrough_planes();
+		EXPECT_TRUE(passthrough[zimg::graph::PLANE_Y]);
+		EXPECT_FALSE(passthrough[zimg::graph::PLANE_U]);
+		EXPECT_FALSE(passthrough[zimg::graph::PLANE_V]);
+		EXPECT_FALSE(passthrough[zimg::graph::PLANE_A]);
+
+		AuditImage<float> src_image{ AuditBufferType::COLOR_YUV, w, h, type, 0, 0 };
+		AuditImage<float> dst_image{ AuditBufferType::COLOR_YUV, w, h, type, 0, 0 };
+		zimg::AlignedVector<char> tmp(graph.get_tmp_size());
+
+		src_image.set_fill_val(test_byte1);
+		src_image.default_fill();
+
+		// Second iteration writes the luma plane back to the input buffer.
+		zimg::graph::ColorImageBuffer<void> dst_buf = dst_image.as_write_buffer();
+		if (x)
+			dst_buf[zimg::graph::PLANE_Y] = src_image.as_write_buffer()[zimg::graph::PLANE_Y];
+
+		graph.process(src_image.as_read_buffer(), dst_buf, tmp.data(), nullptr, nullptr);
+
+		dst_image.set_fill_val(test_byte1, 0);
+		dst_image.set_fill_val(test_byte2, 1);
+		dst_image.set_fill_val(test_byte2, 2);
+
+		ASSERT_EQ(h * 2, filter->get_total_calls());
+
+		SCOPED_TRACE("validating src");
+		src_image.validate();
+		SCOPED_TRACE("validating dst");
+		dst_image.validate();
+	}
+}
+
+TEST(FilterGraphTest, test_planar_uv)
+{
+	const unsigned w = 640;
+	const unsigned h = 480;
+	const zimg::PixelType type = zimg::PixelType::WORD;
+
+	const uint8_t test_byte1 = 0xCD;
+	const uint8_t test_byte2 = 0xDD;
+	const uint8_t test_byte3 = 0xDE;
+
+	zimg::graph::ImageFilter::filter_flags flags{};
+	flags.has_state = true;
+	flags.color = true;
+
+	auto filter_uv = std::make_shared<SplatFilter<uint16_t>>(w / 2, h / 2, type, flags);
+	filter_uv->set_input_val(test_byte1);
+	filter_uv->set_output_val(test_byte2);
+	filter_uv->set_vertical_support(2);
+	filter_uv->set_first_plane(1);
+
+	flags.color = false;
+
+	auto filter = std::make_shared<SplatFilter<uint16_t>>(w / 2, h / 2, type, flags);
+	filter->set_input_val(test_byte2);
+	filter->set_output_val(test_byte3);
+	filter->set_vertical_support(1);
+
+	zimg::graph::FilterGraph graph;
+	node_id id = graph.add_source({ w, h, type }, 1, 1, enabled_planes(true));
+	node_id id_uv = graph.attach_filter(filter_uv, { invalid_id, id, id, invalid_id }, { false, true, true, false });
+	node_id id_u = graph.attach_filter(filter, { invalid_id, id_uv, invalid_id, invalid_id }, { false, true, false, false });
+	node_id id_v = graph.attach_filter(filter, { invalid_id, invalid_id, id_uv, invalid_id }, { false, false, true, false });
+	graph.set_output({ id, id_u, id_v, invalid_id });
+
+	ASSERT_TRUE(graph.is_planar());
+
+	AuditImage<uint16_t> src_image{ AuditBufferType::COLOR_YUV, w, h, type, 1, 1 };
+	AuditImage<uint16_t> dst_image{ AuditBufferType::COLOR_YUV, w, h, type, 1, 1 };
+	zimg::AlignedVector<char> tmp(graph.get_tmp_size());
+
+	src_image.set_fill_val(test_byte1);
+	src_image.default_fill();
+
+	graph.process(src_image.as_read_buffer(), dst_image.as_write_buffer(), tmp.data(), nullptr, nullptr);
+
+	dst_image.set_fill_val(test_byte1, 0);
+	dst_image.set_fill_val(test_byte3, 1);
+	dst_image.set_fill_val(test_byte3, 2);
+
+	// The U+V node runs once per row, although both planes depend on it.
+	ASSERT_EQ(h / 2, filter_uv->get_total_calls());
+	ASSERT_EQ(h, filter->get_total_calls());
+
+	SCOPED_TRACE("validating src");
+	src_image.validate();
+	SCOPED_TRACE("validating dst");
+	dst_image.validate();
+}
+
 TEST(FilterGraphTest, test_color_to_grey)
 {
 	const unsigned w = 640;
@@ -303,6 +432,51 @@ TEST(FilterGraphTest, test_color_to_grey)
 	dst_image.validate();
 }
 
+TEST(FilterGraphTest, test_color_to_grey_direct)
+{
+	const unsigned w = 640;
+	const unsigned h = 480;
+	const zimg::PixelType type = zimg::PixelType::BYTE;
+
+	const uint8_t test_byte1 = 0xCD;
+	const uint8_t test_byte2 = 0xDC;
+
+	zimg::graph::ImageFilter::filter_flags flags{};
+	flags.color = true;
+
+	auto filter = std::make_shared<OutputRecordingFilter<uint8_t>>(w, h, type, flags);
+	filter->set_input_val(test_byte1);
+	filter->set_output_val(test_byte2);
+
+	zimg::graph::FilterGraph graph;
+	node_id id = graph.add_source({ w, h, type }, 0, 0, enabled_planes(true));
+
+	id = graph.attach_filter(filter, id_to_map(id, true), enabled_planes(true));
+	graph.set_output(id_to_map(id, false));
+
+	AuditImage<uint8_t> src_image{ AuditBufferType::COLOR_YUV, w, h, type, 0, 0 };
+	AuditImage<uint8_t> dst_image{ AuditBufferType::PLANE, w, h, type, 0, 0 };
+	zimg::AlignedVector<char> tmp(graph.get_tmp_size());
+
+	src_image.set_fill_val(test_byte1);
+	src_image.default_fill();
+
+	auto dst_buf = dst_image.as_write_buffer();
+	graph.process(src_image.as_read_buffer(), dst_buf, tmp.data(), nullptr, nullptr);
+
+	// The unused chroma planes must not require an intermediate copy of the luma plane.
+	EXPECT_EQ(dst_buf[0].data(), filter->get_output());
+
+	dst_image.set_fill_val(test_byte2);
+
+	ASSERT_EQ(h, filter->get_total_calls());
+
+	SCOPED_TRACE("validating src");
+	src_image.validate();
+	SCOPED_TRACE("validating dst");
+	dst_image.validate();
+}
+
 TEST(FilterGraphTest, test_grey_to_color_rgb)
 {
 	const unsigned w = 640;
@@ -496,6 +670,75 @@ TEST(FilterGraphTest, test_support)
 	}
 }
 
+TEST(FilterGraphTest, test_buffer_reuse)
+{
+	const unsigned w = 640;
+	const unsigned h = 480;
+	const zimg::PixelType type = zimg::PixelType::FLOAT;
+
+	const uint8_t test_byte1 = 0xCD;
+	const uint8_t test_byte2 = 0xDD;
+	const uint8_t test_byte3 = 0xDC;
+	const uint8_t test_byte4 = 0xCC;
+
+	zimg::graph::ImageFilter::filter_flags flags{};
+	flags.has_state = true;
+	flags.entire_row = true;
+	flags.entire_plane = true;
+
+	auto filter1 = std::make_shared<SplatFilter<float>>(w, h, type);
+	auto filter2 = std::make_shared<SplatFilter<float>>(w, h, type, flags);
+	auto filter3 = std::make_shared<SplatFilter<float>>(w, h, type);
+	auto filter4 = std::make_shared<SplatFilter<float>>(w, h, type);
+
+	filter1->set_input_val(test_byte1);
+	filter1->set_output_val(test_byte2);
+
+	filter2->set_input_val(test_byte2);
+	filter2->set_output_val(test_byte3);
+
+	filter3->set_input_val(test_byte3);
+	filter3->set_output_val(test_byte4);
+
+	filter4->set_input_val(test_byte4);
+	filter4->set_output_val(test_byte1);
+	filter4->set_vertical_support(32);
+
+	zimg::graph::FilterGraph graph;
+	node_id id = graph.add_source({ w, h, type }, 0, 0, enabled_planes(false));
+
+	id = graph.attach_filter(filter1, id_to_map(id, false), enabled_planes(false));
+	id = graph.attach_filter(filter2, id_to_map(id, false), enabled_planes(false));
+	id = graph.attach_filter(filter3, id_to_map(id, false), enabled_planes(false));
+	id = graph.attach_filter(filter4, id_to_map(id, false), enabled_planes(false));
+	graph.set_output(id_to_map(id, false));
+
+	AuditImage<float> src_image{ AuditBufferType::PLANE, w, h, type, 0, 0 };
+	AuditImage<float> dst_image{ AuditBufferType::PLANE, w, h, type, 0, 0 };
+	zimg::AlignedVector<char> tmp(graph.get_tmp_size());
+
+	// The buffer read by the entire-plane filter is dead once it has run, so
+	// the line buffer of the third filter can occupy the same memory.
+	size_t plane_size = static_cast<size_t>(w) * h * sizeof(float);
+	size_t line_size = static_cast<size_t>(w) * sizeof(float);
+	EXPECT_LT(graph.get_tmp_size(), 2 * plane_size + 64 * line_size);
+
+	src_image.set_fill_val(test_byte1);
+	src_image.default_fill();
+	graph.process(src_image.as_read_buffer(), dst_image.as_write_buffer(), tmp.data(), nullptr, nullptr);
+	dst_image.set_fill_val(test_byte1);
+
+	ASSERT_EQ(h, filter1->get_total_calls());
+	ASSERT_EQ(1U, filter2->get_total_calls());
+	ASSERT_EQ(h, filter3->get_total_calls());
+	ASSERT_EQ(h, filter4->get_total_calls());
+
+	SCOPED_TRACE("validating src");
+	src_image.validate();
+	SCOPED_TRACE("validating dst");
+	dst_image.validate();
+}
+
 TEST(FilterGraphTest, test_callback)
 {
 	static const unsigned w = 1024;
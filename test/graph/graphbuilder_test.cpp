@@ -7,6 +7,7 @@
 #include "depth/depth.h"
 #include "graph/filtergraph.h"
 #include "graph/graphbuilder.h"
+#include "resize/filter.h"
 #include "resize/resize.h"
 #include "unresize/unresize.h"
 
@@ -140,11 +141,11 @@ void set_resolution(GraphBuilder::state &state, unsigned width, unsigned height)
 	state.active_height = height;
 }
 
-void test_case(const GraphBuilder::state &source, const GraphBuilder::state &target, const TraceList &trace)
+void test_case(const GraphBuilder::state &source, const GraphBuilder::state &target, const TraceList &trace, const GraphBuilder::params *params = nullptr)
 {
 	GraphBuilder builder;
 	TracingObserver observer;
-	builder.set_source(source).connect(target, nullptr, &observer).complete();
+	builder.set_source(source).connect(target, params, &observer).complete();
 
 	EXPECT_EQ(trace.size(), observer.trace().size());
 	for (size_t i = 0; i < std::min(trace.size(), observer.trace().size()); ++i) {
@@ -344,6 +345,29 @@ TEST(GraphBuilderTest, test_resize_byte_slow_path)
 		});
 }
 
+TEST(GraphBuilderTest, test_resize_byte_point)
+{
+	const zimg::resize::PointFilter point{};
+
+	auto source = make_basic_yuv_state();
+	source.type = zimg::PixelType::BYTE;
+	source.depth = 8;
+	source.fullrange = true;
+	set_resolution(source, 64, 48);
+
+	auto target = source;
+	set_resolution(target, 128, 96);
+
+	GraphBuilder::params params;
+	params.filter = &point;
+	params.filter_uv = &point;
+
+	test_case(source, target, {
+		"resize[0]",
+		"resize[1]",
+	}, &params);
+}
+
 TEST(GraphBuilderTest, test_resize_byte_word)
 {
 	auto source = make_basic_yuv_state();
@@ -390,6 +414,47 @@ TEST(GraphBuilderTest, test_resize_word_byte)
 	});
 }
 
+TEST(GraphBuilderTest, test_unresize_word)
+{
+	auto source = make_basic_yuv_state();
+	source.type = zimg::PixelType::WORD;
+	source.depth = 10;
+	set_resolution(source, 128, 96);
+
+	auto target = source;
+	set_resolution(target, 64, 48);
+
+	GraphBuilder::params params;
+	params.unresize = true;
+
+	test_case(source, target, {
+		"unresize: [128, 96] => [64, 48]",
+		"unresize: [128, 96] => [64, 48]",
+	}, &params);
+}
+
+TEST(GraphBuilderTest, test_unresize_word_float)
+{
+	auto source = make_basic_yuv_state();
+	source.type = zimg::PixelType::WORD;
+	source.depth = 10;
+	set_resolution(source, 128, 96);
+
+	auto target = make_basic_yuv_state();
+	set_resolution(target, 64, 48);
+
+	GraphBuilder::params params;
+	params.unresize = true;
+
+	test_case(source, target, {
+		"depth[0]: [1/10 l:l] => [3/32 l:l]",
+		"unresize: [128, 96] => [64, 48]",
+		"depth[1]: [1/10 l:c] => [3/32 l:l]",
+		"unresize: [128, 96] => [64, 48]",
+		"depth[1]: [3/32 l:l] => [3/32 l:c]",
+	}, &params);
+}
+
 TEST(GraphBuilderTest, test_colorspace_only)
 {
 	auto source = make_basic_rgb_state();
@@ -397,6 +462,32 @@ TEST(GraphBuilderTest, test_colorspace_only)
 	test_case(source, target, { "colorspace" });
 }
 
+TEST(GraphBuilderTest, test_colorspace_integer_rgb)
+{
+	auto source = make_basic_rgb_state();
+	source.type = zimg::PixelType::BYTE;
+	source.depth = 8;
+	source.fullrange = true;
+
+	auto target = source;
+	target.colorspace = { MatrixCoefficients::RGB, TransferCharacteristics::REC_709, ColorPrimaries::REC_2020 };
+
+	test_case(source, target, {
+		"colorspace",
+		"depth[0]: [3/32 l:l] => [0/8 f:l]",
+	});
+
+	// Downscaling converts to FLOAT before the colorspace conversion.
+	set_resolution(target, 32, 24);
+
+	test_case(source, target, {
+		"depth[0]: [0/8 f:l] => [3/32 l:l]",
+		"resize[0]",
+		"colorspace",
+		"depth[0]: [3/32 l:l] => [0/8 f:l]",
+	});
+}
+
 TEST(GraphBuilderTest, test_upscale_colorspace)
 {
 	auto source = make_basic_yuv_state();
@@ -578,6 +669,30 @@ TEST(GraphBuilderTest, test_premul_to_straight)
 	});
 }
 
+TEST(GraphBuilderTest, test_straight_to_premul_integer)
+{
+	auto source = make_basic_rgb_state();
+	source.type = zimg::PixelType::BYTE;
+	source.depth = 8;
+	source.fullrange = true;
+	source.alpha = GraphBuilder::AlphaType::STRAIGHT;
+
+	auto target = source;
+	target.alpha = GraphBuilder::AlphaType::PREMULTIPLIED;
+
+	test_case(source, target, { "premultiply" });
+
+	source.fullrange = false;
+	target.fullrange = false;
+
+	test_case(source, target, {
+		"depth[0]: [0/8 l:l] => [3/32 l:l]",
+		"depth[3]: [0/8 f:l] => [3/32 l:l]",
+		"premultiply",
+		"depth[0]: [3/32 l:l] => [0/8 l:l]",
+	});
+}
+
 TEST(GraphBuilderTest, test_straight_to_opaque)
 {
 	auto source = make_basic_rgb_state();
@@ -710,3 +825,25 @@ TEST(GraphBuilderTest, test_subsample_noop_tile)
 		"resize[1]: [32, 24] => [16, 12] (16.000000, 12.000000, 16.000000, 12.000000)",
 	});
 }
+
+TEST(GraphBuilderTest, test_resize_planar)
+{
+	auto source = make_basic_yuv_state();
+	set_resolution(source, 64, 48);
+	source.subsample_w = 1;
+	source.subsample_h = 1;
+
+	auto target = source;
+	set_resolution(target, 128, 96);
+
+	SCOPED_TRACE("yuv");
+	EXPECT_TRUE(GraphBuilder{}.set_source(source).connect(target, nullptr).complete()->is_planar());
+
+	source = make_basic_rgb_state();
+	set_resolution(source, 64, 48);
+	target = source;
+	set_resolution(target, 128, 96);
+
+	SCOPED_TRACE("rgb");
+	EXPECT_TRUE(GraphBuilder{}.set_source(source).connect(target, nullptr).complete()->is_planar());
+}
@@ -0,0 +1,373 @@
+#include <cstdint>
+#include <memory>
+#include <random>
+#include "common/alloc.h"
+#include "common/cpuinfo.h"
+#include "common/pixel.h"
+#include "graph/filtergraph.h"
+#include "graph/graphbuilder.h"
+#include "graph/image_buffer.h"
+#include "graph/interleave.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using zimg::graph::GraphBuilder;
+
+GraphBuilder::state make_state(zimg::PixelType type, unsigned depth, GraphBuilder::ColorFamily color, GraphBuilder::Packing packing)
+{
+	GraphBuilder::state state{};
+	state.width = 100;
+	state.height = 6;
+	state.type = type;
+	state.color = color;
+	state.depth = depth;
+	state.fullrange = true;
+	state.active_width = state.width;
+	state.active_height = state.height;
+	state.packing = packing;
+	return state;
+}
+
+template <class T>
+struct Plane {
+	zimg::AlignedVector<T> data;
+	unsigned width;
+	unsigned height;
+	unsigned components;
+
+	Plane() : width{}, height{}, components{} {}
+
+	Plane(unsigned width, unsigned height, unsigned components) :
+		data(static_cast<size_t>(zimg::ceil_n(width * components, zimg::ALIGNMENT / sizeof(T))) * height),
+		width{ width },
+		height{ height },
+		components{ components }
+	{}
+
+	ptrdiff_t stride() const { return zimg::ceil_n(width * components, zimg::ALIGNMENT / sizeof(T)) * sizeof(T); }
+
+	T &at(unsigned i, unsigned j, unsigned k = 0) { return data[i * (stride() / sizeof(T)) + j * components + k]; }
+
+	void fill_random(uint32_t maxval, std::mt19937 &mt)
+	{
+		std::uniform_int_distribution<uint32_t> dist{ 0, maxval };
+
+		for (unsigned i = 0; i < height; ++i) {
+			for (unsigned j = 0; j < width * components; ++j) {
+				at(i, 0, j) = static_cast<T>(dist(mt));
+			}
+		}
+	}
+};
+
+template <class T, class U>
+void run_graph(const GraphBuilder::state &src_state, const GraphBuilder::state &dst_state, Plane<T> src[4], Plane<U> dst[4])
+{
+	GraphBuilder::params params;
+	params.cpu = zimg::CPUClass::AUTO;
+
+	std::unique_ptr<zimg::graph::FilterGraph> graph = GraphBuilder{}.set_source(src_state).connect(dst_state, &params).complete();
+	zimg::AlignedVector<char> tmp(graph->get_tmp_size());
+
+	zimg::graph::ColorImageBuffer<const void> src_buf;
+	zimg::graph::ColorImageBuffer<void> dst_buf;
+
+	for (unsigned p = 0; p < 4; ++p) {
+		if (!src[p].data.empty())
+			src_buf[p] = { src[p].data.data(), src[p].stride(), zimg::graph::BUFFER_MAX };
+		if (!dst[p].data.empty())
+			dst_buf[p] = { dst[p].data.data(), dst[p].stride(), zimg::graph::BUFFER_MAX };
+	}
+
+	graph->process(src_buf, dst_buf, tmp.data(), nullptr, nullptr);
+}
+
+} // namespace
+
+
+TEST(InterleaveFilterTest, test_roundtrip)
+{
+	const unsigned w = 99;
+	const zimg::PixelType types[] = { zimg::PixelType::BYTE, zimg::PixelType::WORD, zimg::PixelType::FLOAT };
+
+	for (zimg::PixelType type : types) {
+		for (unsigned n = 1; n <= 4; ++n) {
+			SCOPED_TRACE(static_cast<int>(type));
+			SCOPED_TRACE(n);
+
+			const zimg::graph::component_map components{ { 2, 0, 3, 1 } };
+			const unsigned shift = type == zimg::PixelType::WORD ? 6 : 0;
+			const size_t size = zimg::pixel_size(type);
+
+			zimg::AlignedVector<uint8_t> packed(w * n * size);
+			zimg::AlignedVector<uint8_t> planes[4];
+			zimg::AlignedVector<uint8_t> repacked(w * n * size);
+			std::mt19937 mt;
+
+			for (uint8_t &x : packed) {
+				x = static_cast<uint8_t>(mt());
+			}
+			// Clear the low bits of MSB-aligned samples.
+			if (shift) {
+				for (size_t j = 0; j < w * n; ++j) {
+					reinterpret_cast<uint16_t *>(packed.data())[j] &= ~((1U << shift) - 1);
+				}
+			}
+			for (unsigned p = 0; p < 4; ++p) {
+				planes[p].resize(w * size);
+			}
+
+			zimg::graph::DeinterleaveFilter deinterleave{ w, 1, type, 0, components, n, shift, zimg::CPUClass::NONE };
+			zimg::graph::InterleaveFilter interleave{ w, 1, type, 0, components, n, shift, zimg::CPUClass::NONE };
+
+			zimg::graph::ColorImageBuffer<const void> packed_buf;
+			zimg::graph::ColorImageBuffer<void> planes_buf;
+			zimg::graph::ColorImageBuffer<const void> planes_src_buf;
+			zimg::graph::ColorImageBuffer<void> repacked_buf;
+
+			packed_buf[0] = { packed.data(), 0, zimg::graph::BUFFER_MAX };
+			repacked_buf[0] = { repacked.data(), 0, zimg::graph::BUFFER_MAX };
+			for (unsigned p = 0; p < 4; ++p) {
+				planes_buf[p] = { planes[p].data(), 0, zimg::graph::BUFFER_MAX };
+				planes_src_buf[p] = { planes[p].data(), 0, zimg::graph::BUFFER_MAX };
+			}
+
+			deinterleave.process(nullptr, packed_buf, planes_buf, nullptr, 0, 0, w);
+			interleave.process(nullptr, planes_src_buf, repacked_buf, nullptr, 0, 0, w);
+
+			for (unsigned j = 0; j < w; ++j) {
+				for (unsigned k = 0; k < n; ++k) {
+					const uint8_t *x = packed.data() + (j * n + k) * size;
+					const uint8_t *y = planes[components[k]].data() + j * size;
+
+					if (shift)
+						ASSERT_EQ(*reinterpret_cast<const uint16_t *>(x) >> shift, *reinterpret_cast<const uint16_t *>(y)) << j << " " << k;
+					else
+						ASSERT_TRUE(std::equal(x, x + size, y)) << j << " " << k;
+				}
+			}
+			ASSERT_EQ(packed, repacked);
+		}
+	}
+}
+
+TEST(InterleaveFilterTest, test_graph_bgra_to_planar)
+{
+	GraphBuilder::state src_state = make_state(zimg::PixelType::BYTE, 8, GraphBuilder::ColorFamily::RGB, GraphBuilder::Packing::INTERLEAVED_BGR);
+	src_state.alpha = GraphBuilder::AlphaType::STRAIGHT;
+	GraphBuilder::state dst_state = src_state;
+	dst_state.packing = GraphBuilder::Packing::PLANAR;
+
+	Plane<uint8_t> src[4];
+	Plane<uint8_t> dst[4];
+	std::mt19937 mt;
+
+	src[0] = { src_state.width, src_state.height, 4 };
+	src[0].fill_random(255, mt);
+	for (unsigned p = 0; p < 4; ++p) {
+		dst[p] = { dst_state.width, dst_state.height, 1 };
+	}
+
+	run_graph(src_state, dst_state, src, dst);
+
+	const int order[4] = { 2, 1, 0, 3 };
+	for (unsigned i = 0; i < src_state.height; ++i) {
+		for (unsigned j = 0; j < src_state.width; ++j) {
+			for (unsigned k = 0; k < 4; ++k) {
+				ASSERT_EQ(src[0].at(i, j, k), dst[order[k]].at(i, j)) << i << " " << j << " " << k;
+			}
+		}
+	}
+}
+
+TEST(InterleaveFilterTest, test_graph_planar_to_rgb24)
+{
+	GraphBuilder::state src_state = make_state(zimg::PixelType::BYTE, 8, GraphBuilder::ColorFamily::RGB, GraphBuilder::Packing::PLANAR);
+	GraphBuilder::state dst_state = src_state;
+	dst_state.packing = GraphBuilder::Packing::INTERLEAVED;
+
+	Plane<uint8_t> src[4];
+	Plane<uint8_t> dst[4];
+	std::mt19937 mt;
+
+	for (unsigned p = 0; p < 3; ++p) {
+		src[p] = { src_state.width, src_state.height, 1 };
+		src[p].fill_random(255, mt);
+	}
+	dst[0] = { dst_state.width, dst_state.height, 3 };
+
+	run_graph(src_state, dst_state, src, dst);
+
+	for (unsigned i = 0; i < src_state.height; ++i) {
+		for (unsigned j = 0; j < src_state.width; ++j) {
+			for (unsigned k = 0; k < 3; ++k) {
+				ASSERT_EQ(src[k].at(i, j), dst[0].at(i, j, k)) << i << " " << j << " " << k;
+			}
+		}
+	}
+}
+
+TEST(InterleaveFilterTest, test_graph_rgba_to_float)
+{
+	GraphBuilder::state src_state = make_state(zimg::PixelType::BYTE, 8, GraphBuilder::ColorFamily::RGB, GraphBuilder::Packing::INTERLEAVED);
+	src_state.alpha = GraphBuilder::AlphaType::STRAIGHT;
+	GraphBuilder::state planar_state = src_state;
+	planar_state.packing = GraphBuilder::Packing::PLANAR;
+	GraphBuilder::state dst_state = make_state(zimg::PixelType::FLOAT, 32, GraphBuilder::ColorFamily::RGB, GraphBuilder::Packing::PLANAR);
+	dst_state.alpha = GraphBuilder::AlphaType::STRAIGHT;
+
+	Plane<uint8_t> src[4];
+	Plane<uint8_t> planar[4];
+	std::mt19937 mt;
+
+	src[0] = { src_state.width, src_state.height, 4 };
+	src[0].fill_random(255, mt);
+	for (unsigned p = 0; p < 4; ++p) {
+		planar[p] = { src_state.width, src_state.height, 1 };
+	}
+	for (unsigned i = 0; i < src_state.height; ++i) {
+		for (unsigned j = 0; j < src_state.width; ++j) {
+			for (unsigned k = 0; k < 4; ++k) {
+				planar[k].at(i, j) = src[0].at(i, j, k);
+			}
+		}
+	}
+
+	// The split is fused with the depth conversion, which must not change the result.
+	for (unsigned n = 4; n >= 3; --n) {
+		SCOPED_TRACE(n);
+		dst_state.alpha = n == 4 ? GraphBuilder::AlphaType::STRAIGHT : GraphBuilder::AlphaType::NONE;
+
+		Plane<float> dst[4];
+		Plane<float> expected[4];
+		for (unsigned p = 0; p < n; ++p) {
+			dst[p] = { dst_state.width, dst_state.height, 1 };
+			expected[p] = { dst_state.width, dst_state.height, 1 };
+		}
+
+		run_graph(src_state, dst_state, src, dst);
+		run_graph(planar_state, dst_state, planar, expected);
+
+		for (unsigned p = 0; p < n; ++p) {
+			ASSERT_EQ(expected[p].data, dst[p].data) << p;
+		}
+	}
+}
+
+TEST(InterleaveFilterTest, test_graph_float_to_bgra)
+{
+	GraphBuilder::state src_state = make_state(zimg::PixelType::FLOAT, 32, GraphBuilder::ColorFamily::RGB, GraphBuilder::Packing::PLANAR);
+	src_state.alpha = GraphBuilder::AlphaType::STRAIGHT;
+	GraphBuilder::state dst_state = make_state(zimg::PixelType::BYTE, 8, GraphBuilder::ColorFamily::RGB, GraphBuilder::Packing::INTERLEAVED_BGR);
+	dst_state.alpha = GraphBuilder::AlphaType::STRAIGHT;
+	GraphBuilder::state planar_state = dst_state;
+	planar_state.packing = GraphBuilder::Packing::PLANAR;
+
+	Plane<float> src[4];
+	Plane<uint8_t> dst[4];
+	Plane<uint8_t> expected[4];
+	std::mt19937 mt;
+	std::uniform_real_distribution<float> dist{ 0.0f, 1.0f };
+
+	for (unsigned p = 0; p < 4; ++p) {
+		src[p] = { src_state.width, src_state.height, 1 };
+		for (float &x : src[p].data) {
+			x = dist(mt);
+		}
+		expected[p] = { dst_state.width, dst_state.height, 1 };
+	}
+	dst[0] = { dst_state.width, dst_state.height, 4 };
+
+	run_graph(src_state, dst_state, src, dst);
+	run_graph(src_state, planar_state, src, expected);
+
+	const int order[4] = { 2, 1, 0, 3 };
+	for (unsigned i = 0; i < dst_state.height; ++i) {
+		for (unsigned j = 0; j < dst_state.width; ++j) {
+			for (unsigned k = 0; k < 4; ++k) {
+				ASSERT_EQ(expected[order[k]].at(i, j), dst[0].at(i, j, k)) << i << " " << j << " " << k;
+			}
+		}
+	}
+}
+
+TEST(InterleaveFilterTest, test_graph_nv12_roundtrip)
+{
+	GraphBuilder::state src_state = make_state(zimg::PixelType::BYTE, 8, GraphBuilder::ColorFamily::YUV, GraphBuilder::Packing::SEMIPLANAR);
+	src_state.subsample_w = 1;
+	src_state.subsample_h = 1;
+	GraphBuilder::state planar_state = src_state;
+	planar_state.packing = GraphBuilder::Packing::PLANAR;
+
+	Plane<uint8_t> src[4];
+	Plane<uint8_t> planar[4];
+	Plane<uint8_t> dst[4];
+	std::mt19937 mt;
+
+	src[0] = { src_state.width, src_state.height, 1 };
+	src[1] = { src_state.width / 2, src_state.height / 2, 2 };
+	src[0].fill_random(255, mt);
+	src[1].fill_random(255, mt);
+
+	planar[0] = { src_state.width, src_state.height, 1 };
+	planar[1] = { src_state.width / 2, src_state.height / 2, 1 };
+	planar[2] = { src_state.width / 2, src_state.height / 2, 1 };
+
+	dst[0] = { src_state.width, src_state.height, 1 };
+	dst[1] = { src_state.width / 2, src_state.height / 2, 2 };
+
+	run_graph(src_state, planar_state, src, planar);
+
+	for (unsigned i = 0; i < src_state.height / 2; ++i) {
+		for (unsigned j = 0; j < src_state.width / 2; ++j) {
+			ASSERT_EQ(src[1].at(i, j, 0), planar[1].at(i, j)) << i << " " << j;
+			ASSERT_EQ(src[1].at(i, j, 1), planar[2].at(i, j)) << i << " " << j;
+		}
+	}
+
+	Plane<uint8_t> planar_src[4] = { planar[0], planar[1], planar[2] };
+	run_graph(planar_state, src_state, planar_src, dst);
+
+	ASSERT_EQ(src[0].data, dst[0].data);
+	ASSERT_EQ(src[1].data, dst[1].data);
+}
+
+TEST(InterleaveFilterTest, test_graph_p010_to_planar)
+{
+	GraphBuilder::state src_state = make_state(zimg::PixelType::WORD, 10, GraphBuilder::ColorFamily::YUV, GraphBuilder::Packing::SEMIPLANAR_MSB);
+	src_state.subsample_w = 1;
+	src_state.subsample_h = 1;
+	GraphBuilder::state dst_state = src_state;
+	dst_state.packing = GraphBuilder::Packing::PLANAR;
+
+	Plane<uint16_t> src[4];
+	Plane<uint16_t> dst[4];
+	std::mt19937 mt;
+
+	src[0] = { src_state.width, src_state.height, 1 };
+	src[1] = { src_state.width / 2, src_state.height / 2, 2 };
+	src[0].fill_random(1023, mt);
+	src[1].fill_random(1023, mt);
+	for (uint16_t &x : src[0].data) { x <<= 6; }
+	for (uint16_t &x : src[1].data) { x <<= 6; }
+
+	dst[0] = { src_state.width, src_state.height, 1 };
+	dst[1] = { src_state.width / 2, src_state.height / 2, 1 };
+	dst[2] = { src_state.width / 2, src_state.height / 2, 1 };
+
+	run_graph(src_state, dst_state, src, dst);
+
+	for (unsigned i = 0; i < src_state.height; ++i) {
+		for (unsigned j = 0; j < src_state.width; ++j) {
+			ASSERT_EQ(src[0].at(i, j) >> 6, dst[0].at(i, j)) << i << " " << j;
+		}
+	}
+	for (unsigned i = 0; i < src_state.height / 2; ++i) {
+		for (unsigned j = 0; j < src_state.width / 2; ++j) {
+			ASSERT_EQ(src[1].at(i, j, 0) >> 6, dst[1].at(i, j)) << i << " " << j;
+			ASSERT_EQ(src[1].at(i, j, 1) >> 6, dst[2].at(i, j)) << i << " " << j;
+		}
+	}
+}
@@ -9,7 +9,8 @@ MockFilter::MockFilter(unsigned width, unsigned height, zimg::PixelType type, co
 	m_total_calls{},
 	m_simultaneous_lines{ flags.entire_plane ? zimg::graph::BUFFER_MAX : 1 },
 	m_horizontal_support{},
-	m_vertical_support{}
+	m_vertical_support{},
+	m_first_plane{}
 {
 }
 
@@ -36,6 +37,11 @@ void MockFilter::set_vertical_support(unsigned n)
 		m_vertical_support = n;
 }
 
+void MockFilter::set_first_plane(unsigned p)
+{
+	m_first_plane = p;
+}
+
 zimg::graph::ImageFilter::filter_flags MockFilter::get_flags() const
 {
 	return m_flags;
@@ -120,7 +126,7 @@ void MockFilter::process(void *ctx, const zimg::graph::ImageBuffer<const void> *
 		ASSERT_EQ(0U, i);
 	}
 
-	for (unsigned p = 0; p < (flags.color ? 3U : 1U); ++p) {
+	for (unsigned p = flags.color ? m_first_plane : 0; p < (flags.color ? 3U : 1U); ++p) {
 		if (!flags.in_place) {
 			ASSERT_NE(src[p].data(), dst[p].data());
 		}
@@ -184,7 +190,7 @@ void SplatFilter<T>::process(void *ctx, const zimg::graph::ImageBuffer<const voi
 	pair_unsigned row_range = get_required_row_range(i);
 	pair_unsigned col_range = get_required_col_range(left, right);
 
-	for (unsigned p = 0; p < (get_flags().color ? 3U : 1U); ++p) {
+	for (unsigned p = get_flags().color ? m_first_plane : 0; p < (get_flags().color ? 3U : 1U); ++p) {
 		if (m_input_checking) {
 			for (unsigned ii = row_range.first; ii < row_range.second; ++ii) {
 				const T *src_first = static_cast<const T *>(src[p][ii]) + col_range.first;
@@ -21,6 +21,7 @@ protected:
 	unsigned m_simultaneous_lines;
 	unsigned m_horizontal_support;
 	unsigned m_vertical_support;
+	unsigned m_first_plane;
 public:
 	MockFilter(unsigned width, unsigned height, zimg::PixelType type, const filter_flags &flags = {});
 
@@ -32,6 +33,9 @@ public:
 
 	void set_vertical_support(unsigned n);
 
+	// Color filters process planes from p to 2.
+	void set_first_plane(unsigned p);
+
 	// ImageFilter
 	filter_flags get_flags() const override;
 
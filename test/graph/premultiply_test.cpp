@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include "common/alloc.h"
+#include "common/cpuinfo.h"
+#include "common/pixel.h"
+#include "graph/basic_filter.h"
+#include "graph/image_buffer.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+template <class T>
+void test_case_integer(const zimg::PixelFormat &format)
+{
+	const unsigned w = 640;
+	const uint32_t maxval = (1UL << format.depth) - 1;
+
+	zimg::AlignedVector<T> planes[4];
+	std::mt19937 mt;
+	std::uniform_int_distribution<uint32_t> dist{ 0, maxval };
+
+	for (unsigned p = 0; p < 4; ++p) {
+		planes[p].resize(w);
+
+		for (unsigned j = 0; j < w; ++j)
+			planes[p][j] = static_cast<T>(dist(mt));
+	}
+	planes[3][0] = 0;
+	planes[3][1] = static_cast<T>(maxval);
+
+	zimg::graph::PremultiplyFilter filter{ w, 1, format, true, zimg::CPUClass::NONE };
+	ASSERT_EQ(format.type, filter.get_image_attributes().type);
+
+	zimg::graph::ColorImageBuffer<const void> src_buf{
+		{ planes[0].data(), 0, zimg::graph::BUFFER_MAX },
+		{ planes[1].data(), 0, zimg::graph::BUFFER_MAX },
+		{ planes[2].data(), 0, zimg::graph::BUFFER_MAX },
+		{ planes[3].data(), 0, zimg::graph::BUFFER_MAX },
+	};
+
+	zimg::AlignedVector<T> dst[3];
+	for (unsigned p = 0; p < 3; ++p)
+		dst[p].resize(w);
+
+	zimg::graph::ColorImageBuffer<void> dst_buf{
+		{ dst[0].data(), 0, zimg::graph::BUFFER_MAX },
+		{ dst[1].data(), 0, zimg::graph::BUFFER_MAX },
+		{ dst[2].data(), 0, zimg::graph::BUFFER_MAX },
+	};
+
+	filter.process(nullptr, src_buf, dst_buf, nullptr, 0, 0, w);
+
+	for (unsigned p = 0; p < 3; ++p) {
+		for (unsigned j = 0; j < w; ++j) {
+			double expected = std::round(static_cast<double>(planes[p][j]) * planes[3][j] / maxval);
+			ASSERT_EQ(expected, dst[p][j]) << "plane " << p << " index " << j;
+		}
+	}
+}
+
+} // namespace
+
+
+TEST(PremultiplyFilterTest, test_premultiply_float)
+{
+	const unsigned w = 640;
+
+	zimg::AlignedVector<float> planes[4];
+	for (unsigned p = 0; p < 4; ++p)
+		planes[p].resize(w);
+
+	for (unsigned j = 0; j < w; ++j) {
+		planes[0][j] = 0.5f;
+		planes[1][j] = 0.25f;
+		planes[2][j] = -0.5f;
+		planes[3][j] = static_cast<float>(j) / (w / 2) - 0.5f;
+	}
+
+	zimg::graph::PremultiplyFilter premul{ w, 1, zimg::PixelType::FLOAT, true, zimg::CPUClass::NONE };
+	zimg::graph::UnpremultiplyFilter unpremul{ w, 1, true, zimg::CPUClass::NONE };
+
+	zimg::AlignedVector<float> tmp[3];
+	zimg::AlignedVector<float> dst[3];
+	for (unsigned p = 0; p < 3; ++p) {
+		tmp[p].resize(w);
+		dst[p].resize(w);
+	}
+
+	zimg::graph::ColorImageBuffer<const void> src_buf{
+		{ planes[0].data(), 0, zimg::graph::BUFFER_MAX },
+		{ planes[1].data(), 0, zimg::graph::BUFFER_MAX },
+		{ planes[2].data(), 0, zimg::graph::BUFFER_MAX },
+		{ planes[3].data(), 0, zimg::graph::BUFFER_MAX },
+	};
+	zimg::graph::ColorImageBuffer<void> tmp_buf{
+		{ tmp[0].data(), 0, zimg::graph::BUFFER_MAX },
+		{ tmp[1].data(), 0, zimg::graph::BUFFER_MAX },
+		{ tmp[2].data(), 0, zimg::graph::BUFFER_MAX },
+	};
+	zimg::graph::ColorImageBuffer<const void> tmp_src_buf{
+		{ tmp[0].data(), 0, zimg::graph::BUFFER_MAX },
+		{ tmp[1].data(), 0, zimg::graph::BUFFER_MAX },
+		{ tmp[2].data(), 0, zimg::graph::BUFFER_MAX },
+		{ planes[3].data(), 0, zimg::graph::BUFFER_MAX },
+	};
+	zimg::graph::ColorImageBuffer<void> dst_buf{
+		{ dst[0].data(), 0, zimg::graph::BUFFER_MAX },
+		{ dst[1].data(), 0, zimg::graph::BUFFER_MAX },
+		{ dst[2].data(), 0, zimg::graph::BUFFER_MAX },
+	};
+
+	premul.process(nullptr, src_buf, tmp_buf, nullptr, 0, 0, w);
+	unpremul.process(nullptr, tmp_src_buf, dst_buf, nullptr, 0, 0, w);
+
+	for (unsigned p = 0; p < 3; ++p) {
+		for (unsigned j = 0; j < w; ++j) {
+			float a = std::min(std::max(planes[3][j], 0.0f), 1.0f);
+
+			ASSERT_EQ(planes[p][j] * a, tmp[p][j]);
+
+			if (a < FLT_MIN)
+				ASSERT_EQ(0.0f, dst[p][j]);
+			else
+				ASSERT_NEAR(planes[p][j], dst[p][j], 1e-6f);
+		}
+	}
+}
+
+TEST(PremultiplyFilterTest, test_premultiply_b)
+{
+	test_case_integer<uint8_t>({ zimg::PixelType::BYTE, 8, true });
+}
+
+TEST(PremultiplyFilterTest, test_premultiply_w10)
+{
+	test_case_integer<uint16_t>({ zimg::PixelType::WORD, 10, true });
+}
+
+TEST(PremultiplyFilterTest, test_premultiply_w16)
+{
+	test_case_integer<uint16_t>({ zimg::PixelType::WORD, 16, true });
+}
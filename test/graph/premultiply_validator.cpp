@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <utility>
+#include "common/alloc.h"
+#include "common/cpuinfo.h"
+#include "common/pixel.h"
+#include "graph/basic_filter.h"
+#include "graph/image_buffer.h"
+
+#include "gtest/gtest.h"
+
+#include "premultiply_validator.h"
+
+void validate_premultiply(zimg::CPUClass cpu, bool unpremultiply)
+{
+	const unsigned w = 640;
+	const std::pair<unsigned, unsigned> ranges[] = { { 0, w }, { 3, w - 5 }, { w / 4 + 1, w / 2 - 1 } };
+
+	std::shared_ptr<zimg::graph::ImageFilter> filter_c;
+	std::shared_ptr<zimg::graph::ImageFilter> filter_simd;
+
+	if (unpremultiply) {
+		filter_c = std::make_shared<zimg::graph::UnpremultiplyFilter>(w, 1, true, zimg::CPUClass::NONE);
+		filter_simd = std::make_shared<zimg::graph::UnpremultiplyFilter>(w, 1, true, cpu);
+	} else {
+		filter_c = std::make_shared<zimg::graph::PremultiplyFilter>(w, 1, zimg::PixelType::FLOAT, true, zimg::CPUClass::NONE);
+		filter_simd = std::make_shared<zimg::graph::PremultiplyFilter>(w, 1, zimg::PixelType::FLOAT, true, cpu);
+	}
+
+	zimg::AlignedVector<float> src[4];
+	zimg::AlignedVector<float> dst_c[3];
+	zimg::AlignedVector<float> dst_simd[3];
+	std::mt19937 mt;
+	std::uniform_real_distribution<float> dist_x{ 0.0f, 1.0f };
+	std::uniform_real_distribution<float> dist_a{ -0.25f, 1.25f };
+
+	for (unsigned p = 0; p < 4; ++p) {
+		src[p].resize(w);
+
+		for (unsigned j = 0; j < w; ++j)
+			src[p][j] = p == 3 ? dist_a(mt) : dist_x(mt);
+	}
+	src[3][0] = 0.0f;
+	src[3][1] = 1.0f;
+	src[3][2] = FLT_MIN;
+	src[3][3] = FLT_MIN / 2;
+
+	for (unsigned p = 0; p < 3; ++p) {
+		dst_c[p].resize(w);
+		dst_simd[p].resize(w);
+	}
+
+	zimg::graph::ColorImageBuffer<const void> src_buf{
+		{ src[0].data(), 0, zimg::graph::BUFFER_MAX },
+		{ src[1].data(), 0, zimg::graph::BUFFER_MAX },
+		{ src[2].data(), 0, zimg::graph::BUFFER_MAX },
+		{ src[3].data(), 0, zimg::graph::BUFFER_MAX },
+	};
+	zimg::graph::ColorImageBuffer<void> dst_c_buf{
+		{ dst_c[0].data(), 0, zimg::graph::BUFFER_MAX },
+		{ dst_c[1].data(), 0, zimg::graph::BUFFER_MAX },
+		{ dst_c[2].data(), 0, zimg::graph::BUFFER_MAX },
+	};
+	zimg::graph::ColorImageBuffer<void> dst_simd_buf{
+		{ dst_simd[0].data(), 0, zimg::graph::BUFFER_MAX },
+		{ dst_simd[1].data(), 0, zimg::graph::BUFFER_MAX },
+		{ dst_simd[2].data(), 0, zimg::graph::BUFFER_MAX },
+	};
+
+	for (const auto &range : ranges) {
+		SCOPED_TRACE(range.first);
+
+		for (unsigned p = 0; p < 3; ++p) {
+			std::fill(dst_c[p].begin(), dst_c[p].end(), NAN);
+			std::fill(dst_simd[p].begin(), dst_simd[p].end(), NAN);
+		}
+
+		filter_c->process(nullptr, src_buf, dst_c_buf, nullptr, 0, range.first, range.second);
+		filter_simd->process(nullptr, src_buf, dst_simd_buf, nullptr, 0, range.first, range.second);
+
+		for (unsigned p = 0; p < 3; ++p) {
+			for (unsigned j = 0; j < w; ++j) {
+				float x = dst_c[p][j];
+				float y = dst_simd[p][j];
+
+				if (j < range.first || j >= range.second)
+					ASSERT_TRUE(std::isnan(y)) << "plane " << p << " index " << j;
+				else
+					ASSERT_EQ(x, y) << "plane " << p << " index " << j;
+			}
+		}
+	}
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#ifndef ZIMG_UNIT_TEST_GRAPH_PREMULTIPLY_VALIDATOR_H_
+#define ZIMG_UNIT_TEST_GRAPH_PREMULTIPLY_VALIDATOR_H_
+
+namespace zimg {
+
+enum class CPUClass;
+
+} // namespace zimg
+
+
+// Check that the float (un)premultiply filter for the given CPU matches the C path exactly.
+void validate_premultiply(zimg::CPUClass cpu, bool unpremultiply);
+
+#endif // ZIMG_UNIT_TEST_GRAPH_PREMULTIPLY_VALIDATOR_H_
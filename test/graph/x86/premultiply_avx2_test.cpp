@@ -0,0 +1,34 @@
+#ifdef ZIMG_X86
+
+#include "common/cpuinfo.h"
+#include "common/x86/cpuinfo_x86.h"
+#include "graph/premultiply_validator.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+void test_case(bool unpremultiply)
+{
+	if (!zimg::query_x86_capabilities().avx2) {
+		SUCCEED() << "avx2 not available, skipping";
+		return;
+	}
+
+	validate_premultiply(zimg::CPUClass::X86_AVX2, unpremultiply);
+}
+
+} // namespace
+
+
+TEST(PremultiplyFilterAVX2Test, test_premultiply)
+{
+	test_case(false);
+}
+
+TEST(PremultiplyFilterAVX2Test, test_unpremultiply)
+{
+	test_case(true);
+}
+
+#endif // ZIMG_X86
@@ -0,0 +1,34 @@
+#ifdef ZIMG_X86_AVX512
+
+#include "common/cpuinfo.h"
+#include "common/x86/cpuinfo_x86.h"
+#include "graph/premultiply_validator.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+void test_case(bool unpremultiply)
+{
+	if (!zimg::cpu_has_avx512_f_dq_bw_vl(zimg::query_x86_capabilities())) {
+		SUCCEED() << "avx512 not available, skipping";
+		return;
+	}
+
+	validate_premultiply(zimg::CPUClass::X86_AVX512, unpremultiply);
+}
+
+} // namespace
+
+
+TEST(PremultiplyFilterAVX512Test, test_premultiply)
+{
+	test_case(false);
+}
+
+TEST(PremultiplyFilterAVX512Test, test_unpremultiply)
+{
+	test_case(true);
+}
+
+#endif // ZIMG_X86_AVX512
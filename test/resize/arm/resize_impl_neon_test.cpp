@@ -31,15 +31,20 @@ void test_case(const zimg::resize::Filter &filter, bool horizontal, unsigned src
 		.set_shift(0.0)
 		.set_subwidth(horizontal ? src_w : src_h);
 
+	// No half-precision implementation is available in C, so HALF is compared to the FLOAT implementation.
+	auto builder_c = builder;
+	if (format.type == zimg::PixelType::HALF)
+		builder_c.type = zimg::PixelType::FLOAT;
+
 	std::unique_ptr<zimg::graph::ImageFilter> filter_neon = builder.set_cpu(zimg::CPUClass::ARM_NEON).create();
-	std::unique_ptr<zimg::graph::ImageFilter> filter_c = builder.set_cpu(zimg::CPUClass::NONE).create();
+	std::unique_ptr<zimg::graph::ImageFilter> filter_c = builder_c.set_cpu(zimg::CPUClass::NONE).create();
 
 	ASSERT_FALSE(assert_different_dynamic_type(filter_c.get(), filter_neon.get()));
 
 	FilterValidator validator{ filter_neon.get(), src_w, src_h, format };
-	validator.set_sha1(expected_sha1);
-	validator.set_ref_filter(filter_c.get(), expected_snr);
-	validator.validate();
+	validator.set_sha1(expected_sha1)
+	         .set_ref_filter(filter_c.get(), expected_snr)
+	         .validate();
 }
 
 } // namespace
@@ -129,6 +134,40 @@ TEST(ResizeImplNeonTest, test_resize_v_u16)
 	test_case(zimg::resize::LanczosFilter{ 4 }, false, w, dst_h, w, src_h, format, expected_sha1[3], expected_snr);
 }
 
+#if !defined(_MSC_VER) || defined(_M_ARM64)
+TEST(ResizeImplNeonTest, test_resize_h_f16)
+{
+	const unsigned src_w = 640;
+	const unsigned dst_w = 960;
+	const unsigned h = 480;
+	const zimg::PixelType format = zimg::PixelType::HALF;
+
+	// Half precision has an 11-bit significand, so results may differ from the reference by an ulp.
+	const double expected_snr = 60.0;
+
+	test_case(zimg::resize::BilinearFilter{}, true, src_w, h, dst_w, h, format, nullptr, expected_snr);
+	test_case(zimg::resize::Spline16Filter{}, true, src_w, h, dst_w, h, format, nullptr, expected_snr);
+	test_case(zimg::resize::LanczosFilter{ 4 }, true, src_w, h, dst_w, h, format, nullptr, expected_snr);
+	test_case(zimg::resize::LanczosFilter{ 4 }, true, dst_w, h, src_w, h, format, nullptr, expected_snr);
+}
+
+TEST(ResizeImplNeonTest, test_resize_v_f16)
+{
+	const unsigned w = 640;
+	const unsigned src_h = 480;
+	const unsigned dst_h = 720;
+	const zimg::PixelType type = zimg::PixelType::HALF;
+
+	// Half precision has an 11-bit significand, so results may differ from the reference by an ulp.
+	const double expected_snr = 60.0;
+
+	test_case(zimg::resize::BilinearFilter{}, false, w, src_h, w, dst_h, type, nullptr, expected_snr);
+	test_case(zimg::resize::Spline16Filter{}, false, w, src_h, w, dst_h, type, nullptr, expected_snr);
+	test_case(zimg::resize::LanczosFilter{ 4 }, false, w, src_h, w, dst_h, type, nullptr, expected_snr);
+	test_case(zimg::resize::LanczosFilter{ 4 }, false, w, dst_h, w, src_h, type, nullptr, expected_snr);
+}
+#endif // !defined(_MSC_VER) || defined(_M_ARM64)
+
 TEST(ResizeImplNeonTest, test_resize_h_f32)
 {
 	const unsigned src_w = 640;
@@ -1,4 +1,7 @@
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdio>
 #include "resize/filter.h"
 
 #include "gtest/gtest.h"
@@ -95,6 +98,47 @@ TEST(FilterTest, test_spline64)
 	EXPECT_NEAR(-0.00528169, f(-3.5), 1e-8);
 }
 
+TEST(FilterTest, test_area)
+{
+	zimg::resize::AreaFilter f;
+	EXPECT_EQ(1U, f.support());
+	EXPECT_EQ(1.0, f(0.0));
+	EXPECT_EQ(1.0, f(0.25));
+	EXPECT_EQ(0.5, f(0.5));
+	EXPECT_EQ(0.5, f(-0.5));
+	EXPECT_EQ(0.0, f(0.75));
+}
+
+TEST(FilterTest, test_area_footprint)
+{
+	const unsigned src_dim = 1000;
+	const unsigned dst_dims[] = { 1, 3, 10, 333, 999, 1000, 2100 };
+
+	for (unsigned dst_dim : dst_dims) {
+		SCOPED_TRACE(dst_dim);
+
+		zimg::resize::AreaFilterContext ctx = zimg::resize::compute_area_filter(src_dim, dst_dim, 0.0, src_dim);
+		ASSERT_EQ(dst_dim, ctx.rows.size());
+		EXPECT_EQ(src_dim, ctx.input_width);
+
+		for (const zimg::resize::AreaFilterContext::Row &row : ctx.rows) {
+			ASSERT_GE(row.count, 1U);
+			ASSERT_LE(row.left + row.count, src_dim);
+			EXPECT_LE(row.count, ctx.max_count);
+
+			double sum = row.coeff_first;
+			if (row.count > 1)
+				sum += row.coeff_last + row.coeff_mid * (row.count - 2);
+
+			EXPECT_NEAR(1.0, sum, 1e-6);
+		}
+
+		// The footprints must tile the input.
+		EXPECT_EQ(0U, ctx.rows.front().left);
+		EXPECT_EQ(src_dim, ctx.rows.back().left + ctx.rows.back().count);
+	}
+}
+
 TEST(FilterTest, test_lanczos)
 {
 	for (unsigned i = 1; i < 4; ++i) {
@@ -104,3 +148,74 @@ TEST(FilterTest, test_lanczos)
 		check_interpolating(f);
 	}
 }
+
+TEST(FilterTest, test_compute_filter_normalized)
+{
+	const zimg::resize::BilinearFilter bilinear;
+	const zimg::resize::Spline36Filter spline36;
+	const zimg::resize::LanczosFilter lanczos4{ 4 };
+	const zimg::resize::Filter *filters[] = { &bilinear, &spline36, &lanczos4 };
+
+	const unsigned src_dim = 640;
+	const unsigned dst_dims[] = { 7, 333, 640, 1344 };
+
+	for (const zimg::resize::Filter *f : filters) {
+		SCOPED_TRACE(f->support());
+
+		for (unsigned dst_dim : dst_dims) {
+			SCOPED_TRACE(dst_dim);
+
+			zimg::resize::FilterContext ctx = zimg::resize::compute_filter(*f, src_dim, dst_dim, 0.25, src_dim);
+			ASSERT_EQ(dst_dim, ctx.filter_rows);
+			ASSERT_EQ(src_dim, ctx.input_width);
+
+			for (unsigned i = 0; i < ctx.filter_rows; ++i) {
+				ASSERT_LE(ctx.left[i] + ctx.filter_width, ctx.input_width);
+
+				double sum_f32 = 0.0;
+				int sum_i16 = 0;
+
+				for (unsigned k = 0; k < ctx.filter_width; ++k) {
+					sum_f32 += ctx.data[i * ctx.stride + k];
+					sum_i16 += ctx.data_i16[i * ctx.stride_i16 + k];
+				}
+
+				EXPECT_NEAR(1.0, sum_f32, 1e-6);
+				EXPECT_EQ(1 << 14, sum_i16);
+			}
+		}
+	}
+}
+
+// Timing only. Run with --gtest_also_run_disabled_tests.
+TEST(FilterTest, DISABLED_bench_compute_filter)
+{
+	typedef std::chrono::high_resolution_clock hrclock;
+
+	const zimg::resize::LanczosFilter lanczos3{ 3 };
+	const unsigned times = 5;
+
+	struct {
+		unsigned src_dim;
+		unsigned dst_dim;
+	} cases[] = {
+		{ 1920, 3840 },
+		{ 3840, 1920 },
+		{ 12000, 300 },
+	};
+
+	for (const auto &c : cases) {
+		double min_time = INFINITY;
+
+		for (unsigned n = 0; n < times; ++n) {
+			auto start = hrclock::now();
+			zimg::resize::FilterContext ctx = zimg::resize::compute_filter(lanczos3, c.src_dim, c.dst_dim, 0.0, c.src_dim);
+			std::chrono::duration<double> elapsed = hrclock::now() - start;
+
+			ASSERT_EQ(c.dst_dim, ctx.filter_rows);
+			min_time = std::min(min_time, elapsed.count());
+		}
+
+		std::printf("compute_filter: %u => %u: %f ms\n", c.src_dim, c.dst_dim, min_time * 1000.0);
+	}
+}
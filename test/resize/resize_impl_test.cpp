@@ -1,6 +1,15 @@
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include "common/align.h"
+#include "common/alloc.h"
 #include "common/cpuinfo.h"
 #include "common/pixel.h"
+#include "graph/image_buffer.h"
 #include "graph/image_filter.h"
 #include "resize/filter.h"
 #include "resize/resize_impl.h"
@@ -43,6 +52,184 @@ void test_case(const zimg::PixelFormat &format, bool horizontal, double scale_fa
 	}
 }
 
+// Box filter sampled at pixel centers, evaluated with the generic kernels.
+// Equivalent to the area filter when the downscaling ratio is an integer.
+class SampledBoxFilter : public zimg::resize::Filter {
+public:
+	unsigned support() const override { return 1; }
+
+	double operator()(double x) const override { return zimg::resize::AreaFilter{}(x); }
+};
+
+void test_case_area(const zimg::PixelFormat &format, bool horizontal, unsigned src_dim, unsigned dst_dim, const char * const expected_sha1[3], double expected_snr)
+{
+	const unsigned src_w = horizontal ? src_dim : 640;
+	const unsigned src_h = horizontal ? 480 : src_dim;
+
+	const zimg::resize::AreaFilter area{};
+	const SampledBoxFilter box{};
+
+	auto builder = zimg::resize::ResizeImplBuilder{ src_w, src_h, format.type }
+		.set_horizontal(horizontal)
+		.set_dst_dim(dst_dim)
+		.set_depth(format.depth)
+		.set_shift(0.0)
+		.set_subwidth(src_dim);
+
+	auto filter = builder.set_filter(&area).create();
+	ASSERT_TRUE(filter);
+
+	FilterValidator validator{ filter.get(), src_w, src_h, format };
+	validator.set_sha1(expected_sha1);
+
+	std::unique_ptr<zimg::graph::ImageFilter> filter_ref;
+	if (src_dim % dst_dim == 0) {
+		filter_ref = builder.set_filter(&box).create();
+		ASSERT_FALSE(assert_different_dynamic_type(filter.get(), filter_ref.get()));
+		validator.set_ref_filter(filter_ref.get(), expected_snr);
+	}
+
+	validator.validate();
+}
+
+// Compare the area filter against box averages computed directly from the footprint of each output sample.
+template <class T>
+void test_case_area_box(bool horizontal, unsigned src_dim, unsigned dst_dim, double tolerance)
+{
+	const unsigned other_dim = 8;
+	const unsigned src_w = horizontal ? src_dim : other_dim;
+	const unsigned src_h = horizontal ? other_dim : src_dim;
+	const unsigned dst_w = horizontal ? dst_dim : other_dim;
+	const unsigned dst_h = horizontal ? other_dim : dst_dim;
+	const zimg::PixelType type = std::is_same<T, float>::value ? zimg::PixelType::FLOAT : zimg::PixelType::WORD;
+	const double maxval = std::is_same<T, float>::value ? 1.0 : 65535.0;
+
+	const zimg::resize::AreaFilter area{};
+	auto filter = zimg::resize::ResizeImplBuilder{ src_w, src_h, type }
+		.set_horizontal(horizontal)
+		.set_dst_dim(dst_dim)
+		.set_depth(16)
+		.set_filter(&area)
+		.set_shift(0.0)
+		.set_subwidth(src_dim)
+		.create();
+	ASSERT_TRUE(filter);
+
+	zimg::AlignedVector<T> src(static_cast<size_t>(src_w) * src_h);
+	zimg::AlignedVector<T> dst(static_cast<size_t>(dst_w) * dst_h);
+	std::mt19937 mt;
+	std::uniform_real_distribution<double> dist{ 0.0, maxval };
+
+	for (T &x : src) {
+		x = static_cast<T>(std::is_same<T, float>::value ? dist(mt) : std::lrint(dist(mt)));
+	}
+
+	zimg::AlignedVector<unsigned char> ctx(filter->get_context_size());
+	zimg::AlignedVector<unsigned char> tmp(filter->get_tmp_size(0, dst_w));
+	zimg::graph::ImageBuffer<const void> src_buf{ src.data(), static_cast<ptrdiff_t>(src_w * sizeof(T)), zimg::graph::BUFFER_MAX };
+	zimg::graph::ImageBuffer<void> dst_buf{ dst.data(), static_cast<ptrdiff_t>(dst_w * sizeof(T)), zimg::graph::BUFFER_MAX };
+
+	filter->init_context(ctx.data(), 0);
+	for (unsigned i = 0; i < dst_h; i += filter->get_simultaneous_lines()) {
+		filter->process(ctx.data(), &src_buf, &dst_buf, tmp.data(), i, 0, dst_w);
+	}
+
+	const double scale = static_cast<double>(src_dim) / dst_dim;
+	std::vector<double> expected(dst_dim);
+
+	for (unsigned n = 0; n < other_dim; ++n) {
+		auto src_at = [&](unsigned k) { return static_cast<double>(horizontal ? src[static_cast<size_t>(n) * src_w + k] : src[static_cast<size_t>(k) * src_w + n]); };
+		auto dst_at = [&](unsigned j) { return static_cast<double>(horizontal ? dst[static_cast<size_t>(n) * dst_w + j] : dst[static_cast<size_t>(j) * dst_w + n]); };
+
+		for (unsigned j = 0; j < dst_dim; ++j) {
+			double lo = j * scale;
+			double hi = (j + 1) * scale;
+			double sum = 0.0;
+
+			for (unsigned k = static_cast<unsigned>(std::floor(lo)); k < std::min(static_cast<double>(src_dim), std::ceil(hi)); ++k) {
+				double overlap = std::min(hi, k + 1.0) - std::max(lo, static_cast<double>(k));
+				sum += overlap * src_at(k);
+			}
+
+			ASSERT_NEAR(sum / scale, dst_at(j), tolerance) << "line " << n << " sample " << j;
+		}
+	}
+}
+
+template <class T>
+void test_case_uv(const zimg::resize::Filter &filter, bool horizontal, unsigned src_w, unsigned src_h, unsigned dst_dim, zimg::PixelType type)
+{
+	const unsigned dst_w = horizontal ? dst_dim : src_w;
+	const unsigned dst_h = horizontal ? src_h : dst_dim;
+	const ptrdiff_t src_stride = zimg::ceil_n(src_w * sizeof(T), zimg::ALIGNMENT);
+	const ptrdiff_t dst_stride = zimg::ceil_n(dst_w * sizeof(T), zimg::ALIGNMENT);
+
+	auto builder = zimg::resize::ResizeImplBuilder{ src_w, src_h, type }
+		.set_horizontal(horizontal)
+		.set_dst_dim(dst_dim)
+		.set_depth(16)
+		.set_filter(&filter)
+		.set_shift(0.0)
+		.set_subwidth(horizontal ? src_w : src_h);
+
+	auto filter_uv = builder.set_uv(true).create();
+	auto filter_grey = builder.set_uv(false).create();
+	ASSERT_TRUE(filter_uv);
+	ASSERT_TRUE(filter_grey);
+	ASSERT_TRUE(filter_uv->get_flags().color);
+	ASSERT_FALSE(filter_grey->get_flags().color);
+
+	std::vector<zimg::AlignedVector<unsigned char>> src(2, zimg::AlignedVector<unsigned char>(src_stride * src_h));
+	std::vector<zimg::AlignedVector<unsigned char>> dst(4, zimg::AlignedVector<unsigned char>(dst_stride * dst_h));
+	std::mt19937 mt;
+	std::uniform_real_distribution<double> dist{ 0.0, std::is_same<T, float>::value ? 1.0 : 65535.0 };
+
+	for (auto &plane : src) {
+		for (unsigned i = 0; i < src_h; ++i) {
+			T *row = reinterpret_cast<T *>(plane.data() + i * src_stride);
+			std::generate_n(row, src_w, [&]() { return static_cast<T>(std::is_same<T, float>::value ? dist(mt) : std::lrint(dist(mt))); });
+		}
+	}
+
+	auto run = [&](const zimg::graph::ImageFilter &f, const zimg::graph::ImageBuffer<const void> *src_buf, const zimg::graph::ImageBuffer<void> *dst_buf)
+	{
+		// Two tiles, so that neither edge of the second is aligned.
+		const unsigned tiles[][2] = { { 0, dst_w / 3 }, { dst_w / 3, dst_w } };
+
+		for (const auto &tile : tiles) {
+			zimg::AlignedVector<unsigned char> ctx(f.get_context_size());
+			zimg::AlignedVector<unsigned char> tmp(f.get_tmp_size(tile[0], tile[1]));
+
+			f.init_context(ctx.data(), 0);
+			for (unsigned i = 0; i < dst_h; i += f.get_simultaneous_lines()) {
+				f.process(ctx.data(), src_buf, dst_buf, tmp.data(), i, tile[0], tile[1]);
+			}
+		}
+	};
+
+	zimg::graph::ImageBuffer<const void> src_buf[3] = {
+		{},
+		{ src[0].data(), src_stride, zimg::graph::BUFFER_MAX },
+		{ src[1].data(), src_stride, zimg::graph::BUFFER_MAX },
+	};
+	zimg::graph::ImageBuffer<void> dst_buf[5] = {
+		{},
+		{ dst[0].data(), dst_stride, zimg::graph::BUFFER_MAX },
+		{ dst[1].data(), dst_stride, zimg::graph::BUFFER_MAX },
+		{ dst[2].data(), dst_stride, zimg::graph::BUFFER_MAX },
+		{ dst[3].data(), dst_stride, zimg::graph::BUFFER_MAX },
+	};
+
+	run(*filter_uv, src_buf, dst_buf);
+	run(*filter_grey, src_buf + 1, dst_buf + 3);
+	run(*filter_grey, src_buf + 2, dst_buf + 4);
+
+	for (unsigned i = 0; i < dst_h; ++i) {
+		ASSERT_EQ(0, std::memcmp(dst[0].data() + i * dst_stride, dst[2].data() + i * dst_stride, dst_w * sizeof(T))) << "U row " << i;
+		ASSERT_EQ(0, std::memcmp(dst[1].data() + i * dst_stride, dst[3].data() + i * dst_stride, dst_w * sizeof(T))) << "V row " << i;
+	}
+}
+
 } // namespace
 
 TEST(ResizeImplTest, test_nop)
@@ -249,3 +436,170 @@ TEST(ResizeImplTest, test_vertical_shift)
 	SCOPED_TRACE("down");
 	test_case(zimg::PixelType::FLOAT, false, 1.0 / 2.1, shift, subwidth_factor, expected_sha1_down);
 }
+
+TEST(ResizeImplTest, test_area_integer_ratio)
+{
+	const char *expected_sha1[][3] = {
+		{ "af0acc48cfd0f89e3ad9ac3051a98d3ff835da8d" },
+		{ "04841208b7f9b06c501b64f7219426bcffeb66fb" },
+		{ "20a1f9a115be71a1cd1219782793ac859f7e4ed2" },
+		{ "cbe2d5922e53e0dfa7f0d7f294c4b2d9004f86d1" },
+	};
+
+	SCOPED_TRACE("word-h");
+	test_case_area(zimg::PixelType::WORD, true, 640, 160, expected_sha1[0], 80.0);
+	SCOPED_TRACE("word-v");
+	test_case_area(zimg::PixelType::WORD, false, 480, 240, expected_sha1[1], 80.0);
+	SCOPED_TRACE("float-h");
+	test_case_area(zimg::PixelType::FLOAT, true, 640, 320, expected_sha1[2], 120.0);
+	SCOPED_TRACE("float-v");
+	test_case_area(zimg::PixelType::FLOAT, false, 480, 60, expected_sha1[3], 120.0);
+}
+
+TEST(ResizeImplTest, test_area_fractional_ratio)
+{
+	const char *expected_sha1[][3] = {
+		{ "bb97affb7b017747a1c4352fb38ce82fdbe34822" },
+		{ "62f6386cf1c0b928171630547b56fe43349a04f0" },
+		{ "4c2e5fd105f10679c4b1eb63872e61eac7fa182c" },
+		{ "f2ee3b8eaa3281fe7ef7075a8ac3f509fa8da9da" },
+		{ "b99d8a10e1a4073ee92bc8470a01b3fad9bf9725" },
+		{ "f730bdf02d23cc2f4d9d6f5ef1de0aec037d0d3b" },
+	};
+
+	SCOPED_TRACE("word-h");
+	test_case_area(zimg::PixelType::WORD, true, 640, 227, expected_sha1[0], INFINITY);
+	SCOPED_TRACE("word-v");
+	test_case_area(zimg::PixelType::WORD, false, 480, 97, expected_sha1[1], INFINITY);
+	SCOPED_TRACE("float-h");
+	test_case_area(zimg::PixelType::FLOAT, true, 640, 227, expected_sha1[2], INFINITY);
+	SCOPED_TRACE("float-v");
+	test_case_area(zimg::PixelType::FLOAT, false, 480, 97, expected_sha1[3], INFINITY);
+	SCOPED_TRACE("float-h-up");
+	test_case_area(zimg::PixelType::FLOAT, true, 640, 1344, expected_sha1[4], INFINITY);
+	SCOPED_TRACE("float-v-up");
+	test_case_area(zimg::PixelType::FLOAT, false, 480, 1008, expected_sha1[5], INFINITY);
+}
+
+TEST(ResizeImplTest, test_area_box_average)
+{
+	SCOPED_TRACE("float-h-2:1");
+	test_case_area_box<float>(true, 640, 320, 1e-6);
+	SCOPED_TRACE("float-v-2:1");
+	test_case_area_box<float>(false, 480, 240, 1e-6);
+	SCOPED_TRACE("float-h");
+	test_case_area_box<float>(true, 640, 227, 1e-5);
+	SCOPED_TRACE("float-v");
+	test_case_area_box<float>(false, 480, 97, 1e-5);
+	SCOPED_TRACE("float-h-up");
+	test_case_area_box<float>(true, 640, 1344, 1e-5);
+	SCOPED_TRACE("float-v-up");
+	test_case_area_box<float>(false, 480, 1008, 1e-5);
+	SCOPED_TRACE("word-h");
+	test_case_area_box<uint16_t>(true, 640, 227, 1.0);
+	SCOPED_TRACE("word-v");
+	test_case_area_box<uint16_t>(false, 480, 97, 1.0);
+}
+
+TEST(ResizeImplTest, test_point_byte_half)
+{
+	const unsigned src_w = 640;
+	const unsigned src_h = 480;
+
+	const zimg::resize::PointFilter point{};
+	const zimg::PixelFormat formats[] = { zimg::PixelType::BYTE, zimg::PixelType::HALF };
+
+	const char *expected_sha1[][3] = {
+		{ "b46f8a97f348eb35d73abf5885bd27f439f1792f" },
+		{ "9a4af12583587ac670451b965831c002f13b7698" },
+		{ "8d0046f002c08a4f19f8422ad6efab2ec5955c3c" },
+		{ "79f2ffe2dc680a070326f0feb465ba87e283e5d1" },
+	};
+	unsigned sha1_idx = 0;
+
+	for (const zimg::PixelFormat &format : formats) {
+		for (bool horizontal : { true, false }) {
+			SCOPED_TRACE(static_cast<int>(format.type));
+			SCOPED_TRACE(horizontal);
+
+			auto filter = zimg::resize::ResizeImplBuilder{ src_w, src_h, format.type }
+				.set_horizontal(horizontal)
+				.set_dst_dim(horizontal ? 1344 : 229)
+				.set_depth(format.depth)
+				.set_filter(&point)
+				.set_shift(0.0)
+				.set_subwidth(horizontal ? src_w : src_h)
+				.create();
+			ASSERT_TRUE(filter);
+
+			FilterValidator validator{ filter.get(), src_w, src_h, format };
+			validator.set_sha1(expected_sha1[sha1_idx++]);
+			validator.validate();
+		}
+	}
+}
+
+TEST(ResizeImplTest, test_transpose)
+{
+	const unsigned src_w = 641;
+	const unsigned src_h = 480;
+
+	const zimg::resize::LanczosFilter lanczos4{ 4 };
+	const zimg::PixelFormat formats[] = { zimg::PixelType::WORD, zimg::PixelType::FLOAT };
+
+	const char *expected_sha1[][3] = {
+		{ "15febff97f469a1409691795de7e119668d02cbf" },
+		{ "57b525c5e976c7b041afe27511be1922c0f1cce9" },
+		{ "4ece810ac91308cb837e41a73c449eb83de7a974" },
+		{ "c5c050265ca4e36cc912ed013054a89d558a15df" },
+	};
+	unsigned sha1_idx = 0;
+
+	for (const zimg::PixelFormat &format : formats) {
+		for (unsigned dst_h : { 229U, 1008U }) {
+			SCOPED_TRACE(static_cast<int>(format.type));
+			SCOPED_TRACE(dst_h);
+
+			auto builder = zimg::resize::ResizeImplBuilder{ src_w, src_h, format.type }
+				.set_horizontal(false)
+				.set_dst_dim(dst_h)
+				.set_depth(format.depth)
+				.set_filter(&lanczos4)
+				.set_shift(0.0)
+				.set_subwidth(src_h);
+
+			auto filter = builder.set_transpose(true).create();
+			auto filter_ref = builder.set_transpose(false).create();
+			ASSERT_TRUE(filter);
+			ASSERT_TRUE(filter_ref);
+			ASSERT_FALSE(assert_different_dynamic_type(filter.get(), filter_ref.get()));
+			ASSERT_TRUE(filter->get_flags().entire_plane);
+
+			FilterValidator validator{ filter.get(), src_w, src_h, format };
+			validator.set_sha1(expected_sha1[sha1_idx++])
+			         .set_ref_filter(filter_ref.get(), INFINITY);
+			validator.validate();
+		}
+	}
+}
+
+TEST(ResizeImplTest, test_uv)
+{
+	const unsigned src_w = 640;
+	const unsigned src_h = 480;
+
+	const zimg::resize::BicubicFilter bicubic{};
+	const zimg::resize::LanczosFilter lanczos4{ 4 };
+
+	for (bool horizontal : { true, false }) {
+		for (unsigned dst_dim : { 229U, 1011U }) {
+			SCOPED_TRACE(horizontal);
+			SCOPED_TRACE(dst_dim);
+
+			test_case_uv<uint16_t>(bicubic, horizontal, src_w, src_h, dst_dim, zimg::PixelType::WORD);
+			test_case_uv<uint16_t>(lanczos4, horizontal, src_w, src_h, dst_dim, zimg::PixelType::WORD);
+			test_case_uv<float>(bicubic, horizontal, src_w, src_h, dst_dim, zimg::PixelType::FLOAT);
+			test_case_uv<float>(lanczos4, horizontal, src_w, src_h, dst_dim, zimg::PixelType::FLOAT);
+		}
+	}
+}
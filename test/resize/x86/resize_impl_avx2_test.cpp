@@ -1,9 +1,17 @@
 #ifdef ZIMG_X86
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include "common/align.h"
+#include "common/alloc.h"
 #include "common/cpuinfo.h"
 #include "common/pixel.h"
 #include "common/x86/cpuinfo_x86.h"
+#include "graph/image_buffer.h"
 #include "resize/filter.h"
 #include "resize/resize_impl.h"
 
@@ -47,6 +55,124 @@ void test_case(const zimg::resize::Filter &filter, bool horizontal, unsigned src
 	validator.validate();
 }
 
+// Compares the U+V filter to the greyscale filter applied to each plane.
+template <class T>
+void test_case_uv(const zimg::resize::Filter &filter, bool horizontal, unsigned src_w, unsigned src_h, unsigned dst_dim, const zimg::PixelFormat &format)
+{
+	if (!zimg::query_x86_capabilities().avx2) {
+		SUCCEED() << "avx2 not available, skipping";
+		return;
+	}
+
+	SCOPED_TRACE(filter.support());
+	SCOPED_TRACE(dst_dim);
+
+	const unsigned dst_w = horizontal ? dst_dim : src_w;
+	const unsigned dst_h = horizontal ? src_h : dst_dim;
+	const ptrdiff_t src_stride = zimg::ceil_n(src_w * sizeof(T), zimg::ALIGNMENT);
+	const ptrdiff_t dst_stride = zimg::ceil_n(dst_w * sizeof(T), zimg::ALIGNMENT);
+
+	auto builder = zimg::resize::ResizeImplBuilder{ src_w, src_h, format.type }
+		.set_horizontal(horizontal)
+		.set_dst_dim(dst_dim)
+		.set_depth(format.depth)
+		.set_filter(&filter)
+		.set_shift(0.0)
+		.set_subwidth(horizontal ? src_w : src_h)
+		.set_cpu(zimg::CPUClass::X86_AVX2);
+
+	auto filter_uv = builder.set_uv(true).create();
+	auto filter_grey = builder.set_uv(false).create();
+	ASSERT_TRUE(filter_uv);
+	ASSERT_TRUE(filter_grey);
+	ASSERT_TRUE(filter_uv->get_flags().color);
+
+	std::vector<zimg::AlignedVector<unsigned char>> src(2, zimg::AlignedVector<unsigned char>(src_stride * src_h));
+	std::vector<zimg::AlignedVector<unsigned char>> dst(4, zimg::AlignedVector<unsigned char>(dst_stride * dst_h));
+	std::mt19937 mt;
+
+	// Half-precision samples are drawn from [0, 1].
+	double maxval = format.type == zimg::PixelType::FLOAT ? 1.0 : format.type == zimg::PixelType::HALF ? 0x3C00 : (1UL << format.depth) - 1;
+	std::uniform_real_distribution<double> dist{ 0.0, maxval };
+
+	for (auto &plane : src) {
+		for (unsigned i = 0; i < src_h; ++i) {
+			T *row = reinterpret_cast<T *>(plane.data() + i * src_stride);
+			std::generate_n(row, src_w, [&]() { return static_cast<T>(std::is_same<T, float>::value ? dist(mt) : std::lrint(dist(mt))); });
+		}
+	}
+
+	auto run = [&](const zimg::graph::ImageFilter &f, const zimg::graph::ImageBuffer<const void> *src_buf, const zimg::graph::ImageBuffer<void> *dst_buf)
+	{
+		// Two tiles, so that neither edge of the second is aligned.
+		const unsigned tiles[][2] = { { 0, dst_w / 3 }, { dst_w / 3, dst_w } };
+
+		for (const auto &tile : tiles) {
+			zimg::AlignedVector<unsigned char> ctx(f.get_context_size());
+			zimg::AlignedVector<unsigned char> tmp(f.get_tmp_size(tile[0], tile[1]));
+
+			f.init_context(ctx.data(), 0);
+			for (unsigned i = 0; i < dst_h; i += f.get_simultaneous_lines()) {
+				f.process(ctx.data(), src_buf, dst_buf, tmp.data(), i, tile[0], tile[1]);
+			}
+		}
+	};
+
+	zimg::graph::ImageBuffer<const void> src_buf[3] = {
+		{},
+		{ src[0].data(), src_stride, zimg::graph::BUFFER_MAX },
+		{ src[1].data(), src_stride, zimg::graph::BUFFER_MAX },
+	};
+	zimg::graph::ImageBuffer<void> dst_buf[5] = {
+		{},
+		{ dst[0].data(), dst_stride, zimg::graph::BUFFER_MAX },
+		{ dst[1].data(), dst_stride, zimg::graph::BUFFER_MAX },
+		{ dst[2].data(), dst_stride, zimg::graph::BUFFER_MAX },
+		{ dst[3].data(), dst_stride, zimg::graph::BUFFER_MAX },
+	};
+
+	run(*filter_uv, src_buf, dst_buf);
+	run(*filter_grey, src_buf + 1, dst_buf + 3);
+	run(*filter_grey, src_buf + 2, dst_buf + 4);
+
+	for (unsigned i = 0; i < dst_h; ++i) {
+		ASSERT_EQ(0, std::memcmp(dst[0].data() + i * dst_stride, dst[2].data() + i * dst_stride, dst_w * sizeof(T))) << "U row " << i;
+		ASSERT_EQ(0, std::memcmp(dst[1].data() + i * dst_stride, dst[3].data() + i * dst_stride, dst_w * sizeof(T))) << "V row " << i;
+	}
+}
+
+// Compares the transposed vertical pass to the C implementation, which uses
+// scalar transposes. Strips at the right edge and rows at the bottom edge do
+// not fill a vector.
+void test_case_transpose(const zimg::resize::Filter &filter, unsigned src_w, unsigned src_h, unsigned dst_h,
+                         const zimg::PixelFormat &format, const char * const expected_sha1[3], double expected_snr)
+{
+	if (!zimg::query_x86_capabilities().avx2) {
+		SUCCEED() << "avx2 not available, skipping";
+		return;
+	}
+
+	SCOPED_TRACE(static_cast<double>(dst_h) / src_h);
+
+	auto builder = zimg::resize::ResizeImplBuilder{ src_w, src_h, format.type }
+		.set_horizontal(false)
+		.set_dst_dim(dst_h)
+		.set_depth(format.depth)
+		.set_filter(&filter)
+		.set_shift(0.0)
+		.set_subwidth(src_h)
+		.set_transpose(true);
+
+	std::unique_ptr<zimg::graph::ImageFilter> filter_avx2 = builder.set_cpu(zimg::CPUClass::X86_AVX2).create();
+	std::unique_ptr<zimg::graph::ImageFilter> filter_c = builder.set_cpu(zimg::CPUClass::NONE).create();
+	ASSERT_TRUE(filter_avx2->get_flags().entire_plane);
+
+	FilterValidator validator{ filter_avx2.get(), src_w, src_h, format };
+	validator.set_sha1(expected_sha1)
+	         .set_ref_filter(filter_c.get(), expected_snr);
+	validator.validate();
+}
+
 } // namespace
 
 
@@ -218,4 +344,58 @@ TEST(ResizeImplAVX2Test, test_resize_v_f32)
 	test_case(zimg::resize::LanczosFilter{ 4 }, false, w, dst_h, w, src_h, type, expected_sha1[3], expected_snr);
 }
 
+TEST(ResizeImplAVX2Test, test_transpose)
+{
+	const unsigned src_w = 641;
+	const unsigned src_h = 487;
+	const zimg::PixelFormat formats[] = { { zimg::PixelType::WORD, 16 }, zimg::PixelType::FLOAT };
+
+	const char *expected_sha1[][3] = {
+		{ "e898c0853003b90c85c4679d41a95af9fa6cd43c" },
+		{ "7f57c8bddf85d2064bb4e05801a250459e94b045" },
+		{ "4cd000691431b85be1258d1b38f2dbdffc65007d" },
+		{ "bd47481fb15dc7a2226eb5181b1ce04e1dc95513" }
+	};
+	const double expected_snr[] = { INFINITY, 120.0 };
+	unsigned sha1_idx = 0;
+
+	for (unsigned n = 0; n < 2; ++n) {
+		SCOPED_TRACE(static_cast<int>(formats[n].type));
+
+		test_case_transpose(zimg::resize::LanczosFilter{ 4 }, src_w, src_h, 229, formats[n], expected_sha1[sha1_idx++], expected_snr[n]);
+		test_case_transpose(zimg::resize::LanczosFilter{ 4 }, src_w, src_h, 1008, formats[n], expected_sha1[sha1_idx++], expected_snr[n]);
+	}
+}
+
+TEST(ResizeImplAVX2Test, test_resize_uv)
+{
+	const unsigned w = 640;
+	const unsigned h = 480;
+
+	const zimg::resize::BilinearFilter bilinear{};
+	const zimg::resize::LanczosFilter lanczos4{ 4 };
+
+	// Downscaling by more than 2:1 rules out the permute kernels, which are
+	// used instead of the U+V filter where they apply.
+	for (unsigned dst_dim : { 227U, 229U }) {
+		SCOPED_TRACE("h");
+		test_case_uv<uint16_t>(bilinear, true, w, h, dst_dim, { zimg::PixelType::WORD, 10 });
+		test_case_uv<uint16_t>(lanczos4, true, w, h, dst_dim, { zimg::PixelType::WORD, 16 });
+		test_case_uv<uint16_t>(bilinear, true, w, h, dst_dim, zimg::PixelType::HALF);
+		test_case_uv<uint16_t>(lanczos4, true, w, h, dst_dim, zimg::PixelType::HALF);
+		test_case_uv<float>(bilinear, true, w, h, dst_dim, zimg::PixelType::FLOAT);
+		test_case_uv<float>(lanczos4, true, w, h, dst_dim, zimg::PixelType::FLOAT);
+	}
+
+	for (unsigned dst_dim : { 229U, 720U }) {
+		SCOPED_TRACE("v");
+		test_case_uv<uint16_t>(bilinear, false, w, h, dst_dim, { zimg::PixelType::WORD, 10 });
+		test_case_uv<uint16_t>(lanczos4, false, w, h, dst_dim, { zimg::PixelType::WORD, 16 });
+		test_case_uv<uint16_t>(bilinear, false, w, h, dst_dim, zimg::PixelType::HALF);
+		test_case_uv<uint16_t>(lanczos4, false, w, h, dst_dim, zimg::PixelType::HALF);
+		test_case_uv<float>(bilinear, false, w, h, dst_dim, zimg::PixelType::FLOAT);
+		test_case_uv<float>(lanczos4, false, w, h, dst_dim, zimg::PixelType::FLOAT);
+	}
+}
+
 #endif // ZIMG_X86
@@ -47,6 +47,38 @@ void test_case(const zimg::resize::Filter &filter, bool horizontal, unsigned src
 	validator.validate();
 }
 
+// Compares the transposed vertical pass to the C implementation, which uses
+// scalar transposes. Strips at the right edge and rows at the bottom edge do
+// not fill a vector.
+void test_case_transpose(const zimg::resize::Filter &filter, unsigned src_w, unsigned src_h, unsigned dst_h,
+                         const zimg::PixelFormat &format, const char * const expected_sha1[3], double expected_snr)
+{
+	if (!zimg::query_x86_capabilities().avx512f) {
+		SUCCEED() << "avx512 not available, skipping";
+		return;
+	}
+
+	SCOPED_TRACE(static_cast<double>(dst_h) / src_h);
+
+	auto builder = zimg::resize::ResizeImplBuilder{ src_w, src_h, format.type }
+		.set_horizontal(false)
+		.set_dst_dim(dst_h)
+		.set_depth(format.depth)
+		.set_filter(&filter)
+		.set_shift(0.0)
+		.set_subwidth(src_h)
+		.set_transpose(true);
+
+	std::unique_ptr<zimg::graph::ImageFilter> filter_avx512 = builder.set_cpu(zimg::CPUClass::X86_AVX512).create();
+	std::unique_ptr<zimg::graph::ImageFilter> filter_c = builder.set_cpu(zimg::CPUClass::NONE).create();
+	ASSERT_TRUE(filter_avx512->get_flags().entire_plane);
+
+	FilterValidator validator{ filter_avx512.get(), src_w, src_h, format };
+	validator.set_sha1(expected_sha1)
+	         .set_ref_filter(filter_c.get(), expected_snr);
+	validator.validate();
+}
+
 } // namespace
 
 
@@ -218,4 +250,27 @@ TEST(ResizeImplAVX512Test, test_resize_v_f32)
 	test_case(zimg::resize::LanczosFilter{ 4 }, false, w, dst_h, w, src_h, type, expected_sha1[3], expected_snr);
 }
 
+TEST(ResizeImplAVX512Test, test_transpose)
+{
+	const unsigned src_w = 641;
+	const unsigned src_h = 487;
+	const zimg::PixelFormat formats[] = { { zimg::PixelType::WORD, 16 }, zimg::PixelType::FLOAT };
+
+	const char *expected_sha1[][3] = {
+		{ "e898c0853003b90c85c4679d41a95af9fa6cd43c" },
+		{ "7f57c8bddf85d2064bb4e05801a250459e94b045" },
+		{ "4cd000691431b85be1258d1b38f2dbdffc65007d" },
+		{ "bd47481fb15dc7a2226eb5181b1ce04e1dc95513" }
+	};
+	const double expected_snr[] = { INFINITY, 120.0 };
+	unsigned sha1_idx = 0;
+
+	for (unsigned n = 0; n < 2; ++n) {
+		SCOPED_TRACE(static_cast<int>(formats[n].type));
+
+		test_case_transpose(zimg::resize::LanczosFilter{ 4 }, src_w, src_h, 229, formats[n], expected_sha1[sha1_idx++], expected_snr[n]);
+		test_case_transpose(zimg::resize::LanczosFilter{ 4 }, src_w, src_h, 1008, formats[n], expected_sha1[sha1_idx++], expected_snr[n]);
+	}
+}
+
 #endif // ZIMG_X86_AVX512
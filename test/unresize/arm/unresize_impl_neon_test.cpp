@@ -0,0 +1,112 @@
+#ifdef ZIMG_ARM
+
+#include <memory>
+#include "common/cpuinfo.h"
+#include "common/pixel.h"
+#include "common/arm/cpuinfo_arm.h"
+#include "graph/image_filter.h"
+#include "resize/filter.h"
+#include "unresize/unresize_impl.h"
+
+#include "gtest/gtest.h"
+#include "graph/filter_validator.h"
+
+namespace {
+
+void test_case(const zimg::PixelFormat &format, bool horizontal, unsigned up_w, unsigned up_h, unsigned orig_dim, double shift, const zimg::resize::Filter *resample_filter, double expected_snr)
+{
+	if (!zimg::query_arm_capabilities().neon || !zimg::query_arm_capabilities().vfpv4) {
+		SUCCEED() << "neon not available, skipping";
+		return;
+	}
+
+	SCOPED_TRACE(horizontal);
+	SCOPED_TRACE(static_cast<double>(orig_dim) / (horizontal ? up_w : up_h));
+
+	auto builder = zimg::unresize::UnresizeImplBuilder{ up_w, up_h, format.type }
+		.set_horizontal(horizontal)
+		.set_orig_dim(orig_dim)
+		.set_depth(format.depth)
+		.set_shift(shift)
+		.set_filter(resample_filter);
+
+	std::unique_ptr<zimg::graph::ImageFilter> filter_neon = builder.set_cpu(zimg::CPUClass::ARM_NEON).create();
+	std::unique_ptr<zimg::graph::ImageFilter> filter_c = builder.set_cpu(zimg::CPUClass::NONE).create();
+
+	ASSERT_FALSE(assert_different_dynamic_type(filter_c.get(), filter_neon.get()));
+
+	FilterValidator validator{ filter_neon.get(), up_w, up_h, format };
+	validator.set_ref_filter(filter_c.get(), expected_snr);
+	validator.validate();
+}
+
+} // namespace
+
+
+TEST(UnresizeImplNEONTest, test_unresize_h_f32)
+{
+	const zimg::PixelFormat format = zimg::PixelType::FLOAT;
+	const double expected_snr = 120.0;
+
+	test_case(format, true, 960, 480, 640, 0.0, nullptr, expected_snr);
+	test_case(format, true, 1919, 37, 1283, 0.25, nullptr, expected_snr);
+	test_case(format, true, 27, 17, 13, 0.0, nullptr, expected_snr);
+}
+
+TEST(UnresizeImplNEONTest, test_unresize_v_f32)
+{
+	const zimg::PixelFormat format = zimg::PixelType::FLOAT;
+	const double expected_snr = 120.0;
+
+	test_case(format, false, 640, 720, 480, 0.0, nullptr, expected_snr);
+	test_case(format, false, 1283, 539, 357, -0.25, nullptr, expected_snr);
+	test_case(format, false, 13, 27, 11, 0.0, nullptr, expected_snr);
+}
+
+TEST(UnresizeImplNEONTest, test_unresize_h_u16)
+{
+	const zimg::PixelFormat format{ zimg::PixelType::WORD, 10 };
+	const double expected_snr = 90.0;
+
+	test_case(format, true, 960, 480, 640, 0.0, nullptr, expected_snr);
+	test_case(format, true, 1919, 37, 1283, 0.25, nullptr, expected_snr);
+	test_case(format, true, 27, 17, 13, 0.0, nullptr, expected_snr);
+}
+
+TEST(UnresizeImplNEONTest, test_unresize_v_u16)
+{
+	const zimg::PixelFormat format{ zimg::PixelType::WORD, 10 };
+	const double expected_snr = 90.0;
+
+	test_case(format, false, 640, 720, 480, 0.0, nullptr, expected_snr);
+	test_case(format, false, 1283, 539, 357, -0.25, nullptr, expected_snr);
+	test_case(format, false, 13, 27, 11, 0.0, nullptr, expected_snr);
+}
+
+TEST(UnresizeImplNEONTest, test_unresize_h_f32_filter)
+{
+	const zimg::PixelFormat format = zimg::PixelType::FLOAT;
+	const double expected_snr = 120.0;
+
+	const zimg::resize::BicubicFilter bicubic{};
+	const zimg::resize::LanczosFilter lanczos3{ 3 };
+
+	test_case(format, true, 960, 480, 640, 0.0, &bicubic, expected_snr);
+	test_case(format, true, 1919, 37, 1283, 0.25, &lanczos3, expected_snr);
+	test_case(format, true, 27, 17, 13, 0.0, &lanczos3, expected_snr);
+}
+
+TEST(UnresizeImplNEONTest, test_unresize_v_f32_filter)
+{
+	const zimg::PixelFormat format = zimg::PixelType::FLOAT;
+	const double expected_snr = 120.0;
+
+	const zimg::resize::BicubicFilter bicubic{};
+	const zimg::resize::LanczosFilter lanczos3{ 3 };
+
+	test_case(format, false, 640, 720, 480, 0.0, &bicubic, expected_snr);
+	test_case(format, false, 1283, 539, 357, -0.25, &lanczos3, expected_snr);
+	test_case(format, false, 13, 27, 11, 0.0, &lanczos3, expected_snr);
+}
+
+#endif // ZIMG_ARM
@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include "common/alloc.h"
+#include "common/cpuinfo.h"
+#include "common/pixel.h"
+#include "graph/image_buffer.h"
+#include "graph/image_filter.h"
+#include "resize/filter.h"
+#include "resize/resize_impl.h"
+#include "unresize/bilinear.h"
+#include "unresize/unresize_impl.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+template <class T>
+struct Image {
+	zimg::AlignedVector<T> data;
+	unsigned width;
+	unsigned height;
+
+	Image(unsigned width, unsigned height) :
+		data(static_cast<size_t>(zimg::ceil_n(width, zimg::AlignmentOf<T>::value)) * height),
+		width{ width },
+		height{ height }
+	{}
+
+	ptrdiff_t stride() const { return zimg::ceil_n(width, zimg::AlignmentOf<T>::value) * sizeof(T); }
+
+	zimg::graph::ImageBuffer<const void> read_buffer() const { return{ data.data(), stride(), zimg::graph::BUFFER_MAX }; }
+
+	zimg::graph::ImageBuffer<void> write_buffer() { return{ data.data(), stride(), zimg::graph::BUFFER_MAX }; }
+
+	T &at(unsigned i, unsigned j) { return data[i * (stride() / sizeof(T)) + j]; }
+};
+
+template <class T>
+void run_filter(const zimg::graph::ImageFilter &filter, const Image<T> &src, Image<T> &dst)
+{
+	auto attr = filter.get_image_attributes();
+	zimg::AlignedVector<char> ctx(filter.get_context_size());
+	zimg::AlignedVector<char> tmp(filter.get_tmp_size(0, attr.width));
+	unsigned step = filter.get_simultaneous_lines();
+
+	zimg::graph::ImageBuffer<const void> src_buf = src.read_buffer();
+	zimg::graph::ImageBuffer<void> dst_buf = dst.write_buffer();
+
+	filter.init_context(ctx.data(), 0);
+
+	for (unsigned i = 0; i < attr.height; i += std::min(step, attr.height - i)) {
+		filter.process(ctx.data(), &src_buf, &dst_buf, tmp.data(), i, 0, attr.width);
+	}
+}
+
+void test_case(const zimg::resize::Filter &resample_filter, bool horizontal, unsigned orig_dim, unsigned up_dim, double shift, double max_error)
+{
+	const unsigned orig_w = horizontal ? orig_dim : 9;
+	const unsigned orig_h = horizontal ? 9 : orig_dim;
+	const unsigned up_w = horizontal ? up_dim : orig_w;
+	const unsigned up_h = horizontal ? orig_h : up_dim;
+
+	SCOPED_TRACE(horizontal);
+	SCOPED_TRACE(resample_filter.support());
+	SCOPED_TRACE(static_cast<double>(orig_dim) / up_dim);
+
+	Image<float> orig{ orig_w, orig_h };
+	Image<float> up{ up_w, up_h };
+	Image<float> result{ orig_w, orig_h };
+	std::mt19937 mt;
+	std::uniform_real_distribution<float> dist{ 0.0f, 1.0f };
+
+	for (unsigned i = 0; i < orig_h; ++i) {
+		for (unsigned j = 0; j < orig_w; ++j) {
+			orig.at(i, j) = dist(mt);
+		}
+	}
+
+	auto resize_filter = zimg::resize::ResizeImplBuilder{ orig_w, orig_h, zimg::PixelType::FLOAT }
+		.set_horizontal(horizontal)
+		.set_dst_dim(up_dim)
+		.set_filter(&resample_filter)
+		.set_shift(shift * orig_dim / up_dim)
+		.set_subwidth(orig_dim)
+		.create();
+	auto unresize_filter = zimg::unresize::UnresizeImplBuilder{ up_w, up_h, zimg::PixelType::FLOAT }
+		.set_horizontal(horizontal)
+		.set_orig_dim(orig_dim)
+		.set_shift(shift)
+		.set_filter(&resample_filter)
+		.create();
+
+	run_filter(*resize_filter, orig, up);
+	run_filter(*unresize_filter, up, result);
+
+	double error = 0.0;
+	for (unsigned i = 0; i < orig_h; ++i) {
+		for (unsigned j = 0; j < orig_w; ++j) {
+			error = std::max(error, static_cast<double>(std::fabs(orig.at(i, j) - result.at(i, j))));
+		}
+	}
+	EXPECT_LT(error, max_error);
+}
+
+void test_case_word(bool horizontal, unsigned up_dim, unsigned orig_dim, unsigned depth)
+{
+	const unsigned up_w = horizontal ? up_dim : 9;
+	const unsigned up_h = horizontal ? 9 : up_dim;
+	const unsigned orig_w = horizontal ? orig_dim : up_w;
+	const unsigned orig_h = horizontal ? up_h : orig_dim;
+	const float pixel_max = static_cast<float>((1UL << depth) - 1);
+
+	SCOPED_TRACE(horizontal);
+	SCOPED_TRACE(depth);
+
+	Image<uint16_t> up_u16{ up_w, up_h };
+	Image<float> up_f32{ up_w, up_h };
+	Image<uint16_t> result_u16{ orig_w, orig_h };
+	Image<float> result_f32{ orig_w, orig_h };
+	std::mt19937 mt;
+	std::uniform_int_distribution<unsigned> dist{ 0, (1U << depth) - 1 };
+
+	for (unsigned i = 0; i < up_h; ++i) {
+		for (unsigned j = 0; j < up_w; ++j) {
+			up_u16.at(i, j) = static_cast<uint16_t>(dist(mt));
+			up_f32.at(i, j) = up_u16.at(i, j);
+		}
+	}
+
+	auto builder = zimg::unresize::UnresizeImplBuilder{ up_w, up_h, zimg::PixelType::WORD }
+		.set_horizontal(horizontal)
+		.set_orig_dim(orig_dim)
+		.set_depth(depth);
+	auto filter_u16 = builder.create();
+
+	builder.type = zimg::PixelType::FLOAT;
+	auto filter_f32 = builder.create();
+
+	run_filter(*filter_u16, up_u16, result_u16);
+	run_filter(*filter_f32, up_f32, result_f32);
+
+	for (unsigned i = 0; i < orig_h; ++i) {
+		for (unsigned j = 0; j < orig_w; ++j) {
+			float expected = std::min(std::max(std::nearbyint(result_f32.at(i, j)), 0.0f), pixel_max);
+			ASSERT_EQ(expected, result_u16.at(i, j)) << i << " " << j;
+		}
+	}
+}
+
+} // namespace
+
+
+TEST(UnresizeImplTest, test_word)
+{
+	test_case_word(true, 960, 640, 16);
+	test_case_word(true, 523, 373, 10);
+	test_case_word(false, 720, 480, 16);
+	test_case_word(false, 317, 211, 10);
+}
+
+TEST(UnresizeImplTest, test_bandwidth)
+{
+	const zimg::resize::BilinearFilter bilinear{};
+	const zimg::resize::BicubicFilter bicubic{};
+	const zimg::resize::LanczosFilter lanczos3{ 3 };
+
+	EXPECT_EQ(1U, zimg::unresize::create_unresize_context(640, 960, 0.0, nullptr).lu_bandwidth);
+	EXPECT_EQ(1U, zimg::unresize::create_unresize_context(640, 960, 0.0, &bilinear).lu_bandwidth);
+	EXPECT_EQ(3U, zimg::unresize::create_unresize_context(640, 960, 0.0, &bicubic).lu_bandwidth);
+	EXPECT_EQ(5U, zimg::unresize::create_unresize_context(640, 960, 0.0, &lanczos3).lu_bandwidth);
+}
+
+TEST(UnresizeImplTest, test_roundtrip)
+{
+	const zimg::resize::BilinearFilter bilinear{};
+	const zimg::resize::BicubicFilter bicubic{};
+	const zimg::resize::Spline36Filter spline36{};
+	const zimg::resize::LanczosFilter lanczos3{ 3 };
+
+	const zimg::resize::Filter *resample_filters[] = { &bilinear, &bicubic, &spline36, &lanczos3 };
+
+	for (const zimg::resize::Filter *resample_filter : resample_filters) {
+		test_case(*resample_filter, true, 640, 960, 0.0, 1e-3);
+		test_case(*resample_filter, true, 1280, 1920, 0.0, 1e-3);
+		test_case(*resample_filter, true, 373, 523, 0.25, 1e-3);
+		test_case(*resample_filter, false, 480, 720, 0.0, 1e-3);
+		test_case(*resample_filter, false, 211, 317, -0.25, 1e-3);
+	}
+}